@@ -0,0 +1,1001 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "benchmarkscenarios.h"
+#include "entity.h"
+#include "framework.h"
+#include "taskmanager.h"
+#include "components/animationcomponent.h"
+#include "loaders/meshoptdecoder.h"
+#include "../misc/cpuprofilebuffer.h"
+#include "../misc/log.h"
+#include "../misc/math.h"
+#include "../misc/mpmcqueue.h"
+#include "../render/animation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace cauldron
+{
+    BenchmarkScenarioContext::BenchmarkScenarioContext(const std::wstring& scenarioName, uint32_t sampleCount) :
+        m_ScenarioName(scenarioName),
+        m_SampleCount(sampleCount ? sampleCount : 1)
+    {
+    }
+
+    void BenchmarkScenarioContext::Measure(const std::wstring& label, uint32_t operationCount, const std::function<uint64_t()>& runSample)
+    {
+        // Warm caches, thread pools and allocators up until timings settle
+        BenchmarkWarmup warmup(10, std::max(m_SampleCount, 10u), 10);
+        while (!warmup.AddFrame(runSample()))
+            ;
+
+        Measurement measurement;
+        measurement.Label          = m_ScenarioName + L"/" + label;
+        measurement.OperationCount = operationCount ? operationCount : 1;
+        measurement.Samples.Reserve(m_SampleCount);
+        for (uint32_t i = 0; i < m_SampleCount; ++i)
+            measurement.Samples.AddSample(runSample());
+
+        m_Measurements.push_back(std::move(measurement));
+    }
+
+    uint64_t BenchmarkScenarioContext::GetTime()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // Scenarios
+
+    // Fills a component sampler with keys evenly spread over the duration, valueFn writes the value of each key.
+    // The source interpolants are copied out to pSourceTimes/pSourceValues (when provided) before the sampler is finalized.
+    template<typename ValueFn>
+    static void CreateSampler(AnimChannel& channel, AnimChannel::ComponentSampler samplerID, uint32_t keyCount, float duration, int32_t dimension, ValueFn valueFn,
+                              AnimInterpolants* pSourceTimes = nullptr, AnimInterpolants* pSourceValues = nullptr)
+    {
+        AnimInterpolants* pTimes  = nullptr;
+        AnimInterpolants* pValues = nullptr;
+        channel.CreateComponentSampler(samplerID, &pTimes, &pValues);
+
+        pTimes->Count     = pValues->Count = static_cast<int32_t>(keyCount);
+        pTimes->Dimension = 1;
+        pTimes->Stride    = sizeof(float);
+        pTimes->Data.resize(keyCount * sizeof(float));
+        pTimes->Min       = Vec4(0.f, 0.f, 0.f, 0.f);
+        pTimes->Max       = Vec4(duration, 0.f, 0.f, 0.f);
+        pValues->Dimension = dimension;
+        pValues->Stride    = dimension * sizeof(float);
+        pValues->Data.resize(keyCount * pValues->Stride);
+        for (uint32_t key = 0; key < keyCount; ++key)
+        {
+            const float time = duration * key / (keyCount - 1);
+            memcpy(pTimes->Data.data() + key * sizeof(float), &time, sizeof(float));
+            valueFn(time, reinterpret_cast<float*>(pValues->Data.data() + key * pValues->Stride));
+        }
+
+        if (pSourceTimes && pSourceValues)
+        {
+            *pSourceTimes  = *pTimes;
+            *pSourceValues = *pValues;
+        }
+
+        channel.FinalizeComponentSampler(samplerID, GetConfig()->CompressAnimations, GetConfig()->AnimationCompressionLinearTolerance, GetConfig()->AnimationCompressionAngularTolerance);
+    }
+
+    // Animates crowds of skinned characters through a private AnimationComponentMgr (leaving the scene's animations alone).
+    // Every character is a model of its own with a skeleton driven by a shared looping clip, like instanced crowd characters.
+    static void RunAnimationCrowdScenario(BenchmarkScenarioContext& context)
+    {
+        constexpr uint32_t s_JointCount = 32;
+        constexpr uint32_t s_KeyCount   = 61;
+        constexpr float    s_Duration   = 2.f;
+
+        // Joints sway around their own axis, out of phase with each other
+        std::vector<Animation*> clip = { new Animation() };
+        clip[0]->SetDuration(s_Duration);
+        clip[0]->SetNumAnimationChannels(s_JointCount);
+        for (uint32_t joint = 0; joint < s_JointCount; ++joint)
+        {
+            AnimChannel& channel = *clip[0]->GetAnimationChannel(joint);
+            CreateSampler(channel, AnimChannel::ComponentSampler::Translation, 2, s_Duration, 3, [joint](float, float* pValue) {
+                pValue[0] = 0.f;
+                pValue[1] = joint ? 0.1f : 0.f;
+                pValue[2] = 0.f;
+            });
+            CreateSampler(channel, AnimChannel::ComponentSampler::Rotation, s_KeyCount, s_Duration, 4, [joint](float time, float* pValue) {
+                const float angle = 0.5f * std::sin(time * 2.f * 3.14159265f / s_Duration + joint);
+                const Vec3  axis  = math::normalize(Vec3(static_cast<float>(joint % 3 == 0), static_cast<float>(joint % 3 == 1), static_cast<float>(joint % 3 == 2)));
+                pValue[0] = axis.getX() * std::sin(angle * 0.5f);
+                pValue[1] = axis.getY() * std::sin(angle * 0.5f);
+                pValue[2] = axis.getZ() * std::sin(angle * 0.5f);
+                pValue[3] = std::cos(angle * 0.5f);
+            });
+        }
+
+        // Joints form a binary hierarchy under the skeleton root, bound at identity
+        AnimationSkin skin;
+        skin.m_skeletonId = 0;
+        skin.m_InverseBindMatrices.Count     = s_JointCount;
+        skin.m_InverseBindMatrices.Dimension = 16;
+        skin.m_InverseBindMatrices.Stride    = sizeof(Mat4);
+        skin.m_InverseBindMatrices.Data.resize(s_JointCount * sizeof(Mat4));
+        for (uint32_t joint = 0; joint < s_JointCount; ++joint)
+        {
+            const Mat4 identity = Mat4::identity();
+            memcpy(skin.m_InverseBindMatrices.Data.data() + joint * sizeof(Mat4), &identity, sizeof(Mat4));
+            skin.m_jointsNodeIdx.push_back(static_cast<int>(joint));
+        }
+        const std::vector<AnimationSkin*> skins = { &skin };
+
+        for (uint32_t characterCount : { 100u, 1000u })
+        {
+            AnimationComponentMgr                manager;
+            std::vector<Entity*>                 entities;
+            std::vector<AnimationComponentData*> componentData;
+            std::vector<AnimationComponent*>     components;
+            for (uint32_t character = 0; character < characterCount; ++character)
+            {
+                manager.RegisterModelSkins(character, &skins);
+                const size_t firstJoint = entities.size();
+                for (uint32_t joint = 0; joint < s_JointCount; ++joint)
+                {
+                    Entity* pParent = joint ? entities[firstJoint + (joint - 1) / 2] : nullptr;
+                    entities.push_back(new Entity(L"CrowdJoint", pParent));
+
+                    AnimationComponentData* pData = new AnimationComponentData();
+                    pData->m_pAnimRef = &clip;
+                    pData->m_nodeId   = joint;
+                    pData->m_modelId  = character;
+                    pData->m_skinId   = joint ? -1 : 0;
+                    componentData.push_back(pData);
+
+                    components.push_back(manager.SpawnAnimationComponent(entities.back(), pData));
+                    manager.StartManagingComponent(components.back());
+                }
+            }
+
+            // Operations are characters, so results read as time per character
+            context.Measure(L"characters/" + std::to_wstring(characterCount), characterCount, [&manager]() {
+                const uint64_t start = BenchmarkScenarioContext::GetTime();
+                manager.UpdateComponents(1.0 / 60.0);
+                return BenchmarkScenarioContext::GetTime() - start;
+            });
+
+            for (AnimationComponent* pComponent : components)
+            {
+                manager.StopManagingComponent(pComponent);
+                delete pComponent;
+            }
+            for (AnimationComponentData* pData : componentData)
+                delete pData;
+            for (Entity* pEntity : entities)
+                delete pEntity;
+        }
+
+        delete clip[0];
+    }
+
+    // Samples a component the way animation channels did before keyframe cursors: a binary search over the source
+    // interpolants (interleaved times and values) for every sample
+    static void SampleSourceInterpolants(const AnimInterpolants& times, const AnimInterpolants& values, float time, float* frac, Vec4* pCurr, Vec4* pNext)
+    {
+        int32_t       currIndex = FindClosestInterpolant(&times, time);
+        const int32_t nextIndex = std::min<int32_t>(currIndex + 1, times.Count - 1);
+        currIndex = std::max<int32_t>(currIndex, 0);
+
+        float curr[4] = { 0.f, 0.f, 0.f, 0.f };
+        float next[4] = { 0.f, 0.f, 0.f, 0.f };
+        memcpy(curr, GetInterpolant(&values, currIndex), values.Dimension * sizeof(float));
+        memcpy(next, GetInterpolant(&values, nextIndex), values.Dimension * sizeof(float));
+        *pCurr = Vec4(curr[0], curr[1], curr[2], curr[3]);
+        *pNext = Vec4(next[0], next[1], next[2], next[3]);
+
+        const float currTime = *static_cast<const float*>(GetInterpolant(&times, currIndex));
+        const float nextTime = *static_cast<const float*>(GetInterpolant(&times, nextIndex));
+        *frac = currIndex == nextIndex ? 0.f : std::max<float>(0.f, (time - currTime) / (nextTime - currTime));
+    }
+
+    // Samples the translation, rotation and scale channels of thousands of animated nodes, each playing a shared clip
+    // at its own phase, one frame per sample. Compares sampling through keyframe cursors, sampling without cursors
+    // (binary search over the key times) and the previous sampling of the source interpolants. Operations are channels,
+    // so results read as the sampling cost per channel.
+    static void RunAnimationSamplingScenario(BenchmarkScenarioContext& context)
+    {
+        constexpr uint32_t s_ChannelCount = 64;
+        constexpr uint32_t s_KeyCount     = 241;
+        constexpr float    s_Duration     = 8.f;
+        constexpr uint32_t s_SamplerCount = static_cast<uint32_t>(AnimChannel::ComponentSampler::Count);
+
+        // Channels of the clip move along their own curves, keeping the source interpolants of every component
+        Animation clip;
+        clip.SetDuration(s_Duration);
+        clip.SetNumAnimationChannels(s_ChannelCount);
+        std::vector<AnimInterpolants> sourceTimes(s_ChannelCount * s_SamplerCount);
+        std::vector<AnimInterpolants> sourceValues(s_ChannelCount * s_SamplerCount);
+        for (uint32_t channelIndex = 0; channelIndex < s_ChannelCount; ++channelIndex)
+        {
+            AnimChannel&   channel = *clip.GetAnimationChannel(channelIndex);
+            const uint32_t first   = channelIndex * s_SamplerCount;
+            const float    phase   = static_cast<float>(channelIndex);
+            CreateSampler(channel, AnimChannel::ComponentSampler::Translation, s_KeyCount, s_Duration, 3, [phase](float time, float* pValue) {
+                pValue[0] = std::sin(time + phase);
+                pValue[1] = 0.25f * std::sin(3.f * time + phase);
+                pValue[2] = std::cos(time + phase);
+            }, &sourceTimes[first], &sourceValues[first]);
+            CreateSampler(channel, AnimChannel::ComponentSampler::Rotation, s_KeyCount, s_Duration, 4, [phase](float time, float* pValue) {
+                const float angle = std::sin(time + phase);
+                pValue[0] = 0.f;
+                pValue[1] = std::sin(angle * 0.5f);
+                pValue[2] = 0.f;
+                pValue[3] = std::cos(angle * 0.5f);
+            }, &sourceTimes[first + 1], &sourceValues[first + 1]);
+            CreateSampler(channel, AnimChannel::ComponentSampler::Scale, s_KeyCount, s_Duration, 3, [phase](float time, float* pValue) {
+                const float scale = 1.f + 0.1f * std::sin(2.f * time + phase);
+                pValue[0] = pValue[1] = pValue[2] = scale;
+            }, &sourceTimes[first + 2], &sourceValues[first + 2]);
+        }
+
+        for (uint32_t nodeCount : { 1024u, 4096u })
+        {
+            std::vector<float>      nodeTimes(nodeCount);
+            std::vector<AnimCursor> cursors(nodeCount * s_SamplerCount);
+            float                   checksum = 0.f;
+
+            // Advances every node by a frame and samples all of its channels, sampleChannel samples one channel
+            auto sampleFrame = [&](auto sampleChannel) {
+                const uint64_t start = BenchmarkScenarioContext::GetTime();
+                for (uint32_t node = 0; node < nodeCount; ++node)
+                {
+                    nodeTimes[node] = std::fmod(nodeTimes[node] + 1.f / 60.f, s_Duration);
+                    const uint32_t channelIndex = node % s_ChannelCount;
+                    for (uint32_t sampler = 0; sampler < s_SamplerCount; ++sampler)
+                    {
+                        float frac;
+                        Vec4  curr, next;
+                        sampleChannel(node, channelIndex, sampler, nodeTimes[node], &frac, &curr, &next);
+                        checksum += frac + curr.getX() + next.getW();
+                    }
+                }
+                return BenchmarkScenarioContext::GetTime() - start;
+            };
+
+            auto resetNodes = [&]() {
+                for (uint32_t node = 0; node < nodeCount; ++node)
+                    nodeTimes[node] = std::fmod(node * 0.37f, s_Duration);
+                std::fill(cursors.begin(), cursors.end(), AnimCursor());
+            };
+
+            const std::wstring suffix         = std::to_wstring(nodeCount);
+            const uint32_t     operationCount = nodeCount * s_SamplerCount;
+
+            resetNodes();
+            context.Measure(L"cursor/" + suffix, operationCount, [&]() {
+                return sampleFrame([&](uint32_t node, uint32_t channelIndex, uint32_t sampler, float time, float* frac, Vec4* pCurr, Vec4* pNext) {
+                    clip.GetAnimationChannel(channelIndex)->SampleAnimComponent(static_cast<AnimChannel::ComponentSampler>(sampler), time,
+                                                                               &cursors[node * s_SamplerCount + sampler], frac, pCurr, pNext);
+                });
+            });
+
+            resetNodes();
+            context.Measure(L"search/" + suffix, operationCount, [&]() {
+                return sampleFrame([&](uint32_t, uint32_t channelIndex, uint32_t sampler, float time, float* frac, Vec4* pCurr, Vec4* pNext) {
+                    clip.GetAnimationChannel(channelIndex)->SampleAnimComponent(static_cast<AnimChannel::ComponentSampler>(sampler), time, nullptr, frac, pCurr, pNext);
+                });
+            });
+
+            resetNodes();
+            context.Measure(L"interpolants/" + suffix, operationCount, [&]() {
+                return sampleFrame([&](uint32_t, uint32_t channelIndex, uint32_t sampler, float time, float* frac, Vec4* pCurr, Vec4* pNext) {
+                    const uint32_t source = channelIndex * s_SamplerCount + sampler;
+                    SampleSourceInterpolants(sourceTimes[source], sourceValues[source], time, frac, pCurr, pNext);
+                });
+            });
+
+            // Keeps the samples from being optimized away
+            Log::Write(LOGLEVEL_TRACE, L"Animation sampling scenario sampled %u nodes (checksum %f).", nodeCount, checksum);
+        }
+    }
+
+    typedef void (*BenchmarkScenarioFunction)(BenchmarkScenarioContext&);
+
+    struct BenchmarkScenarioEntry
+    {
+        const wchar_t*              Name;
+        BenchmarkScenarioFunction   Run;
+    };
+
+    // The task manager's previous scheduler, a single mutex-protected queue shared by all workers. Kept as the
+    // reference the task contention scenario compares the work-stealing scheduler against.
+    class SingleQueueTaskPool
+    {
+    public:
+        explicit SingleQueueTaskPool(uint32_t threadCount)
+        {
+            for (uint32_t i = 0; i < threadCount; ++i)
+                m_ThreadPool.emplace_back([this]() { TaskExecutor(); });
+        }
+
+        ~SingleQueueTaskPool()
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_CriticalSection);
+                m_ShuttingDown = true;
+                m_QueueCondition.notify_all();
+            }
+            for (std::thread& thread : m_ThreadPool)
+                thread.join();
+        }
+
+        void AddTask(Task& newTask)
+        {
+            std::unique_lock<std::mutex> lock(m_CriticalSection);
+            m_TaskQueue.push(std::move(newTask));
+            m_QueueCondition.notify_one();
+        }
+
+        void AddTaskList(std::queue<Task>& newTaskList)
+        {
+            std::unique_lock<std::mutex> lock(m_CriticalSection);
+            while (newTaskList.size())
+            {
+                m_TaskQueue.push(std::move(newTaskList.front()));
+                newTaskList.pop();
+            }
+            m_QueueCondition.notify_all();
+        }
+
+    private:
+        NO_COPY(SingleQueueTaskPool)
+        NO_MOVE(SingleQueueTaskPool)
+
+        void TaskExecutor()
+        {
+            while (true)
+            {
+                std::unique_lock<std::mutex> lock(m_CriticalSection);
+                m_QueueCondition.wait(lock, [this] { return !m_TaskQueue.empty() || m_ShuttingDown; });
+                if (m_ShuttingDown)
+                    break;
+
+                Task taskToExecute = std::move(m_TaskQueue.front());
+                m_TaskQueue.pop();
+                lock.unlock();
+
+                while (taskToExecute.pTaskFunction)
+                {
+                    taskToExecute.pTaskFunction(taskToExecute.pTaskParam);
+
+                    // The last task of a group runs its completion task
+                    if (taskToExecute.pTaskCompletionCallback && --taskToExecute.pTaskCompletionCallback->TaskCount == 0)
+                    {
+                        TaskCompletionCallback* pCallback = taskToExecute.pTaskCompletionCallback;
+                        taskToExecute = pCallback->CompletionTask;
+                        delete pCallback;
+                        continue;
+                    }
+                    break;
+                }
+            }
+        }
+
+        bool                     m_ShuttingDown = false;
+        std::vector<std::thread> m_ThreadPool   = {};
+        std::queue<Task>         m_TaskQueue    = {};
+        std::mutex               m_CriticalSection;
+        std::condition_variable  m_QueueCondition;
+    };
+
+    // Floods the task manager with thousands of tiny tasks: submitted from outside the pool (through the injection queue),
+    // spawned from a pool thread (onto its own deque, for the other workers to steal) and as a parallel for. The injected
+    // and spawned cases are also run through the previous single queue scheduler, with as many threads, for reference.
+    static void RunTaskContentionScenario(BenchmarkScenarioContext& context)
+    {
+        constexpr uint32_t s_TaskCount = 4096;
+
+        TaskManager*          pTaskManager = GetTaskManager();
+        std::vector<uint32_t> results(s_TaskCount);
+        std::atomic_bool      done(false);
+
+        // Queues all tiny tasks on a scheduler, the last one to complete flags the batch as done
+        auto createTinyTasks = [&results, &done]() {
+            TaskCompletionCallback* pCallback = new TaskCompletionCallback(Task([&done](void*) { done = true; }), s_TaskCount);
+            std::queue<Task> tasks;
+            for (uint32_t i = 0; i < s_TaskCount; ++i)
+                tasks.push(Task([&results, i](void*) { results[i] = i * 2654435761u; }, nullptr, pCallback));
+            return tasks;
+        };
+        auto waitForTinyTasks = [&done]() {
+            while (!done)
+                std::this_thread::yield();
+            done = false;
+        };
+
+        // Runs the injected and spawned cases on a scheduler
+        auto measureScheduler = [&](const std::wstring& prefix, auto addTask, auto addTaskList) {
+            context.Measure(prefix + L"injected/" + std::to_wstring(s_TaskCount), s_TaskCount, [&]() {
+                const uint64_t start = BenchmarkScenarioContext::GetTime();
+                std::queue<Task> tasks = createTinyTasks();
+                addTaskList(tasks);
+                waitForTinyTasks();
+                return BenchmarkScenarioContext::GetTime() - start;
+            });
+
+            context.Measure(prefix + L"spawned/" + std::to_wstring(s_TaskCount), s_TaskCount, [&]() {
+                const uint64_t start = BenchmarkScenarioContext::GetTime();
+                Task spawnTask([&](void*) {
+                    std::queue<Task> tasks = createTinyTasks();
+                    addTaskList(tasks);
+                });
+                addTask(spawnTask);
+                waitForTinyTasks();
+                return BenchmarkScenarioContext::GetTime() - start;
+            });
+        };
+
+        measureScheduler(L"", [pTaskManager](Task& task) { pTaskManager->AddTask(task); },
+                         [pTaskManager](std::queue<Task>& tasks) { pTaskManager->AddTaskList(tasks); });
+
+        context.Measure(L"parallelfor/" + std::to_wstring(s_TaskCount), s_TaskCount, [pTaskManager, &results]() {
+            const uint64_t start = BenchmarkScenarioContext::GetTime();
+            pTaskManager->ParallelForRange(s_TaskCount, 1, [&results](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i)
+                    results[i] = i * 2654435761u;
+            });
+            return BenchmarkScenarioContext::GetTime() - start;
+        });
+
+        // The single queue scheduler had no parallel for, callers queued a task per item (the injected case)
+        SingleQueueTaskPool referencePool(pTaskManager->GetThreadCount());
+        measureScheduler(L"singlequeue/", [&referencePool](Task& task) { referencePool.AddTask(task); },
+                         [&referencePool](std::queue<Task>& tasks) { referencePool.AddTaskList(tasks); });
+    }
+
+    // Pushes items through an MPMCQueue from 1 to 64 threads. Half of the threads produce and the other half consume
+    // (a single thread alternates), threads spin up before timing starts and wait on the queue by yielding.
+    static void RunMPMCQueueScenario(BenchmarkScenarioContext& context)
+    {
+        constexpr uint32_t s_ItemCount     = 1 << 16;
+        constexpr uint32_t s_QueueCapacity = 1024;
+
+        for (uint32_t threadCount = 1; threadCount <= 64; threadCount *= 2)
+        {
+            context.Measure(L"threads/" + std::to_wstring(threadCount), s_ItemCount, [threadCount]() {
+                MPMCQueue<uint64_t> queue(s_QueueCapacity);
+                if (threadCount == 1)
+                {
+                    const uint64_t start = BenchmarkScenarioContext::GetTime();
+                    uint64_t       value = 0;
+                    for (uint32_t i = 0; i < s_ItemCount; ++i)
+                    {
+                        queue.TryPush(static_cast<uint64_t>(i));
+                        queue.TryPop(value);
+                    }
+                    return BenchmarkScenarioContext::GetTime() - start;
+                }
+
+                const uint32_t producerCount = threadCount / 2;
+                const uint32_t consumerCount = threadCount - producerCount;
+
+                std::atomic_uint32_t readyCount(0);
+                std::atomic_bool     go(false);
+                auto waitForStart = [&readyCount, &go]() {
+                    ++readyCount;
+                    while (!go)
+                        std::this_thread::yield();
+                };
+
+                std::vector<std::thread> threads;
+                for (uint32_t producer = 0; producer < producerCount; ++producer)
+                {
+                    threads.emplace_back([&queue, &waitForStart, producerCount]() {
+                        waitForStart();
+                        for (uint64_t i = 0; i < s_ItemCount / producerCount; ++i)
+                        {
+                            while (!queue.TryPush(i))
+                                std::this_thread::yield();
+                        }
+                    });
+                }
+                for (uint32_t consumer = 0; consumer < consumerCount; ++consumer)
+                {
+                    threads.emplace_back([&queue, &waitForStart, consumerCount]() {
+                        waitForStart();
+                        uint64_t value = 0;
+                        for (uint32_t i = 0; i < s_ItemCount / consumerCount; ++i)
+                        {
+                            while (!queue.TryPop(value))
+                                std::this_thread::yield();
+                        }
+                    });
+                }
+
+                while (readyCount != threadCount)
+                    std::this_thread::yield();
+                const uint64_t start = BenchmarkScenarioContext::GetTime();
+                go = true;
+                for (std::thread& thread : threads)
+                    thread.join();
+                return BenchmarkScenarioContext::GetTime() - start;
+            });
+        }
+    }
+    // Logs from 1 to 8 threads at once and reports the average time each Log::Write call takes on the calling thread.
+    // The threads live for the whole measurement since every thread that logs keeps its own buffer in the log system.
+    static void RunLogContentionScenario(BenchmarkScenarioContext& context)
+    {
+        constexpr uint32_t s_CallsPerThread = 256;
+
+        const uint64_t droppedBefore = Log::GetDroppedMessageCount();
+        for (uint32_t threadCount = 1; threadCount <= 8; threadCount *= 2)
+        {
+            std::atomic_uint32_t  sampleIndex(0);
+            std::atomic_uint32_t  doneCount(0);
+            std::atomic_uint64_t  callTime(0);
+            std::atomic_bool      quit(false);
+
+            std::vector<std::thread> threads;
+            for (uint32_t thread = 0; thread < threadCount; ++thread)
+            {
+                threads.emplace_back([&sampleIndex, &doneCount, &callTime, &quit, thread]() {
+                    uint32_t lastSample = 0;
+                    while (true)
+                    {
+                        while (sampleIndex == lastSample && !quit)
+                            std::this_thread::yield();
+                        if (quit)
+                            break;
+                        lastSample = sampleIndex;
+
+                        const uint64_t start = BenchmarkScenarioContext::GetTime();
+                        for (uint32_t i = 0; i < s_CallsPerThread; ++i)
+                            Log::Write(LOGLEVEL_TRACE, L"Log contention thread %u, call %u, value %f.", thread, i, i * 0.5);
+                        callTime += BenchmarkScenarioContext::GetTime() - start;
+                        ++doneCount;
+                    }
+                });
+            }
+
+            context.Measure(L"threads/" + std::to_wstring(threadCount), threadCount * s_CallsPerThread, [&sampleIndex, &doneCount, &callTime, threadCount]() {
+                doneCount = 0;
+                callTime  = 0;
+                ++sampleIndex;
+                while (doneCount != threadCount)
+                    std::this_thread::yield();
+                return callTime.load();
+            });
+
+            quit = true;
+            for (std::thread& thread : threads)
+                thread.join();
+        }
+
+        Log::Write(LOGLEVEL_INFO, L"Log contention scenario dropped %llu message(s).", static_cast<unsigned long long>(Log::GetDroppedMessageCount() - droppedBefore));
+    }
+
+    // Records runs of CPU profiler captures, siblings and captures each holding a nested one, into a thread's capture
+    // buffer. The buffer is drained between samples like the profiler does between frames.
+    static void RunProfilerScopesScenario(BenchmarkScenarioContext& context)
+    {
+        constexpr uint32_t s_CaptureCount = 4096;
+
+        CPUProfileBuffer buffer;
+        uint64_t         checksum = 0;
+        auto drain = [&buffer, &checksum]() {
+            buffer.Drain([&checksum](const CPUProfileEvent& event) { checksum += event.EndTimestamp - event.StartTimestamp; });
+        };
+
+        context.Measure(L"sibling/" + std::to_wstring(s_CaptureCount), s_CaptureCount, [&buffer, &drain]() {
+            const uint64_t start = BenchmarkScenarioContext::GetTime();
+            for (uint32_t i = 0; i < s_CaptureCount; ++i)
+                buffer.End(buffer.Begin(L"Sibling"));
+            const uint64_t time = BenchmarkScenarioContext::GetTime() - start;
+            drain();
+            return time;
+        });
+
+        context.Measure(L"nested/" + std::to_wstring(s_CaptureCount), s_CaptureCount, [&buffer, &drain]() {
+            const uint64_t start = BenchmarkScenarioContext::GetTime();
+            for (uint32_t i = 0; i < s_CaptureCount; i += 2)
+            {
+                const uint32_t parent = buffer.Begin(L"Parent");
+                buffer.End(buffer.Begin(L"Child"));
+                buffer.End(parent);
+            }
+            const uint64_t time = BenchmarkScenarioContext::GetTime() - start;
+            drain();
+            return time;
+        });
+
+        Log::Write(LOGLEVEL_TRACE, L"Profiler scopes scenario recorded captures totaling %llu ticks (%llu dropped).", static_cast<unsigned long long>(checksum),
+                   static_cast<unsigned long long>(buffer.GetDroppedCount()));
+    }
+
+    // Minimal meshopt encoders producing valid streams for the decode scenario (the glTF loader only decodes). The vertex
+    // encoder picks the smallest encoding for each byte group, the index encoder doesn't use the aux code table.
+    static std::vector<uint8_t> EncodeMeshoptVertexBuffer(const uint8_t* pVertices, size_t vertexCount, size_t vertexSize)
+    {
+        std::vector<uint8_t> encoded = { 0xa0 };
+
+        size_t blockSize = (8192 / vertexSize) & ~size_t(15);
+        blockSize = std::min<size_t>(blockSize, 256);
+
+        std::vector<uint8_t> lastVertex(pVertices, pVertices + vertexSize);
+        for (size_t vertexOffset = 0; vertexOffset < vertexCount; vertexOffset += blockSize)
+        {
+            const size_t blockCount   = std::min<size_t>(blockSize, vertexCount - vertexOffset);
+            const size_t alignedCount = (blockCount + 15) & ~size_t(15);
+            for (size_t k = 0; k < vertexSize; ++k)
+            {
+                std::vector<uint8_t> deltas(alignedCount, 0);
+                for (size_t i = 0; i < blockCount; ++i)
+                {
+                    const uint8_t value = pVertices[(vertexOffset + i) * vertexSize + k];
+                    const uint8_t delta = static_cast<uint8_t>(value - lastVertex[k]);
+                    deltas[i]     = static_cast<uint8_t>((delta << 1) ^ (static_cast<int8_t>(delta) >> 7));
+                    lastVertex[k] = value;
+                }
+
+                const size_t headerOffset = encoded.size();
+                encoded.resize(encoded.size() + (alignedCount / 16 + 3) / 4, 0);
+                for (size_t group = 0; group < alignedCount / 16; ++group)
+                {
+                    const uint8_t* pGroup   = deltas.data() + group * 16;
+                    size_t         sizes[4] = { 0, 4, 8, 16 };
+                    for (size_t i = 0; i < 16; ++i)
+                    {
+                        sizes[0] += pGroup[i] ? 16 : 0;
+                        sizes[1] += pGroup[i] >= 3;
+                        sizes[2] += pGroup[i] >= 15;
+                    }
+                    const int bitsLog2 = static_cast<int>(std::min_element(sizes, sizes + 4) - sizes);
+
+                    encoded[headerOffset + group / 4] |= static_cast<uint8_t>(bitsLog2 << ((group % 4) * 2));
+                    if (bitsLog2 == 3)
+                    {
+                        encoded.insert(encoded.end(), pGroup, pGroup + 16);
+                    }
+                    else if (bitsLog2 != 0)
+                    {
+                        const uint32_t       bits     = 1u << bitsLog2;
+                        const uint8_t        sentinel = static_cast<uint8_t>((1u << bits) - 1);
+                        std::vector<uint8_t> escaped;
+                        for (size_t i = 0; i < 16; i += 8 / bits)
+                        {
+                            uint8_t packed = 0;
+                            for (size_t j = 0; j < 8 / bits; ++j)
+                            {
+                                const uint8_t value = std::min<uint8_t>(pGroup[i + j], sentinel);
+                                packed = static_cast<uint8_t>((packed << bits) | value);
+                                if (value == sentinel)
+                                    escaped.push_back(pGroup[i + j]);
+                            }
+                            encoded.push_back(packed);
+                        }
+                        encoded.insert(encoded.end(), escaped.begin(), escaped.end());
+                    }
+                }
+            }
+        }
+
+        // The tail holds the first vertex, the baseline of the first deltas
+        encoded.resize(encoded.size() + std::max<size_t>(vertexSize, 32) - vertexSize, 0);
+        encoded.insert(encoded.end(), pVertices, pVertices + vertexSize);
+        return encoded;
+    }
+
+    static void EncodeMeshoptVByte(std::vector<uint8_t>& data, uint32_t value)
+    {
+        while (value >= 128)
+        {
+            data.push_back(static_cast<uint8_t>((value & 127) | 128));
+            value >>= 7;
+        }
+        data.push_back(static_cast<uint8_t>(value));
+    }
+
+    static void EncodeMeshoptIndexDelta(std::vector<uint8_t>& data, uint32_t index, uint32_t& last)
+    {
+        const int32_t delta = static_cast<int32_t>(index - last);
+        EncodeMeshoptVByte(data, (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31));
+        last = index;
+    }
+
+    static std::vector<uint8_t> EncodeMeshoptIndexBuffer(const uint32_t* pIndices, size_t indexCount)
+    {
+        // Edge and vertex fifos, updated exactly as the decoder does
+        uint32_t edges[16][2];
+        uint32_t vertices[16];
+        size_t   edgeOffset   = 0;
+        size_t   vertexOffset = 0;
+        memset(edges, -1, sizeof(edges));
+        memset(vertices, -1, sizeof(vertices));
+        auto pushEdge = [&](uint32_t a, uint32_t b) {
+            edges[edgeOffset][0] = a;
+            edges[edgeOffset][1] = b;
+            edgeOffset = (edgeOffset + 1) & 15;
+        };
+        auto pushVertex = [&](uint32_t v, bool push) {
+            vertices[vertexOffset] = v;
+            vertexOffset = (vertexOffset + (push ? 1 : 0)) & 15;
+        };
+
+        std::vector<uint8_t> codes = { 0xe1 };
+        std::vector<uint8_t> data;
+        uint32_t             next = 0;
+        uint32_t             last = 0;
+        for (size_t i = 0; i < indexCount; i += 3)
+        {
+            // Look for a rotation of the triangle whose first edge is in the fifo
+            int      fe = -1;
+            uint32_t a = 0, b = 0, c = 0;
+            for (int rotation = 0; rotation < 3 && fe < 0; ++rotation)
+            {
+                a = pIndices[i + rotation];
+                b = pIndices[i + (rotation + 1) % 3];
+                c = pIndices[i + (rotation + 2) % 3];
+                for (int e = 0; e < 16 && fe < 0; ++e)
+                {
+                    if (edges[(edgeOffset - 1 - e) & 15][0] == a && edges[(edgeOffset - 1 - e) & 15][1] == b)
+                        fe = e;
+                }
+            }
+
+            if (fe >= 0)
+            {
+                // Third vertex is new, in the fifo (version 1 uses 13 and 14 for the last index -/+ 1) or free
+                int fec = 15;
+                if (c == next)
+                    fec = 0;
+                for (int v = 1; v < 13 && fec == 15; ++v)
+                    fec = vertices[(vertexOffset - 1 - v) & 15] == c ? v : fec;
+                if (fec == 15 && (c == last - 1 || c == last + 1))
+                    fec = c == last - 1 ? 13 : 14;
+
+                if (fec == 0)
+                    ++next;
+                if (fec >= 13)
+                {
+                    if (fec == 15)
+                        EncodeMeshoptIndexDelta(data, c, last);
+                    last = c;
+                }
+                pushVertex(c, fec == 0 || fec >= 13);
+
+                codes.push_back(static_cast<uint8_t>((fe << 4) | fec));
+                pushEdge(c, b);
+                pushEdge(a, c);
+                continue;
+            }
+
+            // Otherwise every vertex is new, in the fifo or free, starting with a new one if possible
+            a = pIndices[i];
+            b = pIndices[i + 1];
+            c = pIndices[i + 2];
+            if (b == next)
+                std::swap(a, b), std::swap(b, c);
+            else if (c == next)
+                std::swap(a, c), std::swap(b, c);
+
+            const int fea = a == next ? 0 : 15;
+            uint32_t  nextVertex = next + (fea == 0);
+            auto findVertex = [&](uint32_t v) {
+                if (v == nextVertex)
+                {
+                    ++nextVertex;
+                    return 0;
+                }
+                for (int f = 1; f < 15; ++f)
+                {
+                    if (vertices[(vertexOffset - f) & 15] == v)
+                        return f;
+                }
+                return 15;
+            };
+            int feb = findVertex(b);
+            int fec = findVertex(c);
+
+            // An aux code of 0 restarts the new vertex counter, store the vertices in full instead
+            if (feb == 0 && fec == 0 && next != 0)
+                feb = fec = 15;
+            next = (fea == 0 ? next + 1 : next) + (feb == 0) + (fec == 0);
+
+            codes.push_back(fea == 0 ? 0xfe : 0xff);
+            data.push_back(static_cast<uint8_t>((feb << 4) | fec));
+            if (fea == 15)
+                EncodeMeshoptIndexDelta(data, a, last);
+            if (feb == 15)
+                EncodeMeshoptIndexDelta(data, b, last);
+            if (fec == 15)
+                EncodeMeshoptIndexDelta(data, c, last);
+
+            pushVertex(a, true);
+            pushVertex(b, feb == 0 || feb == 15);
+            pushVertex(c, fec == 0 || fec == 15);
+            pushEdge(b, a);
+            pushEdge(c, b);
+            pushEdge(a, c);
+        }
+
+        // Codes, data and the (unused) aux code table
+        codes.insert(codes.end(), data.begin(), data.end());
+        codes.resize(codes.size() + 16, 0);
+        return codes;
+    }
+
+    static std::vector<uint8_t> EncodeMeshoptIndexSequence(const uint32_t* pIndices, size_t indexCount)
+    {
+        // Only the first baseline is used
+        std::vector<uint8_t> encoded = { 0xd1 };
+        uint32_t             last    = 0;
+        for (size_t i = 0; i < indexCount; ++i)
+        {
+            const int32_t delta = static_cast<int32_t>(pIndices[i] - last);
+            EncodeMeshoptVByte(encoded, ((static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31)) << 1);
+            last = pIndices[i];
+        }
+        encoded.resize(encoded.size() + 4, 0);
+        return encoded;
+    }
+
+    // Decodes a meshopt compressed grid mesh (vertices, triangle indices and the same indices as a sequence) and applies
+    // the filters to as many elements. Operations are vertices, indices or filtered elements.
+    static void RunMeshoptDecodeScenario(BenchmarkScenarioContext& context)
+    {
+        constexpr uint32_t s_GridSize    = 256;
+        constexpr uint32_t s_VertexCount = s_GridSize * s_GridSize;
+
+        // Quantized position, octahedral normal and texture coordinates, 16 bytes per vertex
+        struct GridVertex
+        {
+            int16_t  Position[4];
+            int8_t   Normal[4];
+            uint16_t TexCoord[2];
+        };
+        std::vector<GridVertex> vertices(s_VertexCount);
+        for (uint32_t y = 0; y < s_GridSize; ++y)
+        {
+            for (uint32_t x = 0; x < s_GridSize; ++x)
+            {
+                GridVertex& vertex = vertices[y * s_GridSize + x];
+                const float height = std::sin(x * 0.05f) * std::cos(y * 0.07f);
+                vertex.Position[0] = static_cast<int16_t>(x * 64);
+                vertex.Position[1] = static_cast<int16_t>(height * 4096.f);
+                vertex.Position[2] = static_cast<int16_t>(y * 64);
+                vertex.Position[3] = 0;
+                vertex.Normal[0]   = static_cast<int8_t>(std::cos(x * 0.05f) * 40.f);
+                vertex.Normal[1]   = static_cast<int8_t>(std::sin(y * 0.07f) * 40.f);
+                vertex.Normal[2]   = 127;
+                vertex.Normal[3]   = 0;
+                vertex.TexCoord[0] = static_cast<uint16_t>(x * 65535 / (s_GridSize - 1));
+                vertex.TexCoord[1] = static_cast<uint16_t>(y * 65535 / (s_GridSize - 1));
+            }
+        }
+
+        std::vector<uint32_t> indices;
+        for (uint32_t y = 0; y + 1 < s_GridSize; ++y)
+        {
+            for (uint32_t x = 0; x + 1 < s_GridSize; ++x)
+            {
+                const uint32_t corner = y * s_GridSize + x;
+                indices.insert(indices.end(), { corner, corner + s_GridSize, corner + 1, corner + 1, corner + s_GridSize, corner + s_GridSize + 1 });
+            }
+        }
+        const uint32_t indexCount = static_cast<uint32_t>(indices.size());
+
+        const std::vector<uint8_t> vertexData   = EncodeMeshoptVertexBuffer(reinterpret_cast<const uint8_t*>(vertices.data()), s_VertexCount, sizeof(GridVertex));
+        const std::vector<uint8_t> indexData    = EncodeMeshoptIndexBuffer(indices.data(), indexCount);
+        const std::vector<uint8_t> sequenceData = EncodeMeshoptIndexSequence(indices.data(), indexCount);
+
+        std::vector<GridVertex> decodedVertices(s_VertexCount);
+        std::vector<uint32_t>   decodedIndices(indexCount);
+        bool                    valid = true;
+
+        context.Measure(L"vertices/" + std::to_wstring(s_VertexCount), s_VertexCount, [&]() {
+            const uint64_t start = BenchmarkScenarioContext::GetTime();
+            valid &= DecodeMeshoptVertexBuffer(decodedVertices.data(), s_VertexCount, sizeof(GridVertex), vertexData.data(), vertexData.size());
+            return BenchmarkScenarioContext::GetTime() - start;
+        });
+        valid &= memcmp(decodedVertices.data(), vertices.data(), vertices.size() * sizeof(GridVertex)) == 0;
+
+        context.Measure(L"triangles/" + std::to_wstring(indexCount), indexCount, [&]() {
+            const uint64_t start = BenchmarkScenarioContext::GetTime();
+            valid &= DecodeMeshoptIndexBuffer(decodedIndices.data(), indexCount, sizeof(uint32_t), indexData.data(), indexData.size());
+            return BenchmarkScenarioContext::GetTime() - start;
+        });
+        valid &= decodedIndices == indices;
+
+        context.Measure(L"sequence/" + std::to_wstring(indexCount), indexCount, [&]() {
+            const uint64_t start = BenchmarkScenarioContext::GetTime();
+            valid &= DecodeMeshoptIndexSequence(decodedIndices.data(), indexCount, sizeof(uint32_t), sequenceData.data(), sequenceData.size());
+            return BenchmarkScenarioContext::GetTime() - start;
+        });
+        valid &= decodedIndices == indices;
+
+        // Filtered streams hold the filtered attribute alone: octahedral normals, quaternions and exponent encoded positions
+        std::vector<int8_t>   normals(s_VertexCount * 4);
+        std::vector<int16_t>  quaternions(s_VertexCount * 4);
+        std::vector<uint32_t> positions(s_VertexCount * 3);
+        for (uint32_t i = 0; i < s_VertexCount; ++i)
+        {
+            memcpy(&normals[i * 4], vertices[i].Normal, 4);
+            quaternions[i * 4 + 0] = static_cast<int16_t>(vertices[i].Normal[0] * 16);
+            quaternions[i * 4 + 1] = static_cast<int16_t>(vertices[i].Normal[1] * 16);
+            quaternions[i * 4 + 2] = 0;
+            quaternions[i * 4 + 3] = static_cast<int16_t>((2047 << 2) | (i & 3));
+            for (uint32_t j = 0; j < 3; ++j)
+                positions[i * 3 + j] = (static_cast<uint32_t>(-6) << 24) | (static_cast<uint32_t>(static_cast<int32_t>(vertices[i].Position[j])) & 0xffffff);
+        }
+
+        // Filters decode in place, each sample starts from a fresh copy of the filtered data (not timed)
+        auto measureFilter = [&context](const wchar_t* name, auto& source, size_t stride, void (*filter)(void*, size_t, size_t)) {
+            auto filtered = source;
+            context.Measure(std::wstring(name) + L"/" + std::to_wstring(s_VertexCount), s_VertexCount, [&]() {
+                filtered = source;
+                const uint64_t start = BenchmarkScenarioContext::GetTime();
+                filter(filtered.data(), s_VertexCount, stride);
+                return BenchmarkScenarioContext::GetTime() - start;
+            });
+        };
+        measureFilter(L"octahedral", normals, 4, &DecodeMeshoptOctahedralFilter);
+        measureFilter(L"quaternion", quaternions, 8, &DecodeMeshoptQuaternionFilter);
+        measureFilter(L"exponential", positions, 12, &DecodeMeshoptExponentialFilter);
+
+        CauldronAssert(ASSERT_ERROR, valid, L"Meshopt decode scenario failed to decode its streams");
+        Log::Write(LOGLEVEL_TRACE, L"Meshopt decode scenario streams: %zu vertex bytes, %zu index bytes, %zu sequence bytes.", vertexData.size(), indexData.size(),
+                   sequenceData.size());
+    }
+
+    // Scenarios are referenced by name from the Benchmark/Scenarios config entry
+    static const BenchmarkScenarioEntry s_BenchmarkScenarios[] = {
+        { L"AnimationCrowd",    &RunAnimationCrowdScenario },
+        { L"AnimationSampling", &RunAnimationSamplingScenario },
+        { L"TaskContention",    &RunTaskContentionScenario },
+        { L"MPMCQueue",         &RunMPMCQueueScenario },
+        { L"LogContention",     &RunLogContentionScenario },
+        { L"ProfilerScopes",    &RunProfilerScopesScenario },
+        { L"MeshoptDecode",     &RunMeshoptDecodeScenario },
+    };
+
+    bool RunBenchmarkScenario(const std::wstring& name, BenchmarkScenarioContext& context)
+    {
+        for (const BenchmarkScenarioEntry& scenario : s_BenchmarkScenarios)
+        {
+            if (name == scenario.Name)
+            {
+                Log::Write(LOGLEVEL_TRACE, L"Running benchmark scenario %ls.", scenario.Name);
+                scenario.Run(context);
+                return true;
+            }
+        }
+        return false;
+    }
+
+} // namespace cauldron
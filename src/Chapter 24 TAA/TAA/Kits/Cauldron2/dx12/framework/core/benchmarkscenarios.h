@@ -0,0 +1,100 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "../misc/benchmarkstats.h"
+#include "../misc/helpers.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace cauldron
+{
+    /**
+     * @class BenchmarkScenarioContext
+     *
+     * Handed to CPU benchmark scenarios by the benchmark runner. A scenario measures its operations through
+     * <c><i>Measure</i></c>, each measurement warming up until its timings settle and then recording a series
+     * of samples that is reported (and compared against the baseline) like any other benchmark label.
+     *
+     * @ingroup CauldronBenchmark
+     */
+    class BenchmarkScenarioContext
+    {
+    public:
+        /// A measurement recorded by a scenario.
+        ///
+        struct Measurement
+        {
+            std::wstring    Label;              ///< Label of the measurement (prefixed with the scenario name).
+            uint32_t        OperationCount = 1; ///< Number of operations timed by each sample.
+            BenchmarkSeries Samples = {};       ///< Time taken by each sample, in nanoseconds.
+        };
+
+        /**
+         * @brief   Construction. Each measurement records sampleCount samples after its warmup.
+         */
+        BenchmarkScenarioContext(const std::wstring& scenarioName, uint32_t sampleCount);
+
+        /**
+         * @brief   Records a measurement. runSample runs operationCount operations and returns the time they took
+         *          in nanoseconds, it is called until warmup completes and then once per sample.
+         */
+        void Measure(const std::wstring& label, uint32_t operationCount, const std::function<uint64_t()>& runSample);
+
+        /**
+         * @brief   Returns the number of samples recorded per measurement.
+         */
+        uint32_t GetSampleCount() const { return m_SampleCount; }
+
+        /**
+         * @brief   Returns the measurements recorded so far.
+         */
+        std::vector<Measurement>& GetMeasurements() { return m_Measurements; }
+
+        /**
+         * @brief   Returns the current time in nanoseconds, to time samples with.
+         */
+        static uint64_t GetTime();
+
+    private:
+        NO_COPY(BenchmarkScenarioContext)
+        NO_MOVE(BenchmarkScenarioContext)
+
+        std::wstring                m_ScenarioName;
+        uint32_t                    m_SampleCount;
+        std::vector<Measurement>    m_Measurements = {};
+    };
+
+    /// Runs the CPU benchmark scenario registered under the provided name.
+    ///
+    /// @param [in] name        The name of the scenario to run.
+    /// @param [in] context     The context recording the scenario's measurements.
+    ///
+    /// @returns                False if no scenario is registered under that name.
+    ///
+    /// @ingroup CauldronBenchmark
+    bool RunBenchmarkScenario(const std::wstring& name, BenchmarkScenarioContext& context);
+
+} // namespace cauldron
@@ -173,12 +173,12 @@ namespace cauldron
         /**
          * @brief   Indicates the ComponentMgr should start managing the passed in <c><i>Component</i></c>.
          */
-        void StartManagingComponent(Component* pComponent);
+        virtual void StartManagingComponent(Component* pComponent);
 
         /**
          * @brief   Indicates the ComponentMgr should stop managing the passed in <c><i>Component</i></c>.
          */
-        void StopManagingComponent(Component* pComponent);
+        virtual void StopManagingComponent(Component* pComponent);
 
         /**
          * @brief   Focus lost.
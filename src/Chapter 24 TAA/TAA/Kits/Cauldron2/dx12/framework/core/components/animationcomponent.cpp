@@ -21,17 +21,27 @@
 // THE SOFTWARE.
 
 #include "animationcomponent.h"
+#include "cameracomponent.h"
 #include "../entity.h"
 #include "../framework.h"
+#include "../scene.h"
+#include "../../render/mesh.h"
 #include "../../render/rtresources.h"
 
 #include "../../misc/assert.h"
+#include "../../misc/log.h"
 #include "../../misc/math.h"
 
-#include<algorithm>
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
 
 namespace cauldron
 {
+    // Projected size (fraction of the screen height) below which models only update every 2nd / 4th frame
+    static constexpr float s_HalfRateProjectedSize    = 0.15f;
+    static constexpr float s_QuarterRateProjectedSize = 0.05f;
+
     const wchar_t*         AnimationComponentMgr::s_ComponentName     = L"AnimationComponent";
     AnimationComponentMgr* AnimationComponentMgr::s_pComponentManager = nullptr;
 
@@ -68,6 +78,13 @@ namespace cauldron
 
     void AnimationComponentMgr::Shutdown()
     {
+        if (m_CPUSkinnedVertices > 0)
+        {
+            const double busySeconds = static_cast<double>(m_CPUSkinningBusyNanoseconds.load()) * 1e-9;
+            Log::Write(LOGLEVEL_INFO, L"CPU skinning: %llu vertices skinned at %.2f million vertices/second per core.",
+                       m_CPUSkinnedVertices.load(), busySeconds > 0.0 ? static_cast<double>(m_CPUSkinnedVertices.load()) / busySeconds * 1e-6 : 0.0);
+        }
+
         // Clear out the convenience instance pointer
         CauldronAssert(
             ASSERT_ERROR, s_pComponentManager, L"AnimationComponentMgr instance is null. Component managers can ONLY be destroyed through framework shutdown");
@@ -93,7 +110,7 @@ namespace cauldron
         delete m_pData->m_animatedBlas;
     }
 
-    void AnimationComponent::UpdateLocalMatrix(uint32_t animationIndex, float time)
+    void AnimationComponent::UpdateLocalMatrix(uint32_t animationIndex, double animationTime)
     {
         if (animationIndex >= m_pData->m_pAnimRef->size())
         {
@@ -103,23 +120,25 @@ namespace cauldron
 
         Animation* animation = (*m_pData->m_pAnimRef)[animationIndex];
 
-        // Loop animation
-        time = fmod(time, animation->GetDuration());
+        // Loop animation (in double precision so long running clocks don't lose key accuracy)
+        const float time = static_cast<float>(fmod(animationTime, static_cast<double>(animation->GetDuration())));
 
         const AnimChannel* pAnimChannel = animation->GetAnimationChannel(m_pData->m_nodeId);
         if (pAnimChannel->HasComponentSampler(AnimChannel::ComponentSampler::Translation) ||
             pAnimChannel->HasComponentSampler(AnimChannel::ComponentSampler::Rotation) ||
             pAnimChannel->HasComponentSampler(AnimChannel::ComponentSampler::Scale))
         {
-            float frac, *pCurr, *pNext;
+            float frac;
+            Vec4  curr;
+            Vec4  next;
 
             // Animate translation
             //
             Vec4 translation = Vec4(0, 0, 0, 0);
             if (pAnimChannel->HasComponentSampler(AnimChannel::ComponentSampler::Translation))
             {
-                pAnimChannel->SampleAnimComponent(AnimChannel::ComponentSampler::Translation, time, &frac, &pCurr, &pNext);
-                translation = ((1.0f - frac) * math::Vector4(pCurr[0], pCurr[1], pCurr[2], 0)) + ((frac)*math::Vector4(pNext[0], pNext[1], pNext[2], 0));
+                pAnimChannel->SampleAnimComponent(AnimChannel::ComponentSampler::Translation, time, &m_AnimCursors[static_cast<uint32_t>(AnimChannel::ComponentSampler::Translation)], &frac, &curr, &next);
+                translation = math::lerp(frac, curr, next);
             }
             else
             {
@@ -131,10 +150,8 @@ namespace cauldron
             Mat4 rotation = Mat4::identity();
             if (pAnimChannel->HasComponentSampler(AnimChannel::ComponentSampler::Rotation))
             {
-                pAnimChannel->SampleAnimComponent(AnimChannel::ComponentSampler::Rotation, time, &frac, &pCurr, &pNext);
-                rotation =
-                    math::Matrix4(math::slerp(frac, math::Quat(pCurr[0], pCurr[1], pCurr[2], pCurr[3]), math::Quat(pNext[0], pNext[1], pNext[2], pNext[3])),
-                                  math::Vector3(0.0f, 0.0f, 0.0f));
+                pAnimChannel->SampleAnimComponent(AnimChannel::ComponentSampler::Rotation, time, &m_AnimCursors[static_cast<uint32_t>(AnimChannel::ComponentSampler::Rotation)], &frac, &curr, &next);
+                rotation = math::Matrix4(math::slerp(frac, math::Quat(curr), math::Quat(next)), math::Vector3(0.0f, 0.0f, 0.0f));
             }
 
             // Animate scale
@@ -142,8 +159,8 @@ namespace cauldron
             Vec4 scale = Vec4(1, 1, 1, 1);
             if (pAnimChannel->HasComponentSampler(AnimChannel::ComponentSampler::Scale))
             {
-                pAnimChannel->SampleAnimComponent(AnimChannel::ComponentSampler::Scale, time, &frac, &pCurr, &pNext);
-                scale = ((1.0f - frac) * math::Vector4(pCurr[0], pCurr[1], pCurr[2], 0)) + ((frac)*math::Vector4(pNext[0], pNext[1], pNext[2], 0));
+                pAnimChannel->SampleAnimComponent(AnimChannel::ComponentSampler::Scale, time, &m_AnimCursors[static_cast<uint32_t>(AnimChannel::ComponentSampler::Scale)], &frac, &curr, &next);
+                scale = math::lerp(frac, curr, next);
             }
 
             Mat4 transform = math::Matrix4::translation(translation.getXYZ()) * rotation * math::Matrix4::scale(scale.getXYZ());
@@ -152,71 +169,235 @@ namespace cauldron
         }
     }
 
-    void cauldron::AnimationComponentMgr::UpdateComponents(double deltaTime)
+    void AnimationComponentMgr::RegisterModelSkins(uint32_t modelId, const std::vector<AnimationSkin*>* pSkins)
     {
-        static double time = 0.0;
-        time += deltaTime;
+        SkinningData& skinningData = m_skinningData[modelId];
+        skinningData.m_pSkins = pSkins;
+        skinningData.m_SkinningMatrices.resize(pSkins->size());
+        for (size_t i = 0; i < pSkins->size(); ++i)
+            skinningData.m_SkinningMatrices[i].resize((*pSkins)[i]->m_jointsNodeIdx.size());
+        m_UpdateListsDirty = true;
+    }
 
-        // Update local transforms
-        for (auto& component : m_ManagedComponents)
+    void AnimationComponentMgr::StartManagingComponent(Component* pComponent)
+    {
+        ComponentMgr::StartManagingComponent(pComponent);
+        m_UpdateListsDirty = true;
+    }
+
+    void AnimationComponentMgr::StopManagingComponent(Component* pComponent)
+    {
+        ComponentMgr::StopManagingComponent(pComponent);
+        m_UpdateListsDirty = true;
+    }
+
+    void AnimationComponentMgr::BuildUpdateLists()
+    {
+        m_UpdateLists.clear();
+
+        // Group components per model
+        std::unordered_map<uint32_t, size_t> modelListIndices;
+        for (auto* pComponent : m_ManagedComponents)
         {
-            component->Update(time);
+            AnimationComponent* pAnimComponent = static_cast<AnimationComponent*>(pComponent);
+            const uint32_t      modelId        = pAnimComponent->GetData()->m_modelId;
+
+            auto listIter = modelListIndices.find(modelId);
+            if (listIter == modelListIndices.end())
+            {
+                listIter = modelListIndices.emplace(modelId, m_UpdateLists.size()).first;
+                m_UpdateLists.emplace_back();
+                m_UpdateLists.back().ModelId = modelId;
+
+                auto skinningIter = m_skinningData.find(modelId);
+                m_UpdateLists.back().pSkinningData = skinningIter != m_skinningData.end() ? &skinningIter->second : nullptr;
+            }
+
+            m_UpdateLists[listIter->second].Components.push_back(pAnimComponent);
         }
 
-        // Update global transforms (process the hierarchy)
-        for (auto& component : m_ManagedComponents)
+        for (auto& updateList : m_UpdateLists)
         {
-            const auto  owner  = component->GetOwner();
-            const auto& parent = owner->GetParent();
-            const auto& data   = static_cast<const AnimationComponent*>(component)->GetData();
-
-            Mat4 parentTransform = parent == nullptr ? Mat4::identity() : parent->GetTransform();
-            Mat4 globalTransform = parentTransform * static_cast<AnimationComponent*>(component)->GetLocalTransform();
-
-            /*
-            * Currently supports only one Skin per Model. Most assets work this way but it's technically possible for a Model to have multiple Skins.
-            * If supporting these models is desired in the future, the following code needs to change.
-            */
-            const auto& skins = m_skinningData[data->m_modelId].m_pSkins;
-            if (skins != nullptr && skins->size() > 0 && skins->at(0)->m_skeletonId == data->m_nodeId)
+            // Order by hierarchy depth so parents are always resolved before their children
+            std::vector<std::pair<uint32_t, AnimationComponent*>> depthOrder;
+            depthOrder.reserve(updateList.Components.size());
+            for (auto* pComponent : updateList.Components)
             {
-                globalTransform = static_cast<AnimationComponent*>(component)->GetLocalTransform();
+                uint32_t depth = 0;
+                for (Entity* pParent = pComponent->GetOwner()->GetParent(); pParent != nullptr; pParent = pParent->GetParent())
+                    ++depth;
+                depthOrder.push_back({ depth, pComponent });
             }
+            std::stable_sort(depthOrder.begin(), depthOrder.end(),
+                             [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+            for (size_t i = 0; i < depthOrder.size(); ++i)
+                updateList.Components[i] = depthOrder[i].second;
+
+            // Resolve which skin joints each component drives once, rather than searching the joint lists every frame
+            if (updateList.pSkinningData == nullptr || updateList.pSkinningData->m_pSkins == nullptr)
+                continue;
+
+            std::unordered_map<uint32_t, uint32_t> nodeToComponent;
+            for (uint32_t i = 0; i < static_cast<uint32_t>(updateList.Components.size()); ++i)
+                nodeToComponent[updateList.Components[i]->GetData()->m_nodeId] = i;
 
-            owner->SetPrevTransform(owner->GetTransform());
-            owner->SetTransform(globalTransform);
+            const std::vector<AnimationSkin*>& skins = *updateList.pSkinningData->m_pSkins;
+            for (uint32_t skinIdx = 0; skinIdx < static_cast<uint32_t>(skins.size()); ++skinIdx)
+            {
+                for (uint32_t jointIdx = 0; jointIdx < static_cast<uint32_t>(skins[skinIdx]->m_jointsNodeIdx.size()); ++jointIdx)
+                {
+                    auto componentIter = nodeToComponent.find(skins[skinIdx]->m_jointsNodeIdx[jointIdx]);
+                    if (componentIter != nodeToComponent.end())
+                        updateList.SkinJoints.push_back({ componentIter->second, skinIdx, jointIdx });
+                }
+            }
         }
 
+        m_UpdateListsDirty = false;
+    }
 
-        // Skinning
-        for (auto& component : m_ManagedComponents)
+    void AnimationComponentMgr::UpdateModel(ModelUpdateList& updateList, double time)
+    {
+        /*
+        * Currently supports only one Skin per Model. Most assets work this way but it's technically possible for a Model to have multiple Skins.
+        * If supporting these models is desired in the future, the following code needs to change.
+        */
+        const std::vector<AnimationSkin*>* pSkins = updateList.pSkinningData ? updateList.pSkinningData->m_pSkins : nullptr;
+        const int32_t skeletonId = (pSkins != nullptr && pSkins->size() > 0) ? static_cast<int32_t>(pSkins->at(0)->m_skeletonId) : -1;
+
+        // Update local and global transforms, parents are ordered first so their transforms are already current
+        updateList.NeedsUpdate = false;
+        for (auto* pComponent : updateList.Components)
         {
-            const auto& data = static_cast<const AnimationComponent*>(component)->GetData();
+            pComponent->Update(time);
 
-            // Animated models with no skinning
-            if (!m_skinningData[data->m_modelId].m_pSkins)
-                continue;
+            Entity*       pOwner  = pComponent->GetOwner();
+            Entity*       pParent = pOwner->GetParent();
+
+            Mat4 globalTransform = pComponent->GetLocalTransform();
+            if (pParent != nullptr && static_cast<int32_t>(pComponent->GetData()->m_nodeId) != skeletonId)
+                globalTransform = pParent->GetTransform() * globalTransform;
+
+            pOwner->SetPrevTransform(pOwner->GetTransform());
+            pOwner->SetTransform(globalTransform);
+        }
+
+        // Track the model's extent for update-rate LOD
+        if (!updateList.Components.empty())
+        {
+            updateList.Center = updateList.Components[0]->GetOwner()->GetTransform().getTranslation();
+            float radiusSquared = 0.f;
+            for (auto* pComponent : updateList.Components)
+                radiusSquared = std::max<float>(radiusSquared, math::lengthSqr(pComponent->GetOwner()->GetTransform().getTranslation() - updateList.Center));
+            updateList.Radius = std::sqrt(radiusSquared);
+        }
 
-            for (size_t skinIdx = 0; skinIdx < m_skinningData[data->m_modelId].m_pSkins->size(); ++skinIdx)
+        // Skinning
+        for (const SkinJoint& skinJoint : updateList.SkinJoints)
+        {
+            const AnimationSkin* pSkin  = pSkins->at(skinJoint.SkinIndex);
+            const Mat4*          pM     = reinterpret_cast<const Mat4*>(pSkin->m_InverseBindMatrices.Data.data());
+            const Entity*        pJoint = updateList.Components[skinJoint.ComponentIndex]->GetOwner();
+            updateList.pSkinningData->m_SkinningMatrices[skinJoint.SkinIndex][skinJoint.JointIndex].Set(pJoint->GetTransform() * pM[skinJoint.JointIndex]);
+        }
+
+        // CPU skinning needs all of the model's joints to be current
+        if (GetConfig()->CPUSkinning && pSkins != nullptr)
+        {
+            const SkinningMode mode = GetConfig()->CPUSkinningDualQuaternion ? SkinningMode::DualQuaternion : SkinningMode::LinearBlend;
+            for (auto* pComponent : updateList.Components)
             {
-                const AnimationSkin* skin = m_skinningData[data->m_modelId].m_pSkins->at(skinIdx);
+                const int32_t skinId = pComponent->GetData()->m_skinId;
+                if (skinId < 0 || skinId >= static_cast<int32_t>(updateList.pSkinningData->m_SkinningMatrices.size()))
+                    continue;
 
-                // if this node is in the target list of joints to be updated, update it
-                for (size_t i = 0; i < skin->m_jointsNodeIdx.size(); ++i)
-                {
-                    if (data->m_nodeId == skin->m_jointsNodeIdx[i])
-                    {
-                        const Mat4* pM = (Mat4*)skin->m_InverseBindMatrices.Data.data();
-                        m_skinningData[data->m_modelId].m_SkinningMatrices[skinIdx][i].Set(component->GetOwner()->GetTransform() * pM[i]);
-                    }
-                }
+                CPUSkinningStats stats = pComponent->UpdateCPUSkinning(updateList.pSkinningData->m_SkinningMatrices[skinId], mode);
+                m_CPUSkinnedVertices         += stats.VertexCount;
+                m_CPUSkinningBusyNanoseconds += static_cast<uint64_t>(stats.BusySeconds * 1e9);
             }
         }
     }
 
+    uint32_t AnimationComponentMgr::ComputeUpdateInterval(const ModelUpdateList& updateList, const CameraComponent* pCamera) const
+    {
+        if (!GetConfig()->AnimationUpdateLOD || updateList.NeedsUpdate || pCamera == nullptr || pCamera->GetData().Type != CameraType::Perspective)
+            return 1;
+
+        // Estimate the fraction of the screen height covered by the model
+        const float distance = math::length(updateList.Center - pCamera->GetCameraPos()) - updateList.Radius;
+        if (distance <= 0.f)
+            return 1;
+
+        const float projectedSize = updateList.Radius / (distance * std::tan(pCamera->GetFovY() * 0.5f));
+        if (projectedSize >= s_HalfRateProjectedSize)
+            return 1;
+        return projectedSize >= s_QuarterRateProjectedSize ? 2 : 4;
+    }
+
+    void AnimationComponentMgr::HoldModel(ModelUpdateList& updateList)
+    {
+        // The pose doesn't change this frame, previous transforms must match the current ones so motion vectors stay valid
+        for (auto* pComponent : updateList.Components)
+        {
+            Entity* pOwner = pComponent->GetOwner();
+            pOwner->SetPrevTransform(pOwner->GetTransform());
+        }
+
+        for (const SkinJoint& skinJoint : updateList.SkinJoints)
+        {
+            MatrixPair& skinningMatrix = updateList.pSkinningData->m_SkinningMatrices[skinJoint.SkinIndex][skinJoint.JointIndex];
+            skinningMatrix.Set(skinningMatrix.m_Current);
+        }
+    }
+
+    void AnimationComponentMgr::UpdateComponents(double deltaTime)
+    {
+        m_AnimationTime += deltaTime * m_PlaybackRate;
+
+        if (m_UpdateListsDirty)
+            BuildUpdateLists();
+
+        // Models are independent of each other, spread them over the task manager's threads. Models on a reduced
+        // update rate are staggered by their ID so their updates don't all land on the same frame.
+        const double           time    = m_AnimationTime;
+        const uint64_t         frameID = GetFramework()->GetFrameID();
+        const CameraComponent* pCamera = GetScene()->GetCurrentCamera();
+        GetTaskManager()->ParallelFor(static_cast<uint32_t>(m_UpdateLists.size()), [this, time, frameID, pCamera](uint32_t listIndex) {
+            ModelUpdateList& updateList = m_UpdateLists[listIndex];
+            updateList.UpdateInterval   = ComputeUpdateInterval(updateList, pCamera);
+            if ((frameID + updateList.ModelId) % updateList.UpdateInterval == 0)
+                UpdateModel(updateList, time);
+            else
+                HoldModel(updateList);
+        });
+    }
+
     void AnimationComponent::Update(double time)
     {
-        UpdateLocalMatrix(0, static_cast<float>(time));
+        UpdateLocalMatrix(0, time);
+    }
+
+    CPUSkinningStats AnimationComponent::UpdateCPUSkinning(const std::vector<MatrixPair>& skinningMatrices, SkinningMode mode)
+    {
+        CPUSkinningStats stats;
+        const Mesh* pMesh = m_pData->m_pSkinnedMesh;
+        if (pMesh == nullptr)
+            return stats;
+
+        m_CPUSkinnedSurfaces.resize(pMesh->GetNumSurfaces());
+        for (size_t i = 0; i < pMesh->GetNumSurfaces(); ++i)
+        {
+            const CPUSkinningSource* pSource = pMesh->GetSurface(static_cast<uint32_t>(i))->GetCPUSkinningSource();
+            if (pSource == nullptr)
+                continue;
+
+            CPUSkinningStats surfaceStats = CPUSkinning::Skin(*pSource, skinningMatrices, mode, m_CPUSkinnedSurfaces[i]);
+            stats.VertexCount += surfaceStats.VertexCount;
+            stats.BusySeconds += surfaceStats.BusySeconds;
+            stats.ThreadCount  = std::max<uint32_t>(stats.ThreadCount, surfaceStats.ThreadCount);
+        }
+
+        return stats;
     }
 
 } // namespace cauldron
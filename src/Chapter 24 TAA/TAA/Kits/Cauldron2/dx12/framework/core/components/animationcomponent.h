@@ -27,12 +27,16 @@
 
 #include "../../misc/math.h"
 #include "../../render/animation.h"
+#include "../../render/cpuskinning.h"
 
 #include <assert.h>
+#include <atomic>
+#include <vector>
 
 namespace cauldron
 {
     class AnimationComponent;
+    class CameraComponent;
     class GLTFLoader;
 
     /**
@@ -88,10 +92,42 @@ namespace cauldron
         void Shutdown() override;
 
         /**
-         * @brief   Updates all managed components.
+         * @brief   Advances the animation clock and updates all managed components. Models are updated in parallel
+         *          on the task manager's threads. With update-rate LOD enabled, models that are small on screen only
+         *          update their pose every few frames.
          */
         void UpdateComponents(double deltaTime) override;
 
+        /**
+         * @brief   Starts managing an <c><i>AnimationComponent</i></c> and flags the update lists for rebuild.
+         */
+        void StartManagingComponent(Component* pComponent) override;
+
+        /**
+         * @brief   Stops managing an <c><i>AnimationComponent</i></c> and flags the update lists for rebuild.
+         */
+        void StopManagingComponent(Component* pComponent) override;
+
+        /**
+         * @brief   Returns the current time of the animation clock (in seconds).
+         */
+        double GetAnimationTime() const { return m_AnimationTime; }
+
+        /**
+         * @brief   Sets the current time of the animation clock (in seconds).
+         */
+        void SetAnimationTime(double time) { m_AnimationTime = time; }
+
+        /**
+         * @brief   Returns the rate at which the animation clock advances relative to frame time.
+         */
+        double GetPlaybackRate() const { return m_PlaybackRate; }
+
+        /**
+         * @brief   Sets the rate at which the animation clock advances relative to frame time (0 pauses animations).
+         */
+        void SetPlaybackRate(double rate) { m_PlaybackRate = rate; }
+
         /**
          * @brief   Component manager instance accessor.
          */
@@ -105,12 +141,51 @@ namespace cauldron
             return m_skinningData.at(modelId).m_SkinningMatrices[skinId];
         }
 
+        /**
+         * @brief   Registers the skins of a model and allocates the skinning matrices its components drive.
+         *          The skins must outlive the model's components.
+         */
+        void RegisterModelSkins(uint32_t modelId, const std::vector<AnimationSkin*>* pSkins);
+
     private:
+        // Joint of a skin driven by one of the components of a model update list
+        struct SkinJoint
+        {
+            uint32_t ComponentIndex;
+            uint32_t SkinIndex;
+            uint32_t JointIndex;
+        };
+
+        // All the components of a model, with parents ordered before their children
+        struct ModelUpdateList
+        {
+            uint32_t                         ModelId        = 0;
+            SkinningData*                    pSkinningData  = nullptr;
+            std::vector<AnimationComponent*> Components     = {};
+            std::vector<SkinJoint>           SkinJoints     = {};
+
+            // Update-rate LOD
+            Vec3                             Center         = Vec3(0.f, 0.f, 0.f);  // Bounds of the joints as of the last update
+            float                            Radius         = 0.f;
+            uint32_t                         UpdateInterval = 1;                    // Frames between pose updates
+            bool                             NeedsUpdate    = true;                 // Set until the first update happened
+        };
+
+        void BuildUpdateLists();
+        uint32_t ComputeUpdateInterval(const ModelUpdateList& updateList, const CameraComponent* pCamera) const;
+        void UpdateModel(ModelUpdateList& updateList, double time);
+        void HoldModel(ModelUpdateList& updateList);
+
         // <ModelID, SkinningData>
         std::unordered_map<uint32_t, SkinningData>     m_skinningData = {};
         static AnimationComponentMgr* s_pComponentManager;
 
-        friend class GLTFLoader;
+        std::vector<ModelUpdateList> m_UpdateLists      = {};
+        bool                         m_UpdateListsDirty = true;
+        std::atomic<uint64_t>        m_CPUSkinnedVertices       = { 0 };
+        std::atomic<uint64_t>        m_CPUSkinningBusyNanoseconds = { 0 };
+        double                       m_AnimationTime    = 0.0;
+        double                       m_PlaybackRate     = 1.0;
     };
 
     /**
@@ -132,6 +207,7 @@ namespace cauldron
         std::vector<VertexBufferInformation> m_skinnedNormals;
         std::vector<VertexBufferInformation> m_skinnedPreviousPosition;
         BLAS*                                m_animatedBlas = nullptr;
+        const Mesh*                          m_pSkinnedMesh = nullptr;   ///< Mesh skinned by this component (if any)
     };
 
     /**
@@ -175,14 +251,30 @@ namespace cauldron
          */
         void Update(double deltaTime) override;
 
+        /**
+         * @brief   Skins the surfaces of the component's skinned mesh on the CPU with the provided skinning matrices.
+         *          Only surfaces that retained a <c><i>CPUSkinningSource</i></c> are skinned.
+         */
+        CPUSkinningStats UpdateCPUSkinning(const std::vector<MatrixPair>& skinningMatrices, SkinningMode mode);
+
+        /**
+         * @brief   Returns the CPU skinned data of each surface of the component's skinned mesh (as of the last CPU skinning update).
+         */
+        const std::vector<CPUSkinningResult>& GetCPUSkinnedSurfaces() const { return m_CPUSkinnedSurfaces; }
+
     private:
 
         AnimationComponent() = delete;
 
-        void UpdateLocalMatrix(uint32_t animationIndex, float time);
+        void UpdateLocalMatrix(uint32_t animationIndex, double time);
 
         Mat4 m_localTransform = Mat4::identity();
 
+        std::vector<CPUSkinningResult> m_CPUSkinnedSurfaces = {};
+
+        // Keyframe cursors of the sampled channel, so sampling steps forward from the previous frame's keys
+        AnimCursor m_AnimCursors[static_cast<uint32_t>(AnimChannel::ComponentSampler::Count)];
+
         // Keep a pointer on our initialization data for matrix reconstruction
         AnimationComponentData* m_pData;
     };
@@ -25,16 +25,69 @@
 #include "entity.h"
 #include "framework.h"
 #include "taskmanager.h"
+#include "components/meshcomponent.h"
 #include "loaders/gltfloader.h"
 #include "scene.h"
 #include "../misc/assert.h"
+#include "../misc/contentresidency.h"
+#include "../render/buffer.h"
+#include "../render/animation.h"
 #include "../render/material.h"
+#include "../render/mesh.h"
 #include "../render/texture.h"
 
+#include <algorithm>
+
 using namespace std::experimental;
 
 namespace cauldron
 {
+    // Estimates the GPU memory of a texture including its mip chain (block compressed formats are counted at a byte per texel)
+    static uint64_t EstimateTextureBytes(const TextureDesc& desc)
+    {
+        const uint64_t texelSize = std::max<uint32_t>(GetResourceFormatStride(desc.Format), 1);
+        uint64_t textureBytes = 0;
+        uint32_t width  = desc.Width;
+        uint32_t height = desc.Height;
+        for (uint32_t mip = 0; mip < std::max<uint32_t>(desc.MipLevels, 1); ++mip)
+        {
+            textureBytes += static_cast<uint64_t>(width) * height * texelSize;
+            width  = std::max<uint32_t>(width >> 1, 1);
+            height = std::max<uint32_t>(height >> 1, 1);
+        }
+        return textureBytes * std::max<uint32_t>(desc.DepthOrArraySize, 1);
+    }
+
+    // Conservative frustum test, boxes are only rejected when entirely outside one of the side planes or behind the camera
+    static bool IsBoundsVisible(const BoundingBox& bounds, const Mat4& viewProjection)
+    {
+        const Vec4 boundsMin = bounds.GetMin();
+        const Vec4 boundsMax = bounds.GetMax();
+
+        uint32_t outsideCount[5] = { 0 };
+        for (uint32_t corner = 0; corner < 8; ++corner)
+        {
+            Vec4 position((corner & 0x1) ? boundsMax.getX() : boundsMin.getX(),
+                          (corner & 0x2) ? boundsMax.getY() : boundsMin.getY(),
+                          (corner & 0x4) ? boundsMax.getZ() : boundsMin.getZ(), 1.f);
+            Vec4 clipPosition = viewProjection * position;
+
+            const float w = clipPosition.getW();
+            outsideCount[0] += clipPosition.getX() < -w ? 1 : 0;
+            outsideCount[1] += clipPosition.getX() > w ? 1 : 0;
+            outsideCount[2] += clipPosition.getY() < -w ? 1 : 0;
+            outsideCount[3] += clipPosition.getY() > w ? 1 : 0;
+            outsideCount[4] += w <= 0.f ? 1 : 0;
+        }
+
+        for (uint32_t plane = 0; plane < 5; ++plane)
+        {
+            if (outsideCount[plane] == 8)
+                return false;
+        }
+        return true;
+    }
+
     ContentManager::ContentManager()
     {
         // Init our content loaders
@@ -64,11 +117,15 @@ namespace cauldron
         // Delete all the data (will also unload textures)
         DeleteUnloadedContent(0);
 
-        // Remove remaining texture content
-        for (auto texIter = m_LoadedTextureContent.begin(); texIter != m_LoadedTextureContent.end(); ++texIter)
-            delete texIter->second;
+        // Remove remaining texture content (textures can be referenced under several names)
+        for (auto texIter = m_ManagedTextures.begin(); texIter != m_ManagedTextures.end(); ++texIter)
+            delete texIter->first;
+        m_ManagedTextures.clear();
+        m_TextureContentHashes.clear();
         m_LoadedTextureContent.clear();
 
+        CauldronAssert(ASSERT_WARNING, m_ManagedBuffers.empty(), L"%d shared buffers are still referenced at shutdown", static_cast<int>(m_ManagedBuffers.size()));
+
     }
 
     void ContentManager::LoadGLTFToScene(filesystem::path& gltfFile)
@@ -81,6 +138,13 @@ namespace cauldron
             // Increment content load count to track
             ++m_ActiveContentLoads;
 
+            // glTF content can be evicted and reloaded from its source file when over budget
+            {
+                std::lock_guard<std::mutex> lock(m_ContentChangeMutex);
+                m_ReloadableContent.insert(gltfFile.c_str());
+                m_ContentLoadStartTimes[gltfFile.c_str()] = std::chrono::steady_clock::now();
+            }
+
             pLoader->LoadAsync(&gltfFile);
         }
 
@@ -146,15 +210,116 @@ namespace cauldron
         }
     }
 
-    bool ContentManager::StartManagingContent(std::wstring contentName, Texture*& pTextureContent)
+    bool ContentManager::StartManagingContent(std::wstring contentName, Texture*& pTextureContent, uint64_t contentHash/*=0*/)
     {
         // Decrement texture load count
         --m_ActiveTextureLoads;
 
         // Lock while we are making changes to content as this happens from multiple threads
         std::lock_guard<std::mutex>    lock(m_ContentChangeMutex);
+
+        // The same content may have finished loading under another name in the meantime, reference it instead
+        auto hashIter = contentHash ? m_TextureContentHashes.find(contentHash) : m_TextureContentHashes.end();
+        if (hashIter != m_TextureContentHashes.end())
+        {
+            ManagedTexture& managedTexture = m_ManagedTextures[hashIter->second];
+            ++managedTexture.RefCount;
+            if (m_LoadedTextureContent.emplace(std::make_pair(contentName, hashIter->second)).second)
+                managedTexture.Names.push_back(contentName);
+            return false;
+        }
+
         std::pair<std::map<std::wstring, Texture*>::iterator, bool> results = m_LoadedTextureContent.emplace(std::make_pair(contentName, pTextureContent));
-        return results.second;
+        if (!results.second)
+        {
+            ++m_ManagedTextures[results.first->second].RefCount;
+            return false;
+        }
+
+        ManagedTexture& managedTexture = m_ManagedTextures[pTextureContent];
+        managedTexture.ContentHash = contentHash;
+        managedTexture.RefCount    = 1;
+        managedTexture.Names.push_back(contentName);
+        if (contentHash)
+            m_TextureContentHashes.emplace(contentHash, pTextureContent);
+        return true;
+    }
+
+    const Texture* ContentManager::AcquireTexture(uint64_t contentHash, const std::wstring& contentName, size_t sourceDataSize)
+    {
+        std::lock_guard<std::mutex>    lock(m_ContentChangeMutex);
+        auto hashIter = m_TextureContentHashes.find(contentHash);
+        if (hashIter == m_TextureContentHashes.end())
+            return nullptr;
+
+        ManagedTexture& managedTexture = m_ManagedTextures[hashIter->second];
+        ++managedTexture.RefCount;
+        if (m_LoadedTextureContent.emplace(std::make_pair(contentName, hashIter->second)).second)
+            managedTexture.Names.push_back(contentName);
+
+        // This counts as a completed load
+        --m_ActiveTextureLoads;
+        m_DeduplicatedBytes += sourceDataSize;
+        return hashIter->second;
+    }
+
+    void ContentManager::ReleaseTexture(const Texture* pTexture)
+    {
+        // Must be called with m_ContentChangeMutex held
+        auto managedIter = m_ManagedTextures.find(pTexture);
+        CauldronAssert(ASSERT_ERROR, managedIter != m_ManagedTextures.end(), L"Could not find texture %ls to unload", pTexture->GetDesc().Name.c_str());
+        if (managedIter == m_ManagedTextures.end() || --managedIter->second.RefCount > 0)
+            return;
+
+        for (const std::wstring& name : managedIter->second.Names)
+            m_LoadedTextureContent.erase(name);
+        if (managedIter->second.ContentHash)
+            m_TextureContentHashes.erase(managedIter->second.ContentHash);
+
+        delete pTexture;
+        m_ManagedTextures.erase(managedIter);
+    }
+
+    Buffer* ContentManager::AcquireBuffer(uint64_t contentHash)
+    {
+        std::lock_guard<std::mutex>    lock(m_SharedBufferMutex);
+        auto hashIter = m_BufferContentHashes.find(contentHash);
+        if (hashIter == m_BufferContentHashes.end())
+            return nullptr;
+
+        ManagedBuffer& managedBuffer = m_ManagedBuffers[hashIter->second];
+        ++managedBuffer.RefCount;
+        m_DeduplicatedBytes += managedBuffer.DataSize;
+        return hashIter->second;
+    }
+
+    bool ContentManager::StartManagingContent(uint64_t contentHash, Buffer* pBufferContent, size_t dataSize)
+    {
+        std::lock_guard<std::mutex>    lock(m_SharedBufferMutex);
+        if (!m_BufferContentHashes.emplace(contentHash, pBufferContent).second)
+            return false;
+
+        ManagedBuffer& managedBuffer = m_ManagedBuffers[pBufferContent];
+        managedBuffer.ContentHash = contentHash;
+        managedBuffer.RefCount    = 1;
+        managedBuffer.DataSize    = dataSize;
+        return true;
+    }
+
+    bool ContentManager::ReleaseBuffer(const Buffer* pBufferContent)
+    {
+        std::lock_guard<std::mutex>    lock(m_SharedBufferMutex);
+        auto managedIter = m_ManagedBuffers.find(pBufferContent);
+        if (managedIter == m_ManagedBuffers.end())
+            return false;
+
+        if (--managedIter->second.RefCount == 0)
+        {
+            m_BufferContentHashes.erase(managedIter->second.ContentHash);
+            m_ManagedBuffers.erase(managedIter);
+            delete pBufferContent;
+        }
+        return true;
     }
 
     const Texture* ContentManager::GetTexture(const std::wstring& contentName)
@@ -187,9 +352,38 @@ namespace cauldron
         CauldronAssert(ASSERT_ERROR, std::this_thread::get_id() != GetFramework()->MainThreadID() || !GetFramework()->IsRunning(), L"Performance Warning: Using std::map::emplace on the main thread while app is running.");
         std::pair<std::map<std::wstring, Content*>::iterator, bool> results = m_LoadedContentBlocks.emplace(std::make_pair(contentName, pContent));
 
+        // Content that was evicted is resident again
+        m_EvictedContent.erase(contentName);
+
+        // Record how long the load took, files loaded before are likely in the OS file cache so count them as warm
+        auto startTimeIter = m_ContentLoadStartTimes.find(contentName);
+        if (startTimeIter != m_ContentLoadStartTimes.end())
+        {
+            const double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTimeIter->second).count();
+            const bool   warmLoad    = !m_PreviouslyLoadedContent.insert(contentName).second;
+            if (warmLoad)
+            {
+                ++m_ContentLoadStats.WarmLoadCount;
+                m_ContentLoadStats.WarmLoadSeconds += loadSeconds;
+            }
+            else
+            {
+                ++m_ContentLoadStats.ColdLoadCount;
+                m_ContentLoadStats.ColdLoadSeconds += loadSeconds;
+            }
+            Log::Write(LOGLEVEL_TRACE, L"Loaded %ls in %.3f seconds (%ls)", contentName.c_str(), loadSeconds, warmLoad ? L"warm" : L"cold");
+            m_ContentLoadStartTimes.erase(startTimeIter);
+        }
+
         return results.second;
     }
 
+    ContentManager::ContentLoadStats ContentManager::GetContentLoadStats()
+    {
+        std::lock_guard<std::mutex> lock(m_ContentChangeMutex);
+        return m_ContentLoadStats;
+    }
+
     void ContentManager::UnloadContent(const std::wstring& contentName)
     {
         // lock to delete the block
@@ -199,6 +393,10 @@ namespace cauldron
         auto iter = m_LoadedContentBlocks.find(contentName);
         if (iter != m_LoadedContentBlocks.end())
             iter->second->State = ContentBlockState::ToDelete;
+
+        // Explicitly unloaded content must not come back
+        m_EvictedContent.erase(contentName);
+        m_ReloadableContent.erase(contentName);
     }
 
     void ContentManager::UpdateContent(uint64_t currentFrame)
@@ -216,6 +414,7 @@ namespace cauldron
                 // Complete the loading of the content block (component management, scene additions, etc.)
                 CompleteContentBlockLoad(it->second);
                 it->second->State = ContentBlockState::Ready;
+                it->second->LastUsedFrame = currentFrame;
                 ++it;
             }
             else if (it->second->State == ContentBlockState::ToDelete)
@@ -232,10 +431,12 @@ namespace cauldron
             }
         }
 
+        UpdateResidency(currentFrame);
+
         if (!m_ContentToUnload.empty() && (*m_ContentToUnload.begin())->FrameStamp <= frameToUnload)
         {
             // schedule the task to delete everything
-            Task unloadingTask(std::bind(&ContentManager::DeleteUnloadedContent, this, frameToUnload), nullptr);
+            Task unloadingTask([this, frameToUnload](void*) { DeleteUnloadedContent(frameToUnload); });
             GetTaskManager()->AddTask(unloadingTask);
         }
     }
@@ -251,6 +452,168 @@ namespace cauldron
 
         // add all the content block's entities to the scene
         GetScene()->AddContentBlockEntities(pContent->pBlock);
+
+        ComputeContentResidency(pContent);
+    }
+
+    void ContentManager::ComputeContentResidency(Content* pContent)
+    {
+        const ContentBlock* pBlock = pContent->pBlock;
+
+        // Resources shared with other blocks are counted for each of them, which keeps the budget conservative
+        pContent->GPUBytes = 0;
+        for (const Texture* pTexture : pBlock->TextureAssets)
+        {
+            if (pTexture)
+                pContent->GPUBytes += EstimateTextureBytes(pTexture->GetDesc());
+        }
+
+        for (const Mesh* pMesh : pBlock->Meshes)
+        {
+            for (uint32_t i = 0; pMesh && i < pMesh->GetNumSurfaces(); ++i)
+            {
+                const Surface* pSurface = pMesh->GetSurface(i);
+                for (uint32_t type = 0; type < static_cast<uint32_t>(VertexAttributeType::Count); ++type)
+                {
+                    const Buffer* pBuffer = pSurface->GetVertexBuffer(static_cast<VertexAttributeType>(type)).pBuffer;
+                    if (pBuffer)
+                        pContent->GPUBytes += pBuffer->GetDesc().Size;
+                }
+                if (pSurface->GetIndexBuffer().pBuffer)
+                    pContent->GPUBytes += pSurface->GetIndexBuffer().pBuffer->GetDesc().Size;
+            }
+        }
+
+        pContent->CPUBytes = 0;
+        for (const Animation* pAnimation : pBlock->Animations)
+        {
+            for (uint32_t i = 0; pAnimation && i < pAnimation->GetNumAnimationChannels(); ++i)
+                pContent->CPUBytes += pAnimation->GetAnimationChannel(i)->GetDataSize();
+        }
+
+        // World space bounds of the block's meshes, used to know when the content is in view
+        pContent->Bounds.Reset();
+        for (const EntityDataBlock* pEntityDataBlock : pBlock->EntityDataBlocks)
+        {
+            const MeshComponent* pMeshComponent = pEntityDataBlock->pEntity->GetComponent<const MeshComponent>(MeshComponentMgr::Get());
+            if (pMeshComponent == nullptr)
+                continue;
+
+            const Mat4& transform = pEntityDataBlock->pEntity->GetTransform();
+            const Mesh* pMesh     = pMeshComponent->GetData().pMesh;
+            for (uint32_t i = 0; i < pMesh->GetNumSurfaces(); ++i)
+            {
+                const Vec4 center = pMesh->GetSurface(i)->Center();
+                const Vec4 radius = pMesh->GetSurface(i)->Radius();
+                for (uint32_t corner = 0; corner < 8; ++corner)
+                {
+                    Vec4 offset((corner & 0x1) ? radius.getX() : -radius.getX(),
+                                (corner & 0x2) ? radius.getY() : -radius.getY(),
+                                (corner & 0x4) ? radius.getZ() : -radius.getZ(), 0.f);
+                    pContent->Bounds.Grow(transform * (center + offset));
+                }
+            }
+        }
+
+        m_ResidentGPUBytes += pContent->GPUBytes;
+        m_ResidentCPUBytes += pContent->CPUBytes;
+    }
+
+    void ContentManager::MarkContentUsed(const std::wstring& contentName)
+    {
+        std::lock_guard<std::mutex> lock(m_ContentChangeMutex);
+
+        auto iter = m_LoadedContentBlocks.find(contentName);
+        if (iter != m_LoadedContentBlocks.end())
+        {
+            iter->second->LastUsedFrame = GetFramework()->GetFrameID();
+            return;
+        }
+
+        auto evictedIter = m_EvictedContent.find(contentName);
+        if (evictedIter != m_EvictedContent.end())
+            evictedIter->second.Requested = true;
+    }
+
+    void ContentManager::UpdateResidency(uint64_t currentFrame)
+    {
+        // Must be called with m_ContentChangeMutex held
+
+        // Flag everything the current camera can see as used this frame
+        const CameraComponent* pCamera = GetScene()->GetCurrentCamera();
+        for (auto& loadedContent : m_LoadedContentBlocks)
+        {
+            Content* pContent = loadedContent.second;
+            if (pContent->State == ContentBlockState::Ready && (!pCamera || pContent->Bounds.IsEmpty() || IsBoundsVisible(pContent->Bounds, pCamera->GetViewProjection())))
+                pContent->LastUsedFrame = currentFrame;
+        }
+
+        const uint64_t memoryBudget = GetConfig()->ContentMemoryBudget;
+        if (!memoryBudget)
+            return;
+
+        // Reload evicted content that is needed again. Explicit requests go first, then visible content from closest to furthest.
+        std::vector<EvictedContentInfo> evictedInfos;
+        std::vector<std::map<std::wstring, EvictedContent>::iterator> evictedIters;
+        for (auto it = m_EvictedContent.begin(); it != m_EvictedContent.end(); ++it)
+        {
+            EvictedContentInfo info;
+            info.Requested = it->second.Requested;
+            info.Reloading = it->second.Reloading;
+            if (pCamera && IsBoundsVisible(it->second.Bounds, pCamera->GetViewProjection()))
+            {
+                info.Visible  = true;
+                info.Distance = length(it->second.Bounds.GetCenter().getXYZ() - pCamera->GetCameraPos());
+            }
+            evictedInfos.push_back(info);
+            evictedIters.push_back(it);
+        }
+
+        ContentLoader* pLoader = m_ContentLoaders[static_cast<uint32_t>(LoaderType::GLTF)];
+        for (size_t reloadIndex : SelectContentToReload(evictedInfos))
+        {
+            const std::wstring& contentName = evictedIters[reloadIndex]->first;
+            evictedIters[reloadIndex]->second.Reloading = true;
+            Log::Write(LOGLEVEL_TRACE, L"Reloading evicted content %ls", contentName.c_str());
+
+            ++m_ActiveContentLoads;
+            m_ContentLoadStartTimes[contentName] = std::chrono::steady_clock::now();
+            filesystem::path contentPath(contentName);
+            pLoader->LoadAsync(&contentPath);
+        }
+
+        // Evict least recently used content until we are back within budget
+        std::vector<ResidentContentInfo> residentInfos;
+        std::vector<std::map<std::wstring, Content*>::iterator> residentIters;
+        for (auto it = m_LoadedContentBlocks.begin(); it != m_LoadedContentBlocks.end(); ++it)
+        {
+            ResidentContentInfo info;
+            info.Bytes         = it->second->GPUBytes + it->second->CPUBytes;
+            info.LastUsedFrame = it->second->LastUsedFrame;
+            info.Evictable     = it->second->State == ContentBlockState::Ready && m_ReloadableContent.count(it->first);
+            residentInfos.push_back(info);
+            residentIters.push_back(it);
+        }
+
+        bool overBudget = false;
+        for (size_t evictIndex : SelectContentToEvict(residentInfos, m_ResidentGPUBytes + m_ResidentCPUBytes, memoryBudget, currentFrame, overBudget))
+        {
+            auto lruIter = residentIters[evictIndex];
+            Log::Write(LOGLEVEL_TRACE, L"Evicting content %ls (%llu KB, last used on frame %llu)", lruIter->first.c_str(),
+                       (lruIter->second->GPUBytes + lruIter->second->CPUBytes) >> 10, lruIter->second->LastUsedFrame);
+
+            EvictedContent& evicted = m_EvictedContent[lruIter->first];
+            evicted = EvictedContent();
+            evicted.Bounds = lruIter->second->Bounds;
+
+            // The actual deletion happens asynchronously once the GPU is done with the content
+            UnloadContentBlock(lruIter->second, currentFrame);
+            m_LoadedContentBlocks.erase(lruIter);
+        }
+
+        if (overBudget && !m_BudgetExceededWarned)
+            CauldronWarning(L"Content in use exceeds the content memory budget (%llu MB resident).", (m_ResidentGPUBytes + m_ResidentCPUBytes) >> 20);
+        m_BudgetExceededWarned = overBudget;
     }
 
     void ContentManager::UnloadContentBlock(Content* pContent, uint64_t currentFrame)
@@ -268,6 +631,11 @@ namespace cauldron
         // Tag the unload request frame
         pContent->FrameStamp = currentFrame;
 
+        // No longer counts towards the content memory budget
+        m_ResidentGPUBytes -= pContent->GPUBytes;
+        m_ResidentCPUBytes -= pContent->CPUBytes;
+        pContent->GPUBytes = pContent->CPUBytes = 0;
+
         // add the content to the list of content blocks which will be deleted
         m_ContentToUnload.push_back(pContent);
     }
@@ -302,16 +670,11 @@ namespace cauldron
                 for (auto pListener : m_ContentListeners)
                     pListener->OnContentUnloaded((*it)->pBlock);
 
-                // Remove all textures in the content block
+                // Release the content block's references to its textures (shared textures stay alive for other blocks)
                 for (auto texIter = (*it)->pBlock->TextureAssets.begin(); texIter != (*it)->pBlock->TextureAssets.end(); ++texIter)
                 {
-                    auto findItr = m_LoadedTextureContent.find((*texIter)->GetDesc().Name);
-                    CauldronAssert(ASSERT_ERROR, findItr != m_LoadedTextureContent.end(), L"Could not find texture %ls to unload", (*texIter)->GetDesc().Name.c_str());
-                    if (findItr != m_LoadedTextureContent.end())
-                    {
-                        delete findItr->second;
-                        m_LoadedTextureContent.erase(findItr);
-                    }
+                    if (*texIter)
+                        ReleaseTexture(*texIter);
                 }
 
                 // Delete the content
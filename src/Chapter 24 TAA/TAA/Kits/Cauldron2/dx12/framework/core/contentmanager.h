@@ -25,20 +25,25 @@
 #include "contentloader.h"
 #include "loaders/textureloader.h"
 #include "loaders/particleloader.h"
+#include "scene.h"
 #include "../misc/helpers.h"
 #include "../render/texture.h"
 
 #define _SILENCE_EXPERIMENTAL_FILESYSTEM_DEPRECATION_WARNING    // To avoid receiving deprecation error since we are using C++11 only
+#include <chrono>
 #include <experimental/filesystem>
 
 #include <map>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 namespace cauldron
 {
+    class Buffer;
+
     /**
      * @enum LoaderType
      *
@@ -129,9 +134,58 @@ namespace cauldron
 
         /**
          * @brief   Tells the content manager it can start managing the texture content once it's been 
-         *          fully loaded and initialized.
+         *          fully loaded and initialized. A non-zero content hash makes the texture available to
+         *          <c><i>AcquireTexture</i></c>. Returns false if the texture is a duplicate, in which case the
+         *          previously loaded texture is referenced instead and the caller should delete its own.
+         */
+        bool StartManagingContent(std::wstring contentName, Texture*& pTextureContent, uint64_t contentHash = 0);
+
+        /**
+         * @brief   Looks for an already loaded texture with the provided content hash (source data and load options).
+         *          If one is found it gets referenced under contentName, counts as a completed texture load and is returned,
+         *          so the caller can skip all decode work. Returns nullptr otherwise.
+         */
+        const Texture* AcquireTexture(uint64_t contentHash, const std::wstring& contentName, size_t sourceDataSize);
+
+        /**
+         * @brief   Looks for an already uploaded buffer with the provided content hash (data and layout). If one is
+         *          found it gets an additional reference and is returned, otherwise returns nullptr.
+         */
+        Buffer* AcquireBuffer(uint64_t contentHash);
+
+        /**
+         * @brief   Makes a fully uploaded buffer shareable through <c><i>AcquireBuffer</i></c>, taking ownership of it.
+         *          Returns false if a buffer with the same content is already managed, in which case ownership stays with the caller.
          */
-        bool StartManagingContent(std::wstring contentName, Texture*& pTextureContent);
+        bool StartManagingContent(uint64_t contentHash, Buffer* pBufferContent, size_t dataSize);
+
+        /**
+         * @brief   Releases a reference to a managed buffer, deleting it once no longer referenced.
+         *          Returns false if the buffer isn't managed by the content manager.
+         */
+        bool ReleaseBuffer(const Buffer* pBufferContent);
+
+        /**
+         * @brief   Returns the number of bytes that didn't need to be loaded thanks to content deduplication.
+         */
+        uint64_t GetDeduplicatedBytes() const { return m_DeduplicatedBytes; }
+
+        /**
+         * @brief   Load timings of glTF content. The first load of a file in the process is counted as cold,
+         *          loads of files that were loaded before (reloads of evicted content) are counted as warm.
+         */
+        struct ContentLoadStats
+        {
+            uint32_t ColdLoadCount = 0;
+            uint32_t WarmLoadCount = 0;
+            double   ColdLoadSeconds = 0.0;    ///< Summed over all cold loads
+            double   WarmLoadSeconds = 0.0;    ///< Summed over all warm loads
+        };
+
+        /**
+         * @brief   Returns the load timings of all glTF content loaded so far.
+         */
+        ContentLoadStats GetContentLoadStats();
 
         /**
          * @brief   Fetches the requested texture. Returns nullptr if texture isn't found.
@@ -151,9 +205,22 @@ namespace cauldron
 
         /**
          * @brief   Manages the loading state of content as it flows through loading and unloading.
+         *          Also records which content is in use for the frame and, when a content memory budget is set,
+         *          evicts least recently used content and reloads evicted content once it is needed again.
          */
         void UpdateContent(uint64_t currentFrame);
 
+        /**
+         * @brief   Flags content as used for the current frame (content visible to the current camera is flagged automatically).
+         *          Evicted content gets reloaded, ahead of content only needed because it became visible.
+         */
+        void MarkContentUsed(const std::wstring& contentName);
+
+        /**
+         * @brief   Returns the GPU and CPU bytes currently held by resident content blocks.
+         */
+        void GetResidentBytes(uint64_t& gpuBytes, uint64_t& cpuBytes) const { gpuBytes = m_ResidentGPUBytes; cpuBytes = m_ResidentCPUBytes; }
+
         /**
          * @brief   Registers a <c><i>ContentListener</i></c>-derived class for content load/unload callbacks.
          */
@@ -190,12 +257,22 @@ namespace cauldron
             uint64_t            FrameStamp = -1;
             ContentBlock*       pBlock = nullptr;
 
+            // Residency tracking
+            uint64_t            GPUBytes = 0;
+            uint64_t            CPUBytes = 0;
+            uint64_t            LastUsedFrame = 0;
+            BoundingBox         Bounds;
+
             Content() = default;
 
             Content(Content&& moveInst) noexcept :
                 State(moveInst.State),
                 FrameStamp(moveInst.FrameStamp),
-                pBlock(moveInst.pBlock)
+                pBlock(moveInst.pBlock),
+                GPUBytes(moveInst.GPUBytes),
+                CPUBytes(moveInst.CPUBytes),
+                LastUsedFrame(moveInst.LastUsedFrame),
+                Bounds(moveInst.Bounds)
             {
                 moveInst.pBlock = nullptr;  // Has been moved
             }
@@ -210,16 +287,61 @@ namespace cauldron
         void UnloadContentBlock(Content* pContent, uint64_t currentFrame);
 
         void DeleteUnloadedContent(uint64_t frameToUnload);
+        void ReleaseTexture(const Texture* pTexture);
+
+        void ComputeContentResidency(Content* pContent);
+        void UpdateResidency(uint64_t currentFrame);
+
+        // Content that was evicted to stay within budget and can be reloaded from its source
+        struct EvictedContent
+        {
+            BoundingBox Bounds;
+            bool        Requested = false;
+            bool        Reloading = false;
+        };
+
+        // Managed textures can be referenced under several names and by several content blocks
+        struct ManagedTexture
+        {
+            uint64_t                    ContentHash = 0;
+            uint32_t                    RefCount = 0;
+            std::vector<std::wstring>   Names = {};
+        };
+
+        struct ManagedBuffer
+        {
+            uint64_t                    ContentHash = 0;
+            uint32_t                    RefCount = 0;
+            size_t                      DataSize = 0;
+        };
 
         std::vector<ContentLoader*>         m_ContentLoaders;
 
         std::map<std::wstring, Texture*>    m_LoadedTextureContent;
+        std::unordered_map<const Texture*, ManagedTexture>  m_ManagedTextures;
+        std::unordered_map<uint64_t, Texture*>              m_TextureContentHashes;
         std::mutex                          m_ContentChangeMutex;
         std::map<std::wstring, Content*>    m_LoadedContentBlocks;
         std::vector<Content*>               m_ContentToUnload;
 
+        std::unordered_set<std::wstring>                m_ReloadableContent;
+        std::map<std::wstring, EvictedContent>          m_EvictedContent;
+        uint64_t                                        m_ResidentGPUBytes = 0;
+        uint64_t                                        m_ResidentCPUBytes = 0;
+        bool                                            m_BudgetExceededWarned = false;
+
+        std::unordered_map<std::wstring, std::chrono::steady_clock::time_point> m_ContentLoadStartTimes;
+        std::unordered_set<std::wstring>                m_PreviouslyLoadedContent;
+        ContentLoadStats                                m_ContentLoadStats;
+
+        // Buffers are released from mesh destruction (which can happen while holding m_ContentChangeMutex)
+        std::mutex                                          m_SharedBufferMutex;
+        std::unordered_map<const Buffer*, ManagedBuffer>    m_ManagedBuffers;
+        std::unordered_map<uint64_t, Buffer*>               m_BufferContentHashes;
+
         std::atomic_uint32_t                m_ActiveContentLoads = 0;
         std::atomic_uint32_t                m_ActiveTextureLoads = 0;
+        std::atomic_uint64_t                m_DeduplicatedBytes = 0;
 
         std::unordered_set<ContentListener*> m_ContentListeners;
     };
@@ -34,8 +34,10 @@
 #include "components/particlespawnercomponent.h"
 #include "contentmanager.h"
 #include "inputmanager.h"
+#include "iomanager.h"
 #include "uimanager.h"
 #include "scene.h"
+#include "benchmarkscenarios.h"
 #include "../misc/corecounts.h"
 #include "../misc/fileio.h"
 #include "../misc/log.h"
@@ -47,6 +49,7 @@
 #include "../render/resourceresizedlistener.h"
 #include "../render/resourceviewallocator.h"
 #include "../render/shadowmapresourcepool.h"
+#include "../render/suballocator.h"
 #include "../render/swapchain.h"
 #include "../render/uploadheap.h"
 #include "../render/commandlist.h"
@@ -113,6 +116,8 @@ namespace cauldron
         {ResourceFormat::RGB9E5_SHAREDEXP, "RGB9E5_SHAREDEXP"},
         {ResourceFormat::RG16_TYPELESS, "RG16_TYPELESS"},
         {ResourceFormat::RG16_FLOAT, "RG16_FLOAT"},
+        {ResourceFormat::RG16_UNORM, "RG16_UNORM"},
+        {ResourceFormat::RG16_SNORM, "RG16_SNORM"},
         {ResourceFormat::R32_TYPELESS, "R32_TYPELESS"},
         {ResourceFormat::R32_FLOAT, "R32_FLOAT"},
 
@@ -176,6 +181,8 @@ namespace cauldron
             }
             CauldronAssert(ASSERT_CRITICAL, i < maxMappingLoops, L"A cyclic render resource definition has been detected in the config file starting at %ls.", it->first.c_str());
         }
+
+        CauldronAssert(ASSERT_CRITICAL, IOThreadCount > 0, L"IOThreadCount must be at least 1.");
     }
 
     // Search for the final name of the resource if there are some mappings/aliases
@@ -232,6 +239,9 @@ namespace cauldron
         uint32_t numThreads = GetRecommendedThreadCount() - 1;  // Remove one thread to account for the main thread, which we won't count
         CauldronAssert(ASSERT_CRITICAL, !m_pTaskManager->Init(numThreads), L"Failed to initialize the task manager.");
 
+        // Create the I/O manager (services file reads for background loading without blocking task threads, initialized once the config is known)
+        m_pIOManager = new IOManager();
+
         // Also set the CPU name while we are at it
         GetCPUDescription(m_CPUName);
     }
@@ -248,9 +258,10 @@ namespace cauldron
         delete m_pSwapChain;
         delete m_pShadowMapResourcePool;
         delete m_pDynamicResourcePool;
+        delete m_pRasterViewAllocator;  // Raster views release their resource views
         delete m_pResourceViewAllocator;
-        delete m_pRasterViewAllocator;
         delete m_pDevice;
+        delete m_pIOManager;
         delete m_pTaskManager;
         delete m_pImpl;
     }
@@ -260,6 +271,9 @@ namespace cauldron
         // The main thread ID
         m_MainThreadID = std::this_thread::get_id();
 
+        // Initialize the I/O manager
+        CauldronAssert(ASSERT_CRITICAL, !m_pIOManager->Init(m_Config.IOThreadCount), L"Failed to initialize the I/O manager.");
+
         // Initialize implementation
         m_pImpl->Init();
 
@@ -274,6 +288,13 @@ namespace cauldron
             assert(mod);
         }
 
+        // Replay a captured suballocator trace through all backends to compare them
+        if (!m_Config.SuballocatorReplayTrace.empty())
+        {
+            std::wstring replayResultFile = m_Config.SuballocatorReplayTrace + L".replay.json";
+            Suballocator::ReplayTrace(m_Config.SuballocatorReplayTrace.c_str(), replayResultFile.c_str());
+        }
+
         // Initialize the device, resource allocator, and swap chain
         Log::Write(LOGLEVEL_TRACE, L"Initializing graphics device.");
         m_pDevice = Device::CreateDevice();
@@ -306,6 +327,7 @@ namespace cauldron
         Log::Write(LOGLEVEL_TRACE, L"Initializing profiler.");
         m_pProfiler = Profiler::CreateProfiler();
         CauldronAssert(ASSERT_CRITICAL, m_pProfiler, L"Could not initialize profiler.");
+        m_pProfiler->SetThreadName(L"Main Thread");
 
         // Initialize upload heap and constant buffer pool
         Log::Write(LOGLEVEL_TRACE, L"Initializing graphics upload heap.");
@@ -397,8 +419,8 @@ namespace cauldron
         for (const auto& scene : m_Config.StartupContent.Scenes)
         {
             filesystem::path contentPath = scene.c_str();
-            // Only GLTF is supported now
-            if (contentPath.extension() == L".gltf")
+            // Only GLTF (and GLB) is supported now
+            if (contentPath.extension() == L".gltf" || contentPath.extension() == L".glb" || contentPath.extension() == L".GLB")
                 GetContentManager()->LoadGLTFToScene(contentPath);
 
             else
@@ -463,6 +485,10 @@ namespace cauldron
             // Dump it out
             m_pSwapChain->DumpSwapChainToFile(outputPath);
         }
+
+        // CPU scenarios run once frames are done so they don't disturb frame timings
+        if (m_Config.EnableBenchmark && m_PerfFrameCount > 0 && !m_Config.BenchmarkScenarios.empty())
+            RunBenchmarkScenarios();
     }
 
     void Framework::Shutdown()
@@ -524,61 +550,41 @@ namespace cauldron
             bool hasHeader = file.tellp() > std::wofstream::pos_type(0);
 
             double runtime = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - m_StartTime).count();
-            const auto GetMs = [](std::chrono::nanoseconds ns) -> double {
-                return (double)ns.count() / 1000000.0;
+            const auto GetMs = [](double ns) -> double {
+                return ns / 1000000.0;
             };
-            // refine the perf stats
-            {
-                const auto refinePerfStats = [this](std::vector<PerfStats>& perfStats)
-                {
-                    for (auto& curPerfStat : perfStats)
-                    {
 
-                        // incremental variance
-                        // mean(n) = mean(n-1) + (x(n) - mean(n-1))/n
-                        // let s = n * variance
-                        // s(n) = s(n-1) + (x(n) - mean(n-1))(x(n) - mean(n))
-                        double       incrementalMean     = .0;
-                        double       incrementalS        = .0;
-                        const size_t timingsSize         = curPerfStat.timings.size();
-                        size_t       incrementalI        = 1;
-                        for (const auto& t : curPerfStat.timings)
-                        {
-                            const double previousMean             = incrementalMean;
-                            const double currentMinusPreviousMean = t.count() - previousMean;
-                            incrementalMean                       = previousMean + currentMinusPreviousMean / incrementalI;
-                            incrementalS                          = incrementalS + currentMinusPreviousMean * (t.count() - incrementalMean);
-                            incrementalI++;
-                        }
-                        const double incrementalVariance = incrementalS / timingsSize;
+            // Summarize the perf stats (percentiles cover all samples, the mean and variance only cover inliers)
+            for (auto& ps : m_CpuPerfStats)
+                ps.Summary = ps.Samples.Summarize(m_Config.BenchmarkOutlierThreshold);
+            for (auto& ps : m_GpuPerfStats)
+                ps.Summary = ps.Samples.Summarize(m_Config.BenchmarkOutlierThreshold);
+            for (auto& ps : m_ScenarioPerfStats)
+                ps.Summary = ps.Samples.Summarize(m_Config.BenchmarkOutlierThreshold);
+
+            const auto logFrameSummary = [GetMs](const wchar_t* name, const std::vector<PerfStats>& perfStats) {
+                if (perfStats.empty())
+                    return;
+                const BenchmarkSummary& summary = perfStats[0].Summary;
+                Log::Write(LOGLEVEL_INFO, L"Benchmark %ls frame: mean %.3f ms, std dev %.3f ms, p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms (%llu of %llu samples rejected as outliers)",
+                           name, GetMs(summary.Mean), GetMs(std::sqrt(summary.Variance)), GetMs(summary.P50), GetMs(summary.P90), GetMs(summary.P99), GetMs(summary.Peak),
+                           summary.OutlierCount, summary.SampleCount);
+            };
+            logFrameSummary(L"CPU", m_CpuPerfStats);
+            logFrameSummary(L"GPU", m_GpuPerfStats);
+            LogContentLoadStats();
+            for (const auto& ps : m_ScenarioPerfStats)
+            {
+                const double operationCount = static_cast<double>(ps.OperationCount);
+                Log::Write(LOGLEVEL_INFO, L"Benchmark scenario %ls: mean %.1f ns, p50 %.1f ns, p99 %.1f ns per operation",
+                           ps.Label.c_str(), ps.Summary.Mean / operationCount, ps.Summary.P50 / operationCount, ps.Summary.P99 / operationCount);
+            }
 
-                        const double                                stdDeviation = std::sqrt(incrementalVariance);
-                        std::vector<std::chrono::nanoseconds>       refinedTiming;
-                        const double                                min = incrementalMean - m_Config.BenchmarkDeviationFilterFactor * stdDeviation;
-                        const double                                max = incrementalMean + m_Config.BenchmarkDeviationFilterFactor * stdDeviation;
-                        for (const auto& t : curPerfStat.timings)
-                        {
-                            if (t.count() >= min && t.count() <= max)
-                            {
-                                refinedTiming.push_back(t);
-                            }
-                        }
-                        if (refinedTiming.size() == 0)
-                            continue;
+            // Compare against the baseline run if we have one
+            json baselineResults;
+            if (!m_Config.BenchmarkBaseline.empty())
+                baselineResults = CompareBenchmarkToBaseline();
 
-                        curPerfStat.min = curPerfStat.max = refinedTiming[0];
-                        curPerfStat.refinedSize = refinedTiming.size();
-                        for (const auto& rt : refinedTiming)
-                        {
-                            curPerfStat.total += rt;
-                            curPerfStat.min = (std::min)(curPerfStat.min, rt);
-                            curPerfStat.max = (std::max)(curPerfStat.max, rt);
-                        }
-                    }
-                };
-                refinePerfStats(m_CpuPerfStats);
-                refinePerfStats(m_GpuPerfStats);
-            }
             if (m_Config.BenchmarkJson)
             {
                 if (m_Config.BenchmarkAppend && !hasHeader)
@@ -610,17 +616,35 @@ namespace cauldron
                 outputData["AvgFPS"] = (double)m_PerfFrameCount / runtime;
 
                 auto buildLabelJson = [GetMs, this](const PerfStats& ps) -> json {
+                    const BenchmarkSummary& summary = ps.Summary;
                     return json::object({
-                        {"min_ms", GetMs(ps.min)},
-                        {"min_ns", ps.min.count()},
-                        {"max_ms", GetMs(ps.max)},
-                        {"max_ns", ps.max.count()},
-                        {"avg_ms", GetMs(ps.total) / (double)ps.refinedSize},
-                        {"total_ns", ps.total.count()},
+                        {"min_ms", GetMs(summary.Min)},
+                        {"min_ns", static_cast<int64_t>(summary.Min)},
+                        {"max_ms", GetMs(summary.Max)},
+                        {"max_ns", static_cast<int64_t>(summary.Max)},
+                        {"avg_ms", GetMs(summary.Mean)},
+                        {"total_ns", static_cast<int64_t>(summary.Mean * summary.GetInlierCount())},
+                        {"stddev_ms", GetMs(std::sqrt(summary.Variance))},
+                        {"p50_ms", GetMs(summary.P50)},
+                        {"p90_ms", GetMs(summary.P90)},
+                        {"p99_ms", GetMs(summary.P99)},
+                        {"peak_ms", GetMs(summary.Peak)},
+                        {"mean_ns", summary.Mean},
+                        {"variance_ns2", summary.Variance},
+                        {"samples", summary.SampleCount},
+                        {"outliers", summary.OutlierCount},
                     });
                 };
+                auto buildHistogramJson = [](const PerfStats& ps) -> json {
+                    json histogram = json::array();
+                    for (const BenchmarkHistogramBucket& bucket : ps.Samples.GetHistogram().GetBuckets())
+                        histogram.push_back(json::array({bucket.LowerBound, bucket.UpperBound, bucket.Count}));
+                    return histogram;
+                };
                 outputData["GPUTime"] = buildLabelJson(m_GpuPerfStats[0]);
+                outputData["GPUTime"]["histogram_ns"] = buildHistogramJson(m_GpuPerfStats[0]);
                 outputData["CPUTime"] = buildLabelJson(m_CpuPerfStats[0]);
+                outputData["CPUTime"]["histogram_ns"] = buildHistogramJson(m_CpuPerfStats[0]);
                 outputData["GPULabels"] = json::object({});
                 for (const auto& ps : m_GpuPerfStats)
                 {
@@ -631,6 +655,34 @@ namespace cauldron
                 {
                     outputData["CPULabels"][WStringToString(ps.Label)] = buildLabelJson(ps);
                 }
+                if (!m_ScenarioPerfStats.empty())
+                {
+                    outputData["ScenarioLabels"] = json::object({});
+                    for (const auto& ps : m_ScenarioPerfStats)
+                    {
+                        json& scenarioJson = outputData["ScenarioLabels"][WStringToString(ps.Label)];
+                        scenarioJson = buildLabelJson(ps);
+                        scenarioJson["operations_per_sample"] = ps.OperationCount;
+                        scenarioJson["mean_ns_per_operation"] = ps.Summary.Mean / ps.OperationCount;
+                        scenarioJson["p99_ns_per_operation"]  = ps.Summary.P99 / ps.OperationCount;
+                    }
+                }
+
+                const ContentManager::ContentLoadStats loadStats = m_pContentManager->GetContentLoadStats();
+                const IOStats                          ioStats   = m_pIOManager->GetStats();
+                outputData["ContentLoad"] = json::object({
+                    {"cold_loads", loadStats.ColdLoadCount},
+                    {"cold_load_s", loadStats.ColdLoadSeconds},
+                    {"warm_loads", loadStats.WarmLoadCount},
+                    {"warm_load_s", loadStats.WarmLoadSeconds},
+                    {"io_requests", ioStats.RequestCount},
+                    {"io_reads", ioStats.ReadCount},
+                    {"io_bytes", ioStats.BytesRead},
+                    {"io_read_s", static_cast<double>(ioStats.ReadTime) / 1e9},
+                });
+
+                if (!baselineResults.is_null())
+                    outputData["Baseline"] = baselineResults;
 
                 // Dump the screenshot name associate with this benchmark if we've got one
                 outputData["ScreenshotName"] = m_Config.ScreenShotFileName.empty() ? "" : WStringToString(m_Config.ScreenShotFileName.c_str());
@@ -655,6 +707,9 @@ namespace cauldron
                         for (const auto& ps : m_CpuPerfStats)
                             file << ',' << ps.Label;
 
+                        for (const auto& ps : m_ScenarioPerfStats)
+                            file << ',' << ps.Label;
+
                         file << L",ScreenshotName";
                         file << L",CmdLine\n";
                     }
@@ -670,17 +725,20 @@ namespace cauldron
                     file << runtime << ',' << (double)m_PerfFrameCount / runtime << ',';
 
                     // get min/max/avg from first label
-                    file << GetMs(m_GpuPerfStats[0].min) << ',' << GetMs(m_GpuPerfStats[0].max) << ','
-                         << GetMs(m_GpuPerfStats[0].total) / (double)m_GpuPerfStats[0].refinedSize << ',';
-                    file << GetMs(m_CpuPerfStats[0].min) << ',' << GetMs(m_CpuPerfStats[0].max) << ','
-                         << GetMs(m_CpuPerfStats[0].total) / (double)m_CpuPerfStats[0].refinedSize;
+                    file << GetMs(m_GpuPerfStats[0].Summary.Min) << ',' << GetMs(m_GpuPerfStats[0].Summary.Max) << ','
+                         << GetMs(m_GpuPerfStats[0].Summary.Mean) << ',';
+                    file << GetMs(m_CpuPerfStats[0].Summary.Min) << ',' << GetMs(m_CpuPerfStats[0].Summary.Max) << ','
+                         << GetMs(m_CpuPerfStats[0].Summary.Mean);
 
                     // go through all labels
                     for (const auto& ps : m_GpuPerfStats)
-                        file << ',' << GetMs(ps.total) / (double)ps.refinedSize;
+                        file << ',' << GetMs(ps.Summary.Mean);
 
                     for (const auto& ps : m_CpuPerfStats)
-                        file << ',' << GetMs(ps.total) / (double)ps.refinedSize;
+                        file << ',' << GetMs(ps.Summary.Mean);
+
+                    for (const auto& ps : m_ScenarioPerfStats)
+                        file << ',' << GetMs(ps.Summary.Mean);
 
                     // Dump the screenshot name associate with this benchmark if we've got one
                     file << ',' << (m_Config.ScreenShotFileName.empty() ? "" : WStringToString(m_Config.ScreenShotFileName.c_str()).c_str());
@@ -702,15 +760,19 @@ namespace cauldron
                     file << L"Runtime [s]," << runtime << '\n';
                     file << L"Avg FPS," << (double)m_PerfFrameCount / runtime << '\n';
                     // non-append mode has per-marker details. First marker in CPU and GPU sections is whole frame.
-                    file << L"CPU/GPU,Label,Min [ms],Max [ms],Mean [ms]\n";
+                    file << L"CPU/GPU,Label,Min [ms],Max [ms],Mean [ms],StdDev [ms],P50 [ms],P90 [ms],P99 [ms],Peak [ms],Outliers\n";
+                    const auto writeLabelStats = [&file, GetMs](const wchar_t* name, const PerfStats& ps) {
+                        const BenchmarkSummary& summary = ps.Summary;
+                        file << name << ',' << ps.Label << ',' << GetMs(summary.Min) << ',' << GetMs(summary.Max) << ',' << GetMs(summary.Mean) << ','
+                             << GetMs(std::sqrt(summary.Variance)) << ',' << GetMs(summary.P50) << ',' << GetMs(summary.P90) << ',' << GetMs(summary.P99) << ','
+                             << GetMs(summary.Peak) << ',' << summary.OutlierCount << '\n';
+                    };
                     for (const auto& ps : m_CpuPerfStats)
-                    {
-                        file << "CPU," << ps.Label << ',' << GetMs(ps.min) << ',' << GetMs(ps.max) << ',' << GetMs(ps.total) / (double)ps.refinedSize << '\n';
-                    }
+                        writeLabelStats(L"CPU", ps);
                     for (const auto& ps : m_GpuPerfStats)
-                    {
-                        file << "GPU," << ps.Label << ',' << GetMs(ps.min) << ',' << GetMs(ps.max) << ',' << GetMs(ps.total) / (double)ps.refinedSize << '\n';
-                    }
+                        writeLabelStats(L"GPU", ps);
+                    for (const auto& ps : m_ScenarioPerfStats)
+                        writeLabelStats(L"Scenario", ps);
 
                     // Dump the screenshot name associate with this benchmark if we've got one
                     file << "ScreenshotName," << (m_Config.ScreenShotFileName.empty() ? "" : WStringToString(m_Config.ScreenShotFileName.c_str())).c_str() << '\n';
@@ -718,6 +780,13 @@ namespace cauldron
             }
         }
 
+        // Let in-flight content loads finish, they may still need to issue reads
+        while (m_pContentManager->IsCurrentlyLoading())
+            std::this_thread::yield();
+
+        // Terminate the I/O manager first, as read completions are handed to the task manager (pending reads are serviced before it shuts down)
+        m_pIOManager->Shutdown();
+
         // Terminate the task manager
         m_pTaskManager->Shutdown();
 
@@ -733,6 +802,16 @@ namespace cauldron
         // Terminate shader compiler
         TerminateShaderCompileSystem();
 
+        // All content is gone, anything still sub-allocated at this point is a leak
+        if (m_Config.SuballocatorDumpBudgets)
+        {
+            if (!m_Config.SuballocatorPath.empty())
+                filesystem::create_directory(m_Config.SuballocatorPath);
+            filesystem::path budgetFile = filesystem::path(m_Config.SuballocatorPath) / (m_Name + L"-suballocators.json");
+            Suballocator::DumpBudgets(budgetFile.c_str());
+        }
+        Suballocator::ReportLeaks();
+
         // Terminate log system
         Log::TerminateLogSystem();
     }
@@ -790,14 +869,16 @@ namespace cauldron
         // Initialize allocation configuration
         if (configData.find("Allocations") != configData.end())
         {
-            json allocationsConfig         = configData["Allocations"];
-            m_Config.UploadHeapSize        = allocationsConfig.value("UploadHeapSize", m_Config.UploadHeapSize);  // Default to 100 MB
-            m_Config.DynamicBufferPoolSize = allocationsConfig.value("DynamicBufferPoolSize", m_Config.DynamicBufferPoolSize);
-            m_Config.GPUSamplerViewCount   = allocationsConfig.value("GPUSamplerViewCount", m_Config.GPUSamplerViewCount);
-            m_Config.GPUResourceViewCount  = allocationsConfig.value("GPUResourceViewCount", m_Config.GPUResourceViewCount);
-            m_Config.CPUResourceViewCount  = allocationsConfig.value("CPUResourceViewCount", m_Config.CPUResourceViewCount);
-            m_Config.CPURenderViewCount    = allocationsConfig.value("CPURenderViewCount", m_Config.CPURenderViewCount);
-            m_Config.CPUDepthViewCount     = allocationsConfig.value("CPUDepthViewCount", m_Config.CPUDepthViewCount);
+            json allocationsConfig          = configData["Allocations"];
+            m_Config.UploadHeapSize         = allocationsConfig.value("UploadHeapSize", m_Config.UploadHeapSize);  // Default to 100 MB
+            m_Config.DynamicBufferPoolSize  = allocationsConfig.value("DynamicBufferPoolSize", m_Config.DynamicBufferPoolSize);
+            m_Config.DynamicBufferChunkSize = allocationsConfig.value("DynamicBufferChunkSize", m_Config.DynamicBufferChunkSize);
+            m_Config.GPUSamplerViewCount    = allocationsConfig.value("GPUSamplerViewCount", m_Config.GPUSamplerViewCount);
+            m_Config.GPUResourceViewCount   = allocationsConfig.value("GPUResourceViewCount", m_Config.GPUResourceViewCount);
+            m_Config.CPUResourceViewCount   = allocationsConfig.value("CPUResourceViewCount", m_Config.CPUResourceViewCount);
+            m_Config.CPURenderViewCount     = allocationsConfig.value("CPURenderViewCount", m_Config.CPURenderViewCount);
+            m_Config.CPUDepthViewCount      = allocationsConfig.value("CPUDepthViewCount", m_Config.CPUDepthViewCount);
+            m_Config.ContentMemoryBudget    = allocationsConfig.value("ContentMemoryBudget", m_Config.ContentMemoryBudget);
         }
 
         // Initialize frame limiter configuration
@@ -854,6 +935,15 @@ namespace cauldron
         m_Config.OverrideSceneSamplers = configData.value("OverrideSceneSamplers", m_Config.OverrideSceneSamplers);
         m_Config.TakeScreenshot        = configData.value("Screenshot", m_Config.TakeScreenshot);
         m_Config.BuildRayTracingAccelerationStructure = configData.value("BuildRayTracingAccelerationStructure", m_Config.BuildRayTracingAccelerationStructure);
+        m_Config.UseSceneCache         = configData.value("UseSceneCache", m_Config.UseSceneCache);
+        m_Config.NativeVertexFormats   = configData.value("NativeVertexFormats", m_Config.NativeVertexFormats);
+        m_Config.CPUSkinning           = configData.value("CPUSkinning", m_Config.CPUSkinning);
+        m_Config.CPUSkinningDualQuaternion = configData.value("CPUSkinningDualQuaternion", m_Config.CPUSkinningDualQuaternion);
+        m_Config.CompressAnimations    = configData.value("CompressAnimations", m_Config.CompressAnimations);
+        m_Config.AnimationUpdateLOD    = configData.value("AnimationUpdateLOD", m_Config.AnimationUpdateLOD);
+        m_Config.IOThreadCount         = configData.value("IOThreadCount", m_Config.IOThreadCount);
+        m_Config.AnimationCompressionLinearTolerance  = configData.value("AnimationCompressionLinearTolerance", m_Config.AnimationCompressionLinearTolerance);
+        m_Config.AnimationCompressionAngularTolerance = configData.value("AnimationCompressionAngularTolerance", m_Config.AnimationCompressionAngularTolerance);
 
         // Content initialization
         if (configData.find("Content") != configData.end())
@@ -1072,13 +1162,161 @@ namespace cauldron
             m_Config.EnableBenchmark = benchmarkConfig.value("Enabled", m_Config.EnableBenchmark);
             m_Config.BenchmarkFrameDuration = benchmarkConfig.value("FrameDuration", m_Config.BenchmarkFrameDuration);
             m_Config.BenchmarkPath = benchmarkConfig.value("Path", m_Config.BenchmarkPath);
-            m_Config.BenchmarkDeviationFilterFactor = benchmarkConfig.value("DeviationFilterFactor", m_Config.BenchmarkDeviationFilterFactor);
+            m_Config.BenchmarkWarmupFrames = benchmarkConfig.value("WarmupFrames", m_Config.BenchmarkWarmupFrames);
+            m_Config.BenchmarkMaxWarmupFrames = benchmarkConfig.value("MaxWarmupFrames", m_Config.BenchmarkMaxWarmupFrames);
+            m_Config.BenchmarkOutlierThreshold = benchmarkConfig.value("OutlierThreshold", m_Config.BenchmarkOutlierThreshold);
+            m_Config.BenchmarkBaseline = benchmarkConfig.value("Baseline", m_Config.BenchmarkBaseline);
+            m_Config.BenchmarkSignificanceLevel = benchmarkConfig.value("SignificanceLevel", m_Config.BenchmarkSignificanceLevel);
+            m_Config.BenchmarkRegressionThreshold = benchmarkConfig.value("RegressionThreshold", m_Config.BenchmarkRegressionThreshold);
+            m_Config.BenchmarkScenarioSamples = benchmarkConfig.value("ScenarioSamples", m_Config.BenchmarkScenarioSamples);
+            if (benchmarkConfig.find("Scenarios") != benchmarkConfig.end())
+            {
+                m_Config.BenchmarkScenarios.clear();
+                for (const json& scenario : benchmarkConfig["Scenarios"])
+                    m_Config.BenchmarkScenarios.push_back(StringToWString(scenario.get<std::string>()));
+            }
+        }
+
+        // Initialize profile trace config
+        if (configData.find("ProfileTrace") != configData.end())
+        {
+            json profileTraceConfig         = configData["ProfileTrace"];
+            m_Config.EnableProfileTrace     = profileTraceConfig.value("Enabled", m_Config.EnableProfileTrace);
+            m_Config.ProfileTraceStartFrame = profileTraceConfig.value("StartFrame", m_Config.ProfileTraceStartFrame);
+            m_Config.ProfileTraceFrameCount = profileTraceConfig.value("FrameCount", m_Config.ProfileTraceFrameCount);
+            m_Config.ProfileTracePath       = profileTraceConfig.value("Path", m_Config.ProfileTracePath);
+        }
+
+        // Initialize suballocator service config
+        if (configData.find("Suballocators") != configData.end())
+        {
+            json suballocatorConfig             = configData["Suballocators"];
+            m_Config.SuballocatorBackend        = suballocatorConfig.value("Backend", m_Config.SuballocatorBackend);
+            m_Config.SuballocatorDumpBudgets    = suballocatorConfig.value("DumpBudgets", m_Config.SuballocatorDumpBudgets);
+            m_Config.SuballocatorTraceCapture   = suballocatorConfig.value("CaptureTrace", m_Config.SuballocatorTraceCapture);
+            m_Config.SuballocatorPath           = suballocatorConfig.value("Path", m_Config.SuballocatorPath);
+            m_Config.SuballocatorReplayTrace    = suballocatorConfig.value("ReplayTrace", m_Config.SuballocatorReplayTrace);
         }
 
         // Validate that the information are correct
         m_Config.Validate();
     }
 
+    json Framework::CompareBenchmarkToBaseline()
+    {
+        json results = json::object();
+        results["Path"] = WStringToString(m_Config.BenchmarkBaseline);
+
+        // The baseline is the json output of a previous run (the last one if results were appended)
+        std::ifstream baselineFile(m_Config.BenchmarkBaseline.c_str());
+        json baseline = baselineFile.good() ? json::parse(baselineFile, nullptr, false) : json();
+        if (baseline.is_array() && !baseline.empty())
+            baseline = baseline.back();
+        if (baseline.is_discarded() || !baseline.is_object())
+        {
+            CauldronWarning(L"Could not load benchmark baseline %ls.", m_Config.BenchmarkBaseline.c_str());
+            m_BenchmarkExitCode = static_cast<int32_t>(GetBenchmarkExitCode(false, 0, 0));
+            results["Error"] = "Could not load baseline";
+            return results;
+        }
+
+        uint32_t comparedCount   = 0;
+        uint32_t regressionCount = 0;
+        const auto compareLabels = [&](const char* section, const std::vector<PerfStats>& perfStats) {
+            auto sectionIt = baseline.find(section);
+            if (sectionIt == baseline.end())
+                return;
+
+            for (const PerfStats& ps : perfStats)
+            {
+                // Only results with variance information (written since percentiles were added) can be tested
+                const std::string label = WStringToString(ps.Label);
+                auto labelIt = sectionIt->find(label);
+                if (labelIt == sectionIt->end() || !labelIt->contains("mean_ns") || !labelIt->contains("variance_ns2"))
+                    continue;
+
+                BenchmarkSummary baselineSummary;
+                baselineSummary.SampleCount  = labelIt->value("samples", uint64_t(0));
+                baselineSummary.OutlierCount = labelIt->value("outliers", uint64_t(0));
+                baselineSummary.Mean         = labelIt->value("mean_ns", 0.0);
+                baselineSummary.Variance     = labelIt->value("variance_ns2", 0.0);
+
+                const BenchmarkComparison comparison = CompareBenchmarks(baselineSummary, ps.Summary, m_Config.BenchmarkSignificanceLevel, m_Config.BenchmarkRegressionThreshold);
+                results[section][label] = json::object({
+                    {"baseline_ms", baselineSummary.Mean / 1000000.0},
+                    {"current_ms", ps.Summary.Mean / 1000000.0},
+                    {"change", comparison.RelativeChange},
+                    {"p_value", comparison.PValue},
+                    {"result", comparison.Regression ? "regression" : (comparison.Improvement ? "improvement" : "unchanged")},
+                });
+                ++comparedCount;
+
+                if (comparison.Regression)
+                {
+                    ++regressionCount;
+                    Log::Write(LOGLEVEL_WARNING, L"Benchmark regression in %hs %ls: %.3f ms -> %.3f ms (%+.1f%%, p = %.2g)", section, ps.Label.c_str(),
+                               baselineSummary.Mean / 1000000.0, ps.Summary.Mean / 1000000.0, comparison.RelativeChange * 100.0, comparison.PValue);
+                }
+                else if (comparison.Improvement)
+                {
+                    Log::Write(LOGLEVEL_INFO, L"Benchmark improvement in %hs %ls: %.3f ms -> %.3f ms (%+.1f%%, p = %.2g)", section, ps.Label.c_str(),
+                               baselineSummary.Mean / 1000000.0, ps.Summary.Mean / 1000000.0, comparison.RelativeChange * 100.0, comparison.PValue);
+                }
+            }
+        };
+        compareLabels("CPULabels", m_CpuPerfStats);
+        compareLabels("GPULabels", m_GpuPerfStats);
+        compareLabels("ScenarioLabels", m_ScenarioPerfStats);
+        results["Regressions"] = regressionCount;
+
+        if (!comparedCount)
+        {
+            CauldronWarning(L"Benchmark baseline %ls has no results in common with this run.", m_Config.BenchmarkBaseline.c_str());
+            results["Error"] = "No results in common";
+        }
+        else
+        {
+            Log::Write(LOGLEVEL_INFO, L"Compared %u benchmark results against baseline %ls: %u regression(s).", comparedCount, m_Config.BenchmarkBaseline.c_str(), regressionCount);
+        }
+        m_BenchmarkExitCode = static_cast<int32_t>(GetBenchmarkExitCode(true, comparedCount, regressionCount));
+
+        return results;
+    }
+
+    void Framework::RunBenchmarkScenarios()
+    {
+        for (const std::wstring& scenarioName : m_Config.BenchmarkScenarios)
+        {
+            BenchmarkScenarioContext context(scenarioName, m_Config.BenchmarkScenarioSamples);
+            if (!RunBenchmarkScenario(scenarioName, context))
+            {
+                CauldronWarning(L"Unknown benchmark scenario %ls will be skipped.", scenarioName.c_str());
+                continue;
+            }
+
+            for (BenchmarkScenarioContext::Measurement& measurement : context.GetMeasurements())
+            {
+                m_ScenarioPerfStats.push_back({ measurement.Label });
+                m_ScenarioPerfStats.back().Samples        = std::move(measurement.Samples);
+                m_ScenarioPerfStats.back().OperationCount = measurement.OperationCount;
+            }
+        }
+    }
+
+    void Framework::LogContentLoadStats()
+    {
+        const ContentManager::ContentLoadStats loadStats = m_pContentManager->GetContentLoadStats();
+        if (loadStats.ColdLoadCount)
+            Log::Write(LOGLEVEL_INFO, L"Content cold loads: %u taking %.3f seconds on average", loadStats.ColdLoadCount, loadStats.ColdLoadSeconds / loadStats.ColdLoadCount);
+        if (loadStats.WarmLoadCount)
+            Log::Write(LOGLEVEL_INFO, L"Content warm loads: %u taking %.3f seconds on average", loadStats.WarmLoadCount, loadStats.WarmLoadSeconds / loadStats.WarmLoadCount);
+
+        const IOStats ioStats = m_pIOManager->GetStats();
+        Log::Write(LOGLEVEL_INFO, L"I/O: %llu requests serviced by %llu reads, %.2f MB read in %.3f seconds over %u threads",
+                   ioStats.RequestCount, ioStats.ReadCount, static_cast<double>(ioStats.BytesRead) / (1024.0 * 1024.0),
+                   static_cast<double>(ioStats.ReadTime) / 1e9, m_Config.IOThreadCount);
+    }
+
     void Framework::InitConfig()
     {
         // Parse config file
@@ -1090,6 +1328,7 @@ namespace cauldron
         // GPU timing info is synched to the swapchain and reported with a delay equal to the number of back buffers
         // so we need to set up that delay at the start
         m_PerfFrameCount = -static_cast<int64_t>(m_Config.BackBufferCount);
+        m_BenchmarkWarmup = BenchmarkWarmup(m_Config.BenchmarkWarmupFrames, m_Config.BenchmarkMaxWarmupFrames);
     }
 
     void Framework::EnableUpscaling(bool enabled, ResolutionUpdateFunc func /*=nullptr*/)
@@ -1194,6 +1433,15 @@ namespace cauldron
         m_Config.InvertedDepth         = true;
         m_Config.OverrideSceneSamplers = true;
         m_Config.BuildRayTracingAccelerationStructure = false;
+        m_Config.UseSceneCache         = false;
+        m_Config.NativeVertexFormats   = false;
+        m_Config.CPUSkinning           = false;
+        m_Config.CPUSkinningDualQuaternion = false;
+        m_Config.CompressAnimations    = true;
+        m_Config.AnimationUpdateLOD    = false;
+        m_Config.EnableProfileTrace    = false;
+        m_Config.SuballocatorDumpBudgets  = false;
+        m_Config.SuballocatorTraceCapture = false;
 
         // Perf defaults
         m_Config.BenchmarkAppend       = false;
@@ -1513,6 +1761,12 @@ namespace cauldron
                     else if (!argument.compare(0, 5, L"path="))
                         m_Config.BenchmarkPath = argument.substr(5);
 
+                    else if (!argument.compare(0, 7, L"warmup="))
+                        m_Config.BenchmarkWarmupFrames = static_cast<uint32_t>(wcstoul(argument.c_str() + 7, nullptr, 10));
+
+                    else if (!argument.compare(0, 9, L"baseline="))
+                        m_Config.BenchmarkBaseline = argument.substr(9);
+
                     ++localArg;
                 }
 
@@ -1689,12 +1943,24 @@ namespace cauldron
         // Start updating the CPU counters first to catch any waiting on swapchain
         m_pProfiler->BeginCPUFrame();
 
+        // Export the profile trace once all requested frames were collected
+        if (m_Config.EnableProfileTrace && m_Config.ProfileTraceFrameCount > 0 && m_FrameID == static_cast<uint64_t>(m_Config.ProfileTraceStartFrame) + m_Config.ProfileTraceFrameCount)
+        {
+            CauldronAssert(ASSERT_WARNING, m_Config.ProfileTraceFrameCount <= Profiler::s_MAX_CAPTURED_FRAMES, L"Profile traces are limited to the last %u frames.", Profiler::s_MAX_CAPTURED_FRAMES);
+            if (!m_Config.ProfileTracePath.empty())
+                filesystem::create_directory(m_Config.ProfileTracePath);
+            filesystem::path traceFile = filesystem::path(m_Config.ProfileTracePath) / (m_Name + L"-trace.json");
+            m_pProfiler->ExportTrace(traceFile.c_str(), m_Config.ProfileTraceStartFrame, m_FrameID - 1);
+        }
+
         static bool loggedLoadingTime = false;
         if (!loggedLoadingTime && !m_pContentManager->IsCurrentlyLoading())
         {
             // Log the time it took to load
             double loadDelta = std::chrono::duration<double, std::milli>(std::chrono::system_clock::now() - m_LoadingStartTime).count() / 1000.0;
             Log::Write(LOGLEVEL_TRACE, L"Content loading took %f seconds", loadDelta);
+            Log::Write(LOGLEVEL_TRACE, L"Content deduplication saved %.2f MB", static_cast<double>(m_pContentManager->GetDeduplicatedBytes()) / (1024.0 * 1024.0));
+            LogContentLoadStats();
             loggedLoadingTime = true;
         }
 
@@ -1704,16 +1970,22 @@ namespace cauldron
             {
                 if (m_PerfFrameCount == 0)
                 {
-                    Log::Write(LOGLEVEL_TRACE, L"All modules ready, commencing benchmark.");
-                    // First frame with all modules ready. Wait one frame to start gathering information (from this next frame).
-                    // Set start (and possible stop) time now.
-                    m_StartTime = std::chrono::steady_clock::now();
-                    if (m_Config.BenchmarkFrameDuration < UINT32_MAX)
-                        Log::Write(LOGLEVEL_TRACE, L"Benchmarking for %u frames.", m_Config.BenchmarkFrameDuration);
-                    m_PerfFrameCount++;
-                    // store resolution info at beginning of benchmark, since it will change when upscaling modules are disabled,
-                    // which will happen just before shutdown (before output is printed)
-                    m_BenchmarkResolutionInfo = m_ResolutionInfo;
+                    // Warm up until frame times settle before gathering anything
+                    if (m_BenchmarkWarmup.AddFrame(static_cast<uint64_t>(m_pProfiler->GetCPUFrameTicks())))
+                    {
+                        Log::Write(LOGLEVEL_TRACE, L"Benchmark warmup took %u frames (%ls).", m_BenchmarkWarmup.GetFrameCount(),
+                                   m_BenchmarkWarmup.ReachedSteadyState() ? L"steady state reached" : L"frame times did not settle");
+                        Log::Write(LOGLEVEL_TRACE, L"All modules ready, commencing benchmark.");
+                        // First frame with all modules ready. Wait one frame to start gathering information (from this next frame).
+                        // Set start (and possible stop) time now.
+                        m_StartTime = std::chrono::steady_clock::now();
+                        if (m_Config.BenchmarkFrameDuration < UINT32_MAX)
+                            Log::Write(LOGLEVEL_TRACE, L"Benchmarking for %u frames.", m_Config.BenchmarkFrameDuration);
+                        m_PerfFrameCount++;
+                        // store resolution info at beginning of benchmark, since it will change when upscaling modules are disabled,
+                        // which will happen just before shutdown (before output is printed)
+                        m_BenchmarkResolutionInfo = m_ResolutionInfo;
+                    }
                 }
                 else if (m_PerfFrameCount < 0)
                 {
@@ -1741,14 +2013,14 @@ namespace cauldron
                         for (const auto& ti : cpuTimings)
                         {
                             m_CpuPerfStats.push_back({ti.Label});
-                            m_CpuPerfStats.back().timings.reserve(m_Config.BenchmarkFrameDuration);
+                            m_CpuPerfStats.back().Samples.Reserve(m_Config.BenchmarkFrameDuration);
                         }
                         m_GpuPerfStats.clear();
                         m_GpuPerfStats.reserve(gpuTimings.size());
                         for (const auto& ti : gpuTimings)
                         {
                             m_GpuPerfStats.push_back({ti.Label});
-                            m_GpuPerfStats.back().timings.reserve(m_Config.BenchmarkFrameDuration);
+                            m_GpuPerfStats.back().Samples.Reserve(m_Config.BenchmarkFrameDuration);
                         }
                         m_PerfFrameCount = 1;
                     }
@@ -1757,11 +2029,11 @@ namespace cauldron
                         // update stats
                         for (size_t i = 0; i < cpuTimings.size(); i++)
                         {
-                            m_CpuPerfStats[i].timings.emplace_back(cpuTimings[i].GetDuration());
+                            m_CpuPerfStats[i].Samples.AddSample(static_cast<uint64_t>(cpuTimings[i].GetDuration().count()));
                         }
                         for (size_t i = 0; i < gpuTimings.size(); i++)
                         {
-                            m_GpuPerfStats[i].timings.emplace_back(gpuTimings[i].GetDuration());
+                            m_GpuPerfStats[i].Samples.AddSample(static_cast<uint64_t>(gpuTimings[i].GetDuration().count()));
                         }
                         m_PerfFrameCount++;
                     }
@@ -1859,6 +2131,9 @@ namespace cauldron
         // Commit dynamic buffer pool memory for the frame
         m_pDynamicBufferPool->EndFrame();
 
+        // Recycle resource views released during past frames, using the fence the dynamic buffer pool just signaled
+        m_pResourceViewAllocator->EndFrame(m_pDynamicBufferPool->GetFrameFenceValue());
+
         // Reset the Pix capture
         if(m_PixCaptureState == FrameCaptureState::CaptureStarted)
         {
@@ -2139,6 +2414,13 @@ namespace cauldron
         return g_pFrameworkInstance->GetTaskManager();
     }
 
+    // Global I/O manager accessor
+    IOManager* GetIOManager()
+    {
+        CauldronAssert(ASSERT_CRITICAL, g_pFrameworkInstance, L"No framework instance to query. Application will crash.");
+        return g_pFrameworkInstance->GetIOManager();
+    }
+
     // Global content manager accessor
     ContentManager* GetContentManager()
     {
@@ -2249,6 +2531,10 @@ namespace cauldron
         // Shut everything down before deleting and returning
         pFramework->Shutdown();
 
+        // Report benchmark regressions through the exit code unless something else went wrong
+        if (result == 0)
+            result = pFramework->GetBenchmarkExitCode();
+
         // Return the end result back to the sample in case it's needed
         return result;
     }
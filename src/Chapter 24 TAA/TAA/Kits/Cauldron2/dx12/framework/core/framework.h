@@ -53,6 +53,7 @@
 ///
 /// @ingroup Cauldron
 
+#include "../misc/benchmarkstats.h"
 #include "../misc/helpers.h"
 #include "../render/commandlist.h"
 #include "../render/particle.h"
@@ -183,6 +184,33 @@ namespace cauldron
         // Acceleration Structure
         bool BuildRayTracingAccelerationStructure : 1;
 
+        // Cooked scene cache
+        bool UseSceneCache : 1;
+
+        // Keep normalized integer texcoords/colors in their native formats rather than converting them to float
+        bool NativeVertexFormats : 1;
+
+        // Keep CPU copies of skinned surfaces and skin them on the CPU each frame (for culling, picking and headless use)
+        bool CPUSkinning : 1;
+
+        // Use dual-quaternion rather than linear-blend skinning for CPU skinning
+        bool CPUSkinningDualQuaternion : 1;
+
+        // Compress animation clips on load (error bounded key reduction and quantized key values)
+        bool CompressAnimations : 1;
+
+        // Update the pose of animated models that are small on screen every 2nd or 4th frame only
+        bool AnimationUpdateLOD : 1;
+
+        // Export a Chrome trace of CPU captures for a range of frames
+        bool EnableProfileTrace : 1;
+
+        // Dump the budgets of all suballocators on shutdown
+        bool SuballocatorDumpBudgets : 1;
+
+        // Capture an allocation trace per suballocator, to replay through the different suballocator backends
+        bool SuballocatorTraceCapture : 1;
+
         //////////////////////////////////////////////////////////////////////////
         // Non-binary data
 
@@ -197,14 +225,25 @@ namespace cauldron
         uint32_t Height = 1080;
         uint32_t FontSize = 13;
 
+        // Number of threads servicing asynchronous file reads
+        uint32_t IOThreadCount = 2;
+
+        // Largest error compressed animation tracks may have (translation/scale in scene units, rotation in radians), tracks exceeding it stay uncompressed
+        float AnimationCompressionLinearTolerance  = 1e-3f;
+        float AnimationCompressionAngularTolerance = 1e-3f;
+
         // Allocation sizes
-        uint64_t UploadHeapSize        = 100 * 1024 * 1024;
-        uint32_t DynamicBufferPoolSize = 2 * 1024 * 1024;
-        uint32_t GPUResourceViewCount  = 10000;
-        uint32_t CPUResourceViewCount  = 100;
-        uint32_t CPURenderViewCount    = 100;
-        uint32_t CPUDepthViewCount     = 100;
-        uint32_t GPUSamplerViewCount   = 100;
+        uint64_t UploadHeapSize         = 100 * 1024 * 1024;
+        uint32_t DynamicBufferPoolSize  = 2 * 1024 * 1024;
+        uint32_t DynamicBufferChunkSize = 64 * 1024;  // Size of the per-thread chunks dynamic buffers are sub-allocated from
+        uint32_t GPUResourceViewCount   = 10000;
+        uint32_t CPUResourceViewCount   = 100;
+        uint32_t CPURenderViewCount     = 100;
+        uint32_t CPUDepthViewCount      = 100;
+        uint32_t GPUSamplerViewCount    = 100;
+
+        // Memory budget (in bytes) for loaded content, least recently used content gets evicted past it (0 means no budget)
+        uint64_t ContentMemoryBudget   = 0;
 
         // DisplayMode
         DisplayMode CurrentDisplayMode = DisplayMode::DISPLAYMODE_LDR;
@@ -243,10 +282,27 @@ namespace cauldron
         // Perf Output
         uint32_t                      BenchmarkFrameDuration = -1;
         std::wstring                  BenchmarkPath = L"";
-        float                         BenchmarkDeviationFilterFactor = 1.0f;
+        uint32_t                      BenchmarkWarmupFrames = 30;           // Minimum number of frames before the steady state is checked for
+        uint32_t                      BenchmarkMaxWarmupFrames = 600;       // Warmup ends after this many frames even if frame times haven't settled
+        float                         BenchmarkOutlierThreshold = 3.5f;     // Modified z-score past which samples are rejected (0 disables rejection)
+        std::wstring                  BenchmarkBaseline = L"";              // Benchmark json output to compare results against
+        float                         BenchmarkSignificanceLevel = 0.01f;
+        float                         BenchmarkRegressionThreshold = 0.05f; // Relative slowdown past which a significant difference is a regression
+        std::vector<std::wstring>     BenchmarkScenarios = {};              // CPU benchmark scenarios to run once the frame benchmark completes
+        uint32_t                      BenchmarkScenarioSamples = 200;       // Number of samples recorded per scenario measurement
 
         std::vector<std::pair<std::wstring, std::wstring>> BenchmarkPermutationOptions = {};
 
+        // Profile trace output
+        uint32_t                      ProfileTraceStartFrame = 100;
+        uint32_t                      ProfileTraceFrameCount = 10;
+        std::wstring                  ProfileTracePath = L"";
+
+        // Suballocator service
+        std::string                   SuballocatorBackend = "TLSF";         // TLSF (default), VirtualBlock or VirtualBlockLinear (D3D12MA, opt-in)
+        std::wstring                  SuballocatorPath = L"";               // Where budget dumps and allocation traces are written
+        std::wstring                  SuballocatorReplayTrace = L"";        // Allocation trace to replay through all backends on startup
+
         // App identifier
         std::wstring                  AppName = L"";
 
@@ -328,6 +384,7 @@ namespace cauldron
     class DynamicResourcePool;
     class FrameworkInternal;
     class InputManager;
+    class IOManager;
     class Profiler;
     class RasterViewAllocator;
     class ResourceResizedListener;
@@ -442,6 +499,12 @@ namespace cauldron
         const TaskManager* GetTaskManager() const { return m_pTaskManager; }
         TaskManager* GetTaskManager() { return m_pTaskManager; }
 
+        /**
+         * @brief   Retrieves the <c><i>IOManager</i></c> instance.
+         */
+        const IOManager* GetIOManager() const { return m_pIOManager; }
+        IOManager* GetIOManager() { return m_pIOManager; }
+
         /**
          * @brief   Retrieves the <c><i>Scene</i></c> instance.
          */
@@ -673,6 +736,11 @@ namespace cauldron
          */
         uint64_t GetFrameID() const { return m_FrameID; }
 
+        /**
+         * @brief   Returns the exit code reflecting the result of the benchmark baseline comparison (0 when there is nothing to report).
+         */
+        int32_t  GetBenchmarkExitCode() const { return m_BenchmarkExitCode; }
+
         /**
          * @brief   Query whether the sample is currently running.
          */
@@ -762,6 +830,15 @@ namespace cauldron
         void BeginFrame();
         void EndFrame();
 
+        // Compares benchmark results against the configured baseline, sets the benchmark exit code and returns the per-label results
+        json CompareBenchmarkToBaseline();
+
+        // Runs the configured CPU benchmark scenarios
+        void RunBenchmarkScenarios();
+
+        // Logs cold and warm content load timings along with I/O statistics
+        void LogContentLoadStats();
+
         // Members
         CauldronConfig          m_Config = {};
         std::wstring            m_Name;
@@ -782,6 +859,9 @@ namespace cauldron
         // Task Manager for background tasks
         TaskManager*            m_pTaskManager = nullptr;
 
+        // I/O Manager for asynchronous file reads
+        IOManager*              m_pIOManager = nullptr;
+
         // Scene to hold loaded entities for interacting with
         Scene*                  m_pScene = nullptr;
 
@@ -802,13 +882,15 @@ namespace cauldron
         Profiler*               m_pProfiler = nullptr;
         struct PerfStats
         {
-            std::wstring             Label;
-            std::chrono::nanoseconds              min, max, total;
-            size_t                                refinedSize;
-            std::vector<std::chrono::nanoseconds> timings;
+            std::wstring                          Label;
+            BenchmarkSeries                       Samples = {};
+            BenchmarkSummary                      Summary = {};
+            uint32_t                              OperationCount = 1;   // Operations timed per sample (scenarios only)
         };
-        std::vector<PerfStats>                             m_CpuPerfStats{}, m_GpuPerfStats{};
+        std::vector<PerfStats>                             m_CpuPerfStats{}, m_GpuPerfStats{}, m_ScenarioPerfStats{};
         int64_t                                            m_PerfFrameCount{INT64_MIN};
+        BenchmarkWarmup                                    m_BenchmarkWarmup{0, 0};
+        int32_t                                            m_BenchmarkExitCode = 0;
         std::chrono::time_point<std::chrono::steady_clock> m_StartTime;
         std::chrono::time_point<std::chrono::steady_clock> m_StopTime = (std::chrono::time_point<std::chrono::steady_clock>::max)();
 
@@ -855,6 +937,11 @@ namespace cauldron
     */
     TaskManager* GetTaskManager();
 
+    /**
+    * @brief   Retrieves the current <c><i>IOManager</i></c> instance.
+    */
+    IOManager* GetIOManager();
+
     /**
     * @brief   Retrieves the current <c><i>ContentManager</i></c> instance.
     */
@@ -0,0 +1,260 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "iomanager.h"
+#include "framework.h"
+#include "../misc/assert.h"
+#include "../misc/fileio.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <queue>
+
+namespace cauldron
+{
+    // Partial reads of the same file separated by less than this many bytes are serviced with a single read
+    static constexpr int64_t s_MaxCoalescedReadGap = 64 * 1024;
+
+    IOManager::IOManager()
+    {
+    }
+
+    IOManager::~IOManager()
+    {
+    }
+
+    int32_t IOManager::Init(uint32_t ioThreadCount)
+    {
+        std::function<void()> pIOHandler = [this]() { this->IOExecutor(); };
+
+        for (uint32_t i = 0; i < ioThreadCount; ++i)
+            m_IOThreads.emplace_back(pIOHandler);
+
+        return 0;
+    }
+
+    void IOManager::Shutdown()
+    {
+        // Flag all threads to shutdown (they keep going until all pending reads are handed off, as their completion tasks need to run)
+        {
+            std::unique_lock<std::mutex> lock(m_CriticalSection);
+            m_ShuttingDown = true;
+            m_QueueCondition.notify_all();
+        }
+
+        // Wait for all threads to be done
+        std::vector<std::thread>::iterator iter = m_IOThreads.begin();
+        while (iter != m_IOThreads.end())
+        {
+            iter->join();
+            iter = m_IOThreads.erase(iter);
+        }
+    }
+
+    void IOManager::ReadFileAsync(FileReadRequest* pRequest)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_CriticalSection);
+            if (!m_ShuttingDown)
+            {
+                ++m_ActiveReads;
+                m_PendingReads.push_back(pRequest);
+
+                // Wake a single thread to service the read
+                m_QueueCondition.notify_one();
+                return;
+            }
+        }
+
+        FailFileReads({ pRequest });
+    }
+
+    void IOManager::ReadFilesAsync(const std::vector<FileReadRequest*>& requests)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_CriticalSection);
+            if (!m_ShuttingDown)
+            {
+                m_ActiveReads += static_cast<uint32_t>(requests.size());
+                for (auto* pRequest : requests)
+                    m_PendingReads.push_back(pRequest);
+
+                // Wake up all threads to service as many files concurrently as possible
+                m_QueueCondition.notify_all();
+                return;
+            }
+        }
+
+        FailFileReads(requests);
+    }
+
+    IOStats IOManager::GetStats() const
+    {
+        IOStats stats;
+        stats.RequestCount = m_RequestCount;
+        stats.ReadCount    = m_ReadCount;
+        stats.BytesRead    = m_BytesRead;
+        stats.ReadTime     = m_ReadTime;
+        return stats;
+    }
+
+    // Reads can't be serviced once shut down, but their completion tasks still need to run to release them
+    void IOManager::FailFileReads(const std::vector<FileReadRequest*>& requests)
+    {
+        std::queue<Task> completionTasks;
+        for (auto* pRequest : requests)
+        {
+            pRequest->BytesRead = -1;
+            completionTasks.push(pRequest->CompletionTask);
+        }
+        GetTaskManager()->AddTaskList(completionTasks);
+    }
+
+    // Runs for each I/O thread and services any waiting reads when available
+    void IOManager::IOExecutor()
+    {
+        while (true)
+        {
+            std::vector<FileReadRequest*> fileRequests;
+            {
+                std::unique_lock<std::mutex> lock(m_CriticalSection);
+                m_QueueCondition.wait(lock, [this] { return !this->m_PendingReads.empty() || m_ShuttingDown; });    // Sleep until a read is available or we are shutting down
+
+                if (m_PendingReads.empty())
+                    break;
+
+                // Grab the next read along with every other pending read of the same file so they can share a file handle
+                FileReadRequest* pRequest = m_PendingReads.front();
+                m_PendingReads.pop_front();
+                fileRequests.push_back(pRequest);
+
+                auto pendingIter = m_PendingReads.begin();
+                while (pendingIter != m_PendingReads.end())
+                {
+                    if ((*pendingIter)->FileName == pRequest->FileName)
+                    {
+                        fileRequests.push_back(*pendingIter);
+                        pendingIter = m_PendingReads.erase(pendingIter);
+                    }
+                    else
+                        ++pendingIter;
+                }
+            }
+
+            const auto readStart = std::chrono::steady_clock::now();
+            ServiceFileReads(fileRequests);
+            m_ReadTime += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - readStart).count());
+            m_RequestCount += fileRequests.size();
+
+            // Hand off completion tasks (requests may be released by their completion task, so don't touch them after this)
+            std::queue<Task> completionTasks;
+            for (auto* pRequest : fileRequests)
+                completionTasks.push(pRequest->CompletionTask);
+
+            const uint32_t numCompletedReads = static_cast<uint32_t>(fileRequests.size());
+            GetTaskManager()->AddTaskList(completionTasks);
+            m_ActiveReads -= numCompletedReads;
+        }
+    }
+
+    // Services all reads of a single file (all requests are expected to target the same file)
+    void IOManager::ServiceFileReads(std::vector<FileReadRequest*>& requests)
+    {
+        int64_t fileSize = 0;
+        int32_t fileHandle = OpenFileForRead(requests[0]->FileName.c_str(), &fileSize);
+        if (fileHandle == -1)
+        {
+            for (auto* pRequest : requests)
+                pRequest->BytesRead = -1;
+            return;
+        }
+
+        // Resolve read sizes and reject any read going past the end of the file
+        std::vector<FileReadRequest*> validRequests;
+        validRequests.reserve(requests.size());
+        for (auto* pRequest : requests)
+        {
+            if (pRequest->ReadSize < 0)
+                pRequest->ReadSize = std::max<int64_t>(fileSize - pRequest->ReadOffset, 0);
+
+            if (pRequest->ReadOffset < 0 || pRequest->ReadOffset + pRequest->ReadSize > fileSize)
+                pRequest->BytesRead = -1;
+            else
+                validRequests.push_back(pRequest);
+        }
+
+        // Sort by offset so that neighboring ranges can be merged
+        std::sort(validRequests.begin(), validRequests.end(), [](const FileReadRequest* pLHS, const FileReadRequest* pRHS) { return pLHS->ReadOffset < pRHS->ReadOffset; });
+
+        std::vector<char> coalescedData;
+        size_t firstRequest = 0;
+        while (firstRequest < validRequests.size())
+        {
+            // Extend the range for as long as the next read starts close enough to the end of the current range
+            const int64_t rangeStart = validRequests[firstRequest]->ReadOffset;
+            int64_t       rangeEnd   = rangeStart + validRequests[firstRequest]->ReadSize;
+            size_t        lastRequest = firstRequest + 1;
+            while (lastRequest < validRequests.size() && validRequests[lastRequest]->ReadOffset <= rangeEnd + s_MaxCoalescedReadGap)
+            {
+                rangeEnd = std::max<int64_t>(rangeEnd, validRequests[lastRequest]->ReadOffset + validRequests[lastRequest]->ReadSize);
+                ++lastRequest;
+            }
+
+            if (lastRequest - firstRequest == 1)
+            {
+                // Single read goes straight into the request's data
+                FileReadRequest* pRequest = validRequests[firstRequest];
+                pRequest->Data.resize(static_cast<size_t>(pRequest->ReadSize));
+                pRequest->BytesRead = ReadFileAt(fileHandle, pRequest->Data.data(), pRequest->Data.size(), pRequest->ReadOffset);
+                m_BytesRead += std::max<int64_t>(pRequest->BytesRead, 0);
+            }
+            else
+            {
+                // Read the whole range once, and scatter it to all requests it covers
+                coalescedData.resize(static_cast<size_t>(rangeEnd - rangeStart));
+                int64_t bytesRead = ReadFileAt(fileHandle, coalescedData.data(), coalescedData.size(), rangeStart);
+                m_BytesRead += std::max<int64_t>(bytesRead, 0);
+
+                for (size_t i = firstRequest; i < lastRequest; ++i)
+                {
+                    FileReadRequest* pRequest = validRequests[i];
+                    if (bytesRead < 0)
+                    {
+                        pRequest->BytesRead = -1;
+                        continue;
+                    }
+
+                    auto rangeIter = coalescedData.begin() + static_cast<size_t>(pRequest->ReadOffset - rangeStart);
+                    pRequest->Data.assign(rangeIter, rangeIter + static_cast<size_t>(pRequest->ReadSize));
+                    pRequest->BytesRead = pRequest->ReadSize;
+                }
+            }
+
+            ++m_ReadCount;
+            firstRequest = lastRequest;
+        }
+
+        CloseFileHandle(fileHandle);
+    }
+
+} // namespace cauldron
@@ -0,0 +1,160 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "taskmanager.h"
+#include "../misc/helpers.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cauldron
+{
+    /**
+     * @struct FileReadRequest
+     *
+     * Describes an asynchronous file read to be serviced by the <c><i>IOManager</i></c>.
+     * Once the read has completed (successfully or not), the completion task is handed to
+     * the <c><i>TaskManager</i></c> for execution.
+     *
+     * NOTE** calling code is responsible for the memory backing the request, which must remain
+     * valid until the completion task runs.
+     *
+     * @ingroup CauldronCore
+     */
+    struct FileReadRequest
+    {
+        std::wstring        FileName;               ///< The file to read.
+        int64_t             ReadOffset = 0;         ///< Offset in the file where to start reading.
+        int64_t             ReadSize = -1;          ///< Number of bytes to read. -1 reads from ReadOffset to the end of the file.
+        Task                CompletionTask;         ///< The task to execute once the read has completed (keeps its <c><i>TaskCompletionCallback</i></c> semantics).
+
+        std::vector<char>   Data = {};              ///< The data read from file (filled in by the <c><i>IOManager</i></c>).
+        int64_t             BytesRead = -1;         ///< Number of bytes read, or -1 if the read failed.
+
+        FileReadRequest(const std::wstring& fileName, Task completionTask, int64_t readOffset = 0, int64_t readSize = -1) :
+            FileName(fileName), ReadOffset(readOffset), ReadSize(readSize), CompletionTask(completionTask) {}
+
+    private:
+        FileReadRequest() = delete;
+    };
+
+    /**
+     * @struct IOStats
+     *
+     * Statistics of the reads serviced by the <c><i>IOManager</i></c> since it was initialized.
+     *
+     * @ingroup CauldronCore
+     */
+    struct IOStats
+    {
+        uint64_t RequestCount = 0;  ///< Number of read requests serviced.
+        uint64_t ReadCount    = 0;  ///< Number of reads issued to the file system (coalesced requests share a read).
+        uint64_t BytesRead    = 0;  ///< Number of bytes read from the file system.
+        uint64_t ReadTime     = 0;  ///< Time spent opening and reading files in nanoseconds, summed over all I/O threads.
+    };
+
+    /**
+     * @class IOManager
+     *
+     * The IOManager instance services asynchronous file reads on a small pool of dedicated I/O threads
+     * so that loader tasks running on the <c><i>TaskManager</i></c> never block on the file system.
+     * Requests targeting the same file are serviced through a single file handle, and partial reads of
+     * neighboring ranges are coalesced into a single read.
+     *
+     * @ingroup CauldronCore
+     */
+    class IOManager
+    {
+    public:
+
+        /**
+         * @brief   Constructor with default behavior.
+         */
+        IOManager();
+
+        /**
+         * @brief   Destructor with default behavior.
+         */
+        virtual ~IOManager();
+
+        /**
+         * @brief   Initialization function for the IOManager. Dictates the number of I/O threads.
+         */
+        int32_t Init(uint32_t ioThreadCount);
+
+        /**
+         * @brief   Shuts down the I/O manager and joins all threads once all pending reads are serviced. Called from framework
+         *          shut down procedures, before the task manager shuts down as read completions are handed to it. Reads
+         *          requested after shut down fail right away.
+         */
+        void Shutdown();
+
+        /**
+         * @brief   Enqueues a file read for asynchronous execution.
+         */
+        void ReadFileAsync(FileReadRequest* pRequest);
+
+        /**
+         * @brief   Enqueues multiple file reads for asynchronous execution.
+         */
+        void ReadFilesAsync(const std::vector<FileReadRequest*>& requests);
+
+        /**
+         * @brief   Queries whether the IOManager has any pending or in-flight reads.
+         */
+        bool IsBusy() const { return m_ActiveReads != 0; }
+
+        /**
+         * @brief   Returns the statistics of all reads serviced so far.
+         */
+        IOStats GetStats() const;
+
+    private:
+
+        // No Copy, No Move
+        NO_COPY(IOManager);
+        NO_MOVE(IOManager);
+
+        void IOExecutor();
+        void ServiceFileReads(std::vector<FileReadRequest*>& requests);
+        void FailFileReads(const std::vector<FileReadRequest*>& requests);
+
+        bool                            m_ShuttingDown = false;
+        std::vector<std::thread>        m_IOThreads = {};
+        std::deque<FileReadRequest*>    m_PendingReads = {};
+        std::mutex                      m_CriticalSection;
+        std::condition_variable         m_QueueCondition;
+        std::atomic_uint32_t            m_ActiveReads = 0;
+
+        std::atomic_uint64_t            m_RequestCount = 0;
+        std::atomic_uint64_t            m_ReadCount = 0;
+        std::atomic_uint64_t            m_BytesRead = 0;
+        std::atomic_uint64_t            m_ReadTime = 0;
+    };
+
+} // namespace cauldron
@@ -21,8 +21,12 @@
 // THE SOFTWARE.
 
 #include "gltfloader.h"
+#include "gltfscenecache.h"
+#include "gltfstreamparser.h"
+#include "meshoptdecoder.h"
 #include "../entity.h"
 #include "../framework.h"
+#include "../iomanager.h"
 #include "../taskmanager.h"
 #include "../components/cameracomponent.h"
 #include "../components/lightcomponent.h"
@@ -30,9 +34,11 @@
 #include "../components/animationcomponent.h"
 #include "../../misc/assert.h"
 #include "../../misc/fileio.h"
+#include "../../misc/hash.h"
 #include "../../misc/helpers.h"
 #include "../../misc/math.h"
 #include "../../render/animation.h"
+#include "../../render/cpuskinning.h"
 #include "../../render/device.h"
 #include "../../render/material.h"
 #include "../../render/mesh.h"
@@ -41,7 +47,10 @@
 
 #include "../../render/commandlist.h"
 
+#include <limits>
+#include <set>
 #include <string>
+#include <emmintrin.h>
 
 using namespace std::experimental;
 using namespace math;
@@ -88,98 +97,88 @@ namespace cauldron
     constexpr int g_GLTFComponentType_UnsignedInt   = 5125;
     constexpr int g_GLTFComponentType_Float         = 5126;
 
-    const char* g_LightExtensionName = "KHR_lights_punctual";
+    const char* g_LightExtensionName               = "KHR_lights_punctual";
+    const char* g_MeshQuantizationExtensionName    = "KHR_mesh_quantization";
+    const char* g_MeshoptCompressionExtensionName  = "EXT_meshopt_compression";
 
-    float ReadFloat(const json& object, const char* name, float defaultValue)
+    constexpr uint32_t g_GLBMagic          = 0x46546C67;    // "glTF"
+    constexpr uint32_t g_GLBVersion        = 2;
+    constexpr uint32_t g_GLBChunkType_JSON = 0x4E4F534A;    // "JSON"
+    constexpr uint32_t g_GLBChunkType_BIN  = 0x004E4942;    // "BIN"
+
+    // Fallback buffers only exist to give compressed buffer views a destination, they hold no data of their own
+    bool IsMeshoptFallbackBuffer(const json& buffer)
     {
-        auto it = object.find(name);
-        if (it == object.end())
-            return defaultValue;
+        auto extensionsIt = buffer.find("extensions");
+        if (extensionsIt == buffer.end())
+            return false;
 
-        return it->get<float>();
+        auto compressionIt = extensionsIt->find(g_MeshoptCompressionExtensionName);
+        return compressionIt != extensionsIt->end() && compressionIt->value("fallback", false);
     }
 
-    Vector3 ReadVec3(const json& object, const char* name, Vector3 defaultValue)
+    // Locates the json and (optional) binary chunks of a memory mapped GLB file
+    bool ParseGLBChunks(const MappedFile& glbFile, GLTFBufferSpan& jsonChunk, GLTFBufferSpan& binaryChunk)
     {
-        auto it = object.find(name);
-        if (it == object.end())
-            return defaultValue;
+        struct GLBHeader
+        {
+            uint32_t Magic;
+            uint32_t Version;
+            uint32_t Length;
+        };
 
-        return Vector3(
-            it->at(0).get<float>(),
-            it->at(1).get<float>(),
-            it->at(2).get<float>());
+        struct GLBChunkHeader
+        {
+            uint32_t Length;
+            uint32_t Type;
+        };
+
+        if (glbFile.Size < static_cast<int64_t>(sizeof(GLBHeader)))
+            return false;
+
+        const GLBHeader* pHeader = reinterpret_cast<const GLBHeader*>(glbFile.pData);
+        if (pHeader->Magic != g_GLBMagic || pHeader->Version != g_GLBVersion || pHeader->Length > glbFile.Size)
+            return false;
+
+        // The first chunk must be json, the second (if present) is the binary buffer. Anything else is ignored.
+        size_t offset = sizeof(GLBHeader);
+        for (uint32_t chunkIndex = 0; offset + sizeof(GLBChunkHeader) <= pHeader->Length && chunkIndex < 2; ++chunkIndex)
+        {
+            const GLBChunkHeader* pChunk = reinterpret_cast<const GLBChunkHeader*>(glbFile.pData + offset);
+            offset += sizeof(GLBChunkHeader);
+            if (offset + pChunk->Length > pHeader->Length)
+                return false;
+
+            if (chunkIndex == 0 && pChunk->Type == g_GLBChunkType_JSON)
+                jsonChunk = { glbFile.pData + offset, pChunk->Length };
+            else if (chunkIndex == 1 && pChunk->Type == g_GLBChunkType_BIN)
+                binaryChunk = { glbFile.pData + offset, pChunk->Length };
+
+            offset += pChunk->Length;
+        }
+
+        return jsonChunk.pData != nullptr;
     }
 
-    Quat ReadQuat(const json& object, const char* name, Quat defaultValue)
+    float ReadFloat(const json& object, const char* name, float defaultValue)
     {
         auto it = object.find(name);
         if (it == object.end())
             return defaultValue;
 
-        return Quat(
-            it->at(0).get<float>(),
-            it->at(1).get<float>(),
-            it->at(2).get<float>(),
-            it->at(3).get<float>());
+        return it->get<float>();
     }
 
-    Matrix4 ReadMatrix(const json& object, const char* name, Matrix4 defaultValue)
+    Vector3 ReadVec3(const json& object, const char* name, Vector3 defaultValue)
     {
         auto it = object.find(name);
         if (it == object.end())
             return defaultValue;
 
-        Vector4 col0(
+        return Vector3(
             it->at(0).get<float>(),
             it->at(1).get<float>(),
-            it->at(2).get<float>(),
-            it->at(3).get<float>());
-
-        Vector4 col1(
-            it->at(4).get<float>(),
-            it->at(5).get<float>(),
-            it->at(6).get<float>(),
-            it->at(7).get<float>());
-
-        Vector4 col2(
-            it->at(8).get<float>(),
-            it->at(9).get<float>(),
-            it->at(10).get<float>(),
-            it->at(11).get<float>());
-
-        Vector4 col3(
-            it->at(12).get<float>(),
-            it->at(13).get<float>(),
-            it->at(14).get<float>(),
-            it->at(15).get<float>());
-
-        return Matrix4(
-            col0,
-            col1,
-            col2,
-            col3);
-    }
-
-    void VisitNodeRecursive(int index, const json& nodes, Matrix4 parentTransform, std::vector<cauldron::EntityDataBlock*>& entityDataBlocks, std::vector<bool>& visited)
-    {
-        // update transform
-        Matrix4 transform = entityDataBlocks[index]->pEntity->GetTransform();
-        transform = parentTransform * transform;
-        entityDataBlocks[index]->pEntity->SetTransform(transform);
-
-        // notify visited
-        cauldron::CauldronAssert(cauldron::ASSERT_CRITICAL, !visited[index], L"Node %d has already been visited.", index);
-        visited[index] = true;
-
-        // recursive call
-        const json& node = nodes[index];
-        if (node.find("children") != node.end())
-        {
-            const json& children = node["children"];
-            for (size_t i = 0; i < children.size(); ++i)
-                VisitNodeRecursive(children[i].get<int>(), nodes, transform, entityDataBlocks, visited);
-        }
+            it->at(2).get<float>());
     }
 
     ResourceFormat ResourceDataFormat(AttributeFormat attributeFormat, int32_t resourceFormatID)
@@ -287,6 +286,343 @@ namespace cauldron
             return AttributeFormat::Unknown;
     }
 
+    ResourceFormat NormalizedResourceDataFormat(AttributeFormat attributeFormat, int32_t resourceFormatID)
+    {
+        if (attributeFormat == AttributeFormat::Scalar)
+        {
+            switch (resourceFormatID)
+            {
+            case g_GLTFComponentType_Byte:          return ResourceFormat::R8_SNORM;     // Byte
+            case g_GLTFComponentType_UnsignedByte:  return ResourceFormat::R8_UNORM;     // Unsigned Byte
+            case g_GLTFComponentType_Short:         return ResourceFormat::R16_SNORM;    // Short
+            case g_GLTFComponentType_UnsignedShort: return ResourceFormat::R16_UNORM;    // Unsigned Short
+            }
+        }
+        else if (attributeFormat == AttributeFormat::Vec2)
+        {
+            switch (resourceFormatID)
+            {
+            case g_GLTFComponentType_UnsignedByte:  return ResourceFormat::RG8_UNORM;    // Unsigned Byte
+            case g_GLTFComponentType_Short:         return ResourceFormat::RG16_SNORM;   // Short
+            case g_GLTFComponentType_UnsignedShort: return ResourceFormat::RG16_UNORM;   // Unsigned Short
+            }
+        }
+        else if (attributeFormat == AttributeFormat::Vec4)
+        {
+            switch (resourceFormatID)
+            {
+            case g_GLTFComponentType_Byte:          return ResourceFormat::RGBA8_SNORM;  // Byte
+            case g_GLTFComponentType_UnsignedByte:  return ResourceFormat::RGBA8_UNORM;  // Unsigned Byte
+            case g_GLTFComponentType_Short:         return ResourceFormat::RGBA16_SNORM; // Short
+            case g_GLTFComponentType_UnsignedShort: return ResourceFormat::RGBA16_UNORM; // Unsigned Short
+            }
+        }
+
+        // No 3-component (or 2-component signed byte) normalized formats
+        return ResourceFormat::Unknown;
+    }
+
+    // Without KHR_mesh_quantization integer vertex attributes are always normalized (some exporters omit the flag),
+    // with it the flag is authoritative and defaults to false as per spec
+    bool IsAccessorNormalized(const json& accessor, const GLTFDataRep& gltfData)
+    {
+        return accessor.value("normalized", !gltfData.UsesMeshQuantization);
+    }
+
+    // Returns the normalized format an integer accessor can be kept in natively (Unknown if it needs to be converted to float)
+    ResourceFormat NativeNormalizedFormat(const json& accessor, const GLTFDataRep& gltfData)
+    {
+        if (!GetConfig()->NativeVertexFormats || !IsAccessorNormalized(accessor, gltfData))
+            return ResourceFormat::Unknown;
+
+        return NormalizedResourceDataFormat(ResourceFormatType(accessor["type"].get<std::string>()), accessor["componentType"].get<int32_t>());
+    }
+
+    // Returns the scale to apply to integer accessor values (and their min/max) to get their float value
+    float AccessorValueScale(int32_t componentType, bool normalized)
+    {
+        if (!normalized)
+            return 1.f;
+
+        switch (componentType)
+        {
+        case g_GLTFComponentType_UnsignedByte:  return 1.f / 255.f;
+        case g_GLTFComponentType_Byte:          return 1.f / 127.f;
+        case g_GLTFComponentType_UnsignedShort: return 1.f / 65535.f;
+        case g_GLTFComponentType_Short:         return 1.f / 32767.f;
+        default:                                return 1.f;
+        }
+    }
+
+    const char* GetBufferViewData(const json& bufferView, const GLTFDataRep& gltfData, size_t byteOffset, size_t byteLength)
+    {
+        const int    bufferID         = bufferView["buffer"];
+        const size_t bufferViewOffset = bufferView.value("byteOffset", static_cast<size_t>(0));
+        CauldronAssert(ASSERT_CRITICAL, byteOffset + byteLength <= bufferView["byteLength"].get<size_t>(), L"Data out of buffer view bounds.");
+        CauldronAssert(ASSERT_CRITICAL, bufferViewOffset + byteOffset + byteLength <= gltfData.GLTFBuffers[bufferID].Size, L"Data out of buffer bounds.");
+        return gltfData.GLTFBuffers[bufferID].pData + bufferViewOffset + byteOffset;
+    }
+
+    // Returns a pointer to the element data of an accessor along with the stride between its elements.
+    // Sparse accessors (and accessors without a buffer view) are resolved into a tightly packed copy held in resolvedData.
+    const char* ResolveAccessorData(const json& accessor, const json& bufferViews, const GLTFDataRep& gltfData, size_t elementSize, size_t& elementStride, std::vector<char>& resolvedData)
+    {
+        const uint32_t count      = accessor["count"].get<uint32_t>();
+        const size_t   byteOffset = accessor.value("byteOffset", static_cast<size_t>(0));
+
+        const char* pData = nullptr;
+        elementStride = elementSize;
+        auto bufferViewIt = accessor.find("bufferView");
+        if (bufferViewIt != accessor.end())
+        {
+            const json& bufferView = bufferViews[bufferViewIt->get<int>()];
+            elementStride = bufferView.value("byteStride", elementSize);
+
+            const size_t totalLength = count ? (count - 1) * elementStride + elementSize : 0;
+            pData = GetBufferViewData(bufferView, gltfData, byteOffset, totalLength);
+        }
+
+        auto sparseIt = accessor.find("sparse");
+        if (sparseIt == accessor.end())
+        {
+            CauldronAssert(ASSERT_CRITICAL, pData != nullptr, L"Accessor has neither a buffer view nor sparse data.");
+            return pData;
+        }
+
+        // Start from the dense data (or zeros) and apply the sparse substitutions over it
+        resolvedData.assign(count * elementSize, 0);
+        if (pData != nullptr)
+        {
+            for (uint32_t i = 0; i < count; ++i)
+                memcpy(resolvedData.data() + i * elementSize, pData + i * elementStride, elementSize);
+        }
+
+        const json&    sparse      = *sparseIt;
+        const json&    indices     = sparse["indices"];
+        const json&    values      = sparse["values"];
+        const uint32_t sparseCount = sparse["count"].get<uint32_t>();
+        const int32_t  indexType   = indices["componentType"];
+        const size_t   indexSize   = ResourceDataStride(indexType);
+
+        const char* pIndices = GetBufferViewData(bufferViews[indices["bufferView"].get<int>()], gltfData, indices.value("byteOffset", static_cast<size_t>(0)), sparseCount * indexSize);
+        const char* pValues  = GetBufferViewData(bufferViews[values["bufferView"].get<int>()], gltfData, values.value("byteOffset", static_cast<size_t>(0)), sparseCount * elementSize);
+        for (uint32_t i = 0; i < sparseCount; ++i)
+        {
+            uint32_t index = 0;
+            switch (indexType)
+            {
+            case g_GLTFComponentType_UnsignedByte:  index = reinterpret_cast<const uint8_t*>(pIndices)[i]; break;
+            case g_GLTFComponentType_UnsignedShort: index = reinterpret_cast<const uint16_t*>(pIndices)[i]; break;
+            case g_GLTFComponentType_UnsignedInt:   index = reinterpret_cast<const uint32_t*>(pIndices)[i]; break;
+            default: CauldronCritical(L"Invalid sparse accessor index type."); break;
+            }
+
+            CauldronAssert(ASSERT_CRITICAL, index < count, L"Sparse accessor index out of bounds.");
+            memcpy(resolvedData.data() + index * elementSize, pValues + i * elementSize, elementSize);
+        }
+
+        elementStride = elementSize;
+        return resolvedData.data();
+    }
+
+    inline void StoreConvertedComponents(float* pDstData, __m128i components, __m128 scale, bool clampToMinusOne)
+    {
+        __m128 converted = _mm_mul_ps(_mm_cvtepi32_ps(components), scale);
+        if (clampToMinusOne)
+            converted = _mm_max_ps(converted, _mm_set1_ps(-1.f));
+        _mm_storeu_ps(pDstData, converted);
+    }
+
+    // Converts a contiguous run of integer components to scaled floats (16 bytes of source data at a time)
+    void ConvertComponentRun(const char* pSrcData, int32_t componentType, size_t componentCount, float scale, bool clampToMinusOne, float* pDstData)
+    {
+        const __m128  vScale = _mm_set1_ps(scale);
+        const __m128i zero   = _mm_setzero_si128();
+
+        size_t i = 0;
+        switch (componentType)
+        {
+        case g_GLTFComponentType_UnsignedByte:
+        {
+            const uint8_t* pData = reinterpret_cast<const uint8_t*>(pSrcData);
+            for (; i + 16 <= componentCount; i += 16)
+            {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+                __m128i lo16  = _mm_unpacklo_epi8(bytes, zero);
+                __m128i hi16  = _mm_unpackhi_epi8(bytes, zero);
+                StoreConvertedComponents(pDstData + i,      _mm_unpacklo_epi16(lo16, zero), vScale, false);
+                StoreConvertedComponents(pDstData + i + 4,  _mm_unpackhi_epi16(lo16, zero), vScale, false);
+                StoreConvertedComponents(pDstData + i + 8,  _mm_unpacklo_epi16(hi16, zero), vScale, false);
+                StoreConvertedComponents(pDstData + i + 12, _mm_unpackhi_epi16(hi16, zero), vScale, false);
+            }
+            for (; i < componentCount; ++i)
+                pDstData[i] = float(pData[i]) * scale;
+            break;
+        }
+        case g_GLTFComponentType_Byte:
+        {
+            // Sign extend by unpacking into the high half and arithmetic shifting back down
+            const int8_t* pData = reinterpret_cast<const int8_t*>(pSrcData);
+            for (; i + 16 <= componentCount; i += 16)
+            {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+                __m128i lo16  = _mm_srai_epi16(_mm_unpacklo_epi8(bytes, bytes), 8);
+                __m128i hi16  = _mm_srai_epi16(_mm_unpackhi_epi8(bytes, bytes), 8);
+                StoreConvertedComponents(pDstData + i,      _mm_srai_epi32(_mm_unpacklo_epi16(lo16, lo16), 16), vScale, clampToMinusOne);
+                StoreConvertedComponents(pDstData + i + 4,  _mm_srai_epi32(_mm_unpackhi_epi16(lo16, lo16), 16), vScale, clampToMinusOne);
+                StoreConvertedComponents(pDstData + i + 8,  _mm_srai_epi32(_mm_unpacklo_epi16(hi16, hi16), 16), vScale, clampToMinusOne);
+                StoreConvertedComponents(pDstData + i + 12, _mm_srai_epi32(_mm_unpackhi_epi16(hi16, hi16), 16), vScale, clampToMinusOne);
+            }
+            for (; i < componentCount; ++i)
+                pDstData[i] = clampToMinusOne ? std::max<float>(float(pData[i]) * scale, -1.f) : float(pData[i]) * scale;
+            break;
+        }
+        case g_GLTFComponentType_UnsignedShort:
+        {
+            const uint16_t* pData = reinterpret_cast<const uint16_t*>(pSrcData);
+            for (; i + 8 <= componentCount; i += 8)
+            {
+                __m128i shorts = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+                StoreConvertedComponents(pDstData + i,     _mm_unpacklo_epi16(shorts, zero), vScale, false);
+                StoreConvertedComponents(pDstData + i + 4, _mm_unpackhi_epi16(shorts, zero), vScale, false);
+            }
+            for (; i < componentCount; ++i)
+                pDstData[i] = float(pData[i]) * scale;
+            break;
+        }
+        case g_GLTFComponentType_Short:
+        {
+            const int16_t* pData = reinterpret_cast<const int16_t*>(pSrcData);
+            for (; i + 8 <= componentCount; i += 8)
+            {
+                __m128i shorts = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+                StoreConvertedComponents(pDstData + i,     _mm_srai_epi32(_mm_unpacklo_epi16(shorts, shorts), 16), vScale, clampToMinusOne);
+                StoreConvertedComponents(pDstData + i + 4, _mm_srai_epi32(_mm_unpackhi_epi16(shorts, shorts), 16), vScale, clampToMinusOne);
+            }
+            for (; i < componentCount; ++i)
+                pDstData[i] = clampToMinusOne ? std::max<float>(float(pData[i]) * scale, -1.f) : float(pData[i]) * scale;
+            break;
+        }
+        }
+    }
+
+    // Converts (possibly strided) integer components to floats, normalizing them as per the glTF spec if requested
+    bool ConvertComponentsToFloat(const char* pSrcData, int32_t componentType, bool normalized, uint32_t count, uint32_t dimension, size_t srcStride, float* pDstData)
+    {
+        if (componentType != g_GLTFComponentType_UnsignedByte && componentType != g_GLTFComponentType_Byte &&
+            componentType != g_GLTFComponentType_UnsignedShort && componentType != g_GLTFComponentType_Short)
+            return false;
+
+        const float scale = AccessorValueScale(componentType, normalized);
+
+        // Tightly packed data is converted as one run of components, strided data one element at a time
+        const size_t elementSize = ResourceDataStride(componentType) * dimension;
+        if (srcStride == 0 || srcStride == elementSize)
+        {
+            ConvertComponentRun(pSrcData, componentType, static_cast<size_t>(count) * dimension, scale, normalized, pDstData);
+        }
+        else
+        {
+            for (uint32_t i = 0; i < count; ++i)
+                ConvertComponentRun(pSrcData + i * srcStride, componentType, dimension, scale, normalized, pDstData + i * dimension);
+        }
+
+        return true;
+    }
+
+    // Reads the components of an accessor as tightly packed floats, converting integer data as needed
+    bool ReadAccessorFloats(const json& accessor, const json& bufferViews, const GLTFDataRep& gltfData, std::vector<float>& values, uint32_t& dimension)
+    {
+        const int32_t  componentType = accessor["componentType"];
+        const uint32_t count         = accessor["count"].get<uint32_t>();
+        dimension = ResourceFormatDimension(accessor["type"].get<std::string>());
+
+        std::vector<char> resolvedData;
+        size_t srcStride = 0;
+        const char* pData = ResolveAccessorData(accessor, bufferViews, gltfData, ResourceDataStride(componentType) * dimension, srcStride, resolvedData);
+
+        values.resize(static_cast<size_t>(count) * dimension);
+        if (componentType != g_GLTFComponentType_Float)
+            return ConvertComponentsToFloat(pData, componentType, IsAccessorNormalized(accessor, gltfData), count, dimension, srcStride, values.data());
+
+        for (uint32_t i = 0; i < count; ++i)
+            memcpy(values.data() + static_cast<size_t>(i) * dimension, pData + i * srcStride, dimension * sizeof(float));
+        return true;
+    }
+
+    // Builds the CPU copy of a skinned primitive's bind pose and joint influences (returns nullptr if the primitive isn't skinned)
+    CPUSkinningSource* BuildCPUSkinningSource(const json& attributes, const json& accessors, const json& bufferViews, const GLTFDataRep& gltfData)
+    {
+        if (!attributes.contains("POSITION") || !attributes.contains("JOINTS_0") || !attributes.contains("WEIGHTS_0"))
+            return nullptr;
+
+        const uint32_t setCount = (attributes.contains("JOINTS_1") && attributes.contains("WEIGHTS_1")) ? 2 : 1;
+
+        CPUSkinningSource* pSource = new CPUSkinningSource();
+        std::vector<float> values;
+        uint32_t dimension = 0;
+
+        bool success = ReadAccessorFloats(accessors[attributes["POSITION"].get<int>()], bufferViews, gltfData, values, dimension) && dimension >= 3;
+        if (success)
+        {
+            pSource->VertexCount = static_cast<uint32_t>(values.size() / dimension);
+            pSource->Positions.resize(pSource->VertexCount);
+            for (uint32_t v = 0; v < pSource->VertexCount; ++v)
+                pSource->Positions[v] = Vec4(values[v * dimension], values[v * dimension + 1], values[v * dimension + 2], 1.f);
+        }
+
+        if (success && attributes.contains("NORMAL"))
+        {
+            success = ReadAccessorFloats(accessors[attributes["NORMAL"].get<int>()], bufferViews, gltfData, values, dimension) &&
+                      dimension >= 3 && values.size() / dimension == pSource->VertexCount;
+            if (success)
+            {
+                pSource->Normals.resize(pSource->VertexCount);
+                for (uint32_t v = 0; v < pSource->VertexCount; ++v)
+                    pSource->Normals[v] = Vec4(values[v * dimension], values[v * dimension + 1], values[v * dimension + 2], 0.f);
+            }
+        }
+
+        pSource->InfluenceCount = 4 * setCount;
+        pSource->Joints.resize(static_cast<size_t>(pSource->VertexCount) * pSource->InfluenceCount);
+        pSource->Weights.resize(pSource->Joints.size());
+        for (uint32_t set = 0; success && set < setCount; ++set)
+        {
+            const json& jointsAccessor = accessors[attributes[set ? "JOINTS_1" : "JOINTS_0"].get<int>()];
+            const int32_t jointType    = jointsAccessor["componentType"];
+            success = jointsAccessor["count"].get<uint32_t>() == pSource->VertexCount &&
+                      (jointType == g_GLTFComponentType_UnsignedByte || jointType == g_GLTFComponentType_UnsignedShort);
+            if (!success)
+                break;
+
+            std::vector<char> resolvedData;
+            size_t jointStride = 0;
+            const char* pJoints = ResolveAccessorData(jointsAccessor, bufferViews, gltfData, ResourceDataStride(jointType) * 4, jointStride, resolvedData);
+
+            success = ReadAccessorFloats(accessors[attributes[set ? "WEIGHTS_1" : "WEIGHTS_0"].get<int>()], bufferViews, gltfData, values, dimension) &&
+                      dimension == 4 && values.size() / dimension == pSource->VertexCount;
+            for (uint32_t v = 0; success && v < pSource->VertexCount; ++v)
+            {
+                for (uint32_t c = 0; c < 4; ++c)
+                {
+                    const size_t dst = static_cast<size_t>(v) * pSource->InfluenceCount + set * 4 + c;
+                    pSource->Joints[dst]  = (jointType == g_GLTFComponentType_UnsignedByte) ? reinterpret_cast<const uint8_t*>(pJoints + v * jointStride)[c]
+                                                                                           : reinterpret_cast<const uint16_t*>(pJoints + v * jointStride)[c];
+                    pSource->Weights[dst] = values[v * 4 + c];
+                }
+            }
+        }
+
+        if (!success)
+        {
+            CauldronWarning(L"Unsupported skinning data layout, surface will not be skinned on the CPU.");
+            delete pSource;
+            return nullptr;
+        }
+
+        return pSource;
+    }
+
     //////////////////////////////////////////////////////////////////////////
     // GLTFLoader
 
@@ -328,211 +664,96 @@ namespace cauldron
             // And the content block that will hold references to all the managed content in this block (textures, buffers, entities)
             glTFDataRep->pLoadedContentRep = new ContentBlock();
 
+            // Scene entities get created once the scene description, the textures and the buffer assets are all in
+            glTFDataRep->pSceneReadyCallback = new TaskCompletionCallback(Task([this](void* pParam) { PostGLTFContentLoadCompleted(pParam); }, glTFDataRep), 3);
+
             // Add the name of the file all content was loaded from (will be used to uniquely identify internal assets like meshes and animations)
             glTFDataRep->GLTFFilePath = filePathString;
             glTFDataRep->GLTFFileName = pFileToLoad->c_str();
 
             // Start by loading the glTF file and reading in all the json data
             glTFDataRep->pGLTFJsonData = new json();
-            CauldronAssert(ASSERT_CRITICAL, ParseJsonFile(pFileToLoad->c_str(), *glTFDataRep->pGLTFJsonData), L"Could not parse JSON file %ls", pFileToLoad->c_str());
 
-            // Grab the handle to the GLTF data
-            const json& glTFData = *glTFDataRep->pGLTFJsonData;
-            bool hasImages = glTFData.find("images") != glTFData.end();
-            bool hasBuffers = glTFData.find("buffers") != glTFData.end();
-            bool hasMaterials = glTFData.find("materials") != glTFData.end();
-            bool hasSamplers = glTFData.find("samplers") != glTFData.end();
-            bool hasTextureRedirects = glTFData.find("textures") != glTFData.end();
-
-            std::vector<bool>   textureSRGBMap;
-            if (hasImages)
-                textureSRGBMap.resize(glTFData["images"].size(), false);
-
-            // Load available sampler descriptors so they can be added to material information when needed
-            std::vector<SamplerDesc>    textureSamplers;
-            if (hasSamplers)
+            // GLB files are mapped, their json is parsed in place and buffer data will be read straight from the mapping
+            GLTFBufferSpan jsonSource;
+            std::vector<char> sourceData;
+            if (pFileToLoad->extension() == L".glb" || pFileToLoad->extension() == L".GLB")
+            {
+                bool validGLB = MapFileForRead(pFileToLoad->c_str(), glTFDataRep->GLBFile) && ParseGLBChunks(glTFDataRep->GLBFile, jsonSource, glTFDataRep->GLBBinaryChunk);
+                CauldronAssert(ASSERT_CRITICAL, validGLB, L"Could not read GLB file %ls", pFileToLoad->c_str());
+            }
+            else
             {
-                // Read samplers that are present into the file (sampler desc defaults to clamped linear
-                SamplerDesc samplerDesc = {};
+                int64_t fileSize = GetFileSize(pFileToLoad->c_str());
+                sourceData.resize(std::max<int64_t>(fileSize, 0));
+                CauldronAssert(ASSERT_CRITICAL, fileSize >= 0 && ReadFileAll(pFileToLoad->c_str(), sourceData.data(), sourceData.size()) == fileSize, L"Could not read GLTF file %ls", pFileToLoad->c_str());
+                jsonSource = { sourceData.data(), sourceData.size() };
+            }
 
-                // Will need config settings to initialize the device
-                const CauldronConfig* pConfig = GetConfig();
+            // Only parse the source file if the scene cache is stale
+            if (GetConfig()->UseSceneCache)
+            {
+                glTFDataRep->SourceHash = GLTFSceneCache::HashSourceData(jsonSource.pData, jsonSource.Size);
+                glTFDataRep->LoadedFromCache = GLTFSceneCache::Load(*glTFDataRep);
+                glTFDataRep->CookSceneCache = !glTFDataRep->LoadedFromCache;
+            }
 
-                const json& samplers = glTFData["samplers"];
-                for (size_t i = 0; i < samplers.size(); ++i)
+            // Stream the scene description in, kicking off buffer and texture loads as soon as everything they depend on has been parsed
+            bool texturesDispatched = false;
+            TaskCompletionCallback* pBufferLoadCallback = nullptr;
+            if (!glTFDataRep->LoadedFromCache)
+            {
+                const bool embeddedImages = glTFDataRep->GLBBinaryChunk.pData != nullptr;
+                std::set<std::string> parsedMembers;
+                auto memberParsed = [&](const std::string& memberName)
                 {
-                    // ALl values come from glTF 2.0 spec here: https://www.khronos.org/registry/glTF/specs/2.0/glTF-2.0.html#reference-sampler
-                    const json& sampler = samplers[i];
-
-                    // Set min/mag/mip filter accordingly
-                    int32_t magFilter(9729), minFilter(9729);
-                    if (sampler.find("magFilter") != sampler.end())
-                        magFilter = sampler["magFilter"];
-                    if (sampler.find("minFilter") != sampler.end())
-                        minFilter = sampler["minFilter"];
-
-                    // Mag filter can be NEAREST (9728) or LINEAR (9729)
-
-                    // Min filter represents:
-                    //  NEAREST                 (9728)
-                    //  LINEAR                  (9729)
-                    //  NEAREST_MIPMAP_NEAREST  (9984)
-                    //  LINEAR_MIPMAP_NEAREST   (9985)
-                    //  NEAREST_MIPMAP_LINEAR   (9986)
-                    //  LINEAR_MIPMAP_LINEAR    (9987)
-
-                    // If this isn't explicitly nearest, use linear filtering
-                    // unless we are overriding samplers, in which case we'll use anisotropic
-                    if (magFilter != 9728 && minFilter != 9728)
-                    {
-                        if (pConfig->OverrideSceneSamplers)
-                        {
-                            samplerDesc.Filter = FilterFunc::Anisotropic;
-                        }
-                        else
-                        {
-                            samplerDesc.Filter = FilterFunc::MinMagMipLinear;
-                        }
-                    }
-                    else
-                    {
-                        if (magFilter == 9728)
-                        {
-                            switch (minFilter)
-                            {
-                            case 9728:                                                                      // NEAREST
-                            case 9984: samplerDesc.Filter = FilterFunc::MinMagMipPoint; break;              // NEAREST_MIPMAP_NEAREST
-                            case 9729:                                                                      // LINEAR
-                            case 9987: samplerDesc.Filter = FilterFunc::MinLinearMagPointMipLinear; break;  // LINEAR_MIPMAP_LINEAR
-                            case 9985: samplerDesc.Filter = FilterFunc::MinLinearMagMipPoint; break;        // LINEAR_MIPMAP_NEAREST
-                            case 9986: samplerDesc.Filter = FilterFunc::MinMagPointMipLinear; break;        // NEAREST_MIPMAP_LINEAR
-                            default: CauldronError(L"Unsupported sampler filter combination detected"); break;
-                            }
-                        }
-                        else
-                        {
-                            switch (minFilter)
-                            {
-                            case 9728:                                                                      // NEAREST
-                            case 9984: samplerDesc.Filter = FilterFunc::MinPointMagLinearMipPoint; break;   // NEAREST_MIPMAP_NEAREST
-                            case 9729:                                                                      // LINEAR
-                            case 9987: samplerDesc.Filter = FilterFunc::MinMagMipLinear; break;             // LINEAR_MIPMAP_LINEAR
-                            case 9985: samplerDesc.Filter = FilterFunc::MinMagLinearMipPoint; break;        // LINEAR_MIPMAP_NEAREST
-                            case 9986: samplerDesc.Filter = FilterFunc::MinPointMagMipLinear; break;        // NEAREST_MIPMAP_LINEAR
-                            default: CauldronError(L"Unsupported sampler filter combination detected"); break;
-                            }
-                        }
-                    }
+                    parsedMembers.insert(memberName);
+                    if (memberName == "buffers")
+                        pBufferLoadCallback = DispatchBufferLoads(glTFDataRep);
 
-                    // Set proper wrap mode
-                    int32_t wrapU(10497), wrapV(10497);
-                    if (sampler.find("wrapS") != sampler.end())
-                        wrapU = sampler["wrapS"];
-                    if (sampler.find("wrapT") != sampler.end())
-                        wrapV = sampler["wrapT"];
-                    switch (wrapU)
+                    if (!texturesDispatched && parsedMembers.count("images") && parsedMembers.count("materials") && parsedMembers.count("textures") &&
+                        parsedMembers.count("samplers") && (!embeddedImages || (parsedMembers.count("bufferViews") && parsedMembers.count("buffers"))))
                     {
-                    case 33071: samplerDesc.AddressU = AddressMode::Clamp; break;   // CLAMP_TO_EDGE
-                    case 33648: samplerDesc.AddressU = AddressMode::Mirror; break;  // MIRRORED_REPEAT
-                    case 10497: samplerDesc.AddressU = AddressMode::Wrap; break;    // REPEAT
-                    default: CauldronError(L"Unsupported glTF sampler wrap mode detected"); break;
+                        DispatchTextureLoads(glTFDataRep);
+                        texturesDispatched = true;
                     }
+                };
 
-                    switch (wrapV)
-                    {
-                    case 33071: samplerDesc.AddressV = AddressMode::Clamp; break;   // CLAMP_TO_EDGE
-                    case 33648: samplerDesc.AddressV = AddressMode::Mirror; break;  // MIRRORED_REPEAT
-                    case 10497: samplerDesc.AddressV = AddressMode::Wrap; break;    // REPEAT
-                    default: CauldronError(L"Unsupported glTF sampler wrap mode detected"); break;
-                    }
-
-                    textureSamplers.push_back(samplerDesc);
-                }
+                bool parsed = GLTFStreamParser::Parse(jsonSource.pData, jsonSource.Size, *glTFDataRep, memberParsed);
+                CauldronAssert(ASSERT_CRITICAL, parsed, L"Could not parse JSON file %ls", pFileToLoad->c_str());
             }
 
-            // Read in material information and build up partially completed material info (textures will be fixed up later)
-            // material information required ahead of texture and buffer being done loading to properly setup textures and meshes
-            if (hasMaterials)
-            {
-                // Init the material data in the content block
-                const json& materials = glTFData["materials"];
-                glTFDataRep->pLoadedContentRep->Materials.resize(materials.size());
+            // Grab the handle to the GLTF data
+            const json& glTFData = *glTFDataRep->pGLTFJsonData;
+            bool hasBuffers = glTFData.find("buffers") != glTFData.end();
 
-                // Load texture redirects
-                json empty;
-                const json& textures = hasTextureRedirects ? glTFData["textures"] : empty;
+            // Quantized data changes how integer accessors are interpreted, so it needs to be known before buffers get processed
+            auto extensionsUsedIt = glTFData.find("extensionsUsed");
+            if (extensionsUsedIt != glTFData.end())
+                glTFDataRep->UsesMeshQuantization = std::find(extensionsUsedIt->begin(), extensionsUsedIt->end(), g_MeshQuantizationExtensionName) != extensionsUsedIt->end();
 
-                // Go through all the materials and pre-init them with everything except the valid texture pointers (which we will fixup after
-                // textures are loaded). This will also create an SRGB format map for texture loading so we don't have to re-scan the materials.
-                for (size_t i = 0; i < materials.size(); ++i)
-                {
-                    const json& materialEntry = materials[i];
-                    glTFDataRep->pLoadedContentRep->Materials[i] = new Material();
-                    glTFDataRep->pLoadedContentRep->Materials[i]->InitFromGLTFData(materialEntry, textures, textureSRGBMap, textureSamplers);
-                }
-            }
-            else
+            // Load materials and textures if the scene description didn't allow for it while parsing
+            if (!texturesDispatched)
+                DispatchTextureLoads(glTFDataRep);
+
+            if (hasBuffers && glTFDataRep->LoadedFromCache)
             {
-                // Default material
-                glTFDataRep->pLoadedContentRep->Materials.resize(1);
-                glTFDataRep->pLoadedContentRep->Materials[0] = new Material();
-                glTFDataRep->pLoadedContentRep->Materials[0]->SetDoubleSided(true);
+                // Buffer data was already read in from the scene cache, go straight to processing it
+                Task buffersLoadedTask(&GLTFLoader::LoadGLTFBuffersCompleted, glTFDataRep);
+                GetTaskManager()->AddTask(buffersLoadedTask);
             }
-
-            // Load all textures, and when done, continue initialization of resources
-            // Note that we are loading "images" and not "textures" in case multiple textures point to the same image source (which is against spec, but I don't trust it)
-            if (hasImages)
+            else if (hasBuffers)
             {
-                const json& images = glTFData["images"];
-                std::vector<TextureLoadInfo> texLoadInfo;
-                for (size_t i = 0; i < images.size(); ++i)
-                {
-                    const std::string& uriName = images[i]["uri"];
-                    filesystem::path filePath = filePathString + StringToWString(uriName);
-
-                    // Push the load info
-                    texLoadInfo.emplace_back(filePath, textureSRGBMap[i]);
-                }
-
-                // Load all the textures in the background
-                GetContentManager()->LoadTextures(texLoadInfo, &GLTFLoader::LoadGLTFTexturesCompleted, glTFDataRep);
+                // Now that the whole scene description is available, release the buffer processing
+                GetTaskManager()->SignalTaskCompletion(pBufferLoadCallback);
             }
-
-            // Now, schedule asynchronous loads of all the buffer data while we setup
-            // other structures (if we have any)
-            if (hasBuffers)
+            else
             {
-                // Reserve the right number of entries
-                const json& buffers = glTFData["buffers"];
-                glTFDataRep->GLTFBufferData.resize(buffers.size());
-
-                // Load them asynchronously
-                TaskCompletionCallback* pCompletionCallback = new TaskCompletionCallback(Task(&GLTFLoader::LoadGLTFBuffersCompleted, glTFDataRep), static_cast<uint32_t>(buffers.size()));
-
-                std::queue<Task>   taskList;
-                for (size_t i = 0; i < buffers.size(); ++i)
-                {
-                    GLTFBufferLoadParams* pBufferLoadParams = new GLTFBufferLoadParams();
-                    pBufferLoadParams->pGLTFData = glTFDataRep;
-                    pBufferLoadParams->BufferIndex = (uint32_t)i;
-                    const std::string& uriName = buffers[i]["uri"];
-                    pBufferLoadParams->BufferName = filePathString + StringToWString(uriName);
-
-                    // Verify the file exists, otherwise we don't want to load
-                    // We can get around textures not being there, but not whole buffer info
-                    filesystem::path uriFile(pBufferLoadParams->BufferName);
-                    CauldronAssert(ASSERT_ERROR, filesystem::exists(uriFile), L"Buffer file %ls does not exist", pBufferLoadParams->BufferName.c_str());
-
-                    // Push the task
-                    taskList.push(Task(&GLTFLoader::LoadGLTFBuffer, pBufferLoadParams, pCompletionCallback));
-                }
-
-                // If all buffers were found, trigger the loading
-                GetTaskManager()->AddTaskList(taskList);
+                // Nothing to load, buffer assets are done
+                GetTaskManager()->SignalTaskCompletion(glTFDataRep->pSceneReadyCallback);
             }
 
             // Load lights
-            auto extensionsUsedIt = glTFData.find("extensionsUsed");
             if (extensionsUsedIt != glTFData.end())
             {
                 bool hasLights = false;
@@ -630,15 +851,267 @@ namespace cauldron
                 }
             }
 
-            // For now, just create a task to call when all other loads are done (this task may wait for the loads to complete)
-            Task newTask(std::bind(&GLTFLoader::PostGLTFContentLoadCompleted, this, std::placeholders::_1), glTFDataRep);
-            GetTaskManager()->AddTask(newTask);
+            // Scene description is done
+            GetTaskManager()->SignalTaskCompletion(glTFDataRep->pSceneReadyCallback);
         }
 
         // Done with file path data
         delete pFileToLoad;
     }
 
+    // Reads in samplers and materials (texture pointers get fixed up once loaded) and kicks off the loading of all images
+    void GLTFLoader::DispatchTextureLoads(GLTFDataRep* pGLTFData)
+    {
+        const json& glTFData = *pGLTFData->pGLTFJsonData;
+        bool hasImages = glTFData.find("images") != glTFData.end();
+        bool hasMaterials = glTFData.find("materials") != glTFData.end();
+        bool hasSamplers = glTFData.find("samplers") != glTFData.end();
+        bool hasTextureRedirects = glTFData.find("textures") != glTFData.end();
+
+        std::vector<bool>   textureSRGBMap;
+        if (hasImages)
+            textureSRGBMap.resize(glTFData["images"].size(), false);
+
+        // Load available sampler descriptors so they can be added to material information when needed
+        std::vector<SamplerDesc>    textureSamplers;
+        if (hasSamplers)
+        {
+            // Read samplers that are present into the file (sampler desc defaults to clamped linear
+            SamplerDesc samplerDesc = {};
+
+            // Will need config settings to initialize the device
+            const CauldronConfig* pConfig = GetConfig();
+
+            const json& samplers = glTFData["samplers"];
+            for (size_t i = 0; i < samplers.size(); ++i)
+            {
+                // ALl values come from glTF 2.0 spec here: https://www.khronos.org/registry/glTF/specs/2.0/glTF-2.0.html#reference-sampler
+                const json& sampler = samplers[i];
+
+                // Set min/mag/mip filter accordingly
+                int32_t magFilter(9729), minFilter(9729);
+                if (sampler.find("magFilter") != sampler.end())
+                    magFilter = sampler["magFilter"];
+                if (sampler.find("minFilter") != sampler.end())
+                    minFilter = sampler["minFilter"];
+
+                // Mag filter can be NEAREST (9728) or LINEAR (9729)
+
+                // Min filter represents:
+                //  NEAREST                 (9728)
+                //  LINEAR                  (9729)
+                //  NEAREST_MIPMAP_NEAREST  (9984)
+                //  LINEAR_MIPMAP_NEAREST   (9985)
+                //  NEAREST_MIPMAP_LINEAR   (9986)
+                //  LINEAR_MIPMAP_LINEAR    (9987)
+
+                // If this isn't explicitly nearest, use linear filtering
+                // unless we are overriding samplers, in which case we'll use anisotropic
+                if (magFilter != 9728 && minFilter != 9728)
+                {
+                    if (pConfig->OverrideSceneSamplers)
+                    {
+                        samplerDesc.Filter = FilterFunc::Anisotropic;
+                    }
+                    else
+                    {
+                        samplerDesc.Filter = FilterFunc::MinMagMipLinear;
+                    }
+                }
+                else
+                {
+                    if (magFilter == 9728)
+                    {
+                        switch (minFilter)
+                        {
+                        case 9728:                                                                      // NEAREST
+                        case 9984: samplerDesc.Filter = FilterFunc::MinMagMipPoint; break;              // NEAREST_MIPMAP_NEAREST
+                        case 9729:                                                                      // LINEAR
+                        case 9987: samplerDesc.Filter = FilterFunc::MinLinearMagPointMipLinear; break;  // LINEAR_MIPMAP_LINEAR
+                        case 9985: samplerDesc.Filter = FilterFunc::MinLinearMagMipPoint; break;        // LINEAR_MIPMAP_NEAREST
+                        case 9986: samplerDesc.Filter = FilterFunc::MinMagPointMipLinear; break;        // NEAREST_MIPMAP_LINEAR
+                        default: CauldronError(L"Unsupported sampler filter combination detected"); break;
+                        }
+                    }
+                    else
+                    {
+                        switch (minFilter)
+                        {
+                        case 9728:                                                                      // NEAREST
+                        case 9984: samplerDesc.Filter = FilterFunc::MinPointMagLinearMipPoint; break;   // NEAREST_MIPMAP_NEAREST
+                        case 9729:                                                                      // LINEAR
+                        case 9987: samplerDesc.Filter = FilterFunc::MinMagMipLinear; break;             // LINEAR_MIPMAP_LINEAR
+                        case 9985: samplerDesc.Filter = FilterFunc::MinMagLinearMipPoint; break;        // LINEAR_MIPMAP_NEAREST
+                        case 9986: samplerDesc.Filter = FilterFunc::MinPointMagMipLinear; break;        // NEAREST_MIPMAP_LINEAR
+                        default: CauldronError(L"Unsupported sampler filter combination detected"); break;
+                        }
+                    }
+                }
+
+                // Set proper wrap mode
+                int32_t wrapU(10497), wrapV(10497);
+                if (sampler.find("wrapS") != sampler.end())
+                    wrapU = sampler["wrapS"];
+                if (sampler.find("wrapT") != sampler.end())
+                    wrapV = sampler["wrapT"];
+                switch (wrapU)
+                {
+                case 33071: samplerDesc.AddressU = AddressMode::Clamp; break;   // CLAMP_TO_EDGE
+                case 33648: samplerDesc.AddressU = AddressMode::Mirror; break;  // MIRRORED_REPEAT
+                case 10497: samplerDesc.AddressU = AddressMode::Wrap; break;    // REPEAT
+                default: CauldronError(L"Unsupported glTF sampler wrap mode detected"); break;
+                }
+
+                switch (wrapV)
+                {
+                case 33071: samplerDesc.AddressV = AddressMode::Clamp; break;   // CLAMP_TO_EDGE
+                case 33648: samplerDesc.AddressV = AddressMode::Mirror; break;  // MIRRORED_REPEAT
+                case 10497: samplerDesc.AddressV = AddressMode::Wrap; break;    // REPEAT
+                default: CauldronError(L"Unsupported glTF sampler wrap mode detected"); break;
+                }
+
+                textureSamplers.push_back(samplerDesc);
+            }
+        }
+
+        // Read in material information and build up partially completed material info (textures will be fixed up later)
+        // material information required ahead of texture and buffer being done loading to properly setup textures and meshes
+        if (hasMaterials)
+        {
+            // Init the material data in the content block
+            const json& materials = glTFData["materials"];
+            pGLTFData->pLoadedContentRep->Materials.resize(materials.size());
+
+            // Load texture redirects
+            json empty;
+            const json& textures = hasTextureRedirects ? glTFData["textures"] : empty;
+
+            // Go through all the materials and pre-init them with everything except the valid texture pointers (which we will fixup after
+            // textures are loaded). This will also create an SRGB format map for texture loading so we don't have to re-scan the materials.
+            for (size_t i = 0; i < materials.size(); ++i)
+            {
+                const json& materialEntry = materials[i];
+                pGLTFData->pLoadedContentRep->Materials[i] = new Material();
+                pGLTFData->pLoadedContentRep->Materials[i]->InitFromGLTFData(materialEntry, textures, textureSRGBMap, textureSamplers);
+            }
+        }
+        else
+        {
+            // Default material
+            pGLTFData->pLoadedContentRep->Materials.resize(1);
+            pGLTFData->pLoadedContentRep->Materials[0] = new Material();
+            pGLTFData->pLoadedContentRep->Materials[0]->SetDoubleSided(true);
+        }
+
+        // Load all textures, and when done, continue initialization of resources
+        // Note that we are loading "images" and not "textures" in case multiple textures point to the same image source (which is against spec, but I don't trust it)
+        if (hasImages)
+        {
+            const json& images = glTFData["images"];
+            std::vector<TextureLoadInfo> texLoadInfo;
+            for (size_t i = 0; i < images.size(); ++i)
+            {
+                const json& image = images[i];
+                if (image.find("uri") != image.end())
+                {
+                    const std::string& uriName = image["uri"];
+                    filesystem::path filePath = pGLTFData->GLTFFilePath + StringToWString(uriName);
+
+                    // Push the load info
+                    texLoadInfo.emplace_back(filePath, textureSRGBMap[i]);
+                    continue;
+                }
+
+                // Images embedded in the GLB binary chunk are loaded straight from the mapping.
+                // The name needs to be unique and carry the right extension for the texture loader.
+                std::string mimeType = image.value("mimeType", "");
+                std::wstring imageName = pGLTFData->GLTFFileName + L"#Image_" + std::to_wstring(i);
+                imageName += (mimeType == "image/vnd-ms.dds") ? L".dds" : ((mimeType == "image/jpeg") ? L".jpg" : L".png");
+                texLoadInfo.emplace_back(filesystem::path(imageName), textureSRGBMap[i]);
+
+                BufferViewInfo bufferViewInfo = GetBufferInfo(image, glTFData["bufferViews"]);
+                const json& imageBuffer = glTFData["buffers"][bufferViewInfo.BufferID];
+                bool embedded = imageBuffer.find("uri") == imageBuffer.end() && pGLTFData->GLBBinaryChunk.pData != nullptr &&
+                                bufferViewInfo.Offset + bufferViewInfo.Length <= pGLTFData->GLBBinaryChunk.Size;
+                CauldronAssert(ASSERT_ERROR, embedded, L"Image %d of %ls must be stored in the GLB binary chunk to be loaded", static_cast<int>(i), pGLTFData->GLTFFileName.c_str());
+                if (embedded)
+                {
+                    texLoadInfo.back().pTextureData    = pGLTFData->GLBBinaryChunk.pData + bufferViewInfo.Offset;
+                    texLoadInfo.back().TextureDataSize = bufferViewInfo.Length;
+                }
+            }
+
+            // Load all the textures in the background
+            GetContentManager()->LoadTextures(texLoadInfo, &GLTFLoader::LoadGLTFTexturesCompleted, pGLTFData);
+        }
+        else
+        {
+            // No textures to wait on
+            GetTaskManager()->SignalTaskCompletion(pGLTFData->pSceneReadyCallback);
+        }
+    }
+
+    // Kicks off the reads of all external buffers. The returned completion callback runs LoadGLTFBuffersCompleted, and holds
+    // an extra count to release once the whole scene description has been parsed (as buffer processing needs all of it).
+    TaskCompletionCallback* GLTFLoader::DispatchBufferLoads(GLTFDataRep* pGLTFData)
+    {
+        // Reserve the right number of entries
+        const json& buffers = (*pGLTFData->pGLTFJsonData)["buffers"];
+        pGLTFData->GLTFBufferData.resize(buffers.size());
+        pGLTFData->GLTFBuffers.resize(buffers.size());
+
+        // Buffers without a uri reference the GLB binary chunk, which is used in place
+        std::vector<uint32_t> externalBuffers;
+        for (size_t i = 0; i < buffers.size(); ++i)
+        {
+            // Fallback buffers of compressed buffer views have no data to read, they are filled in when decoding
+            if (IsMeshoptFallbackBuffer(buffers[i]))
+            {
+                pGLTFData->GLTFBufferData[i].resize(buffers[i]["byteLength"].get<size_t>());
+                pGLTFData->GLTFBuffers[i] = { pGLTFData->GLTFBufferData[i].data(), pGLTFData->GLTFBufferData[i].size() };
+                continue;
+            }
+
+            if (buffers[i].find("uri") != buffers[i].end())
+            {
+                externalBuffers.push_back(static_cast<uint32_t>(i));
+                continue;
+            }
+
+            CauldronAssert(ASSERT_CRITICAL, i == 0 && pGLTFData->GLBBinaryChunk.pData != nullptr, L"Buffer %d has no uri and there is no GLB binary chunk to reference", static_cast<int>(i));
+            CauldronAssert(ASSERT_CRITICAL, buffers[i]["byteLength"].get<size_t>() <= pGLTFData->GLBBinaryChunk.Size, L"GLB binary chunk is smaller than its buffer");
+            pGLTFData->GLTFBuffers[i] = pGLTFData->GLBBinaryChunk;
+        }
+
+        TaskCompletionCallback* pCompletionCallback = new TaskCompletionCallback(Task(&GLTFLoader::LoadGLTFBuffersCompleted, pGLTFData), static_cast<uint32_t>(externalBuffers.size()) + 1);
+
+        // Load the rest asynchronously
+        std::vector<FileReadRequest*> readList;
+        for (uint32_t i : externalBuffers)
+        {
+            GLTFBufferLoadParams* pBufferLoadParams = new GLTFBufferLoadParams();
+            pBufferLoadParams->pGLTFData = pGLTFData;
+            pBufferLoadParams->BufferIndex = (uint32_t)i;
+            const std::string& uriName = buffers[i]["uri"];
+            pBufferLoadParams->BufferName = pGLTFData->GLTFFilePath + StringToWString(uriName);
+
+            // Verify the file exists, otherwise we don't want to load
+            // We can get around textures not being there, but not whole buffer info
+            filesystem::path uriFile(pBufferLoadParams->BufferName);
+            CauldronAssert(ASSERT_ERROR, filesystem::exists(uriFile), L"Buffer file %ls does not exist", pBufferLoadParams->BufferName.c_str());
+
+            // Push the read, the buffer will be finalized on a task once the data has been read
+            pBufferLoadParams->pFileRead = new FileReadRequest(pBufferLoadParams->BufferName, Task(&GLTFLoader::LoadGLTFBuffer, pBufferLoadParams, pCompletionCallback));
+            readList.push_back(pBufferLoadParams->pFileRead);
+        }
+
+        // If all buffers were found, trigger the loading
+        if (!readList.empty())
+            GetIOManager()->ReadFilesAsync(readList);
+
+        return pCompletionCallback;
+    }
+
     void GLTFLoader::LoadGLTFTexturesCompleted(const std::vector<const Texture*>& textureList, void* pCallbackParams)
     {
         GLTFDataRep* pGLTFData = reinterpret_cast<GLTFDataRep*>(pCallbackParams);
@@ -661,34 +1134,175 @@ namespace cauldron
             ++iter;
         }
 
-        // Mark load of buffer data complete and notify in case someone was waiting
-        {
-            std::unique_lock<std::mutex>    lock(pGLTFData->CriticalSection);
-            pGLTFData->TexturesLoaded = true;
-            pGLTFData->TextureCV.notify_one();
-        }
+        // Textures are done
+        GetTaskManager()->SignalTaskCompletion(pGLTFData->pSceneReadyCallback);
     }
 
     void GLTFLoader::LoadGLTFBuffer(void* pParam)
     {
         GLTFBufferLoadParams* pLoadData = reinterpret_cast<GLTFBufferLoadParams*>(pParam);
+        FileReadRequest* pFileRead = pLoadData->pFileRead;
 
-        int64_t dataSize = GetFileSize(pLoadData->BufferName.c_str());
+        CauldronAssert(ASSERT_ERROR, pFileRead->BytesRead >= 0, L"Error reading buffer file %ls", pLoadData->BufferName.c_str());
 
-        // Allocate the data and read it in
-        pLoadData->pGLTFData->GLTFBufferData[pLoadData->BufferIndex].resize(dataSize+1);
-        CauldronAssert(ASSERT_ERROR,
-                       dataSize == ReadFileAll(pLoadData->BufferName.c_str(), pLoadData->pGLTFData->GLTFBufferData[pLoadData->BufferIndex].data(), dataSize),
-                       L"Error reading buffer file %ls",
-                       pLoadData->BufferName.c_str());
+        // Take ownership of the data read in by the I/O manager
+        std::vector<char>& bufferData = pLoadData->pGLTFData->GLTFBufferData[pLoadData->BufferIndex];
+        bufferData = std::move(pFileRead->Data);
+        pLoadData->pGLTFData->GLTFBuffers[pLoadData->BufferIndex] = { bufferData.data(), bufferData.size() };
 
         // Done with this memory
+        delete pFileRead;
         delete pLoadData;
     }
 
+    // Kicks off a decode task for every EXT_meshopt_compression buffer view. The completion callback re-runs LoadGLTFBuffersCompleted
+    // once everything is decoded. Returns false if there was nothing to decode.
+    bool GLTFLoader::DispatchCompressedViewDecodes(GLTFDataRep* pGLTFData)
+    {
+        json& glTFData = *pGLTFData->pGLTFJsonData;
+        auto bufferViewsIt = glTFData.find("bufferViews");
+        if (bufferViewsIt == glTFData.end())
+            return false;
+
+        std::vector<uint32_t> compressedViews;
+        for (size_t i = 0; i < bufferViewsIt->size(); ++i)
+        {
+            const json& bufferView = (*bufferViewsIt)[i];
+            auto extensionsIt = bufferView.find("extensions");
+            if (extensionsIt != bufferView.end() && extensionsIt->find(g_MeshoptCompressionExtensionName) != extensionsIt->end())
+                compressedViews.push_back(static_cast<uint32_t>(i));
+        }
+
+        if (compressedViews.empty())
+            return false;
+
+        // Compressed views are expected to target fallback buffers, which hold no data of their own. Views targeting
+        // a buffer with data get a separately allocated buffer to decode into instead, leaving the source buffer intact.
+        json& buffers = glTFData["buffers"];
+        for (uint32_t viewIndex : compressedViews)
+        {
+            json& bufferView = (*bufferViewsIt)[viewIndex];
+            if (IsMeshoptFallbackBuffer(buffers[bufferView["buffer"].get<int>()]))
+                continue;
+
+            const json&  compression = bufferView["extensions"][g_MeshoptCompressionExtensionName];
+            const size_t decodedSize = compression["count"].get<size_t>() * compression["byteStride"].get<size_t>();
+            Log::Write(LOGLEVEL_TRACE, L"Compressed buffer view %d doesn't target a fallback buffer, decoding it into a separate buffer.", static_cast<int>(viewIndex));
+
+            json decodedBuffer;
+            decodedBuffer["byteLength"] = decodedSize;
+            buffers.push_back(std::move(decodedBuffer));
+            pGLTFData->GLTFBufferData.emplace_back(decodedSize);
+            pGLTFData->GLTFBuffers.push_back({ pGLTFData->GLTFBufferData.back().data(), pGLTFData->GLTFBufferData.back().size() });
+
+            bufferView["buffer"]     = buffers.size() - 1;
+            bufferView["byteOffset"] = 0;
+            bufferView["byteLength"] = decodedSize;
+        }
+
+        pGLTFData->DecodeStartTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch());
+
+        TaskCompletionCallback* pCompletionCallback = new TaskCompletionCallback(Task(&GLTFLoader::LoadGLTFBuffersCompleted, pGLTFData), static_cast<uint32_t>(compressedViews.size()));
+        std::queue<Task> decodeTaskList;
+        for (uint32_t viewIndex : compressedViews)
+        {
+            GLTFBufferLoadParams* pDecodeParams = new GLTFBufferLoadParams();
+            pDecodeParams->pGLTFData = pGLTFData;
+            pDecodeParams->BufferIndex = viewIndex;
+            decodeTaskList.push(Task(&GLTFLoader::DecodeCompressedView, pDecodeParams, pCompletionCallback));
+        }
+        GetTaskManager()->AddTaskList(decodeTaskList);
+
+        return true;
+    }
+
+    void GLTFLoader::DecodeCompressedView(void* pParam)
+    {
+        GLTFBufferLoadParams* pDecodeParams = reinterpret_cast<GLTFBufferLoadParams*>(pParam);
+        GLTFDataRep* pGLTFData = pDecodeParams->pGLTFData;
+
+        const json& bufferView  = (*pGLTFData->pGLTFJsonData)["bufferViews"][pDecodeParams->BufferIndex];
+        const json& compression = bufferView["extensions"][g_MeshoptCompressionExtensionName];
+
+        // Source is the compressed stream, destination is the (fallback) buffer the view itself points to
+        const GLTFBufferSpan& srcBuffer = pGLTFData->GLTFBuffers[compression["buffer"].get<int>()];
+        const size_t srcOffset = compression.value("byteOffset", static_cast<size_t>(0));
+        const size_t srcSize   = compression["byteLength"].get<size_t>();
+        CauldronAssert(ASSERT_CRITICAL, srcOffset + srcSize <= srcBuffer.Size, L"Compressed buffer view %d out of buffer bounds", static_cast<int>(pDecodeParams->BufferIndex));
+
+        std::vector<char>& dstBuffer = pGLTFData->GLTFBufferData[bufferView["buffer"].get<int>()];
+        const size_t dstOffset = bufferView.value("byteOffset", static_cast<size_t>(0));
+        const size_t count     = compression["count"].get<size_t>();
+        const size_t stride    = compression["byteStride"].get<size_t>();
+        CauldronAssert(ASSERT_CRITICAL, dstOffset + count * stride <= dstBuffer.size(), L"Compressed buffer view %d doesn't fit the buffer it decodes into", static_cast<int>(pDecodeParams->BufferIndex));
+
+        void*          pDst = dstBuffer.data() + dstOffset;
+        const uint8_t* pSrc = reinterpret_cast<const uint8_t*>(srcBuffer.pData + srcOffset);
+
+        bool decoded = false;
+        const std::string mode = compression["mode"].get<std::string>();
+        if (mode == "ATTRIBUTES")
+            decoded = DecodeMeshoptVertexBuffer(pDst, count, stride, pSrc, srcSize);
+        else if (mode == "TRIANGLES")
+            decoded = DecodeMeshoptIndexBuffer(pDst, count, stride, pSrc, srcSize);
+        else if (mode == "INDICES")
+            decoded = DecodeMeshoptIndexSequence(pDst, count, stride, pSrc, srcSize);
+        CauldronAssert(ASSERT_CRITICAL, decoded, L"Could not decode compressed buffer view %d (mode %ls)", static_cast<int>(pDecodeParams->BufferIndex), StringToWString(mode).c_str());
+
+        const std::string filter = compression.value("filter", std::string("NONE"));
+        if (filter == "OCTAHEDRAL")
+            DecodeMeshoptOctahedralFilter(pDst, count, stride);
+        else if (filter == "QUATERNION")
+            DecodeMeshoptQuaternionFilter(pDst, count, stride);
+        else if (filter == "EXPONENTIAL")
+            DecodeMeshoptExponentialFilter(pDst, count, stride);
+        else
+            CauldronAssert(ASSERT_CRITICAL, filter == "NONE", L"Unsupported meshopt filter %ls", StringToWString(filter).c_str());
+
+        pGLTFData->DecodedBytes += count * stride;
+
+        delete pDecodeParams;
+    }
+
     void GLTFLoader::LoadGLTFBuffersCompleted(void* pParam)
     {
         GLTFDataRep* pGLTFData = reinterpret_cast<GLTFDataRep*>(pParam);
+
+        // Compressed buffer views need to be decoded before anything reads from them, come back once that's done
+        if (!pGLTFData->CompressedViewsDecoded)
+        {
+            pGLTFData->CompressedViewsDecoded = true;
+            if (DispatchCompressedViewDecodes(pGLTFData))
+                return;
+        }
+        else if (pGLTFData->DecodedBytes > 0)
+        {
+            std::chrono::nanoseconds endDecode = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch());
+            double decodeSeconds = std::chrono::duration<double>(endDecode - pGLTFData->DecodeStartTime).count();
+            double decodedMB = static_cast<double>(pGLTFData->DecodedBytes) / (1024.0 * 1024.0);
+            Log::Write(LOGLEVEL_TRACE, L"Decoded %.2f MB of compressed buffer data in %.2f ms (%.2f GB/s).", decodedMB, decodeSeconds * 1000.0,
+                       decodeSeconds > 0.0 ? decodedMB / 1024.0 / decodeSeconds : 0.0);
+
+            // All views now point at plain (decoded) data
+            for (json& bufferView : (*pGLTFData->pGLTFJsonData)["bufferViews"])
+            {
+                auto extensionsIt = bufferView.find("extensions");
+                if (extensionsIt != bufferView.end())
+                    extensionsIt->erase(g_MeshoptCompressionExtensionName);
+            }
+        }
+
+        // Do the cooking before any buffer assets are created so that they load from the processed data
+        if (pGLTFData->CookSceneCache)
+            ConvertVertexAttributesToFloat(pGLTFData);
+
+        // Scene data is now ready whether it came from source or from the cache, track how long it took to compare both
+        std::chrono::nanoseconds sceneDataReady = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch());
+        pGLTFData->SceneDataLoadTime = sceneDataReady - pGLTFData->loadStartTime;
+
+        if (pGLTFData->CookSceneCache)
+            GLTFSceneCache::Write(*pGLTFData);
+
         const json& glTFData = *pGLTFData->pGLTFJsonData;
 
         bool hasMeshData = glTFData.find("meshes") != glTFData.end();
@@ -710,6 +1324,13 @@ namespace cauldron
             numLoads += (uint32_t)glTFData["skins"].size();
         }
 
+        // Nothing to create, buffer assets are done
+        if (numLoads == 0)
+        {
+            GLTFAllBufferAssetLoadsCompleted(pParam);
+            return;
+        }
+
         // Create a completion callback to be called after all buffer loads have completed
         TaskCompletionCallback* pLoadCompleteCallback = new TaskCompletionCallback(Task(&GLTFLoader::GLTFAllBufferAssetLoadsCompleted, pParam), numLoads);
 
@@ -821,7 +1442,7 @@ namespace cauldron
 
     }
 
-    const json* GLTFLoader::LoadVertexBuffer(const json& attributes, const char* attributeName, const json& accessors, const json& bufferViews, const json& buffers, const GLTFBufferLoadParams& params, VertexBufferInformation& info, bool forceConversionToFloat)
+    const json* GLTFLoader::LoadVertexBuffer(const json& attributes, const char* attributeName, const json& accessors, const json& bufferViews, const json& buffers, const GLTFBufferLoadParams& params, VertexBufferInformation& info, bool forceConversionToFloat, bool allowNormalizedFormat)
     {
         auto attributeIter = attributes.find(attributeName);
         if (attributeIter != attributes.end())
@@ -836,91 +1457,69 @@ namespace cauldron
             uint32_t resourceDataStride = ResourceDataStride(resourceFormatType);
             uint32_t stride = resourceFormatDimension * resourceDataStride;
 
-            uint32_t byteOffset = 0;
-            auto byteOffsetIt = accessor.find("byteOffset");
-            if (byteOffsetIt != accessor.end())
-                byteOffset = byteOffsetIt->get<uint32_t>();
-
             // Update vertex buffer information
             info.Count = accessor["count"].get<uint32_t>();
             info.AttributeDataFormat = ResourceFormatType(type);
             info.ResourceDataFormat = ResourceDataFormat(info.AttributeDataFormat, resourceFormatType);
 
-            // Original buffer validation
-            BufferViewInfo bufferViewInfo = GetBufferInfo(accessor, bufferViews);
+            // Get a pointer to the data (validates buffer bounds, and resolves sparse accessors into a packed copy)
+            std::vector<char> resolvedData;
+            size_t srcStride = 0;
+            const char* data = ResolveAccessorData(accessor, bufferViews, *params.pGLTFData, stride, srcStride, resolvedData);
 
             const bool jointsAttributeName = (strcmp(attributeName, "JOINTS_0") == 0) || (strcmp(attributeName, "JOINTS_1") == 0);
             if (jointsAttributeName)
             {
-                stride = static_cast<uint32_t>(bufferViewInfo.Stride);
+                stride = static_cast<uint32_t>(srcStride);
             }
 
-            // Only support tightly packed data
-            CauldronAssert(ASSERT_WARNING, bufferViewInfo.Stride == 0 || bufferViewInfo.Stride == stride, L"Stride doesn't match between the type of the accessor and the type of the vertex attribute.");
-
-            // Verify that the buffer is big enough
-            uint32_t totalLength = info.Count * stride;
-            CauldronAssert(ASSERT_CRITICAL, byteOffset + totalLength <= bufferViewInfo.Length, L"Vertex buffer out of buffer view bounds.");
-
-            uint32_t bufferLength = buffers[bufferViewInfo.BufferID]["byteLength"].get<uint32_t>();
-            CauldronAssert(ASSERT_CRITICAL, bufferViewInfo.Offset + byteOffset + totalLength <= bufferLength, L"Vertex buffer out of buffer bounds.");
-
-            // Get a pointer to the data at the correct offset into the buffer
-            char* data = params.pGLTFData->GLTFBufferData[bufferViewInfo.BufferID].data();
-            data += bufferViewInfo.Offset + byteOffset;
-
             // Verify that the component is already using floats or allowed to be converted to floats
             if (jointsAttributeName == false)
             {
                 CauldronAssert(ASSERT_ERROR, (resourceFormatType == g_GLTFComponentType_Float) || forceConversionToFloat, L"Unsupported component type for vertex attribute.");
             }
 
+            // Normalized integer data can be kept as is when we have a matching format, the input assembler will do the conversion
+            ResourceFormat nativeFormat = allowNormalizedFormat ? NativeNormalizedFormat(accessor, *params.pGLTFData) : ResourceFormat::Unknown;
+
             // Convert to float if necessary
-            std::vector<float> convertedData;
-            if (resourceFormatType != g_GLTFComponentType_Float && forceConversionToFloat)
+            std::vector<char> convertedData;
+            if (resourceFormatType != g_GLTFComponentType_Float && forceConversionToFloat && nativeFormat == ResourceFormat::Unknown)
             {
-                // Update resource format, stride and length
+                // Update resource format and stride
                 info.ResourceDataFormat = ResourceDataFormat(info.AttributeDataFormat, g_GLTFComponentType_Float);
                 resourceDataStride = ResourceDataStride(g_GLTFComponentType_Float);
                 stride = resourceFormatDimension * resourceDataStride;
-                totalLength = info.Count * stride;
 
-                // Allocate a new buffer of floats for the converted component
-                const int elementCount = info.Count * resourceDataStride;
-                convertedData.resize(elementCount);
+                // Allocate a new buffer of floats for the converted component and do the conversion
+                convertedData.resize(info.Count * stride);
+                bool converted = ConvertComponentsToFloat(data, resourceFormatType, IsAccessorNormalized(accessor, *params.pGLTFData), info.Count, resourceFormatDimension, srcStride, reinterpret_cast<float*>(convertedData.data()));
+                CauldronAssert(ASSERT_ERROR, converted, L"Unsupported component type conversion for vertex attribute.");
 
-                // Do conversion. Data that requires conversion from byte/short to floats is normalized.
-                if (resourceFormatType == g_GLTFComponentType_UnsignedByte)
-                {
-                    const uint8_t* dataPtr = (uint8_t*)data;
-                    for (int i = 0; i < elementCount; i++)
-                    {
-                        convertedData[i] = float(dataPtr[i]) / 256.0f;
-                    }
-                }
-                else if (resourceFormatType == g_GLTFComponentType_UnsignedShort)
-                {
-                    const uint16_t* dataPtr = (uint16_t*)data;
-                    for (int i = 0; i < elementCount; i++)
-                    {
-                        convertedData[i] = float(dataPtr[i]) / 65536.0f;
-                    }
-                }
-                else
+                // Make the data pointer point towards our converted data
+                data = convertedData.data();
+            }
+            else
+            {
+                if (resourceFormatType != g_GLTFComponentType_Float && forceConversionToFloat)
+                    info.ResourceDataFormat = nativeFormat;
+
+                // Pack interleaved data as we only upload tightly packed streams
+                if (srcStride != stride)
                 {
-                    CauldronAssert(ASSERT_ERROR, false, L"Unsupported component type conversion for vertex attribute.");
+                    convertedData.resize(info.Count * stride);
+                    for (uint32_t i = 0; i < info.Count; ++i)
+                        memcpy(convertedData.data() + i * stride, data + i * srcStride, stride);
+                    data = convertedData.data();
                 }
-
-                // Make the data pointer point towards our converted data
-                data = (char*)convertedData.data();
             }
 
             // align buffer size up to 4-bytes for compatibility with StructuredBuffers with uints.
+            uint32_t totalLength = info.Count * stride;
             uint32_t totalAlignedLength = AlignUp(totalLength, 4u);
 
             BufferDesc desc = BufferDesc::Vertex(StringToWString(std::string("VertexBuffer_") + std::string(attributeName)).c_str(), totalAlignedLength, stride);
-            info.pBuffer = Buffer::CreateBufferResource(&desc, ResourceState::CopyDest);
-            info.pBuffer->CopyData(data, totalLength, params.pUploadCtx, ResourceState::VertexBufferResource);
+            info.pBuffer = CreateSharedBuffer(desc, data, totalLength, ResourceState::VertexBufferResource, params);
             return &accessor;
         }
         return nullptr;
@@ -946,7 +1545,7 @@ namespace cauldron
 
             // create buffer
             BufferViewInfo bufferViewInfo = GetBufferInfo(accessor, bufferViews);
-            const char* data = params.pGLTFData->GLTFBufferData[bufferViewInfo.BufferID].data();
+            const char* data = params.pGLTFData->GLTFBuffers[bufferViewInfo.BufferID].pData;
             data += bufferViewInfo.Offset + byteOffset;
 
             int componentType = accessor["componentType"];
@@ -990,39 +1589,63 @@ namespace cauldron
             uint32_t totalAlignedLength = AlignUp(totalLength, 4u);
 
             BufferDesc desc = BufferDesc::Index(L"IndexBuffer", totalAlignedLength, info.IndexFormat);
-            info.pBuffer = Buffer::CreateBufferResource(&desc, ResourceState::CopyDest);
-            info.pBuffer->CopyData(data, totalLength, params.pUploadCtx, ResourceState::IndexBufferResource);
+            info.pBuffer = CreateSharedBuffer(desc, data, totalLength, ResourceState::IndexBufferResource, params);
         }
     }
 
-    void GLTFLoader::LoadAnimInterpolant(AnimInterpolants& animInterpolant, const json& gltfData, int32_t interpAccessorID, const GLTFBufferLoadParams* pBufferLoadParams)
+    // Identical data with the same layout is shared across meshes and content blocks instead of being uploaded again
+    Buffer* GLTFLoader::CreateSharedBuffer(const BufferDesc& desc, const char* pData, uint32_t dataSize, ResourceState finalState, const GLTFBufferLoadParams& params)
     {
-        auto&       accessors    = gltfData["accessors"];
-        auto&       bufferViews  = gltfData["bufferViews"];
+        const uint32_t layout[] = { static_cast<uint32_t>(desc.Type), static_cast<uint32_t>(desc.Flags), desc.Size, desc.Stride };
+        const uint64_t contentHash = HashData64(pData, dataSize, HashData64(layout, sizeof(layout)));
 
-        const json& inAccessor = accessors.at(interpAccessorID);
+        Buffer* pBuffer = GetContentManager()->AcquireBuffer(contentHash);
+        if (pBuffer)
+            return pBuffer;
 
-        int32_t bufferViewIdx = inAccessor.value("bufferView", -1);
-        CauldronAssert(ASSERT_CRITICAL, bufferViewIdx >= 0, L"Animation buffer view ID invalid");
-        const json& bufferView = bufferViews.at(bufferViewIdx);
-
-        int32_t bufferIdx = bufferView.value("buffer", -1);
-        CauldronAssert(ASSERT_CRITICAL, bufferIdx >= 0, L"Animation buffer ID invalid");
+        pBuffer = Buffer::CreateBufferResource(&desc, ResourceState::CopyDest);
+        pBuffer->CopyData(pData, dataSize, params.pUploadCtx, finalState);
 
-        std::vector<char>& animData = pBufferLoadParams->pGLTFData->GLTFBufferData[bufferIdx];
+        // Can only be shared once the upload has executed
+        if (params.pNewSharedBuffers)
+            params.pNewSharedBuffers->push_back({ contentHash, pBuffer, dataSize });
+        return pBuffer;
+    }
 
-        int32_t offset     = bufferView.value("byteOffset", 0);
-        int32_t byteLength = bufferView["byteLength"];
-        int32_t byteOffset = inAccessor.value("byteOffset", 0);
+    void GLTFLoader::LoadAnimInterpolant(AnimInterpolants& animInterpolant, const json& gltfData, int32_t interpAccessorID, const GLTFBufferLoadParams* pBufferLoadParams)
+    {
+        auto&       accessors    = gltfData["accessors"];
+        auto&       bufferViews  = gltfData["bufferViews"];
 
-        offset += byteOffset;
-        byteLength -= byteOffset;
+        const json& inAccessor = accessors.at(interpAccessorID);
 
-        animInterpolant.Data      = std::vector<char>(animData.begin() + offset, animData.end());
+        const int32_t componentType = inAccessor["componentType"];
         animInterpolant.Dimension = ResourceFormatDimension(inAccessor["type"]);
-        animInterpolant.Stride    = animInterpolant.Dimension * ResourceDataStride(inAccessor["componentType"]);
         animInterpolant.Count     = inAccessor["count"];
 
+        size_t            elementSize = animInterpolant.Dimension * ResourceDataStride(componentType);
+        size_t            elementStride = elementSize;
+        std::vector<char> resolvedData;
+        const char*       pData = ResolveAccessorData(inAccessor, bufferViews, *pBufferLoadParams->pGLTFData, elementSize, elementStride, resolvedData);
+
+        // Animation data is always sampled as floats, quantized keyframes (KHR_mesh_quantization) get expanded here
+        if (componentType != g_GLTFComponentType_Float)
+        {
+            animInterpolant.Data.resize(static_cast<size_t>(animInterpolant.Count) * animInterpolant.Dimension * sizeof(float));
+            bool converted = ConvertComponentsToFloat(pData, componentType, IsAccessorNormalized(inAccessor, *pBufferLoadParams->pGLTFData), animInterpolant.Count,
+                                                      animInterpolant.Dimension, elementStride, reinterpret_cast<float*>(animInterpolant.Data.data()));
+            CauldronAssert(ASSERT_CRITICAL, converted, L"Unsupported animation accessor component type");
+            elementSize = animInterpolant.Dimension * sizeof(float);
+        }
+        else
+        {
+            // Only copy the accessor's data, not the rest of the buffer
+            animInterpolant.Data.resize(static_cast<size_t>(animInterpolant.Count) * elementSize);
+            for (int32_t i = 0; i < animInterpolant.Count; ++i)
+                memcpy(animInterpolant.Data.data() + i * elementSize, pData + i * elementStride, elementSize);
+        }
+        animInterpolant.Stride = static_cast<int32_t>(elementSize);
+
         // Read in min/max according to how big they are (rest is zero initialized)
         if (inAccessor.find("min") != inAccessor.end())
         {
@@ -1063,7 +1686,7 @@ namespace cauldron
         }
     }
 
-    void GLTFLoader::LoadAnimInterpolants(AnimChannel* pAnimChannel, AnimChannel::ComponentSampler samplerType, int32_t samplerIndex, const GLTFBufferLoadParams* pBufferLoadParams)
+    AnimCompressionStats GLTFLoader::LoadAnimInterpolants(AnimChannel* pAnimChannel, AnimChannel::ComponentSampler samplerType, int32_t samplerIndex, const GLTFBufferLoadParams* pBufferLoadParams)
     {
         const json& gltfData = *pBufferLoadParams->pGLTFData->pGLTFJsonData;
         auto& animations = gltfData["animations"];
@@ -1104,6 +1727,9 @@ namespace cauldron
                 CauldronCritical(L"Unsupported Animation component sampler type");
             break;
         }
+
+        return pAnimChannel->FinalizeComponentSampler(samplerType, GetConfig()->CompressAnimations,
+                                                      GetConfig()->AnimationCompressionLinearTolerance, GetConfig()->AnimationCompressionAngularTolerance);
     }
 
     // Called for each mesh in order to create and load mesh information
@@ -1126,6 +1752,9 @@ namespace cauldron
         UploadContext* pUploadContext = UploadContext::CreateUploadContext();
         pBufferLoadParams->pUploadCtx = pUploadContext;
 
+        std::vector<GLTFSharedBuffer> newSharedBuffers;
+        pBufferLoadParams->pNewSharedBuffers = &newSharedBuffers;
+
         // Start loading all of the surfaces for it (a surface in our context is mesh geometry that is associated with a particular material)
         std::vector<VertexBufferInformation> vertexBufferPositions;
         for (uint32_t i = 0; i < (uint32_t)primitives.size(); ++i)
@@ -1135,11 +1764,15 @@ namespace cauldron
             Surface* pSurface = pMeshResource->GetSurface(i);
 
             // Start by setting up the center and radius (if we got them)
-            const json* pPosAccessor = LoadVertexBuffer(attributes, "POSITION", accessors, bufferViews, buffers , *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Position), false);
+            const json* pPosAccessor = LoadVertexBuffer(attributes, "POSITION", accessors, bufferViews, buffers , *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Position), true, false);
             if (pPosAccessor != nullptr && pPosAccessor->contains("max") && pPosAccessor->contains("min"))
             {
                 auto& maxAccessor = (*pPosAccessor)["max"];
                 auto& minAccessor = (*pPosAccessor)["min"];
+
+                // Quantized positions have their bounds expressed in the stored integer range
+                const float boundsScale = AccessorValueScale((*pPosAccessor)["componentType"], IsAccessorNormalized(*pPosAccessor, *pBufferLoadParams->pGLTFData));
+
                 Vec4  max;
                 max.setX(maxAccessor[0]);
                 max.setY(maxAccessor[1]);
@@ -1155,6 +1788,9 @@ namespace cauldron
                 min.setW(0);
                 if (minAccessor.size() == 4)
                     min.setW(minAccessor[3]);
+
+                max *= boundsScale;
+                min *= boundsScale;
                 
                 pSurface->Center() = (min + max) * 0.5f;
                 pSurface->Radius() = max - pMeshResource->GetSurface(i)->Center();
@@ -1162,16 +1798,16 @@ namespace cauldron
             }
             vertexBufferPositions.push_back(pSurface->GetVertexBuffer(VertexAttributeType::Position));
 
-            LoadVertexBuffer(attributes, "NORMAL",      accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Normal),    false);
-            LoadVertexBuffer(attributes, "TANGENT",     accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Tangent),   false);
-            LoadVertexBuffer(attributes, "TEXCOORD_0",  accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Texcoord0), true);
-            LoadVertexBuffer(attributes, "TEXCOORD_1",  accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Texcoord1), true);
-            LoadVertexBuffer(attributes, "COLOR_0",     accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Color0),    true);
-            LoadVertexBuffer(attributes, "COLOR_1",     accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Color1),    true);
-            LoadVertexBuffer(attributes, "WEIGHTS_0",   accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Weights0),  true);
-            LoadVertexBuffer(attributes, "WEIGHTS_1",   accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Weights1),  true);
-            LoadVertexBuffer(attributes, "JOINTS_0",    accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Joints0),   false);
-            LoadVertexBuffer(attributes, "JOINTS_1",    accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Joints1),   false);
+            LoadVertexBuffer(attributes, "NORMAL",      accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Normal),    true, false);
+            LoadVertexBuffer(attributes, "TANGENT",     accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Tangent),   true, false);
+            LoadVertexBuffer(attributes, "TEXCOORD_0",  accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Texcoord0), true, true);
+            LoadVertexBuffer(attributes, "TEXCOORD_1",  accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Texcoord1), true, true);
+            LoadVertexBuffer(attributes, "COLOR_0",     accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Color0),    true, true);
+            LoadVertexBuffer(attributes, "COLOR_1",     accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Color1),    true, true);
+            LoadVertexBuffer(attributes, "WEIGHTS_0",   accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Weights0),  true, false);
+            LoadVertexBuffer(attributes, "WEIGHTS_1",   accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Weights1),  true, false);
+            LoadVertexBuffer(attributes, "JOINTS_0",    accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Joints0),   false, false);
+            LoadVertexBuffer(attributes, "JOINTS_1",    accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetVertexBuffer(VertexAttributeType::Joints1),   false, false);
             LoadIndexBuffer(primitive, accessors, bufferViews, buffers, *pBufferLoadParams, pSurface->GetIndexBuffer());
 
             bool hasAnimationSkins = glTFData.find("skins") != glTFData.end();
@@ -1190,6 +1826,10 @@ namespace cauldron
 
                 // Set Mesh to have animated BLAS for raytracing
                 pMeshResource->setAnimatedBlas(true);
+
+                // Keep the skinning inputs around for CPU skinning
+                if (GetConfig()->CPUSkinning)
+                    pSurface->SetCPUSkinningSource(BuildCPUSkinningSource(attributes, accessors, bufferViews, *pBufferLoadParams->pGLTFData));
             }
 
             int  materialIndex = 0;
@@ -1203,6 +1843,11 @@ namespace cauldron
         pUploadContext->Execute();
         delete pUploadContext;
 
+        // Uploaded data can now be shared with other meshes (a buffer uploaded concurrently by another mesh just stays unshared)
+        for (const GLTFSharedBuffer& sharedBuffer : newSharedBuffers)
+            GetContentManager()->StartManagingContent(sharedBuffer.ContentHash, sharedBuffer.pBuffer, sharedBuffer.DataSize);
+        pBufferLoadParams->pNewSharedBuffers = nullptr;
+
         // Add BLAS info
         if (GetConfig()->BuildRayTracingAccelerationStructure)
         {
@@ -1233,6 +1878,7 @@ namespace cauldron
         pBufferLoadParams->pGLTFData->pLoadedContentRep->Animations[pBufferLoadParams->BufferIndex] = new Animation();
 
         Animation* animation = pBufferLoadParams->pGLTFData->pLoadedContentRep->Animations[pBufferLoadParams->BufferIndex];
+        AnimCompressionStats compressionStats;
 
         for (int c = 0; c < channelsJson.size(); c++)
         {
@@ -1241,7 +1887,7 @@ namespace cauldron
             int     node  = channel["target"]["node"];
             std::string path = channel["target"]["path"];
 
-            const uint32_t numNodes = (uint32_t)glTFData["nodes"].size();
+            const uint32_t numNodes = (uint32_t)pBufferLoadParams->pGLTFData->Nodes.size();
 
             // This is inefficient on gltfScenes as a whole (that mix geometry and animations),
             // but effective on anim heavy gltf
@@ -1251,11 +1897,19 @@ namespace cauldron
 
             AnimChannel::ComponentSampler samplerType = (path == "translation") ? AnimChannel::ComponentSampler::Translation :
                 ((path == "rotation") ? AnimChannel::ComponentSampler::Rotation : AnimChannel::ComponentSampler::Scale);
-            LoadAnimInterpolants(animChannelNew, samplerType, sampler, pBufferLoadParams);
+            compressionStats.Accumulate(LoadAnimInterpolants(animChannelNew, samplerType, sampler, pBufferLoadParams));
 
             // Get the duration of this channel component
             animation->SetDuration(std::max<float>(animChannelNew->GetComponentSamplerDuration(samplerType), animation->GetDuration()));
         }
+
+        if (GetConfig()->CompressAnimations && compressionStats.CompressedBytes > 0)
+        {
+            Log::Write(LOGLEVEL_TRACE, L"Animation %d compressed %llu KB to %llu KB (%.1f:1), max error %.6f units / %.4f degrees, %u track(s) over tolerance left uncompressed.",
+                       pBufferLoadParams->BufferIndex, static_cast<uint64_t>(compressionStats.RawBytes >> 10), static_cast<uint64_t>(compressionStats.CompressedBytes >> 10),
+                       static_cast<double>(compressionStats.RawBytes) / compressionStats.CompressedBytes, compressionStats.MaxLinearError,
+                       compressionStats.MaxAngularError * 180.f / CAULDRON_PI, compressionStats.UncompressedCount);
+        }
     }
 
     void GLTFLoader::LoadGLTFSkin(void* pParam)
@@ -1298,7 +1952,7 @@ namespace cauldron
         int32_t bufferIdx = bufferView.value("buffer", -1);
         assert(bufferIdx >= 0);
 
-        std::vector<char> &animData = pBufferLoadParams->pGLTFData->GLTFBufferData[bufferIdx];
+        const GLTFBufferSpan& animData = pBufferLoadParams->pGLTFData->GLTFBuffers[bufferIdx];
 
         int32_t offset     = bufferView.value("byteOffset", 0);
         int32_t byteLength = bufferView["byteLength"];
@@ -1306,8 +1960,10 @@ namespace cauldron
 
         offset += byteOffset;
         byteLength -= byteOffset;
+        CauldronAssert(ASSERT_CRITICAL, static_cast<size_t>(offset + byteLength) <= animData.Size, L"Skin accessor out of buffer bounds");
 
-        pAccessor->Data      = std::vector<char>(animData.begin() + offset, animData.end());
+        // Only copy the accessor's data, not the rest of the buffer
+        pAccessor->Data      = std::vector<char>(animData.pData + offset, animData.pData + offset + byteLength);
         pAccessor->Dimension = ResourceFormatDimension(inAccessor["type"]);
         pAccessor->Stride    = pAccessor->Dimension * ResourceDataStride(inAccessor["componentType"]);
         pAccessor->Count     = inAccessor["count"];
@@ -1318,10 +1974,118 @@ namespace cauldron
     {
         GLTFDataRep* pGLTFData = reinterpret_cast<GLTFDataRep*>(pParam);
 
-        // Mark load of buffer data complete and notify in case someone was waiting
-        std::unique_lock<std::mutex>    lock(pGLTFData->CriticalSection);
-        pGLTFData->BuffersLoaded = true;
-        pGLTFData->BufferCV.notify_one();
+        // Buffer assets are done
+        GetTaskManager()->SignalTaskCompletion(pGLTFData->pSceneReadyCallback);
+    }
+
+    // Pre-converts all vertex attributes that are loaded as floats so that cooked scenes don't need any conversion at load
+    void GLTFLoader::ConvertVertexAttributesToFloat(GLTFDataRep* pGLTFData)
+    {
+        json& glTFData = *pGLTFData->pGLTFJsonData;
+        if (glTFData.find("meshes") == glTFData.end())
+            return;
+
+        // These need to match the attributes LoadGLTFMesh forces to float (and which of them may keep a native normalized format)
+        struct FloatAttribute
+        {
+            const char* Name;
+            bool        AllowNormalizedFormat;
+        };
+        static const FloatAttribute s_FloatAttributes[] = { { "POSITION", false }, { "NORMAL", false }, { "TANGENT", false },
+                                                            { "TEXCOORD_0", true }, { "TEXCOORD_1", true }, { "COLOR_0", true }, { "COLOR_1", true },
+                                                            { "WEIGHTS_0", false }, { "WEIGHTS_1", false } };
+
+        json& accessors   = glTFData["accessors"];
+        json& bufferViews = glTFData["bufferViews"];
+        json& buffers     = glTFData["buffers"];
+
+        // All converted data goes into a new buffer appended to the existing ones
+        const int32_t convertedBufferID = static_cast<int32_t>(buffers.size());
+        std::vector<char> convertedBuffer;
+        std::vector<bool> convertedAccessors(accessors.size(), false);
+
+        for (const json& mesh : glTFData["meshes"])
+        {
+            for (const json& primitive : mesh["primitives"])
+            {
+                const json& attributes = primitive["attributes"];
+                for (const FloatAttribute& floatAttribute : s_FloatAttributes)
+                {
+                    auto attributeIt = attributes.find(floatAttribute.Name);
+                    if (attributeIt == attributes.end())
+                        continue;
+
+                    int32_t accessorID = attributeIt->get<int32_t>();
+                    json& accessor = accessors[accessorID];
+                    int32_t componentType = accessor["componentType"];
+                    if (convertedAccessors[accessorID] || componentType == g_GLTFComponentType_Float)
+                        continue;
+
+                    // Leave data the loader will keep in its native format untouched
+                    if (floatAttribute.AllowNormalizedFormat && NativeNormalizedFormat(accessor, *pGLTFData) != ResourceFormat::Unknown)
+                        continue;
+
+                    uint32_t count     = accessor["count"].get<uint32_t>();
+                    uint32_t dimension = ResourceFormatDimension(accessor["type"].get<std::string>());
+
+                    std::vector<char> resolvedData;
+                    size_t srcStride = 0;
+                    const char* pSrcData = ResolveAccessorData(accessor, bufferViews, *pGLTFData, ResourceDataStride(componentType) * dimension, srcStride, resolvedData);
+
+                    size_t dstOffset = convertedBuffer.size();
+                    size_t dstLength = count * dimension * sizeof(float);
+                    convertedBuffer.resize(dstOffset + dstLength);
+                    if (!ConvertComponentsToFloat(pSrcData, componentType, IsAccessorNormalized(accessor, *pGLTFData), count, dimension, srcStride, reinterpret_cast<float*>(convertedBuffer.data() + dstOffset)))
+                    {
+                        // Leave it as is, loading will flag the unsupported conversion
+                        convertedBuffer.resize(dstOffset);
+                        continue;
+                    }
+
+                    // Bounds have to match the converted values (normalized data is rescaled by the conversion)
+                    if (count > 0 && accessor.find("min") != accessor.end() && accessor.find("max") != accessor.end())
+                    {
+                        const float* pConverted = reinterpret_cast<const float*>(convertedBuffer.data() + dstOffset);
+                        std::vector<float> minValues(dimension, std::numeric_limits<float>::max());
+                        std::vector<float> maxValues(dimension, std::numeric_limits<float>::lowest());
+                        for (uint32_t i = 0; i < count; ++i)
+                        {
+                            for (uint32_t c = 0; c < dimension; ++c)
+                            {
+                                minValues[c] = std::min(minValues[c], pConverted[i * dimension + c]);
+                                maxValues[c] = std::max(maxValues[c], pConverted[i * dimension + c]);
+                            }
+                        }
+                        accessor["min"] = minValues;
+                        accessor["max"] = maxValues;
+                    }
+
+                    // Point the accessor to the converted data
+                    json bufferView;
+                    bufferView["buffer"]     = convertedBufferID;
+                    bufferView["byteOffset"] = dstOffset;
+                    bufferView["byteLength"] = dstLength;
+                    bufferViews.push_back(std::move(bufferView));
+
+                    accessor["bufferView"]    = bufferViews.size() - 1;
+                    accessor["componentType"] = g_GLTFComponentType_Float;
+                    accessor.erase("byteOffset");
+                    accessor.erase("normalized");
+                    accessor.erase("sparse");
+                    convertedAccessors[accessorID] = true;
+                }
+            }
+        }
+
+        if (!convertedBuffer.empty())
+        {
+            json buffer;
+            buffer["byteLength"] = convertedBuffer.size();
+            buffers.push_back(std::move(buffer));
+            pGLTFData->GLTFBufferData.resize(buffers.size());
+            pGLTFData->GLTFBufferData.back() = std::move(convertedBuffer);
+            pGLTFData->GLTFBuffers.push_back({ pGLTFData->GLTFBufferData.back().data(), pGLTFData->GLTFBufferData.back().size() });
+        }
     }
 
     void GLTFLoader::BuildBLAS(const std::vector<Mesh*>& meshes)
@@ -1346,6 +2110,7 @@ namespace cauldron
     void GLTFLoader::InitSkinningData(const Mesh* pMesh, AnimationComponentData* pComponentData)
     {
         const size_t numSurfaces = pMesh->GetNumSurfaces();
+        pComponentData->m_pSkinnedMesh = pMesh;
         pComponentData->m_skinnedPositions.resize(numSurfaces);
         pComponentData->m_skinnedNormals.resize(numSurfaces);
         pComponentData->m_skinnedPreviousPosition.resize(numSurfaces);
@@ -1401,18 +2166,25 @@ namespace cauldron
         }
     }
 
-    bool isAnimationTarget(const json& pGLTFData, const uint32_t nodeIndex)
+    // Flags all nodes targeted by an animation channel
+    std::vector<bool> GetAnimationTargets(const json& gltfData, size_t nodeCount)
     {
-        for (const auto& animationEntry : pGLTFData["animations"])
+        std::vector<bool> animationTargets(nodeCount, false);
+        auto animationsIt = gltfData.find("animations");
+        if (animationsIt != gltfData.end())
         {
-            for (const auto& channels : animationEntry["channels"])
+            for (const auto& animationEntry : *animationsIt)
             {
-                if (nodeIndex == channels["target"]["node"])
-                    return true;
+                for (const auto& channels : animationEntry["channels"])
+                {
+                    uint32_t nodeIndex = channels["target"]["node"];
+                    if (nodeIndex < nodeCount)
+                        animationTargets[nodeIndex] = true;
+                }
             }
         }
 
-        return false;
+        return animationTargets;
     }
 
     bool entityInAnimatedSubTree(Entity* pParentEntity)
@@ -1435,22 +2207,8 @@ namespace cauldron
         // ID of the current model being loaded
         static uint32_t modelIndex = 0;
 
-        // create entities and component data
-        // If we had buffers, make sure all content was created/loaded
-        if (glTFData.find("buffers") != glTFData.end())
-        {
-            std::unique_lock<std::mutex> lock(pGLTFData->CriticalSection);
-            pGLTFData->BufferCV.wait(lock, [pGLTFData] { return pGLTFData->BuffersLoaded; });
-        }
-
-        // If we had textures, make sure all content was created/loaded
-        if (glTFData.find("images") != glTFData.end())
-        {
-            std::unique_lock<std::mutex> lock(pGLTFData->CriticalSection);
-            pGLTFData->TextureCV.wait(lock, [pGLTFData] { return pGLTFData->TexturesLoaded; });
-        }
-
-        bool hasNodes = glTFData.find("nodes") != glTFData.end();
+        // create entities and component data (all buffer and texture content is loaded by the time we get here)
+        bool hasNodes = !pGLTFData->Nodes.empty();
         bool hasScene = glTFData.find("scenes") != glTFData.end();
         CauldronAssert(ASSERT_ERROR, hasScene && hasNodes, L"Could not find nodes and / or scene. No scene entities will be created!");
 
@@ -1458,19 +2216,21 @@ namespace cauldron
         if (hasScene && hasNodes)
         {
             // We are going to traverse each scene through it's nodes, creating entities as we go, each root node/child is an entity (can be nested)
-            const json& nodes = glTFData["nodes"];
+            const std::vector<GLTFNode>& nodes = pGLTFData->Nodes;
             const json& scenes = glTFData["scenes"];
 
             // We want to keep track if which nodes we've visited to make sure we don't miss any or don't visit any twice
             std::vector<bool> visitedNodes(nodes.size(), false);
+            const std::vector<bool> animationTargets = GetAnimationTargets(glTFData, nodes.size());
 
             // Define a function that will process our nodes recursively and setup as needed
             std::function<void(uint32_t nodeIndex, Entity* pParentEntity, EntityDataBlock* pBackingMem)> processNodeRecursive = [&](uint32_t nodeIndex, Entity* pParentEntity, EntityDataBlock* pParentEntityBlock)
             {
-                auto& node = nodes[nodeIndex];
+                CauldronAssert(ASSERT_CRITICAL, nodeIndex < nodes.size(), L"Referenced node out of bounds");
+                const GLTFNode& node = nodes[nodeIndex];
 
                 // Get it's name if it has one
-                std::wstring nodeName = (node.find("name") != node.end()) ? StringToWString(node["name"].get<std::string>()) : L"un-named";
+                std::wstring nodeName = !node.Name.empty() ? StringToWString(node.Name) : L"un-named";
 
                 // Mark it as visited as well
                 CauldronAssert(ASSERT_CRITICAL, !visitedNodes[nodeIndex], L"Visiting hierarchy nodes more than once. Something has gone horribly wrong. Abort!");
@@ -1502,24 +2262,8 @@ namespace cauldron
                     pNewEntity->SetParent(pParentEntity);
                 }
 
-                // Process transforms for this entity
-                Mat4 transform;
-                if (node.find("matrix") != node.end())
-                    transform = ReadMatrix(node, "matrix", Mat4::identity());
-
-                else
-                {
-                    const Vec3 scale = ReadVec3(node, "scale", Vec3(1.0f, 1.0f, 1.0f));
-                    const Vec3 translation = ReadVec3(node, "translation", Vec3(0.0f, 0.0f, 0.0f));
-                    const Quat rotation = ReadQuat(node, "rotation", Quat::identity());
-
-                    // build the transformation matrix
-                    const Mat4 scaleMatrix = Mat4::scale(scale);
-                    const Mat4 translationMatrix = Mat4::translation(translation);
-                    const Mat4 rotationMatrix = Mat4::rotation(rotation);
-
-                    transform = translationMatrix * rotationMatrix * scaleMatrix;
-                }
+                // Process transforms for this entity (local transforms are composed when parsing nodes)
+                const Mat4& transform = node.Transform;
 
                 // Process hierarchy (used for non animated models)
                 if (pParentEntity)
@@ -1534,30 +2278,24 @@ namespace cauldron
                 // Add light component (if present)
                 if (LightComponentMgr::Get() != nullptr && pGLTFData->LightData.size() > 0)
                 {
-                    auto nodeExtIt = node.find("extensions");
-                    if (nodeExtIt != node.end())
+                    if (node.Light >= 0)
                     {
-                        auto lightExtIt = nodeExtIt->find(g_LightExtensionName);
-                        if (lightExtIt != nodeExtIt->end())
-                        {
-                            const int lightIndex = (*lightExtIt)["light"].get<int>();
-                            CauldronAssert(ASSERT_ERROR, lightIndex >= 0 && lightIndex < pGLTFData->LightData.size(), L"Referenced light out of bounds");
+                        const int lightIndex = node.Light;
+                        CauldronAssert(ASSERT_ERROR, lightIndex >= 0 && lightIndex < pGLTFData->LightData.size(), L"Referenced light out of bounds");
 
-                            LightComponentData* pComponentData = new LightComponentData(pGLTFData->LightData[lightIndex]);
-                            pBackingMem->ComponentsData.push_back(pComponentData);
-                            LightComponent* pComponent = LightComponentMgr::Get()->SpawnLightComponent(pNewEntity, pComponentData);
-                            pBackingMem->Components.push_back(pComponent);
-                        }
+                        LightComponentData* pComponentData = new LightComponentData(pGLTFData->LightData[lightIndex]);
+                        pBackingMem->ComponentsData.push_back(pComponentData);
+                        LightComponent* pComponent = LightComponentMgr::Get()->SpawnLightComponent(pNewEntity, pComponentData);
+                        pBackingMem->Components.push_back(pComponent);
                     }
                 }
 
                 // Add mesh component
                 if (MeshComponentMgr::Get() != nullptr && pGLTFData->pLoadedContentRep->Meshes.size() > 0)
                 {
-                    auto meshIt = node.find("mesh");
-                    if (meshIt != node.end())
+                    if (node.Mesh >= 0)
                     {
-                        const int meshIndex = meshIt->get<int>();
+                        const int meshIndex = node.Mesh;
                         CauldronAssert(ASSERT_ERROR, meshIndex >= 0 && meshIndex < pGLTFData->pLoadedContentRep->Meshes.size(), L"Referenced mesh out of bounds");
 
                         MeshComponentData* pComponentData = new MeshComponentData();
@@ -1574,16 +2312,16 @@ namespace cauldron
                 // Add animation component (if present)
                 if (AnimationComponentMgr::Get() != nullptr && pGLTFData->pLoadedContentRep->Animations.size() > 0)
                 {
-                    bool isSkiningTarget = node.find("skin") != node.end();
+                    bool isSkiningTarget = node.Skin >= 0;
 
                     // if node is the target of an animation, or is in a subtree of an animated node: attach the animation component
-                    if (isAnimationTarget(glTFData, nodeIndex) || entityInAnimatedSubTree(pParentEntity) || isSkiningTarget)
+                    if (animationTargets[nodeIndex] || entityInAnimatedSubTree(pParentEntity) || isSkiningTarget)
                     {
                         AnimationComponentData* pComponentData = new AnimationComponentData();
                         pComponentData->m_pAnimRef             = &(pGLTFData->pLoadedContentRep->Animations);
                         pComponentData->m_nodeId               = nodeIndex;
                         pComponentData->m_modelId              = modelIndex;
-                        pComponentData->m_skinId               = isSkiningTarget ? node["skin"].get<int>() : -1;
+                        pComponentData->m_skinId               = node.Skin;
 
                         pBackingMem->ComponentsData.push_back(pComponentData);
 
@@ -1606,10 +2344,9 @@ namespace cauldron
                 // Add camera component
                 if (CameraComponentMgr::Get() != nullptr && pGLTFData->CameraData.size() > 0)
                 {
-                    auto cameraIt = node.find("camera");
-                    if (cameraIt != node.end())
+                    if (node.Camera >= 0)
                     {
-                        const int cameraIndex = cameraIt->get<int>();
+                        const int cameraIndex = node.Camera;
                         CauldronAssert(ASSERT_ERROR, cameraIndex >= 0 && cameraIndex < pGLTFData->CameraData.size(), L"Referenced camera out of bounds");
 
                         CameraComponentData* pComponentData = new CameraComponentData(pGLTFData->CameraData[cameraIndex]);
@@ -1639,12 +2376,8 @@ namespace cauldron
                 }
 
                 // Process any children it has
-                if (node.find("children") != node.end())
-                {
-                    const json& childNodes = node["children"];
-                    for (size_t child = 0; child < childNodes.size(); ++child)
-                        processNodeRecursive(childNodes[child], pNewEntity, pBackingMem);
-                }
+                for (uint32_t child = 0; child < node.ChildCount; ++child)
+                    processNodeRecursive(pGLTFData->NodeChildren[node.FirstChild + child], pNewEntity, pBackingMem);
             };
 
             // Iterate scenes to load
@@ -1664,18 +2397,7 @@ namespace cauldron
 
             // Update the component manager with skinning information
             if (AnimationComponentMgr::Get() != nullptr && pGLTFData->pLoadedContentRep->Animations.size() > 0)
-            {
-                const auto& skins = pGLTFData->pLoadedContentRep->Skins;
-
-                AnimationComponentMgr::Get()->m_skinningData.insert({modelIndex, {}});
-                AnimationComponentMgr::Get()->m_skinningData[modelIndex].m_SkinningMatrices.resize(skins.size());
-                AnimationComponentMgr::Get()->m_skinningData[modelIndex].m_pSkins = &skins;
-
-                for (size_t i = 0; i < skins.size(); ++i)
-                {
-                    AnimationComponentMgr::Get()->m_skinningData[modelIndex].m_SkinningMatrices[i].resize(skins[i]->m_jointsNodeIdx.size());
-                }
-            }
+                AnimationComponentMgr::Get()->RegisterModelSkins(modelIndex, &pGLTFData->pLoadedContentRep->Skins);
 
             ++modelIndex;
         }
@@ -1689,7 +2411,20 @@ namespace cauldron
         std::chrono::nanoseconds endLoad = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch());
         std::chrono::nanoseconds loadDuration = endLoad - pGLTFData->loadStartTime;
         float loadTime = loadDuration.count() * 0.000000001f;
-        Log::Write(LOGLEVEL_TRACE, L"GLTF file %ls took %f seconds to load.", pGLTFData->GLTFFileName.c_str(), loadTime);
+        Log::Write(LOGLEVEL_TRACE, L"GLTF file %ls took %f seconds to load%ls.", pGLTFData->GLTFFileName.c_str(), loadTime, pGLTFData->LoadedFromCache ? L" from scene cache" : L"");
+
+        // Compare the cooked cache load against the load from source the cache was cooked from
+        const double sceneDataMs = std::chrono::duration<double, std::milli>(pGLTFData->SceneDataLoadTime).count();
+        if (pGLTFData->LoadedFromCache && pGLTFData->SourceSceneDataLoadTime.count() > 0)
+        {
+            const double sourceSceneDataMs = std::chrono::duration<double, std::milli>(pGLTFData->SourceSceneDataLoadTime).count();
+            Log::Write(LOGLEVEL_TRACE, L"GLTF file %ls scene data took %.3f ms to load from scene cache, %.3f ms from source when cooked (%.1fx faster).",
+                       pGLTFData->GLTFFileName.c_str(), sceneDataMs, sourceSceneDataMs, sceneDataMs > 0.0 ? sourceSceneDataMs / sceneDataMs : 0.0);
+        }
+        else if (!pGLTFData->LoadedFromCache)
+        {
+            Log::Write(LOGLEVEL_TRACE, L"GLTF file %ls scene data took %.3f ms to load from source.", pGLTFData->GLTFFileName.c_str(), sceneDataMs);
+        }
 
         // Clear out the gltfContent rep memory
         delete pGLTFData;
@@ -25,6 +25,7 @@
 #include "../contentmanager.h"
 #include "../components/cameracomponent.h"
 #include "../components/lightcomponent.h"
+#include "../../misc/fileio.h"
 #include "../../misc/helpers.h"
 #include "../../render/animation.h"
 #include "../../render/mesh.h"
@@ -35,6 +36,43 @@ using json = nlohmann::ordered_json;
 namespace cauldron
 {
     struct AnimationComponentData;
+    struct FileReadRequest;
+    struct TaskCompletionCallback;
+    struct BufferDesc;
+
+    /**
+     * @struct GLTFBufferSpan
+     *
+     * Non-owning view of GLTF buffer data. Points either into buffer data loaded from
+     * file or directly into a memory mapped GLB binary chunk or scene cache.
+     *
+     * @ingroup CauldronLoaders
+     */
+    struct GLTFBufferSpan
+    {
+        const char*                             pData = nullptr;                ///< The buffer data.
+        size_t                                  Size = 0;                       ///< The size (in bytes) of the buffer data.
+    };
+
+    /**
+     * @struct GLTFNode
+     *
+     * Compact representation of a GLTF scene node. Nodes are converted to this form as they are
+     * parsed rather than being kept in the GLTF json document.
+     *
+     * @ingroup CauldronLoaders
+     */
+    struct GLTFNode
+    {
+        std::string                             Name;                           ///< The node's name (empty if un-named).
+        Mat4                                    Transform = Mat4::identity();   ///< The node's local transform.
+        int32_t                                 Mesh = -1;                      ///< The node's mesh index (-1 if none).
+        int32_t                                 Skin = -1;                      ///< The node's skin index (-1 if none).
+        int32_t                                 Camera = -1;                    ///< The node's camera index (-1 if none).
+        int32_t                                 Light = -1;                     ///< The node's punctual light index (-1 if none).
+        uint32_t                                FirstChild = 0;                 ///< Index of the node's first child in <c><i>GLTFDataRep::NodeChildren</i></c>.
+        uint32_t                                ChildCount = 0;                 ///< The node's number of children.
+    };
 
     /**
      * @struct GLTFDataRep
@@ -47,29 +85,46 @@ namespace cauldron
     struct GLTFDataRep
     {
         json*                                   pGLTFJsonData;                  ///< The json GLTF data instance.
-        std::vector<std::vector<char>>          GLTFBufferData;                 ///< The GLTF buffer data entries.
+        std::vector<std::vector<char>>          GLTFBufferData;                 ///< Storage for GLTF buffer data read from file.
+        std::vector<GLTFBufferSpan>             GLTFBuffers;                    ///< Views of all GLTF buffers (into GLTFBufferData, the mapped GLB file or the mapped scene cache).
+        MappedFile                              GLBFile;                        ///< Memory mapping of the GLB file (when loading a GLB).
+        GLTFBufferSpan                          GLBBinaryChunk;                 ///< The GLB binary chunk (when loading a GLB).
         std::wstring                            GLTFFilePath;                   ///< The GLTF file path.
         std::wstring                            GLTFFileName;                   ///< The GLTF file name.
+        std::vector<GLTFNode>                   Nodes;                          ///< All GLTF scene nodes (not kept in the json data).
+        std::vector<uint32_t>                   NodeChildren;                   ///< Child node indices of all nodes.
 
         std::vector<LightComponentData>         LightData;                      ///< Loaded <c><i>LightComponentData</i></c>.
         std::vector<CameraComponentData>        CameraData;                     ///< Loaded <c><i>CameraComponentData</i></c>.
 
-        // To synchronize data loading and initialization
-        bool                                    BuffersLoaded = false;          ///< Buffer load status. True if buffer loading is completed.
-        bool                                    TexturesLoaded = false;         ///< Texture load status. True if buffer loading is completed.
-
-        std::mutex                              CriticalSection;                ///< Mutex for syncing structure data changes.
-        std::condition_variable                 BufferCV;                       ///< Condition variable for syncing structure buffer data changes.
-        std::condition_variable                 TextureCV;                      ///< Condition variable for syncing structure texture data changes.
+        // To synchronize data loading and initialization. Entity creation runs once the scene description, the textures
+        // and all buffer assets are loaded (each stage signals this callback once, in any order, from any thread).
+        TaskCompletionCallback*                 pSceneReadyCallback = nullptr;  ///< Fan-in of all loading stages, runs <c><i>PostGLTFContentLoadCompleted</i></c>.
 
         // Content block being built up as we are loading various things
         ContentBlock*                           pLoadedContentRep = nullptr;    ///< The <c><i>ContentBlock</i></c> built by the loading processes.
 
         std::chrono::nanoseconds                loadStartTime;                  ///< The time content loading started (used to track loading times)
 
+        // Scene cache
+        uint64_t                                SourceHash = 0;                 ///< Content hash of the source glTF file (used to key the scene cache).
+        MappedFile                              SceneCacheFile;                 ///< Memory mapping of the scene cache (when loaded from the cache).
+        bool                                    LoadedFromCache = false;        ///< True if the json and buffer data were loaded from the scene cache.
+        bool                                    CookSceneCache = false;         ///< True if the scene cache should be (re-)cooked once buffers are loaded.
+        std::chrono::nanoseconds                SceneDataLoadTime = {};         ///< Time it took for the json and buffer data to be ready for processing.
+        std::chrono::nanoseconds                SourceSceneDataLoadTime = {};   ///< <c><i>SceneDataLoadTime</i></c> of the load from source the scene cache was cooked from.
+
+        // Compressed/quantized data
+        bool                                    UsesMeshQuantization = false;   ///< True if the GLTF file uses KHR_mesh_quantization.
+        bool                                    CompressedViewsDecoded = false; ///< True once EXT_meshopt_compression buffer views have been decoded.
+        std::atomic<size_t>                     DecodedBytes = { 0 };           ///< Number of bytes decoded from compressed buffer views.
+        std::chrono::nanoseconds                DecodeStartTime;                ///< The time decoding of compressed buffer views started.
+
         ~GLTFDataRep()
         {
             delete pGLTFJsonData;
+            UnmapFile(GLBFile);
+            UnmapFile(SceneCacheFile);
         }
     };
 
@@ -112,6 +167,10 @@ namespace cauldron
 
         // Handler to load all glTF related assets and content
         void LoadGLTFContent(void* pParam);
+        static void DispatchTextureLoads(GLTFDataRep* pGLTFData);
+        static TaskCompletionCallback* DispatchBufferLoads(GLTFDataRep* pGLTFData);
+        static bool DispatchCompressedViewDecodes(GLTFDataRep* pGLTFData);
+        static void DecodeCompressedView(void* pParam);
         static void LoadGLTFTexturesCompleted(const std::vector<const Texture*>& textureList, void* pCallbackParams);
 
         static void InitSkinningData(const Mesh* pMesh, AnimationComponentData* pComponentData);
@@ -122,20 +181,32 @@ namespace cauldron
         static void LoadGLTFAnimation(void* pParam);
         static void LoadGLTFSkin(void* pParam);
         static void GLTFAllBufferAssetLoadsCompleted(void* pParam);
+        static void ConvertVertexAttributesToFloat(GLTFDataRep* pGLTFData);
 
         // Parameter struct for Buffer-related loads
+        struct GLTFSharedBuffer
+        {
+            uint64_t     ContentHash = 0;
+            Buffer*      pBuffer = nullptr;
+            size_t       DataSize = 0;
+        };
+
         struct GLTFBufferLoadParams
         {
             GLTFDataRep* pGLTFData = nullptr;
             uint32_t     BufferIndex = 0;
             std::wstring BufferName = L"";
             UploadContext* pUploadCtx = nullptr;
+            FileReadRequest* pFileRead = nullptr;
+            std::vector<GLTFSharedBuffer>* pNewSharedBuffers = nullptr;  // Buffers to share once their upload has executed
         };
 
-        static const json* LoadVertexBuffer(const json& attributes, const char* attributeName, const json& accessors, const json& bufferViews, const json& buffers, const GLTFBufferLoadParams& params, VertexBufferInformation& info, bool forceConversionToFloat);
+        static Buffer* CreateSharedBuffer(const BufferDesc& desc, const char* pData, uint32_t dataSize, ResourceState finalState, const GLTFBufferLoadParams& params);
+
+        static const json* LoadVertexBuffer(const json& attributes, const char* attributeName, const json& accessors, const json& bufferViews, const json& buffers, const GLTFBufferLoadParams& params, VertexBufferInformation& info, bool forceConversionToFloat, bool allowNormalizedFormat);
         static void LoadIndexBuffer(const json& primitive, const json& accessors, const json& bufferViews, const json& buffers, const GLTFBufferLoadParams& params, IndexBufferInformation& info);
         static void LoadAnimInterpolant(AnimInterpolants& animInterpolant, const json& gltfData, int32_t interpAccessorID, const GLTFBufferLoadParams* pBufferLoadParams);
-        static void LoadAnimInterpolants(AnimChannel* pAnimChannel, AnimChannel::ComponentSampler samplerType, int32_t samplerIndex, const GLTFBufferLoadParams* pBufferLoadParams);
+        static AnimCompressionStats LoadAnimInterpolants(AnimChannel* pAnimChannel, AnimChannel::ComponentSampler samplerType, int32_t samplerIndex, const GLTFBufferLoadParams* pBufferLoadParams);
         static void GetBufferDetails(int accessor, AnimInterpolants* pAccessor, const GLTFBufferLoadParams* pBufferLoadParams);
         static void BuildBLAS(const std::vector<Mesh*>& meshes);
 
@@ -0,0 +1,333 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "gltfscenecache.h"
+#include "../framework.h"
+#include "../../misc/assert.h"
+#include "../../misc/fileio.h"
+#include "../../misc/hash.h"
+#include "../../misc/log.h"
+
+#include <cstring>
+#include <experimental/filesystem>
+
+using namespace std::experimental;
+
+namespace cauldron
+{
+    // Bump whenever the cache layout or the processing applied to cached scenes changes
+    static constexpr uint32_t s_SceneCacheMagic   = 0x43534743;  // 'CGSC'
+    static constexpr uint32_t s_SceneCacheVersion = 6;
+    static constexpr uint64_t s_SectionAlignment  = 16;
+
+    struct SceneCacheHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint64_t SourceHash;
+        uint64_t FileSize;
+        uint64_t SceneDataOffset;
+        uint64_t SceneDataSize;
+        uint64_t BufferTableOffset;
+        uint64_t NodeTableOffset;
+        uint64_t NodeChildrenOffset;
+        uint64_t NodeNamesOffset;
+        uint64_t NodeNamesSize;
+        uint32_t BufferCount;
+        uint32_t NodeCount;
+        uint32_t NodeChildCount;
+        uint32_t ProcessingFlags;
+        uint64_t SourceLoadTime;    // Time (in nanoseconds) it took to get the scene data ready from source when the cache was cooked
+    };
+
+    struct SceneCacheBufferEntry
+    {
+        uint64_t Offset;
+        uint64_t Size;
+    };
+
+    // Nodes are stored as a flat table read straight from the mapped cache, names live in a separate string block
+    struct SceneCacheNodeEntry
+    {
+        float    Transform[16];     // Column major
+        int32_t  Mesh;
+        int32_t  Skin;
+        int32_t  Camera;
+        int32_t  Light;
+        uint32_t FirstChild;
+        uint32_t ChildCount;
+        uint32_t NameOffset;
+        uint32_t NameSize;
+    };
+
+    // Loader options that change the cooked data, a cache cooked with different options is stale
+    static uint32_t GetProcessingFlags()
+    {
+        uint32_t flags = 0;
+        if (GetConfig()->NativeVertexFormats)
+            flags |= 0x1;
+        return flags;
+    }
+
+    static int64_t GetSourceFileTime(const filesystem::path& filePath)
+    {
+        return static_cast<int64_t>(filesystem::last_write_time(filePath).time_since_epoch().count());
+    }
+
+    std::wstring GLTFSceneCache::GetCacheFileName(const std::wstring& gltfFileName)
+    {
+        return gltfFileName + L".cache";
+    }
+
+    uint64_t GLTFSceneCache::HashSourceData(const void* pData, size_t dataSize)
+    {
+        return HashData64(pData, dataSize);
+    }
+
+    bool GLTFSceneCache::Load(GLTFDataRep& gltfData)
+    {
+        std::wstring cacheFileName = GetCacheFileName(gltfData.GLTFFileName);
+        if (!filesystem::exists(cacheFileName))
+            return false;
+
+        MappedFile& cacheFile = gltfData.SceneCacheFile;
+        if (!MapFileForRead(cacheFileName.c_str(), cacheFile))
+            return false;
+
+        const uint64_t fileSize = static_cast<uint64_t>(cacheFile.Size);
+        auto inFile = [fileSize](uint64_t offset, uint64_t size) { return offset <= fileSize && size <= fileSize - offset; };
+
+        // Validate the header against the source file and our current version
+        SceneCacheHeader header = {};
+        if (fileSize >= sizeof(header))
+            memcpy(&header, cacheFile.pData, sizeof(header));
+
+        if (fileSize < sizeof(header) ||
+            header.Magic != s_SceneCacheMagic || header.Version != s_SceneCacheVersion ||
+            header.SourceHash != gltfData.SourceHash || header.ProcessingFlags != GetProcessingFlags() || header.FileSize != fileSize)
+        {
+            UnmapFile(cacheFile);
+            Log::Write(LOGLEVEL_TRACE, L"Scene cache %ls is stale, it will be re-cooked.", cacheFileName.c_str());
+            return false;
+        }
+
+        bool success = inFile(header.SceneDataOffset, header.SceneDataSize) &&
+                       inFile(header.BufferTableOffset, header.BufferCount * sizeof(SceneCacheBufferEntry)) &&
+                       inFile(header.NodeTableOffset, header.NodeCount * sizeof(SceneCacheNodeEntry)) &&
+                       inFile(header.NodeChildrenOffset, header.NodeChildCount * sizeof(uint32_t)) &&
+                       inFile(header.NodeNamesOffset, header.NodeNamesSize);
+
+        // Tables are aligned in the file, so they can be used in place
+        const SceneCacheBufferEntry* pBufferEntries = reinterpret_cast<const SceneCacheBufferEntry*>(cacheFile.pData + header.BufferTableOffset);
+        const SceneCacheNodeEntry*   pNodeEntries   = reinterpret_cast<const SceneCacheNodeEntry*>(cacheFile.pData + header.NodeTableOffset);
+        const uint32_t*              pNodeChildren  = reinterpret_cast<const uint32_t*>(cacheFile.pData + header.NodeChildrenOffset);
+        const char*                  pNodeNames     = cacheFile.pData + header.NodeNamesOffset;
+
+        json cachedScene;
+        if (success)
+        {
+            const char* pSceneData = cacheFile.pData + header.SceneDataOffset;
+            cachedScene = json::from_msgpack(pSceneData, pSceneData + header.SceneDataSize, true, false);
+            success = !cachedScene.is_discarded() && cachedScene.contains("gltf") && cachedScene.contains("sources");
+        }
+
+        // Make sure none of the source buffers were modified since the cache was cooked
+        if (success)
+        {
+            for (const json& source : cachedScene["sources"])
+            {
+                filesystem::path sourceFile(gltfData.GLTFFilePath + StringToWString(source["uri"].get<std::string>()));
+                if (!filesystem::exists(sourceFile) ||
+                    filesystem::file_size(sourceFile) != source["size"].get<uint64_t>() ||
+                    GetSourceFileTime(sourceFile) != source["time"].get<int64_t>())
+                {
+                    Log::Write(LOGLEVEL_TRACE, L"Scene cache %ls is out of date with %ls, it will be re-cooked.", cacheFileName.c_str(), sourceFile.c_str());
+                    success = false;
+                    break;
+                }
+            }
+        }
+
+        for (uint32_t i = 0; success && i < header.BufferCount; ++i)
+            success = inFile(pBufferEntries[i].Offset, pBufferEntries[i].Size);
+
+        for (uint32_t i = 0; success && i < header.NodeCount; ++i)
+        {
+            const SceneCacheNodeEntry& entry = pNodeEntries[i];
+            success = static_cast<uint64_t>(entry.FirstChild) + entry.ChildCount <= header.NodeChildCount &&
+                      static_cast<uint64_t>(entry.NameOffset) + entry.NameSize <= header.NodeNamesSize;
+        }
+
+        if (!success)
+        {
+            UnmapFile(cacheFile);
+            CauldronWarning(L"Scene cache %ls could not be read, falling back to source data.", cacheFileName.c_str());
+            return false;
+        }
+
+        *gltfData.pGLTFJsonData = std::move(cachedScene["gltf"]);
+
+        gltfData.Nodes.resize(header.NodeCount);
+        for (uint32_t i = 0; i < header.NodeCount; ++i)
+        {
+            const SceneCacheNodeEntry& entry = pNodeEntries[i];
+            const float* t = entry.Transform;
+
+            GLTFNode& node  = gltfData.Nodes[i];
+            node.Name       = std::string(pNodeNames + entry.NameOffset, entry.NameSize);
+            node.Transform  = Mat4(Vec4(t[0], t[1], t[2], t[3]), Vec4(t[4], t[5], t[6], t[7]), Vec4(t[8], t[9], t[10], t[11]), Vec4(t[12], t[13], t[14], t[15]));
+            node.Mesh       = entry.Mesh;
+            node.Skin       = entry.Skin;
+            node.Camera     = entry.Camera;
+            node.Light      = entry.Light;
+            node.FirstChild = entry.FirstChild;
+            node.ChildCount = entry.ChildCount;
+        }
+        gltfData.NodeChildren.assign(pNodeChildren, pNodeChildren + header.NodeChildCount);
+
+        // Buffer data is used straight from the mapping, which stays alive with the scene data
+        gltfData.GLTFBufferData.clear();
+        gltfData.GLTFBuffers.resize(header.BufferCount);
+        for (uint32_t i = 0; i < header.BufferCount; ++i)
+            gltfData.GLTFBuffers[i] = { cacheFile.pData + pBufferEntries[i].Offset, static_cast<size_t>(pBufferEntries[i].Size) };
+        gltfData.SourceSceneDataLoadTime = std::chrono::nanoseconds(header.SourceLoadTime);
+        return true;
+    }
+
+    bool GLTFSceneCache::Write(const GLTFDataRep& gltfData)
+    {
+        const json& gltfJson = *gltfData.pGLTFJsonData;
+        const std::vector<GLTFBufferSpan>& bufferData = gltfData.GLTFBuffers;
+
+        // Record the files holding buffer data the cache was built from so we can detect when they change
+        // (for GLB files only the json chunk is hashed, so the GLB itself is tracked as well)
+        std::vector<std::string> sourceFiles;
+        if (gltfData.GLBFile.pData)
+            sourceFiles.push_back(WStringToString(filesystem::path(gltfData.GLTFFileName).filename().wstring()));
+
+        auto buffersIt = gltfJson.find("buffers");
+        if (buffersIt != gltfJson.end())
+        {
+            for (const json& buffer : *buffersIt)
+            {
+                auto uriIt = buffer.find("uri");
+                if (uriIt != buffer.end())
+                    sourceFiles.push_back(uriIt->get<std::string>());
+            }
+        }
+
+        json cachedScene;
+        cachedScene["sources"] = json::array();
+        for (const std::string& sourceName : sourceFiles)
+        {
+            filesystem::path sourceFile(gltfData.GLTFFilePath + StringToWString(sourceName));
+            if (!filesystem::exists(sourceFile))
+                return false;
+
+            json source;
+            source["uri"]  = sourceName;
+            source["size"] = static_cast<uint64_t>(filesystem::file_size(sourceFile));
+            source["time"] = GetSourceFileTime(sourceFile);
+            cachedScene["sources"].push_back(std::move(source));
+        }
+        cachedScene["gltf"] = gltfJson;
+
+        std::vector<uint8_t> sceneData = json::to_msgpack(cachedScene);
+
+        // Nodes aren't part of the json document once parsed, flatten them into the node table
+        std::vector<SceneCacheNodeEntry> nodeEntries(gltfData.Nodes.size());
+        std::string nodeNames;
+        for (size_t i = 0; i < gltfData.Nodes.size(); ++i)
+        {
+            const GLTFNode& node = gltfData.Nodes[i];
+            SceneCacheNodeEntry& entry = nodeEntries[i];
+            for (int col = 0; col < 4; ++col)
+            {
+                for (int row = 0; row < 4; ++row)
+                    entry.Transform[col * 4 + row] = static_cast<float>(node.Transform.getElem(col, row));
+            }
+            entry.Mesh       = node.Mesh;
+            entry.Skin       = node.Skin;
+            entry.Camera     = node.Camera;
+            entry.Light      = node.Light;
+            entry.FirstChild = node.FirstChild;
+            entry.ChildCount = node.ChildCount;
+            entry.NameOffset = static_cast<uint32_t>(nodeNames.size());
+            entry.NameSize   = static_cast<uint32_t>(node.Name.size());
+            nodeNames       += node.Name;
+        }
+
+        // Lay out the cache: header, then aligned buffer table, node table, node children, node names, scene data and buffer data
+        SceneCacheHeader header = {};
+        header.Magic           = s_SceneCacheMagic;
+        header.Version         = s_SceneCacheVersion;
+        header.SourceHash      = gltfData.SourceHash;
+        header.BufferCount     = static_cast<uint32_t>(bufferData.size());
+        header.NodeCount       = static_cast<uint32_t>(nodeEntries.size());
+        header.NodeChildCount  = static_cast<uint32_t>(gltfData.NodeChildren.size());
+        header.ProcessingFlags = GetProcessingFlags();
+        header.SourceLoadTime  = static_cast<uint64_t>(gltfData.SceneDataLoadTime.count());
+
+        uint64_t cacheSize = sizeof(SceneCacheHeader);
+        auto addSection = [&cacheSize](uint64_t size) {
+            const uint64_t offset = AlignUp(cacheSize, s_SectionAlignment);
+            cacheSize = offset + size;
+            return offset;
+        };
+        header.BufferTableOffset  = addSection(bufferData.size() * sizeof(SceneCacheBufferEntry));
+        header.NodeTableOffset    = addSection(nodeEntries.size() * sizeof(SceneCacheNodeEntry));
+        header.NodeChildrenOffset = addSection(gltfData.NodeChildren.size() * sizeof(uint32_t));
+        header.NodeNamesSize      = nodeNames.size();
+        header.NodeNamesOffset    = addSection(header.NodeNamesSize);
+        header.SceneDataSize      = sceneData.size();
+        header.SceneDataOffset    = addSection(header.SceneDataSize);
+
+        std::vector<SceneCacheBufferEntry> bufferEntries(bufferData.size());
+        for (size_t i = 0; i < bufferData.size(); ++i)
+        {
+            bufferEntries[i].Offset = addSection(bufferData[i].Size);
+            bufferEntries[i].Size   = bufferData[i].Size;
+        }
+        header.FileSize = cacheSize;
+
+        std::vector<char> cacheData(cacheSize, 0);
+        memcpy(cacheData.data(), &header, sizeof(header));
+        memcpy(cacheData.data() + header.BufferTableOffset, bufferEntries.data(), bufferEntries.size() * sizeof(SceneCacheBufferEntry));
+        memcpy(cacheData.data() + header.NodeTableOffset, nodeEntries.data(), nodeEntries.size() * sizeof(SceneCacheNodeEntry));
+        memcpy(cacheData.data() + header.NodeChildrenOffset, gltfData.NodeChildren.data(), gltfData.NodeChildren.size() * sizeof(uint32_t));
+        memcpy(cacheData.data() + header.NodeNamesOffset, nodeNames.data(), nodeNames.size());
+        memcpy(cacheData.data() + header.SceneDataOffset, sceneData.data(), sceneData.size());
+        for (size_t i = 0; i < bufferData.size(); ++i)
+            memcpy(cacheData.data() + bufferEntries[i].Offset, bufferData[i].pData, bufferData[i].Size);
+
+        std::wstring cacheFileName = GetCacheFileName(gltfData.GLTFFileName);
+        if (WriteFileAll(cacheFileName.c_str(), cacheData.data(), cacheData.size()) != static_cast<int64_t>(cacheData.size()))
+        {
+            CauldronWarning(L"Could not write scene cache %ls", cacheFileName.c_str());
+            return false;
+        }
+
+        Log::Write(LOGLEVEL_TRACE, L"Cooked scene cache %ls (%llu bytes).", cacheFileName.c_str(), cacheSize);
+        return true;
+    }
+
+} // namespace cauldron
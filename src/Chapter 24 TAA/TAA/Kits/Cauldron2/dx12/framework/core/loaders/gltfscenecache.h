@@ -0,0 +1,74 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "gltfloader.h"
+#include "../../misc/helpers.h"
+
+#include <string>
+
+namespace cauldron
+{
+    /**
+     * @class GLTFSceneCache
+     *
+     * Reads and writes cooked glTF scene caches. A scene cache stores the processed glTF document
+     * (binary encoded), the flattened scene nodes and all of the processed buffer data (vertex
+     * attributes already converted) in a single versioned file, keyed on a content hash of the
+     * source glTF file. Valid caches are memory mapped, which replaces the json parse of the source
+     * file and the individual buffer file reads; buffer data is used in place from the mapping.
+     *
+     * @ingroup CauldronLoaders
+     */
+    class GLTFSceneCache
+    {
+    public:
+
+        /**
+         * @brief   Returns the cache file name used for the provided glTF file.
+         */
+        static std::wstring GetCacheFileName(const std::wstring& gltfFileName);
+
+        /**
+         * @brief   Computes the content hash used to key a scene cache.
+         */
+        static uint64_t HashSourceData(const void* pData, size_t dataSize);
+
+        /**
+         * @brief   Maps the scene cache and loads the json, nodes and buffer views of a glTF scene from it. Returns false
+         *          if no valid cache matching the scene's source hash is found, in which case the scene data is left untouched.
+         */
+        static bool Load(GLTFDataRep& gltfData);
+
+        /**
+         * @brief   Writes the scene cache for a loaded glTF scene. Returns true on success.
+         */
+        static bool Write(const GLTFDataRep& gltfData);
+
+    private:
+        GLTFSceneCache() = delete;
+        NO_COPY(GLTFSceneCache)
+        NO_MOVE(GLTFSceneCache)
+    };
+
+} // namespace cauldron
@@ -0,0 +1,235 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "gltfstreamparser.h"
+#include "../../misc/assert.h"
+
+namespace cauldron
+{
+    extern const char* g_LightExtensionName;
+
+    // Builds the glTF json document from SAX events, diverting scene nodes to the compact node array
+    class GLTFSaxHandler : public nlohmann::json_sax<json>
+    {
+    public:
+        GLTFSaxHandler(GLTFDataRep& gltfData, const GLTFStreamParser::MemberParsedCallback& memberParsedCallback) :
+            m_GLTFData(gltfData), m_Root(*gltfData.pGLTFJsonData), m_MemberParsedCallback(memberParsedCallback) {}
+
+        bool null() override                                                { return HandleValue(json(nullptr)); }
+        bool boolean(bool val) override                                     { return HandleValue(json(val)); }
+        bool number_integer(number_integer_t val) override                  { return HandleValue(json(val)); }
+        bool number_unsigned(number_unsigned_t val) override                { return HandleValue(json(val)); }
+        bool number_float(number_float_t val, const string_t& str) override { return HandleValue(json(val)); }
+        bool string(string_t& val) override                                 { return HandleValue(json(std::move(val))); }
+        bool binary(binary_t& val) override                                 { return HandleValue(json::binary(std::move(val))); }
+
+        bool start_object(std::size_t elements) override
+        {
+            m_Stack.push_back(InsertValue(json::object()));
+            return true;
+        }
+
+        bool key(string_t& val) override
+        {
+            if (m_Stack.size() == 1)
+            {
+                m_CurrentMember = val;
+
+                // Nodes never make it into the document
+                if (val == "nodes")
+                {
+                    m_ParsingNodes = true;
+                    m_pObjectElement = nullptr;
+                    return true;
+                }
+            }
+
+            m_pObjectElement = &(*m_Stack.back())[val];
+            return true;
+        }
+
+        bool end_object() override
+        {
+            m_Stack.pop_back();
+            return ValueCompleted();
+        }
+
+        bool start_array(std::size_t elements) override
+        {
+            // The node array itself is only tracked on the stack, each node is built on its own and converted once complete
+            if (m_ParsingNodes && m_Stack.size() == 1)
+                m_Stack.push_back(nullptr);
+            else
+                m_Stack.push_back(InsertValue(json::array()));
+            return true;
+        }
+
+        bool end_array() override
+        {
+            m_Stack.pop_back();
+            return ValueCompleted();
+        }
+
+        bool parse_error(std::size_t position, const std::string& lastToken, const json::exception& ex) override
+        {
+            CauldronWarning(L"glTF parse error at byte %llu: %ls", static_cast<unsigned long long>(position), StringToWString(ex.what()).c_str());
+            return false;
+        }
+
+    private:
+        json* InsertValue(json&& value)
+        {
+            if (m_Stack.empty())
+            {
+                m_Root = std::move(value);
+                return &m_Root;
+            }
+
+            // Elements of the node array are built into their own scratch value
+            json* pParent = m_Stack.back();
+            if (pParent == nullptr)
+            {
+                m_Node = std::move(value);
+                return &m_Node;
+            }
+
+            if (pParent->is_array())
+            {
+                pParent->push_back(std::move(value));
+                return &pParent->back();
+            }
+
+            CauldronAssert(ASSERT_CRITICAL, m_pObjectElement != nullptr, L"glTF nodes must be stored in an array.");
+            *m_pObjectElement = std::move(value);
+            return m_pObjectElement;
+        }
+
+        bool HandleValue(json&& value)
+        {
+            InsertValue(std::move(value));
+            return ValueCompleted();
+        }
+
+        bool ValueCompleted()
+        {
+            if (m_Stack.size() == 1)
+            {
+                // A top-level member is complete
+                m_ParsingNodes = false;
+                if (m_MemberParsedCallback)
+                    m_MemberParsedCallback(m_CurrentMember);
+            }
+            else if (!m_Stack.empty() && m_Stack.back() == nullptr)
+            {
+                // A node is complete
+                GLTFStreamParser::AddNode(m_Node, m_GLTFData);
+                m_Node = nullptr;
+            }
+
+            return true;
+        }
+
+        GLTFDataRep&                                    m_GLTFData;
+        json&                                           m_Root;
+        const GLTFStreamParser::MemberParsedCallback&   m_MemberParsedCallback;
+
+        std::vector<json*>                              m_Stack;                    // Open containers (nullptr for the node array)
+        json*                                           m_pObjectElement = nullptr; // Value slot of the last parsed object key
+        json                                            m_Node;                     // Node currently being parsed
+        std::string                                     m_CurrentMember;            // Top-level member currently being parsed
+        bool                                            m_ParsingNodes = false;
+    };
+
+    static Vec3 ReadNodeVec3(const json& node, const char* name, Vec3 defaultValue)
+    {
+        auto it = node.find(name);
+        if (it == node.end())
+            return defaultValue;
+
+        return Vec3(it->at(0).get<float>(), it->at(1).get<float>(), it->at(2).get<float>());
+    }
+
+    static Vec4 ReadNodeVec4(const json& values, size_t offset)
+    {
+        return Vec4(values.at(offset).get<float>(), values.at(offset + 1).get<float>(), values.at(offset + 2).get<float>(), values.at(offset + 3).get<float>());
+    }
+
+    bool GLTFStreamParser::Parse(const char* pData, size_t dataSize, GLTFDataRep& gltfData, const MemberParsedCallback& memberParsedCallback)
+    {
+        gltfData.Nodes.clear();
+        gltfData.NodeChildren.clear();
+
+        GLTFSaxHandler handler(gltfData, memberParsedCallback);
+        return json::sax_parse(pData, pData + dataSize, &handler);
+    }
+
+    void GLTFStreamParser::AddNode(const json& node, GLTFDataRep& gltfData)
+    {
+        CauldronAssert(ASSERT_CRITICAL, node.is_object(), L"glTF nodes must be objects.");
+
+        GLTFNode newNode;
+        newNode.Name   = node.value("name", std::string());
+        newNode.Mesh   = node.value("mesh", -1);
+        newNode.Skin   = node.value("skin", -1);
+        newNode.Camera = node.value("camera", -1);
+
+        auto extensionsIt = node.find("extensions");
+        if (extensionsIt != node.end())
+        {
+            auto lightIt = extensionsIt->find(g_LightExtensionName);
+            if (lightIt != extensionsIt->end())
+                newNode.Light = lightIt->at("light").get<int32_t>();
+        }
+
+        // Compose the local transform
+        auto matrixIt = node.find("matrix");
+        if (matrixIt != node.end())
+        {
+            newNode.Transform = Mat4(ReadNodeVec4(*matrixIt, 0), ReadNodeVec4(*matrixIt, 4), ReadNodeVec4(*matrixIt, 8), ReadNodeVec4(*matrixIt, 12));
+        }
+        else
+        {
+            const Vec3 scale       = ReadNodeVec3(node, "scale", Vec3(1.0f, 1.0f, 1.0f));
+            const Vec3 translation = ReadNodeVec3(node, "translation", Vec3(0.0f, 0.0f, 0.0f));
+
+            Quat rotation = Quat::identity();
+            auto rotationIt = node.find("rotation");
+            if (rotationIt != node.end())
+                rotation = Quat(ReadNodeVec4(*rotationIt, 0));
+
+            newNode.Transform = Mat4::translation(translation) * Mat4::rotation(rotation) * Mat4::scale(scale);
+        }
+
+        // Children are stored contiguously in the scene's child array
+        newNode.FirstChild = static_cast<uint32_t>(gltfData.NodeChildren.size());
+        auto childrenIt = node.find("children");
+        if (childrenIt != node.end())
+        {
+            for (const json& child : *childrenIt)
+                gltfData.NodeChildren.push_back(child.get<uint32_t>());
+            newNode.ChildCount = static_cast<uint32_t>(childrenIt->size());
+        }
+
+        gltfData.Nodes.push_back(std::move(newNode));
+    }
+
+} // namespace cauldron
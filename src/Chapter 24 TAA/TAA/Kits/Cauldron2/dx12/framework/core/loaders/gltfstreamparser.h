@@ -0,0 +1,70 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "gltfloader.h"
+#include "../../misc/helpers.h"
+
+#include <functional>
+#include <string>
+
+namespace cauldron
+{
+    /**
+     * @class GLTFStreamParser
+     *
+     * Streaming (SAX) parser for glTF scene descriptions. Top-level members are built into the scene's
+     * json document as they are parsed, except for nodes, which are converted straight into the compact
+     * <c><i>GLTFNode</i></c> array of the scene without ever being held as a document. A callback is
+     * invoked as each top-level member completes so that loading can start before the rest of the
+     * scene description has been parsed.
+     *
+     * @ingroup CauldronLoaders
+     */
+    class GLTFStreamParser
+    {
+    public:
+
+        /**
+         * @brief   Callback invoked (on the parsing thread) each time a top-level member of the glTF document has been parsed.
+         */
+        typedef std::function<void(const std::string& memberName)> MemberParsedCallback;
+
+        /**
+         * @brief   Parses the glTF json data into the scene's json document and node array. Returns false if the data
+         *          is not valid json.
+         */
+        static bool Parse(const char* pData, size_t dataSize, GLTFDataRep& gltfData, const MemberParsedCallback& memberParsedCallback = nullptr);
+
+        /**
+         * @brief   Converts a glTF json node and appends it to the scene's node array.
+         */
+        static void AddNode(const json& node, GLTFDataRep& gltfData);
+
+    private:
+        GLTFStreamParser() = delete;
+        NO_COPY(GLTFStreamParser)
+        NO_MOVE(GLTFStreamParser)
+    };
+
+} // namespace cauldron
@@ -0,0 +1,572 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "meshoptdecoder.h"
+
+#include <cmath>
+#include <cstring>
+#include <emmintrin.h>
+
+// Decoders follow the bitstream layouts of the EXT_meshopt_compression specification:
+// https://github.com/KhronosGroup/glTF/blob/main/extensions/2.0/Vendor/EXT_meshopt_compression/README.md
+
+namespace cauldron
+{
+    //////////////////////////////////////////////////////////////////////////
+    // Vertex codec
+
+    static constexpr uint8_t s_VertexHeader         = 0xa0;
+    static constexpr size_t  s_VertexBlockSizeBytes = 8192;
+    static constexpr size_t  s_VertexBlockMaxSize   = 256;
+    static constexpr size_t  s_ByteGroupSize        = 16;
+    static constexpr size_t  s_ByteGroupDecodeLimit = 24;
+    static constexpr size_t  s_TailMaxSize          = 32;
+
+    static size_t GetVertexBlockSize(size_t vertexSize)
+    {
+        // The whole block has to fit in the scratch buffer, and is truncated to whole byte groups
+        size_t blockSize = (s_VertexBlockSizeBytes / vertexSize) & ~(s_ByteGroupSize - 1);
+        return blockSize < s_VertexBlockMaxSize ? blockSize : s_VertexBlockMaxSize;
+    }
+
+    // Decodes a group of 16 bytes stored with 0, 2, 4 or 8 bits each (values that don't fit are stored in full after the packed bits)
+    static const uint8_t* DecodeBytesGroup(const uint8_t* pData, uint8_t* pBuffer, int bitsLog2)
+    {
+        switch (bitsLog2)
+        {
+        case 0:
+            memset(pBuffer, 0, s_ByteGroupSize);
+            return pData;
+
+        case 1:
+        case 2:
+        {
+            const uint32_t bits      = 1u << bitsLog2;
+            const uint32_t sentinel  = (1u << bits) - 1;
+            const uint8_t* pVariable = pData + bits * 2;  // 16 values * bits / 8
+            for (size_t i = 0; i < s_ByteGroupSize; i += 8 / bits)
+            {
+                uint8_t packed = *pData++;
+                for (uint32_t j = 0; j < 8 / bits; ++j)
+                {
+                    uint8_t value = packed >> (8 - bits);
+                    packed <<= bits;
+                    *pBuffer++ = (value == sentinel) ? *pVariable : value;
+                    pVariable += (value == sentinel);
+                }
+            }
+            return pVariable;
+        }
+
+        default:
+            memcpy(pBuffer, pData, s_ByteGroupSize);
+            return pData + s_ByteGroupSize;
+        }
+    }
+
+    static const uint8_t* DecodeBytes(const uint8_t* pData, const uint8_t* pDataEnd, uint8_t* pBuffer, size_t bufferSize)
+    {
+        // 2 header bits per byte group
+        const uint8_t* pHeader    = pData;
+        const size_t   headerSize = (bufferSize / s_ByteGroupSize + 3) / 4;
+        if (static_cast<size_t>(pDataEnd - pData) < headerSize)
+            return nullptr;
+
+        pData += headerSize;
+        for (size_t i = 0; i < bufferSize; i += s_ByteGroupSize)
+        {
+            if (static_cast<size_t>(pDataEnd - pData) < s_ByteGroupDecodeLimit)
+                return nullptr;
+
+            const size_t group    = i / s_ByteGroupSize;
+            const int    bitsLog2 = (pHeader[group / 4] >> ((group % 4) * 2)) & 3;
+            pData = DecodeBytesGroup(pData, pBuffer + i, bitsLog2);
+        }
+
+        return pData;
+    }
+
+    // Undoes the zigzag and delta encoding of a byte stream, 16 values at a time (prefix sums are done with log-step byte shifts)
+    static uint8_t DecodeByteDeltas(const uint8_t* pEncoded, uint8_t* pDecoded, size_t count, uint8_t previous)
+    {
+        const __m128i one     = _mm_set1_epi8(1);
+        const __m128i lowBits = _mm_set1_epi8(0x7f);
+
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i encoded = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pEncoded + i));
+            __m128i deltas  = _mm_xor_si128(_mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(encoded, one)), _mm_and_si128(_mm_srli_epi16(encoded, 1), lowBits));
+
+            deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 1));
+            deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 2));
+            deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 4));
+            deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 8));
+            deltas = _mm_add_epi8(deltas, _mm_set1_epi8(static_cast<char>(previous)));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDecoded + i), deltas);
+            previous = pDecoded[i + 15];
+        }
+
+        for (; i < count; ++i)
+        {
+            const uint8_t encoded = pEncoded[i];
+            previous = static_cast<uint8_t>(((0 - (encoded & 1)) ^ (encoded >> 1)) + previous);
+            pDecoded[i] = previous;
+        }
+
+        return previous;
+    }
+
+    static const uint8_t* DecodeVertexBlock(const uint8_t* pData, const uint8_t* pDataEnd, uint8_t* pVertexData, size_t vertexCount, size_t vertexSize, uint8_t* pLastVertex)
+    {
+        uint8_t encoded[s_VertexBlockMaxSize];
+        uint8_t decoded[s_VertexBlockMaxSize];
+        const size_t vertexCountAligned = (vertexCount + s_ByteGroupSize - 1) & ~(s_ByteGroupSize - 1);
+
+        // Each byte of the vertex is stored as its own stream
+        for (size_t k = 0; k < vertexSize; ++k)
+        {
+            pData = DecodeBytes(pData, pDataEnd, encoded, vertexCountAligned);
+            if (!pData)
+                return nullptr;
+
+            pLastVertex[k] = DecodeByteDeltas(encoded, decoded, vertexCount, pLastVertex[k]);
+            for (size_t i = 0; i < vertexCount; ++i)
+                pVertexData[i * vertexSize + k] = decoded[i];
+        }
+
+        return pData;
+    }
+
+    bool DecodeMeshoptVertexBuffer(void* pDst, size_t vertexCount, size_t vertexSize, const uint8_t* pSrc, size_t srcSize)
+    {
+        if (vertexSize == 0 || vertexSize > 256 || vertexSize % 4 != 0)
+            return false;
+
+        const uint8_t* pData    = pSrc;
+        const uint8_t* pDataEnd = pSrc + srcSize;
+        if (srcSize < 1 + vertexSize)
+            return false;
+
+        // Only version 0 is valid for the glTF extension
+        if (*pData++ != s_VertexHeader)
+            return false;
+
+        // Deltas of the first vertex are relative to the tail
+        uint8_t lastVertex[256];
+        memcpy(lastVertex, pDataEnd - vertexSize, vertexSize);
+
+        uint8_t* pVertexData = static_cast<uint8_t*>(pDst);
+        const size_t blockSize = GetVertexBlockSize(vertexSize);
+        for (size_t vertexOffset = 0; vertexOffset < vertexCount; vertexOffset += blockSize)
+        {
+            const size_t blockCount = (vertexOffset + blockSize < vertexCount) ? blockSize : vertexCount - vertexOffset;
+            pData = DecodeVertexBlock(pData, pDataEnd, pVertexData + vertexOffset * vertexSize, blockCount, vertexSize, lastVertex);
+            if (!pData)
+                return false;
+        }
+
+        const size_t tailSize = vertexSize < s_TailMaxSize ? s_TailMaxSize : vertexSize;
+        return static_cast<size_t>(pDataEnd - pData) == tailSize;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // Index codecs
+
+    static constexpr uint8_t s_IndexHeader    = 0xe0;
+    static constexpr uint8_t s_SequenceHeader = 0xd0;
+
+    struct IndexFifos
+    {
+        uint32_t    Edges[16][2];
+        uint32_t    Vertices[16];
+        size_t      EdgeOffset = 0;
+        size_t      VertexOffset = 0;
+
+        IndexFifos()
+        {
+            memset(Edges, -1, sizeof(Edges));
+            memset(Vertices, -1, sizeof(Vertices));
+        }
+
+        void PushEdge(uint32_t a, uint32_t b)
+        {
+            Edges[EdgeOffset][0] = a;
+            Edges[EdgeOffset][1] = b;
+            EdgeOffset = (EdgeOffset + 1) & 15;
+        }
+
+        void PushVertex(uint32_t v, bool push = true)
+        {
+            Vertices[VertexOffset] = v;
+            VertexOffset = (VertexOffset + (push ? 1 : 0)) & 15;
+        }
+    };
+
+    static uint32_t DecodeVByte(const uint8_t*& pData)
+    {
+        uint8_t lead = *pData++;
+        if (lead < 128)
+            return lead;
+
+        // Up to 4 extra bytes
+        uint32_t result = lead & 127;
+        uint32_t shift = 7;
+        for (int i = 0; i < 4; ++i)
+        {
+            uint8_t group = *pData++;
+            result |= static_cast<uint32_t>(group & 127) << shift;
+            shift += 7;
+            if (group < 128)
+                break;
+        }
+
+        return result;
+    }
+
+    static uint32_t DecodeIndex(const uint8_t*& pData, uint32_t last)
+    {
+        uint32_t v = DecodeVByte(pData);
+        uint32_t d = (v >> 1) ^ (0 - (v & 1));
+        return last + d;
+    }
+
+    static void WriteTriangle(void* pDst, size_t offset, size_t indexSize, uint32_t a, uint32_t b, uint32_t c)
+    {
+        if (indexSize == 2)
+        {
+            uint16_t* pIndices = static_cast<uint16_t*>(pDst) + offset;
+            pIndices[0] = static_cast<uint16_t>(a);
+            pIndices[1] = static_cast<uint16_t>(b);
+            pIndices[2] = static_cast<uint16_t>(c);
+        }
+        else
+        {
+            uint32_t* pIndices = static_cast<uint32_t*>(pDst) + offset;
+            pIndices[0] = a;
+            pIndices[1] = b;
+            pIndices[2] = c;
+        }
+    }
+
+    bool DecodeMeshoptIndexBuffer(void* pDst, size_t indexCount, size_t indexSize, const uint8_t* pSrc, size_t srcSize)
+    {
+        if (indexCount % 3 != 0 || (indexSize != 2 && indexSize != 4))
+            return false;
+
+        // The smallest valid encoding is the header, a code byte per triangle and the 16 byte aux code table
+        if (srcSize < 1 + indexCount / 3 + 16 || (pSrc[0] & 0xf0) != s_IndexHeader)
+            return false;
+
+        const int version = pSrc[0] & 0x0f;
+        if (version > 1)
+            return false;
+
+        IndexFifos fifos;
+        uint32_t next = 0;
+        uint32_t last = 0;
+        const int fecMax = version >= 1 ? 13 : 15;
+
+        const uint8_t* pCode      = pSrc + 1;
+        const uint8_t* pData      = pCode + indexCount / 3;
+        const uint8_t* pDataEnd   = pSrc + srcSize - 16;
+        const uint8_t* pCodeTable = pDataEnd;
+
+        for (size_t i = 0; i < indexCount; i += 3)
+        {
+            // A triangle reads at most 16 bytes of data, which the code table at the end guarantees are there
+            if (pData > pDataEnd)
+                return false;
+
+            const uint8_t codeTri = *pCode++;
+            if (codeTri < 0xf0)
+            {
+                // Edge from the fifo plus a vertex (new, from the fifo or free)
+                const int fe = codeTri >> 4;
+                uint32_t a = fifos.Edges[(fifos.EdgeOffset - 1 - fe) & 15][0];
+                uint32_t b = fifos.Edges[(fifos.EdgeOffset - 1 - fe) & 15][1];
+                uint32_t c = 0;
+
+                const int fec = codeTri & 15;
+                if (fec < fecMax)
+                {
+                    c = (fec == 0) ? next : fifos.Vertices[(fifos.VertexOffset - 1 - fec) & 15];
+                    next += (fec == 0);
+                    fifos.PushVertex(c, fec == 0);
+                }
+                else
+                {
+                    // 13/14 encode last -1/+1 (version 1), 15 a delta encoded free index
+                    last = c = (fec != 15) ? last + (fec - (fec ^ 3)) : DecodeIndex(pData, last);
+                    fifos.PushVertex(c);
+                }
+
+                fifos.PushEdge(c, b);
+                fifos.PushEdge(a, c);
+                WriteTriangle(pDst, i, indexSize, a, b, c);
+            }
+            else
+            {
+                uint32_t a, b, c;
+                int feb, fec;
+                if (codeTri < 0xfe)
+                {
+                    // Aux code from the table, first vertex is always new
+                    const uint8_t codeAux = pCodeTable[codeTri & 15];
+                    feb = codeAux >> 4;
+                    fec = codeAux & 15;
+
+                    a = next++;
+                    b = (feb == 0) ? next : fifos.Vertices[(fifos.VertexOffset - feb) & 15];
+                    next += (feb == 0);
+                    c = (fec == 0) ? next : fifos.Vertices[(fifos.VertexOffset - fec) & 15];
+                    next += (fec == 0);
+                }
+                else
+                {
+                    // Aux code stored in full, vertices can be new, from the fifo or free
+                    const uint8_t codeAux = *pData++;
+                    const int fea = (codeTri == 0xfe) ? 0 : 15;
+                    feb = codeAux >> 4;
+                    fec = codeAux & 15;
+
+                    // Restart
+                    if (codeAux == 0)
+                        next = 0;
+
+                    a = (fea == 0) ? next++ : 0;
+                    b = (feb == 0) ? next++ : fifos.Vertices[(fifos.VertexOffset - feb) & 15];
+                    c = (fec == 0) ? next++ : fifos.Vertices[(fifos.VertexOffset - fec) & 15];
+
+                    if (fea == 15)
+                        last = a = DecodeIndex(pData, last);
+                    if (feb == 15)
+                        last = b = DecodeIndex(pData, last);
+                    if (fec == 15)
+                        last = c = DecodeIndex(pData, last);
+                }
+
+                WriteTriangle(pDst, i, indexSize, a, b, c);
+
+                fifos.PushVertex(a);
+                fifos.PushVertex(b, feb == 0 || feb == 15);
+                fifos.PushVertex(c, fec == 0 || fec == 15);
+                fifos.PushEdge(b, a);
+                fifos.PushEdge(c, b);
+                fifos.PushEdge(a, c);
+            }
+        }
+
+        // All data should have been consumed up to the code table
+        return pData == pDataEnd;
+    }
+
+    bool DecodeMeshoptIndexSequence(void* pDst, size_t indexCount, size_t indexSize, const uint8_t* pSrc, size_t srcSize)
+    {
+        if (indexSize != 2 && indexSize != 4)
+            return false;
+
+        // The smallest valid encoding is the header, a byte per index and a 4 byte tail
+        if (srcSize < 1 + indexCount + 4 || (pSrc[0] & 0xf0) != s_SequenceHeader || (pSrc[0] & 0x0f) > 1)
+            return false;
+
+        const uint8_t* pData    = pSrc + 1;
+        const uint8_t* pDataEnd = pSrc + srcSize - 4;
+
+        // Indices are delta encoded against one of two baselines
+        uint32_t last[2] = { 0, 0 };
+        for (size_t i = 0; i < indexCount; ++i)
+        {
+            // An index reads at most 5 bytes, which the tail guarantees are there
+            if (pData >= pDataEnd)
+                return false;
+
+            uint32_t v = DecodeVByte(pData);
+            const uint32_t baseline = v & 1;
+            v >>= 1;
+
+            const uint32_t index = last[baseline] + ((v >> 1) ^ (0 - (v & 1)));
+            last[baseline] = index;
+
+            if (indexSize == 2)
+                static_cast<uint16_t*>(pDst)[i] = static_cast<uint16_t>(index);
+            else
+                static_cast<uint32_t*>(pDst)[i] = index;
+        }
+
+        return pData == pDataEnd;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // Filters
+
+    // Rounds to the nearest integer, halfway cases away from zero
+    static inline __m128i RoundToInt(__m128 value)
+    {
+        const __m128 half = _mm_or_ps(_mm_and_ps(value, _mm_set1_ps(-0.f)), _mm_set1_ps(0.5f));
+        return _mm_cvttps_epi32(_mm_add_ps(value, half));
+    }
+
+    static inline __m128 Abs(__m128 value)
+    {
+        return _mm_andnot_ps(_mm_set1_ps(-0.f), value);
+    }
+
+    // Flips the sign of value where sign is negative
+    static inline __m128 MultiplySign(__m128 value, __m128 sign)
+    {
+        return _mm_xor_ps(value, _mm_and_ps(sign, _mm_set1_ps(-0.f)));
+    }
+
+    template<typename T>
+    static void DecodeOctahedral(T* pData, size_t count, size_t stride)
+    {
+        const size_t elementStride = stride / sizeof(T);
+        const float  maxValue      = static_cast<float>((1 << (sizeof(T) * 8 - 1)) - 1);
+
+        // 4 elements at a time, tail elements are handled by a zero-padded final batch
+        alignas(16) float   x[4], y[4], z[4];
+        alignas(16) int32_t xi[4], yi[4], zi[4];
+        for (size_t i = 0; i < count; i += 4)
+        {
+            const size_t batchCount = (count - i < 4) ? count - i : 4;
+            for (size_t j = 0; j < 4; ++j)
+            {
+                const T* pElement = pData + (i + (j < batchCount ? j : 0)) * elementStride;
+                x[j] = static_cast<float>(pElement[0]);
+                y[j] = static_cast<float>(pElement[1]);
+                z[j] = static_cast<float>(pElement[2]);
+            }
+
+            // Reconstruct z (z is stored as 1 at the same scale) and unfold the octahedron where z < 0
+            __m128 vx = _mm_load_ps(x);
+            __m128 vy = _mm_load_ps(y);
+            __m128 vz = _mm_sub_ps(_mm_sub_ps(_mm_load_ps(z), Abs(vx)), Abs(vy));
+            __m128 t  = _mm_min_ps(vz, _mm_setzero_ps());
+            vx = _mm_add_ps(vx, MultiplySign(t, vx));
+            vy = _mm_add_ps(vy, MultiplySign(t, vy));
+
+            // Normalize and scale back to the integer range
+            __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz)));
+            __m128 scale  = _mm_div_ps(_mm_set1_ps(maxValue), length);
+            _mm_store_si128(reinterpret_cast<__m128i*>(xi), RoundToInt(_mm_mul_ps(vx, scale)));
+            _mm_store_si128(reinterpret_cast<__m128i*>(yi), RoundToInt(_mm_mul_ps(vy, scale)));
+            _mm_store_si128(reinterpret_cast<__m128i*>(zi), RoundToInt(_mm_mul_ps(vz, scale)));
+
+            for (size_t j = 0; j < batchCount; ++j)
+            {
+                T* pElement = pData + (i + j) * elementStride;
+                pElement[0] = static_cast<T>(xi[j]);
+                pElement[1] = static_cast<T>(yi[j]);
+                pElement[2] = static_cast<T>(zi[j]);
+            }
+        }
+    }
+
+    void DecodeMeshoptOctahedralFilter(void* pData, size_t count, size_t stride)
+    {
+        if (stride == 4)
+            DecodeOctahedral(static_cast<int8_t*>(pData), count, stride);
+        else
+            DecodeOctahedral(static_cast<int16_t*>(pData), count, stride);
+    }
+
+    void DecodeMeshoptQuaternionFilter(void* pData, size_t count, size_t stride)
+    {
+        int16_t*     pQuats        = static_cast<int16_t*>(pData);
+        const size_t elementStride = stride / sizeof(int16_t);
+        const float  scale         = 1.f / sqrtf(2.f);
+
+        // 4 quaternions at a time, tail elements are handled by a zero-padded final batch
+        alignas(16) float   x[4], y[4], z[4], s[4];
+        alignas(16) int32_t xi[4], yi[4], zi[4], wi[4];
+        for (size_t i = 0; i < count; i += 4)
+        {
+            const size_t batchCount = (count - i < 4) ? count - i : 4;
+            for (size_t j = 0; j < 4; ++j)
+            {
+                const int16_t* pElement = pQuats + (i + (j < batchCount ? j : 0)) * elementStride;
+                x[j] = static_cast<float>(pElement[0]);
+                y[j] = static_cast<float>(pElement[1]);
+                z[j] = static_cast<float>(pElement[2]);
+                s[j] = static_cast<float>(pElement[3] | 3);  // The scale is stored in the high bits of the last component
+            }
+
+            // Rescale the 3 stored components to [-1/sqrt(2), 1/sqrt(2)] and reconstruct the largest one
+            __m128 ss = _mm_div_ps(_mm_set1_ps(scale), _mm_load_ps(s));
+            __m128 vx = _mm_mul_ps(_mm_load_ps(x), ss);
+            __m128 vy = _mm_mul_ps(_mm_load_ps(y), ss);
+            __m128 vz = _mm_mul_ps(_mm_load_ps(z), ss);
+            __m128 ww = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.f), _mm_mul_ps(vx, vx)), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+            __m128 vw = _mm_sqrt_ps(_mm_max_ps(ww, _mm_setzero_ps()));
+
+            const __m128 maxValue = _mm_set1_ps(32767.f);
+            _mm_store_si128(reinterpret_cast<__m128i*>(xi), RoundToInt(_mm_mul_ps(vx, maxValue)));
+            _mm_store_si128(reinterpret_cast<__m128i*>(yi), RoundToInt(_mm_mul_ps(vy, maxValue)));
+            _mm_store_si128(reinterpret_cast<__m128i*>(zi), RoundToInt(_mm_mul_ps(vz, maxValue)));
+            _mm_store_si128(reinterpret_cast<__m128i*>(wi), RoundToInt(_mm_mul_ps(vw, maxValue)));
+
+            // The low bits of the last component hold the index of the reconstructed component
+            for (size_t j = 0; j < batchCount; ++j)
+            {
+                int16_t* pElement = pQuats + (i + j) * elementStride;
+                const int qc = pElement[3] & 3;
+                pElement[(qc + 1) & 3] = static_cast<int16_t>(xi[j]);
+                pElement[(qc + 2) & 3] = static_cast<int16_t>(yi[j]);
+                pElement[(qc + 3) & 3] = static_cast<int16_t>(zi[j]);
+                pElement[(qc + 0) & 3] = static_cast<int16_t>(wi[j]);
+            }
+        }
+    }
+
+    void DecodeMeshoptExponentialFilter(void* pData, size_t count, size_t stride)
+    {
+        // Each 32-bit value holds a 24-bit signed mantissa and 8-bit signed exponent
+        uint32_t*    pValues    = static_cast<uint32_t*>(pData);
+        const size_t valueCount = count * (stride / sizeof(uint32_t));
+
+        size_t i = 0;
+        for (; i + 4 <= valueCount; i += 4)
+        {
+            __m128i values   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pValues + i));
+            __m128i mantissa = _mm_srai_epi32(_mm_slli_epi32(values, 8), 8);
+            __m128i exponent = _mm_srai_epi32(values, 24);
+            __m128  scale    = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(exponent, _mm_set1_epi32(127)), 23));
+            _mm_storeu_ps(reinterpret_cast<float*>(pValues + i), _mm_mul_ps(_mm_cvtepi32_ps(mantissa), scale));
+        }
+
+        for (; i < valueCount; ++i)
+        {
+            const int32_t mantissa = static_cast<int32_t>(pValues[i] << 8) >> 8;
+            const int32_t exponent = static_cast<int32_t>(pValues[i]) >> 24;
+
+            float scale;
+            const uint32_t scaleBits = static_cast<uint32_t>(exponent + 127) << 23;
+            memcpy(&scale, &scaleBits, sizeof(scale));
+
+            const float value = static_cast<float>(mantissa) * scale;
+            memcpy(&pValues[i], &value, sizeof(value));
+        }
+    }
+
+} // namespace cauldron
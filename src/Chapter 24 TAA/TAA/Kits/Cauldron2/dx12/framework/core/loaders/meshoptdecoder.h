@@ -0,0 +1,89 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cauldron
+{
+    /// @defgroup CauldronMeshopt Meshopt decoding
+    /// Decoders for buffer views compressed with the EXT_meshopt_compression glTF extension.
+    ///
+    /// @ingroup CauldronLoaders
+
+    /// Decodes a vertex buffer encoded with the meshopt vertex codec (ATTRIBUTES mode).
+    ///
+    /// @param [out] pDst           Destination memory (vertexCount * vertexSize bytes).
+    /// @param [in]  vertexCount    Number of vertices to decode.
+    /// @param [in]  vertexSize     Size of a vertex in bytes (multiple of 4, at most 256).
+    /// @param [in]  pSrc           Encoded data.
+    /// @param [in]  srcSize        Size of the encoded data in bytes.
+    ///
+    /// @returns True if the data was decoded successfully.
+    ///
+    /// @ingroup CauldronMeshopt
+    bool DecodeMeshoptVertexBuffer(void* pDst, size_t vertexCount, size_t vertexSize, const uint8_t* pSrc, size_t srcSize);
+
+    /// Decodes a triangle list index buffer encoded with the meshopt index codec (TRIANGLES mode).
+    ///
+    /// @param [out] pDst           Destination memory (indexCount * indexSize bytes).
+    /// @param [in]  indexCount     Number of indices to decode (multiple of 3).
+    /// @param [in]  indexSize      Size of an index in bytes (2 or 4).
+    /// @param [in]  pSrc           Encoded data.
+    /// @param [in]  srcSize        Size of the encoded data in bytes.
+    ///
+    /// @returns True if the data was decoded successfully.
+    ///
+    /// @ingroup CauldronMeshopt
+    bool DecodeMeshoptIndexBuffer(void* pDst, size_t indexCount, size_t indexSize, const uint8_t* pSrc, size_t srcSize);
+
+    /// Decodes an index sequence encoded with the meshopt index sequence codec (INDICES mode).
+    ///
+    /// @param [out] pDst           Destination memory (indexCount * indexSize bytes).
+    /// @param [in]  indexCount     Number of indices to decode.
+    /// @param [in]  indexSize      Size of an index in bytes (2 or 4).
+    /// @param [in]  pSrc           Encoded data.
+    /// @param [in]  srcSize        Size of the encoded data in bytes.
+    ///
+    /// @returns True if the data was decoded successfully.
+    ///
+    /// @ingroup CauldronMeshopt
+    bool DecodeMeshoptIndexSequence(void* pDst, size_t indexCount, size_t indexSize, const uint8_t* pSrc, size_t srcSize);
+
+    /// Applies the meshopt OCTAHEDRAL filter in place (4 or 8 byte elements of signed normalized x, y, z and w).
+    ///
+    /// @ingroup CauldronMeshopt
+    void DecodeMeshoptOctahedralFilter(void* pData, size_t count, size_t stride);
+
+    /// Applies the meshopt QUATERNION filter in place (8 byte elements of signed normalized x, y, z and w).
+    ///
+    /// @ingroup CauldronMeshopt
+    void DecodeMeshoptQuaternionFilter(void* pData, size_t count, size_t stride);
+
+    /// Applies the meshopt EXPONENTIAL filter in place (elements made of 32-bit floats).
+    ///
+    /// @ingroup CauldronMeshopt
+    void DecodeMeshoptExponentialFilter(void* pData, size_t count, size_t stride);
+
+} // namespace cauldron
@@ -22,10 +22,12 @@
 
 #include "textureloader.h"
 #include "../contentmanager.h"
+#include "../iomanager.h"
 #include "../taskmanager.h"
 #include "../framework.h"
 #include "../../misc/assert.h"
 #include "../../misc/fileio.h"
+#include "../../misc/hash.h"
 #include "../../render/device.h"
 #include "../../render/gpuresource.h"
 
@@ -51,9 +53,8 @@ namespace cauldron
         // manager once fully initialized and call the requester' callback
         TaskCompletionCallback* pLoadCompleteCallback = new TaskCompletionCallback(Task(&TextureLoader::AsyncLoadCompleteCallback, pTexLoadData), 1);
 
-        // Enqueue the task to load content
-        Task loadingTask(&TextureLoader::LoadTextureContent, &pTexLoadData->LoadInfo[0], pLoadCompleteCallback);
-        GetTaskManager()->AddTask(loadingTask);
+        // Enqueue the read of the texture file, content will be loaded once the data is available
+        ReadTextureFiles(pTexLoadData, pLoadCompleteCallback);
     }
 
     void TextureLoader::LoadMultipleAsync(void* pLoadParams)
@@ -67,24 +68,63 @@ namespace cauldron
         // Create a task completion callback to call in order to call the requester' callback
         TaskCompletionCallback* pLoadCompleteCallback = new TaskCompletionCallback(Task(&TextureLoader::AsyncLoadCompleteCallback, pTexLoadData), static_cast<uint32_t>(pTexLoadData->LoadInfo.size()));
 
-        // Enqueue a task per texture to load the content
-        std::queue<Task> taskList;
+        // Enqueue the reads of all texture files, content will be loaded as the data becomes available
+        ReadTextureFiles(pTexLoadData, pLoadCompleteCallback);
+    }
+
+    void TextureLoader::ReadTextureFiles(TextureLoadParams* pTexLoadData, TaskCompletionCallback* pLoadCompleteCallback)
+    {
+        // Each read will kick a task to load the texture content once the file data is available
+        std::vector<FileReadRequest*> readList;
+        readList.reserve(pTexLoadData->LoadInfo.size());
         for (size_t i = 0; i < pTexLoadData->LoadInfo.size(); ++i)
         {
-            taskList.push(Task(&TextureLoader::LoadTextureContent, &pTexLoadData->LoadInfo[i], pLoadCompleteCallback));
+            TextureFileLoadParams* pFileLoadParams = new TextureFileLoadParams();
+            pFileLoadParams->pLoadInfo = &pTexLoadData->LoadInfo[i];
+            pFileLoadParams->pFileRead = new FileReadRequest(pFileLoadParams->pLoadInfo->TextureFile.c_str(), Task(&TextureLoader::LoadTextureContent, pFileLoadParams, pLoadCompleteCallback));
+
+            // Textures already in memory don't need to go through the I/O manager
+            const TextureLoadInfo& loadInfo = *pFileLoadParams->pLoadInfo;
+            if (loadInfo.pTextureData != nullptr)
+            {
+                pFileLoadParams->pFileRead->Data.assign(loadInfo.pTextureData, loadInfo.pTextureData + loadInfo.TextureDataSize);
+                pFileLoadParams->pFileRead->BytesRead = static_cast<int64_t>(loadInfo.TextureDataSize);
+                GetTaskManager()->AddTask(pFileLoadParams->pFileRead->CompletionTask);
+                continue;
+            }
+
+            readList.push_back(pFileLoadParams->pFileRead);
         }
-        GetTaskManager()->AddTaskList(taskList);
+
+        if (!readList.empty())
+            GetIOManager()->ReadFilesAsync(readList);
     }
 
     // Handler to load texture resources
     void TextureLoader::LoadTextureContent(void* pParam)
     {
-        TextureLoadInfo& loadInfo = *reinterpret_cast<TextureLoadInfo*>(pParam);
+        TextureFileLoadParams* pFileLoadParams = reinterpret_cast<TextureFileLoadParams*>(pParam);
+        TextureLoadInfo& loadInfo = *pFileLoadParams->pLoadInfo;
+        FileReadRequest* pFileRead = pFileLoadParams->pFileRead;
+
+        bool fileRead = pFileRead->BytesRead >= 0;
+        CauldronAssert(ASSERT_ERROR, fileRead, L"Could not read texture file %ls. Please run ClearMediaCache.bat followed by UpdateMedia.bat to sync to latest media.", loadInfo.TextureFile.c_str());
 
-        bool fileExists = filesystem::exists(loadInfo.TextureFile);
-        CauldronAssert(ASSERT_ERROR, fileExists, L"Could not find texture file %ls. Please run ClearMediaCache.bat followed by UpdateMedia.bat to sync to latest media.", loadInfo.TextureFile.c_str());
+        // Identical source data loaded with the same options (possibly through another path) can reuse the already loaded texture
+        uint64_t contentHash = 0;
+        bool     alreadyLoaded = false;
+        if (fileRead)
+        {
+            uint32_t alphaThresholdBits;
+            memcpy(&alphaThresholdBits, &loadInfo.AlphaThreshold, sizeof(alphaThresholdBits));
+            const uint64_t optionsSeed = (static_cast<uint64_t>(alphaThresholdBits) << 32) | (static_cast<uint64_t>(loadInfo.Flags) << 1) | (loadInfo.SRGB ? 1 : 0);
+            contentHash = HashData64(pFileRead->Data.data(), pFileRead->Data.size(), optionsSeed);
+
+            if (GetContentManager()->AcquireTexture(contentHash, loadInfo.TextureFile.c_str(), pFileRead->Data.size()) != nullptr)
+                alreadyLoaded = true;
+        }
 
-        if (fileExists)
+        if (fileRead && !alreadyLoaded)
         {
             TextureDesc texDesc = {};
 
@@ -97,7 +137,7 @@ namespace cauldron
             else
                 pTextureData = new WICTextureDataBlock();
 
-            bool loaded = pTextureData->LoadTextureData(loadInfo.TextureFile, loadInfo.AlphaThreshold, texDesc);
+            bool loaded = pTextureData->LoadTextureData(pFileRead->Data, loadInfo.AlphaThreshold, texDesc);
 
             CauldronAssert(ASSERT_ERROR, loaded, L"Could not load texture %ls (TextureDataBlock::LoadTextureData() failed)", loadInfo.TextureFile.c_str());
             if (loaded)
@@ -119,7 +159,7 @@ namespace cauldron
                     pNewTexture->CopyData(pTextureData);
 
                     // Start managing the texture at this point
-                    bool emplaced = GetContentManager()->StartManagingContent(texDesc.Name, pNewTexture);
+                    bool emplaced = GetContentManager()->StartManagingContent(texDesc.Name, pNewTexture, contentHash);
 
                     // If it was emplaced, need to queue it up for a transition during the first graphics cmd list
                     if (emplaced)
@@ -139,6 +179,10 @@ namespace cauldron
 
             delete pTextureData;
         }
+
+        // Done with this memory
+        delete pFileRead;
+        delete pFileLoadParams;
     }
 
     // Completion handler to call when texture loads are all complete
@@ -289,6 +333,23 @@ namespace cauldron
         if (!m_pData)
             return false;
 
+        return InitTextureDesc(alphaThreshold, texDesc);
+    }
+
+    bool WICTextureDataBlock::LoadTextureData(std::vector<char>& fileData, float alphaThreshold, TextureDesc& texDesc)
+    {
+        int32_t channels;
+        m_pData = reinterpret_cast<char*>(stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(fileData.data()), static_cast<int32_t>(fileData.size()),
+                                                                reinterpret_cast<int32_t*>(&texDesc.Width), reinterpret_cast<int32_t*>(&texDesc.Height), &channels, STBI_rgb_alpha));
+
+        if (!m_pData)
+            return false;
+
+        return InitTextureDesc(alphaThreshold, texDesc);
+    }
+
+    bool WICTextureDataBlock::InitTextureDesc(float alphaThreshold, TextureDesc& texDesc)
+    {
         // Compute number of mips
         uint32_t mipWidth = texDesc.Width;
         uint32_t mipHeight = texDesc.Height;
@@ -479,64 +540,41 @@ namespace cauldron
         }
     }
 
-    // DDSTextureDataBlock Implementation (Uses DDS loader)
-    DDSTextureDataBlock::~DDSTextureDataBlock()
+    typedef enum RESOURCE_DIMENSION
     {
-        delete m_pData;
-    }
-
-    bool DDSTextureDataBlock::LoadTextureData(filesystem::path& textureFile, float alphaThreshold, TextureDesc& texDesc)
+        RESOURCE_DIMENSION_UNKNOWN = 0,
+        RESOURCE_DIMENSION_BUFFER = 1,
+        RESOURCE_DIMENSION_TEXTURE1D = 2,
+        RESOURCE_DIMENSION_TEXTURE2D = 3,
+        RESOURCE_DIMENSION_TEXTURE3D = 4
+    } RESOURCE_DIMENSION;
+
+    typedef struct
     {
-        typedef enum RESOURCE_DIMENSION
-        {
-            RESOURCE_DIMENSION_UNKNOWN = 0,
-            RESOURCE_DIMENSION_BUFFER = 1,
-            RESOURCE_DIMENSION_TEXTURE1D = 2,
-            RESOURCE_DIMENSION_TEXTURE2D = 3,
-            RESOURCE_DIMENSION_TEXTURE3D = 4
-        } RESOURCE_DIMENSION;
-
-        typedef struct
-        {
-            DXGI_FORMAT         dxgiFormat;
-            RESOURCE_DIMENSION  resourceDimension;
-            UINT32              miscFlag;
-            UINT32              arraySize;
-            UINT32              reserved;
-        } DDS_HEADER_DXT10;
+        DXGI_FORMAT         dxgiFormat;
+        RESOURCE_DIMENSION  resourceDimension;
+        UINT32              miscFlag;
+        UINT32              arraySize;
+        UINT32              reserved;
+    } DDS_HEADER_DXT10;
 
-        // Get the file size
-        int64_t fileSize = GetFileSize(textureFile.c_str());
-        int64_t rawTextureSize = fileSize;
-        if (fileSize == -1)
-        {
-            CauldronError(L"Could not get file size of %ls", textureFile.c_str());
-            return false;
-        }
+    constexpr int32_t c_DDS_HEADER_SIZE = 4 + sizeof(DDS_HEADER) + sizeof(DDS_HEADER_DXT10);
 
-        // read the header
-        constexpr size_t c_HEADER_ALIGNMENT = alignof(uint32_t);
-        constexpr int32_t c_HEADER_SIZE = 4 + sizeof(DDS_HEADER) + sizeof(DDS_HEADER_DXT10);
-        alignas(c_HEADER_ALIGNMENT) char headerData[c_HEADER_SIZE];
-        uint32_t bytesRead = 0;
-
-        int64_t sizeRead = ReadFilePartial(textureFile.c_str(), headerData, c_HEADER_SIZE);
-        if (sizeRead != c_HEADER_SIZE)
-        {
-            CauldronError(L"Error reading texture header data for file %ls", textureFile.c_str());
-            return false;
-        }
+    // Parses the DDS header (c_DDS_HEADER_SIZE bytes) and returns the size of the texture data following it
+    int64_t ParseDDSHeader(const char* pHeaderData, int64_t fileSize, TextureDesc& texDesc)
+    {
+        int64_t rawTextureSize = fileSize;
 
-        char* pByteData = headerData;
-        uint32_t magicNumber = *reinterpret_cast<uint32_t*>(pByteData);
+        const char* pByteData = pHeaderData;
+        uint32_t magicNumber = *reinterpret_cast<const uint32_t*>(pByteData);
         CauldronAssert(ASSERT_ERROR, magicNumber == ' SDD', L"DDSLoader could not find DDS indicator in header info");
         if (magicNumber != ' SDD')   // "DDS "
-            return false;
+            return -1;
 
         pByteData += 4;
         rawTextureSize -= 4;
 
-        DDS_HEADER* pHeader = reinterpret_cast<DDS_HEADER*>(pByteData);
+        const DDS_HEADER* pHeader = reinterpret_cast<const DDS_HEADER*>(pByteData);
         pByteData += sizeof(DDS_HEADER);
         rawTextureSize -= sizeof(DDS_HEADER);
 
@@ -548,7 +586,7 @@ namespace cauldron
 
         if (pHeader->ddspf.fourCC == '01XD')
         {
-            DDS_HEADER_DXT10* pHeader10 = reinterpret_cast<DDS_HEADER_DXT10*>((char*)pHeader + sizeof(DDS_HEADER));
+            const DDS_HEADER_DXT10* pHeader10 = reinterpret_cast<const DDS_HEADER_DXT10*>((const char*)pHeader + sizeof(DDS_HEADER));
             rawTextureSize -= sizeof(DDS_HEADER_DXT10);
 
             // Surface format
@@ -593,12 +631,49 @@ namespace cauldron
             texDesc.Format = GetResourceFormat(pHeader->ddspf);
         }
 
+        return rawTextureSize;
+    }
+
+    // DDSTextureDataBlock Implementation (Uses DDS loader)
+    DDSTextureDataBlock::~DDSTextureDataBlock()
+    {
+        // Data is only owned separately when it isn't backed by the file's contents
+        if (m_FileData.empty())
+            delete[] m_pData;
+    }
+
+    bool DDSTextureDataBlock::LoadTextureData(filesystem::path& textureFile, float alphaThreshold, TextureDesc& texDesc)
+    {
+        // Get the file size
+        int64_t fileSize = GetFileSize(textureFile.c_str());
+        if (fileSize == -1)
+        {
+            CauldronError(L"Could not get file size of %ls", textureFile.c_str());
+            return false;
+        }
+
+        // read the header
+        constexpr size_t c_HEADER_ALIGNMENT = alignof(uint32_t);
+        alignas(c_HEADER_ALIGNMENT) char headerData[c_DDS_HEADER_SIZE];
+
+        int64_t sizeRead = ReadFilePartial(textureFile.c_str(), headerData, c_DDS_HEADER_SIZE);
+        if (sizeRead != c_DDS_HEADER_SIZE)
+        {
+            CauldronError(L"Error reading texture header data for file %ls", textureFile.c_str());
+            return false;
+        }
+
+        int64_t rawTextureSize = ParseDDSHeader(headerData, fileSize, texDesc);
+        if (rawTextureSize < 0)
+            return false;
+
         // Read in the data representing the texture (remainder of the file after the header)
         m_pData = new char[rawTextureSize];
         sizeRead = ReadFilePartial(textureFile.c_str(), m_pData, rawTextureSize, fileSize - rawTextureSize);
         if (sizeRead != rawTextureSize)
         {
             delete[](m_pData);
+            m_pData = nullptr;
             CauldronError(L"Error reading texture data for file %ls", textureFile.c_str());
             return false;
         }
@@ -606,6 +681,26 @@ namespace cauldron
         return true;
     }
 
+    bool DDSTextureDataBlock::LoadTextureData(std::vector<char>& fileData, float alphaThreshold, TextureDesc& texDesc)
+    {
+        const int64_t fileSize = static_cast<int64_t>(fileData.size());
+        if (fileSize < c_DDS_HEADER_SIZE)
+        {
+            CauldronError(L"Error reading texture header data (file too small)");
+            return false;
+        }
+
+        int64_t rawTextureSize = ParseDDSHeader(fileData.data(), fileSize, texDesc);
+        if (rawTextureSize < 0)
+            return false;
+
+        // Texture data is the remainder of the file after the header, keep the file's contents around to back it
+        m_FileData = std::move(fileData);
+        m_pData = m_FileData.data() + (fileSize - rawTextureSize);
+
+        return true;
+    }
+
     void DDSTextureDataBlock::CopyTextureData(void* pDest, uint32_t stride, uint32_t bytesWidth, uint32_t height, uint32_t readOffset)
     {
         for (uint32_t y = 0; y < height; ++y)
@@ -624,6 +719,12 @@ namespace cauldron
         return false;
     }
 
+    bool MemTextureDataBlock::LoadTextureData(std::vector<char>& fileData, float alphaThreshold, TextureDesc& texDesc)
+    {
+        CauldronError(L"MemTextureDataBlock does not support calls to LoadTextureData.");
+        return false;
+    }
+
     void MemTextureDataBlock::CopyTextureData(void* pDest, uint32_t stride, uint32_t bytesWidth, uint32_t height, uint32_t readOffset)
     {
         for (uint32_t y = 0; y < height; ++y)
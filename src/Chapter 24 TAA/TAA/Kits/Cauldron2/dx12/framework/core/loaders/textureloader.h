@@ -33,6 +33,9 @@
 
 namespace cauldron
 {
+    struct FileReadRequest;
+    struct TaskCompletionCallback;
+
     /**
      * @typedef TextureLoadCompletionCallbackFn
      *
@@ -55,6 +58,8 @@ namespace cauldron
         bool                                SRGB = true;                    ///< If we need this to be in SRGB format.
         float                               AlphaThreshold = 1.f;           ///< Alpha threshold for alpha generation.
         ResourceFlags                       Flags = ResourceFlags::None;    ///< <c><i>ResourceFlags</i></c> for the loaded <c><i>Texture</i></c>.
+        const char*                         pTextureData = nullptr;         ///< Optional in-memory texture file data to load from instead of reading TextureFile (must remain valid until the load completes).
+        size_t                              TextureDataSize = 0;            ///< Size (in bytes) of the in-memory texture file data.
 
         TextureLoadInfo(std::experimental::filesystem::path file, bool srgb = true, float alphaThreshold = 1.f, ResourceFlags flags = ResourceFlags::None) : TextureFile(file), SRGB(srgb), AlphaThreshold(alphaThreshold), Flags(flags) {};
     };
@@ -91,6 +96,12 @@ namespace cauldron
          */
         virtual bool LoadTextureData(std::experimental::filesystem::path& textureFile, float alphaThreshold, TextureDesc& texDesc) = 0;
 
+        /**
+         * @brief   Loads the texture data from the file's contents (already read to memory) according to the DataBlock type.
+         *          The DataBlock may take ownership of the file data.
+         */
+        virtual bool LoadTextureData(std::vector<char>& fileData, float alphaThreshold, TextureDesc& texDesc) = 0;
+
         /**
          * @brief   Copies the texture data to the resource's backing memory.
          */
@@ -121,13 +132,18 @@ namespace cauldron
          */
         virtual bool LoadTextureData(std::experimental::filesystem::path& textureFile, float alphaThreshold, TextureDesc& texDesc) override;
 
-        
+        /**
+         * @brief   Loads the texture data from the file's contents according to the DataBlock type.
+         */
+        virtual bool LoadTextureData(std::vector<char>& fileData, float alphaThreshold, TextureDesc& texDesc) override;
+
         /**
          * @brief   Copies the texture data to the resource's backing memory. Will also generate mip-chain.
          */
         virtual void CopyTextureData(void* pDest, uint32_t stride, uint32_t widthStride, uint32_t height, uint32_t sliceOffset) override;
 
     private:
+        bool InitTextureDesc(float alphaThreshold, TextureDesc& texDesc);
         float GetAlphaCoverage(uint32_t width, uint32_t height, float scale, uint32_t alphaThreshold) const;
         void ScaleAlpha(uint32_t width, uint32_t height, float scale);
         void MipImage(uint32_t width, uint32_t height);
@@ -156,13 +172,20 @@ namespace cauldron
          */
         virtual bool LoadTextureData(std::experimental::filesystem::path& textureFile, float alphaThreshold, TextureDesc& texDesc) override;
 
+        /**
+         * @brief   Loads the texture data from the file's contents according to the DataBlock type.
+         *          Takes ownership of the file data to avoid copying the texture payload.
+         */
+        virtual bool LoadTextureData(std::vector<char>& fileData, float alphaThreshold, TextureDesc& texDesc) override;
+
         /**
          * @brief   Copies the texture data to the resource's backing memory.
          */
         virtual void CopyTextureData(void* pDest, uint32_t stride, uint32_t widthStride, uint32_t height, uint32_t sliceOffset) override;
 
     private:
-        char* m_pData = nullptr;
+        char*               m_pData = nullptr;
+        std::vector<char>   m_FileData = {};    // Backs m_pData when loaded from memory
     };
 
     /**
@@ -184,6 +207,12 @@ namespace cauldron
          */
         virtual bool LoadTextureData(std::experimental::filesystem::path& textureFile, float alphaThreshold, TextureDesc& texDesc) override;
 
+        /**
+         * @brief   As the MemTextureDataBlock is backed by memory already, LoadTextureData does nothing and should not be called.
+         *          This function will assert if called.
+         */
+        virtual bool LoadTextureData(std::vector<char>& fileData, float alphaThreshold, TextureDesc& texDesc) override;
+
         /**
          * @brief   Copies the texture data to the resource's backing memory.
          */
@@ -227,6 +256,14 @@ namespace cauldron
         virtual void LoadMultipleAsync(void* pLoadParams) override;
 
     private:
+        // Parameter struct for a single texture's load (file data is read by the I/O manager ahead of decoding)
+        struct TextureFileLoadParams
+        {
+            TextureLoadInfo* pLoadInfo = nullptr;
+            FileReadRequest* pFileRead = nullptr;
+        };
+
+        static void ReadTextureFiles(TextureLoadParams* pTexLoadData, TaskCompletionCallback* pLoadCompleteCallback);
         static void LoadTextureContent(void* pParam);
         static void AsyncLoadCompleteCallback(void* pParam);
     };
@@ -24,11 +24,91 @@
 #include "contentmanager.h"
 #include "framework.h"
 #include "../misc/assert.h"
+#include "../misc/log.h"
+#include "../misc/poolallocator.h"
+#include "../misc/workstealingdeque.h"
+#include "../render/profiler.h"
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
+#include <memory>
 
 namespace cauldron
 {
+    struct TaskManager::WorkerQueues
+    {
+        WorkStealingDeque<Task*> Deques[static_cast<uint32_t>(TaskPriority::Count)];
+    };
+
+    // Identifies pool threads so tasks they spawn go to their own deques
+    static thread_local const TaskManager* s_pWorkerOwner = nullptr;
+    static thread_local uint32_t           s_WorkerIndex  = 0;
+
+    // Shared by the caller and helper tasks of a ParallelForRange call. Helpers that only start once all
+    // items are done still touch the state, so it is reference counted and returned to a pool by the last user.
+    struct ParallelForState
+    {
+        const InlineFunction<void(uint32_t, uint32_t)>* pRangeFunc = nullptr;
+        uint32_t                                        ItemCount  = 0;
+        uint32_t                                        GrainSize  = 1;
+        std::atomic_uint32_t                            NextItem       = { 0 };
+        std::atomic_uint32_t                            CompletedItems = { 0 };
+        std::atomic_uint32_t                            ThreadCount    = { 0 };
+        std::atomic_uint32_t                            RefCount       = { 1 };
+
+        static void* operator new(size_t size) { return PoolAllocator<ParallelForState>::Allocate(); }
+        static void operator delete(void* pMem) { PoolAllocator<ParallelForState>::Free(pMem); }
+
+        void Run()
+        {
+            uint32_t begin = NextItem.fetch_add(GrainSize);
+            if (begin >= ItemCount)
+                return;
+
+            ++ThreadCount;
+            for (; begin < ItemCount; begin = NextItem.fetch_add(GrainSize))
+            {
+                const uint32_t end = std::min<uint32_t>(begin + GrainSize, ItemCount);
+                (*pRangeFunc)(begin, end);
+                CompletedItems += end - begin;
+            }
+        }
+
+        void Release()
+        {
+            if (--RefCount == 0)
+                delete this;
+        }
+    };
+
+    static uint64_t GetSubmitTicks()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void* Task::operator new(size_t size)
+    {
+        CauldronAssert(ASSERT_CRITICAL, size == sizeof(Task), L"Task pool only serves Task objects");
+        return PoolAllocator<Task>::Allocate();
+    }
+
+    void Task::operator delete(void* pMem)
+    {
+        PoolAllocator<Task>::Free(pMem);
+    }
+
+    void* TaskCompletionCallback::operator new(size_t size)
+    {
+        CauldronAssert(ASSERT_CRITICAL, size == sizeof(TaskCompletionCallback), L"Completion callback pool only serves TaskCompletionCallback objects");
+        return PoolAllocator<TaskCompletionCallback>::Allocate();
+    }
+
+    void TaskCompletionCallback::operator delete(void* pMem)
+    {
+        PoolAllocator<TaskCompletionCallback>::Free(pMem);
+    }
+
     TaskManager::TaskManager()
     {
     }
@@ -39,10 +119,13 @@ namespace cauldron
 
     int32_t TaskManager::Init(uint32_t threadPoolSize)
     {
-        std::function<void()> pTaskHandler = [this]() { this->TaskExecutor(); };
+        // All queues must exist before any worker can try to steal from them
+        m_pInjectedQueues = new WorkerQueues();
+        for (uint32_t i = 0; i < threadPoolSize; ++i)
+            m_WorkerQueues.push_back(new WorkerQueues());
 
         for (uint32_t i = 0; i < threadPoolSize; ++i)
-            m_ThreadPool.emplace_back(pTaskHandler);
+            m_ThreadPool.emplace_back([this, i]() { this->TaskExecutor(i); });
 
         return 0;
     }
@@ -54,9 +137,9 @@ namespace cauldron
 
         // Flag all threads to shutdown
         {
-            std::unique_lock<std::mutex> lock(m_CriticalSection);
+            std::unique_lock<std::mutex> lock(m_SleepMutex);
             m_ShuttingDown = true;
-            m_QueueCondition.notify_all();
+            m_WakeCondition.notify_all();
         }
 
         // Wait for all threads to be done
@@ -66,71 +149,270 @@ namespace cauldron
             iter->join();
             iter = m_ThreadPool.erase(iter);
         }
-    }
 
-    void TaskManager::AddTask(Task& newTask) 
-    { 
-        std::unique_lock<std::mutex> lock(m_CriticalSection);
-        m_TaskQueue.push(std::move(newTask));
+        // Release anything that never got to run
+        for (WorkerQueues* pWorkerQueues : m_WorkerQueues)
+        {
+            for (auto& deque : pWorkerQueues->Deques)
+            {
+                while (Task* pTask = deque.Pop())
+                    delete pTask;
+            }
+            delete pWorkerQueues;
+        }
+        m_WorkerQueues.clear();
+
+        for (auto& deque : m_pInjectedQueues->Deques)
+        {
+            while (Task* pTask = deque.Pop())
+                delete pTask;
+        }
+        delete m_pInjectedQueues;
+        m_pInjectedQueues = nullptr;
 
-        // Wake a single thread to pick up the task
-        m_QueueCondition.notify_one();
+        const TaskManagerStats stats = GetStats();
+        const uint64_t frameCount = std::max<uint64_t>(1, GetFramework()->GetFrameID());
+        Log::Write(LOGLEVEL_TRACE, L"TaskManager: %llu tasks submitted, %.1f ns average submission latency, %llu heap allocations (%.3f per frame).",
+                   stats.SubmittedTasks, stats.SubmittedTasks ? stats.SubmitSeconds * 1e9 / stats.SubmittedTasks : 0.0,
+                   stats.HeapAllocations, static_cast<double>(stats.HeapAllocations) / frameCount);
+    }
+
+    void TaskManager::AddTask(Task& newTask)
+    {
+        const uint64_t startTicks = GetSubmitTicks();
+        QueueTask(new Task(std::move(newTask)));
+        WakeWorkers(false);
+        m_SubmitTicks += GetSubmitTicks() - startTicks;
     }
 
     void TaskManager::AddTaskList(std::queue<Task>& newTaskList)
     {
-        std::unique_lock<std::mutex> lock(m_CriticalSection);
+        const uint64_t startTicks = GetSubmitTicks();
+
+        // Queue in batches so tasks from outside the pool take the injection lock once per batch
+        static constexpr uint32_t s_BatchSize = 64;
+        Task* pBatch[s_BatchSize];
         while (newTaskList.size())
         {
-            m_TaskQueue.push(std::move(newTaskList.front()));
-            newTaskList.pop();
+            uint32_t batchCount = 0;
+            for (; batchCount < s_BatchSize && newTaskList.size(); ++batchCount)
+            {
+                pBatch[batchCount] = new Task(std::move(newTaskList.front()));
+                newTaskList.pop();
+            }
+            QueueTasks(pBatch, batchCount);
         }
 
         // Wake up all threads to pick up as many concurrent tasks as possible
-        m_QueueCondition.notify_all();
+        WakeWorkers(true);
+        m_SubmitTicks += GetSubmitTicks() - startTicks;
     }
 
-    // Runs for each thread and executes any waiting tasks when available
-    void TaskManager::TaskExecutor()
+    void TaskManager::SignalTaskCompletion(TaskCompletionCallback* pCompletionCallback)
     {
-        while (true)
+        if (--pCompletionCallback->TaskCount == 0)
         {
-            Task taskToExecute;
-            {
-                // Try to unload a task to execute
-                std::unique_lock<std::mutex> lock(m_CriticalSection);
-                m_QueueCondition.wait(lock, [this] { return !this->m_TaskQueue.empty() || m_ShuttingDown; });    // Sleep until a task is available to execute or we are shutting down
+            Task completionTask = std::move(pCompletionCallback->CompletionTask);
+            delete pCompletionCallback;
+            AddTask(completionTask);
+        }
+    }
+
+    TaskManagerStats TaskManager::GetStats() const
+    {
+        TaskManagerStats stats;
+        stats.SubmittedTasks  = m_SubmittedTasks.load();
+        stats.SubmitSeconds   = static_cast<double>(m_SubmitTicks.load()) * 1e-9;
+        stats.HeapAllocations = PoolAllocator<Task>::GetHeapAllocationCount() +
+                                PoolAllocator<TaskCompletionCallback>::GetHeapAllocationCount() +
+                                PoolAllocator<ParallelForState>::GetHeapAllocationCount() +
+                                TaskFunc::GetHeapFallbackCount();
+        return stats;
+    }
+
+    uint32_t TaskManager::ParallelFor(uint32_t itemCount, const InlineFunction<void(uint32_t)>& itemFunc)
+    {
+        return ParallelForRange(itemCount, 0, [&itemFunc](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i)
+                itemFunc(i);
+        });
+    }
+
+    uint32_t TaskManager::ParallelForRange(uint32_t itemCount, uint32_t grainSize, const InlineFunction<void(uint32_t, uint32_t)>& rangeFunc)
+    {
+        if (itemCount == 0)
+            return 0;
+
+        // By default, cut the work in a few ranges per thread so uneven items still balance out
+        const uint32_t threadCount = GetThreadCount() + 1;
+        if (grainSize == 0)
+            grainSize = std::max<uint32_t>(1, itemCount / (threadCount * 4));
 
-                if (m_ShuttingDown)
-                    break;
+        const uint32_t rangeCount  = DivideRoundingUp(itemCount, grainSize);
+        const uint32_t helperCount = std::min<uint32_t>(rangeCount - 1, GetThreadCount());
 
-                // Get the task (if not shutting down
-                taskToExecute = m_TaskQueue.front();
-                m_TaskQueue.pop();
+        // The range function is only invoked while items remain, which can't outlive this call
+        ParallelForState* pState = new ParallelForState();
+        pState->pRangeFunc = &rangeFunc;
+        pState->ItemCount  = itemCount;
+        pState->GrainSize  = grainSize;
+        pState->RefCount   = helperCount + 1;
+
+        if (helperCount > 0)
+        {
+            const uint64_t startTicks = GetSubmitTicks();
+            Task* pHelpers[64];
+            for (uint32_t queued = 0; queued < helperCount;)
+            {
+                const uint32_t batchCount = std::min<uint32_t>(helperCount - queued, 64);
+                for (uint32_t i = 0; i < batchCount; ++i)
+                    pHelpers[i] = new Task([pState](void*) { pState->Run(); pState->Release(); }, nullptr, nullptr, TaskPriority::High);
+                QueueTasks(pHelpers, batchCount);
+                queued += batchCount;
             }
+            WakeWorkers(helperCount > 1);
+            m_SubmitTicks += GetSubmitTicks() - startTicks;
+        }
+
+        pState->Run();
+        while (pState->CompletedItems.load() < itemCount)
+            std::this_thread::yield();
+
+        const uint32_t participatingThreads = pState->ThreadCount.load();
+        pState->Release();
+        return participatingThreads;
+    }
+
+    void TaskManager::QueueTask(Task* pTask)
+    {
+        QueueTasks(&pTask, 1);
+    }
+
+    void TaskManager::QueueTasks(Task** ppTasks, uint32_t taskCount)
+    {
+        // Count the tasks before they become visible so a worker taking one never sees the count go negative
+        m_PendingTasks   += static_cast<int32_t>(taskCount);
+        m_SubmittedTasks += taskCount;
+
+        if (s_pWorkerOwner == this)
+        {
+            WorkerQueues* pQueues = m_WorkerQueues[s_WorkerIndex];
+            for (uint32_t i = 0; i < taskCount; ++i)
+                pQueues->Deques[static_cast<uint32_t>(ppTasks[i]->Priority)].Push(ppTasks[i]);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(m_InjectionMutex);
+            for (uint32_t i = 0; i < taskCount; ++i)
+                m_pInjectedQueues->Deques[static_cast<uint32_t>(ppTasks[i]->Priority)].Push(ppTasks[i]);
+        }
+    }
+
+    void TaskManager::WakeWorkers(bool wakeAll)
+    {
+        // Workers register as sleeping before re-checking the pending count, so either they see the new task or we see them
+        if (m_SleepingWorkers.load() == 0)
+            return;
+
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        if (wakeAll)
+            m_WakeCondition.notify_all();
+        else
+            m_WakeCondition.notify_one();
+    }
+
+    Task* TaskManager::FindTask(uint32_t workerIndex)
+    {
+        const uint32_t workerCount = static_cast<uint32_t>(m_WorkerQueues.size());
+        for (uint32_t priority = 0; priority < static_cast<uint32_t>(TaskPriority::Count); ++priority)
+        {
+            // Own work first (most recent, likely hot in cache)
+            if (Task* pTask = m_WorkerQueues[workerIndex]->Deques[priority].Pop())
+                return pTask;
 
-            while (taskToExecute.pTaskFunction)
+            // Then work from outside the pool
+            if (Task* pTask = m_pInjectedQueues->Deques[priority].Steal())
+                return pTask;
+
+            // Then the oldest work of the other workers
+            for (uint32_t i = 1; i < workerCount; ++i)
             {
-                // Execute the task
-                taskToExecute.pTaskFunction(taskToExecute.pTaskParam);
+                if (Task* pTask = m_WorkerQueues[(workerIndex + i) % workerCount]->Deques[priority].Steal())
+                    return pTask;
+            }
+        }
+
+        return nullptr;
+    }
 
-                // When we are done, if there was a completion callback, tick it down and execute if needed
-                if (taskToExecute.pTaskCompletionCallback)
+    void TaskManager::ExecuteTask(Task* pTask)
+    {
+        // Task execution shows up on the worker's track in profile traces
+        static const wchar_t* s_TaskLabels[] = { L"Task (High)", L"Task (Normal)" };
+        static_assert(sizeof(s_TaskLabels) / sizeof(s_TaskLabels[0]) == static_cast<uint32_t>(TaskPriority::Count), "Missing task priority label");
+
+        Profiler* pProfiler = GetProfiler();
+        while (pTask->pTaskFunction)
+        {
+            // Execute the task
+            ProfileCapture capture;
+            if (pProfiler)
+                capture = pProfiler->BeginCPU(s_TaskLabels[static_cast<uint32_t>(pTask->Priority)]);
+            pTask->pTaskFunction(pTask->pTaskParam);
+            if (pProfiler)
+                pProfiler->EndCPU(capture);
+
+            // When we are done, if there was a completion callback, tick it down and execute if needed
+            if (pTask->pTaskCompletionCallback)
+            {
+                // If this was the last task on which we were waiting, execute the completion task now
+                if (--pTask->pTaskCompletionCallback->TaskCount == 0)
                 {
-                    // If this was the last task on which we were waiting, execute the completion task now
-                    if (--taskToExecute.pTaskCompletionCallback->TaskCount == 0)
-                    {
-                        auto callbackMemPtr = taskToExecute.pTaskCompletionCallback;
-                        taskToExecute = taskToExecute.pTaskCompletionCallback->CompletionTask;
-                        delete callbackMemPtr;
-                        continue;
-                    }
+                    auto callbackMemPtr = pTask->pTaskCompletionCallback;
+                    *pTask = callbackMemPtr->CompletionTask;
+                    delete callbackMemPtr;
+                    continue;
                 }
+            }
 
-                // No completion task to run, fetch another task or sleep
-                break;
+            // No completion task to run
+            break;
+        }
+
+        delete pTask;
+    }
+
+    // Runs for each thread and executes any waiting tasks when available
+    void TaskManager::TaskExecutor(uint32_t workerIndex)
+    {
+        s_pWorkerOwner = this;
+        s_WorkerIndex  = workerIndex;
+
+        // The profiler is created after the thread pool, name our track once it's there
+        bool profilerThreadNamed = false;
+
+        while (!m_ShuttingDown)
+        {
+            if (Task* pTask = FindTask(workerIndex))
+            {
+                --m_PendingTasks;
+                if (!profilerThreadNamed && GetProfiler())
+                {
+                    GetProfiler()->SetThreadName((L"Task Worker " + std::to_wstring(workerIndex)).c_str());
+                    profilerThreadNamed = true;
+                }
+                ExecuteTask(pTask);
+                continue;
             }
+
+            // Sleep until a task is available to execute or we are shutting down
+            std::unique_lock<std::mutex> lock(m_SleepMutex);
+            ++m_SleepingWorkers;
+            m_WakeCondition.wait(lock, [this] { return m_PendingTasks.load() > 0 || m_ShuttingDown; });
+            --m_SleepingWorkers;
         }
+
+        s_pWorkerOwner = nullptr;
     }
 
 } // namespace cauldron
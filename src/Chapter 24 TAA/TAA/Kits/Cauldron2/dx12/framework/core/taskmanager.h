@@ -23,8 +23,11 @@
 #pragma once
 
 #include "../misc/helpers.h"
+#include "../misc/inlinefunction.h"
 #include "../misc/threadsafe_queue.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <queue>
 #include <memory>
@@ -33,10 +36,23 @@
 
 namespace cauldron
 {
-    typedef std::function<void(void*)> TaskFunc;
+    /// Task entry point. Stored inline (no heap allocation) for function pointers and lambdas capturing up to 64 bytes,
+    /// so typed captures (i.e. <c><i>[this, pData](void*) { ... }</i></c>) should be preferred over parameter structs.
+    typedef InlineFunction<void(void*), 64> TaskFunc;
 
     struct TaskCompletionCallback;
 
+    /// An enumeration of task priorities. Higher priority tasks are always picked up first.
+    ///
+    /// @ingroup CauldronCore
+    enum class TaskPriority : uint32_t
+    {
+        High = 0,   ///< Frame-critical work the main loop is waiting on.
+        Normal,     ///< Background work such as content streaming.
+
+        Count
+    };
+
     /**
      * @struct Task
      *
@@ -49,9 +65,14 @@ namespace cauldron
         TaskFunc                pTaskFunction;              ///< The task to execute
         void*                   pTaskParam;                 ///< Parameters (in the form of a void pointer) to pass to the task (NOTE** calling code is responsible for the memory backing parameter pointer).
         TaskCompletionCallback* pTaskCompletionCallback;    ///< If this task is part of a larger group of tasks that require post-completion synchronization, they will be associated with a task sync primitive
+        TaskPriority            Priority = TaskPriority::Normal;    ///< Scheduling priority of the task
+
+        Task(TaskFunc pTaskFunction, void* pTaskParam = nullptr, TaskCompletionCallback* pCompletionCallback = nullptr, TaskPriority priority = TaskPriority::Normal) :
+            pTaskFunction(std::move(pTaskFunction)), pTaskParam(pTaskParam), pTaskCompletionCallback(pCompletionCallback), Priority(priority) {}
 
-        Task(TaskFunc pTaskFunction, void* pTaskParam = nullptr, TaskCompletionCallback* pCompletionCallback = nullptr) :
-            pTaskFunction(pTaskFunction), pTaskParam(pTaskParam), pTaskCompletionCallback(pCompletionCallback) {}
+        // Queued tasks come from a pool
+        static void* operator new(size_t size);
+        static void operator delete(void* pMem);
 
     private:
         friend class TaskManager;
@@ -73,17 +94,41 @@ namespace cauldron
         std::atomic_uint        TaskCount;          ///< Number of tasks this callback is paired with. Count will tick down upon completion of each dependent task.
 
         TaskCompletionCallback(Task completionTask, uint32_t taskCount = 1) :
-            CompletionTask(completionTask), TaskCount(taskCount) {}
+            CompletionTask(std::move(completionTask)), TaskCount(taskCount) {}
+
+        // Completion callbacks come from a pool, callers keep using new/delete
+        static void* operator new(size_t size);
+        static void operator delete(void* pMem);
 
     private:
         TaskCompletionCallback() = delete;
     };
 
+    /**
+     * @struct TaskManagerStats
+     *
+     * Task submission statistics gathered since startup.
+     *
+     * @ingroup CauldronCore
+     */
+    struct TaskManagerStats
+    {
+        uint64_t SubmittedTasks  = 0;   ///< Number of tasks queued (including parallel-for helpers)
+        uint64_t HeapAllocations = 0;   ///< Number of heap allocations made by task submission (pool growth and oversized task functions)
+        double   SubmitSeconds   = 0.0; ///< Time spent by submitting threads queuing tasks
+    };
+
     /**
      * @class TaskManager
      *
-     * The TaskManager instance manages our thread pool. Currently, only loading of content is handled
-     * asynchronously (the main loop is single threaded).
+     * The TaskManager instance manages our thread pool. Each worker owns a work-stealing deque per priority
+     * where tasks it spawns are queued, idle workers steal from the others. Tasks added from outside the
+     * pool go through a shared injection queue. Content loading runs at normal priority while per-frame
+     * parallel work (<c><i>ParallelFor</i></c>) runs at high priority.
+     *
+     * Submitting work doesn't allocate in the steady state: tasks, completion callbacks and parallel-for
+     * states are pooled and task functions are stored inline. Allocation counts and submission latency
+     * are tracked and reported on shutdown.
      *
      * @ingroup CauldronCore
      */
@@ -121,19 +166,67 @@ namespace cauldron
          */
         void AddTaskList(std::queue<Task>& newTaskList);
 
+        /**
+         * @brief   Ticks down a completion callback for a dependency that didn't run as a task (i.e. a texture load
+         *          notification or a loading stage finishing). Queues the completion task if this was the last dependency.
+         */
+        void SignalTaskCompletion(TaskCompletionCallback* pCompletionCallback);
+
+        /**
+         * @brief   Runs itemFunc for each item in [0, itemCount) across the thread pool and returns once all items are done.
+         *          The calling thread processes items as well, so a busy thread pool never stalls the call.
+         *          Returns the number of threads that ended up processing items.
+         */
+        uint32_t ParallelFor(uint32_t itemCount, const InlineFunction<void(uint32_t)>& itemFunc);
+
+        /**
+         * @brief   Splits [0, itemCount) in ranges of grainSize items (0 picks a size based on the thread count) and runs
+         *          rangeFunc(begin, end) on each across the thread pool. Behaves like <c><i>ParallelFor</i></c> otherwise.
+         */
+        uint32_t ParallelForRange(uint32_t itemCount, uint32_t grainSize, const InlineFunction<void(uint32_t, uint32_t)>& rangeFunc);
+
+        /**
+         * @brief   Returns the number of threads in the thread pool.
+         */
+        uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_ThreadPool.size()); }
+
+        /**
+         * @brief   Returns task submission statistics gathered since startup.
+         */
+        TaskManagerStats GetStats() const;
+
     private:
 
         // No Copy, No Move
         NO_COPY(TaskManager);
         NO_MOVE(TaskManager);
 
-        void TaskExecutor();
+        struct WorkerQueues;
+
+        void TaskExecutor(uint32_t workerIndex);
+        void QueueTask(Task* pTask);
+        void QueueTasks(Task** ppTasks, uint32_t taskCount);
+        void WakeWorkers(bool wakeAll);
+        Task* FindTask(uint32_t workerIndex);
+        void ExecuteTask(Task* pTask);
+
+        std::atomic_bool                            m_ShuttingDown = { false };
+        std::vector<std::thread>                    m_ThreadPool   = {};
+        std::vector<WorkerQueues*>                  m_WorkerQueues = {};
+
+        // Tasks added from threads outside the pool (pushes are serialized, workers steal from it)
+        WorkerQueues*                               m_pInjectedQueues = nullptr;
+        std::mutex                                  m_InjectionMutex;
+
+        // Sleeping workers wait on the number of queued tasks
+        std::atomic_int32_t                         m_PendingTasks     = { 0 };
+        std::atomic_uint32_t                        m_SleepingWorkers  = { 0 };
+        std::mutex                                  m_SleepMutex;
+        std::condition_variable                     m_WakeCondition;
 
-        bool                        m_ShuttingDown = false;
-        std::vector<std::thread>    m_ThreadPool = {};
-        std::queue<Task>            m_TaskQueue = {};
-        std::mutex                  m_CriticalSection;
-        std::condition_variable     m_QueueCondition;
+        // Submission statistics
+        std::atomic_uint64_t                        m_SubmittedTasks = { 0 };
+        std::atomic_uint64_t                        m_SubmitTicks    = { 0 };
     };
 
 } // namespace cauldron
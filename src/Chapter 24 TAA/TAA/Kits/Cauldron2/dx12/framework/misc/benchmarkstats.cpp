@@ -0,0 +1,344 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "benchmarkstats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace cauldron
+{
+    // Linear interpolation between the closest ranks of sorted samples
+    static double GetSortedPercentile(const std::vector<uint64_t>& sortedSamples, double fraction)
+    {
+        if (sortedSamples.empty())
+            return 0.0;
+
+        const double position = std::min(std::max(fraction, 0.0), 1.0) * static_cast<double>(sortedSamples.size() - 1);
+        const size_t lowerIndex = static_cast<size_t>(position);
+        const size_t upperIndex = std::min(lowerIndex + 1, sortedSamples.size() - 1);
+        const double weight = position - static_cast<double>(lowerIndex);
+        return static_cast<double>(sortedSamples[lowerIndex]) * (1.0 - weight) + static_cast<double>(sortedSamples[upperIndex]) * weight;
+    }
+
+    static uint64_t GetMedian(std::vector<uint64_t>& samples)
+    {
+        auto middle = samples.begin() + samples.size() / 2;
+        std::nth_element(samples.begin(), middle, samples.end());
+        return *middle;
+    }
+
+    static uint32_t GetHighestBitSet(uint64_t value)
+    {
+        uint32_t bit = 0;
+        for (uint32_t shift = 32; shift > 0; shift >>= 1)
+        {
+            if (value >> shift)
+            {
+                value >>= shift;
+                bit += shift;
+            }
+        }
+        return bit;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // BenchmarkHistogram
+
+    uint32_t BenchmarkHistogram::GetBucketIndex(uint64_t value)
+    {
+        // Values under the sub-bucket count get their own bucket, then every power of two gets s_SubBucketCount buckets
+        if (value < s_SubBucketCount)
+            return static_cast<uint32_t>(value);
+
+        const uint32_t shift = GetHighestBitSet(value) - s_SubBucketBits;
+        return s_SubBucketCount + shift * s_SubBucketCount + static_cast<uint32_t>((value >> shift) - s_SubBucketCount);
+    }
+
+    uint64_t BenchmarkHistogram::GetBucketLowerBound(uint32_t bucketIndex)
+    {
+        if (bucketIndex < s_SubBucketCount)
+            return bucketIndex;
+
+        const uint32_t shift     = (bucketIndex - s_SubBucketCount) / s_SubBucketCount;
+        const uint64_t subBucket = (bucketIndex - s_SubBucketCount) % s_SubBucketCount;
+        return (s_SubBucketCount + subBucket) << shift;
+    }
+
+    void BenchmarkHistogram::Record(uint64_t value)
+    {
+        const uint32_t bucketIndex = GetBucketIndex(value);
+        if (bucketIndex >= m_Buckets.size())
+            m_Buckets.resize(bucketIndex + 1, 0);
+
+        ++m_Buckets[bucketIndex];
+        ++m_Count;
+    }
+
+    double BenchmarkHistogram::GetPercentile(double fraction) const
+    {
+        if (!m_Count)
+            return 0.0;
+
+        const uint64_t rank = static_cast<uint64_t>(std::ceil(std::min(std::max(fraction, 0.0), 1.0) * static_cast<double>(m_Count)));
+        uint64_t count = 0;
+        for (uint32_t i = 0; i < m_Buckets.size(); ++i)
+        {
+            count += m_Buckets[i];
+            if (count >= std::max<uint64_t>(rank, 1))
+                return (static_cast<double>(GetBucketLowerBound(i)) + static_cast<double>(GetBucketLowerBound(i + 1) - 1)) * 0.5;
+        }
+
+        return static_cast<double>(GetBucketLowerBound(static_cast<uint32_t>(m_Buckets.size())) - 1);
+    }
+
+    std::vector<BenchmarkHistogramBucket> BenchmarkHistogram::GetBuckets() const
+    {
+        std::vector<BenchmarkHistogramBucket> buckets;
+        for (uint32_t i = 0; i < m_Buckets.size(); ++i)
+        {
+            if (m_Buckets[i])
+                buckets.push_back({ GetBucketLowerBound(i), GetBucketLowerBound(i + 1), m_Buckets[i] });
+        }
+        return buckets;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // BenchmarkSeries
+
+    void BenchmarkSeries::AddSample(uint64_t value)
+    {
+        m_Samples.push_back(value);
+        m_Histogram.Record(value);
+    }
+
+    void BenchmarkSeries::Reset()
+    {
+        m_Samples.clear();
+        m_Histogram = BenchmarkHistogram();
+    }
+
+    BenchmarkSummary BenchmarkSeries::Summarize(double outlierThreshold) const
+    {
+        BenchmarkSummary summary;
+        summary.SampleCount = m_Samples.size();
+        if (m_Samples.empty())
+            return summary;
+
+        std::vector<uint64_t> sortedSamples = m_Samples;
+        std::sort(sortedSamples.begin(), sortedSamples.end());
+        summary.P50  = GetSortedPercentile(sortedSamples, 0.5);
+        summary.P90  = GetSortedPercentile(sortedSamples, 0.9);
+        summary.P99  = GetSortedPercentile(sortedSamples, 0.99);
+        summary.Peak = static_cast<double>(sortedSamples.back());
+
+        // Modified z-score: 0.6745 * |x - median| / MAD (falls back on the mean absolute deviation when more than half the samples are equal)
+        const double median = summary.P50;
+        double       scale  = 0.0;
+        if (outlierThreshold > 0.0)
+        {
+            std::vector<uint64_t> deviations(sortedSamples.size());
+            double                deviationSum = 0.0;
+            for (size_t i = 0; i < sortedSamples.size(); ++i)
+            {
+                const double deviation = std::abs(static_cast<double>(sortedSamples[i]) - median);
+                deviations[i] = static_cast<uint64_t>(std::llround(deviation));
+                deviationSum += deviation;
+            }
+
+            const double medianDeviation = static_cast<double>(GetMedian(deviations));
+            if (medianDeviation > 0.0)
+                scale = medianDeviation / 0.6745;
+            else
+                scale = 1.253314 * deviationSum / static_cast<double>(sortedSamples.size());
+        }
+
+        // Welford's running mean/variance over the inliers
+        double   mean = 0.0;
+        double   m2   = 0.0;
+        uint64_t n    = 0;
+        for (uint64_t sample : sortedSamples)
+        {
+            const double value = static_cast<double>(sample);
+            if (scale > 0.0 && std::abs(value - median) / scale > outlierThreshold)
+            {
+                ++summary.OutlierCount;
+                continue;
+            }
+
+            if (n == 0)
+                summary.Min = value;
+            summary.Max = value;
+
+            ++n;
+            const double delta = value - mean;
+            mean += delta / static_cast<double>(n);
+            m2   += delta * (value - mean);
+        }
+
+        summary.Mean     = mean;
+        summary.Variance = (n > 1) ? m2 / static_cast<double>(n - 1) : 0.0;
+        return summary;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // BenchmarkWarmup
+
+    BenchmarkWarmup::BenchmarkWarmup(uint32_t minFrames, uint32_t maxFrames, uint32_t windowSize, double tolerance)
+        : m_MinFrames(minFrames)
+        , m_MaxFrames(std::max(minFrames, maxFrames))
+        , m_WindowSize(std::max(windowSize, 1u))
+        , m_Tolerance(tolerance)
+    {
+        m_FrameTimes.reserve(m_WindowSize * 2);
+    }
+
+    bool BenchmarkWarmup::AddFrame(uint64_t frameTime)
+    {
+        if (m_SteadyState || m_FrameCount >= m_MaxFrames)
+            return true;
+
+        ++m_FrameCount;
+        if (m_FrameTimes.size() == m_WindowSize * 2)
+            m_FrameTimes.erase(m_FrameTimes.begin());
+        m_FrameTimes.push_back(frameTime);
+
+        if (m_FrameCount >= m_MinFrames && m_FrameTimes.size() == m_WindowSize * 2)
+        {
+            std::vector<uint64_t> previousWindow(m_FrameTimes.begin(), m_FrameTimes.begin() + m_WindowSize);
+            std::vector<uint64_t> lastWindow(m_FrameTimes.begin() + m_WindowSize, m_FrameTimes.end());
+            const double previousMedian = static_cast<double>(GetMedian(previousWindow));
+            const double lastMedian     = static_cast<double>(GetMedian(lastWindow));
+            if (std::abs(lastMedian - previousMedian) <= m_Tolerance * previousMedian)
+                m_SteadyState = true;
+        }
+
+        return m_SteadyState || m_FrameCount >= m_MaxFrames;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // Significance testing
+
+    // Continued fraction of the regularized incomplete beta function (modified Lentz's method)
+    static double IncompleteBetaContinuedFraction(double a, double b, double x)
+    {
+        const double tiny = 1e-300;
+        double c = 1.0;
+        double d = 1.0 - (a + b) * x / (a + 1.0);
+        d = (std::abs(d) < tiny) ? 1.0 / tiny : 1.0 / d;
+        double result = d;
+
+        for (int32_t m = 1; m <= 300; ++m)
+        {
+            // Even step
+            double numerator = m * (b - m) * x / ((a + 2.0 * m - 1.0) * (a + 2.0 * m));
+            d = 1.0 + numerator * d;
+            c = 1.0 + numerator / c;
+            d = (std::abs(d) < tiny) ? 1.0 / tiny : 1.0 / d;
+            c = (std::abs(c) < tiny) ? tiny : c;
+            result *= d * c;
+
+            // Odd step
+            numerator = -(a + m) * (a + b + m) * x / ((a + 2.0 * m) * (a + 2.0 * m + 1.0));
+            d = 1.0 + numerator * d;
+            c = 1.0 + numerator / c;
+            d = (std::abs(d) < tiny) ? 1.0 / tiny : 1.0 / d;
+            c = (std::abs(c) < tiny) ? tiny : c;
+            const double delta = d * c;
+            result *= delta;
+
+            if (std::abs(delta - 1.0) < 1e-12)
+                break;
+        }
+
+        return result;
+    }
+
+    static double RegularizedIncompleteBeta(double a, double b, double x)
+    {
+        if (x <= 0.0)
+            return 0.0;
+        if (x >= 1.0)
+            return 1.0;
+
+        const double logFront = std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) + a * std::log(x) + b * std::log(1.0 - x);
+        const double front    = std::exp(logFront);
+
+        // The continued fraction converges quickly on this side, use the symmetry relation otherwise
+        if (x < (a + 1.0) / (a + b + 2.0))
+            return front * IncompleteBetaContinuedFraction(a, b, x) / a;
+        return 1.0 - front * IncompleteBetaContinuedFraction(b, a, 1.0 - x) / b;
+    }
+
+    double StudentTTwoSidedPValue(double t, double degreesOfFreedom)
+    {
+        if (!std::isfinite(t))
+            return 0.0;
+        if (degreesOfFreedom <= 0.0)
+            return 1.0;
+
+        return RegularizedIncompleteBeta(degreesOfFreedom * 0.5, 0.5, degreesOfFreedom / (degreesOfFreedom + t * t));
+    }
+
+    BenchmarkComparison CompareBenchmarks(const BenchmarkSummary& baseline, const BenchmarkSummary& current, double significanceLevel, double regressionThreshold)
+    {
+        BenchmarkComparison comparison;
+        if (baseline.Mean > 0.0)
+            comparison.RelativeChange = (current.Mean - baseline.Mean) / baseline.Mean;
+
+        const uint64_t baselineCount = baseline.GetInlierCount();
+        const uint64_t currentCount  = current.GetInlierCount();
+        if (baselineCount < 2 || currentCount < 2)
+            return comparison;
+
+        // Welch's t-test with the Welch-Satterthwaite approximation of the degrees of freedom
+        const double baselineError = baseline.Variance / static_cast<double>(baselineCount);
+        const double currentError  = current.Variance / static_cast<double>(currentCount);
+        const double standardError = baselineError + currentError;
+        if (standardError <= 0.0)
+        {
+            comparison.PValue = (current.Mean == baseline.Mean) ? 1.0 : 0.0;
+        }
+        else
+        {
+            const double t = (current.Mean - baseline.Mean) / std::sqrt(standardError);
+            const double degreesOfFreedom = standardError * standardError /
+                (baselineError * baselineError / static_cast<double>(baselineCount - 1) + currentError * currentError / static_cast<double>(currentCount - 1));
+            comparison.PValue = StudentTTwoSidedPValue(t, degreesOfFreedom);
+        }
+
+        comparison.Significant = comparison.PValue < significanceLevel;
+        comparison.Regression  = comparison.Significant && comparison.RelativeChange > regressionThreshold;
+        comparison.Improvement = comparison.Significant && comparison.RelativeChange < -regressionThreshold;
+        return comparison;
+    }
+
+    BenchmarkExitCode GetBenchmarkExitCode(bool baselineLoaded, uint32_t comparedCount, uint32_t regressionCount)
+    {
+        // A baseline with nothing in common with this run can't vouch for it
+        if (!baselineLoaded || !comparedCount)
+            return BenchmarkExitCode::BaselineError;
+        return regressionCount ? BenchmarkExitCode::Regression : BenchmarkExitCode::Success;
+    }
+
+} // namespace cauldron
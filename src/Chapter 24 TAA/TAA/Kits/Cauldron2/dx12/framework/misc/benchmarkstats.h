@@ -0,0 +1,253 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @defgroup CauldronBenchmark Benchmark
+/// Platform-neutral statistics used to summarize and compare benchmark runs.
+///
+/// @ingroup CauldronMisc
+
+namespace cauldron
+{
+    /// Statistics of a series of benchmark samples. Percentiles are taken over all samples while the mean and
+    /// variance only account for the samples that weren't rejected as outliers.
+    ///
+    /// @ingroup CauldronBenchmark
+    struct BenchmarkSummary
+    {
+        uint64_t SampleCount  = 0;      ///< Number of samples in the series.
+        uint64_t OutlierCount = 0;      ///< Number of samples rejected as outliers.
+        double   Mean         = 0.0;    ///< Mean of the inliers.
+        double   Variance     = 0.0;    ///< Unbiased variance of the inliers.
+        double   Min          = 0.0;    ///< Smallest inlier.
+        double   Max          = 0.0;    ///< Largest inlier.
+        double   P50          = 0.0;    ///< Median of all samples.
+        double   P90          = 0.0;    ///< 90th percentile of all samples.
+        double   P99          = 0.0;    ///< 99th percentile of all samples.
+        double   Peak         = 0.0;    ///< Largest sample (including outliers).
+
+        /// Number of samples used for the mean and variance.
+        uint64_t GetInlierCount() const { return SampleCount - OutlierCount; }
+    };
+
+    /// A bucket of a benchmark histogram, holding the samples in [LowerBound, UpperBound).
+    ///
+    /// @ingroup CauldronBenchmark
+    struct BenchmarkHistogramBucket
+    {
+        uint64_t LowerBound;    ///< Smallest value of the bucket.
+        uint64_t UpperBound;    ///< Bound past the largest value of the bucket.
+        uint64_t Count;         ///< Number of samples in the bucket.
+    };
+
+    /**
+     * @class BenchmarkHistogram
+     *
+     * Log-linear histogram of non-negative integer samples. Each power of two range is split in
+     * <c><i>s_SubBucketCount</i></c> linear buckets, which bounds the relative error of reported
+     * values to about 3% regardless of the magnitude of the samples.
+     *
+     * @ingroup CauldronBenchmark
+     */
+    class BenchmarkHistogram
+    {
+    public:
+        static constexpr uint32_t s_SubBucketBits  = 5;
+        static constexpr uint32_t s_SubBucketCount = 1u << s_SubBucketBits;
+
+        /**
+         * @brief   Records a sample.
+         */
+        void Record(uint64_t value);
+
+        /**
+         * @brief   Returns the number of recorded samples.
+         */
+        uint64_t GetCount() const { return m_Count; }
+
+        /**
+         * @brief   Returns the value below which the requested fraction ([0, 1]) of samples fall (bucket midpoint).
+         */
+        double GetPercentile(double fraction) const;
+
+        /**
+         * @brief   Returns the non-empty buckets in increasing order.
+         */
+        std::vector<BenchmarkHistogramBucket> GetBuckets() const;
+
+    private:
+        static uint32_t GetBucketIndex(uint64_t value);
+        static uint64_t GetBucketLowerBound(uint32_t bucketIndex);
+
+        std::vector<uint64_t> m_Buckets = {};
+        uint64_t              m_Count   = 0;
+    };
+
+    /**
+     * @class BenchmarkSeries
+     *
+     * Collects the samples of a single benchmark measurement (i.e. the duration of a pass, in nanoseconds)
+     * and summarizes them. Outliers are rejected with the modified z-score (based on the median absolute
+     * deviation), which unlike standard deviation filters isn't skewed by the outliers themselves.
+     *
+     * @ingroup CauldronBenchmark
+     */
+    class BenchmarkSeries
+    {
+    public:
+        /**
+         * @brief   Reserves memory for the expected number of samples.
+         */
+        void Reserve(size_t sampleCount) { m_Samples.reserve(sampleCount); }
+
+        /**
+         * @brief   Adds a sample to the series.
+         */
+        void AddSample(uint64_t value);
+
+        /**
+         * @brief   Clears all samples.
+         */
+        void Reset();
+
+        /**
+         * @brief   Returns the samples in the order they were added.
+         */
+        const std::vector<uint64_t>& GetSamples() const { return m_Samples; }
+
+        /**
+         * @brief   Returns the histogram of all samples.
+         */
+        const BenchmarkHistogram& GetHistogram() const { return m_Histogram; }
+
+        /**
+         * @brief   Summarizes the series. Samples with a modified z-score above outlierThreshold are
+         *          rejected as outliers (0 disables outlier rejection).
+         */
+        BenchmarkSummary Summarize(double outlierThreshold) const;
+
+    private:
+        std::vector<uint64_t> m_Samples   = {};
+        BenchmarkHistogram    m_Histogram = {};
+    };
+
+    /**
+     * @class BenchmarkWarmup
+     *
+     * Decides when a benchmark reaches its steady state. Frame times are gathered over a sliding window and
+     * the warmup ends once the median of the last window is within tolerance of the median of the window before,
+     * after a minimum number of frames. Warmup always ends after the maximum number of frames.
+     *
+     * @ingroup CauldronBenchmark
+     */
+    class BenchmarkWarmup
+    {
+    public:
+        BenchmarkWarmup(uint32_t minFrames, uint32_t maxFrames, uint32_t windowSize = 30, double tolerance = 0.02);
+
+        /**
+         * @brief   Adds the time of a warmup frame. Returns true once the steady state is reached.
+         */
+        bool AddFrame(uint64_t frameTime);
+
+        /**
+         * @brief   Returns the number of frames spent warming up.
+         */
+        uint32_t GetFrameCount() const { return m_FrameCount; }
+
+        /**
+         * @brief   Returns true if warmup ended before hitting the maximum number of frames.
+         */
+        bool ReachedSteadyState() const { return m_SteadyState; }
+
+    private:
+        uint32_t              m_MinFrames;
+        uint32_t              m_MaxFrames;
+        uint32_t              m_WindowSize;
+        double                m_Tolerance;
+        uint32_t              m_FrameCount  = 0;
+        bool                  m_SteadyState = false;
+        std::vector<uint64_t> m_FrameTimes  = {};
+    };
+
+    /// Result of the comparison of a benchmark series against its baseline.
+    ///
+    /// @ingroup CauldronBenchmark
+    struct BenchmarkComparison
+    {
+        double RelativeChange = 0.0;    ///< Relative change of the mean (positive when slower than the baseline).
+        double PValue         = 1.0;    ///< Two-sided p-value of Welch's t-test on the means.
+        bool   Significant    = false;  ///< True if the p-value is below the significance level.
+        bool   Regression     = false;  ///< True if significantly slower by more than the regression threshold.
+        bool   Improvement    = false;  ///< True if significantly faster by more than the regression threshold.
+    };
+
+    /// Compares a benchmark summary against a baseline summary with Welch's t-test (which doesn't assume
+    /// equal variances).
+    ///
+    /// @param [in] baseline                The summary of the baseline run.
+    /// @param [in] current                 The summary of the current run.
+    /// @param [in] significanceLevel       The p-value under which a difference is considered significant.
+    /// @param [in] regressionThreshold     The relative change of the mean past which a significant difference is reported.
+    ///
+    /// @returns                            The comparison result.
+    ///
+    /// @ingroup CauldronBenchmark
+    BenchmarkComparison CompareBenchmarks(const BenchmarkSummary& baseline, const BenchmarkSummary& current, double significanceLevel, double regressionThreshold);
+
+    /// Exit codes reported by <c><i>RunFramework</i></c> when benchmark results are compared against a baseline.
+    ///
+    /// @ingroup CauldronBenchmark
+    enum class BenchmarkExitCode : int32_t
+    {
+        Success       = 0,  ///< No significant regression against the baseline.
+        Regression    = 2,  ///< At least one measurement regressed significantly.
+        BaselineError = 3,  ///< The baseline couldn't be loaded or doesn't match the benchmark.
+    };
+
+    /// Decides the exit code of a benchmark run from the outcome of its baseline comparison.
+    ///
+    /// @param [in] baselineLoaded      True if the baseline could be read.
+    /// @param [in] comparedCount       The number of measurements found in both the baseline and the current run.
+    /// @param [in] regressionCount     The number of measurements that regressed significantly.
+    ///
+    /// @returns                        The exit code to report.
+    ///
+    /// @ingroup CauldronBenchmark
+    BenchmarkExitCode GetBenchmarkExitCode(bool baselineLoaded, uint32_t comparedCount, uint32_t regressionCount);
+
+    /// Computes the two-sided p-value of a Student's t statistic.
+    ///
+    /// @param [in] t                   The t statistic.
+    /// @param [in] degreesOfFreedom    The degrees of freedom of the distribution.
+    ///
+    /// @returns                        The probability of a statistic at least as extreme as t.
+    ///
+    /// @ingroup CauldronBenchmark
+    double StudentTTwoSidedPValue(double t, double degreesOfFreedom);
+
+} // namespace cauldron
@@ -0,0 +1,83 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "contentresidency.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace cauldron
+{
+    std::vector<size_t> SelectContentToReload(const std::vector<EvictedContentInfo>& evictedContent)
+    {
+        // Requests sort ahead of everything visible
+        std::vector<std::pair<float, size_t>> reloadList;
+        for (size_t i = 0; i < evictedContent.size(); ++i)
+        {
+            const EvictedContentInfo& evicted = evictedContent[i];
+            if (evicted.Reloading)
+                continue;
+
+            if (evicted.Requested)
+                reloadList.push_back(std::make_pair(-1.f, i));
+            else if (evicted.Visible)
+                reloadList.push_back(std::make_pair(std::max(evicted.Distance, 0.f), i));
+        }
+        std::sort(reloadList.begin(), reloadList.end());
+
+        std::vector<size_t> reloadOrder(reloadList.size());
+        for (size_t i = 0; i < reloadList.size(); ++i)
+            reloadOrder[i] = reloadList[i].second;
+        return reloadOrder;
+    }
+
+    std::vector<size_t> SelectContentToEvict(const std::vector<ResidentContentInfo>& residentContent, uint64_t residentBytes, uint64_t budget,
+                                             uint64_t currentFrame, bool& overBudget)
+    {
+        std::vector<size_t> evictOrder;
+        overBudget = false;
+        if (residentBytes <= budget)
+            return evictOrder;
+
+        std::vector<size_t> candidates;
+        for (size_t i = 0; i < residentContent.size(); ++i)
+        {
+            if (residentContent[i].Evictable && residentContent[i].LastUsedFrame < currentFrame)
+                candidates.push_back(i);
+        }
+
+        // Least recently used first (stable so that ties keep the caller's order)
+        std::stable_sort(candidates.begin(), candidates.end(), [&residentContent](size_t lhs, size_t rhs) {
+            return residentContent[lhs].LastUsedFrame < residentContent[rhs].LastUsedFrame;
+        });
+
+        for (size_t i = 0; i < candidates.size() && residentBytes > budget; ++i)
+        {
+            evictOrder.push_back(candidates[i]);
+            residentBytes -= std::min(residentBytes, residentContent[candidates[i]].Bytes);
+        }
+
+        overBudget = residentBytes > budget;
+        return evictOrder;
+    }
+
+} // namespace cauldron
@@ -0,0 +1,70 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cauldron
+{
+    /// Residency state of a content block that is currently loaded.
+    ///
+    /// @ingroup CauldronCore
+    struct ResidentContentInfo
+    {
+        uint64_t Bytes         = 0;         ///< GPU and CPU bytes held by the content.
+        uint64_t LastUsedFrame = 0;         ///< Last frame the content was visible or explicitly used.
+        bool     Evictable     = false;     ///< False for content that can't be evicted (still loading, or no source to reload it from).
+    };
+
+    /// Residency state of a content block that was evicted to stay within budget.
+    ///
+    /// @ingroup CauldronCore
+    struct EvictedContentInfo
+    {
+        float Distance  = 0.f;      ///< Distance from the camera to the content.
+        bool  Visible   = false;    ///< True if the content is visible to the camera.
+        bool  Requested = false;    ///< True if the content was explicitly requested.
+        bool  Reloading = false;    ///< True if the content is already being reloaded.
+    };
+
+    /**
+     * @brief   Selects the evicted content that needs to be reloaded, in reload order. Explicit requests go
+     *          first, then visible content from closest to furthest. Returns indices into evictedContent.
+     *
+     * @ingroup CauldronCore
+     */
+    std::vector<size_t> SelectContentToReload(const std::vector<EvictedContentInfo>& evictedContent);
+
+    /**
+     * @brief   Selects the least recently used content to evict to bring residentBytes back within budget,
+     *          in eviction order. Content used on currentFrame is never evicted. Returns indices into residentContent,
+     *          and sets overBudget if not enough content could be evicted to meet the budget.
+     *
+     * @ingroup CauldronCore
+     */
+    std::vector<size_t> SelectContentToEvict(const std::vector<ResidentContentInfo>& residentContent, uint64_t residentBytes, uint64_t budget,
+                                             uint64_t currentFrame, bool& overBudget);
+
+} // namespace cauldron
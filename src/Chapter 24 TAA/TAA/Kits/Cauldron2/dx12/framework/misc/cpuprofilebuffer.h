@@ -0,0 +1,159 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "helpers.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace cauldron
+{
+    /// A completed CPU capture, as recorded by the thread that made it
+    ///
+    /// @ingroup CauldronMisc
+    struct CPUProfileEvent
+    {
+        const wchar_t* pLabel;          ///< Capture label (not copied).
+        uint64_t       StartTimestamp;  ///< CPU timestamp at which the capture began.
+        uint64_t       EndTimestamp;    ///< CPU timestamp at which the capture ended.
+        uint32_t       Depth;           ///< Nesting depth of the capture on its thread.
+    };
+
+    /**
+     * @class CPUProfileBuffer
+     *
+     * Records the CPU captures of a single thread. Holds the owning thread's stack of open captures and a
+     * single-producer (the owning thread) / single-consumer (the frame collection) ring of completed captures.
+     *
+     * @ingroup CauldronMisc
+     */
+    class CPUProfileBuffer
+    {
+    public:
+        static constexpr uint32_t s_Capacity = 16384;   ///< Number of completed captures the ring holds (must be a power of 2).
+        static constexpr uint32_t s_MaxDepth = 64;      ///< Maximum tracked nesting depth of open captures.
+
+        /**
+         * @brief   Construction.
+         */
+        CPUProfileBuffer() : m_Events(s_Capacity) {}
+
+        /**
+         * @brief   Opens a capture and returns its depth, which identifies it when ending it. Owning thread only.
+         *          Captures deeper than <c><i>s_MaxDepth</i></c> still need to be ended, but aren't recorded.
+         */
+        uint32_t Begin(const wchar_t* label);
+
+        /**
+         * @brief   Ends the capture opened at depth index, along with any capture nested in it that wasn't ended.
+         *          Returns false if there is no such capture. Owning thread only.
+         */
+        bool End(uint32_t index);
+
+        /**
+         * @brief   Returns the number of captures currently open. Owning thread only.
+         */
+        uint32_t GetDepth() const { return m_Depth; }
+
+        /**
+         * @brief   Calls func on every completed capture not drained yet, in the order they ended.
+         */
+        template<typename Func>
+        void Drain(Func func);
+
+        /**
+         * @brief   Returns the number of captures lost because the ring was full.
+         */
+        uint64_t GetDroppedCount() const { return m_Dropped.load(std::memory_order_relaxed); }
+
+    private:
+        NO_COPY(CPUProfileBuffer)
+        NO_MOVE(CPUProfileBuffer)
+
+        void Push(const CPUProfileEvent& event);
+
+        struct OpenCapture
+        {
+            const wchar_t* pLabel;
+            uint64_t       StartTimestamp;
+        };
+
+        // Owning thread state
+        OpenCapture m_OpenCaptures[s_MaxDepth];
+        uint32_t    m_Depth         = 0;
+
+        std::vector<CPUProfileEvent>     m_Events;
+        alignas(64) std::atomic_uint64_t m_WritePos = { 0 };
+        alignas(64) std::atomic_uint64_t m_ReadPos  = { 0 };
+        std::atomic_uint64_t             m_Dropped  = { 0 };
+    };
+
+    inline uint32_t CPUProfileBuffer::Begin(const wchar_t* label)
+    {
+        const uint32_t depth = m_Depth++;
+        if (depth < s_MaxDepth)
+            m_OpenCaptures[depth] = { label, ReadCPUTimestamp() };
+        return depth;
+    }
+
+    inline bool CPUProfileBuffer::End(uint32_t index)
+    {
+        if (index >= m_Depth)
+            return false;
+
+        const uint64_t endTimestamp = ReadCPUTimestamp();
+        m_Depth = index;
+        if (index < s_MaxDepth)
+        {
+            const OpenCapture& openCapture = m_OpenCaptures[index];
+            Push({ openCapture.pLabel, openCapture.StartTimestamp, endTimestamp, index });
+        }
+        return true;
+    }
+
+    inline void CPUProfileBuffer::Push(const CPUProfileEvent& event)
+    {
+        const uint64_t writePos = m_WritePos.load(std::memory_order_relaxed);
+        if (writePos - m_ReadPos.load(std::memory_order_acquire) >= s_Capacity)
+        {
+            m_Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        m_Events[writePos & (s_Capacity - 1)] = event;
+        m_WritePos.store(writePos + 1, std::memory_order_release);
+    }
+
+    template<typename Func>
+    void CPUProfileBuffer::Drain(Func func)
+    {
+        const uint64_t writePos = m_WritePos.load(std::memory_order_acquire);
+        uint64_t       readPos  = m_ReadPos.load(std::memory_order_relaxed);
+        for (; readPos < writePos; ++readPos)
+            func(m_Events[readPos & (s_Capacity - 1)]);
+        m_ReadPos.store(readPos, std::memory_order_release);
+    }
+
+} // namespace cauldron
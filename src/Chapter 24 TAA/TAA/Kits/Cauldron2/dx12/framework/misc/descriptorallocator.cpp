@@ -0,0 +1,301 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "descriptorallocator.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace cauldron
+{
+    // Per-thread caches of single descriptors, one slot per allocator the thread allocated from. Slots are
+    // matched on the allocator's generation so a recycled allocator address never picks up a stale cache.
+    struct DescriptorThreadCacheSlot
+    {
+        uint64_t Generation = 0;
+        void*    pCache     = nullptr;
+    };
+    static constexpr uint32_t                     s_DescriptorThreadCacheSlotCount = 8;
+    static thread_local DescriptorThreadCacheSlot s_DescriptorThreadCacheSlots[s_DescriptorThreadCacheSlotCount];
+    static std::atomic_uint64_t                   s_DescriptorAllocatorGeneration = { 0 };
+
+    static constexpr uint64_t s_AllBitsSet = ~0ull;
+
+    DescriptorAllocator::DescriptorAllocator(uint32_t capacity) :
+        m_Generation(++s_DescriptorAllocatorGeneration),
+        m_Capacity(capacity)
+    {
+        const uint32_t wordCount = DivideRoundingUp(capacity, 64);
+        m_FreeBits.resize(wordCount, s_AllBitsSet);
+        m_FreeWordMask.resize(DivideRoundingUp(wordCount, 64), 0);
+
+        // Descriptors past the end of the heap are never free
+        if (capacity % 64)
+            m_FreeBits.back() = (1ull << (capacity % 64)) - 1;
+
+        for (uint32_t word = 0; word < wordCount; ++word)
+            m_FreeWordMask[word / 64] |= 1ull << (word % 64);
+    }
+
+    bool DescriptorAllocator::Allocate(uint32_t count, uint32_t& index)
+    {
+        assert(count > 0 && "Can't allocate an empty descriptor range.");
+
+        if (count == 1)
+        {
+            ThreadCache* pCache = GetThreadCache();
+            if (pCache)
+            {
+                if (!pCache->Count)
+                {
+                    std::lock_guard<std::mutex> lock(m_CriticalSection);
+                    pCache->Count = TakeFreeDescriptors(pCache->Indices, s_ThreadCacheSize);
+                }
+
+                if (!pCache->Count)
+                    return false;
+
+                index = pCache->Indices[--pCache->Count];
+                return true;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_CriticalSection);
+        if (!FindRange(count, index))
+            return false;
+
+        MarkRange(index, count, false);
+        m_AllocatedCount.fetch_add(count, std::memory_order_relaxed);
+        return true;
+    }
+
+    void DescriptorAllocator::Free(uint32_t index, uint32_t count)
+    {
+        assert(count > 0 && index < m_Capacity && count <= m_Capacity - index && "Freeing descriptors outside of the heap.");
+
+        std::lock_guard<std::mutex> lock(m_CriticalSection);
+        m_PendingFrees.push_back({ index, count });
+    }
+
+    void DescriptorAllocator::EndFrame(uint64_t fenceValue)
+    {
+        std::lock_guard<std::mutex> lock(m_CriticalSection);
+        if (!m_PendingFrees.empty())
+        {
+            m_RetiringFrames.push({ fenceValue, std::move(m_PendingFrees) });
+            m_PendingFrees.clear();
+        }
+    }
+
+    void DescriptorAllocator::Retire(uint64_t completedFenceValue)
+    {
+        std::lock_guard<std::mutex> lock(m_CriticalSection);
+        while (!m_RetiringFrames.empty() && m_RetiringFrames.front().FenceValue <= completedFenceValue)
+        {
+            for (const PendingFree& pendingFree : m_RetiringFrames.front().Frees)
+            {
+                MarkRange(pendingFree.Index, pendingFree.Count, true);
+                m_AllocatedCount.fetch_sub(pendingFree.Count, std::memory_order_relaxed);
+            }
+            m_RetiringFrames.pop();
+        }
+    }
+
+    uint32_t DescriptorAllocator::GetLargestFreeRange() const
+    {
+        std::lock_guard<std::mutex> lock(m_CriticalSection);
+
+        uint32_t largestRange = 0;
+        uint32_t rangeLength  = 0;
+        for (const uint64_t bits : m_FreeBits)
+        {
+            if (bits == s_AllBitsSet)
+            {
+                rangeLength += 64;
+                continue;
+            }
+
+            // The low free bits close the range coming from the previous words
+            rangeLength += FindLowestBitSet(~bits);
+            largestRange = std::max(largestRange, rangeLength);
+
+            // Runs inside the word
+            uint64_t remainingBits = bits;
+            while (remainingBits)
+            {
+                const uint32_t runStart  = FindLowestBitSet(remainingBits);
+                const uint32_t runLength = FindLowestBitSet(~(remainingBits >> runStart));
+                largestRange = std::max(largestRange, runLength);
+                if (runStart + runLength >= 64)
+                    break;
+                remainingBits &= ~((1ull << (runStart + runLength)) - 1);
+            }
+
+            // The high free bits start a new range
+            rangeLength = (bits >> 63) ? 63 - FindHighestBitSet(~bits) : 0;
+        }
+        return std::max(largestRange, rangeLength);
+    }
+
+    DescriptorAllocator::ThreadCache* DescriptorAllocator::GetThreadCache()
+    {
+        DescriptorThreadCacheSlot* pFreeSlot = nullptr;
+        for (DescriptorThreadCacheSlot& slot : s_DescriptorThreadCacheSlots)
+        {
+            if (slot.Generation == m_Generation)
+                return static_cast<ThreadCache*>(slot.pCache);
+            if (!slot.Generation && !pFreeSlot)
+                pFreeSlot = &slot;
+        }
+
+        // Threads touching more allocators than there are slots go through the shared path
+        if (!pFreeSlot)
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(m_CriticalSection);
+        m_ThreadCaches.push_back(std::make_unique<ThreadCache>());
+        pFreeSlot->Generation = m_Generation;
+        pFreeSlot->pCache     = m_ThreadCaches.back().get();
+        return m_ThreadCaches.back().get();
+    }
+
+    bool DescriptorAllocator::FindRange(uint32_t count, uint32_t& index) const
+    {
+        // Track the run of free descriptors reaching the top of the last visited word,
+        // so ranges can span multiple words
+        uint32_t runStart  = 0;
+        uint32_t runLength = 0;
+        uint32_t lastWord  = 0;
+        for (uint32_t maskIndex = 0; maskIndex < static_cast<uint32_t>(m_FreeWordMask.size()); ++maskIndex)
+        {
+            uint64_t wordMask = m_FreeWordMask[maskIndex];
+            while (wordMask)
+            {
+                const uint32_t word = maskIndex * 64 + FindLowestBitSet(wordMask);
+                wordMask &= wordMask - 1;
+                const uint64_t bits = m_FreeBits[word];
+
+                // Extend the run coming from the previous word
+                if (runLength && word == lastWord + 1)
+                {
+                    const uint32_t lowFreeCount = (bits == s_AllBitsSet) ? 64 : FindLowestBitSet(~bits);
+                    if (runLength + lowFreeCount >= count)
+                    {
+                        index = runStart;
+                        return true;
+                    }
+
+                    if (bits == s_AllBitsSet)
+                    {
+                        runLength += 64;
+                        lastWord = word;
+                        continue;
+                    }
+                }
+
+                // Look for a run inside the word: after each step bit i is set if the fitLength bits starting at i are free
+                if (count <= 64)
+                {
+                    uint64_t fit       = bits;
+                    uint32_t fitLength = 1;
+                    while (fit && fitLength < count)
+                    {
+                        const uint32_t step = std::min(fitLength, count - fitLength);
+                        fit &= fit >> step;
+                        fitLength += step;
+                    }
+
+                    if (fit)
+                    {
+                        index = word * 64 + FindLowestBitSet(fit);
+                        return true;
+                    }
+                }
+
+                // Start a new run from the free descriptors at the top of the word
+                runLength = (bits == s_AllBitsSet) ? 64 : ((bits >> 63) ? 63 - FindHighestBitSet(~bits) : 0);
+                runStart  = word * 64 + 64 - runLength;
+                lastWord  = word;
+            }
+        }
+        return false;
+    }
+
+    uint32_t DescriptorAllocator::TakeFreeDescriptors(uint32_t* pIndices, uint32_t maxCount)
+    {
+        // Indices are handed out from the back of the cache, fill it in reverse so they come out in ascending order
+        uint32_t takenCount = 0;
+        for (uint32_t maskIndex = 0; maskIndex < static_cast<uint32_t>(m_FreeWordMask.size()) && takenCount < maxCount; ++maskIndex)
+        {
+            while (m_FreeWordMask[maskIndex] && takenCount < maxCount)
+            {
+                const uint32_t word = maskIndex * 64 + FindLowestBitSet(m_FreeWordMask[maskIndex]);
+                uint64_t&      bits = m_FreeBits[word];
+                while (bits && takenCount < maxCount)
+                {
+                    pIndices[maxCount - 1 - takenCount++] = word * 64 + FindLowestBitSet(bits);
+                    bits &= bits - 1;
+                }
+
+                if (!bits)
+                    m_FreeWordMask[maskIndex] &= ~(1ull << (word % 64));
+            }
+        }
+
+        // Compact to the front of the cache if we came up short
+        if (takenCount && takenCount < maxCount)
+            std::copy(pIndices + maxCount - takenCount, pIndices + maxCount, pIndices);
+
+        m_AllocatedCount.fetch_add(takenCount, std::memory_order_relaxed);
+        return takenCount;
+    }
+
+    void DescriptorAllocator::MarkRange(uint32_t index, uint32_t count, bool free)
+    {
+        while (count)
+        {
+            const uint32_t word      = index / 64;
+            const uint32_t bit       = index % 64;
+            const uint32_t bitCount  = std::min(64 - bit, count);
+            const uint64_t rangeBits = ((bitCount == 64) ? s_AllBitsSet : ((1ull << bitCount) - 1)) << bit;
+
+            if (free)
+            {
+                assert(!(m_FreeBits[word] & rangeBits) && "Freeing descriptors that aren't allocated.");
+                m_FreeBits[word] |= rangeBits;
+            }
+            else
+            {
+                m_FreeBits[word] &= ~rangeBits;
+            }
+
+            if (m_FreeBits[word])
+                m_FreeWordMask[word / 64] |= 1ull << (word % 64);
+            else
+                m_FreeWordMask[word / 64] &= ~(1ull << (word % 64));
+
+            index += bitCount;
+            count -= bitCount;
+        }
+    }
+
+} // namespace cauldron
@@ -0,0 +1,145 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "helpers.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+namespace cauldron
+{
+    /**
+     * @class DescriptorAllocator
+     *
+     * Backend-neutral allocator for ranges of descriptor indices in a fixed size heap. Free descriptors are
+     * tracked in a bitset with a second bitset marking the words that still hold free descriptors, so searches
+     * skip full parts of the heap and scan the rest a word at a time. Ranges are placed first-fit to keep the
+     * heap compact.
+     *
+     * Freed descriptors may still be referenced by in-flight GPU work, so they are only recycled once the
+     * fence of the frame they were freed in has completed. Single descriptor allocations are served from
+     * small per-thread caches refilled in batches, which keeps the heap lock off the hot path of parallel
+     * content creation.
+     *
+     * @ingroup CauldronMisc
+     */
+    class DescriptorAllocator
+    {
+    public:
+
+        /**
+         * @brief   Construction. All capacity descriptors start out free.
+         */
+        DescriptorAllocator(uint32_t capacity);
+
+        /**
+         * @brief   Destruction.
+         */
+        ~DescriptorAllocator() = default;
+
+        /**
+         * @brief   Allocates count contiguous descriptors and returns the index of the first one.
+         *          Thread-safe. Returns false if no large enough range is free.
+         */
+        bool Allocate(uint32_t count, uint32_t& index);
+
+        /**
+         * @brief   Frees count descriptors starting at index. They are recycled once the frame being
+         *          recorded has been retired. Thread-safe.
+         */
+        void Free(uint32_t index, uint32_t count);
+
+        /**
+         * @brief   Closes the current frame. Descriptors freed during it are recycled once fenceValue has completed.
+         */
+        void EndFrame(uint64_t fenceValue);
+
+        /**
+         * @brief   Recycles the descriptors freed in all closed frames up to completedFenceValue.
+         */
+        void Retire(uint64_t completedFenceValue);
+
+        /**
+         * @brief   Returns the number of descriptors managed by the allocator.
+         */
+        uint32_t GetCapacity() const { return m_Capacity; }
+
+        /**
+         * @brief   Returns the number of descriptors not available for allocation. This includes descriptors
+         *          held in thread caches and freed descriptors waiting to be recycled.
+         */
+        uint32_t GetAllocatedCount() const { return m_AllocatedCount.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief   Returns the size of the largest range of descriptors that can currently be allocated.
+         */
+        uint32_t GetLargestFreeRange() const;
+
+    private:
+        NO_COPY(DescriptorAllocator)
+        NO_MOVE(DescriptorAllocator)
+
+        static constexpr uint32_t s_ThreadCacheSize = 16;
+
+        struct ThreadCache
+        {
+            uint32_t Count = 0;
+            uint32_t Indices[s_ThreadCacheSize];
+        };
+
+        struct PendingFree
+        {
+            uint32_t Index = 0;
+            uint32_t Count = 0;
+        };
+
+        struct RetiringFrame
+        {
+            uint64_t                 FenceValue = 0;
+            std::vector<PendingFree> Frees      = {};
+        };
+
+        ThreadCache* GetThreadCache();
+        bool FindRange(uint32_t count, uint32_t& index) const;
+        uint32_t TakeFreeDescriptors(uint32_t* pIndices, uint32_t maxCount);
+        void MarkRange(uint32_t index, uint32_t count, bool free);
+
+        const uint64_t                              m_Generation;
+        const uint32_t                              m_Capacity;
+        std::atomic_uint32_t                        m_AllocatedCount = { 0 };
+
+        std::vector<uint64_t>                       m_FreeBits     = {};    // One bit per descriptor, set while free
+        std::vector<uint64_t>                       m_FreeWordMask = {};    // One bit per m_FreeBits word, set while it holds free descriptors
+
+        std::vector<PendingFree>                    m_PendingFrees   = {};
+        std::queue<RetiringFrame>                   m_RetiringFrames = {};
+        std::vector<std::unique_ptr<ThreadCache>>   m_ThreadCaches   = {};
+        mutable std::mutex                          m_CriticalSection;
+    };
+
+} // namespace cauldron
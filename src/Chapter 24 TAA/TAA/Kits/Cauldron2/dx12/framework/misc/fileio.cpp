@@ -22,6 +22,7 @@
 
 #include "fileio.h"
 #include "assert.h"
+#include "helpers.h"
 
 #include <algorithm>
 #include <fcntl.h>
@@ -191,6 +192,157 @@ namespace cauldron
         return fileStatus.st_size;
     }
 
+    int32_t OpenFileForRead(const wchar_t* fileName, int64_t* pFileSize/*= nullptr*/)
+    {
+        // Try to open the file (random access as the handle may be used for multiple reads)
+        int file = -1;
+        (void)_wsopen_s(&file, fileName, _O_RDONLY | _O_NOINHERIT | _O_BINARY | _O_RANDOM, _SH_DENYNO, _S_IREAD);
+
+        // Unable to open file
+        if (file == -1)
+            return -1;
+
+        // Get the file size
+        struct _stat64 fileStatus;
+        if (_fstat64(file, &fileStatus) != 0 || !S_ISREG(fileStatus.st_mode))
+        {
+            // Unable to get size or not a regular file
+            (void)_close(file);
+            return -1;
+        }
+
+        if (pFileSize)
+            *pFileSize = fileStatus.st_size;
+
+        return file;
+    }
+
+    int64_t ReadFileAt(int32_t fileHandle, void* buffer, size_t bufferLen, int64_t readOffset)
+    {
+        if (fileHandle == -1)
+            return -1;
+
+        // Move the read head to the requested offset
+        if (_lseeki64(fileHandle, readOffset, SEEK_SET) != readOffset)
+            return -1;
+
+        // Fill in the buffer
+        char* pFileBuffer = (char*)buffer;
+        for (uint64_t bytesLeft = bufferLen; bytesLeft > 0;)
+        {
+            uint32_t bytesRequested = static_cast<uint32_t>(std::min<uint64_t>(bytesLeft, INT32_MAX));
+            auto bytesReceivedOrStatus = _read(fileHandle, pFileBuffer, bytesRequested);
+
+            // Break into 4GB chunks
+            if (bytesReceivedOrStatus > 0)
+            {
+                bytesLeft -= bytesReceivedOrStatus;
+                pFileBuffer += bytesReceivedOrStatus;
+            }
+
+            // bytesReceivedOrStatus == 0: going past eof... not good
+            // bytesReceivedOrStatus <  0: error reported during read
+            else
+                return -1;
+        }
+
+        return static_cast<int64_t>(bufferLen);
+    }
+
+    void CloseFileHandle(int32_t fileHandle)
+    {
+        if (fileHandle != -1)
+            (void)_close(fileHandle);
+    }
+
+    int64_t WriteFileAll(const wchar_t* fileName, const void* buffer, size_t bufferLen)
+    {
+        // Try to create the file (or truncate the existing one)
+        int file = -1;
+        (void)_wsopen_s(&file, fileName, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_NOINHERIT | _O_BINARY | _O_SEQUENTIAL, _SH_DENYWR, _S_IREAD | _S_IWRITE);
+
+        // Unable to open file
+        if (file == -1)
+            return -1;
+
+        // Write out the buffer
+        const char* pFileBuffer = (const char*)buffer;
+        for (uint64_t bytesLeft = bufferLen; bytesLeft > 0;)
+        {
+            uint32_t bytesRequested = static_cast<uint32_t>(std::min<uint64_t>(bytesLeft, INT32_MAX));
+            auto bytesWrittenOrStatus = _write(file, pFileBuffer, bytesRequested);
+
+            // Break into 4GB chunks
+            if (bytesWrittenOrStatus > 0)
+            {
+                bytesLeft -= bytesWrittenOrStatus;
+                pFileBuffer += bytesWrittenOrStatus;
+            }
+
+            // Error reported during write
+            else
+            {
+                (void)_close(file);
+                return -1;
+            }
+        }
+
+        // All done
+        (void)_close(file);
+
+        return static_cast<int64_t>(bufferLen);
+    }
+
+    bool MapFileForRead(const wchar_t* fileName, MappedFile& mappedFile)
+    {
+        mappedFile = {};
+
+        HANDLE file = CreateFileW(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        // Empty files can't be mapped
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        const void* pView = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (pView == nullptr)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        mappedFile.pData          = reinterpret_cast<const char*>(pView);
+        mappedFile.Size           = fileSize.QuadPart;
+        mappedFile.pFileHandle    = file;
+        mappedFile.pMappingHandle = mapping;
+        return true;
+    }
+
+    void UnmapFile(MappedFile& mappedFile)
+    {
+        if (mappedFile.pData)
+            UnmapViewOfFile(mappedFile.pData);
+        if (mappedFile.pMappingHandle)
+            CloseHandle(mappedFile.pMappingHandle);
+        if (mappedFile.pFileHandle)
+            CloseHandle(mappedFile.pFileHandle);
+
+        mappedFile = {};
+    }
+
     bool ParseJsonFile(const wchar_t* fileName, json& jsonOut)
     {
         // Add any render modules needed for this sample
@@ -66,6 +66,74 @@ namespace cauldron
     /// @ingroup CauldronFileIO
     int64_t GetFileSize(const wchar_t* fileName);
 
+    /// Opens a file for (possibly repeated) reading
+    ///
+    /// @param [in]  fileName   The file to open.
+    /// @param [out] pFileSize  Optional pointer to receive the size (in bytes) of the file.
+    ///
+    /// @returns                A handle to the opened file, or -1 if the file could not be opened.
+    ///
+    /// @ingroup CauldronFileIO
+    int32_t OpenFileForRead(const wchar_t* fileName, int64_t* pFileSize = nullptr);
+
+    /// Reads from a file previously opened with <c><i>OpenFileForRead</i></c>
+    ///
+    /// @param [in] fileHandle  The handle of the file to read.
+    /// @param [in] buffer      The buffer into which to copy read file data.
+    /// @param [in] bufferLen   The amount of data to read.
+    /// @param [in] readOffset  Offset in the file where to start reading.
+    ///
+    /// @returns                The number of bytes read, or -1 on error.
+    ///
+    /// @ingroup CauldronFileIO
+    int64_t ReadFileAt(int32_t fileHandle, void* buffer, size_t bufferLen, int64_t readOffset);
+
+    /// Closes a file previously opened with <c><i>OpenFileForRead</i></c>
+    ///
+    /// @param [in] fileHandle  The handle of the file to close.
+    ///
+    /// @ingroup CauldronFileIO
+    void CloseFileHandle(int32_t fileHandle);
+
+    /// Writes a buffer to file, replacing any previous file contents
+    ///
+    /// @param [in] fileName    The file to write.
+    /// @param [in] buffer      The buffer holding the data to write.
+    /// @param [in] bufferLen   The amount of data to write.
+    ///
+    /// @returns                The number of bytes written, or -1 on error.
+    ///
+    /// @ingroup CauldronFileIO
+    int64_t WriteFileAll(const wchar_t* fileName, const void* buffer, size_t bufferLen);
+
+    /// Read-only memory mapping of a file
+    ///
+    /// @ingroup CauldronFileIO
+    struct MappedFile
+    {
+        const char* pData = nullptr;            ///< The mapped file data.
+        int64_t     Size = 0;                   ///< The size (in bytes) of the mapped file data.
+        void*       pFileHandle = nullptr;      ///< Platform handle of the mapped file.
+        void*       pMappingHandle = nullptr;   ///< Platform handle of the file mapping.
+    };
+
+    /// Maps a file into memory for reading
+    ///
+    /// @param [in]  fileName   The file to map.
+    /// @param [out] mappedFile The resulting file mapping.
+    ///
+    /// @returns                True if the file was mapped, false otherwise.
+    ///
+    /// @ingroup CauldronFileIO
+    bool MapFileForRead(const wchar_t* fileName, MappedFile& mappedFile);
+
+    /// Releases a file mapping created with <c><i>MapFileForRead</i></c>
+    ///
+    /// @param [in] mappedFile  The file mapping to release.
+    ///
+    /// @ingroup CauldronFileIO
+    void UnmapFile(MappedFile& mappedFile);
+
     /// Helper to read and parse json files
     ///
     /// @param [in]  fileName   The json file to read and parse.
@@ -0,0 +1,132 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "frameringallocator.h"
+
+#include <cassert>
+
+namespace cauldron
+{
+    // The chunk each thread is currently allocating from. Threads only cache a chunk for a single
+    // allocator, which is fine as there is one per frame pool.
+    struct FrameRingThreadState
+    {
+        uint64_t Generation = 0;
+        uint64_t FrameIndex = 0;
+        uint32_t Offset     = 0;
+        uint32_t End        = 0;
+    };
+    static thread_local FrameRingThreadState s_FrameRingThreadState;
+    static std::atomic_uint64_t              s_FrameRingGeneration = { 0 };
+
+    FrameRingAllocator::FrameRingAllocator(uint32_t totalSize, uint32_t chunkSize) :
+        m_Generation(++s_FrameRingGeneration),
+        m_ChunkSize(chunkSize),
+        m_ChunkCount(chunkSize ? totalSize / chunkSize : 0)
+    {
+        assert(m_ChunkCount > 0 && "Frame ring allocator needs to hold at least one chunk");
+    }
+
+    bool FrameRingAllocator::Allocate(uint32_t size, uint32_t alignment, uint32_t& offset)
+    {
+        assert(alignment && !(alignment & (alignment - 1)) && alignment <= m_ChunkSize && "Frame ring allocations need a power of two alignment no bigger than a chunk");
+
+        // Chunks are never carried over to the next frame, or they would be retired with the frame they were acquired in
+        FrameRingThreadState& state = s_FrameRingThreadState;
+        const uint64_t frameIndex = m_FrameIndex.load(std::memory_order_acquire);
+        if (state.Generation != m_Generation || state.FrameIndex != frameIndex)
+            state = { m_Generation, frameIndex, 0, 0 };
+
+        // Bump allocate from the thread's chunk
+        const uint32_t alignedOffset = AlignUp(state.Offset, alignment);
+        if (state.End && alignedOffset <= state.End && size <= state.End - alignedOffset)
+        {
+            offset       = alignedOffset;
+            state.Offset = alignedOffset + size;
+            return true;
+        }
+
+        // Large allocations get chunks of their own, leaving the thread's chunk in place
+        uint32_t firstChunk;
+        if (size > m_ChunkSize / 2)
+        {
+            const uint64_t chunkCount = (static_cast<uint64_t>(size) + m_ChunkSize - 1) / m_ChunkSize;
+            if (chunkCount > m_ChunkCount || !AcquireChunks(static_cast<uint32_t>(chunkCount), firstChunk))
+                return false;
+
+            offset = firstChunk * m_ChunkSize;
+            return true;
+        }
+
+        if (!AcquireChunks(1, firstChunk))
+            return false;
+
+        offset       = firstChunk * m_ChunkSize;
+        state.Offset = offset + size;
+        state.End    = offset + m_ChunkSize;
+        return true;
+    }
+
+    bool FrameRingAllocator::AcquireChunks(uint32_t count, uint32_t& firstChunk)
+    {
+        uint64_t acquiredChunks = m_AcquiredChunks.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            // Runs of chunks can't wrap around the end of the ring, skip to its start instead
+            uint64_t first = acquiredChunks;
+            const uint64_t ringIndex = first % m_ChunkCount;
+            if (ringIndex + count > m_ChunkCount)
+                first += m_ChunkCount - ringIndex;
+
+            if (first + count - m_RetiredChunks.load(std::memory_order_acquire) > m_ChunkCount)
+                return false;
+
+            if (m_AcquiredChunks.compare_exchange_weak(acquiredChunks, first + count, std::memory_order_acq_rel, std::memory_order_relaxed))
+            {
+                firstChunk = static_cast<uint32_t>(first % m_ChunkCount);
+                return true;
+            }
+        }
+    }
+
+    void FrameRingAllocator::EndFrame(uint64_t fenceValue)
+    {
+        // Everything acquired so far belongs to the frame being closed
+        m_PendingFrames.push({ fenceValue, m_AcquiredChunks.load(std::memory_order_acquire) });
+        m_FrameIndex.fetch_add(1, std::memory_order_release);
+    }
+
+    void FrameRingAllocator::Retire(uint64_t completedFenceValue)
+    {
+        while (!m_PendingFrames.empty() && m_PendingFrames.front().FenceValue <= completedFenceValue)
+        {
+            m_RetiredChunks.store(m_PendingFrames.front().ChunkEnd, std::memory_order_release);
+            m_PendingFrames.pop();
+        }
+    }
+
+    uint64_t FrameRingAllocator::GetUsedSize() const
+    {
+        return (m_AcquiredChunks.load(std::memory_order_relaxed) - m_RetiredChunks.load(std::memory_order_relaxed)) * m_ChunkSize;
+    }
+
+} // namespace cauldron
@@ -0,0 +1,115 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "helpers.h"
+
+#include <atomic>
+#include <cstdint>
+#include <queue>
+
+namespace cauldron
+{
+    /**
+     * @class FrameRingAllocator
+     *
+     * Backend-neutral allocator for transient per-frame memory laid out as a ring. The ring is split in
+     * fixed-size chunks which threads acquire without locking, each thread then bump allocates from its own
+     * chunk so parallel recording doesn't contend on a shared head. Memory is retired a frame at a time,
+     * once the fence value the frame was closed with has completed.
+     *
+     * The allocator only hands out offsets, the backing memory is owned by the caller.
+     *
+     * @ingroup CauldronMisc
+     */
+    class FrameRingAllocator
+    {
+    public:
+
+        /**
+         * @brief   Construction. totalSize is rounded down to a multiple of chunkSize.
+         */
+        FrameRingAllocator(uint32_t totalSize, uint32_t chunkSize);
+
+        /**
+         * @brief   Destruction.
+         */
+        ~FrameRingAllocator() = default;
+
+        /**
+         * @brief   Allocates size bytes at the requested (power of two, at most chunk sized) alignment for
+         *          the current frame. Thread-safe and lock-free. Returns false if the ring is out of memory.
+         */
+        bool Allocate(uint32_t size, uint32_t alignment, uint32_t& offset);
+
+        /**
+         * @brief   Closes the current frame. Its memory is retired once fenceValue has completed.
+         *          Must be called from the frame thread while no allocations are in flight.
+         */
+        void EndFrame(uint64_t fenceValue);
+
+        /**
+         * @brief   Releases the memory of all closed frames up to completedFenceValue.
+         *          Must be called from the frame thread.
+         */
+        void Retire(uint64_t completedFenceValue);
+
+        /**
+         * @brief   Returns the size of the chunks threads allocate from.
+         */
+        uint32_t GetChunkSize() const { return m_ChunkSize; }
+
+        /**
+         * @brief   Returns the number of chunks in the ring.
+         */
+        uint32_t GetChunkCount() const { return m_ChunkCount; }
+
+        /**
+         * @brief   Returns the amount of memory currently held by in-flight frames.
+         */
+        uint64_t GetUsedSize() const;
+
+    private:
+        NO_COPY(FrameRingAllocator)
+        NO_MOVE(FrameRingAllocator)
+
+        bool AcquireChunks(uint32_t count, uint32_t& firstChunk);
+
+        struct FrameInfo
+        {
+            uint64_t FenceValue = 0;
+            uint64_t ChunkEnd   = 0;
+        };
+
+        const uint64_t          m_Generation;
+        const uint32_t          m_ChunkSize;
+        const uint32_t          m_ChunkCount;
+
+        // Chunks are counted monotonically, the ring index is the count modulo the number of chunks
+        std::atomic_uint64_t    m_AcquiredChunks = { 0 };
+        std::atomic_uint64_t    m_RetiredChunks  = { 0 };
+        std::atomic_uint64_t    m_FrameIndex     = { 0 };
+        std::queue<FrameInfo>   m_PendingFrames  = {};
+    };
+
+} // namespace cauldron
@@ -0,0 +1,134 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "hash.h"
+
+#include <cstring>
+
+namespace cauldron
+{
+    static constexpr uint64_t s_Prime1 = 0x9E3779B185EBCA87ull;
+    static constexpr uint64_t s_Prime2 = 0xC2B2AE3D27D4EB4Full;
+    static constexpr uint64_t s_Prime3 = 0x165667B19E3779F9ull;
+    static constexpr uint64_t s_Prime4 = 0x85EBCA77C2B2AE63ull;
+    static constexpr uint64_t s_Prime5 = 0x27D4EB2F165667C5ull;
+
+    static inline uint64_t RotateLeft(uint64_t value, uint32_t bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    // Unaligned little-endian reads
+    static inline uint64_t Read64(const uint8_t* pData)
+    {
+        uint64_t value;
+        memcpy(&value, pData, sizeof(value));
+        return value;
+    }
+
+    static inline uint32_t Read32(const uint8_t* pData)
+    {
+        uint32_t value;
+        memcpy(&value, pData, sizeof(value));
+        return value;
+    }
+
+    static inline uint64_t Round(uint64_t accumulator, uint64_t input)
+    {
+        accumulator += input * s_Prime2;
+        accumulator  = RotateLeft(accumulator, 31);
+        return accumulator * s_Prime1;
+    }
+
+    static inline uint64_t MergeRound(uint64_t accumulator, uint64_t value)
+    {
+        accumulator ^= Round(0, value);
+        return accumulator * s_Prime1 + s_Prime4;
+    }
+
+    uint64_t HashData64(const void* pData, size_t dataSize, uint64_t seed /*= 0*/)
+    {
+        const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(pData);
+        const uint8_t* pEnd   = pBytes + dataSize;
+
+        uint64_t hash;
+        if (dataSize >= 32)
+        {
+            // Process 32 byte stripes over 4 independent lanes
+            uint64_t v1 = seed + s_Prime1 + s_Prime2;
+            uint64_t v2 = seed + s_Prime2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - s_Prime1;
+
+            const uint8_t* pLimit = pEnd - 32;
+            do
+            {
+                v1 = Round(v1, Read64(pBytes));
+                v2 = Round(v2, Read64(pBytes + 8));
+                v3 = Round(v3, Read64(pBytes + 16));
+                v4 = Round(v4, Read64(pBytes + 24));
+                pBytes += 32;
+            } while (pBytes <= pLimit);
+
+            hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+            hash = MergeRound(hash, v1);
+            hash = MergeRound(hash, v2);
+            hash = MergeRound(hash, v3);
+            hash = MergeRound(hash, v4);
+        }
+        else
+        {
+            hash = seed + s_Prime5;
+        }
+
+        hash += static_cast<uint64_t>(dataSize);
+
+        // Consume the remaining bytes
+        for (; pBytes + 8 <= pEnd; pBytes += 8)
+        {
+            hash ^= Round(0, Read64(pBytes));
+            hash  = RotateLeft(hash, 27) * s_Prime1 + s_Prime4;
+        }
+
+        if (pBytes + 4 <= pEnd)
+        {
+            hash ^= static_cast<uint64_t>(Read32(pBytes)) * s_Prime1;
+            hash  = RotateLeft(hash, 23) * s_Prime2 + s_Prime3;
+            pBytes += 4;
+        }
+
+        for (; pBytes < pEnd; ++pBytes)
+        {
+            hash ^= (*pBytes) * s_Prime5;
+            hash  = RotateLeft(hash, 11) * s_Prime1;
+        }
+
+        // Final avalanche
+        hash ^= hash >> 33;
+        hash *= s_Prime2;
+        hash ^= hash >> 29;
+        hash *= s_Prime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+} // namespace cauldron
@@ -0,0 +1,46 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// @defgroup CauldronHash Hash
+/// Content hashing used to identify identical resource data.
+///
+/// @ingroup CauldronMisc
+
+namespace cauldron
+{
+    /// Computes the 64-bit xxHash (XXH64) of a block of memory.
+    ///
+    /// @param [in] pData       The data to hash.
+    /// @param [in] dataSize    The size of the data in bytes.
+    /// @param [in] seed        The seed to start hashing with (can be used to chain hashes).
+    ///
+    /// @returns                The 64-bit hash of the data.
+    ///
+    /// @ingroup CauldronHash
+    uint64_t HashData64(const void* pData, size_t dataSize, uint64_t seed = 0);
+
+} // namespace cauldron
@@ -29,6 +29,10 @@
     #include <codecvt>
     #include <locale>
 #endif  // #if defined(_WINDOWS)
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif  // #if defined(_MSC_VER)
+#include <chrono>
 #include <cmath>
 #include <string>
 
@@ -169,3 +173,69 @@ inline uint8_t CountBitsSet(uint32_t val) noexcept
 #endif
 }
 
+/// Finds the index of the lowest bit set to 1 in a 64-bit integer.
+///
+/// @param [in] val Integer mask, must not be 0.
+///
+/// @return Index of the least significant bit set in provided val.
+///
+/// @ingroup CauldronHelpers
+inline uint32_t FindLowestBitSet(uint64_t val) noexcept
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, val);
+    return static_cast<uint32_t>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_ctzll(val));
+#else
+    uint32_t index = 0;
+    while (!(val & 1ull))
+    {
+        val >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+/// Finds the index of the highest bit set to 1 in a 64-bit integer (i.e. floor(log2(val))).
+///
+/// @param [in] val Integer mask, must not be 0.
+///
+/// @return Index of the most significant bit set in provided val.
+///
+/// @ingroup CauldronHelpers
+inline uint32_t FindHighestBitSet(uint64_t val) noexcept
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, val);
+    return static_cast<uint32_t>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+    return 63u - static_cast<uint32_t>(__builtin_clzll(val));
+#else
+    uint32_t index = 0;
+    while (val >>= 1)
+        ++index;
+    return index;
+#endif
+}
+
+/// Reads a fast, monotonic CPU timestamp. The unit is unspecified (CPU cycles where the
+/// time stamp counter is available, nanoseconds otherwise), so callers need to calibrate
+/// against a steady clock to convert timestamps to time.
+///
+/// @return The current timestamp.
+///
+/// @ingroup CauldronHelpers
+inline uint64_t ReadCPUTimestamp() noexcept
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_ia32_rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
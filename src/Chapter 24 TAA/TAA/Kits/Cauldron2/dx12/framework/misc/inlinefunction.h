@@ -0,0 +1,213 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "assert.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cauldron
+{
+    /**
+     * @class InlineFunction
+     *
+     * Type-erased callable wrapper similar to std::function, but with a guaranteed inline storage size
+     * so that wrapping function pointers, lambdas and binds with small captures never touches the heap.
+     * Callables that don't fit the inline storage fall back to a heap allocation, which is counted and
+     * can be queried with <c><i>GetHeapFallbackCount</i></c>.
+     *
+     * @ingroup CauldronMisc
+     */
+    template<typename Signature, size_t Capacity = 64>
+    class InlineFunction;
+
+    template<typename R, typename... Args, size_t Capacity>
+    class InlineFunction<R(Args...), Capacity>
+    {
+    public:
+
+        /**
+         * @brief   Construction, empty function.
+         */
+        InlineFunction() = default;
+        InlineFunction(std::nullptr_t) {}
+
+        /**
+         * @brief   Construction from any callable invocable with the function's arguments.
+         */
+        template<typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, InlineFunction>::value>::type>
+        InlineFunction(F&& func)
+        {
+            Assign(std::forward<F>(func));
+        }
+
+        InlineFunction(const InlineFunction& other)
+        {
+            if (other.m_pOps)
+            {
+                other.m_pOps->pCopy(m_Storage, other.m_Storage);
+                m_pOps = other.m_pOps;
+            }
+        }
+
+        InlineFunction(InlineFunction&& other) noexcept
+        {
+            if (other.m_pOps)
+            {
+                other.m_pOps->pMove(m_Storage, other.m_Storage);
+                m_pOps = other.m_pOps;
+                other.Reset();
+            }
+        }
+
+        ~InlineFunction()
+        {
+            Reset();
+        }
+
+        InlineFunction& operator=(const InlineFunction& other)
+        {
+            if (this != &other)
+            {
+                Reset();
+                if (other.m_pOps)
+                {
+                    other.m_pOps->pCopy(m_Storage, other.m_Storage);
+                    m_pOps = other.m_pOps;
+                }
+            }
+            return *this;
+        }
+
+        InlineFunction& operator=(InlineFunction&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                if (other.m_pOps)
+                {
+                    other.m_pOps->pMove(m_Storage, other.m_Storage);
+                    m_pOps = other.m_pOps;
+                    other.Reset();
+                }
+            }
+            return *this;
+        }
+
+        /**
+         * @brief   Invokes the wrapped callable.
+         */
+        R operator()(Args... args) const
+        {
+            CauldronAssert(ASSERT_CRITICAL, m_pOps != nullptr, L"Calling an empty InlineFunction");
+            return m_pOps->pInvoke(const_cast<uint8_t*>(m_Storage), std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief   Returns true if a callable is set.
+         */
+        explicit operator bool() const { return m_pOps != nullptr; }
+
+        /**
+         * @brief   Returns the number of callables that were too large to be stored inline since startup.
+         */
+        static uint64_t GetHeapFallbackCount() { return s_HeapFallbackCount.load(std::memory_order_relaxed); }
+
+    private:
+        struct Ops
+        {
+            R    (*pInvoke)(void* pStorage, Args&&... args);
+            void (*pCopy)(void* pDst, const void* pSrc);
+            void (*pMove)(void* pDst, void* pSrc);
+            void (*pDestroy)(void* pStorage);
+        };
+
+        // Callables small enough (and cheap enough to move) are placed directly in our storage
+        template<typename F>
+        struct InlineOps
+        {
+            static R Invoke(void* pStorage, Args&&... args) { return (*static_cast<F*>(pStorage))(std::forward<Args>(args)...); }
+            static void Copy(void* pDst, const void* pSrc) { new (pDst) F(*static_cast<const F*>(pSrc)); }
+            static void Move(void* pDst, void* pSrc) { new (pDst) F(std::move(*static_cast<F*>(pSrc))); }
+            static void Destroy(void* pStorage) { static_cast<F*>(pStorage)->~F(); }
+            static constexpr Ops Table = { &Invoke, &Copy, &Move, &Destroy };
+        };
+
+        // Larger callables live on the heap and our storage only holds the pointer
+        template<typename F>
+        struct HeapOps
+        {
+            static F*& Get(void* pStorage) { return *static_cast<F**>(pStorage); }
+            static R Invoke(void* pStorage, Args&&... args) { return (*Get(pStorage))(std::forward<Args>(args)...); }
+            static void Copy(void* pDst, const void* pSrc)
+            {
+                ++s_HeapFallbackCount;
+                Get(pDst) = new F(**static_cast<F* const*>(pSrc));
+            }
+            static void Move(void* pDst, void* pSrc)
+            {
+                Get(pDst) = Get(pSrc);
+                Get(pSrc) = nullptr;
+            }
+            static void Destroy(void* pStorage) { delete Get(pStorage); }
+            static constexpr Ops Table = { &Invoke, &Copy, &Move, &Destroy };
+        };
+
+        template<typename F>
+        void Assign(F&& func)
+        {
+            typedef typename std::decay<F>::type Callable;
+            if constexpr (sizeof(Callable) <= Capacity && alignof(Callable) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible<Callable>::value)
+            {
+                new (m_Storage) Callable(std::forward<F>(func));
+                m_pOps = &InlineOps<Callable>::Table;
+            }
+            else
+            {
+                ++s_HeapFallbackCount;
+                *reinterpret_cast<Callable**>(m_Storage) = new Callable(std::forward<F>(func));
+                m_pOps = &HeapOps<Callable>::Table;
+            }
+        }
+
+        void Reset()
+        {
+            if (m_pOps)
+            {
+                m_pOps->pDestroy(m_Storage);
+                m_pOps = nullptr;
+            }
+        }
+
+        alignas(std::max_align_t) uint8_t m_Storage[Capacity];
+        const Ops*                        m_pOps = nullptr;
+
+        static inline std::atomic_uint64_t s_HeapFallbackCount = { 0 };
+    };
+
+} // namespace cauldron
@@ -22,8 +22,13 @@
 
 #include "log.h"
 #include "assert.h"
+#include "helpers.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdarg>
+#include <cstring>
+#include <cwchar>
 #include <iostream>
 #include <sstream>
 
@@ -36,24 +41,6 @@ namespace cauldron
     //////////////////////////////////////////////////////////////////////////
     // Helpers
 
-    int GetFormattedLength(const wchar_t* format, ...)
-    {
-        va_list vl;
-        va_start(vl, format);
-        int len = _vscwprintf(L" (%ls: %d)", vl);
-        va_end(vl);
-        return len;
-    }
-
-    int PrintInBuffer(wchar_t* data, int length, const wchar_t* format, ...)
-    {
-        va_list vl;
-        va_start(vl, format);
-        int len = _vsnwprintf_s(data, length, length, format, vl);
-        va_end(vl);
-        return len;
-    }
-
     void PrintMessage(std::wostream& os, const cauldron::MessageBuffer& msg)
     {
         time_t t = msg.Time();
@@ -151,6 +138,376 @@ namespace cauldron
             return m_static;
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    // Binary log records
+
+    // Argument types recovered from format strings (everything is widened to 8 bytes in the records)
+    enum class LogArgType : uint8_t
+    {
+        Int,
+        Long,
+        LongLong,
+        Double,
+        Pointer,
+        WideString,
+        NarrowString,
+    };
+
+    // A format string split in pieces holding at most one conversion each, so the worker can format
+    // the arguments one by one without having to rebuild a va_list
+    struct LogFormatSegment
+    {
+        std::wstring Format;
+        uint32_t     FirstArg;   // Index of the first argument consumed (including '*' width/precision)
+        uint32_t     ArgCount;   // 0 for trailing text, 1 + number of '*'
+    };
+
+    struct LogFormat
+    {
+        std::vector<LogFormatSegment> Segments;
+        std::vector<LogArgType>       ArgTypes;
+    };
+
+    struct LogRecordHeader
+    {
+        uint32_t       Size;        // Total record size in bytes (multiple of 8)
+        uint32_t       FormatId;
+        uint64_t       Timestamp;
+        const wchar_t* pFileName;   // Only for detailed messages (always a string literal)
+        int32_t        Line;
+        int32_t        Level;
+    };
+
+    static constexpr uint32_t s_MaxLogArgs          = 32;
+    static constexpr uint32_t s_MaxLogFormats       = 4096;
+    static constexpr uint32_t s_MaxLogStringLength  = 4096;
+    static constexpr uint32_t s_LogBufferSize       = 128 * 1024;
+    static constexpr uint32_t s_PaddingFormatId     = 0xffffffff;   // Skip to the start of the buffer
+    static constexpr uint32_t s_PreformattedId      = 0xfffffffe;   // Single string argument printed as is
+
+    static std::atomic_uint64_t s_LogGeneration = { 0 };
+
+    static uint64_t SteadyNanoseconds()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static constexpr uint32_t AlignRecordSize(size_t size)
+    {
+        return static_cast<uint32_t>((size + 7) & ~static_cast<size_t>(7));
+    }
+
+    // Scans the conversions of a format string, returning the argument types they consume and a hash of the string.
+    // Returns false for conversions we don't know how to capture, in which case the message gets formatted in place.
+    static bool ScanFormat(const wchar_t* text, LogArgType* pArgTypes, uint32_t& argCount, uint64_t& hash, bool& hasConversions)
+    {
+        hash           = 14695981039346656037ull;
+        argCount       = 0;
+        hasConversions = false;
+
+        const wchar_t* pChar = text;
+        auto next = [&]() {
+            hash = (hash ^ static_cast<uint64_t>(*pChar)) * 1099511628211ull;
+            return *pChar++;
+        };
+        auto pushArg = [&](LogArgType type) {
+            if (argCount == s_MaxLogArgs)
+                return false;
+            pArgTypes[argCount++] = type;
+            return true;
+        };
+
+        while (*pChar)
+        {
+            if (next() != L'%')
+                continue;
+
+            hasConversions = true;
+            if (*pChar == L'%')
+            {
+                next();
+                continue;
+            }
+
+            // Flags, width and precision
+            while (*pChar && wcschr(L"-+ #0", *pChar))
+                next();
+            for (int32_t field = 0; field < 2; ++field)
+            {
+                if (field == 1)
+                {
+                    if (*pChar != L'.')
+                        break;
+                    next();
+                }
+
+                if (*pChar == L'*')
+                {
+                    next();
+                    if (!pushArg(LogArgType::Int))
+                        return false;
+                }
+                while (*pChar >= L'0' && *pChar <= L'9')
+                    next();
+            }
+
+            // Length modifiers
+            int32_t longCount  = 0;
+            bool    is64Bit    = false;
+            bool    isNarrow   = false;
+            bool    isWide     = false;
+            for (bool parsing = true; parsing && *pChar;)
+            {
+                switch (*pChar)
+                {
+                case L'l': ++longCount; isWide = true; next(); break;
+                case L'w': isWide = true; next(); break;
+                case L'h': isNarrow = true; next(); break;
+                case L'j': case L'z': case L't': is64Bit = true; next(); break;
+                case L'L': next(); break;
+                case L'I':
+                    next();
+                    if (pChar[0] == L'6' && pChar[1] == L'4')
+                    {
+                        next(); next();
+                        is64Bit = true;
+                    }
+                    else if (pChar[0] == L'3' && pChar[1] == L'2')
+                    {
+                        next(); next();
+                    }
+                    else
+                    {
+                        is64Bit = sizeof(size_t) == 8;
+                    }
+                    break;
+                default: parsing = false; break;
+                }
+            }
+
+            bool validConversion = true;
+            switch (*pChar ? next() : L'\0')
+            {
+            case L'd': case L'i': case L'o': case L'u': case L'x': case L'X':
+                validConversion = pushArg(is64Bit || longCount > 1 ? LogArgType::LongLong : (longCount == 1 ? LogArgType::Long : LogArgType::Int));
+                break;
+            case L'c': case L'C':
+                validConversion = pushArg(LogArgType::Int);
+                break;
+            case L'e': case L'E': case L'f': case L'F': case L'g': case L'G': case L'a': case L'A':
+                // Long doubles are captured as doubles, which only loses precision where they differ
+                validConversion = pushArg(LogArgType::Double);
+                break;
+            case L'p':
+                validConversion = pushArg(LogArgType::Pointer);
+                break;
+            case L's':
+#ifdef _MSC_VER
+                // Microsoft's wide printf functions treat %s as a wide string
+                validConversion = pushArg(isNarrow ? LogArgType::NarrowString : LogArgType::WideString);
+#else
+                validConversion = pushArg(isWide ? LogArgType::WideString : LogArgType::NarrowString);
+#endif
+                break;
+            case L'S':
+#ifdef _MSC_VER
+                validConversion = pushArg(isWide ? LogArgType::WideString : LogArgType::NarrowString);
+#else
+                validConversion = pushArg(LogArgType::WideString);
+#endif
+                break;
+            default:
+                validConversion = false;
+                break;
+            }
+
+            if (!validConversion)
+                return false;
+        }
+
+        return true;
+    }
+
+    // Splits a format string in single conversion segments (ScanFormat already validated it)
+    static LogFormat* BuildFormat(const wchar_t* text, const LogArgType* pArgTypes, uint32_t argCount)
+    {
+        LogFormat* pFormat = new LogFormat();
+        pFormat->ArgTypes.assign(pArgTypes, pArgTypes + argCount);
+
+        uint32_t       argIndex      = 0;
+        const wchar_t* pSegmentStart = text;
+        const wchar_t* pChar         = text;
+        while (*pChar)
+        {
+            if (*pChar++ != L'%')
+                continue;
+            if (*pChar == L'%')
+            {
+                ++pChar;
+                continue;
+            }
+
+            // Find the conversion character, counting '*' as we go
+            uint32_t segmentArgs = 1;
+            while (*pChar && !wcschr(L"diouxXcCeEfFgGaApsS", *pChar))
+            {
+                if (*pChar == L'*')
+                    ++segmentArgs;
+                ++pChar;
+            }
+            if (*pChar)
+                ++pChar;
+
+            pFormat->Segments.push_back({ std::wstring(pSegmentStart, pChar), argIndex, segmentArgs });
+            argIndex += segmentArgs;
+            pSegmentStart = pChar;
+        }
+
+        if (pChar != pSegmentStart)
+            pFormat->Segments.push_back({ std::wstring(pSegmentStart, pChar), argIndex, 0 });
+        return pFormat;
+    }
+
+    // Appends printf style output to a string
+    template<typename... Args>
+    static void AppendFormatted(std::wstring& output, const wchar_t* format, Args... args)
+    {
+        wchar_t localBuffer[256];
+        int length = swprintf(localBuffer, 256, format, args...);
+        if (length >= 0)
+        {
+            output.append(localBuffer, length);
+            return;
+        }
+
+        // Didn't fit, grow until it does
+        std::vector<wchar_t> buffer(1024);
+        while ((length = swprintf(buffer.data(), buffer.size(), format, args...)) < 0 && buffer.size() < (1u << 24))
+            buffer.resize(buffer.size() * 2);
+        if (length > 0)
+            output.append(buffer.data(), length);
+    }
+
+    union LogArgValue
+    {
+        int64_t     Integer;
+        double      Real;
+        const void* pPointer;
+    };
+
+    /**
+     * Single-producer (the owning thread) / single-consumer (the log worker) byte ring holding binary log records.
+     * Records never wrap, a padding record fills the end of the buffer when the next record doesn't fit.
+     * The owning thread and the log share ownership, the last one to release the buffer deletes it.
+     */
+    class LogThreadBuffer
+    {
+    public:
+        LogThreadBuffer() : m_Data(s_LogBufferSize) {}
+
+        // Producer side. Returns nullptr if there is no room.
+        uint8_t* BeginWrite(uint32_t size)
+        {
+            const uint64_t writePos = m_WritePos.load(std::memory_order_relaxed);
+            const uint64_t readPos  = m_ReadPos.load(std::memory_order_acquire);
+            const uint32_t offset   = static_cast<uint32_t>(writePos % s_LogBufferSize);
+            const uint32_t padding  = (offset + size > s_LogBufferSize) ? s_LogBufferSize - offset : 0;
+            if (writePos + padding + size - readPos > s_LogBufferSize)
+            {
+                ++m_Dropped;
+                return nullptr;
+            }
+
+            if (padding)
+            {
+                LogRecordHeader* pPadding = reinterpret_cast<LogRecordHeader*>(m_Data.data() + offset);
+                pPadding->Size     = padding;
+                pPadding->FormatId = s_PaddingFormatId;
+            }
+
+            m_PendingWritePos = writePos + padding;
+            return m_Data.data() + (m_PendingWritePos % s_LogBufferSize);
+        }
+
+        void EndWrite(uint32_t size)
+        {
+            m_WritePos.store(m_PendingWritePos + size, std::memory_order_release);
+        }
+
+        // Consumer side. Returns the next record (skipping padding), or nullptr if there is none.
+        const uint8_t* Peek()
+        {
+            const uint64_t writePos = m_WritePos.load(std::memory_order_acquire);
+            uint64_t       readPos  = m_ReadPos.load(std::memory_order_relaxed);
+            while (readPos < writePos)
+            {
+                const uint8_t* pRecord = m_Data.data() + (readPos % s_LogBufferSize);
+                const LogRecordHeader* pHeader = reinterpret_cast<const LogRecordHeader*>(pRecord);
+                if (pHeader->FormatId != s_PaddingFormatId)
+                    return pRecord;
+
+                readPos += pHeader->Size;
+                m_ReadPos.store(readPos, std::memory_order_release);
+            }
+            return nullptr;
+        }
+
+        void Consume(const uint8_t* pRecord)
+        {
+            const uint64_t readPos = m_ReadPos.load(std::memory_order_relaxed);
+            m_ReadPos.store(readPos + reinterpret_cast<const LogRecordHeader*>(pRecord)->Size, std::memory_order_release);
+        }
+
+        uint64_t GetDroppedCount() const { return m_Dropped.load(std::memory_order_relaxed); }
+        void CountDrop() { ++m_Dropped; }
+
+        // Producer side, the owning thread won't write anymore (it exited or moved on to a new log instance)
+        void Retire() { m_Retired.store(true, std::memory_order_release); }
+
+        // Consumer side, all records were written and consumed
+        bool IsDrained()
+        {
+            return m_Retired.load(std::memory_order_acquire) && !Peek();
+        }
+
+        static void Release(LogThreadBuffer* pBuffer)
+        {
+            if (pBuffer->m_References.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                delete pBuffer;
+        }
+
+    private:
+        std::vector<uint8_t>             m_Data;
+        uint64_t                         m_PendingWritePos = 0;
+        alignas(64) std::atomic_uint64_t m_WritePos        = { 0 };
+        alignas(64) std::atomic_uint64_t m_ReadPos         = { 0 };
+        std::atomic_uint64_t             m_Dropped         = { 0 };
+        std::atomic_bool                 m_Retired         = { false };
+        std::atomic_uint32_t             m_References      = { 2 };     // Owning thread and log
+    };
+
+    // Each thread caches its buffer and the ids of the format strings it has used (keyed on their content hash)
+    struct LogThreadState
+    {
+        uint64_t                               Generation = 0;
+        LogThreadBuffer*                       pBuffer    = nullptr;
+        std::unordered_map<uint64_t, uint32_t> FormatIds  = {};
+
+        // Hands the buffer over to the log worker, which frees it once drained
+        void RetireBuffer()
+        {
+            if (pBuffer)
+            {
+                pBuffer->Retire();
+                LogThreadBuffer::Release(pBuffer);
+                pBuffer = nullptr;
+            }
+        }
+
+        ~LogThreadState() { RetireBuffer(); }
+    };
+    static thread_local LogThreadState s_LogThreadState;
+
     //////////////////////////////////////////////////////////////////////////
     // Log
     
@@ -181,21 +538,38 @@ namespace cauldron
     }
 
     Log::Log(const wchar_t* filename)
-        : m_messageBuffer()
+        : m_generation(++s_LogGeneration)
+        , m_reportedDrops(0)
+        , m_retiredDrops(0)
+        , m_startTimestamp(ReadCPUTimestamp())
+        , m_startTime(time(0))
+        , m_timestampFrequency(0.0)
+        , m_running(true)
         , m_output(filename, std::ofstream::out)
-        , m_thread(&Log::Worker, this)
         , m_messagesLock()
         , m_messageStartIndex(0)
         , m_messageCount(0)
         , m_messagesRingBuffer()
     {
+        // Everything needs to be set up before the worker starts
+        m_thread = std::thread(&Log::Worker, this);
     }
 
     Log::~Log()
     {
-        m_messageBuffer.Close();
+        {
+            std::lock_guard<std::mutex> lock(m_wakeLock);
+            m_running = false;
+        }
+        m_wakeCondition.notify_one();
         m_thread.join();
         m_output.close();
+
+        // Buffers of threads still running are deleted when they exit
+        for (LogThreadBuffer* pBuffer : m_threadBuffers)
+            LogThreadBuffer::Release(pBuffer);
+        for (LogFormat* pFormat : m_formats)
+            delete pFormat;
     }
 
 
@@ -221,57 +595,400 @@ namespace cauldron
         }
     }
 
+    LogThreadBuffer* Log::GetThreadBuffer()
+    {
+        // Register a buffer the first time this thread logs (or after the log system was re-created)
+        LogThreadState& state = s_LogThreadState;
+        if (state.Generation != m_generation)
+        {
+            state.RetireBuffer();
+            state.Generation = m_generation;
+            state.pBuffer    = new LogThreadBuffer();
+            state.FormatIds.clear();
+
+            std::lock_guard<std::mutex> lock(m_threadBuffersLock);
+            m_threadBuffers.push_back(state.pBuffer);
+        }
+        return state.pBuffer;
+    }
+
+    uint32_t Log::RegisterFormat(const wchar_t* text, uint64_t hash)
+    {
+        std::lock_guard<std::mutex> lock(m_formatsLock);
+        auto formatIt = m_formatIds.find(hash);
+        if (formatIt != m_formatIds.end())
+            return formatIt->second;
+
+        if (m_formats.size() >= s_MaxLogFormats)
+            return s_PreformattedId;
+
+        LogArgType argTypes[s_MaxLogArgs];
+        uint32_t   argCount       = 0;
+        bool       hasConversions = false;
+        ScanFormat(text, argTypes, argCount, hash, hasConversions);
+
+        const uint32_t formatId = static_cast<uint32_t>(m_formats.size());
+        m_formats.push_back(BuildFormat(text, argTypes, argCount));
+        m_formatIds.emplace(hash, formatId);
+        return formatId;
+    }
+
     void Log::QueueMessage(LogLevel level, const wchar_t* filename, int line, const wchar_t* text, va_list args)
     {
-        time_t now = time(0);
-        
-        int body_len = _vscwprintf(text, args);
+        const uint64_t timestamp = ReadCPUTimestamp();
+        LogThreadBuffer* pBuffer = GetThreadBuffer();
 
-        const wchar_t* filename_format = L" (%ls: %d)";
-        int filename_len = 0;
-        if (filename != nullptr)
-            filename_len = GetFormattedLength(filename_format, filename, line);
+        LogArgType argTypes[s_MaxLogArgs];
+        uint32_t   argCount       = 0;
+        uint64_t   hash           = 0;
+        bool       hasConversions = false;
+        uint32_t   formatId       = s_PreformattedId;
+        if (ScanFormat(text, argTypes, argCount, hash, hasConversions) && hasConversions)
+        {
+            // Messages without any conversion (i.e. pre-formatted asserts) are copied as is instead of filling up the format table
+            auto formatIt = s_LogThreadState.FormatIds.find(hash);
+            if (formatIt != s_LogThreadState.FormatIds.end())
+            {
+                formatId = formatIt->second;
+            }
+            else
+            {
+                formatId = RegisterFormat(text, hash);
+                if (formatId != s_PreformattedId)
+                    s_LogThreadState.FormatIds.emplace(hash, formatId);
+            }
+        }
 
-        int total_len = body_len + filename_len + 1;
-        MessageBuffer msg(total_len, level, now);
+        // Capture the arguments (or the formatted message if the format can't be deferred)
+        LogArgValue  argValues[s_MaxLogArgs];
+        uint32_t     stringLengths[s_MaxLogArgs];
+        std::wstring preformatted;
+        if (formatId == s_PreformattedId)
+        {
+            if (hasConversions)
+            {
+                std::vector<wchar_t> buffer(256);
+                va_list argsCopy;
+                int length;
+                while (true)
+                {
+                    va_copy(argsCopy, args);
+                    length = vswprintf(buffer.data(), buffer.size(), text, argsCopy);
+                    va_end(argsCopy);
+                    if (length >= 0 || buffer.size() >= (1u << 20))
+                        break;
+                    buffer.resize(buffer.size() * 2);
+                }
+                preformatted.assign(buffer.data(), std::max(length, 0));
+            }
+            else
+            {
+                preformatted = text;
+            }
 
-        int offset = 0;
+            argCount              = 1;
+            argTypes[0]           = LogArgType::WideString;
+            argValues[0].pPointer = preformatted.c_str();
+        }
+        else
+        {
+            for (uint32_t i = 0; i < argCount; ++i)
+            {
+                switch (argTypes[i])
+                {
+                case LogArgType::Int:          argValues[i].Integer  = va_arg(args, int); break;
+                case LogArgType::Long:         argValues[i].Integer  = va_arg(args, long); break;
+                case LogArgType::LongLong:     argValues[i].Integer  = va_arg(args, long long); break;
+                case LogArgType::Double:       argValues[i].Real     = va_arg(args, double); break;
+                case LogArgType::Pointer:      argValues[i].pPointer = va_arg(args, void*); break;
+                case LogArgType::WideString:   argValues[i].pPointer = va_arg(args, const wchar_t*); break;
+                case LogArgType::NarrowString: argValues[i].pPointer = va_arg(args, const char*); break;
+                }
+            }
+        }
 
-        offset += vswprintf_s(msg.Data() + offset, (size_t)total_len - (size_t)offset, text, args);
+        // Size the record
+        size_t recordSize = sizeof(LogRecordHeader);
+        for (uint32_t i = 0; i < argCount; ++i)
+        {
+            recordSize += sizeof(LogArgValue);
+            if (argTypes[i] == LogArgType::WideString || argTypes[i] == LogArgType::NarrowString)
+            {
+                const bool   wide     = argTypes[i] == LogArgType::WideString;
+                const size_t maxChars = (formatId == s_PreformattedId) ? s_LogBufferSize / 4 / sizeof(wchar_t) : s_MaxLogStringLength;
+                size_t       length   = 6;   // "(null)"
+                if (argValues[i].pPointer)
+                    length = wide ? wcslen(static_cast<const wchar_t*>(argValues[i].pPointer)) : strlen(static_cast<const char*>(argValues[i].pPointer));
+                stringLengths[i] = static_cast<uint32_t>(std::min(length, maxChars));
+                recordSize += AlignRecordSize((stringLengths[i] + 1) * (wide ? sizeof(wchar_t) : sizeof(char)));
+            }
+        }
 
-        if (filename != nullptr)
+        const uint32_t alignedSize = AlignRecordSize(recordSize);
+        if (alignedSize > s_LogBufferSize / 2)
         {
-            offset += PrintInBuffer(msg.Data() + offset, total_len - offset, filename_format, filename, line);
-            msg.Data()[total_len - 1] = L'\0';
+            pBuffer->CountDrop();
+            return;
         }
 
-        m_messageBuffer.PushBack(std::move(msg));
+        uint8_t* pRecord = pBuffer->BeginWrite(alignedSize);
+        if (!pRecord)
+            return;
+
+        LogRecordHeader* pHeader = reinterpret_cast<LogRecordHeader*>(pRecord);
+        pHeader->Size      = alignedSize;
+        pHeader->FormatId  = formatId;
+        pHeader->Timestamp = timestamp;
+        pHeader->pFileName = filename;
+        pHeader->Line      = line;
+        pHeader->Level     = level;
+
+        // Arguments follow, strings are copied inline after their length
+        uint8_t* pData = pRecord + sizeof(LogRecordHeader);
+        for (uint32_t i = 0; i < argCount; ++i)
+        {
+            LogArgValue* pValue = reinterpret_cast<LogArgValue*>(pData);
+            pData += sizeof(LogArgValue);
+            if (argTypes[i] != LogArgType::WideString && argTypes[i] != LogArgType::NarrowString)
+            {
+                *pValue = argValues[i];
+                continue;
+            }
+
+            pValue->Integer = stringLengths[i];
+            if (argTypes[i] == LogArgType::WideString)
+            {
+                const wchar_t* pString = argValues[i].pPointer ? static_cast<const wchar_t*>(argValues[i].pPointer) : L"(null)";
+                memcpy(pData, pString, stringLengths[i] * sizeof(wchar_t));
+                reinterpret_cast<wchar_t*>(pData)[stringLengths[i]] = L'\0';
+                pData += AlignRecordSize((stringLengths[i] + 1) * sizeof(wchar_t));
+            }
+            else
+            {
+                const char* pString = argValues[i].pPointer ? static_cast<const char*>(argValues[i].pPointer) : "(null)";
+                memcpy(pData, pString, stringLengths[i]);
+                reinterpret_cast<char*>(pData)[stringLengths[i]] = '\0';
+                pData += AlignRecordSize(stringLengths[i] + 1);
+            }
+        }
+
+        pBuffer->EndWrite(alignedSize);
+
+        // Don't keep errors waiting
+        if (level >= LOGLEVEL_ERROR)
+            m_wakeCondition.notify_one();
+    }
+
+    void Log::FormatRecord(const uint8_t* pRecord, std::wstring& message, time_t& time, LogLevel& level)
+    {
+        const LogRecordHeader* pHeader = reinterpret_cast<const LogRecordHeader*>(pRecord);
+        level = static_cast<LogLevel>(pHeader->Level);
+
+        // Timestamps are converted with the frequency measured since startup
+        if (m_timestampFrequency > 0.0 && pHeader->Timestamp > m_startTimestamp)
+            time = m_startTime + static_cast<time_t>(static_cast<double>(pHeader->Timestamp - m_startTimestamp) / m_timestampFrequency);
+        else
+            time = m_startTime;
+
+        // Gather argument pointers
+        const LogFormat* pFormat = nullptr;
+        if (pHeader->FormatId != s_PreformattedId)
+        {
+            std::lock_guard<std::mutex> lock(m_formatsLock);
+            pFormat = m_formats[pHeader->FormatId];
+        }
+
+        const uint8_t* pData = pRecord + sizeof(LogRecordHeader);
+        auto readArg = [&pData](LogArgType type) {
+            LogArgValue value = *reinterpret_cast<const LogArgValue*>(pData);
+            pData += sizeof(LogArgValue);
+            if (type == LogArgType::WideString || type == LogArgType::NarrowString)
+            {
+                const size_t charSize = (type == LogArgType::WideString) ? sizeof(wchar_t) : sizeof(char);
+                const size_t length   = static_cast<size_t>(value.Integer);
+                value.pPointer = pData;
+                pData += AlignRecordSize((length + 1) * charSize);
+            }
+            return value;
+        };
+
+        message.clear();
+        if (!pFormat)
+        {
+            message = static_cast<const wchar_t*>(readArg(LogArgType::WideString).pPointer);
+        }
+        else
+        {
+            LogArgValue args[s_MaxLogArgs];
+            for (size_t i = 0; i < pFormat->ArgTypes.size(); ++i)
+                args[i] = readArg(pFormat->ArgTypes[i]);
+
+            for (const LogFormatSegment& segment : pFormat->Segments)
+            {
+                if (segment.ArgCount == 0)
+                {
+                    AppendFormatted(message, segment.Format.c_str());
+                    continue;
+                }
+
+                // '*' width and precision come first, the value last
+                const uint32_t   valueIndex = segment.FirstArg + segment.ArgCount - 1;
+                const LogArgValue& value    = args[valueIndex];
+                auto appendValue = [&](auto typedValue) {
+                    if (segment.ArgCount == 1)
+                        AppendFormatted(message, segment.Format.c_str(), typedValue);
+                    else if (segment.ArgCount == 2)
+                        AppendFormatted(message, segment.Format.c_str(), static_cast<int>(args[segment.FirstArg].Integer), typedValue);
+                    else
+                        AppendFormatted(message, segment.Format.c_str(), static_cast<int>(args[segment.FirstArg].Integer), static_cast<int>(args[segment.FirstArg + 1].Integer), typedValue);
+                };
+
+                switch (pFormat->ArgTypes[valueIndex])
+                {
+                case LogArgType::Int:          appendValue(static_cast<int>(value.Integer)); break;
+                case LogArgType::Long:         appendValue(static_cast<long>(value.Integer)); break;
+                case LogArgType::LongLong:     appendValue(static_cast<long long>(value.Integer)); break;
+                case LogArgType::Double:       appendValue(value.Real); break;
+                case LogArgType::Pointer:      appendValue(value.pPointer); break;
+                case LogArgType::WideString:   appendValue(static_cast<const wchar_t*>(value.pPointer)); break;
+                case LogArgType::NarrowString: appendValue(static_cast<const char*>(value.pPointer)); break;
+                }
+            }
+        }
+
+        if (pHeader->pFileName)
+            AppendFormatted(message, L" (%ls: %d)", pHeader->pFileName, pHeader->Line);
+    }
+
+    size_t Log::FlushThreadBuffers()
+    {
+        std::vector<LogThreadBuffer*> buffers;
+        {
+            std::lock_guard<std::mutex> lock(m_threadBuffersLock);
+            buffers = m_threadBuffers;
+        }
+
+        // Calibrate the timestamp frequency against the steady clock as time goes by
+        static const uint64_t s_StartNanoseconds = SteadyNanoseconds();
+        const uint64_t elapsedNanoseconds = SteadyNanoseconds() - s_StartNanoseconds;
+        if (elapsedNanoseconds > 1000000)
+            m_timestampFrequency = static_cast<double>(ReadCPUTimestamp() - m_startTimestamp) * 1e9 / static_cast<double>(elapsedNanoseconds);
+
+        // Merge the records of all threads in timestamp order
+        size_t       processedCount = 0;
+        std::wstring message;
+        while (true)
+        {
+            LogThreadBuffer* pOldestBuffer = nullptr;
+            const uint8_t*   pOldestRecord = nullptr;
+            for (LogThreadBuffer* pBuffer : buffers)
+            {
+                const uint8_t* pRecord = pBuffer->Peek();
+                if (pRecord && (!pOldestRecord || reinterpret_cast<const LogRecordHeader*>(pRecord)->Timestamp < reinterpret_cast<const LogRecordHeader*>(pOldestRecord)->Timestamp))
+                {
+                    pOldestBuffer = pBuffer;
+                    pOldestRecord = pRecord;
+                }
+            }
+
+            if (!pOldestRecord)
+                break;
+
+            time_t   time;
+            LogLevel level;
+            FormatRecord(pOldestRecord, message, time, level);
+            pOldestBuffer->Consume(pOldestRecord);
+
+            MessageBuffer msg(message.size() + 1, level, time);
+            memcpy(msg.Data(), message.c_str(), (message.size() + 1) * sizeof(wchar_t));
+            ProcessMessage(msg);
+            ++processedCount;
+        }
+
+        // Free the buffers of exited threads once everything they logged went out
+        auto retiredIt = std::partition(buffers.begin(), buffers.end(), [](LogThreadBuffer* pBuffer) { return !pBuffer->IsDrained(); });
+        if (retiredIt != buffers.end())
+        {
+            std::lock_guard<std::mutex> lock(m_threadBuffersLock);
+            for (auto it = retiredIt; it != buffers.end(); ++it)
+            {
+                m_retiredDrops += (*it)->GetDroppedCount();
+                m_threadBuffers.erase(std::find(m_threadBuffers.begin(), m_threadBuffers.end(), *it));
+                LogThreadBuffer::Release(*it);
+            }
+            buffers.erase(retiredIt, buffers.end());
+        }
+
+        // Let the user know if messages got lost
+        uint64_t droppedCount = m_retiredDrops;
+        for (LogThreadBuffer* pBuffer : buffers)
+            droppedCount += pBuffer->GetDroppedCount();
+        if (droppedCount > m_reportedDrops)
+        {
+            message.clear();
+            AppendFormatted(message, L"%llu log message(s) dropped, a thread's log buffer was full.", static_cast<unsigned long long>(droppedCount - m_reportedDrops));
+            m_reportedDrops = droppedCount;
+
+            MessageBuffer msg(message.size() + 1, LOGLEVEL_WARNING, time(0));
+            memcpy(msg.Data(), message.c_str(), (message.size() + 1) * sizeof(wchar_t));
+            ProcessMessage(msg);
+        }
+
+        return processedCount;
     }
 
     void Log::Worker() {
         std::cout << "Log Worker thread started" << std::endl;
-        MessageBuffer msg;
-        while (m_messageBuffer.Pop(msg))
-        {
-            // write in the file
-            PrintMessage(m_output, msg);
-            
-            // output to debugger console
-            OutputToDebugger(msg);
-
-            // save in the buffer of last messages
-            std::lock_guard<std::mutex> lk(m_messagesLock);
-            int index = (m_messageStartIndex + m_messageCount) % s_MAX_SAVED_MESSAGES;
-            if (m_messageCount == s_MAX_SAVED_MESSAGES)
-                ++m_messageStartIndex;
-            else
-                ++m_messageCount;
-            m_messagesRingBuffer[index] = std::move(msg);
+
+        while (true)
+        {
+            // Make sure everything logged before shutdown gets flushed
+            const bool running = m_running;
+            const size_t processedCount = FlushThreadBuffers();
+            if (!running)
+                break;
+
+            // Producers never block on us, so just check back regularly when idle
+            if (processedCount == 0)
+            {
+                std::unique_lock<std::mutex> lock(m_wakeLock);
+                m_wakeCondition.wait_for(lock, std::chrono::milliseconds(2), [this] { return !m_running; });
+            }
         }
 
         std::cout << "Log Worker thread ended" << std::endl;
     }
 
+    void Log::ProcessMessage(MessageBuffer& msg)
+    {
+        // write in the file
+        PrintMessage(m_output, msg);
+
+        // output to debugger console
+        OutputToDebugger(msg);
+
+        // save in the buffer of last messages
+        std::lock_guard<std::mutex> lk(m_messagesLock);
+        size_t index = (m_messageStartIndex + m_messageCount) % s_MAX_SAVED_MESSAGES;
+        if (m_messageCount == s_MAX_SAVED_MESSAGES)
+            m_messageStartIndex = (m_messageStartIndex + 1) % s_MAX_SAVED_MESSAGES;
+        else
+            ++m_messageCount;
+        m_messagesRingBuffer[index] = std::move(msg);
+    }
+
+    uint64_t Log::GetDroppedMessageCount()
+    {
+        if (s_pLogInstance == nullptr)
+            return 0;
+
+        std::lock_guard<std::mutex> lock(s_pLogInstance->m_threadBuffersLock);
+        uint64_t droppedCount = s_pLogInstance->m_retiredDrops;
+        for (LogThreadBuffer* pBuffer : s_pLogInstance->m_threadBuffers)
+            droppedCount += pBuffer->GetDroppedCount();
+        return droppedCount;
+    }
+
     void Log::OutputToDebugger(const MessageBuffer& msg)
     {
 #ifdef WIN32
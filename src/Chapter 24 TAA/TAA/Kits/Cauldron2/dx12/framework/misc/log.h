@@ -22,18 +22,23 @@
 
 #pragma once
 
-#include "threadsafe_ringbuffer.h"
-
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
 #include <mutex>
 #include <stdint.h>
+#include <string>
 #include <thread>
 #include <time.h>
+#include <unordered_map>
 #include <vector>
 #include <array>
 
 namespace cauldron
 {
+    class LogThreadBuffer;
+    struct LogFormat;
+
     /// An enumeration of message log types.
     ///
     /// @ingroup CauldronMisc
@@ -182,6 +187,11 @@ namespace cauldron
      *
      * This is the logger for FidelityFX Cauldron Framework. It provides a static interface for message logging.
      *
+     * Logging threads don't format messages. Each thread appends a compact binary record (format id, raw arguments
+     * and a CPU timestamp) to its own lock-free single-producer buffer. The log worker thread merges the records of
+     * all threads in timestamp order, formats them and flushes them to the log file. If a thread's buffer is full
+     * the message is dropped and counted rather than stalling the thread; drops are reported in the log.
+     *
      * @ingroup CauldronMisc
      */
     class Log
@@ -233,21 +243,49 @@ namespace cauldron
          */
         static void QueryMessageCounts(std::array<uint32_t, LOGLEVEL_COUNT>& countAray);
 
+        /**
+         * @brief   Returns the number of messages dropped because a thread's log buffer was full.
+         */
+        static uint64_t GetDroppedMessageCount();
+
     private:
         static_assert(LOGLEVEL_COUNT == 6, L"Number of log levels has changed. Please fix up impacted code.");
         static Log* s_pLogInstance;
 
         void QueueMessage(LogLevel level, const wchar_t* filename, int line, const wchar_t* text, va_list args);
+        LogThreadBuffer* GetThreadBuffer();
+        uint32_t RegisterFormat(const wchar_t* text, uint64_t hash);
         void Worker();
+        size_t FlushThreadBuffers();
+        void FormatRecord(const uint8_t* pRecord, std::wstring& message, time_t& time, LogLevel& level);
+        void ProcessMessage(MessageBuffer& msg);
         void OutputToDebugger(const MessageBuffer& msg);
         std::wstring FilterMessages(int32_t flags);
         void GetAllMessageBuffers(std::vector<LogMessageEntry>& messages, int32_t flags);
         void QueryMessageBufferCounts(std::array<uint32_t, LOGLEVEL_COUNT>& countAray);
 
     private:
-        static constexpr size_t s_MESSAGE_BUFFER_SIZE = 16;
-        ThreadSafeRingBuffer<MessageBuffer, s_MESSAGE_BUFFER_SIZE> m_messageBuffer; // a buffer storing the message before they are put in the output file
-        std::thread m_thread;
+        // Per-thread record buffers (registered once per thread, drained by the worker and freed once their thread exits)
+        std::mutex                    m_threadBuffersLock;
+        std::vector<LogThreadBuffer*> m_threadBuffers;
+        uint64_t                      m_generation;
+        uint64_t                      m_reportedDrops;
+        uint64_t                      m_retiredDrops;   // Drops of the buffers already freed
+
+        // Format strings seen so far, records reference them by index
+        std::mutex                             m_formatsLock;
+        std::vector<LogFormat*>                m_formats;
+        std::unordered_map<uint64_t, uint32_t> m_formatIds;
+
+        // Timestamp to wall clock conversion
+        uint64_t m_startTimestamp;
+        time_t   m_startTime;
+        double   m_timestampFrequency;
+
+        std::atomic_bool        m_running;
+        std::mutex              m_wakeLock;
+        std::condition_variable m_wakeCondition;
+        std::thread             m_thread;
 
         std::wofstream m_output; // the file output
         
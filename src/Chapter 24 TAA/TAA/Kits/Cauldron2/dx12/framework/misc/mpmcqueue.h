@@ -0,0 +1,218 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace cauldron
+{
+    /**
+     * @class MPMCQueue
+     *
+     * Lock-free bounded multi-producer/multi-consumer FIFO (Vyukov-style sequenced ring). Each cell carries a
+     * sequence number telling producers and consumers whether it is free or filled for their lap around the ring,
+     * so both sides only contend on a single atomic increment. Supports move-only types. Backs <c><i>ThreadSafeQueue</i></c>.
+     *
+     * @ingroup CauldronMisc
+     */
+    template<typename T>
+    class MPMCQueue
+    {
+    public:
+
+        /**
+         * @brief   Construction with the maximum number of items (rounded up to a power of 2).
+         */
+        explicit MPMCQueue(size_t capacity);
+
+        /**
+         * @brief   Destruction. Destroys any item still in the queue.
+         */
+        ~MPMCQueue();
+
+        /**
+         * @brief   Tries to push a value at the back of the queue. The value is only moved from on success.
+         *          Returns false if the queue is full.
+         */
+        template<typename U>
+        bool TryPush(U&& value);
+
+        /**
+         * @brief   Tries to pop the value at the front of the queue.
+         *          Returns false if the queue is empty.
+         */
+        bool TryPop(T& value);
+
+        /**
+         * @brief   Returns the number of items in the queue (approximate while other threads are pushing or popping).
+         */
+        size_t Size() const;
+
+        /**
+         * @brief   Returns the maximum number of items the queue can hold.
+         */
+        size_t Capacity() const { return m_Mask + 1; }
+
+        /**
+         * @brief   Calls func on every item in the queue, front to back. The queue must not be modified concurrently.
+         */
+        template<typename Func>
+        void ForEach(Func func) const;
+
+    private:
+        // No Copy, No Move
+        MPMCQueue(const MPMCQueue&) = delete;
+        MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+        struct Cell
+        {
+            std::atomic<size_t>             Sequence;
+            alignas(T) unsigned char        Storage[sizeof(T)];
+
+            T* Get() { return reinterpret_cast<T*>(Storage); }
+            const T* Get() const { return reinterpret_cast<const T*>(Storage); }
+        };
+
+        Cell*                    m_pCells = nullptr;
+        size_t                   m_Mask   = 0;
+
+        // Producers and consumers each hammer their own position, keep them on separate cache lines
+        alignas(64) std::atomic<size_t> m_EnqueuePos = { 0 };
+        alignas(64) std::atomic<size_t> m_DequeuePos = { 0 };
+    };
+
+    template<typename T>
+    MPMCQueue<T>::MPMCQueue(size_t capacity)
+    {
+        size_t cellCount = 2;
+        while (cellCount < capacity)
+            cellCount <<= 1;
+
+        m_pCells = new Cell[cellCount];
+        m_Mask   = cellCount - 1;
+        for (size_t i = 0; i < cellCount; ++i)
+            m_pCells[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+
+    template<typename T>
+    MPMCQueue<T>::~MPMCQueue()
+    {
+        const size_t enqueuePos = m_EnqueuePos.load(std::memory_order_acquire);
+        for (size_t pos = m_DequeuePos.load(std::memory_order_acquire); pos < enqueuePos; ++pos)
+            m_pCells[pos & m_Mask].Get()->~T();
+        delete[] m_pCells;
+    }
+
+    template<typename T>
+    template<typename U>
+    bool MPMCQueue<T>::TryPush(U&& value)
+    {
+        Cell*  pCell;
+        size_t pos = m_EnqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            pCell = &m_pCells[pos & m_Mask];
+            const size_t   sequence = pCell->Sequence.load(std::memory_order_acquire);
+            const intptr_t diff     = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                // Cell is free for this lap, claim it
+                if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                // Cell still holds the item from the previous lap, we're full
+                return false;
+            }
+            else
+            {
+                // Another producer got here first
+                pos = m_EnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (pCell->Storage) T(std::forward<U>(value));
+        pCell->Sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename T>
+    bool MPMCQueue<T>::TryPop(T& value)
+    {
+        Cell*  pCell;
+        size_t pos = m_DequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            pCell = &m_pCells[pos & m_Mask];
+            const size_t   sequence = pCell->Sequence.load(std::memory_order_acquire);
+            const intptr_t diff     = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                // Cell is filled for this lap, claim it
+                if (m_DequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                // Cell hasn't been filled yet, we're empty
+                return false;
+            }
+            else
+            {
+                // Another consumer got here first
+                pos = m_DequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        T* pValue = pCell->Get();
+        value = std::move(*pValue);
+        pValue->~T();
+
+        // Free the cell for the producers' next lap
+        pCell->Sequence.store(pos + m_Mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename T>
+    size_t MPMCQueue<T>::Size() const
+    {
+        const size_t dequeuePos = m_DequeuePos.load(std::memory_order_relaxed);
+        const size_t enqueuePos = m_EnqueuePos.load(std::memory_order_relaxed);
+        return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+    }
+
+    template<typename T>
+    template<typename Func>
+    void MPMCQueue<T>::ForEach(Func func) const
+    {
+        const size_t enqueuePos = m_EnqueuePos.load(std::memory_order_acquire);
+        for (size_t pos = m_DequeuePos.load(std::memory_order_acquire); pos < enqueuePos; ++pos)
+            func(*m_pCells[pos & m_Mask].Get());
+    }
+
+} // namespace cauldron
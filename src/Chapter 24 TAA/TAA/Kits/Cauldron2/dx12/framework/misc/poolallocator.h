@@ -0,0 +1,186 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace cauldron
+{
+    /**
+     * @class PoolAllocator
+     *
+     * Fixed-size block allocator for objects of type T that are frequently created and destroyed from
+     * multiple threads. Each thread keeps a small cache of free blocks and exchanges them in batches with
+     * a shared free list, so blocks allocated on one thread and freed on another flow back without a lock
+     * per operation. Memory is acquired from the heap in chunks and only released at shutdown.
+     *
+     * Meant to back class-specific operator new/delete.
+     *
+     * @ingroup CauldronMisc
+     */
+    template<typename T, uint32_t BlocksPerChunk = 64>
+    class PoolAllocator
+    {
+    public:
+
+        /**
+         * @brief   Returns uninitialized memory for one T.
+         */
+        static void* Allocate();
+
+        /**
+         * @brief   Returns a block obtained from <c><i>Allocate</i></c> to the pool.
+         */
+        static void Free(void* pBlock);
+
+        /**
+         * @brief   Returns the number of heap allocations the pool made since startup.
+         */
+        static uint64_t GetHeapAllocationCount() { return GetSharedPool().HeapAllocations.load(std::memory_order_relaxed); }
+
+    private:
+        PoolAllocator() = delete;
+
+        union Block
+        {
+            Block* pNext;
+            alignas(T) uint8_t Storage[sizeof(T)];
+        };
+
+        static constexpr uint32_t s_BatchSize = BlocksPerChunk / 2;
+
+        struct SharedPool
+        {
+            std::mutex           Mutex;
+            Block*               pFreeList       = nullptr;
+            std::vector<Block*>  Chunks          = {};
+            std::atomic_uint64_t HeapAllocations = { 0 };
+
+            ~SharedPool()
+            {
+                for (Block* pChunk : Chunks)
+                    delete[] pChunk;
+            }
+        };
+
+        struct ThreadCache
+        {
+            Block*   pFreeList = nullptr;
+            uint32_t Count     = 0;
+
+            // Make sure the shared pool outlives our caches
+            ThreadCache() { GetSharedPool(); }
+            ~ThreadCache() { ReturnBlocks(*this, Count); }
+        };
+
+        static SharedPool& GetSharedPool()
+        {
+            static SharedPool s_SharedPool;
+            return s_SharedPool;
+        }
+
+        static ThreadCache& GetThreadCache()
+        {
+            static thread_local ThreadCache s_ThreadCache;
+            return s_ThreadCache;
+        }
+
+        static void ReturnBlocks(ThreadCache& cache, uint32_t count);
+    };
+
+    template<typename T, uint32_t BlocksPerChunk>
+    void* PoolAllocator<T, BlocksPerChunk>::Allocate()
+    {
+        ThreadCache& cache = GetThreadCache();
+        if (!cache.pFreeList)
+        {
+            SharedPool& pool = GetSharedPool();
+            std::lock_guard<std::mutex> lock(pool.Mutex);
+
+            // Grab a batch of free blocks, or carve a new chunk if there are none left
+            if (!pool.pFreeList)
+            {
+                Block* pChunk = new Block[BlocksPerChunk];
+                pool.Chunks.push_back(pChunk);
+                ++pool.HeapAllocations;
+                for (uint32_t i = 0; i < BlocksPerChunk; ++i)
+                {
+                    pChunk[i].pNext = pool.pFreeList;
+                    pool.pFreeList  = &pChunk[i];
+                }
+            }
+
+            for (uint32_t i = 0; i < s_BatchSize && pool.pFreeList; ++i)
+            {
+                Block* pBlock   = pool.pFreeList;
+                pool.pFreeList  = pBlock->pNext;
+                pBlock->pNext   = cache.pFreeList;
+                cache.pFreeList = pBlock;
+                ++cache.Count;
+            }
+        }
+
+        Block* pBlock   = cache.pFreeList;
+        cache.pFreeList = pBlock->pNext;
+        --cache.Count;
+        return pBlock;
+    }
+
+    template<typename T, uint32_t BlocksPerChunk>
+    void PoolAllocator<T, BlocksPerChunk>::Free(void* pBlock)
+    {
+        if (!pBlock)
+            return;
+
+        ThreadCache& cache = GetThreadCache();
+        Block* pFreed   = static_cast<Block*>(pBlock);
+        pFreed->pNext   = cache.pFreeList;
+        cache.pFreeList = pFreed;
+
+        // Threads that mostly free (i.e. workers completing tasks) hand their surplus back to the allocating threads
+        if (++cache.Count >= BlocksPerChunk)
+            ReturnBlocks(cache, s_BatchSize);
+    }
+
+    template<typename T, uint32_t BlocksPerChunk>
+    void PoolAllocator<T, BlocksPerChunk>::ReturnBlocks(ThreadCache& cache, uint32_t count)
+    {
+        if (!count)
+            return;
+
+        SharedPool& pool = GetSharedPool();
+        std::lock_guard<std::mutex> lock(pool.Mutex);
+        for (uint32_t i = 0; i < count && cache.pFreeList; ++i)
+        {
+            Block* pBlock   = cache.pFreeList;
+            cache.pFreeList = pBlock->pNext;
+            pBlock->pNext   = pool.pFreeList;
+            pool.pFreeList  = pBlock;
+            --cache.Count;
+        }
+    }
+
+} // namespace cauldron
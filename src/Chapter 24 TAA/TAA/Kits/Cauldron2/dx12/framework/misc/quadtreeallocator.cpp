@@ -0,0 +1,263 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "quadtreeallocator.h"
+
+#include <cassert>
+
+namespace cauldron
+{
+    QuadTreeAllocator::QuadTreeAllocator(uint32_t size)
+    {
+        assert(size > 0 && (size & (size - 1)) == 0 && "The quadtree size must be a power of two.");
+        m_Cells.push_back({ size, 0, 0, CellStatus::Empty });
+
+        // One level per halving of the cell size
+        m_FreeCells.resize(FindHighestBitSet(size) + 1);
+        m_FreeCellSlots.push_back(-1);
+        AddFreeCell(0);
+    }
+
+    const QuadTreeAllocator::Cell& QuadTreeAllocator::GetCell(int32_t index) const
+    {
+        assert(index >= 0 && index < static_cast<int32_t>(m_Cells.size()) && "This cell index doesn't exist yet.");
+        return m_Cells[index];
+    }
+
+    int32_t QuadTreeAllocator::FindBestCell(uint32_t size) const
+    {
+        if (size == 0 || size > m_Cells[0].Size)
+            return -1;
+
+        // The deepest level with empty cells at or above the one holding the requested size has the best fitting cells
+        const uint32_t level     = FindHighestBitSet(m_Cells[0].Size / size);
+        const uint32_t levelMask = m_FreeLevelMask & static_cast<uint32_t>((2ull << level) - 1);
+        if (!levelMask)
+            return -1;
+
+        return m_FreeCells[FindHighestBitSet(levelMask)].back();
+    }
+
+    int32_t QuadTreeAllocator::AllocateCell(uint32_t size, int32_t index)
+    {
+        assert(index >= 0 && index < static_cast<int32_t>(m_Cells.size()) && "This cell index doesn't exist yet.");
+        assert(m_Cells[index].Status == CellStatus::Empty && "The cell we are trying to allocate/subdivide isn't empty.");
+        RemoveFreeCell(index);
+        while (m_Cells[index].Size > size)
+        {
+            // subdivide
+            int32_t childrenBaseIndex = GetChildrenBaseIndex(index);
+            if (m_Cells.size() < childrenBaseIndex + 4)
+            {
+                m_Cells.resize(childrenBaseIndex + 4);
+                m_FreeCellSlots.resize(childrenBaseIndex + 4, -1);
+            }
+
+            // init the children: top left, top right, bottom left, bottom right
+            const Cell     currentCell   = m_Cells[index];
+            const uint32_t childCellSize = currentCell.Size / 2;
+            for (int32_t i = 0; i < 4; ++i)
+            {
+                Cell& childCell  = m_Cells[childrenBaseIndex + i];
+                childCell.Size   = childCellSize;
+                childCell.Left   = currentCell.Left + ((i & 1) ? childCellSize : 0);
+                childCell.Top    = currentCell.Top + ((i & 2) ? childCellSize : 0);
+                childCell.Status = CellStatus::Empty;
+            }
+
+            // mark the cell non empty
+            m_Cells[index].Status = CellStatus::Subdivided;
+
+            // select the first child cell, the others are up for grabs
+            for (int32_t i = 1; i < 4; ++i)
+                AddFreeCell(childrenBaseIndex + i);
+            index = childrenBaseIndex;
+        }
+
+        assert(m_Cells[index].Size == size && "This cell size doesn't match the expected one.");
+        m_Cells[index].Status = CellStatus::Allocated;
+        return index;
+    }
+
+    void QuadTreeAllocator::FreeCell(int32_t index)
+    {
+        assert(index >= 0 && index < static_cast<int32_t>(m_Cells.size()) && "This cell index doesn't exist.");
+        assert(m_Cells[index].Status == CellStatus::Allocated && "The cell we are trying to free isn't allocated.");
+
+        // free the cell
+        m_Cells[index].Status = CellStatus::Empty;
+
+        // merge with the sibling cells
+        while (index != 0)
+        {
+            int32_t parentIndex = GetParentIndex(index);
+            assert(m_Cells[parentIndex].Status == CellStatus::Subdivided && "We are trying to merge the children of a cell that isn't subdivided.");
+
+            bool allChildrenEmpty = true;
+            int32_t childrenBaseIndex = GetChildrenBaseIndex(parentIndex);
+            for (int32_t i = 0; i < 4; ++i)
+            {
+                allChildrenEmpty &= (m_Cells[childrenBaseIndex + i].Status == CellStatus::Empty);
+            }
+
+            if (!allChildrenEmpty)
+            {
+                // cannot merge because only child is still allocated or subdivided
+                break;
+            }
+
+            // merge the cells
+            for (int32_t i = 0; i < 4; ++i)
+            {
+                if (childrenBaseIndex + i != index)
+                    RemoveFreeCell(childrenBaseIndex + i);
+            }
+            m_Cells[parentIndex].Status = CellStatus::Empty;
+
+            // move to parent
+            index = parentIndex;
+        }
+
+        AddFreeCell(index);
+    }
+
+    uint32_t QuadTreeAllocator::Defragment(uint32_t maxMoves, std::vector<CellMove>& moves)
+    {
+        uint32_t moveCount = 0;
+
+        // Work from the smallest cells up, merging them back is what frees up larger cells
+        for (int32_t level = static_cast<int32_t>(m_FreeCells.size()) - 1; level > 0 && moveCount < maxMoves; --level)
+        {
+            const std::vector<int32_t>& freeCells = m_FreeCells[level];
+            if (freeCells.size() < 2)
+                continue;
+
+            // Find the sparsest subdivision whose cells can all be moved (i.e. none of them are further subdivided)
+            auto getEmptyChildCount = [this](int32_t parentIndex) {
+                uint32_t emptyCount = 0;
+                int32_t childrenBaseIndex = GetChildrenBaseIndex(parentIndex);
+                for (int32_t i = 0; i < 4; ++i)
+                {
+                    if (m_Cells[childrenBaseIndex + i].Status == CellStatus::Subdivided)
+                        return 0u;
+                    emptyCount += (m_Cells[childrenBaseIndex + i].Status == CellStatus::Empty) ? 1 : 0;
+                }
+                return emptyCount;
+            };
+
+            int32_t  sourceIndex      = -1;
+            uint32_t sourceEmptyCount = 0;
+            for (int32_t cellIndex : freeCells)
+            {
+                const int32_t  parentIndex = GetParentIndex(cellIndex);
+                const uint32_t emptyCount  = getEmptyChildCount(parentIndex);
+                if (emptyCount > sourceEmptyCount)
+                {
+                    sourceIndex      = parentIndex;
+                    sourceEmptyCount = emptyCount;
+                }
+            }
+
+            // Only worth moving anything if the rest of the level can take all of its cells
+            if (sourceIndex < 0 || freeCells.size() - sourceEmptyCount < 4 - sourceEmptyCount)
+                continue;
+
+            const int32_t childrenBaseIndex = GetChildrenBaseIndex(sourceIndex);
+            for (int32_t i = 0; i < 4 && moveCount < maxMoves; ++i)
+            {
+                const int32_t srcIndex = childrenBaseIndex + i;
+                if (m_Cells[srcIndex].Status != CellStatus::Allocated)
+                    continue;
+
+                // Fill up the densest subdivision first
+                int32_t  dstIndex          = -1;
+                uint32_t dstSiblingsEmpty  = 4;
+                for (int32_t cellIndex : freeCells)
+                {
+                    const int32_t parentIndex = GetParentIndex(cellIndex);
+                    if (parentIndex == sourceIndex)
+                        continue;
+
+                    uint32_t emptyCount = 0;
+                    const int32_t siblingsBaseIndex = GetChildrenBaseIndex(parentIndex);
+                    for (int32_t j = 0; j < 4; ++j)
+                        emptyCount += (m_Cells[siblingsBaseIndex + j].Status == CellStatus::Empty) ? 1 : 0;
+
+                    if (emptyCount < dstSiblingsEmpty)
+                    {
+                        dstIndex         = cellIndex;
+                        dstSiblingsEmpty = emptyCount;
+                    }
+                }
+                assert(dstIndex >= 0 && "Ran out of cells to defragment into.");
+
+                AllocateCell(m_Cells[srcIndex].Size, dstIndex);
+                FreeCell(srcIndex);
+                moves.push_back({ srcIndex, dstIndex });
+                ++moveCount;
+            }
+        }
+
+        return moveCount;
+    }
+
+    int32_t QuadTreeAllocator::GetChildrenBaseIndex(int32_t index)
+    {
+        return (index << 2) + 1;
+    }
+
+    int32_t QuadTreeAllocator::GetParentIndex(int32_t index)
+    {
+        return (index - 1) >> 2;
+    }
+
+    uint32_t QuadTreeAllocator::GetCellLevel(int32_t index) const
+    {
+        return FindHighestBitSet(m_Cells[0].Size / m_Cells[index].Size);
+    }
+
+    void QuadTreeAllocator::AddFreeCell(int32_t index)
+    {
+        const uint32_t level = GetCellLevel(index);
+        m_FreeCellSlots[index] = static_cast<int32_t>(m_FreeCells[level].size());
+        m_FreeCells[level].push_back(index);
+        m_FreeLevelMask |= 1u << level;
+    }
+
+    void QuadTreeAllocator::RemoveFreeCell(int32_t index)
+    {
+        const uint32_t level = GetCellLevel(index);
+        std::vector<int32_t>& freeCells = m_FreeCells[level];
+        assert(m_FreeCellSlots[index] >= 0 && "The cell isn't in the free cell lists.");
+
+        // Swap with the last entry to remove in constant time
+        const int32_t slot = m_FreeCellSlots[index];
+        freeCells[slot] = freeCells.back();
+        m_FreeCellSlots[freeCells[slot]] = slot;
+        freeCells.pop_back();
+        m_FreeCellSlots[index] = -1;
+
+        if (freeCells.empty())
+            m_FreeLevelMask &= ~(1u << level);
+    }
+
+} // namespace cauldron
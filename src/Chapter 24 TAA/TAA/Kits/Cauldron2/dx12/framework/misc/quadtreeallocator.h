@@ -0,0 +1,156 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "helpers.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace cauldron
+{
+    /// An enumeration for quadtree cell status
+    ///
+    /// @ingroup CauldronMisc
+    enum class CellStatus
+    {
+        Empty,          ///< The cell is empty.
+        Allocated,      ///< The cell has been allocated.
+        Subdivided      ///< The cell was subdivided into 4 cells.
+    };
+
+    /**
+     * @class QuadTreeAllocator
+     *
+     * Quadtree sub-allocator for square cells of power of two sizes in a square area (e.g. a shadow map atlas).
+     * Cells are split in 4 on allocation and merged back with their siblings on release. Empty cells are kept
+     * in per-level free lists so the best fitting cell is found without walking the tree.
+     *
+     * The allocator only hands out cell coordinates and does not touch the memory it manages, which keeps it
+     * testable without a GPU. Not thread-safe, callers are expected to synchronize access.
+     *
+     * @ingroup CauldronMisc
+     */
+    class QuadTreeAllocator
+    {
+    public:
+
+        /**
+         * @struct Cell
+         *
+         * A square cell of the quadtree.
+         *
+         * @ingroup CauldronMisc
+         */
+        struct Cell
+        {
+            uint32_t   Size   = 0;                  ///< The size (squared) of the cell.
+            uint32_t   Left   = 0;                  ///< The horizontal offset of the cell.
+            uint32_t   Top    = 0;                  ///< The vertical offset of the cell.
+            CellStatus Status = CellStatus::Empty;  ///< The <c><i>CellStatus</i></c> (defaults to CellStatus::Empty).
+        };
+
+        /**
+         * @struct CellMove
+         *
+         * A cell relocated by <c><i>QuadTreeAllocator::Defragment</i></c>.
+         *
+         * @ingroup CauldronMisc
+         */
+        struct CellMove
+        {
+            int32_t SrcCellIndex = -1;              ///< The index of the cell that was freed.
+            int32_t DstCellIndex = -1;              ///< The index of the cell that replaces it.
+        };
+
+        /**
+         * @brief   Construction. The size of the managed area must be a power of two.
+         */
+        explicit QuadTreeAllocator(uint32_t size);
+
+        /**
+         * @brief   Destruction.
+         */
+        ~QuadTreeAllocator() = default;
+
+        /**
+         * @brief   Returns the size (squared) of the managed area.
+         */
+        uint32_t GetSize() const { return m_Cells[0].Size; }
+
+        /**
+         * @brief   Returns the number of cell records (including the ones of merged subdivisions).
+         */
+        uint32_t GetCellCount() const { return static_cast<uint32_t>(m_Cells.size()); }
+
+        /**
+         * @brief   Returns the <c><i>Cell</i></c> corresponding to the requested index.
+         */
+        const Cell& GetCell(int32_t index) const;
+
+        /**
+         * @brief   Returns true when nothing is allocated.
+         */
+        bool IsEmpty() const { return m_Cells[0].Status == CellStatus::Empty; }
+
+        /**
+         * @brief   Returns an index to the smallest empty cell that can hold the requested size, or -1 if none was found.
+         */
+        int32_t FindBestCell(uint32_t size) const;
+
+        /**
+         * @brief   Allocates a new sub-cell of specified size into the index-defined empty cell, subdividing it as needed.
+         */
+        int32_t AllocateCell(uint32_t size, int32_t index);
+
+        /**
+         * @brief   Frees the specified cell, merging it with its siblings when they are all empty.
+         */
+        void FreeCell(int32_t index);
+
+        /**
+         * @brief   Incrementally compacts the tree by relocating up to maxMoves allocated cells out of sparsely
+         *          used subdivisions so those can merge back into larger free cells. The relocations are appended
+         *          to moves. Returns the number of cells moved.
+         */
+        uint32_t Defragment(uint32_t maxMoves, std::vector<CellMove>& moves);
+
+    private:
+        NO_COPY(QuadTreeAllocator)
+        NO_MOVE(QuadTreeAllocator)
+
+        static int32_t GetChildrenBaseIndex(int32_t index);
+        static int32_t GetParentIndex(int32_t index);
+        uint32_t GetCellLevel(int32_t index) const;
+        void AddFreeCell(int32_t index);
+        void RemoveFreeCell(int32_t index);
+
+        std::vector<Cell> m_Cells;
+
+        // Empty cells by level (level 0 being the whole area) so the best fitting cell is found without walking the tree
+        std::vector<std::vector<int32_t>> m_FreeCells;
+        std::vector<int32_t>              m_FreeCellSlots;      // Position of each cell in its level's free list, -1 if it isn't empty
+        uint32_t                          m_FreeLevelMask = 0;  // Bit set for each level with empty cells
+    };
+
+} // namespace cauldron
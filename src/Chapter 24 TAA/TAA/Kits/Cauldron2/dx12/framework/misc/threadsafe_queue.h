@@ -22,16 +22,20 @@
 
 #pragma once
 
-#include <queue>
+#include "mpmcqueue.h"
+
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
-#include <xmemory>
 
 namespace cauldron
 {
     /**
      * @class ThreadSafeQueue
      *
-     * Thread-safe queue implementation. Currently used to back <c><i>Device</i></c> command allocators.
+     * Thread-safe bounded queue implementation built on a lock-free <c><i>MPMCQueue</i></c>. Pushing and popping
+     * never take a lock unless the queue is full (<c><i>PushBack</i></c>) or empty (<c><i>WaitPopFront</i></c>) and
+     * the calling thread has to block. Supports move-only types. Currently used to back <c><i>Device</i></c> command allocators.
      *
      * @ingroup CauldronMisc
      */
@@ -41,17 +45,22 @@ namespace cauldron
     public:
 
         /**
-         * @brief   Construction with default.
+         * @brief   Construction with default capacity.
          */
         ThreadSafeQueue();
 
         /**
-         * @brief   Copy construction.
+         * @brief   Construction with the maximum number of items the queue will hold.
+         */
+        explicit ThreadSafeQueue(size_t capacity);
+
+        /**
+         * @brief   Copy construction. The copied queue must not be modified concurrently.
          */
         ThreadSafeQueue(const ThreadSafeQueue& copy);
 
         /**
-         * @brief   Push a value into the back of the queue.
+         * @brief   Push a value into the back of the queue. Blocks while the queue is full.
          */
         void PushBack(T value);
 
@@ -61,6 +70,11 @@ namespace cauldron
          */
         bool PopFront(T& value);
 
+        /**
+         * @brief   Pop a value from the front of the queue. Blocks until a value is available.
+         */
+        void WaitPopFront(T& value);
+
         /**
          * @brief   Check to see if there are any items in the queue.
          */
@@ -72,52 +86,96 @@ namespace cauldron
         size_t Size() const;
 
     private:
-        std::queue<T> m_Queue;
-        mutable std::mutex m_Mutex;
+        static constexpr size_t s_DefaultCapacity = 1024;
+
+        void NotifyWaiters(std::atomic_uint32_t& waiterCount);
+
+        MPMCQueue<T>            m_Queue;
+
+        // Only used when a thread needs to block
+        std::atomic_uint32_t    m_WaitingPushers = { 0 };
+        std::atomic_uint32_t    m_WaitingPoppers = { 0 };
+        std::mutex              m_WaitMutex;
+        std::condition_variable m_WaitCondition;
     };
 
     template<typename T>
-    ThreadSafeQueue<T>::ThreadSafeQueue() = default;
+    ThreadSafeQueue<T>::ThreadSafeQueue() :
+        m_Queue(s_DefaultCapacity)
+    {
+    }
+
+    template<typename T>
+    ThreadSafeQueue<T>::ThreadSafeQueue(size_t capacity) :
+        m_Queue(capacity)
+    {
+    }
 
     template<typename T>
-    ThreadSafeQueue<T>::ThreadSafeQueue(const ThreadSafeQueue<T>& copy)
+    ThreadSafeQueue<T>::ThreadSafeQueue(const ThreadSafeQueue<T>& copy) :
+        m_Queue(copy.m_Queue.Capacity())
     {
-        std::lock_guard<std::mutex> lock(copy.m_Mutex);
-        m_Queue = copy.m_Queue;
+        copy.m_Queue.ForEach([this](const T& value) { m_Queue.TryPush(value); });
     }
 
     template<typename T>
     void ThreadSafeQueue<T>::PushBack(T value)
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        m_Queue.push(std::move(value));
+        if (!m_Queue.TryPush(std::move(value)))
+        {
+            std::unique_lock<std::mutex> lock(m_WaitMutex);
+            ++m_WaitingPushers;
+            m_WaitCondition.wait(lock, [this, &value] { return m_Queue.TryPush(std::move(value)); });
+            --m_WaitingPushers;
+        }
+        NotifyWaiters(m_WaitingPoppers);
     }
 
     template<typename T>
     bool ThreadSafeQueue<T>::PopFront(T& value)
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        if (m_Queue.empty())
+        if (!m_Queue.TryPop(value))
             return false;
 
-        value = m_Queue.front();
-        m_Queue.pop();
-
+        NotifyWaiters(m_WaitingPushers);
         return true;
     }
 
+    template<typename T>
+    void ThreadSafeQueue<T>::WaitPopFront(T& value)
+    {
+        if (!m_Queue.TryPop(value))
+        {
+            std::unique_lock<std::mutex> lock(m_WaitMutex);
+            ++m_WaitingPoppers;
+            m_WaitCondition.wait(lock, [this, &value] { return m_Queue.TryPop(value); });
+            --m_WaitingPoppers;
+        }
+        NotifyWaiters(m_WaitingPushers);
+    }
+
     template<typename T>
     bool ThreadSafeQueue<T>::Empty() const
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        return m_Queue.empty();
+        return m_Queue.Size() == 0;
     }
 
     template<typename T>
     size_t ThreadSafeQueue<T>::Size() const
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        return m_Queue.size();
+        return m_Queue.Size();
+    }
+
+    template<typename T>
+    void ThreadSafeQueue<T>::NotifyWaiters(std::atomic_uint32_t& waiterCount)
+    {
+        // Blocked threads register before re-checking the queue, so either they see our change or we see them
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiterCount.load() == 0)
+            return;
+
+        std::lock_guard<std::mutex> lock(m_WaitMutex);
+        m_WaitCondition.notify_all();
     }
 
 } // namespace cauldron
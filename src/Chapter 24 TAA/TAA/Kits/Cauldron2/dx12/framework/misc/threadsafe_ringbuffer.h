@@ -31,7 +31,7 @@ namespace cauldron
     /**
      * @class ThreadSafeRingBuffer
      *
-     * Thread-safe ring buffer used to back logging system.
+     * Thread-safe ring buffer of fixed-size entries.
      *
      * @ingroup CauldronMisc
      */
@@ -0,0 +1,305 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "tlsfallocator.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace cauldron
+{
+    void TLSFAllocator::Init(uint64_t size, uint64_t granularity)
+    {
+        assert(granularity && !(granularity & (granularity - 1)) && "TLSF allocator granularity must be a power of two");
+
+        m_Blocks.clear();
+        m_Blocks.reserve(256);
+        m_UnusedBlocks     = s_InvalidHandle;
+        m_FirstLevelBitmap = 0;
+        for (uint32_t firstLevel = 0; firstLevel < s_FirstLevelCount; ++firstLevel)
+        {
+            m_SecondLevelBitmaps[firstLevel] = 0;
+            for (uint32_t secondLevel = 0; secondLevel < s_SecondLevelCount; ++secondLevel)
+                m_FreeLists[firstLevel][secondLevel] = s_InvalidHandle;
+        }
+
+        m_Granularity      = granularity;
+        m_GranularityShift = FindLowestBitSet(granularity);
+        m_Size             = size & ~(granularity - 1);
+        m_FreeSize         = m_Size;
+        m_AllocationCount  = 0;
+        m_FreeBlockCount   = 0;
+
+        // Start out with a single free block spanning the whole range
+        if (m_Size)
+        {
+            uint32_t blockIndex = AcquireBlock();
+            m_Blocks[blockIndex].Offset = 0;
+            m_Blocks[blockIndex].Size   = m_Size >> m_GranularityShift;
+            InsertFreeBlock(blockIndex);
+        }
+    }
+
+    bool TLSFAllocator::Allocate(uint64_t size, uint64_t alignment, Allocation& allocation)
+    {
+        assert((!alignment || !(alignment & (alignment - 1))) && "TLSF allocations must have a power of two alignment");
+
+        const uint64_t sizeUnits      = std::max<uint64_t>(AlignUp(size, m_Granularity) >> m_GranularityShift, 1);
+        const uint64_t alignmentUnits = std::max<uint64_t>(alignment >> m_GranularityShift, 1);
+
+        // Look for a block guaranteed to fit the allocation at any alignment
+        uint32_t blockIndex = FindFreeBlock(sizeUnits + alignmentUnits - 1);
+
+        // Otherwise a block from the allocation's own class up to the one searched above may still be large enough
+        // once aligned
+        if (blockIndex == s_InvalidHandle)
+        {
+            uint32_t firstLevel, secondLevel, lastFirstLevel, lastSecondLevel;
+            MapSize(sizeUnits, firstLevel, secondLevel);
+            MapSize(sizeUnits + alignmentUnits - 1, lastFirstLevel, lastSecondLevel);
+            lastFirstLevel = std::min(lastFirstLevel, s_FirstLevelCount - 1);
+            for (; blockIndex == s_InvalidHandle && firstLevel <= lastFirstLevel; ++firstLevel, secondLevel = 0)
+            {
+                // Only visit the classes holding free blocks
+                uint32_t secondLevelMap = m_SecondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+                if (firstLevel == lastFirstLevel && lastSecondLevel + 1 < s_SecondLevelCount)
+                    secondLevelMap &= (1u << (lastSecondLevel + 1)) - 1;
+
+                for (; secondLevelMap && blockIndex == s_InvalidHandle; secondLevelMap &= secondLevelMap - 1)
+                {
+                    uint32_t candidate = m_FreeLists[firstLevel][FindLowestBitSet(secondLevelMap)];
+                    for (; candidate != s_InvalidHandle; candidate = m_Blocks[candidate].NextFree)
+                    {
+                        const Block& block = m_Blocks[candidate];
+                        if (block.Size >= AlignUp(block.Offset, alignmentUnits) - block.Offset + sizeUnits)
+                        {
+                            blockIndex = candidate;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            if (blockIndex == s_InvalidHandle)
+                return false;
+        }
+
+        RemoveFreeBlock(blockIndex);
+
+        // Give the alignment padding back as a free block of its own
+        const uint64_t padding = AlignUp(m_Blocks[blockIndex].Offset, alignmentUnits) - m_Blocks[blockIndex].Offset;
+        if (padding)
+        {
+            uint32_t alignedIndex = SplitBlock(blockIndex, padding);
+            InsertFreeBlock(blockIndex);
+            blockIndex = alignedIndex;
+        }
+
+        // And the remainder
+        if (m_Blocks[blockIndex].Size > sizeUnits)
+            InsertFreeBlock(SplitBlock(blockIndex, sizeUnits));
+
+        m_FreeSize -= sizeUnits << m_GranularityShift;
+        ++m_AllocationCount;
+
+        allocation.Offset = m_Blocks[blockIndex].Offset << m_GranularityShift;
+        allocation.Size   = sizeUnits << m_GranularityShift;
+        allocation.Handle = blockIndex;
+        return true;
+    }
+
+    void TLSFAllocator::Free(uint32_t handle)
+    {
+        assert(handle < m_Blocks.size() && !m_Blocks[handle].IsFree && "Freeing an invalid TLSF allocation");
+
+        m_FreeSize += m_Blocks[handle].Size << m_GranularityShift;
+        --m_AllocationCount;
+
+        // Coalesce with the previous block
+        uint32_t blockIndex = handle;
+        uint32_t prevIndex  = m_Blocks[blockIndex].PrevPhysical;
+        if (prevIndex != s_InvalidHandle && m_Blocks[prevIndex].IsFree)
+        {
+            RemoveFreeBlock(prevIndex);
+            m_Blocks[prevIndex].Size += m_Blocks[blockIndex].Size;
+            m_Blocks[prevIndex].NextPhysical = m_Blocks[blockIndex].NextPhysical;
+            if (m_Blocks[blockIndex].NextPhysical != s_InvalidHandle)
+                m_Blocks[m_Blocks[blockIndex].NextPhysical].PrevPhysical = prevIndex;
+            ReleaseBlock(blockIndex);
+            blockIndex = prevIndex;
+        }
+
+        // And the next one
+        uint32_t nextIndex = m_Blocks[blockIndex].NextPhysical;
+        if (nextIndex != s_InvalidHandle && m_Blocks[nextIndex].IsFree)
+        {
+            RemoveFreeBlock(nextIndex);
+            m_Blocks[blockIndex].Size += m_Blocks[nextIndex].Size;
+            m_Blocks[blockIndex].NextPhysical = m_Blocks[nextIndex].NextPhysical;
+            if (m_Blocks[nextIndex].NextPhysical != s_InvalidHandle)
+                m_Blocks[m_Blocks[nextIndex].NextPhysical].PrevPhysical = blockIndex;
+            ReleaseBlock(nextIndex);
+        }
+
+        InsertFreeBlock(blockIndex);
+    }
+
+    uint64_t TLSFAllocator::GetLargestFreeBlockSize() const
+    {
+        if (!m_FirstLevelBitmap)
+            return 0;
+
+        // Only the highest non-empty class needs to be searched
+        const uint32_t firstLevel  = FindHighestBitSet(m_FirstLevelBitmap);
+        const uint32_t secondLevel = FindHighestBitSet(m_SecondLevelBitmaps[firstLevel]);
+        uint64_t largestSize = 0;
+        for (uint32_t blockIndex = m_FreeLists[firstLevel][secondLevel]; blockIndex != s_InvalidHandle; blockIndex = m_Blocks[blockIndex].NextFree)
+            largestSize = std::max(largestSize, m_Blocks[blockIndex].Size);
+        return largestSize << m_GranularityShift;
+    }
+
+    void TLSFAllocator::MapSize(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel)
+    {
+        if (size < s_SecondLevelCount)
+        {
+            firstLevel  = 0;
+            secondLevel = static_cast<uint32_t>(size);
+        }
+        else
+        {
+            const uint32_t highestBit = FindHighestBitSet(size);
+            firstLevel  = highestBit - s_SecondLevelBits + 1;
+            secondLevel = static_cast<uint32_t>(size >> (highestBit - s_SecondLevelBits)) - s_SecondLevelCount;
+        }
+    }
+
+    uint32_t TLSFAllocator::FindFreeBlock(uint64_t size) const
+    {
+        // Round the size up to the next class boundary so that any block of the class found will fit
+        if (size >= s_SecondLevelCount)
+            size += (1ull << (FindHighestBitSet(size) - s_SecondLevelBits)) - 1;
+
+        uint32_t firstLevel, secondLevel;
+        MapSize(size, firstLevel, secondLevel);
+        if (firstLevel >= s_FirstLevelCount)
+            return s_InvalidHandle;
+
+        uint32_t secondLevelMap = m_SecondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+        if (!secondLevelMap)
+        {
+            const uint64_t firstLevelMap = m_FirstLevelBitmap & (~0ull << (firstLevel + 1));
+            if (!firstLevelMap)
+                return s_InvalidHandle;
+
+            firstLevel     = FindLowestBitSet(firstLevelMap);
+            secondLevelMap = m_SecondLevelBitmaps[firstLevel];
+        }
+
+        return m_FreeLists[firstLevel][FindLowestBitSet(secondLevelMap)];
+    }
+
+    uint32_t TLSFAllocator::AcquireBlock()
+    {
+        if (m_UnusedBlocks == s_InvalidHandle)
+        {
+            m_Blocks.emplace_back();
+            return static_cast<uint32_t>(m_Blocks.size() - 1);
+        }
+
+        uint32_t blockIndex = m_UnusedBlocks;
+        m_UnusedBlocks = m_Blocks[blockIndex].NextFree;
+        m_Blocks[blockIndex] = Block();
+        return blockIndex;
+    }
+
+    void TLSFAllocator::ReleaseBlock(uint32_t blockIndex)
+    {
+        m_Blocks[blockIndex].IsFree   = false;
+        m_Blocks[blockIndex].NextFree = m_UnusedBlocks;
+        m_UnusedBlocks = blockIndex;
+    }
+
+    void TLSFAllocator::InsertFreeBlock(uint32_t blockIndex)
+    {
+        uint32_t firstLevel, secondLevel;
+        MapSize(m_Blocks[blockIndex].Size, firstLevel, secondLevel);
+
+        Block& block = m_Blocks[blockIndex];
+        block.IsFree   = true;
+        block.PrevFree = s_InvalidHandle;
+        block.NextFree = m_FreeLists[firstLevel][secondLevel];
+        if (block.NextFree != s_InvalidHandle)
+            m_Blocks[block.NextFree].PrevFree = blockIndex;
+
+        m_FreeLists[firstLevel][secondLevel] = blockIndex;
+        m_SecondLevelBitmaps[firstLevel] |= 1u << secondLevel;
+        m_FirstLevelBitmap |= 1ull << firstLevel;
+        ++m_FreeBlockCount;
+    }
+
+    void TLSFAllocator::RemoveFreeBlock(uint32_t blockIndex)
+    {
+        uint32_t firstLevel, secondLevel;
+        MapSize(m_Blocks[blockIndex].Size, firstLevel, secondLevel);
+
+        Block& block = m_Blocks[blockIndex];
+        if (block.PrevFree != s_InvalidHandle)
+            m_Blocks[block.PrevFree].NextFree = block.NextFree;
+        else
+            m_FreeLists[firstLevel][secondLevel] = block.NextFree;
+        if (block.NextFree != s_InvalidHandle)
+            m_Blocks[block.NextFree].PrevFree = block.PrevFree;
+
+        block.IsFree   = false;
+        block.PrevFree = s_InvalidHandle;
+        block.NextFree = s_InvalidHandle;
+
+        // Clear the class bits once its list is empty
+        if (m_FreeLists[firstLevel][secondLevel] == s_InvalidHandle)
+        {
+            m_SecondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+            if (!m_SecondLevelBitmaps[firstLevel])
+                m_FirstLevelBitmap &= ~(1ull << firstLevel);
+        }
+        --m_FreeBlockCount;
+    }
+
+    uint32_t TLSFAllocator::SplitBlock(uint32_t blockIndex, uint64_t size)
+    {
+        // Note: acquiring a block may grow the block storage, so only index into it afterwards
+        uint32_t splitIndex = AcquireBlock();
+        Block& block = m_Blocks[blockIndex];
+        Block& split = m_Blocks[splitIndex];
+
+        split.Offset       = block.Offset + size;
+        split.Size         = block.Size - size;
+        split.PrevPhysical = blockIndex;
+        split.NextPhysical = block.NextPhysical;
+        if (block.NextPhysical != s_InvalidHandle)
+            m_Blocks[block.NextPhysical].PrevPhysical = splitIndex;
+
+        block.Size         = size;
+        block.NextPhysical = splitIndex;
+        return splitIndex;
+    }
+
+} // namespace cauldron
@@ -0,0 +1,162 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "helpers.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace cauldron
+{
+    /**
+     * @class TLSFAllocator
+     *
+     * Two-level segregated fit sub-allocator managing a range of offsets. Free blocks are binned in
+     * power-of-two classes split into linear sub-classes, with a bitmap per level, so finding a free block
+     * and releasing one (coalescing it with its free neighbors) are constant time operations.
+     *
+     * The allocator only hands out offsets and does not touch the memory it manages, which keeps it usable
+     * for GPU memory (and testable without a GPU). Bookkeeping is kept on the side and allocations are
+     * identified by a handle. Not thread-safe, callers are expected to synchronize access.
+     *
+     * @ingroup CauldronMisc
+     */
+    class TLSFAllocator
+    {
+    public:
+
+        static constexpr uint32_t s_InvalidHandle = UINT32_MAX;
+
+        /**
+         * @struct Allocation
+         *
+         * A range returned by <c><i>TLSFAllocator::Allocate</i></c>.
+         *
+         * @ingroup CauldronMisc
+         */
+        struct Allocation
+        {
+            uint64_t Offset = 0;                    ///< The (aligned) offset of the allocation.
+            uint64_t Size   = 0;                    ///< The size of the allocation, rounded up to the allocator's granularity.
+            uint32_t Handle = s_InvalidHandle;      ///< The handle to pass to <c><i>TLSFAllocator::Free</i></c>.
+        };
+
+        /**
+         * @brief   Construction. The allocator must be initialized before use.
+         */
+        TLSFAllocator() = default;
+
+        /**
+         * @brief   Destruction.
+         */
+        ~TLSFAllocator() = default;
+
+        /**
+         * @brief   (Re)initializes the allocator to manage [0, size). All sizes and offsets are rounded
+         *          to granularity, which must be a power of two.
+         */
+        void Init(uint64_t size, uint64_t granularity);
+
+        /**
+         * @brief   Allocates a range of size bytes at the requested (power of two) alignment.
+         *          Returns false if no free block can hold the allocation.
+         */
+        bool Allocate(uint64_t size, uint64_t alignment, Allocation& allocation);
+
+        /**
+         * @brief   Releases an allocation and merges it with its free neighbors.
+         */
+        void Free(uint32_t handle);
+
+        /**
+         * @brief   Returns the size of the managed range.
+         */
+        uint64_t GetSize() const { return m_Size; }
+
+        /**
+         * @brief   Returns the total amount of free memory.
+         */
+        uint64_t GetFreeSize() const { return m_FreeSize; }
+
+        /**
+         * @brief   Returns the size of the largest free block (the largest allocation that can succeed at
+         *          the allocator's granularity).
+         */
+        uint64_t GetLargestFreeBlockSize() const;
+
+        /**
+         * @brief   Returns the number of live allocations.
+         */
+        uint32_t GetAllocationCount() const { return m_AllocationCount; }
+
+        /**
+         * @brief   Returns the number of free blocks the free memory is split in.
+         */
+        uint32_t GetFreeBlockCount() const { return m_FreeBlockCount; }
+
+    private:
+        NO_COPY(TLSFAllocator)
+        NO_MOVE(TLSFAllocator)
+
+        // Sizes below 2^s_SecondLevelBits units are binned linearly, larger ones in 2^s_SecondLevelBits sub-classes per power of two
+        static constexpr uint32_t s_SecondLevelBits  = 5;
+        static constexpr uint32_t s_SecondLevelCount = 1u << s_SecondLevelBits;
+        static constexpr uint32_t s_FirstLevelCount  = 64 - s_SecondLevelBits;
+
+        struct Block
+        {
+            uint64_t Offset       = 0;                  // In granularity units
+            uint64_t Size         = 0;                  // In granularity units
+            uint32_t PrevPhysical = s_InvalidHandle;
+            uint32_t NextPhysical = s_InvalidHandle;
+            uint32_t PrevFree     = s_InvalidHandle;
+            uint32_t NextFree     = s_InvalidHandle;    // Also links unused block records
+            bool     IsFree       = false;
+        };
+
+        static void MapSize(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel);
+        uint32_t FindFreeBlock(uint64_t size) const;
+
+        uint32_t AcquireBlock();
+        void ReleaseBlock(uint32_t blockIndex);
+        void InsertFreeBlock(uint32_t blockIndex);
+        void RemoveFreeBlock(uint32_t blockIndex);
+        uint32_t SplitBlock(uint32_t blockIndex, uint64_t size);
+
+        std::vector<Block>  m_Blocks            = {};
+        uint32_t            m_UnusedBlocks      = s_InvalidHandle;
+
+        uint64_t            m_FirstLevelBitmap  = 0;
+        uint32_t            m_SecondLevelBitmaps[s_FirstLevelCount]                     = {};
+        uint32_t            m_FreeLists[s_FirstLevelCount][s_SecondLevelCount]          = {};
+
+        uint64_t            m_Size              = 0;
+        uint64_t            m_FreeSize          = 0;
+        uint64_t            m_Granularity       = 1;
+        uint32_t            m_GranularityShift  = 0;
+        uint32_t            m_AllocationCount   = 0;
+        uint32_t            m_FreeBlockCount    = 0;
+    };
+
+} // namespace cauldron
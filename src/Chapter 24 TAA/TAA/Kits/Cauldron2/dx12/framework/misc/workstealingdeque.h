@@ -0,0 +1,191 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace cauldron
+{
+    /**
+     * @class WorkStealingDeque
+     *
+     * Lock-free Chase-Lev work-stealing deque of pointers. The owning thread pushes and pops at the bottom
+     * (LIFO), any other thread may steal from the top (FIFO). The deque grows as needed, retired storage
+     * is kept until destruction as stealers may still be reading from it. Currently used to back the
+     * <c><i>TaskManager</i></c> worker queues.
+     *
+     * @ingroup CauldronMisc
+     */
+    template<typename T>
+    class WorkStealingDeque
+    {
+        static_assert(std::is_pointer<T>::value, "WorkStealingDeque only holds pointers");
+
+    public:
+
+        /**
+         * @brief   Construction with an initial capacity (rounded up to a power of 2).
+         */
+        explicit WorkStealingDeque(int64_t initialCapacity = 256);
+
+        /**
+         * @brief   Destruction. Items left in the deque are not owned by it.
+         */
+        ~WorkStealingDeque() = default;
+
+        /**
+         * @brief   Pushes an item at the bottom of the deque. Owning thread only.
+         */
+        void Push(T item);
+
+        /**
+         * @brief   Pops the most recently pushed item. Owning thread only.
+         *          Returns nullptr if the deque is empty.
+         */
+        T Pop();
+
+        /**
+         * @brief   Steals the oldest item of the deque. Can be called from any thread.
+         *          Returns nullptr if the deque is empty or the item was taken by another thread.
+         */
+        T Steal();
+
+        /**
+         * @brief   Check to see if there are any items in the deque (approximate when called from other threads).
+         */
+        bool Empty() const;
+
+    private:
+        // No Copy, No Move
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        struct RingArray
+        {
+            int64_t                           Capacity;
+            std::unique_ptr<std::atomic<T>[]> Slots;
+
+            explicit RingArray(int64_t capacity) : Capacity(capacity), Slots(new std::atomic<T>[capacity]) {}
+            void Put(int64_t index, T item) { Slots[index & (Capacity - 1)].store(item, std::memory_order_relaxed); }
+            T Get(int64_t index) const { return Slots[index & (Capacity - 1)].load(std::memory_order_relaxed); }
+        };
+
+        RingArray* Grow(RingArray* pArray, int64_t top, int64_t bottom);
+
+        // Top and bottom are hit by different threads, keep them on separate cache lines
+        alignas(64) std::atomic<int64_t>        m_Top    = { 0 };
+        alignas(64) std::atomic<int64_t>        m_Bottom = { 0 };
+        alignas(64) std::atomic<RingArray*>     m_pArray = { nullptr };
+        std::vector<std::unique_ptr<RingArray>> m_Arrays = {};   // Current and retired storage (owner only)
+    };
+
+    template<typename T>
+    WorkStealingDeque<T>::WorkStealingDeque(int64_t initialCapacity)
+    {
+        int64_t capacity = 1;
+        while (capacity < initialCapacity)
+            capacity <<= 1;
+
+        m_Arrays.emplace_back(new RingArray(capacity));
+        m_pArray.store(m_Arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    template<typename T>
+    void WorkStealingDeque<T>::Push(T item)
+    {
+        const int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+        const int64_t top    = m_Top.load(std::memory_order_acquire);
+        RingArray*    pArray = m_pArray.load(std::memory_order_relaxed);
+        if (bottom - top > pArray->Capacity - 1)
+            pArray = Grow(pArray, top, bottom);
+
+        pArray->Put(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    template<typename T>
+    T WorkStealingDeque<T>::Pop()
+    {
+        const int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+        RingArray*    pArray = m_pArray.load(std::memory_order_relaxed);
+        m_Bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_Top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            // Empty, restore the bottom
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T item = pArray->Get(bottom);
+        if (top == bottom)
+        {
+            // Last item, race against stealers for it
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                item = nullptr;
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    template<typename T>
+    T WorkStealingDeque<T>::Steal()
+    {
+        int64_t top = m_Top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+        if (top >= bottom)
+            return nullptr;
+
+        T item = m_pArray.load(std::memory_order_acquire)->Get(top);
+        if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return item;
+    }
+
+    template<typename T>
+    bool WorkStealingDeque<T>::Empty() const
+    {
+        return m_Bottom.load(std::memory_order_relaxed) <= m_Top.load(std::memory_order_relaxed);
+    }
+
+    template<typename T>
+    typename WorkStealingDeque<T>::RingArray* WorkStealingDeque<T>::Grow(RingArray* pArray, int64_t top, int64_t bottom)
+    {
+        RingArray* pNewArray = new RingArray(pArray->Capacity * 2);
+        for (int64_t i = top; i < bottom; ++i)
+            pNewArray->Put(i, pArray->Get(i));
+
+        m_Arrays.emplace_back(pNewArray);
+        m_pArray.store(pNewArray, std::memory_order_release);
+        return pNewArray;
+    }
+
+} // namespace cauldron
@@ -22,6 +22,10 @@
 
 #include "animation.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 namespace cauldron
 {
     const void* GetInterpolant(const AnimInterpolants* pInterpolant, int32_t index)
@@ -53,28 +57,284 @@ namespace cauldron
         return end;
     }
 
-    void AnimChannel::SampleLinear(const AnimSampler& sampler, float time, float* frac, float** pCurr, float** pNext) const
+    // Past this many keys a forward step is treated as a seek
+    static constexpr int32_t s_MaxCursorSteps = 4;
+
+    // Key reduction gets half of the track's error tolerance, the other half is left to quantization
+    static constexpr float   s_ReductionToleranceShare = 0.5f;
+    static constexpr int32_t s_MaxReducedSpan          = 256;   // Bounds the cost of reduction on long clips
+
+    // Smallest-three quaternion packing: 2 bits for the dropped component, 20 bits for each remaining one
+    static constexpr uint32_t s_QuatComponentBits  = 20;
+    static constexpr uint32_t s_QuatComponentMask  = (1u << s_QuatComponentBits) - 1;
+    static constexpr float    s_QuatComponentRange = 0.70710678f;   // Remaining components are within [-1/sqrt(2), 1/sqrt(2)]
+
+    static float AngleBetween(const Vec4& q0, const Vec4& q1)
+    {
+        // atan2 form stays accurate for small angles, where acos of the dot product runs out of float precision
+        const Vec4 aligned = math::dot(q0, q1) < 0.f ? -q1 : q1;
+        return 2.f * std::atan2(math::length(q0 - aligned), math::length(q0 + aligned));
+    }
+
+    static Vec4 InterpolateKeys(const Vec4& curr, const Vec4& next, float frac, bool isRotation)
+    {
+        if (!isRotation)
+            return math::lerp(frac, curr, next);
+
+        const math::Quat q = math::slerp(frac, math::Quat(curr), math::Quat(next));
+        return Vec4(q.getX(), q.getY(), q.getZ(), q.getW());
+    }
+
+    static float KeyError(const Vec4& value, const Vec4& reference, bool isRotation)
     {
-        int curr_index = FindClosestInterpolant(&sampler.m_Time, time);
-        int next_index = std::min<int>(curr_index + 1, sampler.m_Time.Count - 1);
+        return isRotation ? AngleBetween(value, reference) : math::length(value - reference);
+    }
+
+    static uint64_t PackQuat(const Vec4& quat)
+    {
+        float q[4] = { quat.getX(), quat.getY(), quat.getZ(), quat.getW() };
 
-        if (curr_index < 0)
-            curr_index++;
+        uint32_t largest = 0;
+        for (uint32_t i = 1; i < 4; ++i)
+            largest = std::abs(q[i]) > std::abs(q[largest]) ? i : largest;
 
-        if (curr_index == next_index)
+        // q and -q are the same rotation, keep the dropped component positive so it can be rebuilt
+        const float sign = q[largest] < 0.f ? -1.f : 1.f;
+
+        uint64_t packed = largest;
+        uint32_t shift  = 2;
+        for (uint32_t i = 0; i < 4; ++i)
         {
-            *frac = 0;
-            *pCurr = (float*)GetInterpolant(&sampler.m_Value, curr_index);
-            *pNext = (float*)GetInterpolant(&sampler.m_Value, next_index);
-            return;
+            if (i == largest)
+                continue;
+
+            const float normalized = std::min<float>(std::max<float>((q[i] * sign / s_QuatComponentRange) * 0.5f + 0.5f, 0.f), 1.f);
+            packed |= static_cast<uint64_t>(normalized * s_QuatComponentMask + 0.5f) << shift;
+            shift  += s_QuatComponentBits;
+        }
+        return packed;
+    }
+
+    static Vec4 UnpackQuat(uint64_t packed)
+    {
+        // Components are converted from 32-bit integers, 64-bit integer to float conversions are slow on x64
+        constexpr float s_Scale = 2.f * s_QuatComponentRange / s_QuatComponentMask;
+        const float     a       = static_cast<float>(static_cast<uint32_t>(packed >> 2) & s_QuatComponentMask) * s_Scale - s_QuatComponentRange;
+        const float     b       = static_cast<float>(static_cast<uint32_t>(packed >> (2 + s_QuatComponentBits)) & s_QuatComponentMask) * s_Scale - s_QuatComponentRange;
+        const float     c       = static_cast<float>(static_cast<uint32_t>(packed >> (2 + 2 * s_QuatComponentBits)) & s_QuatComponentMask) * s_Scale - s_QuatComponentRange;
+        const float     d       = std::sqrt(std::max<float>(1.f - (a * a + b * b + c * c), 0.f));
+
+        switch (packed & 0x3)
+        {
+        case 0:  return Vec4(d, a, b, c);
+        case 1:  return Vec4(a, d, b, c);
+        case 2:  return Vec4(a, b, d, c);
+        default: return Vec4(a, b, c, d);
+        }
+    }
+
+    // Translations and scales are quantized to 16 bits per component over the range of the track
+    static uint64_t PackRange(const Vec4& value, const Vec4& rangeMin, const Vec4& rangeExtent)
+    {
+        uint64_t packed = 0;
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            const float extent     = rangeExtent[i];
+            const float normalized = extent > 0.f ? std::min<float>(std::max<float>((value[i] - rangeMin[i]) / extent, 0.f), 1.f) : 0.f;
+            packed |= static_cast<uint64_t>(normalized * 65535.f + 0.5f) << (i * 16);
+        }
+        return packed;
+    }
+
+    static Vec4 UnpackRange(uint64_t packed, const Vec4& rangeMin, const Vec4& rangeScale)
+    {
+        const Vec4 quantized(static_cast<float>(static_cast<uint32_t>(packed) & 0xFFFF), static_cast<float>(static_cast<uint32_t>(packed >> 16) & 0xFFFF),
+                             static_cast<float>(static_cast<uint32_t>(packed >> 32) & 0xFFFF), 0.f);
+        return rangeMin + math::mulPerElem(quantized, rangeScale);
+    }
+
+    Vec4 AnimChannel::GetKeyValue(const AnimSampler& sampler, int32_t index)
+    {
+        if (sampler.m_PackedValues.empty())
+            return sampler.m_KeyValues[index];
+
+        return sampler.m_IsRotation ? UnpackQuat(sampler.m_PackedValues[index]) : UnpackRange(sampler.m_PackedValues[index], sampler.m_RangeMin, sampler.m_RangeScale);
+    }
+
+    AnimCompressionStats AnimChannel::FinalizeComponentSampler(ComponentSampler samplerID, bool compress, float maxLinearError, float maxAngularError)
+    {
+        AnimSampler* pSampler = m_pComponentSamplers[static_cast<uint32_t>(samplerID)];
+        CauldronAssert(ASSERT_CRITICAL, pSampler != nullptr, L"Finalizing a component sampler that wasn't created");
+
+        const int32_t keyCount = std::min<int32_t>(pSampler->m_Time.Count, pSampler->m_Value.Count);
+        CauldronAssert(ASSERT_CRITICAL, keyCount > 0 && pSampler->m_Value.Dimension <= 4, L"Invalid animation keyframe data");
+
+        std::vector<float> times(keyCount);
+        std::vector<Vec4>  values(keyCount);
+        for (int32_t i = 0; i < keyCount; ++i)
+        {
+            times[i] = *reinterpret_cast<const float*>(GetInterpolant(&pSampler->m_Time, i));
+
+            float value[4] = { 0.f, 0.f, 0.f, 0.f };
+            memcpy(value, GetInterpolant(&pSampler->m_Value, i), pSampler->m_Value.Dimension * sizeof(float));
+            values[i] = Vec4(value[0], value[1], value[2], value[3]);
         }
 
-        float curr_time = *(float*)GetInterpolant(&sampler.m_Time, curr_index);
-        float next_time = *(float*)GetInterpolant(&sampler.m_Time, next_index);
+        AnimCompressionStats stats;
+        stats.RawBytes = static_cast<size_t>(keyCount) * (1 + pSampler->m_Value.Dimension) * sizeof(float);
+
+        // Only the min/max information of the source interpolants is still needed
+        pSampler->m_Time.Data  = std::vector<char>();
+        pSampler->m_Value.Data = std::vector<char>();
+        pSampler->m_Time.Count = pSampler->m_Value.Count = keyCount;
+        pSampler->m_IsRotation = samplerID == ComponentSampler::Rotation;
+
+        if (!compress)
+        {
+            pSampler->m_KeyTimes  = std::move(times);
+            pSampler->m_KeyValues = std::move(values);
+            stats.CompressedBytes = GetSamplerDataSize(*pSampler);
+            return stats;
+        }
+
+        const bool  isRotation = pSampler->m_IsRotation;
+        const float maxError   = isRotation ? maxAngularError : maxLinearError;
+        const float tolerance  = maxError * s_ReductionToleranceShare;
+
+        // Error-bounded key reduction: drop every key the interpolation of its kept neighbours reproduces within tolerance
+        std::vector<int32_t> keptKeys = { 0 };
+        for (int32_t candidate = 1; candidate < keyCount - 1; ++candidate)
+        {
+            const int32_t anchor = keptKeys.back();
+            const int32_t next   = candidate + 1;
+
+            bool reducible = next - anchor <= s_MaxReducedSpan && times[next] > times[anchor];
+            for (int32_t i = anchor + 1; reducible && i < next; ++i)
+            {
+                const float frac = (times[i] - times[anchor]) / (times[next] - times[anchor]);
+                reducible = KeyError(InterpolateKeys(values[anchor], values[next], frac, isRotation), values[i], isRotation) <= tolerance;
+            }
+
+            if (!reducible)
+                keptKeys.push_back(candidate);
+        }
+        if (keyCount > 1)
+            keptKeys.push_back(keyCount - 1);
+
+        // Quantize the kept keys
+        pSampler->m_KeyTimes.resize(keptKeys.size());
+        pSampler->m_PackedValues.resize(keptKeys.size());
+        if (!isRotation)
+        {
+            Vec4 rangeMin = values[keptKeys[0]];
+            Vec4 rangeMax = values[keptKeys[0]];
+            for (int32_t key : keptKeys)
+            {
+                rangeMin = math::minPerElem(rangeMin, values[key]);
+                rangeMax = math::maxPerElem(rangeMax, values[key]);
+            }
+            pSampler->m_RangeMin   = rangeMin;
+            pSampler->m_RangeScale = (rangeMax - rangeMin) * (1.f / 65535.f);
+            pSampler->m_RangeMin.setW(0.f);
+            pSampler->m_RangeScale.setW(0.f);
+
+            for (size_t i = 0; i < keptKeys.size(); ++i)
+                pSampler->m_PackedValues[i] = PackRange(values[keptKeys[i]], rangeMin, rangeMax - rangeMin);
+        }
+        else
+        {
+            for (size_t i = 0; i < keptKeys.size(); ++i)
+                pSampler->m_PackedValues[i] = PackQuat(math::normalize(values[keptKeys[i]]));
+        }
+        for (size_t i = 0; i < keptKeys.size(); ++i)
+            pSampler->m_KeyTimes[i] = times[keptKeys[i]];
+
+        // Measure the final error against every source key
+        float finalError = 0.f;
+        for (int32_t i = 0; i < keyCount; ++i)
+        {
+            float frac;
+            Vec4  curr, next;
+            SampleLinear(*pSampler, times[i], nullptr, &frac, &curr, &next);
+            finalError = std::max<float>(finalError, KeyError(InterpolateKeys(curr, next, frac, isRotation), values[i], isRotation));
+        }
+
+        // Quantization can push the error past what the track tolerates (i.e. translations over a large range), keep the source keys then
+        if (finalError > maxError)
+        {
+            pSampler->m_PackedValues = std::vector<uint64_t>();
+            pSampler->m_KeyTimes     = std::move(times);
+            pSampler->m_KeyValues    = std::move(values);
+            stats.UncompressedCount  = 1;
+            stats.CompressedBytes    = GetSamplerDataSize(*pSampler);
+            return stats;
+        }
+
+        (isRotation ? stats.MaxAngularError : stats.MaxLinearError) = finalError;
+        stats.CompressedBytes = GetSamplerDataSize(*pSampler);
+        return stats;
+    }
+
+    size_t AnimChannel::GetSamplerDataSize(const AnimSampler& sampler)
+    {
+        return sampler.m_Time.Data.size() + sampler.m_Value.Data.size() +
+               sampler.m_KeyTimes.size() * sizeof(float) + sampler.m_KeyValues.size() * sizeof(Vec4) +
+               sampler.m_PackedValues.size() * sizeof(uint64_t) + (sampler.m_PackedValues.empty() || sampler.m_IsRotation ? 0 : 2 * sizeof(Vec4));
+    }
+
+    int32_t AnimChannel::FindKey(const AnimSampler& sampler, float time, AnimCursor* pCursor) const
+    {
+        const float*  pTimes   = sampler.m_KeyTimes.data();
+        const int32_t keyCount = static_cast<int32_t>(sampler.m_KeyTimes.size());
+
+        int32_t key   = pCursor ? std::min<int32_t>(std::max<int32_t>(pCursor->Key, 0), keyCount - 1) : 0;
+        int32_t first = 0;
+        if (pCursor && pTimes[key] <= time)
+        {
+            // Playback moves forward a key or so per frame, step there from the cached key
+            int32_t steps = 0;
+            while (key + 1 < keyCount && pTimes[key + 1] <= time && steps < s_MaxCursorSteps)
+            {
+                ++key;
+                ++steps;
+            }
+
+            if (key + 1 >= keyCount || pTimes[key + 1] > time)
+            {
+                pCursor->Key = key;
+                return key;
+            }
+
+            // Seeking forward, only the remaining keys need to be searched
+            first = key;
+        }
+
+        // Binary search for the last key at or before time (loops and seeks backwards land here)
+        key = static_cast<int32_t>(std::upper_bound(pTimes + first, pTimes + keyCount, time) - pTimes) - 1;
+        key = std::max<int32_t>(key, 0);
+
+        if (pCursor)
+            pCursor->Key = key;
+        return key;
+    }
+
+    void AnimChannel::SampleLinear(const AnimSampler& sampler, float time, AnimCursor* pCursor, float* frac, Vec4* pCurr, Vec4* pNext) const
+    {
+        const int32_t keyCount  = static_cast<int32_t>(sampler.m_KeyTimes.size());
+        const int32_t currIndex = FindKey(sampler, time, pCursor);
+        const int32_t nextIndex = std::min<int32_t>(currIndex + 1, keyCount - 1);
+
+        *pCurr = GetKeyValue(sampler, currIndex);
+        *pNext = GetKeyValue(sampler, nextIndex);
+
+        if (currIndex == nextIndex)
+        {
+            *frac = 0.f;
+            return;
+        }
 
-        *pCurr = (float*)GetInterpolant(&sampler.m_Value, curr_index);
-        *pNext = (float*)GetInterpolant(&sampler.m_Value, next_index);
-        *frac = (std::max)(0.f, (time - curr_time) / (next_time - curr_time));
-        CauldronAssert(ASSERT_CRITICAL, *frac >= 0 && *frac <= 1.0, L"Animation data out of bounds");
+        const float currTime = sampler.m_KeyTimes[currIndex];
+        const float nextTime = sampler.m_KeyTimes[nextIndex];
+        *frac = std::min<float>(std::max<float>(0.f, (time - currTime) / (nextTime - currTime)), 1.f);
     }
 }
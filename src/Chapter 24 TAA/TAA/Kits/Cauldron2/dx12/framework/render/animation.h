@@ -26,6 +26,7 @@
 #include "../misc/math.h"
 #include "../shaders/surfacerendercommon.h"
 
+#include <algorithm>
 #include <vector>
 
 
@@ -68,6 +69,47 @@ namespace cauldron
     /// @ingroup CauldronRender
     int32_t FindClosestInterpolant(const AnimInterpolants* pInterpolant, float value);
 
+    /**
+     * @struct AnimCursor
+     *
+     * Caches the keyframe last sampled from a component sampler so that playback can step forward from it
+     * rather than searching all keyframes every frame. Each sampling client keeps its own cursors.
+     *
+     * @ingroup CauldronRender
+     */
+    struct AnimCursor
+    {
+        int32_t Key = 0;    ///< Keyframe at (or preceding) the last sampled time.
+    };
+
+    /**
+     * @struct AnimCompressionStats
+     *
+     * Size and accuracy information of compressed animation keyframe data.
+     *
+     * @ingroup CauldronRender
+     */
+    struct AnimCompressionStats
+    {
+        size_t RawBytes        = 0;     ///< Size of the source keyframe data (times and full float values).
+        size_t CompressedBytes = 0;     ///< Size of the keyframe data once compressed.
+        float  MaxLinearError  = 0.f;   ///< Largest translation/scale deviation from the source keys (scene units).
+        float  MaxAngularError = 0.f;   ///< Largest rotation deviation from the source keys (radians).
+        uint32_t UncompressedCount = 0; ///< Number of tracks left uncompressed as compressing them exceeded the error tolerance.
+
+        /**
+         * @brief   Accumulates the stats of another track.
+         */
+        void Accumulate(const AnimCompressionStats& other)
+        {
+            RawBytes        += other.RawBytes;
+            CompressedBytes += other.CompressedBytes;
+            MaxLinearError   = std::max<float>(MaxLinearError, other.MaxLinearError);
+            MaxAngularError  = std::max<float>(MaxAngularError, other.MaxAngularError);
+            UncompressedCount += other.UncompressedCount;
+        }
+    };
+
     /**
      * @struct AnimationSkin
      *
@@ -158,17 +200,19 @@ namespace cauldron
 
         /**
          * @brief   Samples the requested <c><i>ComponentSampler</i></c> at a specific time to get the animation data.
+         *          When a cursor is provided, the search starts from the keyframe it last landed on.
          */
-        void SampleAnimComponent(ComponentSampler samplerID, float time, float* frac, float** pCurr, float** pNext) const
+        void SampleAnimComponent(ComponentSampler samplerID, float time, AnimCursor* pCursor, float* frac, Vec4* pCurr, Vec4* pNext) const
         {
             if (HasComponentSampler(samplerID))
             {
-                SampleLinear(*m_pComponentSamplers[static_cast<uint32_t>(samplerID)], time, frac, pCurr, pNext);
+                SampleLinear(*m_pComponentSamplers[static_cast<uint32_t>(samplerID)], time, pCursor, frac, pCurr, pNext);
             }
         }
 
         /**
          * @brief   Creates a <c><i>ComponentSampler</i></c> and assigns time and value fields to be populated.
+         *          <c><i>FinalizeComponentSampler</i></c> must be called once they are.
          */
         void CreateComponentSampler(ComponentSampler samplerID, AnimInterpolants** timeInterpolants, AnimInterpolants** valueInterpolants)
         {
@@ -178,6 +222,15 @@ namespace cauldron
             *valueInterpolants = &m_pComponentSamplers[static_cast<uint32_t>(samplerID)]->m_Value;
         }
 
+        /**
+         * @brief   Moves the populated interpolant data of a <c><i>ComponentSampler</i></c> into its sampling layout
+         *          (separate key time and key value arrays). When compressing, keys that interpolation reproduces
+         *          within half of the error tolerance are dropped, rotations are packed as smallest-three quaternions and translations/scales
+         *          are quantized over the range of the track. Tracks whose compressed keys deviate from the source keys
+         *          by more than maxLinearError (scene units) or maxAngularError (radians) are kept uncompressed.
+         */
+        AnimCompressionStats FinalizeComponentSampler(ComponentSampler samplerID, bool compress, float maxLinearError, float maxAngularError);
+
         /**
          * @brief   Queries the <c><i>ComponentSampler</i></c> animation duration.
          */
@@ -192,15 +245,40 @@ namespace cauldron
             return 0.f;
         }
 
+        /**
+         * @brief   Returns the size (in bytes) of all keyframe data held by the channel.
+         */
+        size_t GetDataSize() const
+        {
+            size_t dataSize = 0;
+            for (const AnimSampler* pSampler : m_pComponentSamplers)
+            {
+                if (pSampler)
+                    dataSize += GetSamplerDataSize(*pSampler);
+            }
+            return dataSize;
+        }
+
     private:
 
         typedef struct AnimSampler
         {
             AnimInterpolants m_Time;
             AnimInterpolants m_Value;
+
+            // Sampling layout (SoA), values are either padded to a Vec4 per key or packed to 64 bits per key when compressed
+            std::vector<float>    m_KeyTimes;
+            std::vector<Vec4>     m_KeyValues;
+            std::vector<uint64_t> m_PackedValues;
+            Vec4                  m_RangeMin   = Vec4(0.f, 0.f, 0.f, 0.f);    // Dequantization of packed translations/scales
+            Vec4                  m_RangeScale = Vec4(0.f, 0.f, 0.f, 0.f);
+            bool                  m_IsRotation = false;
         } AnimSampler;
 
-        void SampleLinear(const AnimSampler& sampler, float time, float* frac, float** pCurr, float** pNext) const;
+        static Vec4 GetKeyValue(const AnimSampler& sampler, int32_t index);
+        static size_t GetSamplerDataSize(const AnimSampler& sampler);
+        int32_t FindKey(const AnimSampler& sampler, float time, AnimCursor* pCursor) const;
+        void SampleLinear(const AnimSampler& sampler, float time, AnimCursor* pCursor, float* frac, Vec4* pCurr, Vec4* pNext) const;
 
         AnimSampler* m_pComponentSamplers[static_cast<uint32_t>(ComponentSampler::Count)] = { nullptr };
     };
@@ -242,6 +320,11 @@ namespace cauldron
          */
         void SetNumAnimationChannels(uint32_t numChannels) { m_AnimationChannels.resize(numChannels); }
 
+        /**
+         * @brief   Gets the number of <c><i>AnimChannel</i></c>s in the <c><i>Animation</i></c>.
+         */
+        uint32_t GetNumAnimationChannels() const { return static_cast<uint32_t>(m_AnimationChannels.size()); }
+
         /**
          * @brief   Gets a specific <c><i>AnimChannel</i></c> in order to query it's animation data.
          */
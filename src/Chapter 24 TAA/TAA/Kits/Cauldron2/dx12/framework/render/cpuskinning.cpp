@@ -0,0 +1,192 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "cpuskinning.h"
+#include "../core/framework.h"
+#include "../core/taskmanager.h"
+#include "../misc/assert.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+namespace cauldron
+{
+    // Vertices skinned per task, large enough to amortize dispatch and small enough to balance across threads
+    static constexpr uint32_t s_SkinningChunkSize = 4096;
+
+    struct DualQuat
+    {
+        Vec4 Real;
+        Vec4 Dual;
+    };
+
+    static DualQuat ToDualQuat(const Mat4& matrix)
+    {
+        // Remove any scale so the rotation can be extracted
+        Mat3 rotation = matrix.getUpper3x3();
+        rotation.setCol0(math::normalize(rotation.getCol0()));
+        rotation.setCol1(math::normalize(rotation.getCol1()));
+        rotation.setCol2(math::normalize(rotation.getCol2()));
+
+        const math::Quat real = math::normalize(math::Quat(rotation));
+        const math::Quat dual = math::Quat(matrix.getTranslation(), 0.f) * real * 0.5f;
+
+        DualQuat dq;
+        dq.Real = Vec4(real.getX(), real.getY(), real.getZ(), real.getW());
+        dq.Dual = Vec4(dual.getX(), dual.getY(), dual.getZ(), dual.getW());
+        return dq;
+    }
+
+    static void SkinLinearBlend(const CPUSkinningSource& source, const MatrixPair* pMatrices, uint32_t jointCount, uint32_t first, uint32_t last, CPUSkinningResult& result, Vec4& boundsMin, Vec4& boundsMax)
+    {
+        const bool hasNormals = !source.Normals.empty();
+        for (uint32_t v = first; v < last; ++v)
+        {
+            const uint16_t* pJoints  = &source.Joints[static_cast<size_t>(v) * source.InfluenceCount];
+            const float*    pWeights = &source.Weights[static_cast<size_t>(v) * source.InfluenceCount];
+
+            Mat4 skinMatrix = pMatrices[std::min<uint32_t>(pJoints[0], jointCount - 1)].m_Current * pWeights[0];
+            for (uint32_t i = 1; i < source.InfluenceCount; ++i)
+            {
+                if (pWeights[i] != 0.f)
+                    skinMatrix += pMatrices[std::min<uint32_t>(pJoints[i], jointCount - 1)].m_Current * pWeights[i];
+            }
+
+            const Vec4 position = skinMatrix * source.Positions[v];
+            result.Positions[v] = position;
+            boundsMin = math::minPerElem(boundsMin, position);
+            boundsMax = math::maxPerElem(boundsMax, position);
+
+            if (hasNormals)
+                result.Normals[v] = Vec4(math::normalize((skinMatrix * source.Normals[v]).getXYZ()), 0.f);
+        }
+    }
+
+    static void SkinDualQuaternion(const CPUSkinningSource& source, const std::vector<DualQuat>& dualQuats, uint32_t first, uint32_t last, CPUSkinningResult& result, Vec4& boundsMin, Vec4& boundsMax)
+    {
+        const uint32_t jointCount = static_cast<uint32_t>(dualQuats.size());
+        const bool     hasNormals = !source.Normals.empty();
+        for (uint32_t v = first; v < last; ++v)
+        {
+            const uint16_t* pJoints  = &source.Joints[static_cast<size_t>(v) * source.InfluenceCount];
+            const float*    pWeights = &source.Weights[static_cast<size_t>(v) * source.InfluenceCount];
+
+            const DualQuat& pivot = dualQuats[std::min<uint32_t>(pJoints[0], jointCount - 1)];
+            Vec4 real = pivot.Real * pWeights[0];
+            Vec4 dual = pivot.Dual * pWeights[0];
+            for (uint32_t i = 1; i < source.InfluenceCount; ++i)
+            {
+                if (pWeights[i] == 0.f)
+                    continue;
+
+                // Blend along the shortest path relative to the first influence
+                const DualQuat& dq     = dualQuats[std::min<uint32_t>(pJoints[i], jointCount - 1)];
+                const float     weight = math::dot(dq.Real, pivot.Real) < 0.f ? -pWeights[i] : pWeights[i];
+                real += dq.Real * weight;
+                dual += dq.Dual * weight;
+            }
+
+            const float invLength = 1.f / math::length(real);
+            const math::Quat rotation(real * invLength);
+            const math::Quat translation = math::Quat(dual * invLength) * math::conj(rotation);
+
+            const Vec3 position = math::rotate(rotation, source.Positions[v].getXYZ()) + translation.getXYZ() * 2.f;
+            result.Positions[v] = Vec4(position, 1.f);
+            boundsMin = math::minPerElem(boundsMin, result.Positions[v]);
+            boundsMax = math::maxPerElem(boundsMax, result.Positions[v]);
+
+            if (hasNormals)
+                result.Normals[v] = Vec4(math::normalize(math::rotate(rotation, source.Normals[v].getXYZ())), 0.f);
+        }
+    }
+
+    CPUSkinningStats CPUSkinning::Skin(const CPUSkinningSource& source, const std::vector<MatrixPair>& skinningMatrices, SkinningMode mode, CPUSkinningResult& result)
+    {
+        CPUSkinningStats stats;
+        if (source.VertexCount == 0 || skinningMatrices.empty())
+            return stats;
+
+        CauldronAssert(ASSERT_CRITICAL, source.InfluenceCount > 0 && source.Joints.size() == source.Weights.size() &&
+                                        source.Joints.size() == static_cast<size_t>(source.VertexCount) * source.InfluenceCount,
+                       L"Invalid CPU skinning source data");
+
+        result.Positions.resize(source.VertexCount);
+        result.Normals.resize(source.Normals.empty() ? 0 : source.VertexCount);
+
+        // Dual quaternions are derived once per joint rather than per influence
+        std::vector<DualQuat> dualQuats;
+        if (mode == SkinningMode::DualQuaternion)
+        {
+            dualQuats.resize(skinningMatrices.size());
+            for (size_t i = 0; i < skinningMatrices.size(); ++i)
+                dualQuats[i] = ToDualQuat(skinningMatrices[i].m_Current);
+        }
+
+        const uint32_t    chunkCount = DivideRoundingUp(source.VertexCount, s_SkinningChunkSize);
+        std::vector<Vec4> chunkMin(chunkCount);
+        std::vector<Vec4> chunkMax(chunkCount);
+        std::atomic<uint64_t> busyNanoseconds = { 0 };
+
+        auto skinChunk = [&](uint32_t chunk) {
+            const auto     startTime = std::chrono::high_resolution_clock::now();
+            const uint32_t first     = chunk * s_SkinningChunkSize;
+            const uint32_t last      = std::min<uint32_t>(first + s_SkinningChunkSize, source.VertexCount);
+
+            Vec4 boundsMin(std::numeric_limits<float>::max());
+            Vec4 boundsMax(-std::numeric_limits<float>::max());
+            if (mode == SkinningMode::DualQuaternion)
+                SkinDualQuaternion(source, dualQuats, first, last, result, boundsMin, boundsMax);
+            else
+                SkinLinearBlend(source, skinningMatrices.data(), static_cast<uint32_t>(skinningMatrices.size()), first, last, result, boundsMin, boundsMax);
+            chunkMin[chunk] = boundsMin;
+            chunkMax[chunk] = boundsMax;
+
+            busyNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - startTime).count();
+        };
+
+        // Small surfaces aren't worth dispatching
+        if (chunkCount == 1)
+        {
+            skinChunk(0);
+            stats.ThreadCount = 1;
+        }
+        else
+        {
+            stats.ThreadCount = GetTaskManager()->ParallelFor(chunkCount, skinChunk);
+        }
+
+        result.BoundsMin = chunkMin[0];
+        result.BoundsMax = chunkMax[0];
+        for (uint32_t i = 1; i < chunkCount; ++i)
+        {
+            result.BoundsMin = math::minPerElem(result.BoundsMin, chunkMin[i]);
+            result.BoundsMax = math::maxPerElem(result.BoundsMax, chunkMax[i]);
+        }
+
+        stats.VertexCount = source.VertexCount;
+        stats.BusySeconds = static_cast<double>(busyNanoseconds.load()) * 1e-9;
+        return stats;
+    }
+
+} // namespace cauldron
@@ -0,0 +1,118 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "../misc/helpers.h"
+#include "../misc/math.h"
+#include "../shaders/surfacerendercommon.h"
+
+#include <vector>
+
+namespace cauldron
+{
+    /// An enumeration of the skinning modes supported by <c><i>CPUSkinning</i></c>.
+    ///
+    /// @ingroup CauldronRender
+    enum class SkinningMode : uint32_t
+    {
+        LinearBlend = 0,    ///< Blends the joint matrices (matches the GPU skinning path).
+        DualQuaternion,     ///< Blends joint dual quaternions, preserves volume at joints but ignores joint scale.
+    };
+
+    /**
+     * @struct CPUSkinningSource
+     *
+     * CPU copy of the bind pose and joint influences of a <c><i>Surface</i></c>, laid out for CPU skinning.
+     *
+     * @ingroup CauldronRender
+     */
+    struct CPUSkinningSource
+    {
+        uint32_t              VertexCount    = 0;   ///< Number of vertices.
+        uint32_t              InfluenceCount = 0;   ///< Joint influences per vertex (4 for JOINTS_0 only, 8 with JOINTS_1).
+        std::vector<Vec4>     Positions      = {};  ///< Bind pose positions (w = 1).
+        std::vector<Vec4>     Normals        = {};  ///< Bind pose normals (w = 0), empty when the surface has none.
+        std::vector<uint16_t> Joints         = {};  ///< InfluenceCount joint indices per vertex.
+        std::vector<float>    Weights        = {};  ///< InfluenceCount joint weights per vertex.
+    };
+
+    /**
+     * @struct CPUSkinningResult
+     *
+     * Skinned vertex data and bounds produced by <c><i>CPUSkinning</i></c>.
+     *
+     * @ingroup CauldronRender
+     */
+    struct CPUSkinningResult
+    {
+        std::vector<Vec4> Positions = {};                   ///< Skinned positions (w = 1).
+        std::vector<Vec4> Normals   = {};                   ///< Skinned normals (w = 0).
+        Vec4              BoundsMin = Vec4(0, 0, 0, 1);     ///< Minimum of the skinned positions.
+        Vec4              BoundsMax = Vec4(0, 0, 0, 1);     ///< Maximum of the skinned positions.
+    };
+
+    /**
+     * @struct CPUSkinningStats
+     *
+     * Throughput information for a CPU skinning pass.
+     *
+     * @ingroup CauldronRender
+     */
+    struct CPUSkinningStats
+    {
+        uint64_t VertexCount = 0;       ///< Number of vertices skinned.
+        double   BusySeconds = 0.0;     ///< Time spent skinning, summed over all participating threads.
+        uint32_t ThreadCount = 0;       ///< Number of threads that skinned vertices.
+
+        /**
+         * @brief   Returns the number of vertices skinned per second on a single core.
+         */
+        double VerticesPerSecondPerCore() const { return BusySeconds > 0.0 ? static_cast<double>(VertexCount) / BusySeconds : 0.0; }
+    };
+
+    /**
+     * @class CPUSkinning
+     *
+     * Skins surface geometry on the CPU for systems that need the animated vertices or bounds outside of
+     * rendering (culling, picking, headless rendering). Vertices are processed in chunks across the task
+     * manager's threads.
+     *
+     * @ingroup CauldronRender
+     */
+    class CPUSkinning
+    {
+    public:
+
+        /**
+         * @brief   Skins the source vertices with the current skinning matrices of a skin (as produced by the <c><i>AnimationComponentMgr</i></c>).
+         *          Normals are only skinned if the source has them.
+         */
+        static CPUSkinningStats Skin(const CPUSkinningSource& source, const std::vector<MatrixPair>& skinningMatrices, SkinningMode mode, CPUSkinningResult& result);
+
+    private:
+        CPUSkinning() = delete;
+        NO_COPY(CPUSkinning)
+        NO_MOVE(CPUSkinning)
+    };
+
+} // namespace cauldron
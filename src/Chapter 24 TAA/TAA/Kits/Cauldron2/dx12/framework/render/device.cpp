@@ -69,7 +69,7 @@ namespace cauldron
 
         // Asynchronously delete the active command list in the background once it's cleared the graphics queue
         GPUExecutionPacket* pInflightPacket = new GPUExecutionPacket(cmdLists, signalValue);
-        Task                newTask(std::bind(&Device::DeleteCommandListAsync, this, std::placeholders::_1), reinterpret_cast<void*>(pInflightPacket));
+        Task                newTask([this, pInflightPacket](void*) { DeleteCommandListAsync(pInflightPacket); });
         GetTaskManager()->AddTask(newTask);
 
         // Make sure no one tries to do anything with this
@@ -82,14 +82,12 @@ namespace cauldron
 
         // Asynchronously delete the active command list in the background once it's cleared the graphics queue
         GPUExecutionPacket* pInflightPacket = new GPUExecutionPacket(cmdLists, signalValue);
-        Task newTask(std::bind(&Device::DeleteCommandListAsync, this, std::placeholders::_1), reinterpret_cast<void*>(pInflightPacket));
+        Task newTask([this, pInflightPacket](void*) { DeleteCommandListAsync(pInflightPacket); });
         GetTaskManager()->AddTask(newTask);
     }
 
-    void Device::DeleteCommandListAsync(void* pInFlightGPUInfo)
+    void Device::DeleteCommandListAsync(GPUExecutionPacket* pInflightPacket)
     {
-        GPUExecutionPacket* pInflightPacket = static_cast<GPUExecutionPacket*>(pInFlightGPUInfo);
-
         // Wait until the command lists are processed
         WaitOnQueue(pInflightPacket->CompletionID, CommandQueue::Graphics);
 
@@ -264,7 +264,7 @@ namespace cauldron
     protected:
         
         Device();
-        void DeleteCommandListAsync(void* pInFlightGPUInfo);
+        void DeleteCommandListAsync(GPUExecutionPacket* pInflightPacket);
 
     private:        
         
@@ -35,6 +35,9 @@
 
 namespace cauldron
 {
+    // Buffer uploads larger than this are split so they don't need to fit in the upload heap as a whole
+    static constexpr size_t s_BufferUploadChunkSize = 4 * 1024 * 1024;
+
     BufferCopyDesc::BufferCopyDesc(const GPUResource* pSource, const GPUResource* pDest)
     {
         GetImpl()->pSrc = const_cast<ID3D12Resource*>(pSource->GetImpl()->DX12Resource());
@@ -79,31 +82,40 @@ namespace cauldron
     {
         UploadHeap* pUploadHeap = GetUploadHeap();
 
-        TransferInfo* pTransferInfo = pUploadHeap->BeginResourceTransfer(size, 256, 1);
-
-        uint8_t* pMapped = pTransferInfo->DataPtr(0);
-        memcpy(pMapped, pData, size);
-
-        BufferCopyDesc desc;
-        desc.GetImpl()->pSrc = pUploadHeap->GetResource()->GetImpl()->DX12Resource();
-        desc.GetImpl()->pDst = m_pResource->GetImpl()->DX12Resource();
-        desc.GetImpl()->SrcOffset = pMapped - pUploadHeap->BasePtr();
-        desc.GetImpl()->DstOffset = 0;
-        desc.GetImpl()->Size = static_cast<UINT64>(size);
-
-        CommandList* pImmediateCmdList = GetDevice()->CreateCommandList(L"BufferCopyCmdList", CommandQueue::Copy);
-        CopyBufferRegion(pImmediateCmdList, &desc);
-        CloseCmdList(pImmediateCmdList);
-
-        // Execute and sync
-        std::vector<CommandList*> cmdLists;
-        cmdLists.push_back(pImmediateCmdList);
-        GetDevice()->ExecuteCommandListsImmediate(cmdLists, CommandQueue::Copy);
-
-        // No longer needed, will release allocator on destruction
-        delete pImmediateCmdList;
-
-        pUploadHeap->EndResourceTransfer(pTransferInfo);
+        // Upload in chunks of whatever the upload heap can currently hold rather than waiting for the whole buffer to fit
+        const uint32_t chunkCount = static_cast<uint32_t>((size + s_BufferUploadChunkSize - 1) / s_BufferUploadChunkSize);
+        size_t offset = 0;
+        while (offset < size)
+        {
+            const uint32_t remainingChunks = chunkCount - static_cast<uint32_t>(offset / s_BufferUploadChunkSize);
+            TransferInfo* pTransferInfo = pUploadHeap->BeginPartialResourceTransfer(std::min(size, s_BufferUploadChunkSize), 256, remainingChunks);
+            const size_t copySize = std::min(size - offset, pTransferInfo->GetSliceCount() * s_BufferUploadChunkSize);
+
+            uint8_t* pMapped = pTransferInfo->DataPtr(0);
+            memcpy(pMapped, static_cast<const uint8_t*>(pData) + offset, copySize);
+
+            BufferCopyDesc desc;
+            desc.GetImpl()->pSrc = pUploadHeap->GetResource()->GetImpl()->DX12Resource();
+            desc.GetImpl()->pDst = m_pResource->GetImpl()->DX12Resource();
+            desc.GetImpl()->SrcOffset = pMapped - pUploadHeap->BasePtr();
+            desc.GetImpl()->DstOffset = static_cast<UINT64>(offset);
+            desc.GetImpl()->Size = static_cast<UINT64>(copySize);
+
+            CommandList* pImmediateCmdList = GetDevice()->CreateCommandList(L"BufferCopyCmdList", CommandQueue::Copy);
+            CopyBufferRegion(pImmediateCmdList, &desc);
+            CloseCmdList(pImmediateCmdList);
+
+            // Execute and sync
+            std::vector<CommandList*> cmdLists;
+            cmdLists.push_back(pImmediateCmdList);
+            GetDevice()->ExecuteCommandListsImmediate(cmdLists, CommandQueue::Copy);
+
+            // No longer needed, will release allocator on destruction
+            delete pImmediateCmdList;
+
+            pUploadHeap->EndResourceTransfer(pTransferInfo);
+            offset += copySize;
+        }
     }
 
     // TODO: Make signature take an actual upload context
@@ -112,21 +124,34 @@ namespace cauldron
         CauldronAssert(ASSERT_CRITICAL, pUploadContext != nullptr, L"null upload context");
 
         UploadHeap* pUploadHeap = GetUploadHeap();
-        TransferInfo* pTransferInfo = pUploadHeap->BeginResourceTransfer(size, 256, 1);
-
-        // Copy the data
-        uint8_t* pMapped = pTransferInfo->DataPtr(0);
-        memcpy(pMapped, pData, size);
 
-        BufferCopyDesc desc;
-        desc.GetImpl()->pSrc = pUploadHeap->GetResource()->GetImpl()->DX12Resource();
-        desc.GetImpl()->pDst = m_pResource->GetImpl()->DX12Resource();
-        desc.GetImpl()->SrcOffset = pMapped - pUploadHeap->BasePtr();
-        desc.GetImpl()->DstOffset = 0;
-        desc.GetImpl()->Size = static_cast<UINT64>(size);
-
-        // Copy
-        CopyBufferRegion(pUploadContext->GetImpl()->GetCopyCmdList(), &desc);
+        // Large buffers are split in chunks so they don't need a single contiguous block of the upload heap
+        const uint32_t chunkCount = static_cast<uint32_t>((size + s_BufferUploadChunkSize - 1) / s_BufferUploadChunkSize);
+        size_t offset = 0;
+        while (offset < size)
+        {
+            const uint32_t remainingChunks = chunkCount - static_cast<uint32_t>(offset / s_BufferUploadChunkSize);
+            TransferInfo* pTransferInfo = pUploadHeap->BeginPartialResourceTransfer(std::min(size, s_BufferUploadChunkSize), 256, remainingChunks);
+            const size_t copySize = std::min(size - offset, pTransferInfo->GetSliceCount() * s_BufferUploadChunkSize);
+
+            // Copy the data
+            uint8_t* pMapped = pTransferInfo->DataPtr(0);
+            memcpy(pMapped, static_cast<const uint8_t*>(pData) + offset, copySize);
+
+            BufferCopyDesc desc;
+            desc.GetImpl()->pSrc = pUploadHeap->GetResource()->GetImpl()->DX12Resource();
+            desc.GetImpl()->pDst = m_pResource->GetImpl()->DX12Resource();
+            desc.GetImpl()->SrcOffset = pMapped - pUploadHeap->BasePtr();
+            desc.GetImpl()->DstOffset = static_cast<UINT64>(offset);
+            desc.GetImpl()->Size = static_cast<UINT64>(copySize);
+
+            // Copy
+            CopyBufferRegion(pUploadContext->GetImpl()->GetCopyCmdList(), &desc);
+
+            // The upload context releases the transfer once its copies have executed
+            pUploadContext->AppendTransferInfo(pTransferInfo);
+            offset += copySize;
+        }
 
         // Transition
         Barrier barrier = Barrier::Transition(GetResource(), ResourceState::CopyDest, postCopyState);
@@ -61,39 +61,7 @@ namespace cauldron
 
     bool DynamicBufferPoolInternal::InternalAlloc(uint32_t size, uint32_t* offset)
     {
-        std::lock_guard<std::mutex> memlock(m_Mutex);
-
-        // check if we can directly allocate from head
-        if (m_Head >= m_Tail && m_Head + size < m_TotalSize)
-        {
-            *offset = m_Head;
-            m_Head += size;
-            m_AllocationTotal += size;
-            return true;
-        }
-
-        // check head if we've wrapped
-        if (m_Tail > m_Head && m_Tail - m_Head > size)
-        {
-            *offset = m_Head;
-            m_Head += size;
-            m_AllocationTotal += size;
-            return true;
-        }
-
-        // check if we need to wrap
-        if (m_Head >= m_Tail && m_Head + size >= m_TotalSize)
-        {
-            if (size < m_Tail)
-            {
-                *offset = 0;
-                m_AllocationTotal += (m_TotalSize - m_Head) + size;
-                m_Head = size;
-                return true;
-            }
-        }
-
-        return false;
+        return m_Allocator.Allocate(size, 256u, *offset);
     }
 
     BufferAddressInfo DynamicBufferPoolInternal::AllocConstantBuffer(uint32_t size, const void* pInitData)
@@ -178,40 +146,14 @@ namespace cauldron
         return bufferInfo;
     }
 
-   
-
     void DynamicBufferPoolInternal::EndFrame()
     {
-        MemoryPoolFrameInfo poolInfo = {};
-
-        // set a fence on the command queue to know when this memory has been processed so we can move up the tail
-        poolInfo.gpuSignal = GetDevice()->SignalQueue(CommandQueue::Graphics);
+        // set a fence on the command queue to know when this frame's memory has been processed so we can retire it
+        m_FrameFenceValue = GetDevice()->SignalQueue(CommandQueue::Graphics);
+        m_Allocator.EndFrame(m_FrameFenceValue);
 
-        {
-            std::lock_guard<std::mutex> memlock(m_Mutex);
-            poolInfo.allocationSize = m_AllocationTotal;
-            m_AllocationTotal = 0; // cleared as all allocations from here are "fresh"
-        }
-        
-        // Enqueue the information
-        m_FrameAllocationQueue.push(poolInfo);
-        
-        // Check past frame allocations to see if we can recoup them
-        while(!m_FrameAllocationQueue.empty())
-        {
-            MemoryPoolFrameInfo& frameEntry = m_FrameAllocationQueue.front();
-            if (frameEntry.gpuSignal > GetDevice()->QueryLastCompletedValue(CommandQueue::Graphics))
-            {
-                break; // nothing else is done
-            }
-
-            // Lock the mutex, and move up the tail
-            {
-                std::lock_guard<std::mutex> memlock(m_Mutex);
-                m_Tail = (m_Tail + frameEntry.allocationSize) % m_TotalSize;
-            }
-            m_FrameAllocationQueue.pop();            
-        }
+        // Recoup the memory of past frames the GPU is done with
+        m_Allocator.Retire(GetDevice()->QueryLastCompletedValue(CommandQueue::Graphics));
     }
 
 } // namespace cauldron
@@ -25,8 +25,6 @@
 #include "../dynamicbufferpool.h"
 #include "buffer_dx12.h"
 
-#include <queue>
-
 namespace cauldron
 {
     class DynamicBufferPoolInternal final : public DynamicBufferPool
@@ -45,20 +43,6 @@ namespace cauldron
         virtual ~DynamicBufferPoolInternal();
 
         bool InternalAlloc(uint32_t size, uint32_t* offset);
-
-        struct MemoryPoolFrameInfo
-        {
-            uint64_t gpuSignal      = 0;
-            uint32_t allocationSize = 0;
-        };
-
-    private:
-
-        std::mutex                      m_Mutex;
-        uint32_t                        m_AllocationTotal  = 0;
-        std::queue<MemoryPoolFrameInfo> m_FrameAllocationQueue = {};
-        uint32_t                        m_Tail = 0;
-        uint32_t                        m_Head = 0;
     };
 
 } // namespace cauldron
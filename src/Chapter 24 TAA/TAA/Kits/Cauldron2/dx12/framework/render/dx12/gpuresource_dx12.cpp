@@ -438,6 +438,10 @@ namespace
             return DXGI_FORMAT_R16G16_TYPELESS;
         case ResourceFormat::RG16_FLOAT:
             return DXGI_FORMAT_R16G16_FLOAT;
+        case ResourceFormat::RG16_UNORM:
+            return DXGI_FORMAT_R16G16_UNORM;
+        case ResourceFormat::RG16_SNORM:
+            return DXGI_FORMAT_R16G16_SNORM;
         case ResourceFormat::R32_TYPELESS:
             return DXGI_FORMAT_R32_TYPELESS;
         case ResourceFormat::R32_FLOAT:
@@ -612,6 +616,8 @@ namespace
         case ResourceFormat::RG11B10_FLOAT:
         case ResourceFormat::RGB9E5_SHAREDEXP:
         case ResourceFormat::RG16_FLOAT:
+        case ResourceFormat::RG16_UNORM:
+        case ResourceFormat::RG16_SNORM:
         case ResourceFormat::R32_UINT:
         case ResourceFormat::R32_FLOAT:
         case ResourceFormat::D32_FLOAT:
@@ -29,6 +29,7 @@
 
 #include "../../core/framework.h"
 #include "../../misc/assert.h"
+#include "../resourceviewallocator.h"
 
 
 namespace cauldron
@@ -36,17 +37,24 @@ namespace cauldron
     ResourceView* ResourceView::CreateResourceView(ResourceViewHeapType type, uint32_t count, void* pInitParams)
     {
         ResourceViewInitParams* pParams = (ResourceViewInitParams*)pInitParams;
-        return new ResourceViewInternal(pParams->hCPUHandle, pParams->hGPUHandle, type, count, pParams->descriptorSize);
+        return new ResourceViewInternal(pParams->hCPUHandle, pParams->hGPUHandle, type, count, pParams->descriptorSize, pParams->descriptorIndex);
     }
 
-    ResourceViewInternal::ResourceViewInternal(D3D12_CPU_DESCRIPTOR_HANDLE hCPUHandle, D3D12_GPU_DESCRIPTOR_HANDLE hGPUHandle, ResourceViewHeapType type, uint32_t count, uint32_t descriptorSize) :
+    ResourceViewInternal::ResourceViewInternal(D3D12_CPU_DESCRIPTOR_HANDLE hCPUHandle, D3D12_GPU_DESCRIPTOR_HANDLE hGPUHandle, ResourceViewHeapType type, uint32_t count, uint32_t descriptorSize, uint32_t descriptorIndex) :
         ResourceView(type, count),
         m_hGPUHandle(hGPUHandle),
         m_hCPUHandle(hCPUHandle),
-        m_DescriptorSize(descriptorSize)
+        m_DescriptorSize(descriptorSize),
+        m_DescriptorIndex(descriptorIndex)
     {
     }
 
+    ResourceViewInternal::~ResourceViewInternal()
+    {
+        // Hand the descriptors back for reuse once the GPU is done with them
+        GetResourceViewAllocator()->ReleaseViews(m_Type, m_DescriptorIndex, m_Count);
+    }
+
     const ResourceViewInfo ResourceViewInternal::GetViewInfo(uint32_t index) const
     {
         CauldronAssert(ASSERT_CRITICAL, index < m_Count, L"Accessing view out of the bounds");
@@ -39,6 +39,7 @@ namespace cauldron
         D3D12_CPU_DESCRIPTOR_HANDLE hCPUHandle;
         D3D12_GPU_DESCRIPTOR_HANDLE hGPUHandle;
         uint32_t                    descriptorSize;
+        uint32_t                    descriptorIndex;
     };
 
     class ResourceViewInternal final : public ResourceView
@@ -52,9 +53,9 @@ namespace cauldron
 
     private:
         friend class ResourceView;
-        ResourceViewInternal(D3D12_CPU_DESCRIPTOR_HANDLE hCPUHandle, D3D12_GPU_DESCRIPTOR_HANDLE hGPUHandle, ResourceViewHeapType type, uint32_t count, uint32_t descriptorSize);
+        ResourceViewInternal(D3D12_CPU_DESCRIPTOR_HANDLE hCPUHandle, D3D12_GPU_DESCRIPTOR_HANDLE hGPUHandle, ResourceViewHeapType type, uint32_t count, uint32_t descriptorSize, uint32_t descriptorIndex);
         ResourceViewInternal() = delete;
-        virtual ~ResourceViewInternal() = default;
+        virtual ~ResourceViewInternal();
 
         void BindRTV(const GPUResource* pResource, const TextureDesc& textureDesc, ViewDimension dimension, int32_t mip, int32_t arraySize, int32_t firstSlice, uint32_t index);
         void BindDSV(const GPUResource* pResource, const TextureDesc& textureDesc, ViewDimension dimension, int32_t mip, int32_t arraySize, int32_t firstSlice, uint32_t index);
@@ -71,6 +72,7 @@ namespace cauldron
         D3D12_GPU_DESCRIPTOR_HANDLE m_hGPUHandle = {};
         D3D12_CPU_DESCRIPTOR_HANDLE m_hCPUHandle = {};
         uint32_t                    m_DescriptorSize = 0;
+        uint32_t                    m_DescriptorIndex = 0;
 
         D3D12_CPU_DESCRIPTOR_HANDLE GetCPUHandle(uint32_t index) const;
         D3D12_GPU_DESCRIPTOR_HANDLE GetGPUHandle(uint32_t index) const;
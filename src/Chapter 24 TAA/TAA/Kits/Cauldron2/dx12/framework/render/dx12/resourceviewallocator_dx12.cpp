@@ -24,6 +24,7 @@
 
 #include "../../core/framework.h"
 #include "../../misc/assert.h"
+#include "../../misc/descriptorallocator.h"
 
 #include "device_dx12.h"
 #include "resourceview_dx12.h"
@@ -95,9 +96,11 @@ namespace cauldron
     ResourceView* ResourceViewAllocatorInternal::AllocateViews(ResourceViewHeapType type, uint32_t count)
     {
         uint32_t heapID = static_cast<uint32_t>(type);
-        CauldronAssert(ASSERT_CRITICAL,
-                       m_DescriptorIndex[heapID] + count <= m_NumDescriptors[heapID],
-                       L"Resource view allocator has run out of memory, please increase its size.");
+
+        // This can happen on background threads, the descriptor allocator is thread-safe
+        uint32_t descriptorIndex = 0;
+        bool allocated = m_pDescriptorAllocators[heapID]->Allocate(count, descriptorIndex);
+        CauldronAssert(ASSERT_CRITICAL, allocated, L"Resource view allocator has run out of memory, please increase its size.");
 
         ResourceView* pView = nullptr;
 
@@ -106,12 +109,9 @@ namespace cauldron
         if (type == ResourceViewHeapType::GPUResourceView || type == ResourceViewHeapType::GPUSamplerView)
             needsGPU = true;
 
-        // Allocate the handles
+        // Setup the handles
         {
-            // This can happen on background threads
-            std::unique_lock<std::mutex> lock(m_CriticalSection);
-
-            uint32_t                    offset  = m_DescriptorIndex[heapID] * m_DescriptorSizes[heapID];
+            uint64_t                    offset  = static_cast<uint64_t>(descriptorIndex) * m_DescriptorSizes[heapID];
             D3D12_CPU_DESCRIPTOR_HANDLE cpuView = m_pDescriptorHeaps[heapID]->GetCPUDescriptorHandleForHeapStart();
             cpuView.ptr += offset;
 
@@ -127,11 +127,9 @@ namespace cauldron
             initParams.hCPUHandle = cpuView;
             initParams.hGPUHandle = gpuView;
             initParams.descriptorSize = m_DescriptorSizes[heapID];
+            initParams.descriptorIndex = descriptorIndex;
             pView = ResourceView::CreateResourceView(type, count, &initParams);
             CauldronAssert(ASSERT_ERROR, pView != nullptr, L"Could not allocate ResourceView");
-
-            // Increment internals
-            m_DescriptorIndex[heapID] += count;
         }
 
         return pView;
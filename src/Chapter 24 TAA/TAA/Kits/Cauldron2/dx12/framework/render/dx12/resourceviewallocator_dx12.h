@@ -51,9 +51,7 @@ namespace cauldron
     protected:
         MSComPtr<ID3D12DescriptorHeap>                  m_pDescriptorHeaps[static_cast<uint32_t>(ResourceViewHeapType::Count)] = {nullptr};
         uint32_t                                        m_DescriptorSizes[static_cast<uint32_t>(ResourceViewHeapType::Count)]  = {0};
-        uint32_t                                        m_DescriptorIndex[static_cast<uint32_t>(ResourceViewHeapType::Count)]  = {0};
         uint32_t                                        m_NumDescriptors[static_cast<uint32_t>(ResourceViewHeapType::Count)]   = {0};
-        std::mutex                                      m_CriticalSection;
     };
 
 } // namespace cauldron
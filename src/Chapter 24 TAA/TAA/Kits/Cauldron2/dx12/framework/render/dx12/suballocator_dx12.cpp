@@ -0,0 +1,108 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#if defined(_DX12)
+
+#include "suballocator_dx12.h"
+#include "../../misc/assert.h"
+
+namespace cauldron
+{
+    Suballocator* Suballocator::CreateSuballocator(const wchar_t* name, uint64_t size, uint64_t granularity, SuballocatorBackend backend)
+    {
+        switch (backend)
+        {
+        case SuballocatorBackend::VirtualBlock:
+            return new VirtualBlockSuballocator(name, size, granularity, false);
+        case SuballocatorBackend::VirtualBlockLinear:
+            return new VirtualBlockSuballocator(name, size, granularity, true);
+        case SuballocatorBackend::TLSF:
+        default:
+            return new TLSFSuballocator(name, size, granularity);
+        }
+    }
+
+    VirtualBlockSuballocator::VirtualBlockSuballocator(const wchar_t* name, uint64_t size, uint64_t granularity, bool linear) :
+        Suballocator(name, size, granularity, linear ? SuballocatorBackend::VirtualBlockLinear : SuballocatorBackend::VirtualBlock)
+    {
+        D3D12MA::VIRTUAL_BLOCK_DESC blockDesc = {};
+        blockDesc.Flags = linear ? D3D12MA::VIRTUAL_BLOCK_FLAG_ALGORITHM_LINEAR : D3D12MA::VIRTUAL_BLOCK_FLAG_NONE;
+        blockDesc.Size  = size;
+        CauldronThrowOnFail(D3D12MA::CreateVirtualBlock(&blockDesc, &m_pVirtualBlock));
+    }
+
+    VirtualBlockSuballocator::~VirtualBlockSuballocator()
+    {
+        // Leaks are reported by the base class, don't trip D3D12MA's own checks on top of that
+        if (!m_pVirtualBlock->IsEmpty())
+            m_pVirtualBlock->Clear();
+        m_pVirtualBlock->Release();
+    }
+
+    bool VirtualBlockSuballocator::AllocateInternal(uint64_t size, uint64_t alignment, Allocation& allocation)
+    {
+        D3D12MA::VIRTUAL_ALLOCATION_DESC allocationDesc = {};
+        allocationDesc.Size      = size;
+        allocationDesc.Alignment = alignment;
+
+        D3D12MA::VirtualAllocation virtualAllocation = {};
+        UINT64 offset = 0;
+        if (FAILED(m_pVirtualBlock->Allocate(&allocationDesc, &virtualAllocation, &offset)))
+            return false;
+
+        allocation.Offset = offset;
+        allocation.Size   = size;
+        allocation.Handle = virtualAllocation.AllocHandle;
+        return true;
+    }
+
+    void VirtualBlockSuballocator::FreeInternal(uint64_t handle)
+    {
+        m_pVirtualBlock->FreeAllocation({ handle });
+    }
+
+    uint64_t VirtualBlockSuballocator::GetLargestFreeBlockSizeInternal() const
+    {
+        D3D12MA::DetailedStatistics stats = {};
+        m_pVirtualBlock->CalculateStatistics(&stats);
+        return stats.UnusedRangeCount ? stats.UnusedRangeSizeMax : 0;
+    }
+
+    uint32_t VirtualBlockSuballocator::GetFreeBlockCountInternal() const
+    {
+        D3D12MA::DetailedStatistics stats = {};
+        m_pVirtualBlock->CalculateStatistics(&stats);
+        return stats.UnusedRangeCount;
+    }
+
+    std::string VirtualBlockSuballocator::GetDetailedStatsInternal() const
+    {
+        WCHAR* pStatsString = nullptr;
+        m_pVirtualBlock->BuildStatsString(&pStatsString);
+        std::string detailedStats = WStringToString(pStatsString);
+        m_pVirtualBlock->FreeStatsString(pStatsString);
+        return detailedStats;
+    }
+
+} // namespace cauldron
+
+#endif // #if defined(_DX12)
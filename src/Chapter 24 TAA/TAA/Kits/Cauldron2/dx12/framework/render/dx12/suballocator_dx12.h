@@ -0,0 +1,57 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "../suballocator.h"
+
+#ifndef D3D12MA_USING_DIRECTX_HEADERS
+#define D3D12MA_USING_DIRECTX_HEADERS
+#endif // #ifndef D3D12MA_USING_DIRECTX_HEADERS
+#include "../../../../../OpenSource/amd/memoryallocator/D3D12MemAlloc.h"
+
+namespace cauldron
+{
+    /**
+     * @class VirtualBlockSuballocator
+     *
+     * <c><i>Suballocator</i></c> backend built on a D3D12MA virtual block (pure CPU-side book-keeping).
+     *
+     * @ingroup CauldronRender
+     */
+    class VirtualBlockSuballocator final : public Suballocator
+    {
+    public:
+        VirtualBlockSuballocator(const wchar_t* name, uint64_t size, uint64_t granularity, bool linear);
+        virtual ~VirtualBlockSuballocator();
+
+    private:
+        bool AllocateInternal(uint64_t size, uint64_t alignment, Allocation& allocation) override;
+        void FreeInternal(uint64_t handle) override;
+        uint64_t GetLargestFreeBlockSizeInternal() const override;
+        uint32_t GetFreeBlockCountInternal() const override;
+        std::string GetDetailedStatsInternal() const override;
+
+        D3D12MA::VirtualBlock* m_pVirtualBlock = nullptr;
+    };
+
+} // namespace cauldron
@@ -115,39 +115,47 @@ namespace cauldron
 
         UploadHeap* pUploadHeap = GetUploadHeap();
 
-        // Get what we need to transfer data
-        TransferInfo* pTransferInfo = pUploadHeap->BeginResourceTransfer(uplHeapSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT, m_TextureDesc.DepthOrArraySize);
-
-        std::vector<TextureCopyDesc>    copyInfoList;
+        // Upload as many array slices at a time as the upload heap can hold rather than waiting for all of them to fit
         uint32_t readOffset = 0;
-        for (uint32_t a = 0; a < m_TextureDesc.DepthOrArraySize; ++a)
+        uint32_t firstSlice = 0;
+        while (firstSlice < m_TextureDesc.DepthOrArraySize)
         {
-            // Get the pointer for the entries in this slice (depth slice or array entr6y)
-            UINT8* pPixels = pTransferInfo->DataPtr(a);
+            // Get what we need to transfer data
+            TransferInfo* pTransferInfo = pUploadHeap->BeginPartialResourceTransfer(uplHeapSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT, m_TextureDesc.DepthOrArraySize - firstSlice);
 
-            // Copy all the mip slices into the offsets specified by the footprint structure
-            for (uint32_t mip = 0; mip < m_TextureDesc.MipLevels; ++mip)
+            std::vector<TextureCopyDesc>    copyInfoList;
+            for (uint32_t s = 0; s < pTransferInfo->GetSliceCount(); ++s)
             {
-                pTextureDataBlock->CopyTextureData(pPixels + placedTex2D[mip].Offset, placedTex2D[mip].Footprint.RowPitch, (placedTex2D[mip].Footprint.Width * formatStride) / pixelsPerBlock, numRows[mip], readOffset);
-                readOffset += ((numRows[mip] * placedTex2D[mip].Footprint.Width * formatStride) / pixelsPerBlock);
-                
-                D3D12_PLACED_SUBRESOURCE_FOOTPRINT slice = placedTex2D[mip];
-                slice.Offset += (pPixels - pUploadHeap->BasePtr());
-                
-                TextureCopyDesc copyDesc = {};
-                copyDesc.GetImpl()->Dst = CD3DX12_TEXTURE_COPY_LOCATION(m_pResource->GetImpl()->DX12Resource(), a * m_TextureDesc.MipLevels + mip);
-                copyDesc.GetImpl()->Src = CD3DX12_TEXTURE_COPY_LOCATION(pUploadHeap->GetImpl()->DX12Resource(), slice);
-                copyDesc.GetImpl()->pCopyBox = nullptr;
-
-                copyInfoList.push_back(copyDesc);
+                const uint32_t a = firstSlice + s;
+
+                // Get the pointer for the entries in this slice (depth slice or array entr6y)
+                UINT8* pPixels = pTransferInfo->DataPtr(s);
+
+                // Copy all the mip slices into the offsets specified by the footprint structure
+                for (uint32_t mip = 0; mip < m_TextureDesc.MipLevels; ++mip)
+                {
+                    pTextureDataBlock->CopyTextureData(pPixels + placedTex2D[mip].Offset, placedTex2D[mip].Footprint.RowPitch, (placedTex2D[mip].Footprint.Width * formatStride) / pixelsPerBlock, numRows[mip], readOffset);
+                    readOffset += ((numRows[mip] * placedTex2D[mip].Footprint.Width * formatStride) / pixelsPerBlock);
+
+                    D3D12_PLACED_SUBRESOURCE_FOOTPRINT slice = placedTex2D[mip];
+                    slice.Offset += (pPixels - pUploadHeap->BasePtr());
+
+                    TextureCopyDesc copyDesc = {};
+                    copyDesc.GetImpl()->Dst = CD3DX12_TEXTURE_COPY_LOCATION(m_pResource->GetImpl()->DX12Resource(), a * m_TextureDesc.MipLevels + mip);
+                    copyDesc.GetImpl()->Src = CD3DX12_TEXTURE_COPY_LOCATION(pUploadHeap->GetImpl()->DX12Resource(), slice);
+                    copyDesc.GetImpl()->pCopyBox = nullptr;
+
+                    copyInfoList.push_back(copyDesc);
+                }
             }
-        }
+            firstSlice += pTransferInfo->GetSliceCount();
 
-        // Copy all immediate
-        GetDevice()->ExecuteTextureResourceCopyImmediate(static_cast<int32_t>(copyInfoList.size()), copyInfoList.data());
+            // Copy all immediate
+            GetDevice()->ExecuteTextureResourceCopyImmediate(static_cast<int32_t>(copyInfoList.size()), copyInfoList.data());
 
-        // Kick off the resource transfer. When we get back from here the resource is ready to be used.
-        pUploadHeap->EndResourceTransfer(pTransferInfo);
+            // Kick off the resource transfer. When we get back from here the resource is ready to be used.
+            pUploadHeap->EndResourceTransfer(pTransferInfo);
+        }
     }
 
     void Texture::Recreate()
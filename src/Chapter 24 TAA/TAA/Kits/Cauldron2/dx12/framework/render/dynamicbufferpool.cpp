@@ -27,10 +27,10 @@
 
 namespace cauldron
 {
-    DynamicBufferPool::DynamicBufferPool()
+    DynamicBufferPool::DynamicBufferPool() :
+        m_TotalSize(AlignUp<uint32_t>(static_cast<uint32_t>(GetConfig()->DynamicBufferPoolSize), 256u)),
+        m_Allocator(m_TotalSize, AlignUp<uint32_t>(GetConfig()->DynamicBufferChunkSize, 256u))
     {
-        const CauldronConfig* pConfig = GetConfig();
-        m_TotalSize = AlignUp<uint32_t>(static_cast<uint32_t>(pConfig->DynamicBufferPoolSize), 256u);
     }
 
     DynamicBufferPool::~DynamicBufferPool()
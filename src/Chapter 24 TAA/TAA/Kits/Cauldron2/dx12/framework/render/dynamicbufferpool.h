@@ -23,6 +23,7 @@
 #pragma once
 
 #include "../misc/helpers.h"
+#include "../misc/frameringallocator.h"
 
 #include <mutex>
 
@@ -93,6 +94,11 @@ namespace cauldron
          */
         virtual void EndFrame() = 0;
 
+        /**
+         * @brief   Returns the graphics queue fence value signaled by the last call to EndFrame.
+         */
+        uint64_t GetFrameFenceValue() const { return m_FrameFenceValue; }
+
 
     private:
         // No copy, No move
@@ -107,6 +113,10 @@ namespace cauldron
         uint32_t     m_TotalSize  = 0;
         uint8_t*     m_pData      = nullptr;
 
+        // Hands out per-thread chunks of the pool, retired a frame at a time
+        FrameRingAllocator m_Allocator;
+        uint64_t           m_FrameFenceValue = 0;
+
         // Backing resource
         GPUResource* m_pResource = nullptr;
     };
@@ -114,6 +114,8 @@ namespace cauldron
         case ResourceFormat::RG16_SINT:
         case ResourceFormat::RG16_UINT:
         case ResourceFormat::RG16_FLOAT:
+        case ResourceFormat::RG16_UNORM:
+        case ResourceFormat::RG16_SNORM:
         case ResourceFormat::R32_FLOAT:
         case ResourceFormat::D32_FLOAT:
             return 4;
@@ -21,7 +21,10 @@
 // THE SOFTWARE.
 
 #include "mesh.h"
+#include "../core/contentmanager.h"
+#include "../core/framework.h"
 #include "buffer.h"
+#include "cpuskinning.h"
 #include "material.h"
 #include "rtresources.h"
 #include "shaderbuilder.h"
@@ -35,10 +38,22 @@ namespace cauldron
 
     Surface::~Surface()
     {
-        // Delete memory for the index and vertex buffer info
-        delete m_IndexBuffer.pBuffer;
+        // Release the index and vertex buffers (buffers shared through the content manager are only deleted once unreferenced)
+        if (m_IndexBuffer.pBuffer && !GetContentManager()->ReleaseBuffer(m_IndexBuffer.pBuffer))
+            delete m_IndexBuffer.pBuffer;
         for (int i = 0; i < m_VertexBuffers.size(); ++i)
-            delete m_VertexBuffers[i].pBuffer;
+        {
+            if (m_VertexBuffers[i].pBuffer && !GetContentManager()->ReleaseBuffer(m_VertexBuffers[i].pBuffer))
+                delete m_VertexBuffers[i].pBuffer;
+        }
+
+        delete m_pCPUSkinningSource;
+    }
+
+    void Surface::SetCPUSkinningSource(CPUSkinningSource* pSource)
+    {
+        delete m_pCPUSkinningSource;
+        m_pCPUSkinningSource = pSource;
     }
 
     uint32_t Surface::GetAttributeStride(VertexAttributeType type) const
@@ -35,6 +35,7 @@ namespace cauldron
     class BLAS;
     class Buffer;
     class Material;
+    struct CPUSkinningSource;
 
     /// Structure representing the vertex buffer information for a vertex data stream (component channel).
     ///
@@ -138,6 +139,16 @@ namespace cauldron
          */
         static void GetVertexAttributeDefines(uint32_t attributes, DefineList& defines);
 
+        /**
+         * @brief   Returns the CPU copy of the surface's skinning inputs (only retained for skinned surfaces when CPU skinning is enabled).
+         */
+        const CPUSkinningSource* GetCPUSkinningSource() const { return m_pCPUSkinningSource; }
+
+        /**
+         * @brief   Sets the CPU copy of the surface's skinning inputs. The surface takes ownership of it.
+         */
+        void SetCPUSkinningSource(CPUSkinningSource* pSource);
+
         /**
          * @brief   Returns the ID of the surface in the Mesh.
          */
@@ -158,6 +169,8 @@ namespace cauldron
         uint32_t m_surfaceID = 0;
 
         const Material* m_pMaterial = nullptr;
+
+        CPUSkinningSource* m_pCPUSkinningSource = nullptr;
     };
 
     /**
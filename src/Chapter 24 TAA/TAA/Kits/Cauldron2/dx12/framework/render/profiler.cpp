@@ -24,16 +24,58 @@
 #include "device.h"
 #include "../core/framework.h"
 #include "../misc/assert.h"
+#include "../misc/cpuprofilebuffer.h"
+#include "../misc/log.h"
 #include "commandlist.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+
 namespace cauldron
 {
+    /////////////////////////////////////////////////////////////////////////
+    // Per-thread CPU event buffers
+    /////////////////////////////////////////////////////////////////////////
+
+    static_assert(Profiler::s_MAX_CPU_CAPTURE_DEPTH == CPUProfileBuffer::s_MaxDepth, "CPU capture depth mismatch");
+
+    // Captures of a thread, along with how the thread shows up in traces
+    class ProfilerThreadBuffer : public CPUProfileBuffer
+    {
+    public:
+        ProfilerThreadBuffer(uint32_t threadIndex) : CPUProfileBuffer(), ThreadIndex(threadIndex) {}
+
+        const uint32_t ThreadIndex;
+        std::wstring   Name;   // Guarded by the profiler's thread buffer lock
+    };
+
+    // Each thread caches its buffer, the generation identifies the profiler instance it was registered with
+    struct ProfilerThreadState
+    {
+        uint64_t              Generation = 0;
+        ProfilerThreadBuffer* pBuffer    = nullptr;
+    };
+    static thread_local ProfilerThreadState s_ProfilerThreadState;
+    static std::atomic_uint64_t             s_ProfilerGeneration = { 0 };
+
+    static int64_t GetSteadyNanoseconds()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+    }
+
     /////////////////////////////////////////////////////////////////////////
     // Profiler
     /////////////////////////////////////////////////////////////////////////
     Profiler::Profiler(bool enableCPUProfiling, bool enableGPUProfiling)
         : m_CPUProfilingEnabled(enableCPUProfiling)
         , m_GPUProfilingEnabled(enableGPUProfiling)
+        , m_Generation(++s_ProfilerGeneration)
+        , m_StartTimestamp(ReadCPUTimestamp())
+        , m_StartNanoseconds(GetSteadyNanoseconds())
+        , m_CollectedFrameID(GetFramework()->GetFrameID())
+        , m_CollectedFrameTime(m_StartNanoseconds)
     {
         const uint32_t backBufferCount = static_cast<uint32_t>(GetConfig()->BackBufferCount);
 
@@ -47,6 +89,12 @@ namespace cauldron
         }
     }
 
+    Profiler::~Profiler()
+    {
+        for (ProfilerThreadBuffer* pBuffer : m_ThreadBuffers)
+            delete pBuffer;
+    }
+
     const std::vector<TimingInfo>& Profiler::GetCPUTimings() const
     {
         // When fetching timings, we always want those from the last frame (current frame timings incomplete)
@@ -75,17 +123,28 @@ namespace cauldron
         EndGPU(pCmdList, capture);
     }
 
+    ProfilerThreadBuffer* Profiler::GetThreadBuffer()
+    {
+        ProfilerThreadState& state = s_ProfilerThreadState;
+        if (state.Generation != m_Generation)
+        {
+            // First capture on this thread, register a buffer for it
+            std::lock_guard<std::mutex> lock(m_ThreadBuffersLock);
+            state.Generation = m_Generation;
+            state.pBuffer    = new ProfilerThreadBuffer(static_cast<uint32_t>(m_ThreadBuffers.size()));
+            m_ThreadBuffers.push_back(state.pBuffer);
+        }
+        return state.pBuffer;
+    }
+
     ProfileCapture Profiler::BeginCPU(const wchar_t* label)
     {
         ProfileCapture capture;
         if (m_CPUProfilingEnabled)
         {
-            TimingInfo t;
-            t.Label = label;
-            t.StartTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch());
-
-            m_CurrentCPUTimings.push_back(std::move(t));
-            capture.CPUIndex = static_cast<uint32_t>(m_CurrentCPUTimings.size()) - 1;
+            // The capture keeps the thread's buffer, so ending it doesn't need another thread local lookup
+            capture.pCPUBuffer = GetThreadBuffer();
+            capture.CPUIndex   = capture.pCPUBuffer->Begin(label);
         }
         return capture;
     }
@@ -94,11 +153,39 @@ namespace cauldron
     {
         if (m_CPUProfilingEnabled)
         {
-            CauldronAssert(ASSERT_WARNING, m_CurrentCPUTimings.size() > capture.CPUIndex, L"There is no CPU timing to end");
-            m_CurrentCPUTimings[capture.CPUIndex].EndTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch());
+            // Ending a capture also ends any capture nested in it that wasn't ended
+            if (!capture.pCPUBuffer || !capture.pCPUBuffer->End(capture.CPUIndex))
+                CauldronWarning(L"There is no CPU timing to end");
         }
     }
 
+    void Profiler::SetThreadName(const wchar_t* name)
+    {
+        ProfilerThreadBuffer* pBuffer = GetThreadBuffer();
+        std::lock_guard<std::mutex> lock(m_ThreadBuffersLock);
+        pBuffer->Name = name;
+    }
+
+    bool Profiler::GetCapturedFrameRange(uint64_t& firstFrame, uint64_t& lastFrame) const
+    {
+        std::lock_guard<std::mutex> lock(m_CapturedFramesLock);
+        if (m_CapturedFrames.empty())
+            return false;
+
+        firstFrame = m_CapturedFrames.front().FrameID;
+        lastFrame  = m_CapturedFrames.back().FrameID;
+        return true;
+    }
+
+    uint64_t Profiler::GetDroppedCPUCaptureCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_ThreadBuffersLock);
+        uint64_t droppedCount = 0;
+        for (const ProfilerThreadBuffer* pBuffer : m_ThreadBuffers)
+            droppedCount += pBuffer->GetDroppedCount();
+        return droppedCount;
+    }
+
     ProfileCapture Profiler::BeginGPU(CommandList* pCmdList, const wchar_t* label)
     {
         ProfileCapture capture;
@@ -161,23 +248,224 @@ namespace cauldron
         m_TimeStampCount = 0;
     }
 
+    uint32_t Profiler::GetLabelID(const wchar_t* label)
+    {
+        // Labels are mostly literals, so look them up by address first (the string is still checked in case the memory got reused)
+        auto pointerIt = m_LabelIDsByPointer.find(label);
+        if (pointerIt != m_LabelIDsByPointer.end() && m_Labels[pointerIt->second] == label)
+            return pointerIt->second;
+
+        std::wstring labelName(label);
+        auto nameIt = m_LabelIDsByName.find(labelName);
+        uint32_t labelID = 0;
+        if (nameIt != m_LabelIDsByName.end())
+        {
+            labelID = nameIt->second;
+        }
+        else
+        {
+            labelID = static_cast<uint32_t>(m_Labels.size());
+            m_Labels.push_back(labelName);
+            m_LabelIDsByName.emplace(std::move(labelName), labelID);
+        }
+
+        m_LabelIDsByPointer[label] = labelID;
+        return labelID;
+    }
+
     void Profiler::CollectCPUTimings()
     {
         // By the time we collect CPU timings, the frame ID has changed, so we need to use the last frame's ID
         uint32_t frameID = (m_CurrentFrame == 0) ? GetConfig()->BackBufferCount - 1 : m_CurrentFrame - 1;
 
-        // Populate the frame timings from the current (last frame) capture timings
+        // Refine the timestamp frequency against the steady clock as time goes by
+        const int64_t  currentTime      = GetSteadyNanoseconds();
+        const uint64_t currentTimestamp = ReadCPUTimestamp();
+        if (currentTime > m_StartNanoseconds && currentTimestamp > m_StartTimestamp)
+            m_NanosecondsPerTick = static_cast<double>(currentTime - m_StartNanoseconds) / static_cast<double>(currentTimestamp - m_StartTimestamp);
+        auto toNanoseconds = [this](uint64_t timestamp) {
+            return m_StartNanoseconds + static_cast<int64_t>(static_cast<double>(static_cast<int64_t>(timestamp - m_StartTimestamp)) * m_NanosecondsPerTick);
+        };
+
+        std::vector<ProfilerThreadBuffer*> threadBuffers;
+        {
+            std::lock_guard<std::mutex> lock(m_ThreadBuffersLock);
+            threadBuffers = m_ThreadBuffers;
+        }
+
+        // Recycle the oldest captured frame
+        CapturedFrame capturedFrame;
+        {
+            std::lock_guard<std::mutex> lock(m_CapturedFramesLock);
+            if (m_CapturedFrames.size() == s_MAX_CAPTURED_FRAMES)
+            {
+                capturedFrame = std::move(m_CapturedFrames.front());
+                m_CapturedFrames.pop_front();
+            }
+        }
+        capturedFrame.FrameID   = m_CollectedFrameID;
+        capturedFrame.StartTime = m_CollectedFrameTime;
+        capturedFrame.EndTime   = currentTime;
+        capturedFrame.Events.clear();
+
+        // Populate the frame timings from the captures made on this thread during the last frame
+        ProfilerThreadBuffer* pFrameThreadBuffer = GetThreadBuffer();
         std::vector<TimingInfo>& latestCPUTimings = m_CPUTimings[frameID];
         latestCPUTimings.clear();
-        latestCPUTimings.swap(m_CurrentCPUTimings);
-        m_CurrentCPUTimings.clear();
+
+        std::vector<uint32_t> frameThreadDepths;
+        for (ProfilerThreadBuffer* pBuffer : threadBuffers)
+        {
+            pBuffer->Drain([&](const CPUProfileEvent& event) {
+                const int64_t startTime = toNanoseconds(event.StartTimestamp);
+                const int64_t endTime   = toNanoseconds(event.EndTimestamp);
+                capturedFrame.Events.push_back({ GetLabelID(event.pLabel), pBuffer->ThreadIndex, event.Depth, startTime, endTime });
+
+                if (pBuffer == pFrameThreadBuffer)
+                {
+                    TimingInfo timingInfo(m_Labels[capturedFrame.Events.back().LabelID].c_str());
+                    timingInfo.StartTime = std::chrono::nanoseconds(startTime);
+                    timingInfo.EndTime   = std::chrono::nanoseconds(endTime);
+                    latestCPUTimings.push_back(std::move(timingInfo));
+                    frameThreadDepths.push_back(event.Depth);
+                }
+            });
+        }
+
+        // Captures are recorded as they end, report them in the order they began (outer captures first)
+        std::vector<uint32_t> order(latestCPUTimings.size());
+        for (uint32_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            if (latestCPUTimings[a].StartTime != latestCPUTimings[b].StartTime)
+                return latestCPUTimings[a].StartTime < latestCPUTimings[b].StartTime;
+            return frameThreadDepths[a] < frameThreadDepths[b];
+        });
+        std::vector<TimingInfo> sortedCPUTimings;
+        sortedCPUTimings.reserve(order.size());
+        for (uint32_t index : order)
+            sortedCPUTimings.push_back(std::move(latestCPUTimings[index]));
+        latestCPUTimings.swap(sortedCPUTimings);
 
         // Calculate frame tick
         m_LatestCPUFrameCount = 0;
         if (latestCPUTimings.size())
         {
-            m_LatestCPUFrameCount = (latestCPUTimings[latestCPUTimings.size() - 1].EndTime - latestCPUTimings[0].StartTime).count();
+            std::chrono::nanoseconds endTime = latestCPUTimings[0].EndTime;
+            for (const TimingInfo& timingInfo : latestCPUTimings)
+                endTime = std::max(endTime, timingInfo.EndTime);
+            m_LatestCPUFrameCount = (endTime - latestCPUTimings[0].StartTime).count();
+        }
+
+        // Keep the captures of all threads around for trace exports (anything captured before the first frame is dropped)
+        if (m_CollectedFrameID != UINT64_MAX)
+        {
+            std::lock_guard<std::mutex> lock(m_CapturedFramesLock);
+            m_CapturedFrames.push_back(std::move(capturedFrame));
+        }
+
+        m_CollectedFrameID   = GetFramework()->GetFrameID();
+        m_CollectedFrameTime = currentTime;
+    }
+
+    // Escapes a label for use in a json string
+    static std::string EscapeTraceString(const std::wstring& string)
+    {
+        std::string escaped;
+        for (char c : WStringToString(string))
+        {
+            if (c == '"' || c == '\\')
+            {
+                escaped += '\\';
+                escaped += c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char code[8];
+                snprintf(code, sizeof(code), "\\u%04x", c);
+                escaped += code;
+            }
+            else
+            {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    bool Profiler::ExportTrace(const wchar_t* fileName, uint64_t firstFrame, uint64_t lastFrame) const
+    {
+        std::ofstream file(fileName, std::ios_base::out | std::ios_base::trunc);
+        if (!file.good())
+        {
+            CauldronWarning(L"Could not open %ls to export the profile trace.", fileName);
+            return false;
         }
+
+        std::vector<std::pair<uint32_t, std::wstring>> threadNames;
+        {
+            std::lock_guard<std::mutex> lock(m_ThreadBuffersLock);
+            for (const ProfilerThreadBuffer* pBuffer : m_ThreadBuffers)
+                threadNames.emplace_back(pBuffer->ThreadIndex, pBuffer->Name.empty() ? L"Thread " + std::to_wstring(pBuffer->ThreadIndex) : pBuffer->Name);
+        }
+
+        std::lock_guard<std::mutex> lock(m_CapturedFramesLock);
+        if (m_CapturedFrames.empty() || firstFrame > m_CapturedFrames.back().FrameID || lastFrame < m_CapturedFrames.front().FrameID)
+        {
+            CauldronWarning(L"Frames %llu to %llu are not available for the profile trace export.", firstFrame, lastFrame);
+            return false;
+        }
+
+        // Timestamps are in microseconds, relative to the start of the first exported frame. Frames are shown on their own track (tid 0)
+        // and thread tracks are offset by one.
+        int64_t traceStartTime = INT64_MAX;
+        for (const CapturedFrame& frame : m_CapturedFrames)
+        {
+            if (frame.FrameID >= firstFrame && frame.FrameID <= lastFrame)
+                traceStartTime = std::min(traceStartTime, frame.StartTime);
+        }
+        auto toMicroseconds = [traceStartTime](int64_t time) {
+            return static_cast<double>(time - traceStartTime) / 1000.0;
+        };
+
+        file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Frames\"}}";
+        for (const auto& threadName : threadNames)
+        {
+            file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadName.first + 1
+                 << ",\"args\":{\"name\":\"" << EscapeTraceString(threadName.second) << "\"}}";
+        }
+
+        file.precision(3);
+        file << std::fixed;
+        uint64_t eventCount = 0;
+        for (const CapturedFrame& frame : m_CapturedFrames)
+        {
+            if (frame.FrameID < firstFrame || frame.FrameID > lastFrame)
+                continue;
+
+            file << ",\n{\"name\":\"Frame " << frame.FrameID << "\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":"
+                 << toMicroseconds(frame.StartTime) << ",\"dur\":" << toMicroseconds(frame.EndTime) - toMicroseconds(frame.StartTime) << "}";
+
+            for (const CapturedEvent& event : frame.Events)
+            {
+                file << ",\n{\"name\":\"" << EscapeTraceString(m_Labels[event.LabelID]) << "\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.ThreadIndex + 1
+                     << ",\"ts\":" << toMicroseconds(event.StartTime) << ",\"dur\":" << toMicroseconds(event.EndTime) - toMicroseconds(event.StartTime)
+                     << ",\"args\":{\"frame\":" << frame.FrameID << ",\"depth\":" << event.Depth << "}}";
+            }
+            eventCount += frame.Events.size();
+        }
+        file << "\n]}\n";
+
+        if (!file.good())
+        {
+            CauldronWarning(L"Failed writing the profile trace to %ls.", fileName);
+            return false;
+        }
+
+        Log::Write(LOGLEVEL_TRACE, L"Exported profile trace of frames %llu to %llu (%llu events) to %ls.", std::max(firstFrame, m_CapturedFrames.front().FrameID),
+                   std::min(lastFrame, m_CapturedFrames.back().FrameID), eventCount, fileName);
+        return true;
     }
 
     void Profiler::CollectGPUTimings(CommandList* pCmdList)
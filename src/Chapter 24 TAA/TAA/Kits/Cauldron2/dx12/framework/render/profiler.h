@@ -25,7 +25,10 @@
 #include "../misc/helpers.h"
 
 #include <chrono>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <limits>
 
@@ -37,6 +40,7 @@ namespace cauldron
     constexpr uint64_t g_NanosecondsPerSecond = 1000000000;
 
     class CommandList;
+    class ProfilerThreadBuffer;
 
     
     /// Structure holding the information of a timing capture
@@ -68,15 +72,22 @@ namespace cauldron
     /// @ingroup CauldronRender
     struct ProfileCapture
     {
-        uint32_t CPUIndex = UINT32_MAX;     ///< The index of the CPU timing information.
-        uint32_t GPUIndex = UINT32_MAX;     ///< The index of the GPU timing information.
+        uint32_t              CPUIndex   = UINT32_MAX;  ///< The index of the CPU timing information.
+        uint32_t              GPUIndex   = UINT32_MAX;  ///< The index of the GPU timing information.
+        ProfilerThreadBuffer* pCPUBuffer = nullptr;     ///< The buffer of the thread the CPU capture was made on.
     };
 
     /**
      * @class Profiler
      *
      * The <c><i>FidelityFX Cauldron Framework</i></c> representation of the CPU/GPU profiler.
-     * NOTE: This class is not thread safe.
+     *
+     * CPU captures can be made from any thread and nest. Each thread records completed captures in its own
+     * lock-free event buffer, which are collected at the start of every CPU frame. The captures made on the
+     * thread running the frame are reported through <c><i>GetCPUTimings</i></c>, while the captures of all
+     * threads (including task manager workers) are kept for the last few frames and can be exported as a
+     * Chrome trace (also loads in Perfetto).
+     * NOTE: GPU captures are not thread safe.
      *
      * @ingroup CauldronRender
      */
@@ -88,6 +99,14 @@ namespace cauldron
         /// 
         static const uint32_t s_MAX_TIMESTAMPS_PER_FRAME = 256;
 
+        /// Maximum number of past frames for which CPU captures of all threads are kept.
+        ///
+        static const uint32_t s_MAX_CAPTURED_FRAMES = 256;
+
+        /// Maximum nesting depth of CPU captures on a thread.
+        ///
+        static const uint32_t s_MAX_CPU_CAPTURE_DEPTH = 64;
+
         /**
          * @brief   Profiler instance creation function. Implemented per api/platform to return the correct
          *          internal resource type.
@@ -95,9 +114,9 @@ namespace cauldron
         static Profiler* CreateProfiler(bool enableCPUProfiling = true, bool enableGPUProfiling = true);
 
         /**
-         * @brief   Destruction with default behavior.
+         * @brief   Destructor. Releases the per-thread event buffers.
          */
-        virtual ~Profiler() = default;
+        virtual ~Profiler();
 
         /**
          * @brief   Returns true if CPU profiling is enabled.
@@ -155,7 +174,8 @@ namespace cauldron
         void End(CommandList* pCmdList, ProfileCapture capture);
 
         /**
-         * @brief   Begins a capture on CPU only.
+         * @brief   Begins a capture on CPU only. Can be called from any thread, captures must be ended on the
+         *          thread that began them. The label needs to stay valid until the next CPU frame begins.
          */
         ProfileCapture BeginCPU(const wchar_t* label);
 
@@ -164,6 +184,28 @@ namespace cauldron
          */
         void EndCPU(ProfileCapture capture);
 
+        /**
+         * @brief   Names the calling thread in exported traces.
+         */
+        void SetThreadName(const wchar_t* name);
+
+        /**
+         * @brief   Returns the range of frames for which CPU captures can be exported.
+         *          Returns false if no frame was captured yet.
+         */
+        bool GetCapturedFrameRange(uint64_t& firstFrame, uint64_t& lastFrame) const;
+
+        /**
+         * @brief   Returns the number of CPU captures that were lost because a thread's event buffer was full.
+         */
+        uint64_t GetDroppedCPUCaptureCount() const;
+
+        /**
+         * @brief   Exports the CPU captures of all threads for a range of frames in the Chrome trace event format.
+         *          Frames are identified by the framework frame ID they were captured on. Returns true on success.
+         */
+        bool ExportTrace(const wchar_t* fileName, uint64_t firstFrame, uint64_t lastFrame) const;
+
         /**
          * @brief   Begins a capture on GPU only.
          */
@@ -190,6 +232,8 @@ namespace cauldron
         NO_MOVE(Profiler)
         Profiler() = delete;
 
+        ProfilerThreadBuffer* GetThreadBuffer();
+        uint32_t GetLabelID(const wchar_t* label);
         void CollectCPUTimings();
         void CollectGPUTimings(CommandList* pCmdList);
 
@@ -206,10 +250,45 @@ namespace cauldron
 
         // Members for CPU/GPU timings
     private:
-        std::vector<TimingInfo>     m_CurrentCPUTimings;
         int64_t                     m_LatestCPUFrameCount = 0;
         int64_t                     m_LatestGPUFrameCount = 0;
 
+        // Per-thread CPU event buffers
+        mutable std::mutex                  m_ThreadBuffersLock;
+        std::vector<ProfilerThreadBuffer*>  m_ThreadBuffers;
+        uint64_t                            m_Generation = 0;
+
+        // CPU timestamp conversion to nanoseconds (calibrated as frames go by)
+        uint64_t m_StartTimestamp       = 0;
+        int64_t  m_StartNanoseconds     = 0;
+        double   m_NanosecondsPerTick   = 1.0;
+
+        // Captured CPU events of all threads for the last frames
+        struct CapturedEvent
+        {
+            uint32_t LabelID;
+            uint32_t ThreadIndex;
+            uint32_t Depth;
+            int64_t  StartTime;
+            int64_t  EndTime;
+        };
+
+        struct CapturedFrame
+        {
+            uint64_t                   FrameID   = 0;
+            int64_t                    StartTime = 0;
+            int64_t                    EndTime   = 0;
+            std::vector<CapturedEvent> Events;
+        };
+
+        mutable std::mutex                             m_CapturedFramesLock;
+        std::deque<CapturedFrame>                      m_CapturedFrames;
+        std::vector<std::wstring>                      m_Labels;
+        std::unordered_map<const wchar_t*, uint32_t>   m_LabelIDsByPointer;
+        std::unordered_map<std::wstring, uint32_t>     m_LabelIDsByName;
+        uint64_t                                       m_CollectedFrameID   = 0;
+        int64_t                                        m_CollectedFrameTime = 0;
+
 
     private:
         // Internal GPU timing tracking
@@ -250,6 +250,8 @@ namespace cauldron
         RG16_UINT,          ///< 2-Component (RG) 32-bit (unsigned int) type.
         RG16_TYPELESS,      ///< 2-Component (R) 32-bit (typeless) type.
         RG16_FLOAT,         ///< 2-Component (R) 32-bit (floating point) type.
+        RG16_UNORM,         ///< 2-Component (RG) 32-bit (unsigned normalized) type.
+        RG16_SNORM,         ///< 2-Component (RG) 32-bit (signed normalized) type.
         R32_TYPELESS,       ///< Single-Component (R) 32-bit (typeless) type.
         R32_FLOAT,          ///< Single-Component (R) 32-bit (floating point) type.
 
@@ -23,7 +23,9 @@
 #pragma once
 
 #include "resourceviewallocator.h"
+#include "device.h"
 #include "../core/framework.h"
+#include "../misc/descriptorallocator.h"
 
 namespace cauldron
 {
@@ -35,6 +37,36 @@ namespace cauldron
         m_NumViews[static_cast<size_t>(ResourceViewHeapType::CPURenderView)]   = pConfig->CPURenderViewCount;
         m_NumViews[static_cast<size_t>(ResourceViewHeapType::CPUDepthView)]    = pConfig->CPUDepthViewCount;
         m_NumViews[static_cast<size_t>(ResourceViewHeapType::GPUSamplerView)]  = pConfig->GPUSamplerViewCount;
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(ResourceViewHeapType::Count); ++i)
+            m_pDescriptorAllocators[i] = new DescriptorAllocator(m_NumViews[i]);
+    }
+
+    ResourceViewAllocator::~ResourceViewAllocator()
+    {
+        for (uint32_t i = 0; i < static_cast<uint32_t>(ResourceViewHeapType::Count); ++i)
+            delete m_pDescriptorAllocators[i];
+    }
+
+    void ResourceViewAllocator::ReleaseViews(ResourceViewHeapType type, uint32_t index, uint32_t count)
+    {
+        m_pDescriptorAllocators[static_cast<uint32_t>(type)]->Free(index, count);
+    }
+
+    void ResourceViewAllocator::EndFrame(uint64_t frameFenceValue)
+    {
+        // Views released this frame may still be referenced by the work submitted before frameFenceValue
+        const uint64_t completedFenceValue = GetDevice()->QueryLastCompletedValue(CommandQueue::Graphics);
+        for (uint32_t i = 0; i < static_cast<uint32_t>(ResourceViewHeapType::Count); ++i)
+        {
+            m_pDescriptorAllocators[i]->EndFrame(frameFenceValue);
+            m_pDescriptorAllocators[i]->Retire(completedFenceValue);
+        }
+    }
+
+    uint32_t ResourceViewAllocator::GetAllocatedViewCount(ResourceViewHeapType type) const
+    {
+        return m_pDescriptorAllocators[static_cast<uint32_t>(type)]->GetAllocatedCount();
     }
     
 } // namespace cauldron
@@ -27,6 +27,8 @@
 
 namespace cauldron
 {
+    class DescriptorAllocator;
+
     /// Per platform/API implementation of <c><i>ResourceViewAllocator</i></c>
     ///
     /// @ingroup CauldronRender
@@ -50,9 +52,9 @@ namespace cauldron
         static ResourceViewAllocator* CreateResourceViewAllocator();
 
         /**
-         * @brief   Destruction with default behavior.
+         * @brief   Destruction.
          */
-        virtual ~ResourceViewAllocator() = default;
+        virtual ~ResourceViewAllocator();
 
         /**
          * @brief   Allocates CPU resource views.
@@ -79,6 +81,23 @@ namespace cauldron
          */
         virtual void AllocateCPUDepthViews(ResourceView** ppResourceView, uint32_t count = 1) = 0;
 
+        /**
+         * @brief   Releases count views of the given heap type starting at index. The views are recycled once
+         *          the GPU is done with the frame they were released in.
+         */
+        void ReleaseViews(ResourceViewHeapType type, uint32_t index, uint32_t count);
+
+        /**
+         * @brief   Closes the frame's released views, which are recycled once frameFenceValue has completed on
+         *          the graphics queue, and recycles the ones the GPU is done with.
+         */
+        void EndFrame(uint64_t frameFenceValue);
+
+        /**
+         * @brief   Returns the number of views of the given heap type that are in use.
+         */
+        uint32_t GetAllocatedViewCount(ResourceViewHeapType type) const;
+
         /**
          * @brief   Gets the internal implementation for api/platform parameter accessors.
          */
@@ -93,7 +112,8 @@ namespace cauldron
     protected:
         ResourceViewAllocator();
         
-        uint32_t m_NumViews[static_cast<uint32_t>(ResourceViewHeapType::Count)];
+        uint32_t             m_NumViews[static_cast<uint32_t>(ResourceViewHeapType::Count)];
+        DescriptorAllocator* m_pDescriptorAllocators[static_cast<uint32_t>(ResourceViewHeapType::Count)] = { nullptr };
     };
 
 } // namespace cauldron
@@ -27,162 +27,56 @@
 namespace cauldron
 {
     ShadowMapAtlas::ShadowMapAtlas(uint32_t size, Texture* pRenderTarget)
-        : m_pRenderTarget{ pRenderTarget }
+        : m_Allocator{ size }
+        , m_pRenderTarget{ pRenderTarget }
     {
-        Cell rootCell = { size, { 0, 0, size, size }, CellStatus::Empty };
-        m_Cells.push_back(rootCell);
     }
 
     ShadowMapAtlas::~ShadowMapAtlas()
     {
-        CauldronAssert(ASSERT_CRITICAL, m_Cells[0].status == CellStatus::Empty, L"All the cells haven't been freed.");
+        CauldronAssert(ASSERT_CRITICAL, m_Allocator.IsEmpty(), L"All the cells haven't been freed.");
         CauldronAssert(ASSERT_ERROR, m_pRenderTarget != nullptr, L"A shadow map atlas texture is null.");
         delete m_pRenderTarget;
     }
 
     Cell ShadowMapAtlas::GetCell(int32_t index) const
     {
-        CauldronAssert(ASSERT_CRITICAL, m_Cells.size() > index, L"This cell index %d doesn't exist yet.", index);
-        return m_Cells[index];
+        CauldronAssert(ASSERT_CRITICAL, index >= 0 && m_Allocator.GetCellCount() > static_cast<uint32_t>(index), L"This cell index %d doesn't exist yet.", index);
+        const QuadTreeAllocator::Cell& cell = m_Allocator.GetCell(index);
+        return { cell.Size, GetCellRect(cell), cell.Status };
     }
 
     int32_t ShadowMapAtlas::FindBestCell(uint32_t size) const
     {
-        int32_t foundCellIndex = -1;
-        FindBestCellRecursive(size, 0, foundCellIndex);
-        return foundCellIndex;
+        return m_Allocator.FindBestCell(size);
     }
 
     int32_t ShadowMapAtlas::AllocateCell(uint32_t size, int32_t index)
     {
-        CauldronAssert(ASSERT_CRITICAL, m_Cells.size() > index, L"This cell index %d doesn't exist yet.", index);
-        CauldronAssert(ASSERT_CRITICAL, m_Cells[index].status == CellStatus::Empty, L"The cell %d we are trying to allocate/subdivide isn't empty.", index);
-        while (m_Cells[index].size > size)
-        {
-            // subdivide
-            int32_t childrenBaseIndex = GetChildrenBaseIndex(index);
-            if (m_Cells.size() < childrenBaseIndex + 4)
-                m_Cells.resize(childrenBaseIndex + 4);
-
-            Cell currentCell = m_Cells[index];
-            uint32_t childCellSize = currentCell.size / 2;
-            // init the children
-            for (int32_t i = 0; i < 4; ++i)
-            {
-                Cell childCell;
-
-                childCell.size = childCellSize;
-                childCell.status = CellStatus::Empty;
-                childCell.rect = currentCell.rect;
-
-                switch (i)
-                {
-                case 0: // top left
-                    childCell.rect.Right = childCell.rect.Left + childCellSize;
-                    childCell.rect.Bottom = childCell.rect.Top + childCellSize;
-                    break;
-                case 1: // top right
-                    childCell.rect.Left = childCell.rect.Right - childCellSize;
-                    childCell.rect.Bottom = childCell.rect.Top + childCellSize;
-                    break;
-                case 2: // bottom right
-                    childCell.rect.Right = childCell.rect.Left + childCellSize;
-                    childCell.rect.Top = childCell.rect.Bottom - childCellSize;
-                    break;
-                case 3: // bottom right
-                    childCell.rect.Left = childCell.rect.Right - childCellSize;
-                    childCell.rect.Top = childCell.rect.Bottom - childCellSize;
-                    break;
-                }
-
-                m_Cells[childrenBaseIndex + i] = childCell;
-            }
-
-            // mark the cell non empty
-            m_Cells[index].status = CellStatus::Subdivided;
-
-            // select the first child cell
-            index = childrenBaseIndex;
-        }
-
-        CauldronAssert(ASSERT_CRITICAL, m_Cells.size() > index, L"This cell index doesn't exist yet.");
-        CauldronAssert(ASSERT_CRITICAL, m_Cells[index].size == size, L"This cell size doesn't match the expected one.");
-        CauldronAssert(ASSERT_CRITICAL, m_Cells[index].status == CellStatus::Empty, L"The cell %d we are trying to allocate isn't empty.", index);
-
-        m_Cells[index].status = CellStatus::Allocated;
-        return index;
+        CauldronAssert(ASSERT_CRITICAL, index >= 0 && m_Allocator.GetCellCount() > static_cast<uint32_t>(index), L"This cell index %d doesn't exist yet.", index);
+        CauldronAssert(ASSERT_CRITICAL, m_Allocator.GetCell(index).Status == CellStatus::Empty, L"The cell %d we are trying to allocate/subdivide isn't empty.", index);
+        return m_Allocator.AllocateCell(size, index);
     }
 
     void ShadowMapAtlas::FreeCell(int32_t index)
     {
-        CauldronAssert(ASSERT_CRITICAL, m_Cells.size() > index, L"This cell index %d doesn't exist.", index);
-        CauldronAssert(ASSERT_CRITICAL, m_Cells[index].status == CellStatus::Allocated, L"The cell %d we are trying to free isn't allocated.", index);
-
-        // free the cell
-        m_Cells[index].status = CellStatus::Empty;
-
-        // merge with the sibling cells
-        while (index != 0)
-        {
-            // move to parent
-            index = GetParentIndex(index);
-
-            CauldronAssert(ASSERT_CRITICAL, m_Cells[index].status == CellStatus::Subdivided, L"The cell %d isn't subdivided. We are trying to merge its children so it should be subdivided.", index);
-            bool allChildrenEmpty = true;
-            int32_t childrenBaseIndex = GetChildrenBaseIndex(index);
-            for (int32_t i = 0; i < 4; ++i)
-            {
-                allChildrenEmpty &= (m_Cells[childrenBaseIndex + i].status == CellStatus::Empty);
-            }
-
-            if (allChildrenEmpty)
-            {
-                // merge the cells
-                m_Cells[index].status = CellStatus::Empty;
-            }
-            else
-            {
-                // cannot merge because only child is still allocated or subdivided
-                break;
-            }
-        }
-    }
-
-    int32_t ShadowMapAtlas::GetChildrenBaseIndex(int32_t index)
-    {
-        return (index << 2) + 1;
+        CauldronAssert(ASSERT_CRITICAL, index >= 0 && m_Allocator.GetCellCount() > static_cast<uint32_t>(index), L"This cell index %d doesn't exist.", index);
+        CauldronAssert(ASSERT_CRITICAL, m_Allocator.GetCell(index).Status == CellStatus::Allocated, L"The cell %d we are trying to free isn't allocated.", index);
+        m_Allocator.FreeCell(index);
     }
 
-    int32_t ShadowMapAtlas::GetParentIndex(int32_t index)
+    uint32_t ShadowMapAtlas::Defragment(uint32_t maxMoves, std::vector<CellMove>& moves)
     {
-        return (index - 1) >> 2;
+        m_Moves.clear();
+        const uint32_t moveCount = m_Allocator.Defragment(maxMoves, m_Moves);
+        for (const QuadTreeAllocator::CellMove& move : m_Moves)
+            moves.push_back({ move.SrcCellIndex, move.DstCellIndex, GetCellRect(m_Allocator.GetCell(move.DstCellIndex)) });
+        return moveCount;
     }
 
-    void ShadowMapAtlas::FindBestCellRecursive(size_t size, int32_t currentIndex, int32_t& foundCellIndex) const
+    Rect ShadowMapAtlas::GetCellRect(const QuadTreeAllocator::Cell& cell)
     {
-        if (currentIndex < m_Cells.size())
-        {
-            Cell cell = m_Cells[currentIndex];
-
-            if (cell.status == CellStatus::Empty) // we can only select this cell if it is completely empty
-            {
-                // only replace if this is a better cell
-                //   - size is bigger than the requested one
-                //   - size is smaller than the current best cell
-                if (cell.size >= size && (foundCellIndex < 0 || m_Cells[foundCellIndex].size > cell.size))
-                {
-                    foundCellIndex = currentIndex;
-                }
-            }
-            else if (cell.status == CellStatus::Subdivided) // explore children
-            {
-                int32_t childrenBaseIndex = GetChildrenBaseIndex(currentIndex);
-                for (int32_t i = 0; i < 4; ++i)
-                {
-                    FindBestCellRecursive(size, childrenBaseIndex + i, foundCellIndex);
-                }
-            }
-        }
+        return { cell.Left, cell.Top, cell.Left + cell.Size, cell.Top + cell.Size };
     }
 
     ShadowMapResourcePool::ShadowMapResourcePool()
@@ -192,7 +86,7 @@ namespace cauldron
     ShadowMapResourcePool::~ShadowMapResourcePool()
     {
         // Release all resources
-        std::lock_guard<std::mutex> lock(m_CriticalSection);
+        std::unique_lock<std::shared_mutex> lock(m_CriticalSection);
         for (auto pShadowMapAtlas : m_ShadowMapAtlases)
             delete pShadowMapAtlas;
         m_ShadowMapAtlases.clear();
@@ -200,13 +94,13 @@ namespace cauldron
 
     uint32_t ShadowMapResourcePool::GetRenderTargetCount()
     {
-        std::lock_guard<std::mutex> lock(m_CriticalSection);
+        std::shared_lock<std::shared_mutex> lock(m_CriticalSection);
         return static_cast<uint32_t>(m_ShadowMapAtlases.size());
     }
 
     const Texture* ShadowMapResourcePool::GetRenderTarget(uint32_t index)
     {
-        std::lock_guard<std::mutex> lock(m_CriticalSection);
+        std::shared_lock<std::shared_mutex> lock(m_CriticalSection);
         if (index < (uint32_t)m_ShadowMapAtlases.size())
         {
             return m_ShadowMapAtlases[index]->GetRenderTarget();
@@ -222,7 +116,7 @@ namespace cauldron
         ShadowMapView view;
         const uint32_t cellSize = g_ShadowMapTextureSize / static_cast<uint32_t>(resolution);
 
-        std::lock_guard<std::mutex> lock(m_CriticalSection);
+        std::unique_lock<std::shared_mutex> lock(m_CriticalSection);
         view.index = -1;
         view.cellIndex = -1;
         for (int i = 0; i < m_ShadowMapAtlases.size(); ++i)
@@ -285,7 +179,7 @@ namespace cauldron
     {
         if (index >= 0)
         {
-            std::lock_guard<std::mutex> lock(m_CriticalSection);
+            std::unique_lock<std::shared_mutex> lock(m_CriticalSection);
             if (index < m_ShadowMapAtlases.size())
             {
                 ShadowMapAtlas* pShadowMapAtlas = m_ShadowMapAtlases[index];
@@ -294,6 +188,22 @@ namespace cauldron
         }
     }
 
+    uint32_t ShadowMapResourcePool::Defragment(uint32_t maxMoves, std::vector<ShadowMapMove>& moves)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_CriticalSection);
+
+        uint32_t moveCount = 0;
+        std::vector<CellMove> cellMoves;
+        for (int i = 0; i < m_ShadowMapAtlases.size() && moveCount < maxMoves; ++i)
+        {
+            cellMoves.clear();
+            moveCount += m_ShadowMapAtlases[i]->Defragment(maxMoves - moveCount, cellMoves);
+            for (const CellMove& cellMove : cellMoves)
+                moves.push_back({ i, cellMove.srcCellIndex, cellMove.dstCellIndex, cellMove.dstRect });
+        }
+        return moveCount;
+    }
+
     Viewport ShadowMapResourcePool::GetViewport(Rect rect)
     {
         return {
@@ -23,24 +23,15 @@
 #pragma once
 
 #include "../misc/math.h"
+#include "../misc/quadtreeallocator.h"
 #include "gpuresource.h"
 #include "texture.h"
 
-#include <mutex>
+#include <shared_mutex>
 #include <vector>
 
 namespace cauldron
 {
-    /// An enumeration for shadow cell status
-    ///
-    /// @ingroup CauldronRender
-    enum class CellStatus
-    {
-        Empty,          ///< The cell is empty.
-        Allocated,      ///< The cell has been allocated.
-        Subdivided      ///< The cell was subdivided into 4 cells.
-    };
-
     /// An structure represnting a shadow cell entry
     ///
     /// @ingroup CauldronRender
@@ -51,10 +42,22 @@ namespace cauldron
         CellStatus status = CellStatus::Empty;  ///< The <c><i>CellStatus</i></c> (defaults to CellStatus::Empty).
     };
 
+    /// A structure representing a cell relocated by the shadow atlas defragmentation. The shadow
+    /// map content needs to be rendered to the destination rect.
+    ///
+    /// @ingroup CauldronRender
+    struct CellMove
+    {
+        int32_t srcCellIndex = -1;              ///< The index of the cell that was freed.
+        int32_t dstCellIndex = -1;              ///< The index of the cell that replaces it.
+        Rect    dstRect;                        ///< The rect of the replacement cell.
+    };
+
     /**
      * @class ShadowMapAtlas
      *
-     * The <c><i>FidelityFX Cauldron Framework</i></c> shadow map atlas representation.
+     * The <c><i>FidelityFX Cauldron Framework</i></c> shadow map atlas representation. Cells are managed by a
+     * <c><i>QuadTreeAllocator</i></c>.
      *
      * @ingroup CauldronRender
      */
@@ -83,7 +86,7 @@ namespace cauldron
         Cell GetCell(int32_t index) const;
 
         /**
-         * @brief   Returns an index to a cell that can hold the requested size of texture, or -1 if none was found.
+         * @brief   Returns an index to the smallest empty cell that can hold the requested size of texture, or -1 if none was found.
          */
         int32_t FindBestCell(uint32_t size) const;
 
@@ -93,18 +96,25 @@ namespace cauldron
         int32_t AllocateCell(uint32_t size, int32_t index);
 
         /**
-         * @brief   Frees the specified cell.
+         * @brief   Frees the specified cell, merging it with its siblings when they are all empty.
          */
         void FreeCell(int32_t index);
 
+        /**
+         * @brief   Incrementally compacts the atlas by relocating up to maxMoves allocated cells out of sparsely
+         *          used subdivisions so those can merge back into larger free cells. The relocations are appended
+         *          to moves. Returns the number of cells moved.
+         */
+        uint32_t Defragment(uint32_t maxMoves, std::vector<CellMove>& moves);
+
     private:
-        static int32_t GetChildrenBaseIndex(int32_t index);
-        static int32_t GetParentIndex(int32_t index);
-        void FindBestCellRecursive(size_t size, int32_t currentIndex, int32_t& foundCellIndex) const;
+        static Rect GetCellRect(const QuadTreeAllocator::Cell& cell);
 
         // internal members
-        std::vector<Cell> m_Cells;
+        QuadTreeAllocator m_Allocator;
         Texture* m_pRenderTarget = nullptr;
+
+        std::vector<QuadTreeAllocator::CellMove> m_Moves;   // Scratch storage for Defragment
     };
 
     /// An enumeration for shadow map resolution occupancy
@@ -176,6 +186,23 @@ namespace cauldron
          */
         void ReleaseShadowMap(int index, int32_t cellIndex);
 
+        /// An structure representing a shadow map relocated by defragmentation
+        ///
+        struct ShadowMapMove
+        {
+            int index = 0;                  ///< Index of the shadow map the view moved in.
+            int32_t srcCellIndex = -1;      ///< Shadow map view's previous cell ID.
+            int32_t dstCellIndex = -1;      ///< Shadow map view's new cell ID.
+            Rect rect;                      ///< Shadow map view's new rect information.
+        };
+
+        /**
+         * @brief   Relocates up to maxMoves shadow map views to reduce atlas fragmentation. Views are only moved within
+         *          their shadow map, owners of moved views need to pick up the new cell and rect and render the shadow
+         *          map to it. Returns the number of views moved.
+         */
+        uint32_t Defragment(uint32_t maxMoves, std::vector<ShadowMapMove>& moves);
+
         /**
          * @brief   Returns the format used by shadow map textures.
          */
@@ -193,7 +220,7 @@ namespace cauldron
 
     private:
         std::vector<ShadowMapAtlas*> m_ShadowMapAtlases;
-        std::mutex m_CriticalSection;
+        std::shared_mutex m_CriticalSection;
     };
 
 } // namespace cauldron
@@ -0,0 +1,423 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "suballocator.h"
+#include "../core/framework.h"
+#include "../misc/assert.h"
+#include "../misc/fileio.h"
+#include "../misc/log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <experimental/filesystem>
+#include <fstream>
+
+using namespace std::experimental;
+
+namespace cauldron
+{
+    // Bump whenever the trace layout changes
+    static constexpr uint32_t s_SuballocatorTraceMagic   = 0x54534343;  // 'CCST'
+    static constexpr uint32_t s_SuballocatorTraceVersion = 1;
+
+    // Fragmentation is sampled every so many events when replaying traces
+    static constexpr uint32_t s_ReplayFragmentationInterval = 64;
+
+    struct SuballocatorTraceHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint64_t Size;
+        uint64_t Granularity;
+        uint64_t EventCount;
+    };
+
+    // All live suballocators, for budget dumps
+    static std::mutex                   s_SuballocatorsLock;
+    static std::vector<Suballocator*>   s_Suballocators;
+
+    static const char* s_SuballocatorBackendNames[static_cast<uint32_t>(SuballocatorBackend::Count)] = { "TLSF", "VirtualBlock", "VirtualBlockLinear" };
+
+    const char* Suballocator::GetBackendName(SuballocatorBackend backend)
+    {
+        return backend < SuballocatorBackend::Count ? s_SuballocatorBackendNames[static_cast<uint32_t>(backend)] : "Unknown";
+    }
+
+    Suballocator* Suballocator::CreateSuballocator(const wchar_t* name, uint64_t size, uint64_t granularity)
+    {
+        const CauldronConfig* pConfig = GetConfig();
+
+        SuballocatorBackend backend = SuballocatorBackend::Count;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(SuballocatorBackend::Count); ++i)
+        {
+            if (pConfig->SuballocatorBackend == s_SuballocatorBackendNames[i])
+                backend = static_cast<SuballocatorBackend>(i);
+        }
+        if (backend == SuballocatorBackend::Count)
+        {
+            CauldronWarning(L"Unknown suballocator backend %hs, falling back to TLSF.", pConfig->SuballocatorBackend.c_str());
+            backend = SuballocatorBackend::TLSF;
+        }
+
+        Suballocator* pSuballocator = CreateSuballocator(name, size, granularity, backend);
+        if (pConfig->SuballocatorTraceCapture)
+        {
+            if (!pConfig->SuballocatorPath.empty())
+                filesystem::create_directory(pConfig->SuballocatorPath);
+            filesystem::path traceFile = filesystem::path(pConfig->SuballocatorPath) / (std::wstring(name) + L".suballoctrace");
+            pSuballocator->EnableTraceCapture(traceFile.c_str());
+        }
+        return pSuballocator;
+    }
+
+    Suballocator::Suballocator(const wchar_t* name, uint64_t size, uint64_t granularity, SuballocatorBackend backend) :
+        m_Name(name),
+        m_Size(size),
+        m_Granularity(granularity),
+        m_Backend(backend)
+    {
+        CauldronAssert(ASSERT_CRITICAL, granularity && !(granularity & (granularity - 1)), L"Suballocator granularity must be a power of two");
+        m_Stats.Size = size;
+
+        std::lock_guard<std::mutex> lock(s_SuballocatorsLock);
+        s_Suballocators.push_back(this);
+    }
+
+    Suballocator::~Suballocator()
+    {
+        {
+            std::lock_guard<std::mutex> lock(s_SuballocatorsLock);
+            s_Suballocators.erase(std::find(s_Suballocators.begin(), s_Suballocators.end(), this));
+        }
+
+        if (m_Stats.AllocationCount)
+            Log::Write(LOGLEVEL_WARNING, L"Suballocator %ls leaked %u allocation(s) holding %llu bytes.", m_Name.c_str(), m_Stats.AllocationCount, m_Stats.UsedSize);
+
+        if (m_CaptureTrace)
+            WriteTrace();
+    }
+
+    bool Suballocator::Allocate(uint64_t size, uint64_t alignment, Allocation& allocation)
+    {
+        CauldronAssert(ASSERT_CRITICAL, alignment && !(alignment & (alignment - 1)), L"Suballocations need a power of two alignment");
+
+        std::lock_guard<std::mutex> lock(m_CriticalSection);
+        const bool allocated = AllocateInternal(AlignUp(std::max<uint64_t>(size, 1), m_Granularity), std::max(alignment, m_Granularity), allocation);
+        if (allocated)
+        {
+            m_Stats.UsedSize += allocation.Size;
+            m_Stats.PeakUsedSize = std::max(m_Stats.PeakUsedSize, m_Stats.UsedSize);
+            ++m_Stats.AllocationCount;
+            ++m_Stats.TotalAllocationCount;
+        }
+        else
+        {
+            ++m_Stats.FailedAllocationCount;
+        }
+
+        if (m_CaptureTrace)
+        {
+            // Failed allocations are recorded as well, they are part of the workload
+            const uint32_t allocationID = m_TraceAllocationCount++;
+            m_TraceEvents.push_back({ allocationID, static_cast<uint32_t>(alignment), size });
+            if (allocated)
+                m_TraceAllocations[allocation.Handle] = allocationID;
+        }
+        return allocated;
+    }
+
+    void Suballocator::Free(const Allocation& allocation)
+    {
+        CauldronAssert(ASSERT_CRITICAL, allocation.Handle != s_InvalidHandle, L"Freeing an invalid suballocation");
+
+        std::lock_guard<std::mutex> lock(m_CriticalSection);
+        FreeInternal(allocation.Handle);
+        m_Stats.UsedSize -= allocation.Size;
+        --m_Stats.AllocationCount;
+
+        if (m_CaptureTrace)
+        {
+            auto iter = m_TraceAllocations.find(allocation.Handle);
+            if (iter != m_TraceAllocations.end())
+            {
+                m_TraceEvents.push_back({ iter->second, 0, 0 });
+                m_TraceAllocations.erase(iter);
+            }
+        }
+    }
+
+    uint64_t Suballocator::GetLargestFreeBlockSize() const
+    {
+        std::lock_guard<std::mutex> lock(m_CriticalSection);
+        return GetLargestFreeBlockSizeInternal();
+    }
+
+    SuballocatorStats Suballocator::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_CriticalSection);
+        SuballocatorStats stats     = m_Stats;
+        stats.LargestFreeBlockSize  = GetLargestFreeBlockSizeInternal();
+        stats.FreeBlockCount        = GetFreeBlockCountInternal();
+        return stats;
+    }
+
+    void Suballocator::EnableTraceCapture(const wchar_t* traceFileName)
+    {
+        std::lock_guard<std::mutex> lock(m_CriticalSection);
+        CauldronAssert(ASSERT_WARNING, !m_Stats.AllocationCount, L"Trace capture of suballocator %ls enabled with live allocations, they won't be part of the trace.", m_Name.c_str());
+        m_TraceFileName = traceFileName;
+        m_CaptureTrace  = true;
+    }
+
+    void Suballocator::WriteTrace() const
+    {
+        SuballocatorTraceHeader header = { s_SuballocatorTraceMagic, s_SuballocatorTraceVersion, m_Size, m_Granularity, m_TraceEvents.size() };
+
+        std::vector<char> traceData(sizeof(header) + m_TraceEvents.size() * sizeof(TraceEvent));
+        memcpy(traceData.data(), &header, sizeof(header));
+        if (!m_TraceEvents.empty())
+            memcpy(traceData.data() + sizeof(header), m_TraceEvents.data(), m_TraceEvents.size() * sizeof(TraceEvent));
+
+        if (WriteFileAll(m_TraceFileName.c_str(), traceData.data(), traceData.size()) != static_cast<int64_t>(traceData.size()))
+            CauldronWarning(L"Could not write suballocator trace %ls", m_TraceFileName.c_str());
+        else
+            Log::Write(LOGLEVEL_TRACE, L"Wrote %llu suballocator events to %ls.", static_cast<uint64_t>(m_TraceEvents.size()), m_TraceFileName.c_str());
+    }
+
+    bool Suballocator::DumpBudgets(const wchar_t* fileName)
+    {
+        json budgets;
+        budgets["Suballocators"] = json::array();
+        {
+            std::lock_guard<std::mutex> lock(s_SuballocatorsLock);
+            for (const Suballocator* pSuballocator : s_Suballocators)
+            {
+                const SuballocatorStats stats = pSuballocator->GetStats();
+
+                json budget;
+                budget["Name"]                  = WStringToString(pSuballocator->GetName());
+                budget["Backend"]               = GetBackendName(pSuballocator->GetBackend());
+                budget["Size"]                  = stats.Size;
+                budget["Granularity"]           = pSuballocator->m_Granularity;
+                budget["UsedSize"]              = stats.UsedSize;
+                budget["PeakUsedSize"]          = stats.PeakUsedSize;
+                budget["AllocationCount"]       = stats.AllocationCount;
+                budget["FreeBlockCount"]        = stats.FreeBlockCount;
+                budget["LargestFreeBlockSize"]  = stats.LargestFreeBlockSize;
+                budget["Fragmentation"]         = stats.GetFragmentation();
+                budget["TotalAllocationCount"]  = stats.TotalAllocationCount;
+                budget["FailedAllocationCount"] = stats.FailedAllocationCount;
+
+                std::string detailedStats;
+                {
+                    std::lock_guard<std::mutex> suballocatorLock(pSuballocator->m_CriticalSection);
+                    detailedStats = pSuballocator->GetDetailedStatsInternal();
+                }
+                if (!detailedStats.empty())
+                {
+                    json details = json::parse(detailedStats, nullptr, false);
+                    if (!details.is_discarded())
+                        budget["Details"] = std::move(details);
+                }
+
+                budgets["Suballocators"].push_back(std::move(budget));
+            }
+        }
+
+        std::ofstream file(fileName, std::ios_base::out | std::ios_base::trunc);
+        if (!file.good())
+        {
+            CauldronWarning(L"Could not open %ls to dump suballocator budgets.", fileName);
+            return false;
+        }
+        file << budgets.dump(4);
+        return file.good();
+    }
+
+    uint64_t Suballocator::ReportLeaks()
+    {
+        uint64_t leakedAllocationCount = 0;
+
+        std::lock_guard<std::mutex> lock(s_SuballocatorsLock);
+        for (const Suballocator* pSuballocator : s_Suballocators)
+        {
+            const SuballocatorStats stats = pSuballocator->GetStats();
+            if (stats.AllocationCount)
+            {
+                Log::Write(LOGLEVEL_WARNING, L"Suballocator %ls leaked %u allocation(s) holding %llu bytes.", pSuballocator->GetName().c_str(), stats.AllocationCount, stats.UsedSize);
+                leakedAllocationCount += stats.AllocationCount;
+            }
+        }
+        return leakedAllocationCount;
+    }
+
+    bool Suballocator::ReplayTrace(const wchar_t* traceFileName, const wchar_t* resultFileName)
+    {
+        int64_t fileSize = 0;
+        int32_t traceFile = OpenFileForRead(traceFileName, &fileSize);
+        if (traceFile == -1)
+        {
+            CauldronWarning(L"Could not open suballocator trace %ls", traceFileName);
+            return false;
+        }
+
+        SuballocatorTraceHeader header = {};
+        bool success = ReadFileAt(traceFile, &header, sizeof(header), 0) == sizeof(header) &&
+                       header.Magic == s_SuballocatorTraceMagic && header.Version == s_SuballocatorTraceVersion &&
+                       static_cast<uint64_t>(fileSize) == sizeof(header) + header.EventCount * sizeof(TraceEvent);
+
+        std::vector<TraceEvent> events;
+        if (success)
+        {
+            events.resize(header.EventCount);
+            success = ReadFileAt(traceFile, events.data(), events.size() * sizeof(TraceEvent), sizeof(header)) ==
+                      static_cast<int64_t>(events.size() * sizeof(TraceEvent));
+        }
+        CloseFileHandle(traceFile);
+
+        if (!success)
+        {
+            CauldronWarning(L"Suballocator trace %ls is invalid or out of date.", traceFileName);
+            return false;
+        }
+
+        uint32_t allocationCount = 0;
+        for (const TraceEvent& event : events)
+            allocationCount = std::max(allocationCount, event.AllocationID + 1);
+
+        json results;
+        results["Trace"]       = WStringToString(traceFileName);
+        results["Size"]        = header.Size;
+        results["Granularity"] = header.Granularity;
+        results["EventCount"]  = events.size();
+        results["Backends"]    = json::array();
+
+        // The dynamic buffer pool's frame ring isn't a backend here: it frees a frame at a time in submission
+        // order, so it can't replay traces that free in arbitrary order
+        std::vector<Allocation> allocations;
+        for (uint32_t backendID = 0; backendID < static_cast<uint32_t>(SuballocatorBackend::Count); ++backendID)
+        {
+            const SuballocatorBackend backend = static_cast<SuballocatorBackend>(backendID);
+            const std::wstring replayName = L"Replay" + StringToWString(GetBackendName(backend));
+
+            // The first pass measures throughput, the second one samples fragmentation along the way
+            double   replayTime            = 0.0;
+            uint64_t failedAllocations     = 0;
+            float    peakFragmentation     = 0.f;
+            double   fragmentationSum      = 0.0;
+            uint64_t fragmentationSamples  = 0;
+            for (uint32_t pass = 0; pass < 2; ++pass)
+            {
+                const bool sampleFragmentation = pass == 1;
+                Suballocator* pSuballocator = CreateSuballocator(replayName.c_str(), header.Size, header.Granularity, backend);
+                allocations.assign(allocationCount, Allocation());
+
+                const auto startTime = std::chrono::steady_clock::now();
+                for (size_t eventID = 0; eventID < events.size(); ++eventID)
+                {
+                    const TraceEvent& event = events[eventID];
+                    Allocation& allocation = allocations[event.AllocationID];
+                    if (event.Alignment)
+                    {
+                        if (!pSuballocator->Allocate(event.Size, event.Alignment, allocation))
+                            allocation.Handle = s_InvalidHandle;
+                    }
+                    else if (allocation.Handle != s_InvalidHandle)
+                    {
+                        pSuballocator->Free(allocation);
+                        allocation.Handle = s_InvalidHandle;
+                    }
+
+                    if (sampleFragmentation && !(eventID % s_ReplayFragmentationInterval))
+                    {
+                        const float fragmentation = pSuballocator->GetStats().GetFragmentation();
+                        peakFragmentation = std::max(peakFragmentation, fragmentation);
+                        fragmentationSum += fragmentation;
+                        ++fragmentationSamples;
+                    }
+                }
+                const auto endTime = std::chrono::steady_clock::now();
+
+                if (!sampleFragmentation)
+                {
+                    replayTime        = std::chrono::duration<double, std::nano>(endTime - startTime).count();
+                    failedAllocations = pSuballocator->GetStats().FailedAllocationCount;
+                }
+
+                // Allocations still live at the end of the trace aren't leaks of the replay
+                for (Allocation& allocation : allocations)
+                {
+                    if (allocation.Handle != s_InvalidHandle)
+                        pSuballocator->Free(allocation);
+                }
+                delete pSuballocator;
+            }
+
+            const double nanosecondsPerEvent = events.empty() ? 0.0 : replayTime / static_cast<double>(events.size());
+
+            json result;
+            result["Backend"]               = GetBackendName(backend);
+            result["NanosecondsPerEvent"]   = nanosecondsPerEvent;
+            result["FailedAllocations"]     = failedAllocations;
+            result["PeakFragmentation"]     = peakFragmentation;
+            result["AverageFragmentation"]  = fragmentationSamples ? fragmentationSum / static_cast<double>(fragmentationSamples) : 0.0;
+            results["Backends"].push_back(std::move(result));
+
+            Log::Write(LOGLEVEL_INFO, L"Suballocator replay (%hs): %.1f ns per event, %llu failed allocations, %.3f peak fragmentation.",
+                       GetBackendName(backend), nanosecondsPerEvent, failedAllocations, peakFragmentation);
+        }
+
+        std::ofstream file(resultFileName, std::ios_base::out | std::ios_base::trunc);
+        if (!file.good())
+        {
+            CauldronWarning(L"Could not open %ls to write suballocator replay results.", resultFileName);
+            return false;
+        }
+        file << results.dump(4);
+        return file.good();
+    }
+
+    TLSFSuballocator::TLSFSuballocator(const wchar_t* name, uint64_t size, uint64_t granularity) :
+        Suballocator(name, size, granularity, SuballocatorBackend::TLSF)
+    {
+        m_Allocator.Init(size, granularity);
+    }
+
+    bool TLSFSuballocator::AllocateInternal(uint64_t size, uint64_t alignment, Allocation& allocation)
+    {
+        TLSFAllocator::Allocation tlsfAllocation;
+        if (!m_Allocator.Allocate(size, alignment, tlsfAllocation))
+            return false;
+
+        allocation.Offset = tlsfAllocation.Offset;
+        allocation.Size   = tlsfAllocation.Size;
+        allocation.Handle = tlsfAllocation.Handle;
+        return true;
+    }
+
+    void TLSFSuballocator::FreeInternal(uint64_t handle)
+    {
+        m_Allocator.Free(static_cast<uint32_t>(handle));
+    }
+
+} // namespace cauldron
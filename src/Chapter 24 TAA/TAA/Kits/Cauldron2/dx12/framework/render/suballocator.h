@@ -0,0 +1,241 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "../misc/helpers.h"
+#include "../misc/tlsfallocator.h"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cauldron
+{
+    /// An enumeration of the engines a <c><i>Suballocator</i></c> can be backed by.
+    ///
+    /// @ingroup CauldronRender
+    enum class SuballocatorBackend
+    {
+        TLSF = 0,               ///< Cauldron's <c><i>TLSFAllocator</i></c>.
+        VirtualBlock,           ///< A D3D12MA virtual block using its default (TLSF) algorithm.
+        VirtualBlockLinear,     ///< A D3D12MA virtual block using its linear algorithm (ring buffer/stack usage patterns).
+
+        Count
+    };
+
+    /// Allocation statistics of a <c><i>Suballocator</i></c>.
+    ///
+    /// @ingroup CauldronRender
+    struct SuballocatorStats
+    {
+        uint64_t Size                   = 0;    ///< The size of the managed range.
+        uint64_t UsedSize               = 0;    ///< The amount of memory held by live allocations.
+        uint64_t PeakUsedSize           = 0;    ///< The highest UsedSize seen over the suballocator's lifetime.
+        uint64_t LargestFreeBlockSize   = 0;    ///< The largest allocation that can currently succeed.
+        uint32_t AllocationCount        = 0;    ///< The number of live allocations.
+        uint32_t FreeBlockCount         = 0;    ///< The number of free blocks the free memory is split in.
+        uint64_t TotalAllocationCount   = 0;    ///< The number of successful allocations over the suballocator's lifetime.
+        uint64_t FailedAllocationCount  = 0;    ///< The number of allocations that didn't fit over the suballocator's lifetime.
+
+        /// Fragmentation of the free memory, 0 when it is a single block and approaching 1 as it gets split up.
+        float GetFragmentation() const
+        {
+            const uint64_t freeSize = Size - UsedSize;
+            return freeSize ? 1.f - static_cast<float>(LargestFreeBlockSize) / static_cast<float>(freeSize) : 0.f;
+        }
+    };
+
+    /**
+     * @class Suballocator
+     *
+     * The <c><i>FidelityFX Cauldron Framework</i></c> shared service to sub-allocate ranges of a larger resource (or
+     * any other linear address space). The allocation engine is selected per suballocator, defaulting to the
+     * backend set in the configuration. The service itself takes care of thread-safety and of the book-keeping
+     * that is common to all backends: allocation statistics, budget dumps of all live suballocators, leak
+     * reporting on destruction and capture of allocation traces.
+     *
+     * The configuration defaults to the TLSF backend, which is covered by the headless tests. The D3D12MA virtual
+     * block backends are opted into through the Suballocators/Backend config entry.
+     *
+     * Captured traces can be replayed through every backend with <c><i>Suballocator::ReplayTrace</i></c> to
+     * compare their fragmentation and allocation throughput on real workloads.
+     *
+     * @ingroup CauldronRender
+     */
+    class Suballocator
+    {
+    public:
+
+        static constexpr uint64_t s_InvalidHandle = UINT64_MAX;
+
+        /**
+         * @struct Allocation
+         *
+         * A range returned by <c><i>Suballocator::Allocate</i></c>.
+         *
+         * @ingroup CauldronRender
+         */
+        struct Allocation
+        {
+            uint64_t Offset = 0;                    ///< The (aligned) offset of the allocation.
+            uint64_t Size   = 0;                    ///< The size of the allocation, rounded up to the suballocator's granularity.
+            uint64_t Handle = s_InvalidHandle;      ///< The backend handle identifying the allocation.
+        };
+
+        /**
+         * @brief   Suballocator instance creation function, using the backend and trace capture settings
+         *          of the configuration. Sizes and offsets are rounded to granularity (a power of two).
+         */
+        static Suballocator* CreateSuballocator(const wchar_t* name, uint64_t size, uint64_t granularity);
+
+        /**
+         * @brief   Suballocator instance creation function for a specific backend. Implemented per api/platform.
+         */
+        static Suballocator* CreateSuballocator(const wchar_t* name, uint64_t size, uint64_t granularity, SuballocatorBackend backend);
+
+        /**
+         * @brief   Destruction. Reports allocations that were never freed, and writes the captured trace (if any).
+         */
+        virtual ~Suballocator();
+
+        /**
+         * @brief   Allocates a range of size bytes at the requested (power of two) alignment. Thread-safe.
+         *          Returns false if no free block can hold the allocation.
+         */
+        bool Allocate(uint64_t size, uint64_t alignment, Allocation& allocation);
+
+        /**
+         * @brief   Releases an allocation. Thread-safe.
+         */
+        void Free(const Allocation& allocation);
+
+        /**
+         * @brief   Returns the size of the largest free block.
+         */
+        uint64_t GetLargestFreeBlockSize() const;
+
+        /**
+         * @brief   Returns the suballocator's statistics.
+         */
+        SuballocatorStats GetStats() const;
+
+        /**
+         * @brief   Returns the suballocator's name.
+         */
+        const std::wstring& GetName() const { return m_Name; }
+
+        /**
+         * @brief   Returns the backend the suballocator is built on.
+         */
+        SuballocatorBackend GetBackend() const { return m_Backend; }
+
+        /**
+         * @brief   Records all allocations and frees to traceFileName, written when the suballocator is destroyed.
+         */
+        void EnableTraceCapture(const wchar_t* traceFileName);
+
+        /**
+         * @brief   Writes the budgets and statistics of all live suballocators to a json file.
+         */
+        static bool DumpBudgets(const wchar_t* fileName);
+
+        /**
+         * @brief   Logs every live suballocator still holding allocations. Returns the number of leaked allocations.
+         */
+        static uint64_t ReportLeaks();
+
+        /**
+         * @brief   Replays a captured allocation trace through every backend and writes the fragmentation and
+         *          throughput each of them achieved to a json file.
+         */
+        static bool ReplayTrace(const wchar_t* traceFileName, const wchar_t* resultFileName);
+
+        /**
+         * @brief   Returns the name of a backend (as used in the configuration).
+         */
+        static const char* GetBackendName(SuballocatorBackend backend);
+
+    private:
+        // No copy, No move
+        NO_COPY(Suballocator)
+        NO_MOVE(Suballocator)
+
+        void WriteTrace() const;
+
+        struct TraceEvent
+        {
+            uint32_t AllocationID = 0;  // Ordinal of the allocation in the trace
+            uint32_t Alignment    = 0;  // 0 for frees
+            uint64_t Size         = 0;
+        };
+
+        std::vector<TraceEvent>                 m_TraceEvents       = {};
+        std::unordered_map<uint64_t, uint32_t>  m_TraceAllocations  = {};   // Live allocation handles to their trace ordinal
+        std::wstring                            m_TraceFileName     = L"";
+        uint32_t                                m_TraceAllocationCount = 0;
+        bool                                    m_CaptureTrace      = false;
+
+    protected:
+        Suballocator(const wchar_t* name, uint64_t size, uint64_t granularity, SuballocatorBackend backend);
+
+        // Backend interface, called with the suballocator's lock held
+        virtual bool AllocateInternal(uint64_t size, uint64_t alignment, Allocation& allocation) = 0;
+        virtual void FreeInternal(uint64_t handle) = 0;
+        virtual uint64_t GetLargestFreeBlockSizeInternal() const = 0;
+        virtual uint32_t GetFreeBlockCountInternal() const = 0;
+        virtual std::string GetDetailedStatsInternal() const { return ""; }   // Optional backend specific json statistics
+
+        const std::wstring          m_Name;
+        const uint64_t              m_Size;
+        const uint64_t              m_Granularity;
+        const SuballocatorBackend   m_Backend;
+
+        SuballocatorStats           m_Stats = {};
+        mutable std::mutex          m_CriticalSection;
+    };
+
+    /**
+     * @class TLSFSuballocator
+     *
+     * <c><i>Suballocator</i></c> backend built on Cauldron's <c><i>TLSFAllocator</i></c>.
+     *
+     * @ingroup CauldronRender
+     */
+    class TLSFSuballocator final : public Suballocator
+    {
+    public:
+        TLSFSuballocator(const wchar_t* name, uint64_t size, uint64_t granularity);
+        virtual ~TLSFSuballocator() = default;
+
+    private:
+        bool AllocateInternal(uint64_t size, uint64_t alignment, Allocation& allocation) override;
+        void FreeInternal(uint64_t handle) override;
+        uint64_t GetLargestFreeBlockSizeInternal() const override { return m_Allocator.GetLargestFreeBlockSize(); }
+        uint32_t GetFreeBlockCountInternal() const override { return m_Allocator.GetFreeBlockCount(); }
+
+        TLSFAllocator m_Allocator;
+    };
+
+} // namespace cauldron
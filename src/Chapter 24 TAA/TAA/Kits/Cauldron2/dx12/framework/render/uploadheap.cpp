@@ -25,147 +25,110 @@
 #include "../core/framework.h"
 #include "gpuresource.h"
 #include "uploadheap.h"
+#include "../misc/poolallocator.h"
 
 #include <chrono>
 #include <thread>
 
 namespace cauldron
 {
+    // All transfers are placed at multiples of this inside the heap
+    static constexpr uint64_t s_UploadHeapGranularity = 256;
+
+    // Buffer resources are placed at 64KB boundaries
+    static constexpr size_t s_UploadHeapBaseAlignment = 64 * 1024;
+
+    void* TransferInfo::operator new(size_t size)
+    {
+        CauldronAssert(ASSERT_CRITICAL, size == sizeof(TransferInfo), L"Transfer pool only serves TransferInfo objects");
+        return PoolAllocator<TransferInfo>::Allocate();
+    }
+
+    void TransferInfo::operator delete(void* pMem)
+    {
+        PoolAllocator<TransferInfo>::Free(pMem);
+    }
+
     UploadHeap::~UploadHeap()
     {
+        delete m_pAllocator;
         delete m_pResource;
     }
 
     void UploadHeap::InitAllocationBlocks()
     {
-        // Only one block at the beginning
-        AllocationBlock allocationInfo;
-        allocationInfo.pDataBegin  = m_pDataBegin;
-        allocationInfo.pDataEnd    = m_pDataEnd;
-        allocationInfo.Size        = ((uint64_t)m_pDataEnd) - ((uint64_t)m_pDataBegin);
+        // Slices are aligned relative to the heap's start, which needs to be aligned at least as much as they are
+        CauldronAssert(ASSERT_CRITICAL, !(reinterpret_cast<size_t>(m_pDataBegin) & (s_UploadHeapBaseAlignment - 1)), L"Upload heap memory is not sufficiently aligned");
 
-        m_AvailableAllocations.push_back(allocationInfo);
+        // The whole heap starts out as a single free block
+        m_pAllocator = Suballocator::CreateSuballocator(L"UploadHeap", static_cast<uint64_t>(m_pDataEnd - m_pDataBegin), s_UploadHeapGranularity);
     }
 
     TransferInfo* UploadHeap::BeginResourceTransfer(size_t sliceSize, uint64_t sliceAlignment, uint32_t numSlices)
     {
-        // Before we try to make any modifications, see how much mem we need and check if there is enough available
-        size_t requiredSize = AlignUp(sliceSize, sliceAlignment) * numSlices;
-        CauldronAssert(ASSERT_CRITICAL, requiredSize < m_Size, L"Resource will not fit into upload heap. Please make it bigger");
+        return AllocateTransfer(sliceSize, sliceAlignment, numSlices, numSlices);
+    }
 
-        // Spin here until we can get the size we need (might have to wait for other jobs to finish up)
-        uint8_t* pDataBegin = nullptr;
-        uint8_t* pDataEnd = nullptr;
+    TransferInfo* UploadHeap::BeginPartialResourceTransfer(size_t sliceSize, uint64_t sliceAlignment, uint32_t numSlices)
+    {
+        return AllocateTransfer(sliceSize, sliceAlignment, numSlices, 1);
+    }
 
-        TransferInfo* pTransferInfo = nullptr;
-        bool logged = false;
+    TransferInfo* UploadHeap::AllocateTransfer(size_t sliceSize, uint64_t sliceAlignment, uint32_t numSlices, uint32_t minSlices)
+    {
+        // Before we try to make any modifications, see how much mem we need and check if there is enough available
+        const uint64_t slicePitch = AlignUp(static_cast<uint64_t>(sliceSize), sliceAlignment);
+        CauldronAssert(ASSERT_CRITICAL, slicePitch * minSlices < m_Size, L"Resource will not fit into upload heap. Please make it bigger");
 
-        while (!pTransferInfo)
+        Suballocator::Allocation allocation;
+        uint32_t sliceCount = numSlices;
         {
-            // Go through the list of allocation blocks and find one big enough to accommodate us
+            std::unique_lock<std::mutex> lock(m_AllocationMutex);
+            for (;;)
             {
-                std::unique_lock<std::mutex> lock(m_AllocationMutex);
-                std::vector<AllocationBlock>::iterator iter = m_AvailableAllocations.begin();
-                while (iter != m_AvailableAllocations.end())
-                {
-                    if ((*iter).Size > requiredSize)
-                    {
-                        // Figure out the begin, aligned begin, and end for the memory we want to use
-                        pDataBegin = (*iter).pDataBegin;
-                        uint8_t* pAlignedBegin = reinterpret_cast<uint8_t*>(AlignUp(reinterpret_cast<size_t>(pDataBegin), static_cast<size_t>(sliceAlignment)));
-                        pDataEnd = reinterpret_cast<uint8_t*>(reinterpret_cast<size_t>(pAlignedBegin) + requiredSize);
-
-                        // Modify the existing block
-                        (*iter).pDataBegin = pDataEnd;
-                        (*iter).Size = ((uint64_t)(*iter).pDataEnd) - ((uint64_t)(*iter).pDataBegin);
-
-                        // Create our transfer block
-                        m_ActiveTranfers.push_back(new TransferInfo());
-                        pTransferInfo = m_ActiveTranfers.back();
-                        break;
-                    }
-                    
-                    ++iter;
-                }
+                if (m_pAllocator->Allocate(slicePitch * numSlices, sliceAlignment, allocation))
+                    break;
 
-                // If we got here, couldn't find a block big enough. Sleep a bit and try again
-                if (!pTransferInfo)
+                // Take as many slices as the largest free block holds. If padding for alignment gets in
+                // the way of the last one, one slice less is always going to fit.
+                const uint64_t fittingSlices = std::min<uint64_t>(m_pAllocator->GetLargestFreeBlockSize() / slicePitch, numSlices - 1);
+                if (fittingSlices >= minSlices)
                 {
-                    if (!logged)
-                    {
-                        logged = true;  // Don't spam the output for the same resource
-                        //CauldronWarning(L"Could not get a %zu size data block for resource data transfer. Waiting until more blocks are freed. Consider growing upload heap size.", requiredSize);
-                    }                    
-                    m_AllocationCV.wait(lock);
+                    sliceCount = static_cast<uint32_t>(fittingSlices);
+                    if (m_pAllocator->Allocate(slicePitch * sliceCount, sliceAlignment, allocation))
+                        break;
+                    if (--sliceCount >= minSlices && m_pAllocator->Allocate(slicePitch * sliceCount, sliceAlignment, allocation))
+                        break;
                 }
-            }                
-        }
 
-        // Got our memory, setup the transfer information, the slice pointers and fetch a command list to record the work
-        pTransferInfo->AllocationInfo.pDataBegin    = pDataBegin;
-        pTransferInfo->AllocationInfo.pDataEnd      = pDataEnd;
-        pTransferInfo->AllocationInfo.Size          = ((uint64_t)pTransferInfo->AllocationInfo.pDataEnd) - ((uint64_t)pTransferInfo->AllocationInfo.pDataBegin);
-
-        uint8_t* pSliceStart = pDataBegin;
-        for (uint32_t i = 0; i < numSlices; ++i)
-        {
-            pSliceStart = reinterpret_cast<uint8_t*>(AlignUp(reinterpret_cast<size_t>(pSliceStart), static_cast<size_t>(sliceAlignment)));
-            pTransferInfo->pSliceDataBegin.push_back(pSliceStart);
-            pSliceStart += (sliceSize);
+                // Couldn't find a block big enough, wait for in-flight transfers to complete and try again
+                sliceCount = numSlices;
+                m_AllocationCV.wait(lock);
+            }
         }
 
+        // Got our memory, setup the transfer information
+        TransferInfo* pTransferInfo = new TransferInfo();
+        pTransferInfo->AllocationInfo.pDataBegin    = m_pDataBegin + allocation.Offset;
+        pTransferInfo->AllocationInfo.pDataEnd      = pTransferInfo->AllocationInfo.pDataBegin + allocation.Size;
+        pTransferInfo->AllocationInfo.Size          = static_cast<size_t>(allocation.Size);
+        pTransferInfo->SlicePitch                   = slicePitch;
+        pTransferInfo->SliceCount                   = sliceCount;
+        pTransferInfo->Suballocation                = allocation;
         return pTransferInfo;
     }
 
     void UploadHeap::EndResourceTransfer(TransferInfo* pTransferBlock)
     {
-        // Lock to avoid data collisions
+        // Return the allocation block to the heap (joins it with adjacent free blocks)
         {
             std::unique_lock<std::mutex> lock(m_AllocationMutex);
-
-            // Return the allocation block to the pool (will join memory to a an adjacent block where possible)
-            std::vector<AllocationBlock>::iterator iter = m_AvailableAllocations.begin();
-
-            // First find the right spot to insert it (ordered)
-            for (; iter != m_AvailableAllocations.end(); ++iter)
-            {
-                if ((*iter).pDataBegin >= pTransferBlock->AllocationInfo.pDataEnd)
-                    break;
-            }
-            iter = m_AvailableAllocations.insert(iter, pTransferBlock->AllocationInfo);
-
-            // Now merge adjacent blocks together to free up larger blocks
-            for (size_t index = m_AvailableAllocations.size() - 1; index >= 1; --index)
-            {
-                // Check if they are joinable
-                if (m_AvailableAllocations[index].pDataBegin == m_AvailableAllocations[index - 1].pDataEnd)
-                {
-                    // Merge them 
-                    m_AvailableAllocations[index - 1].pDataEnd = m_AvailableAllocations[index].pDataEnd;
-                    m_AvailableAllocations[index - 1].Size += m_AvailableAllocations[index].Size;
-                    
-                    // Remove the previous element
-                    m_AvailableAllocations.erase(std::next(m_AvailableAllocations.begin(), index));
-                }
-            }
-
-            // Find and destroy this active transfer to clean everything up
-            std::vector<TransferInfo*>::iterator transferIter = m_ActiveTranfers.begin();
-            while (transferIter != m_ActiveTranfers.end())
-            {
-                if (*transferIter == pTransferBlock)
-                {
-                    delete pTransferBlock;
-                    m_ActiveTranfers.erase(transferIter);
-                    break;
-                }
-
-                ++transferIter;
-            }
-
-            // Signal any pending allocations
-            m_AllocationCV.notify_one();
+            m_pAllocator->Free(pTransferBlock->Suballocation);
         }
+        delete pTransferBlock;
+
+        // Signal any pending allocations (they may be waiting for different sizes)
+        m_AllocationCV.notify_all();
     }
 
 } // namespace cauldron
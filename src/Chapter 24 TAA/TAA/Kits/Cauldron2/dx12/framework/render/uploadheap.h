@@ -24,6 +24,7 @@
 
 #include "../misc/helpers.h"
 #include "../misc/sync.h"
+#include "suballocator.h"
 
 #include <vector>
 
@@ -49,12 +50,21 @@ namespace cauldron
     /// @ingroup CauldronRender
     struct TransferInfo
     {
-        uint8_t* DataPtr(uint32_t sliceID) { return pSliceDataBegin[sliceID]; }
+        uint8_t* DataPtr(uint32_t sliceID) { return AllocationInfo.pDataBegin + SlicePitch * sliceID; }
+
+        /// The number of slices backed by the transfer (can be less than requested for partial transfers).
+        uint32_t GetSliceCount() const { return SliceCount; }
+
+        // Transfers come from a pool
+        static void* operator new(size_t size);
+        static void operator delete(void* pMem);
 
     private:
         friend class UploadHeap;
-        AllocationBlock         AllocationInfo;   // The backing allocation
-        std::vector<uint8_t*>   pSliceDataBegin;  // The data pointer for each slice of data in the block
+        AllocationBlock         AllocationInfo;     // The backing allocation
+        uint64_t                SlicePitch = 0;     // The aligned size of each slice of data in the block
+        uint32_t                SliceCount = 0;     // The number of slices in the block
+        Suballocator::Allocation Suballocation;     // The heap range backing the block
     };
 
     /// Per platform/API implementation of <c><i>UploadHeap</i></c>
@@ -102,9 +112,17 @@ namespace cauldron
 
         /**
          * @brief   Returns a <c><i>TransferInfo</i></c> instance setup to load a resource as requested.
+         *          Waits for memory to be freed if all slices can't be allocated at once.
          */
         TransferInfo* BeginResourceTransfer(size_t sliceSize, uint64_t sliceAlignment, uint32_t numSlices);
 
+        /**
+         * @brief   Returns a <c><i>TransferInfo</i></c> instance backing as many of the requested slices as
+         *          currently fit (at least one, see <c><i>TransferInfo::GetSliceCount</i></c>). Lets large
+         *          transfers be split in chunks instead of waiting for the entire transfer to fit.
+         */
+        TransferInfo* BeginPartialResourceTransfer(size_t sliceSize, uint64_t sliceAlignment, uint32_t numSlices);
+
         /**
          * @brief   Ends the resource transfer associated with the <c><i>TransferInfo</i></c> pointer.
          */
@@ -121,6 +139,8 @@ namespace cauldron
         NO_COPY(UploadHeap)
         NO_MOVE(UploadHeap)
 
+        TransferInfo* AllocateTransfer(size_t sliceSize, uint64_t sliceAlignment, uint32_t numSlices, uint32_t minSlices);
+
     protected:
         UploadHeap() = default;
 
@@ -130,8 +150,7 @@ namespace cauldron
         uint8_t*        m_pDataEnd      = nullptr; // Ending position of upload heap 
         uint8_t*        m_pDataBegin    = nullptr; // Starting position of upload heap
 
-        std::vector<AllocationBlock>    m_AvailableAllocations;
-        std::vector<TransferInfo*>      m_ActiveTranfers;
+        Suballocator*                   m_pAllocator = nullptr;
         std::mutex                      m_AllocationMutex;
         std::condition_variable         m_AllocationCV;
     };
@@ -113,6 +113,17 @@ RasterShadowRenderModule::~RasterShadowRenderModule()
     m_ShadowMapInfos.clear();
 }
 
+void RasterShadowRenderModule::OnPreFrame()
+{
+    std::lock_guard<std::mutex> shadowLock(m_CriticalSection);
+
+    // All shadow maps are re-rendered every frame, so moved views only need to pick up their new location
+    // before the scene builds the shadow map transforms from them
+    std::vector<ShadowMapResourcePool::ShadowMapMove> shadowMapMoves;
+    if (GetFramework()->GetShadowMapResourcePool()->Defragment(s_ShadowAtlasDefragMovesPerFrame, shadowMapMoves) > 0)
+        ApplyShadowMapMoves(shadowMapMoves);
+}
+
 void RasterShadowRenderModule::Execute(double deltaTime, CommandList* pCmdList)
 {
     GPUScopedProfileCapture rasterShadowMapMarker(pCmdList, L"RasterShadow");
@@ -125,6 +136,7 @@ void RasterShadowRenderModule::Execute(double deltaTime, CommandList* pCmdList)
     // Transition all the shadow maps for write
     // Render modules expect resources coming in/going out to be in a shader read state
     ShadowMapResourcePool* pShadowPool = GetFramework()->GetShadowMapResourcePool();
+
     std::vector<Barrier> barriers;
     for (uint32_t i = 0; i < pShadowPool->GetRenderTargetCount(); ++i)
     {
@@ -804,6 +816,32 @@ void RasterShadowRenderModule::UpdateUIState(bool hasDirectional)
     }
 }
 
+void RasterShadowRenderModule::ApplyShadowMapMoves(const std::vector<ShadowMapResourcePool::ShadowMapMove>& moves)
+{
+    for (const ShadowMapResourcePool::ShadowMapMove& move : moves)
+    {
+        for (auto& shadowMapInfo : m_ShadowMapInfos)
+        {
+            if (shadowMapInfo.ShadowMapIndex != move.index)
+                continue;
+
+            for (auto lightIter = shadowMapInfo.LightComponents.begin(); lightIter < shadowMapInfo.LightComponents.end(); ++lightIter)
+            {
+                LightComponent* pLightComponent = const_cast<LightComponent*>(*lightIter);
+                LightComponentData& lightData = pLightComponent->GetData();
+                for (int i = 0; i < pLightComponent->GetShadowMapCount(); ++i)
+                {
+                    if (lightData.ShadowMapIndex[i] == move.index && lightData.ShadowMapCellIndex[i] == move.srcCellIndex)
+                    {
+                        lightData.ShadowMapCellIndex[i] = move.dstCellIndex;
+                        lightData.ShadowMapRect[i] = move.rect;
+                    }
+                }
+            }
+        }
+    }
+}
+
 void RasterShadowRenderModule::UpdateCascades()
 {
     // Find all the directional lights
@@ -72,6 +72,12 @@ public:
     */
     void Init(const json& initData) override;
 
+    /**
+    * @brief   Compacts the shadow atlases a few cells at a time. Runs before the scene update so this frame's
+    *          shadow map transforms are built from the new cell locations.
+    */
+    void OnPreFrame() override;
+
     /**
     * @brief   Renders all active shadow geometry in the <c><i>Scene</i></c> from each shadow-casting light's point of view.
     */
@@ -101,6 +107,7 @@ private:
     void DestroyShadowMapInfo(cauldron::LightComponent* pLightComponent);
 
     void UpdateCascades();
+    void ApplyShadowMapMoves(const std::vector<cauldron::ShadowMapResourcePool::ShadowMapMove>& moves);
 
     void UpdateUIState(bool hasDirectional);
 
@@ -108,6 +115,7 @@ private:
 
     static constexpr uint32_t s_MaxTextureCount = 200;
     static constexpr uint32_t s_MaxSamplerCount = 20;
+    static constexpr uint32_t s_ShadowAtlasDefragMovesPerFrame = 4;
 
     cauldron::RootSignature* m_pRootSignature = nullptr;
     cauldron::ParameterSet*  m_pParameterSet  = nullptr;
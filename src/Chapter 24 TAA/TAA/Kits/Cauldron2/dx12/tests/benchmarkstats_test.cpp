@@ -0,0 +1,253 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "misc/benchmarkstats.h"
+#include "testing.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace cauldron;
+
+// Percentiles interpolate between the closest ranks, the mean and variance are those of the inliers
+static void TestSummary()
+{
+    BenchmarkSeries series;
+    for (uint64_t i = 100; i > 0; --i)
+        series.AddSample(i);
+
+    const BenchmarkSummary summary = series.Summarize(0.0);
+    CHECK(summary.SampleCount == 100);
+    CHECK(summary.OutlierCount == 0);
+    CHECK_NEAR(summary.P50, 50.5, 1e-9);
+    CHECK_NEAR(summary.P90, 90.1, 1e-9);
+    CHECK_NEAR(summary.P99, 99.01, 1e-9);
+    CHECK_NEAR(summary.Peak, 100.0, 0.0);
+    CHECK_NEAR(summary.Min, 1.0, 0.0);
+    CHECK_NEAR(summary.Max, 100.0, 0.0);
+    CHECK_NEAR(summary.Mean, 50.5, 1e-9);
+    CHECK_NEAR(summary.Variance, 100.0 * 101.0 / 12.0, 1e-6);
+
+    // A single sample has no variance
+    BenchmarkSeries single;
+    single.AddSample(42);
+    const BenchmarkSummary singleSummary = single.Summarize(3.5);
+    CHECK_NEAR(singleSummary.P50, 42.0, 0.0);
+    CHECK_NEAR(singleSummary.P99, 42.0, 0.0);
+    CHECK_NEAR(singleSummary.Mean, 42.0, 0.0);
+    CHECK_NEAR(singleSummary.Variance, 0.0, 0.0);
+
+    // Nothing to summarize
+    const BenchmarkSummary emptySummary = BenchmarkSeries().Summarize(3.5);
+    CHECK(emptySummary.SampleCount == 0);
+    CHECK_NEAR(emptySummary.Mean, 0.0, 0.0);
+}
+
+// Spikes are rejected from the mean and variance, but still show up in the percentiles and peak
+static void TestOutlierRejection()
+{
+    BenchmarkSeries series;
+    const uint64_t samples[] = { 100, 101, 99, 102, 98, 100, 101, 99, 100, 100, 5000 };
+    for (uint64_t sample : samples)
+        series.AddSample(sample);
+
+    const BenchmarkSummary summary = series.Summarize(3.5);
+    CHECK(summary.SampleCount == 11);
+    CHECK(summary.OutlierCount == 1);
+    CHECK(summary.GetInlierCount() == 10);
+    CHECK_NEAR(summary.Mean, 100.0, 1e-9);
+    CHECK_NEAR(summary.Variance, 12.0 / 9.0, 1e-9);
+    CHECK_NEAR(summary.Max, 102.0, 0.0);
+    CHECK_NEAR(summary.Peak, 5000.0, 0.0);
+
+    // Disabled rejection keeps everything
+    const BenchmarkSummary unfiltered = series.Summarize(0.0);
+    CHECK(unfiltered.OutlierCount == 0);
+    CHECK_NEAR(unfiltered.Max, 5000.0, 0.0);
+
+    // More than half the samples being equal falls back on the mean absolute deviation
+    BenchmarkSeries flat;
+    for (uint32_t i = 0; i < 20; ++i)
+        flat.AddSample(1000);
+    flat.AddSample(1001);
+    flat.AddSample(100000);
+    const BenchmarkSummary flatSummary = flat.Summarize(3.5);
+    CHECK(flatSummary.OutlierCount == 1);
+    CHECK_NEAR(flatSummary.Max, 1001.0, 0.0);
+}
+
+// The histogram bounds the relative error of its percentiles
+static void TestHistogram()
+{
+    BenchmarkHistogram histogram;
+    CHECK_NEAR(histogram.GetPercentile(0.5), 0.0, 0.0);
+
+    for (uint64_t i = 0; i < 32; ++i)
+        histogram.Record(i);
+    CHECK(histogram.GetCount() == 32);
+    CHECK(histogram.GetBuckets().size() == 32);
+
+    // Small values are exact
+    CHECK_NEAR(histogram.GetPercentile(0.5), 15.0, 0.0);
+
+    BenchmarkHistogram wide;
+    for (uint64_t i = 1; i <= 10000; ++i)
+        wide.Record(i * 1000);
+    CHECK_NEAR(wide.GetPercentile(0.5), 5000000.0, 5000000.0 / BenchmarkHistogram::s_SubBucketCount);
+    CHECK_NEAR(wide.GetPercentile(0.99), 9900000.0, 9900000.0 / BenchmarkHistogram::s_SubBucketCount);
+
+    // Buckets cover all samples and don't overlap
+    uint64_t count = 0;
+    uint64_t previousUpperBound = 0;
+    for (const BenchmarkHistogramBucket& bucket : wide.GetBuckets())
+    {
+        CHECK(bucket.LowerBound < bucket.UpperBound);
+        CHECK(bucket.LowerBound >= previousUpperBound);
+        previousUpperBound = bucket.UpperBound;
+        count += bucket.Count;
+    }
+    CHECK(count == wide.GetCount());
+}
+
+static void TestWarmup()
+{
+    // Steady frame times settle as soon as two full windows are in, past the minimum frame count
+    BenchmarkWarmup steady(10, 1000, 30, 0.02);
+    uint32_t frame = 0;
+    while (!steady.AddFrame(16000000))
+        ++frame;
+    CHECK(steady.ReachedSteadyState());
+    CHECK(steady.GetFrameCount() == 60);
+
+    // The minimum frame count holds even when frame times settled earlier
+    BenchmarkWarmup minimum(100, 1000, 30, 0.02);
+    while (!minimum.AddFrame(16000000)) {}
+    CHECK(minimum.GetFrameCount() == 100);
+
+    // Frame times that keep drifting never settle, warmup stops at the maximum
+    BenchmarkWarmup drifting(10, 200, 30, 0.02);
+    uint64_t frameTime = 16000000;
+    while (!drifting.AddFrame(frameTime))
+        frameTime += frameTime / 50;
+    CHECK(!drifting.ReachedSteadyState());
+    CHECK(drifting.GetFrameCount() == 200);
+}
+
+// Two-sided critical values of Student's t distribution
+static void TestStudentT()
+{
+    CHECK_NEAR(StudentTTwoSidedPValue(12.706, 1.0), 0.05, 1e-4);
+    CHECK_NEAR(StudentTTwoSidedPValue(2.228, 10.0), 0.05, 1e-4);
+    CHECK_NEAR(StudentTTwoSidedPValue(-2.228, 10.0), 0.05, 1e-4);
+    CHECK_NEAR(StudentTTwoSidedPValue(2.750, 30.0), 0.01, 1e-4);
+    CHECK_NEAR(StudentTTwoSidedPValue(1.960, 1e6), 0.05, 1e-4);
+    CHECK_NEAR(StudentTTwoSidedPValue(0.0, 10.0), 1.0, 1e-9);
+    CHECK_NEAR(StudentTTwoSidedPValue(1.0, 0.0), 1.0, 0.0);
+}
+
+static BenchmarkSummary MakeSummary(double mean, double variance, uint64_t sampleCount)
+{
+    BenchmarkSummary summary;
+    summary.SampleCount = sampleCount;
+    summary.Mean        = mean;
+    summary.Variance    = variance;
+    return summary;
+}
+
+static void TestComparison()
+{
+    const BenchmarkSummary baseline = MakeSummary(1000.0, 100.0, 1000);
+
+    // 10% slower with tight variance is a regression past a 5% threshold
+    BenchmarkComparison comparison = CompareBenchmarks(baseline, MakeSummary(1100.0, 100.0, 1000), 0.01, 0.05);
+    CHECK_NEAR(comparison.RelativeChange, 0.1, 1e-9);
+    CHECK(comparison.Significant);
+    CHECK(comparison.Regression);
+    CHECK(!comparison.Improvement);
+
+    // Significant, but below the regression threshold
+    comparison = CompareBenchmarks(baseline, MakeSummary(1020.0, 100.0, 1000), 0.01, 0.05);
+    CHECK(comparison.Significant);
+    CHECK(!comparison.Regression);
+    CHECK(!comparison.Improvement);
+
+    // 10% faster is an improvement
+    comparison = CompareBenchmarks(baseline, MakeSummary(900.0, 100.0, 1000), 0.01, 0.05);
+    CHECK(comparison.Improvement);
+    CHECK(!comparison.Regression);
+
+    // 10% slower but drowned in noise isn't significant
+    comparison = CompareBenchmarks(MakeSummary(1000.0, 250000.0, 10), MakeSummary(1100.0, 250000.0, 10), 0.01, 0.05);
+    CHECK(!comparison.Significant);
+    CHECK(!comparison.Regression);
+
+    // Welch's t-test: t = 3 / sqrt(25/30 + 25/30) = 2.3238 with 58 degrees of freedom
+    comparison = CompareBenchmarks(MakeSummary(100.0, 25.0, 30), MakeSummary(103.0, 25.0, 30), 0.05, 0.01);
+    CHECK_NEAR(comparison.PValue, 0.0237, 5e-4);
+    CHECK(comparison.Regression);
+
+    // Not enough samples to test anything
+    comparison = CompareBenchmarks(MakeSummary(1000.0, 0.0, 1), MakeSummary(2000.0, 0.0, 1), 0.01, 0.05);
+    CHECK_NEAR(comparison.PValue, 1.0, 0.0);
+    CHECK(!comparison.Regression);
+
+    // Without any variance, any difference is significant
+    comparison = CompareBenchmarks(MakeSummary(1000.0, 0.0, 10), MakeSummary(1100.0, 0.0, 10), 0.01, 0.05);
+    CHECK_NEAR(comparison.PValue, 0.0, 0.0);
+    CHECK(comparison.Regression);
+}
+
+static void TestExitCodes()
+{
+    CHECK(GetBenchmarkExitCode(true, 10, 0) == BenchmarkExitCode::Success);
+    CHECK(GetBenchmarkExitCode(true, 10, 1) == BenchmarkExitCode::Regression);
+    CHECK(GetBenchmarkExitCode(true, 0, 0) == BenchmarkExitCode::BaselineError);
+    CHECK(GetBenchmarkExitCode(false, 0, 0) == BenchmarkExitCode::BaselineError);
+    CHECK(static_cast<int32_t>(BenchmarkExitCode::Success) == 0);
+    CHECK(static_cast<int32_t>(BenchmarkExitCode::Regression) == 2);
+    CHECK(static_cast<int32_t>(BenchmarkExitCode::BaselineError) == 3);
+
+    // End to end: a series regressing against its baseline series fails the run
+    BenchmarkSeries baselineSeries;
+    BenchmarkSeries currentSeries;
+    for (uint64_t i = 0; i < 500; ++i)
+    {
+        baselineSeries.AddSample(1000000 + (i * 7919) % 20000);
+        currentSeries.AddSample(1100000 + (i * 104729) % 20000);
+    }
+    const BenchmarkComparison comparison = CompareBenchmarks(baselineSeries.Summarize(3.5), currentSeries.Summarize(3.5), 0.01, 0.05);
+    CHECK(GetBenchmarkExitCode(true, 1, comparison.Regression ? 1 : 0) == BenchmarkExitCode::Regression);
+    const BenchmarkComparison selfComparison = CompareBenchmarks(baselineSeries.Summarize(3.5), baselineSeries.Summarize(3.5), 0.01, 0.05);
+    CHECK(GetBenchmarkExitCode(true, 1, selfComparison.Regression ? 1 : 0) == BenchmarkExitCode::Success);
+}
+
+int main()
+{
+    TestSummary();
+    TestOutlierRejection();
+    TestHistogram();
+    TestWarmup();
+    TestStudentT();
+    TestComparison();
+    TestExitCodes();
+    return cauldron::test::GetExitCode();
+}
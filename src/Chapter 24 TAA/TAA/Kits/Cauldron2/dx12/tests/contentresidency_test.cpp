@@ -0,0 +1,238 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "misc/contentresidency.h"
+#include "testing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using namespace cauldron;
+
+// Requests come first, then visible content from closest to furthest, content already reloading or out of view is left alone
+static void TestReloadOrder()
+{
+    std::vector<EvictedContentInfo> evicted(6);
+    evicted[0].Visible = true;  evicted[0].Distance = 30.f;
+    evicted[1].Visible = false; evicted[1].Distance = 1.f;
+    evicted[2].Visible = true;  evicted[2].Distance = 10.f;
+    evicted[3].Requested = true;
+    evicted[4].Visible = true;  evicted[4].Distance = 5.f; evicted[4].Reloading = true;
+    evicted[5].Visible = true;  evicted[5].Distance = 20.f;
+
+    const std::vector<size_t> reloadOrder = SelectContentToReload(evicted);
+    CHECK(reloadOrder == std::vector<size_t>({ 3, 2, 5, 0 }));
+    CHECK(SelectContentToReload({}).empty());
+}
+
+// Least recently used content goes first, only as much as needed, never content in use this frame or that can't be evicted
+static void TestEvictOrder()
+{
+    std::vector<ResidentContentInfo> resident(5);
+    resident[0] = { 100, 8, true };
+    resident[1] = { 100, 3, true };
+    resident[2] = { 100, 10, true };    // Used this frame
+    resident[3] = { 100, 1, false };    // Still loading
+    resident[4] = { 100, 5, true };
+
+    bool overBudget = true;
+    CHECK(SelectContentToEvict(resident, 500, 500, 10, overBudget).empty());
+    CHECK(!overBudget);
+
+    CHECK(SelectContentToEvict(resident, 500, 350, 10, overBudget) == std::vector<size_t>({ 1, 4 }));
+    CHECK(!overBudget);
+
+    // Only 3 blocks are evictable, which isn't enough to get there
+    CHECK(SelectContentToEvict(resident, 500, 100, 10, overBudget) == std::vector<size_t>({ 1, 4, 0 }));
+    CHECK(overBudget);
+}
+
+// Simulates a camera travelling back and forth over a row of content blocks, with a budget well below the total
+// content size and reloads that take a few frames to complete, the way the content manager drives the residency policy.
+static void TestCameraPath()
+{
+    struct Block
+    {
+        float    Position      = 0.f;
+        uint64_t Bytes         = 0;
+        bool     Resident      = true;
+        bool     Reloading     = false;
+        uint64_t ReadyFrame    = 0;
+        uint64_t LastUsedFrame = 0;
+        uint64_t VisibleSince  = 0;
+        bool     WasVisible    = false;
+        bool     ServedInView  = false;
+    };
+
+    const uint32_t blockCount   = 64;
+    const float    blockSpacing = 10.f;
+    const float    viewDistance = 25.f;
+    const uint64_t reloadFrames = 3;
+    const uint64_t budget       = 40;
+
+    std::vector<Block> blocks(blockCount);
+    uint64_t totalBytes = 0;
+    for (uint32_t i = 0; i < blockCount; ++i)
+    {
+        blocks[i].Position = i * blockSpacing;
+        blocks[i].Bytes    = 1 + i % 3;
+        totalBytes        += blocks[i].Bytes;
+    }
+    CHECK(totalBytes > budget * 2);
+
+    // Everything starts loaded (the initial load isn't budgeted), then the camera goes to the end of the row and back twice
+    const float    pathLength = (blockCount - 1) * blockSpacing;
+    const float    speed      = 2.5f;
+    const uint64_t frameCount = static_cast<uint64_t>(4.f * pathLength / speed);
+
+    uint64_t reloadCount = 0, evictCount = 0, viewEntryCount = 0, maxResidencyDelay = 0, maxResidentBytes = 0;
+    bool     everOverBudget = false;
+    for (uint64_t frame = 1; frame <= frameCount; ++frame)
+    {
+        const float pathPosition = std::fmod(frame * speed, 2.f * pathLength);
+        const float cameraX      = pathPosition < pathLength ? pathPosition : 2.f * pathLength - pathPosition;
+
+        // Reloads that completed become resident and in use (the content manager stamps them when they are added to the scene)
+        for (Block& block : blocks)
+        {
+            if (block.Reloading && block.ReadyFrame <= frame)
+            {
+                block.Reloading     = false;
+                block.Resident      = true;
+                block.LastUsedFrame = frame;
+            }
+        }
+
+        // Visible content is in use
+        std::vector<bool> visible(blockCount);
+        for (uint32_t i = 0; i < blockCount; ++i)
+        {
+            Block& block = blocks[i];
+            visible[i] = std::abs(block.Position - cameraX) <= viewDistance;
+            if (visible[i] && !block.WasVisible)
+            {
+                block.VisibleSince = frame;
+                block.ServedInView = false;
+                ++viewEntryCount;
+            }
+            block.WasVisible = visible[i];
+
+            if (visible[i] && block.Resident)
+            {
+                block.LastUsedFrame = frame;
+                if (!block.ServedInView)
+                    maxResidencyDelay = std::max(maxResidencyDelay, frame - block.VisibleSince);
+                block.ServedInView = true;
+            }
+        }
+
+        // Reload evicted content coming into view, closest first
+        std::vector<EvictedContentInfo> evictedInfos;
+        std::vector<uint32_t>           evictedBlocks;
+        for (uint32_t i = 0; i < blockCount; ++i)
+        {
+            if (blocks[i].Resident)
+                continue;
+
+            EvictedContentInfo info;
+            info.Visible   = visible[i];
+            info.Distance  = std::abs(blocks[i].Position - cameraX);
+            info.Reloading = blocks[i].Reloading;
+            evictedInfos.push_back(info);
+            evictedBlocks.push_back(i);
+        }
+
+        const std::vector<size_t> reloadOrder = SelectContentToReload(evictedInfos);
+        for (size_t i = 1; i < reloadOrder.size(); ++i)
+            CHECK(evictedInfos[reloadOrder[i - 1]].Distance <= evictedInfos[reloadOrder[i]].Distance);
+        for (size_t reloadIndex : reloadOrder)
+        {
+            Block& block = blocks[evictedBlocks[reloadIndex]];
+            CHECK(visible[evictedBlocks[reloadIndex]]);
+            block.Reloading  = true;
+            block.ReadyFrame = frame + reloadFrames;
+            ++reloadCount;
+        }
+
+        // Evict least recently used content past the budget
+        std::vector<ResidentContentInfo> residentInfos;
+        std::vector<uint32_t>            residentBlocks;
+        uint64_t                         residentBytes = 0;
+        for (uint32_t i = 0; i < blockCount; ++i)
+        {
+            if (!blocks[i].Resident)
+                continue;
+
+            residentInfos.push_back({ blocks[i].Bytes, blocks[i].LastUsedFrame, true });
+            residentBlocks.push_back(i);
+            residentBytes += blocks[i].Bytes;
+        }
+
+        bool overBudget = false;
+        const std::vector<size_t> evictOrder = SelectContentToEvict(residentInfos, residentBytes, budget, frame, overBudget);
+        uint64_t oldestKept = UINT64_MAX;
+        for (size_t i = 0; i < residentInfos.size(); ++i)
+        {
+            if (std::find(evictOrder.begin(), evictOrder.end(), i) == evictOrder.end() && residentInfos[i].LastUsedFrame < frame)
+                oldestKept = std::min(oldestKept, residentInfos[i].LastUsedFrame);
+        }
+        for (size_t evictIndex : evictOrder)
+        {
+            Block& block = blocks[residentBlocks[evictIndex]];
+            CHECK(!visible[residentBlocks[evictIndex]]);
+            CHECK(block.LastUsedFrame <= oldestKept);
+            block.Resident = false;
+            residentBytes -= block.Bytes;
+            ++evictCount;
+        }
+
+        everOverBudget   = everOverBudget || overBudget;
+        maxResidentBytes = frame > 1 ? std::max(maxResidentBytes, residentBytes) : maxResidentBytes;
+        CHECK(overBudget || residentBytes <= budget);
+    }
+
+    // The visible set always fits, so the budget holds throughout and content in view is never out for longer than a reload
+    CHECK(!everOverBudget);
+    CHECK(maxResidentBytes <= budget);
+    CHECK(maxResidencyDelay <= reloadFrames);
+
+    // Content is only reloaded when coming back into view, so there's no thrashing
+    CHECK(evictCount > 0);
+    CHECK(reloadCount > 0);
+    CHECK(reloadCount <= viewEntryCount);
+
+    std::printf("camera path: %llu frames, %llu view entries, %llu reloads, %llu evictions, peak resident %llu/%llu units, worst residency delay %llu frames\n",
+                static_cast<unsigned long long>(frameCount), static_cast<unsigned long long>(viewEntryCount), static_cast<unsigned long long>(reloadCount),
+                static_cast<unsigned long long>(evictCount), static_cast<unsigned long long>(maxResidentBytes), static_cast<unsigned long long>(budget),
+                static_cast<unsigned long long>(maxResidencyDelay));
+}
+
+int main()
+{
+    TestReloadOrder();
+    TestEvictOrder();
+    TestCameraPath();
+    return cauldron::test::GetExitCode();
+}
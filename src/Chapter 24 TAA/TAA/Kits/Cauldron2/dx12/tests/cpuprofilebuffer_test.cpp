@@ -0,0 +1,185 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "misc/cpuprofilebuffer.h"
+#include "testing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+using namespace cauldron;
+
+static std::vector<CPUProfileEvent> DrainEvents(CPUProfileBuffer& buffer)
+{
+    std::vector<CPUProfileEvent> events;
+    buffer.Drain([&events](const CPUProfileEvent& event) { events.push_back(event); });
+    return events;
+}
+
+// Captures are recorded as they end, with their nesting depth. Ending a capture also ends the ones nested in it.
+static void TestNesting()
+{
+    static const wchar_t* s_Outer = L"Outer";
+    static const wchar_t* s_Inner = L"Inner";
+    static const wchar_t* s_Lost  = L"Lost";
+
+    CPUProfileBuffer buffer;
+    const uint32_t outer = buffer.Begin(s_Outer);
+    const uint32_t inner = buffer.Begin(s_Inner);
+    CHECK(outer == 0);
+    CHECK(inner == 1);
+    CHECK(buffer.End(inner));
+    buffer.Begin(s_Lost);
+    CHECK(buffer.End(outer));
+    CHECK(buffer.GetDepth() == 0);
+    CHECK(!buffer.End(outer));
+
+    const std::vector<CPUProfileEvent> events = DrainEvents(buffer);
+    CHECK(events.size() == 2);
+    if (events.size() == 2)
+    {
+        CHECK(events[0].pLabel == s_Inner && events[0].Depth == 1);
+        CHECK(events[1].pLabel == s_Outer && events[1].Depth == 0);
+        CHECK(events[0].StartTimestamp >= events[1].StartTimestamp);
+        CHECK(events[0].EndTimestamp <= events[1].EndTimestamp);
+    }
+    CHECK(DrainEvents(buffer).empty());
+}
+
+// Each capture reads its own begin timestamp, so work done between captures isn't attributed to either of them
+static void TestUntimedWork()
+{
+    CPUProfileBuffer buffer;
+    buffer.End(buffer.Begin(L"First"));
+
+    // Untimed work between the two captures
+    const uint64_t untimedStart = ReadCPUTimestamp();
+    while (ReadCPUTimestamp() - untimedStart < 100000)
+        ;
+    const uint64_t untimedEnd = ReadCPUTimestamp();
+
+    const uint32_t parent = buffer.Begin(L"Parent");
+    buffer.End(buffer.Begin(L"Child"));
+    buffer.End(parent);
+
+    const std::vector<CPUProfileEvent> events = DrainEvents(buffer);
+    CHECK(events.size() == 3);
+    if (events.size() == 3)
+    {
+        CHECK(events[0].EndTimestamp <= untimedStart);
+        CHECK(events[2].StartTimestamp >= untimedEnd);                  // Parent begins after the untimed work
+        CHECK(events[1].StartTimestamp >= events[2].StartTimestamp);    // Child is nested in Parent
+        CHECK(events[1].EndTimestamp <= events[2].EndTimestamp);
+    }
+}
+
+// Nothing blocks when the ring is full, captures are dropped and counted instead
+static void TestOverflow()
+{
+    CPUProfileBuffer buffer;
+    for (uint32_t i = 0; i < CPUProfileBuffer::s_Capacity + 10; ++i)
+        buffer.End(buffer.Begin(L"Capture"));
+    CHECK(buffer.GetDroppedCount() == 10);
+    CHECK(DrainEvents(buffer).size() == CPUProfileBuffer::s_Capacity);
+
+    buffer.End(buffer.Begin(L"Capture"));
+    CHECK(DrainEvents(buffer).size() == 1);
+
+    // Captures past the maximum depth still balance out, but aren't recorded
+    std::vector<uint32_t> captures;
+    for (uint32_t i = 0; i < CPUProfileBuffer::s_MaxDepth + 4; ++i)
+        captures.push_back(buffer.Begin(L"Deep"));
+    while (!captures.empty())
+    {
+        CHECK(buffer.End(captures.back()));
+        captures.pop_back();
+    }
+    CHECK(DrainEvents(buffer).size() == CPUProfileBuffer::s_MaxDepth);
+}
+
+// Measures the cost of a capture: runs of sibling captures, and captures each holding a nested one. Reports the
+// best of a few rounds to keep scheduling noise out.
+static void BenchmarkScopes()
+{
+    constexpr uint32_t s_BatchSize  = CPUProfileBuffer::s_Capacity / 2;
+    constexpr uint32_t s_BatchCount = 64;
+    constexpr uint32_t s_RoundCount = 5;
+
+    CPUProfileBuffer buffer;
+    uint64_t         checksum = 0;
+    auto drain = [&buffer, &checksum]() {
+        buffer.Drain([&checksum](const CPUProfileEvent& event) { checksum += event.EndTimestamp - event.StartTimestamp; });
+    };
+
+    auto measure = [&](auto recordBatch) {
+        double bestNanoseconds = 1e30;
+        for (uint32_t round = 0; round < s_RoundCount; ++round)
+        {
+            std::chrono::steady_clock::duration elapsed(0);
+            for (uint32_t batch = 0; batch < s_BatchCount; ++batch)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                recordBatch();
+                elapsed += std::chrono::steady_clock::now() - start;
+                drain();
+            }
+            const double nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count() / (static_cast<double>(s_BatchSize) * s_BatchCount);
+            bestNanoseconds = std::min(bestNanoseconds, nanoseconds);
+        }
+        return bestNanoseconds;
+    };
+
+    const double siblingNanoseconds = measure([&buffer]() {
+        for (uint32_t i = 0; i < s_BatchSize; ++i)
+            buffer.End(buffer.Begin(L"Sibling"));
+    });
+
+    const double nestedNanoseconds = measure([&buffer]() {
+        for (uint32_t i = 0; i < s_BatchSize; i += 2)
+        {
+            const uint32_t parent = buffer.Begin(L"Parent");
+            buffer.End(buffer.Begin(L"Child"));
+            buffer.End(parent);
+        }
+    });
+
+    // Reference: reading the timestamp counter alone
+    const double timestampNanoseconds = measure([&checksum]() {
+        for (uint32_t i = 0; i < s_BatchSize; ++i)
+            checksum += ReadCPUTimestamp();
+    });
+
+    CHECK(buffer.GetDroppedCount() == 0);
+    std::printf("capture cost: %.1f ns per sibling capture, %.1f ns per nested capture, %.1f ns per timestamp read (checksum %llu)\n",
+                siblingNanoseconds, nestedNanoseconds, timestampNanoseconds, static_cast<unsigned long long>(checksum & 0xff));
+}
+
+int main()
+{
+    TestNesting();
+    TestUntimedWork();
+    TestOverflow();
+    BenchmarkScopes();
+    return cauldron::test::GetExitCode();
+}
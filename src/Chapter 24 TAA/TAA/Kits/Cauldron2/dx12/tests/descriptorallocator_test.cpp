@@ -0,0 +1,295 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "misc/descriptorallocator.h"
+#include "testing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace cauldron;
+
+// Naive first-fit model of a descriptor heap
+class FirstFitModel
+{
+public:
+    FirstFitModel(uint32_t capacity) : m_Used(capacity, false) {}
+
+    bool Allocate(uint32_t count, uint32_t& index)
+    {
+        uint32_t run = 0;
+        for (uint32_t i = 0; i < m_Used.size(); ++i)
+        {
+            run = m_Used[i] ? 0 : run + 1;
+            if (run == count)
+            {
+                index = i + 1 - count;
+                std::fill(m_Used.begin() + index, m_Used.begin() + index + count, true);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Free(uint32_t index, uint32_t count) { std::fill(m_Used.begin() + index, m_Used.begin() + index + count, false); }
+
+    uint32_t GetAllocatedCount() const { return static_cast<uint32_t>(std::count(m_Used.begin(), m_Used.end(), true)); }
+
+    uint32_t GetLargestFreeRange() const
+    {
+        uint32_t run = 0, largest = 0;
+        for (bool used : m_Used)
+        {
+            run     = used ? 0 : run + 1;
+            largest = std::max(largest, run);
+        }
+        return largest;
+    }
+
+private:
+    std::vector<bool> m_Used;
+};
+
+using DescriptorRange = std::pair<uint32_t, uint32_t>;
+
+// Freed descriptors only come back once the fence of the frame they were freed in has completed
+static void TestDeferredRecycling()
+{
+    DescriptorAllocator allocator(64);
+
+    uint32_t index = 0;
+    CHECK(allocator.Allocate(64, index) && index == 0);
+    CHECK(!allocator.Allocate(2, index));
+    CHECK(allocator.GetAllocatedCount() == 64);
+
+    allocator.Free(8, 4);
+    CHECK(!allocator.Allocate(2, index));
+    allocator.EndFrame(1);
+    allocator.Retire(0);
+    CHECK(!allocator.Allocate(2, index));
+    CHECK(allocator.GetAllocatedCount() == 64);
+
+    allocator.Retire(1);
+    CHECK(allocator.GetAllocatedCount() == 60);
+    CHECK(allocator.GetLargestFreeRange() == 4);
+    CHECK(allocator.Allocate(4, index) && index == 8);
+    CHECK(allocator.GetLargestFreeRange() == 0);
+
+    // Frames without frees don't hold up later ones
+    allocator.EndFrame(2);
+    allocator.Free(0, 1);
+    allocator.EndFrame(3);
+    allocator.Retire(3);
+    CHECK(allocator.GetAllocatedCount() == 63);
+}
+
+// Range allocations match a first-fit model through random allocate, free and retire sequences
+static void TestRangesMatchModel()
+{
+    std::mt19937 generator(123);
+    for (uint32_t capacity : { 1u, 63u, 64u, 65u, 1000u, 4096u, 10000u, 300000u })
+    {
+        DescriptorAllocator allocator(capacity);
+        FirstFitModel       model(capacity);
+
+        std::vector<DescriptorRange>                                  liveRanges;
+        std::vector<DescriptorRange>                                  pendingRanges;
+        std::deque<std::pair<uint64_t, std::vector<DescriptorRange>>> retiringFrames;
+        uint64_t                                                      fenceValue = 0;
+
+        const int32_t iterationCount = capacity > 100000 ? 3000 : 20000;
+        for (int32_t iteration = 0; iteration < iterationCount; ++iteration)
+        {
+            const uint32_t operation = generator() % 10;
+            if (operation < 6)
+            {
+                // Single descriptors go through the thread caches, so only ranges can be compared with the model
+                const uint32_t count = 2 + generator() % ((generator() % 4 == 0) ? 300 : 40);
+                uint32_t index = 0, modelIndex = 0;
+                const bool allocated = allocator.Allocate(count, index);
+                CHECK(allocated == model.Allocate(count, modelIndex));
+                if (allocated)
+                {
+                    CHECK(index == modelIndex);
+                    liveRanges.push_back({ index, count });
+                }
+            }
+            else if (operation < 9 && !liveRanges.empty())
+            {
+                const size_t slot = generator() % liveRanges.size();
+                allocator.Free(liveRanges[slot].first, liveRanges[slot].second);
+                pendingRanges.push_back(liveRanges[slot]);
+                liveRanges[slot] = liveRanges.back();
+                liveRanges.pop_back();
+            }
+            else
+            {
+                // The GPU runs two frames behind
+                allocator.EndFrame(++fenceValue);
+                if (!pendingRanges.empty())
+                    retiringFrames.push_back({ fenceValue, std::move(pendingRanges) });
+                pendingRanges.clear();
+
+                const uint64_t completedFenceValue = fenceValue >= 2 ? fenceValue - 2 : 0;
+                allocator.Retire(completedFenceValue);
+                while (!retiringFrames.empty() && retiringFrames.front().first <= completedFenceValue)
+                {
+                    for (const DescriptorRange& range : retiringFrames.front().second)
+                        model.Free(range.first, range.second);
+                    retiringFrames.pop_front();
+                }
+            }
+
+            if (iteration % 97 == 0)
+            {
+                CHECK(allocator.GetLargestFreeRange() == model.GetLargestFreeRange());
+                CHECK(allocator.GetAllocatedCount() == model.GetAllocatedCount());
+            }
+        }
+    }
+}
+
+// Threads mixing single descriptor and range allocations never get overlapping descriptors
+static void TestMultiThreadedAllocations()
+{
+    constexpr uint32_t s_Capacity    = 200000;
+    constexpr uint32_t s_ThreadCount = 8;
+
+    DescriptorAllocator               allocator(s_Capacity);
+    std::vector<std::atomic_uint32_t> owners(s_Capacity);
+    for (std::atomic_uint32_t& owner : owners)
+        owner = 0;
+
+    std::atomic_uint32_t     failureCount = { 0 };
+    std::vector<std::thread> threads;
+    for (uint32_t threadIndex = 0; threadIndex < s_ThreadCount; ++threadIndex)
+    {
+        threads.emplace_back([&, threadIndex]() {
+            std::mt19937 generator(threadIndex);
+            for (int32_t i = 0; i < 2000; ++i)
+            {
+                const uint32_t count = (generator() % 3) ? 1 : 1 + generator() % 20;
+                uint32_t       index = 0;
+                if (!allocator.Allocate(count, index))
+                {
+                    ++failureCount;
+                    return;
+                }
+
+                for (uint32_t j = 0; j < count; ++j)
+                {
+                    if (owners[index + j].exchange(threadIndex + 1) != 0)
+                        ++failureCount;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    CHECK(failureCount == 0);
+}
+
+// Times single descriptor and small range allocations in a fragmented heap
+static void BenchmarkAllocations()
+{
+    constexpr uint32_t s_Capacity         = 1000000;
+    constexpr uint32_t s_SingleAllocCount = 200000;
+    constexpr uint32_t s_RangeAllocCount  = 20000;
+
+    DescriptorAllocator allocator(s_Capacity);
+    std::mt19937        generator(5);
+    uint32_t            index = 0;
+
+    // Fill the heap with small ranges and free every other one
+    std::vector<DescriptorRange> ranges;
+    for (;;)
+    {
+        const uint32_t count = 1 + generator() % 8;
+        if (!allocator.Allocate(count, index))
+            break;
+        ranges.push_back({ index, count });
+    }
+    for (size_t i = 0; i < ranges.size(); i += 2)
+        allocator.Free(ranges[i].first, ranges[i].second);
+    allocator.EndFrame(1);
+    allocator.Retire(1);
+
+    uint32_t   singleCount = 0;
+    const auto singleStart = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < s_SingleAllocCount; ++i)
+        singleCount += allocator.Allocate(1, index) ? 1 : 0;
+    const double singleNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - singleStart).count() / s_SingleAllocCount;
+
+    uint32_t   rangeCount = 0;
+    const auto rangeStart = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < s_RangeAllocCount; ++i)
+        rangeCount += allocator.Allocate(4, index) ? 1 : 0;
+    const double rangeNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - rangeStart).count() / s_RangeAllocCount;
+    CHECK(singleCount == s_SingleAllocCount);
+
+    std::printf("fragmented %u descriptor heap: single descriptor %.1f ns per allocation, 4 descriptor range %.1f ns per allocation (%u succeeded)\n",
+                s_Capacity, singleNanoseconds, rangeNanoseconds, rangeCount);
+
+    // Parallel single descriptor allocations
+    for (uint32_t threadCount : { 1u, 4u, 8u })
+    {
+        constexpr uint32_t s_AllocsPerThread = 100000;
+
+        // Leave room for descriptors sitting unused in other threads' caches
+        DescriptorAllocator      threadAllocator(2 * s_AllocsPerThread * threadCount);
+        std::atomic_uint32_t     allocatedCount = { 0 };
+        std::vector<std::thread> threads;
+        const auto threadStart = std::chrono::steady_clock::now();
+        for (uint32_t t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&]() {
+                uint32_t threadIndex = 0, count = 0;
+                for (uint32_t i = 0; i < s_AllocsPerThread; ++i)
+                    count += threadAllocator.Allocate(1, threadIndex) ? 1 : 0;
+                allocatedCount += count;
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        const double threadNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - threadStart).count() / (static_cast<double>(s_AllocsPerThread) * threadCount);
+
+        CHECK(allocatedCount == s_AllocsPerThread * threadCount);
+        std::printf("%u thread(s): %.1f ns per single descriptor allocation (wall time over all allocations)\n", threadCount, threadNanoseconds);
+    }
+}
+
+int main()
+{
+    TestDeferredRecycling();
+    TestRangesMatchModel();
+    TestMultiThreadedAllocations();
+    BenchmarkAllocations();
+    return cauldron::test::GetExitCode();
+}
@@ -0,0 +1,283 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "misc/frameringallocator.h"
+#include "testing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace cauldron;
+
+// Allocations bump through the thread's chunk, large ones get chunks of their own, and memory comes back once the
+// fence of the frame it was allocated in completes
+static void TestAllocateRetire()
+{
+    FrameRingAllocator allocator(16 * 1024, 1024);
+    CHECK(allocator.GetChunkCount() == 16);
+
+    uint32_t first, second, third, fourth, large;
+    CHECK(allocator.Allocate(100, 256, first));
+    CHECK(allocator.Allocate(100, 16, second));
+    CHECK(second == first + 112);
+    CHECK(allocator.Allocate(256, 256, third));
+    CHECK(third == first + 256);
+    CHECK(allocator.Allocate(512, 256, third));
+    CHECK(third == first + 512);
+    CHECK(allocator.Allocate(256, 256, fourth));
+    CHECK(fourth / 1024 != first / 1024);   // Didn't fit in the chunk anymore
+    CHECK(allocator.Allocate(3000, 256, large));
+    CHECK(large % 1024 == 0);
+    CHECK(allocator.GetUsedSize() == 5 * 1024);
+
+    // Fill the ring up
+    allocator.EndFrame(1);
+    uint32_t offset;
+    uint32_t frameAllocations = 0;
+    while (allocator.Allocate(1024, 256, offset))
+        ++frameAllocations;
+    CHECK(frameAllocations == 11);
+    allocator.EndFrame(2);
+
+    // Nothing comes back until the frame's fence completes
+    allocator.Retire(0);
+    CHECK(!allocator.Allocate(1024, 256, offset));
+    allocator.Retire(1);
+    CHECK(allocator.GetUsedSize() == 11 * 1024);
+    CHECK(allocator.Allocate(1024, 256, offset));
+    allocator.EndFrame(3);
+    allocator.Retire(3);
+    CHECK(allocator.GetUsedSize() == 0);
+
+    // Runs of chunks don't wrap around the end of the ring, they skip to its start
+    CHECK(allocator.Allocate(8 * 1024, 256, offset));
+    CHECK(offset == 1024);
+    CHECK(!allocator.Allocate(8 * 1024, 256, offset));
+    allocator.EndFrame(4);
+    allocator.Retire(4);
+    CHECK(allocator.Allocate(8 * 1024, 256, offset));
+    CHECK(offset == 0);
+    CHECK(!allocator.Allocate(17 * 1024, 256, offset));
+}
+
+// Frame thread and worker threads take turns: the workers allocate for a frame, then the frame thread closes it
+class FrameBarrier
+{
+public:
+    explicit FrameBarrier(uint32_t workerCount) : m_WorkerCount(workerCount) {}
+
+    // Frame thread: starts a frame and waits for the workers to be done with it. Returns false once stopped.
+    void RunFrame(uint64_t frame)
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Frame     = frame;
+        m_DoneCount = 0;
+        m_Condition.notify_all();
+        m_Condition.wait(lock, [this] { return m_DoneCount == m_WorkerCount; });
+    }
+
+    void Stop()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Frame = UINT64_MAX;
+        m_Condition.notify_all();
+    }
+
+    // Workers: waits for the next frame
+    uint64_t WaitForFrame(uint64_t lastFrame)
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Condition.wait(lock, [this, lastFrame] { return m_Frame != lastFrame; });
+        return m_Frame;
+    }
+
+    void FinishFrame()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (++m_DoneCount == m_WorkerCount)
+            m_Condition.notify_all();
+    }
+
+private:
+    std::mutex              m_Mutex;
+    std::condition_variable m_Condition;
+    const uint32_t          m_WorkerCount;
+    uint32_t                m_DoneCount = 0;
+    uint64_t                m_Frame     = 0;
+};
+
+struct StressResults
+{
+    uint64_t AllocationCount = 0;
+    uint64_t FailureCount    = 0;
+    uint64_t ReuseErrorCount = 0;
+    uint64_t MaxUsedSize     = 0;
+};
+
+// Several threads allocate every frame while the GPU lags 1 to 3 frames behind. Every 256B granule handed out is
+// tagged with the fence of the frame it was allocated in, handing it out again while that fence hasn't completed
+// means memory the GPU may still read got overwritten. retireEarly retires frames as soon as they are closed, to
+// check that this is caught.
+static StressResults RunFrameStress(uint64_t frameCount, uint32_t ringSize, bool retireEarly)
+{
+    constexpr uint32_t s_Granularity = 256;
+    constexpr uint32_t s_ThreadCount = 8;
+
+    FrameRingAllocator                 allocator(ringSize, 64 * 1024);
+    std::vector<std::atomic_uint64_t>  granuleFences(ringSize / s_Granularity);
+    std::atomic_uint64_t               completedFence(0);
+    std::atomic_uint64_t               reuseErrorCount(0);
+    std::atomic_uint64_t               allocationCount(0);
+    std::atomic_uint64_t               failureCount(0);
+    FrameBarrier                       barrier(s_ThreadCount);
+
+    std::vector<std::thread> threads;
+    for (uint32_t thread = 0; thread < s_ThreadCount; ++thread)
+    {
+        threads.emplace_back([&, thread]() {
+            std::mt19937 random(thread);
+            for (uint64_t frame = barrier.WaitForFrame(0); frame != UINT64_MAX; frame = barrier.WaitForFrame(frame))
+            {
+                // Frame N is closed with fence N
+                const uint32_t count = 20 + random() % 40;
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    // Mostly constant buffer sized allocations, with the odd large vertex buffer
+                    const uint32_t size = (random() % 16) ? 256 * (1 + random() % 8) : 32 * 1024 + random() % (96 * 1024);
+                    uint32_t       offset;
+                    if (!allocator.Allocate(size, s_Granularity, offset))
+                    {
+                        ++failureCount;
+                        continue;
+                    }
+
+                    ++allocationCount;
+                    for (uint32_t granule = offset / s_Granularity; granule < (offset + size + s_Granularity - 1) / s_Granularity; ++granule)
+                    {
+                        if (granuleFences[granule].exchange(frame) > completedFence.load())
+                            ++reuseErrorCount;
+                    }
+                }
+                barrier.FinishFrame();
+            }
+        });
+    }
+
+    // The simulated GPU completes frames in order, 1 to 3 frames behind
+    std::mt19937         random(1234);
+    std::deque<uint64_t> inFlightFences;
+    StressResults        results;
+    for (uint64_t frame = 1; frame <= frameCount; ++frame)
+    {
+        barrier.RunFrame(frame);
+        results.MaxUsedSize = std::max(results.MaxUsedSize, allocator.GetUsedSize());
+
+        allocator.EndFrame(frame);
+        inFlightFences.push_back(frame);
+        const uint32_t latency = 1 + random() % 3;
+        while (inFlightFences.size() > latency)
+        {
+            completedFence = inFlightFences.front();
+            inFlightFences.pop_front();
+        }
+        allocator.Retire(retireEarly ? frame : completedFence.load());
+    }
+    barrier.Stop();
+    for (std::thread& thread : threads)
+        thread.join();
+
+    allocator.Retire(frameCount);
+    CHECK(allocator.GetUsedSize() == 0);
+
+    results.AllocationCount = allocationCount;
+    results.FailureCount    = failureCount;
+    results.ReuseErrorCount = reuseErrorCount;
+    return results;
+}
+
+static void TestMultiThreadedStress()
+{
+    const StressResults results = RunFrameStress(3000, 16 << 20, false);
+    CHECK(results.ReuseErrorCount == 0);
+    CHECK(results.FailureCount < results.AllocationCount / 100);
+    std::printf("stress: 3000 frames, 8 threads, %llu allocations, %llu failed, peak in flight %llu KB, %llu early reuses\n",
+                static_cast<unsigned long long>(results.AllocationCount), static_cast<unsigned long long>(results.FailureCount),
+                static_cast<unsigned long long>(results.MaxUsedSize / 1024), static_cast<unsigned long long>(results.ReuseErrorCount));
+
+    // Make sure the check above would catch memory reused while the GPU may still read it (a smaller ring wraps
+    // around within the GPU latency)
+    CHECK(RunFrameStress(200, 8 << 20, true).ReuseErrorCount > 0);
+}
+
+// Measures the cost of an allocation on a single thread and with every thread allocating at once
+static void BenchmarkAllocations()
+{
+    constexpr uint32_t s_AllocationsPerFrame = 4096;
+    constexpr uint32_t s_FrameCount          = 200;
+
+    for (uint32_t threadCount : { 1u, 4u })
+    {
+        FrameRingAllocator allocator(64 << 20, 64 * 1024);
+        std::chrono::steady_clock::duration elapsed(0);
+        for (uint32_t frame = 1; frame <= s_FrameCount; ++frame)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads;
+            for (uint32_t thread = 1; thread < threadCount; ++thread)
+            {
+                threads.emplace_back([&allocator]() {
+                    uint32_t offset;
+                    for (uint32_t i = 0; i < s_AllocationsPerFrame; ++i)
+                        allocator.Allocate(256, 256, offset);
+                });
+            }
+            uint32_t offset;
+            for (uint32_t i = 0; i < s_AllocationsPerFrame; ++i)
+                allocator.Allocate(256, 256, offset);
+            for (std::thread& thread : threads)
+                thread.join();
+            elapsed += std::chrono::steady_clock::now() - start;
+
+            allocator.EndFrame(frame);
+            allocator.Retire(frame);
+        }
+
+        const double nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count() / (static_cast<double>(s_AllocationsPerFrame) * s_FrameCount * threadCount);
+        std::printf("allocation cost: %.1f ns per allocation with %u thread(s) (including thread startup)\n", nanoseconds, threadCount);
+    }
+}
+
+int main()
+{
+    TestAllocateRetire();
+    TestMultiThreadedStress();
+    BenchmarkAllocations();
+    return cauldron::test::GetExitCode();
+}
@@ -0,0 +1,139 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "misc/hash.h"
+#include "testing.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace cauldron;
+
+struct KnownAnswer
+{
+    size_t   Length;
+    uint64_t Seed;
+    uint64_t Hash;
+};
+
+// Reference XXH64 values of the xxHash sanity check buffer, for lengths covering the short input paths, the
+// 32-byte stripe loop and the tail handling, at seeds 0, PRIME32 and a full 64-bit seed
+static const KnownAnswer s_KnownAnswers[] = {
+    {    0, 0x0000000000000000ull, 0xEF46DB3751D8E999ull },
+    {    1, 0x0000000000000000ull, 0xE934A84ADB052768ull },
+    {    3, 0x0000000000000000ull, 0xFF7E1959CB50794Aull },
+    {    4, 0x0000000000000000ull, 0x9136A0DCA57457EEull },
+    {    7, 0x0000000000000000ull, 0x6C83909A9F01ED25ull },
+    {    8, 0x0000000000000000ull, 0xCDBCF538E71D1348ull },
+    {   14, 0x0000000000000000ull, 0x8282DCC4994E35C8ull },
+    {   31, 0x0000000000000000ull, 0x299B39A290E6D783ull },
+    {   32, 0x0000000000000000ull, 0x18B216492BB44B70ull },
+    {   33, 0x0000000000000000ull, 0x55C8DC3E578F5B59ull },
+    {   63, 0x0000000000000000ull, 0xA9EFBE0FA0F3F4E7ull },
+    {   64, 0x0000000000000000ull, 0xEF558F8ACAC2B5CDull },
+    {  100, 0x0000000000000000ull, 0x4BFE019CD91D9EA4ull },
+    {  222, 0x0000000000000000ull, 0xB641AE8CB691C174ull },
+    { 1024, 0x0000000000000000ull, 0x4775BF7CACE4D177ull },
+    { 2367, 0x0000000000000000ull, 0xA82418DDEC0EA581ull },
+    {    0, 0x000000009E3779B1ull, 0xAC75FDA2929B17EFull },
+    {    1, 0x000000009E3779B1ull, 0x5014607643A9B4C3ull },
+    {    3, 0x000000009E3779B1ull, 0xAA8584E83660F7D1ull },
+    {    4, 0x000000009E3779B1ull, 0xCAAB286BD8E9FDB5ull },
+    {    7, 0x000000009E3779B1ull, 0xF98D03B1AD6F9293ull },
+    {    8, 0x000000009E3779B1ull, 0xFE0C047A5353CDACull },
+    {   14, 0x000000009E3779B1ull, 0xC3BD6BF63DEB6DF0ull },
+    {   31, 0x000000009E3779B1ull, 0xDA673D5FEB5C1D79ull },
+    {   32, 0x000000009E3779B1ull, 0xB3F33BDF93ADE409ull },
+    {   33, 0x000000009E3779B1ull, 0xE92C292F64BC3071ull },
+    {   63, 0x000000009E3779B1ull, 0x6C911FADB05B6FC2ull },
+    {   64, 0x000000009E3779B1ull, 0xB5EEBA99264CC44Full },
+    {  100, 0x000000009E3779B1ull, 0x4853706DC9625CAEull },
+    {  222, 0x000000009E3779B1ull, 0x20CB8AB7AE10C14Aull },
+    { 1024, 0x000000009E3779B1ull, 0x238CF9296898B465ull },
+    { 2367, 0x000000009E3779B1ull, 0xA36A93C18052673Aull },
+    {    0, 0x9E3779B185EBCA87ull, 0x6EC6D05F61C7E7A7ull },
+    {    1, 0x9E3779B185EBCA87ull, 0x60508B0CED72C717ull },
+    {    3, 0x9E3779B185EBCA87ull, 0xB7C97337300AA844ull },
+    {    4, 0x9E3779B185EBCA87ull, 0x05C571D4638902D1ull },
+    {    7, 0x9E3779B185EBCA87ull, 0x88566A55A29C05F5ull },
+    {    8, 0x9E3779B185EBCA87ull, 0xC9BAE69468995DD2ull },
+    {   14, 0x9E3779B185EBCA87ull, 0x8439F25BB2594BEBull },
+    {   31, 0x9E3779B185EBCA87ull, 0xD5B2DBBFA83B0B60ull },
+    {   32, 0x9E3779B185EBCA87ull, 0xAAFEF1645D1B13D9ull },
+    {   33, 0x9E3779B185EBCA87ull, 0x07493C92A23A6825ull },
+    {   63, 0x9E3779B185EBCA87ull, 0x626845AEEA2BFC12ull },
+    {   64, 0x9E3779B185EBCA87ull, 0x97973ADE8B590FE4ull },
+    {  100, 0x9E3779B185EBCA87ull, 0xC14DD279D7809C6Aull },
+    {  222, 0x9E3779B185EBCA87ull, 0x44398F91204414A4ull },
+    { 1024, 0x9E3779B185EBCA87ull, 0x4B9336BE8B2E8CFCull },
+    { 2367, 0x9E3779B185EBCA87ull, 0x724217F2A3A5C3A4ull },
+};
+
+// The xxHash sanity check buffer
+static std::vector<uint8_t> CreateSanityBuffer(size_t length)
+{
+    std::vector<uint8_t> buffer(length);
+    uint64_t byteGenerator = 2654435761u;
+    for (uint8_t& byte : buffer)
+    {
+        byte = static_cast<uint8_t>(byteGenerator >> 56);
+        byteGenerator *= 11400714785074694797ull;
+    }
+    return buffer;
+}
+
+static void TestKnownAnswers()
+{
+    const std::vector<uint8_t> buffer = CreateSanityBuffer(2367);
+    for (const KnownAnswer& answer : s_KnownAnswers)
+    {
+        const uint64_t hash = HashData64(buffer.data(), answer.Length, answer.Seed);
+        if (hash != answer.Hash)
+            std::fprintf(stderr, "XXH64 of %zu bytes with seed 0x%llx: got 0x%016llx, expected 0x%016llx\n", answer.Length,
+                         static_cast<unsigned long long>(answer.Seed), static_cast<unsigned long long>(hash), static_cast<unsigned long long>(answer.Hash));
+        CHECK(hash == answer.Hash);
+    }
+
+    CHECK(HashData64("abc", 3) == 0x44BC2CF5AD770999ull);
+    CHECK(HashData64(nullptr, 0) == 0xEF46DB3751D8E999ull);
+}
+
+// The hash doesn't depend on the alignment of the data
+static void TestUnalignedData()
+{
+    const std::vector<uint8_t> buffer = CreateSanityBuffer(2367);
+    std::vector<uint8_t>       shifted(buffer.size() + 8);
+    for (size_t offset = 1; offset < 8; ++offset)
+    {
+        std::memcpy(shifted.data() + offset, buffer.data(), buffer.size());
+        for (size_t length : { size_t(7), size_t(33), size_t(222), buffer.size() })
+            CHECK(HashData64(shifted.data() + offset, length, 0) == HashData64(buffer.data(), length, 0));
+    }
+}
+
+int main()
+{
+    TestKnownAnswers();
+    TestUnalignedData();
+    return cauldron::test::GetExitCode();
+}
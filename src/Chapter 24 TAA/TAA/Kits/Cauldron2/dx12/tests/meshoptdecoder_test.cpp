@@ -0,0 +1,284 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "core/loaders/meshoptdecoder.h"
+#include "testing.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace cauldron;
+
+// Reference streams and their decoded output, from the codec tests of meshoptimizer (encoded by its reference encoder)
+
+struct PackedVertex
+{
+    uint16_t px, py, pz;
+    uint8_t  nu, nv;
+    uint16_t tx, ty;
+};
+
+static const PackedVertex s_VertexBuffer[] = {
+    {   0,   0, 0, 0, 0,   0,   0 },
+    { 300,   0, 0, 0, 0, 500,   0 },
+    {   0, 300, 0, 0, 0,   0, 500 },
+    { 300, 300, 0, 0, 0, 500, 500 },
+};
+
+static const uint8_t s_VertexData[] = {
+    0xa0, 0x01, 0x3f, 0x00, 0x00, 0x00, 0x58, 0x57, 0x58, 0x01, 0x26, 0x00, 0x00, 0x00, 0x01,
+    0x0c, 0x00, 0x00, 0x00, 0x58, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+    0x3f, 0x00, 0x00, 0x00, 0x17, 0x18, 0x17, 0x01, 0x26, 0x00, 0x00, 0x00, 0x01, 0x0c, 0x00,
+    0x00, 0x00, 0x17, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const uint32_t s_IndexBuffer[] = { 0, 1, 2, 2, 1, 3, 4, 6, 5, 7, 8, 9 };
+
+static const uint8_t s_IndexDataV0[] = {
+    0xe0, 0xf0, 0x10, 0xfe, 0xff, 0xf0, 0x0c, 0xff, 0x02, 0x02, 0x02, 0x00, 0x76, 0x87, 0x56, 0x67,
+    0x78, 0xa9, 0x86, 0x65, 0x89, 0x68, 0x98, 0x01, 0x69, 0x00, 0x00,
+};
+
+// Exercises restarts (0 1 2) and the last index +/- 1 codes of version 1
+static const uint32_t s_IndexBufferV1[] = { 0, 1, 2, 2, 1, 3, 0, 1, 2, 2, 1, 5, 2, 1, 4 };
+
+static const uint8_t s_IndexDataV1[] = {
+    0xe1, 0xf0, 0x10, 0xfe, 0x1f, 0x3d, 0x00, 0x0a, 0x00, 0x76, 0x87, 0x56, 0x67, 0x78, 0xa9, 0x86,
+    0x65, 0x89, 0x68, 0x98, 0x01, 0x69, 0x00, 0x00,
+};
+
+static const uint32_t s_IndexSequence[] = { 0, 1, 51, 2, 49, 1000 };
+
+static const uint8_t s_IndexSequenceData[] = {
+    0xd1, 0x00, 0x04, 0xcd, 0x01, 0x04, 0x07, 0x98, 0x1f, 0x00, 0x00, 0x00, 0x00,
+};
+
+// Encodes a vertex buffer with the vertex codec, picking the smallest encoding for each byte group. Only used to
+// round trip buffers large enough to go through the 16-wide delta decoding and span several blocks.
+static std::vector<uint8_t> EncodeVertexBuffer(const uint8_t* pVertices, size_t vertexCount, size_t vertexSize)
+{
+    std::vector<uint8_t> encoded = { 0xa0 };
+
+    // Block size as the decoder computes it
+    size_t blockSize = (8192 / vertexSize) & ~size_t(15);
+    blockSize = blockSize < 256 ? blockSize : 256;
+
+    std::vector<uint8_t> lastVertex(pVertices, pVertices + vertexSize);
+    for (size_t vertexOffset = 0; vertexOffset < vertexCount; vertexOffset += blockSize)
+    {
+        const size_t blockCount   = vertexOffset + blockSize < vertexCount ? blockSize : vertexCount - vertexOffset;
+        const size_t alignedCount = (blockCount + 15) & ~size_t(15);
+        for (size_t k = 0; k < vertexSize; ++k)
+        {
+            // Zigzag encoded deltas of the byte over the block
+            std::vector<uint8_t> deltas(alignedCount, 0);
+            for (size_t i = 0; i < blockCount; ++i)
+            {
+                const uint8_t value = pVertices[(vertexOffset + i) * vertexSize + k];
+                const uint8_t delta = static_cast<uint8_t>(value - lastVertex[k]);
+                deltas[i]     = static_cast<uint8_t>((delta << 1) ^ (static_cast<int8_t>(delta) >> 7));
+                lastVertex[k] = value;
+            }
+
+            const size_t headerOffset = encoded.size();
+            encoded.resize(encoded.size() + (alignedCount / 16 + 3) / 4, 0);
+            for (size_t group = 0; group < alignedCount / 16; ++group)
+            {
+                const uint8_t* pGroup = deltas.data() + group * 16;
+
+                // Size of the group with 0, 2, 4 and 8 bits per value (values that don't fit are stored in full)
+                size_t sizes[4] = { 0, 4, 8, 16 };
+                for (size_t i = 0; i < 16; ++i)
+                {
+                    sizes[0] += pGroup[i] ? 16 : 0;
+                    sizes[1] += pGroup[i] >= 3;
+                    sizes[2] += pGroup[i] >= 15;
+                }
+                int bitsLog2 = 0;
+                for (int mode = 1; mode < 4; ++mode)
+                    bitsLog2 = sizes[mode] < sizes[bitsLog2] ? mode : bitsLog2;
+
+                encoded[headerOffset + group / 4] |= static_cast<uint8_t>(bitsLog2 << ((group % 4) * 2));
+                if (bitsLog2 == 3)
+                {
+                    encoded.insert(encoded.end(), pGroup, pGroup + 16);
+                }
+                else if (bitsLog2 != 0)
+                {
+                    const uint32_t       bits     = 1u << bitsLog2;
+                    const uint8_t        sentinel = static_cast<uint8_t>((1u << bits) - 1);
+                    std::vector<uint8_t> escaped;
+                    for (size_t i = 0; i < 16; i += 8 / bits)
+                    {
+                        uint8_t packed = 0;
+                        for (size_t j = 0; j < 8 / bits; ++j)
+                        {
+                            const uint8_t value = pGroup[i + j] >= sentinel ? sentinel : pGroup[i + j];
+                            packed = static_cast<uint8_t>((packed << bits) | value);
+                            if (value == sentinel)
+                                escaped.push_back(pGroup[i + j]);
+                        }
+                        encoded.push_back(packed);
+                    }
+                    encoded.insert(encoded.end(), escaped.begin(), escaped.end());
+                }
+            }
+        }
+    }
+
+    // The tail holds the first vertex, the baseline of the first deltas
+    const size_t tailSize = vertexSize < 32 ? 32 : vertexSize;
+    encoded.resize(encoded.size() + tailSize - vertexSize, 0);
+    encoded.insert(encoded.end(), pVertices, pVertices + vertexSize);
+    return encoded;
+}
+
+// Decodes the reference vertex stream and rejects truncated or invalid ones
+static void TestVertexReference()
+{
+    PackedVertex decoded[4];
+    CHECK(DecodeMeshoptVertexBuffer(decoded, 4, sizeof(PackedVertex), s_VertexData, sizeof(s_VertexData)));
+    CHECK(memcmp(decoded, s_VertexBuffer, sizeof(s_VertexBuffer)) == 0);
+
+    CHECK(!DecodeMeshoptVertexBuffer(decoded, 4, sizeof(PackedVertex), s_VertexData, sizeof(s_VertexData) - 1));
+    CHECK(!DecodeMeshoptVertexBuffer(decoded, 4, 10, s_VertexData, sizeof(s_VertexData)));
+
+    std::vector<uint8_t> badHeader(s_VertexData, s_VertexData + sizeof(s_VertexData));
+    badHeader[0] = 0xa1;
+    CHECK(!DecodeMeshoptVertexBuffer(decoded, 4, sizeof(PackedVertex), badHeader.data(), badHeader.size()));
+}
+
+// Round trips vertex buffers through several blocks, with smooth, noisy and constant bytes so every group encoding is used
+static void TestVertexRoundTrip()
+{
+    for (size_t vertexSize : { 4u, 16u, 64u })
+    {
+        for (size_t vertexCount : { 1u, 17u, 1000u, 5000u })
+        {
+            std::vector<uint8_t> vertices(vertexCount * vertexSize);
+            uint32_t             noise = 12345;
+            for (size_t i = 0; i < vertexCount; ++i)
+            {
+                for (size_t k = 0; k < vertexSize; ++k)
+                {
+                    noise = noise * 1664525u + 1013904223u;
+                    uint8_t value = 0;
+                    switch (k % 4)
+                    {
+                    case 0: value = static_cast<uint8_t>(i); break;                       // Small deltas
+                    case 1: value = static_cast<uint8_t>(i * 7 + (noise >> 30)); break;   // Mid-sized deltas
+                    case 2: value = static_cast<uint8_t>(noise >> 24); break;             // Random
+                    case 3: value = static_cast<uint8_t>(k); break;                       // Constant
+                    }
+                    vertices[i * vertexSize + k] = value;
+                }
+            }
+
+            const std::vector<uint8_t> encoded = EncodeVertexBuffer(vertices.data(), vertexCount, vertexSize);
+            std::vector<uint8_t>       decoded(vertices.size());
+            CHECK(DecodeMeshoptVertexBuffer(decoded.data(), vertexCount, vertexSize, encoded.data(), encoded.size()));
+            CHECK(decoded == vertices);
+        }
+    }
+}
+
+// Decodes the reference index streams to 16 and 32-bit indices
+static void TestIndexBuffer()
+{
+    uint32_t indices[15];
+    CHECK(DecodeMeshoptIndexBuffer(indices, 12, sizeof(uint32_t), s_IndexDataV0, sizeof(s_IndexDataV0)));
+    CHECK(memcmp(indices, s_IndexBuffer, sizeof(s_IndexBuffer)) == 0);
+
+    uint16_t shortIndices[15];
+    CHECK(DecodeMeshoptIndexBuffer(shortIndices, 12, sizeof(uint16_t), s_IndexDataV0, sizeof(s_IndexDataV0)));
+    for (size_t i = 0; i < 12; ++i)
+        CHECK(shortIndices[i] == s_IndexBuffer[i]);
+
+    CHECK(DecodeMeshoptIndexBuffer(indices, 15, sizeof(uint32_t), s_IndexDataV1, sizeof(s_IndexDataV1)));
+    CHECK(memcmp(indices, s_IndexBufferV1, sizeof(s_IndexBufferV1)) == 0);
+
+    CHECK(!DecodeMeshoptIndexBuffer(indices, 12, sizeof(uint32_t), s_IndexDataV0, sizeof(s_IndexDataV0) - 1));
+    CHECK(!DecodeMeshoptIndexBuffer(indices, 10, sizeof(uint32_t), s_IndexDataV0, sizeof(s_IndexDataV0)));
+}
+
+// Decodes the reference index sequence to 16 and 32-bit indices
+static void TestIndexSequence()
+{
+    uint32_t indices[6];
+    CHECK(DecodeMeshoptIndexSequence(indices, 6, sizeof(uint32_t), s_IndexSequenceData, sizeof(s_IndexSequenceData)));
+    CHECK(memcmp(indices, s_IndexSequence, sizeof(s_IndexSequence)) == 0);
+
+    uint16_t shortIndices[6];
+    CHECK(DecodeMeshoptIndexSequence(shortIndices, 6, sizeof(uint16_t), s_IndexSequenceData, sizeof(s_IndexSequenceData)));
+    for (size_t i = 0; i < 6; ++i)
+        CHECK(shortIndices[i] == s_IndexSequence[i]);
+
+    CHECK(!DecodeMeshoptIndexSequence(indices, 6, sizeof(uint32_t), s_IndexSequenceData, sizeof(s_IndexSequenceData) - 1));
+}
+
+// Filters decode 4 elements at a time, elements past the reference ones repeat them to cover the partial final batch
+template<typename T, size_t N, typename FilterFn>
+static void CheckFilter(const T (&data)[N], const T (&expected)[N], size_t componentCount, FilterFn filter)
+{
+    const size_t   referenceCount = N / componentCount;
+    const size_t   elementCount   = referenceCount + 2;
+    std::vector<T> decoded(elementCount * componentCount);
+    for (size_t i = 0; i < decoded.size(); ++i)
+        decoded[i] = data[i % N];
+
+    filter(decoded.data(), elementCount, componentCount * sizeof(T));
+    for (size_t i = 0; i < decoded.size(); ++i)
+        CHECK(decoded[i] == expected[i % N]);
+}
+
+// Applies the filters to reference values
+static void TestFilters()
+{
+    const uint8_t octahedral8[16]         = { 0, 1, 127, 0, 0, 187, 127, 1, 255, 1, 127, 0, 14, 130, 127, 1 };
+    const uint8_t octahedral8Expected[16] = { 0, 1, 127, 0, 0, 159, 82, 1, 255, 1, 127, 0, 1, 130, 241, 1 };
+    CheckFilter(octahedral8, octahedral8Expected, 4, DecodeMeshoptOctahedralFilter);
+
+    const uint16_t octahedral12[16]         = { 0, 1, 2047, 0, 0, 1870, 2047, 1, 2017, 1, 2047, 0, 14, 1300, 2047, 1 };
+    const uint16_t octahedral12Expected[16] = { 0, 16, 32767, 0, 0, 32621, 3088, 1, 32764, 16, 471, 0, 307, 28541, 16093, 1 };
+    CheckFilter(octahedral12, octahedral12Expected, 4, DecodeMeshoptOctahedralFilter);
+
+    const uint16_t quaternion12[16]         = { 0, 1, 0, 0x7fc, 0, 1870, 0, 0x7fd, 2017, 1, 0, 0x7fe, 14, 1300, 0, 0x7ff };
+    const uint16_t quaternion12Expected[16] = { 32767, 0, 11, 0, 0, 25013, 0, 21166, 11, 0, 23504, 22830, 158, 14715, 0, 29277 };
+    CheckFilter(quaternion12, quaternion12Expected, 4, DecodeMeshoptQuaternionFilter);
+
+    const uint32_t exponential[4]         = { 0, 0xff000003, 0x02fffff7, 0xfe7fffff };
+    const uint32_t exponentialExpected[4] = { 0, 0x3fc00000, 0xc2100000, 0x49fffffe };
+    CheckFilter(exponential, exponentialExpected, 1, DecodeMeshoptExponentialFilter);
+}
+
+int main()
+{
+    TestVertexReference();
+    TestVertexRoundTrip();
+    TestIndexBuffer();
+    TestIndexSequence();
+    TestFilters();
+    return cauldron::test::GetExitCode();
+}
@@ -0,0 +1,270 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "misc/mpmcqueue.h"
+#include "misc/threadsafe_queue.h"
+#include "testing.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace cauldron;
+
+// Move-only item counting live instances
+class TrackedItem
+{
+public:
+    TrackedItem() : m_Value(0) { ++s_LiveCount; }
+    explicit TrackedItem(uint64_t value) : m_Value(value) { ++s_LiveCount; }
+    TrackedItem(TrackedItem&& other) noexcept : m_Value(other.m_Value) { ++s_LiveCount; other.m_Value = 0; }
+    TrackedItem& operator=(TrackedItem&& other) noexcept { m_Value = other.m_Value; other.m_Value = 0; return *this; }
+    ~TrackedItem() { --s_LiveCount; }
+
+    TrackedItem(const TrackedItem&) = delete;
+    TrackedItem& operator=(const TrackedItem&) = delete;
+
+    uint64_t GetValue() const { return m_Value; }
+
+    static int GetLiveCount() { return s_LiveCount; }
+
+private:
+    uint64_t                      m_Value;
+    static inline std::atomic_int s_LiveCount = { 0 };
+};
+
+// Move-only items go through in order, are only moved from on a successful push and are destroyed with the queue
+static void TestMoveOnlyItems()
+{
+    {
+        MPMCQueue<std::unique_ptr<int>> queue(4);
+        for (int i = 0; i < 4; ++i)
+            CHECK(queue.TryPush(std::make_unique<int>(i)));
+
+        std::unique_ptr<int> rejected = std::make_unique<int>(4);
+        CHECK(!queue.TryPush(std::move(rejected)));
+        CHECK(rejected != nullptr);
+
+        std::unique_ptr<int> value;
+        for (int i = 0; i < 4; ++i)
+        {
+            CHECK(queue.TryPop(value));
+            CHECK(value && *value == i);
+        }
+        CHECK(!queue.TryPop(value));
+    }
+
+    {
+        MPMCQueue<TrackedItem> queue(8);
+        for (uint64_t i = 1; i <= 5; ++i)
+            CHECK(queue.TryPush(TrackedItem(i)));
+        TrackedItem item;
+        CHECK(queue.TryPop(item) && item.GetValue() == 1);
+        CHECK(TrackedItem::GetLiveCount() == 5);
+    }
+    CHECK(TrackedItem::GetLiveCount() == 0);
+}
+
+// Capacity rounds up to a power of 2, pushes fail when full and pops when empty, on every lap around the ring
+static void TestBoundaries()
+{
+    CHECK(MPMCQueue<int>(1).Capacity() == 2);
+    CHECK(MPMCQueue<int>(3).Capacity() == 4);
+    CHECK(MPMCQueue<int>(1024).Capacity() == 1024);
+
+    MPMCQueue<int> queue(8);
+    int value = 0;
+    CHECK(!queue.TryPop(value));
+    CHECK(queue.Size() == 0);
+
+    int pushed = 0, popped = 0;
+    for (int lap = 0; lap < 100; ++lap)
+    {
+        // Fill up, drain part of it, then drain the rest so the positions drift across cell boundaries
+        while (queue.TryPush(pushed))
+            ++pushed;
+        CHECK(queue.Size() == 8);
+        CHECK(!queue.TryPush(-1));
+
+        for (int i = 0; i < 3 + lap % 5; ++i)
+        {
+            CHECK(queue.TryPop(value) && value == popped);
+            ++popped;
+        }
+        CHECK(queue.Size() == static_cast<size_t>(pushed - popped));
+
+        while (queue.TryPop(value))
+        {
+            CHECK(value == popped);
+            ++popped;
+        }
+        CHECK(queue.Size() == 0);
+        CHECK(pushed == popped);
+
+        // Leave a partial lap behind
+        for (int i = 0; i < lap % 7; ++i)
+            CHECK(queue.TryPush(pushed++));
+        while (queue.TryPop(value))
+            CHECK(value == popped++);
+    }
+}
+
+// Returns true if flag gets set within the timeout
+static bool WaitForFlag(const std::atomic_bool& flag, std::chrono::milliseconds timeout)
+{
+    const auto end = std::chrono::steady_clock::now() + timeout;
+    while (!flag && std::chrono::steady_clock::now() < end)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return flag;
+}
+
+// PushBack blocks while the queue is full and WaitPopFront while it is empty
+static void TestBlocking()
+{
+    ThreadSafeQueue<TrackedItem> queue(2);
+    queue.PushBack(TrackedItem(1));
+    queue.PushBack(TrackedItem(2));
+
+    std::atomic_bool pushed = { false };
+    std::thread pusher([&]() {
+        queue.PushBack(TrackedItem(3));
+        pushed = true;
+    });
+    CHECK(!WaitForFlag(pushed, std::chrono::milliseconds(50)));
+
+    TrackedItem item;
+    CHECK(queue.PopFront(item) && item.GetValue() == 1);
+    CHECK(WaitForFlag(pushed, std::chrono::seconds(10)));
+    pusher.join();
+
+    queue.WaitPopFront(item);
+    CHECK(item.GetValue() == 2);
+    queue.WaitPopFront(item);
+    CHECK(item.GetValue() == 3);
+    CHECK(queue.Empty());
+    CHECK(!queue.PopFront(item));
+
+    std::atomic_bool popped = { false };
+    uint64_t         poppedValue = 0;
+    std::thread popper([&]() {
+        TrackedItem waitedItem;
+        queue.WaitPopFront(waitedItem);
+        poppedValue = waitedItem.GetValue();
+        popped = true;
+    });
+    CHECK(!WaitForFlag(popped, std::chrono::milliseconds(50)));
+
+    queue.PushBack(TrackedItem(4));
+    CHECK(WaitForFlag(popped, std::chrono::seconds(10)));
+    popper.join();
+    CHECK(poppedValue == 4);
+}
+
+// Runs producers and consumers over a small queue. Every item must be consumed exactly once, and each consumer
+// must see the items of a given producer in the order they were pushed.
+template<typename PushFunc, typename PopFunc>
+static void RunProducersConsumers(uint32_t producerCount, uint32_t consumerCount, uint32_t itemsPerProducer, PushFunc push, PopFunc pop)
+{
+    std::vector<std::atomic_uint32_t> consumeCounts(static_cast<size_t>(producerCount) * itemsPerProducer);
+    for (std::atomic_uint32_t& count : consumeCounts)
+        count = 0;
+
+    std::atomic_uint32_t orderFailures = { 0 };
+    std::atomic_uint32_t remaining     = { producerCount * itemsPerProducer };
+
+    std::vector<std::thread> threads;
+    for (uint32_t producer = 0; producer < producerCount; ++producer)
+    {
+        threads.emplace_back([&, producer]() {
+            for (uint32_t i = 0; i < itemsPerProducer; ++i)
+                push((static_cast<uint64_t>(producer) << 32) | i);
+        });
+    }
+    for (uint32_t consumer = 0; consumer < consumerCount; ++consumer)
+    {
+        threads.emplace_back([&]() {
+            std::vector<int64_t> lastSeen(producerCount, -1);
+            uint64_t value = 0;
+            while (remaining.load(std::memory_order_relaxed) > 0)
+            {
+                if (!pop(value))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                const uint32_t producer = static_cast<uint32_t>(value >> 32);
+                const uint32_t index    = static_cast<uint32_t>(value);
+                if (static_cast<int64_t>(index) <= lastSeen[producer])
+                    ++orderFailures;
+                lastSeen[producer] = index;
+                ++consumeCounts[static_cast<size_t>(producer) * itemsPerProducer + index];
+                --remaining;
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    uint32_t lostOrDuplicated = 0;
+    for (const std::atomic_uint32_t& count : consumeCounts)
+        lostOrDuplicated += (count != 1) ? 1 : 0;
+    CHECK(lostOrDuplicated == 0);
+    CHECK(orderFailures == 0);
+}
+
+// Concurrent producers and consumers neither lose nor duplicate items
+static void TestProducersConsumers()
+{
+    constexpr uint32_t s_ItemsPerProducer = 50000;
+
+    for (uint32_t threadCount : { 2u, 4u, 8u })
+    {
+        MPMCQueue<uint64_t> queue(64);
+        RunProducersConsumers(threadCount, threadCount, s_ItemsPerProducer,
+            [&queue](uint64_t value) {
+                while (!queue.TryPush(value))
+                    std::this_thread::yield();
+            },
+            [&queue](uint64_t& value) { return queue.TryPop(value); });
+        CHECK(queue.Size() == 0);
+    }
+
+    // Blocking pushes on a queue small enough to be full most of the time
+    ThreadSafeQueue<uint64_t> blockingQueue(4);
+    RunProducersConsumers(4, 4, s_ItemsPerProducer / 4,
+        [&blockingQueue](uint64_t value) { blockingQueue.PushBack(value); },
+        [&blockingQueue](uint64_t& value) { return blockingQueue.PopFront(value); });
+    CHECK(blockingQueue.Empty());
+}
+
+int main()
+{
+    TestMoveOnlyItems();
+    TestBoundaries();
+    TestBlocking();
+    TestProducersConsumers();
+    return cauldron::test::GetExitCode();
+}
@@ -0,0 +1,350 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "misc/quadtreeallocator.h"
+#include "testing.h"
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace cauldron;
+
+// Walks the tree for the smallest empty cell that can hold size (how the atlas searched before the free lists)
+static int32_t FindBestCellRecursive(const QuadTreeAllocator& allocator, int32_t index, uint32_t size)
+{
+    const QuadTreeAllocator::Cell& cell = allocator.GetCell(index);
+    if (cell.Size < size || cell.Status == CellStatus::Allocated)
+        return -1;
+    if (cell.Status == CellStatus::Empty)
+        return index;
+
+    int32_t bestIndex = -1;
+    for (int32_t i = 0; i < 4; ++i)
+    {
+        const int32_t childIndex = FindBestCellRecursive(allocator, (index << 2) + 1 + i, size);
+        if (childIndex >= 0 && (bestIndex < 0 || allocator.GetCell(childIndex).Size < allocator.GetCell(bestIndex).Size))
+            bestIndex = childIndex;
+    }
+    return bestIndex;
+}
+
+// Returns the quadrant of the whole area a cell is in
+static uint32_t GetQuadrant(const QuadTreeAllocator& allocator, int32_t index)
+{
+    const QuadTreeAllocator::Cell& cell = allocator.GetCell(index);
+    const uint32_t halfSize = allocator.GetSize() / 2;
+    return (cell.Left >= halfSize ? 1 : 0) + (cell.Top >= halfSize ? 2 : 0);
+}
+
+// Checks that the allocated cells are in range and don't overlap, on a grid of minCellSize texels
+static bool CheckAllocations(const QuadTreeAllocator& allocator, const std::vector<int32_t>& cells, uint32_t minCellSize)
+{
+    const uint32_t gridSize = allocator.GetSize() / minCellSize;
+    std::vector<bool> coverage(gridSize * gridSize, false);
+    for (int32_t index : cells)
+    {
+        const QuadTreeAllocator::Cell& cell = allocator.GetCell(index);
+        if (cell.Status != CellStatus::Allocated || cell.Left + cell.Size > allocator.GetSize() || cell.Top + cell.Size > allocator.GetSize())
+            return false;
+
+        for (uint32_t y = cell.Top / minCellSize; y < (cell.Top + cell.Size) / minCellSize; ++y)
+        {
+            for (uint32_t x = cell.Left / minCellSize; x < (cell.Left + cell.Size) / minCellSize; ++x)
+            {
+                if (coverage[y * gridSize + x])
+                    return false;
+                coverage[y * gridSize + x] = true;
+            }
+        }
+    }
+    return true;
+}
+
+// The best cell is the smallest empty one that fits, subdivisions are laid out in quadrants
+static void TestFindBestCell()
+{
+    QuadTreeAllocator allocator(2048);
+    CHECK(allocator.FindBestCell(0) == -1);
+    CHECK(allocator.FindBestCell(4096) == -1);
+    CHECK(allocator.FindBestCell(2048) == 0);
+    CHECK(allocator.FindBestCell(512) == 0);
+
+    const int32_t cellIndex = allocator.AllocateCell(512, 0);
+    CHECK(allocator.GetCell(cellIndex).Size == 512);
+    CHECK(allocator.GetCell(cellIndex).Left == 0 && allocator.GetCell(cellIndex).Top == 0);
+    CHECK(allocator.GetCell(0).Status == CellStatus::Subdivided);
+
+    // One free 512 and 1024 cell left at each level
+    CHECK(allocator.FindBestCell(2048) == -1);
+    CHECK(allocator.GetCell(allocator.FindBestCell(1024)).Size == 1024);
+    CHECK(allocator.GetCell(allocator.FindBestCell(512)).Size == 512);
+    CHECK(allocator.GetCell(allocator.FindBestCell(256)).Size == 512);
+
+    // Children are top left, top right, bottom left, bottom right
+    const int32_t childrenBaseIndex = 1;
+    for (int32_t i = 0; i < 4; ++i)
+    {
+        const QuadTreeAllocator::Cell& cell = allocator.GetCell(childrenBaseIndex + i);
+        CHECK(cell.Size == 1024);
+        CHECK(cell.Left == ((i & 1) ? 1024u : 0u) && cell.Top == ((i & 2) ? 1024u : 0u));
+    }
+
+    // Allocating the free 512 cells leaves 1024 cells as the best fit for smaller requests
+    for (int32_t i = 0; i < 3; ++i)
+        allocator.AllocateCell(512, allocator.FindBestCell(512));
+    CHECK(allocator.GetCell(allocator.FindBestCell(256)).Size == 1024);
+}
+
+// Freeing the last allocated child of a subdivision merges it back into its parent, up to the root
+static void TestBuddyMerge()
+{
+    QuadTreeAllocator allocator(2048);
+
+    std::vector<int32_t> cells;
+    for (int32_t i = 0; i < 4; ++i)
+        cells.push_back(allocator.AllocateCell(1024, allocator.FindBestCell(1024)));
+    CHECK(allocator.FindBestCell(1024) == -1);
+    CHECK(CheckAllocations(allocator, cells, 1024));
+
+    for (int32_t i = 0; i < 3; ++i)
+    {
+        allocator.FreeCell(cells[i]);
+        CHECK(allocator.GetCell(0).Status == CellStatus::Subdivided);
+        CHECK(allocator.FindBestCell(2048) == -1);
+    }
+    allocator.FreeCell(cells[3]);
+    CHECK(allocator.IsEmpty());
+    CHECK(allocator.FindBestCell(2048) == 0);
+
+    // A deep allocation merges all the way back up
+    const int32_t cellIndex = allocator.AllocateCell(128, 0);
+    CHECK(allocator.GetCell(cellIndex).Size == 128);
+    CHECK(allocator.FindBestCell(2048) == -1);
+    allocator.FreeCell(cellIndex);
+    CHECK(allocator.IsEmpty());
+    CHECK(allocator.FindBestCell(2048) == 0);
+    CHECK(allocator.GetCell(allocator.FindBestCell(128)).Size == 2048);
+}
+
+// Defragmenting moves the cells of the sparsest subdivision into the densest ones so it merges back
+static void TestDefragment()
+{
+    QuadTreeAllocator allocator(2048);
+
+    std::vector<int32_t> cells;
+    for (int32_t i = 0; i < 16; ++i)
+        cells.push_back(allocator.AllocateCell(512, allocator.FindBestCell(512)));
+    CHECK(CheckAllocations(allocator, cells, 512));
+
+    // Leave one cell in the quadrant of the first one and free one cell in another quadrant
+    const uint32_t sparseQuadrant = GetQuadrant(allocator, cells[0]);
+    bool           denseFreed     = false;
+    std::vector<int32_t> liveCells;
+    for (int32_t cellIndex : cells)
+    {
+        const uint32_t quadrant = GetQuadrant(allocator, cellIndex);
+        if ((quadrant == sparseQuadrant && cellIndex != cells[0]) || (quadrant != sparseQuadrant && !denseFreed))
+        {
+            denseFreed |= quadrant != sparseQuadrant;
+            allocator.FreeCell(cellIndex);
+        }
+        else
+            liveCells.push_back(cellIndex);
+    }
+    CHECK(liveCells.size() == 12);
+    CHECK(allocator.FindBestCell(1024) == -1);
+
+    std::vector<QuadTreeAllocator::CellMove> moves;
+    CHECK(allocator.Defragment(8, moves) == 1);
+    CHECK(moves.size() == 1);
+    CHECK(moves[0].SrcCellIndex == cells[0]);
+    CHECK(GetQuadrant(allocator, moves[0].DstCellIndex) != sparseQuadrant);
+    CHECK(allocator.GetCell(moves[0].SrcCellIndex).Status == CellStatus::Empty);
+    CHECK(allocator.GetCell(moves[0].DstCellIndex).Status == CellStatus::Allocated);
+
+    // The sparse quadrant merged back into a free 1024 cell
+    const int32_t freeIndex = allocator.FindBestCell(1024);
+    CHECK(freeIndex >= 0 && allocator.GetCell(freeIndex).Size == 1024 && GetQuadrant(allocator, freeIndex) == sparseQuadrant);
+
+    liveCells[0] = moves[0].DstCellIndex;
+    CHECK(CheckAllocations(allocator, liveCells, 512));
+
+    // Nothing left to compact
+    moves.clear();
+    CHECK(allocator.Defragment(8, moves) == 0);
+    CHECK(moves.empty());
+
+    // Leave two cells in one of the full quadrants and free one cell in each of the two others
+    const uint32_t       nextSparseQuadrant = GetQuadrant(allocator, liveCells[0]);
+    std::vector<int32_t> freedQuadrantCells(4, 0);
+    std::vector<int32_t> remainingCells;
+    for (int32_t cellIndex : liveCells)
+    {
+        const uint32_t quadrant  = GetQuadrant(allocator, cellIndex);
+        const int32_t  freeCount = (quadrant == nextSparseQuadrant) ? 2 : 1;
+        if (freedQuadrantCells[quadrant] < freeCount)
+        {
+            ++freedQuadrantCells[quadrant];
+            allocator.FreeCell(cellIndex);
+        }
+        else
+            remainingCells.push_back(cellIndex);
+    }
+    CHECK(remainingCells.size() == 8);
+
+    // The move count is capped, moving the rest later on completes the merge
+    moves.clear();
+    CHECK(allocator.Defragment(0, moves) == 0);
+    CHECK(allocator.Defragment(1, moves) == 1);
+    CHECK(allocator.Defragment(1, moves) == 1);
+    CHECK(moves.size() == 2);
+    for (const QuadTreeAllocator::CellMove& move : moves)
+    {
+        CHECK(GetQuadrant(allocator, move.SrcCellIndex) == nextSparseQuadrant);
+        CHECK(GetQuadrant(allocator, move.DstCellIndex) != nextSparseQuadrant);
+    }
+    CHECK(allocator.AllocateCell(1024, allocator.FindBestCell(1024)) >= 0);
+    CHECK(allocator.AllocateCell(1024, allocator.FindBestCell(1024)) >= 0);
+    CHECK(allocator.FindBestCell(512) == -1);
+}
+
+// Random allocations, releases and defragmentations keep the tree consistent and the best fit matches a full tree walk
+static void TestRandomOperations()
+{
+    constexpr uint32_t s_AtlasSize   = 256;
+    constexpr uint32_t s_MinCellSize = 16;
+
+    QuadTreeAllocator    allocator(s_AtlasSize);
+    std::mt19937         generator(42);
+    std::vector<int32_t> cells;
+    uint32_t             allocatedArea = 0;
+
+    for (int32_t iteration = 0; iteration < 20000; ++iteration)
+    {
+        const uint32_t operation = generator() % 16;
+        if (operation < 9)
+        {
+            const uint32_t size      = s_MinCellSize << (generator() % 4);
+            const int32_t  cellIndex = allocator.FindBestCell(size);
+            const int32_t  reference = FindBestCellRecursive(allocator, 0, size);
+            CHECK((cellIndex < 0) == (reference < 0));
+            if (cellIndex < 0)
+                continue;
+            CHECK(allocator.GetCell(cellIndex).Size == allocator.GetCell(reference).Size);
+
+            cells.push_back(allocator.AllocateCell(size, cellIndex));
+            allocatedArea += size * size;
+        }
+        else if (operation < 15 && !cells.empty())
+        {
+            const size_t slot = generator() % cells.size();
+            allocatedArea -= allocator.GetCell(cells[slot]).Size * allocator.GetCell(cells[slot]).Size;
+            allocator.FreeCell(cells[slot]);
+            cells[slot] = cells.back();
+            cells.pop_back();
+        }
+        else
+        {
+            std::vector<QuadTreeAllocator::CellMove> moves;
+            allocator.Defragment(4, moves);
+            for (const QuadTreeAllocator::CellMove& move : moves)
+            {
+                CHECK(allocator.GetCell(move.DstCellIndex).Size == allocator.GetCell(move.SrcCellIndex).Size);
+                for (int32_t& cellIndex : cells)
+                {
+                    if (cellIndex == move.SrcCellIndex)
+                        cellIndex = move.DstCellIndex;
+                }
+            }
+        }
+
+        if (iteration % 64 == 0)
+        {
+            uint32_t area = 0;
+            for (int32_t cellIndex : cells)
+                area += allocator.GetCell(cellIndex).Size * allocator.GetCell(cellIndex).Size;
+            CHECK(area == allocatedArea);
+            CHECK(CheckAllocations(allocator, cells, s_MinCellSize));
+        }
+    }
+
+    for (int32_t cellIndex : cells)
+        allocator.FreeCell(cellIndex);
+    CHECK(allocator.IsEmpty());
+    CHECK(allocator.FindBestCell(s_AtlasSize) == 0);
+}
+
+// Times FindBestCell against a full tree walk on a busy atlas
+static void BenchmarkFindBestCell()
+{
+    constexpr uint32_t s_AtlasSize   = 16384;
+    constexpr uint32_t s_MinCellSize = 64;
+    constexpr uint32_t s_QueryCount  = 1 << 16;
+
+    QuadTreeAllocator    allocator(s_AtlasSize);
+    std::mt19937         generator(7);
+    std::vector<int32_t> cells;
+
+    // Fill the atlas up with mixed sizes, then free half of the cells to leave holes at every level
+    for (;;)
+    {
+        const uint32_t size      = s_MinCellSize << (generator() % 5);
+        const int32_t  cellIndex = allocator.FindBestCell(size);
+        if (cellIndex < 0)
+            break;
+        cells.push_back(allocator.AllocateCell(size, cellIndex));
+    }
+    for (size_t i = 0; i < cells.size(); i += 2)
+        allocator.FreeCell(cells[i]);
+
+    std::vector<uint32_t> sizes(s_QueryCount);
+    for (uint32_t& size : sizes)
+        size = s_MinCellSize << (generator() % 6);
+
+    int64_t checksum = 0;
+    const auto freeListStart = std::chrono::steady_clock::now();
+    for (uint32_t size : sizes)
+        checksum += allocator.FindBestCell(size);
+    const double freeListNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - freeListStart).count() / s_QueryCount;
+
+    int64_t referenceChecksum = 0;
+    const auto treeWalkStart = std::chrono::steady_clock::now();
+    for (uint32_t size : sizes)
+        referenceChecksum += FindBestCellRecursive(allocator, 0, size) >= 0 ? 1 : 0;
+    const double treeWalkNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - treeWalkStart).count() / s_QueryCount;
+    CHECK(checksum != 0 && referenceChecksum != 0);
+
+    std::printf("find best cell: %zu cells in a %u atlas, free lists %.1f ns per query, tree walk %.1f ns per query\n",
+                cells.size() - (cells.size() + 1) / 2, s_AtlasSize, freeListNanoseconds, treeWalkNanoseconds);
+}
+
+int main()
+{
+    TestFindBestCell();
+    TestBuddyMerge();
+    TestDefragment();
+    TestRandomOperations();
+    BenchmarkFindBestCell();
+    return cauldron::test::GetExitCode();
+}
@@ -0,0 +1,81 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+
+/// @defgroup CauldronTests Tests
+/// Minimal checks used by the headless tests of <c><i>Cauldron</i></c>'s platform-neutral code.
+///
+/// @ingroup CauldronMisc
+
+namespace cauldron
+{
+namespace test
+{
+    /// Returns the number of checks that failed so far.
+    ///
+    /// @ingroup CauldronTests
+    inline int& GetFailureCount()
+    {
+        static int failureCount = 0;
+        return failureCount;
+    }
+
+    /// Reports a failed check.
+    ///
+    /// @ingroup CauldronTests
+    inline void ReportFailure(const char* file, int line, const char* expression)
+    {
+        std::fprintf(stderr, "%s(%d): check failed: %s\n", file, line, expression);
+        ++GetFailureCount();
+    }
+
+    /// Returns the process exit code for the checks made (0 when all passed).
+    ///
+    /// @ingroup CauldronTests
+    inline int GetExitCode()
+    {
+        if (GetFailureCount())
+            std::fprintf(stderr, "%d check(s) failed\n", GetFailureCount());
+        return GetFailureCount() ? 1 : 0;
+    }
+
+} // namespace test
+} // namespace cauldron
+
+/// \def CHECK(expression)
+/// Reports a failure when \expression is false and carries on with the test.
+///
+/// @ingroup CauldronTests
+#define CHECK(expression) \
+    do { if (!(expression)) cauldron::test::ReportFailure(__FILE__, __LINE__, #expression); } while (0)
+
+/// \def CHECK_NEAR(value, expected, tolerance)
+/// Reports a failure when \value is further than \tolerance from \expected.
+///
+/// @ingroup CauldronTests
+#define CHECK_NEAR(value, expected, tolerance) \
+    do { if (!(std::abs(static_cast<double>(value) - static_cast<double>(expected)) <= (tolerance))) \
+        cauldron::test::ReportFailure(__FILE__, __LINE__, #value " == " #expected " +/- " #tolerance); } while (0)
@@ -0,0 +1,277 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "misc/tlsfallocator.h"
+#include "testing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace cauldron;
+
+// Checks that the live allocations don't overlap and stay in range, and that the free size accounts for them
+static bool CheckAllocations(const TLSFAllocator& allocator, std::vector<TLSFAllocator::Allocation> allocations)
+{
+    std::sort(allocations.begin(), allocations.end(), [](const TLSFAllocator::Allocation& a, const TLSFAllocator::Allocation& b) { return a.Offset < b.Offset; });
+
+    uint64_t usedSize = 0;
+    for (size_t i = 0; i < allocations.size(); ++i)
+    {
+        if (allocations[i].Offset + allocations[i].Size > allocator.GetSize())
+            return false;
+        if (i > 0 && allocations[i - 1].Offset + allocations[i - 1].Size > allocations[i].Offset)
+            return false;
+        usedSize += allocations[i].Size;
+    }
+    return allocator.GetFreeSize() == allocator.GetSize() - usedSize && allocator.GetAllocationCount() == allocations.size();
+}
+
+// Sizes round up to the granularity, offsets honor the alignment and freed blocks merge back with their neighbors
+static void TestAllocateFree()
+{
+    TLSFAllocator allocator;
+    allocator.Init(1 << 20, 256);
+    CHECK(allocator.GetFreeBlockCount() == 1);
+    CHECK(allocator.GetLargestFreeBlockSize() == 1 << 20);
+
+    TLSFAllocator::Allocation first, second, third;
+    CHECK(allocator.Allocate(100, 0, first));
+    CHECK(first.Size == 256);
+    CHECK(allocator.Allocate(1000, 4096, second));
+    CHECK(second.Offset % 4096 == 0);
+    CHECK(second.Size == 1024);
+    CHECK(allocator.Allocate(256, 256, third));
+    CHECK(CheckAllocations(allocator, { first, second, third }));
+
+    // Freeing the middle allocation leaves a hole, freeing its neighbors merges everything back
+    allocator.Free(second.Handle);
+    CHECK(CheckAllocations(allocator, { first, third }));
+    allocator.Free(first.Handle);
+    allocator.Free(third.Handle);
+    CHECK(allocator.GetFreeSize() == 1 << 20);
+    CHECK(allocator.GetFreeBlockCount() == 1);
+    CHECK(allocator.GetLargestFreeBlockSize() == 1 << 20);
+
+    // Nothing fits past the end
+    TLSFAllocator::Allocation whole, more;
+    CHECK(allocator.Allocate(1 << 20, 0, whole));
+    CHECK(!allocator.Allocate(1, 0, more));
+    allocator.Free(whole.Handle);
+    CHECK(allocator.GetAllocationCount() == 0);
+}
+
+// Random allocations and frees in arbitrary order never overlap, and the heap coalesces back to a single block
+static void TestRandomOperations()
+{
+    TLSFAllocator allocator;
+    allocator.Init(16 << 20, 256);
+
+    std::mt19937                           random(1234);
+    std::vector<TLSFAllocator::Allocation> allocations;
+    bool                                   consistent = true;
+    for (uint32_t i = 0; i < 200000; ++i)
+    {
+        if (allocations.empty() || random() % 100 < 55)
+        {
+            const uint64_t size      = 1 + random() % (256 << 10);
+            const uint64_t alignment = 1ull << (random() % 17);
+            TLSFAllocator::Allocation allocation;
+            if (allocator.Allocate(size, alignment, allocation))
+            {
+                consistent &= allocation.Offset % std::max<uint64_t>(alignment, 256) == 0 && allocation.Size >= size;
+                allocations.push_back(allocation);
+            }
+        }
+        else
+        {
+            const size_t index = random() % allocations.size();
+            allocator.Free(allocations[index].Handle);
+            allocations[index] = allocations.back();
+            allocations.pop_back();
+        }
+
+        if (i % 1000 == 0)
+            consistent &= CheckAllocations(allocator, allocations);
+    }
+    CHECK(consistent);
+    CHECK(CheckAllocations(allocator, allocations));
+
+    for (const TLSFAllocator::Allocation& allocation : allocations)
+        allocator.Free(allocation.Handle);
+    CHECK(allocator.GetFreeSize() == allocator.GetSize());
+    CHECK(allocator.GetFreeBlockCount() == 1);
+}
+
+// The upload heap's previous algorithm: first fit over a free list sorted by offset, merged on release
+class FirstFitAllocator
+{
+public:
+    explicit FirstFitAllocator(uint64_t size) : m_FreeBlocks{ { 0, size } } {}
+
+    bool Allocate(uint64_t size, uint64_t alignment, uint64_t& offset)
+    {
+        for (size_t i = 0; i < m_FreeBlocks.size(); ++i)
+        {
+            Block&         block   = m_FreeBlocks[i];
+            const uint64_t aligned = (block.Offset + alignment - 1) & ~(alignment - 1);
+            if (aligned + size > block.Offset + block.Size)
+                continue;
+
+            // Keep the padding and the remainder as free blocks
+            const Block padding   = { block.Offset, aligned - block.Offset };
+            const Block remainder = { aligned + size, block.Offset + block.Size - aligned - size };
+            m_FreeBlocks.erase(m_FreeBlocks.begin() + i);
+            if (remainder.Size)
+                m_FreeBlocks.insert(m_FreeBlocks.begin() + i, remainder);
+            if (padding.Size)
+                m_FreeBlocks.insert(m_FreeBlocks.begin() + i, padding);
+            offset = aligned;
+            return true;
+        }
+        return false;
+    }
+
+    void Free(uint64_t offset, uint64_t size)
+    {
+        auto it = std::lower_bound(m_FreeBlocks.begin(), m_FreeBlocks.end(), offset, [](const Block& block, uint64_t value) { return block.Offset < value; });
+        it = m_FreeBlocks.insert(it, { offset, size });
+        if (it + 1 != m_FreeBlocks.end() && it->Offset + it->Size == (it + 1)->Offset)
+        {
+            it->Size += (it + 1)->Size;
+            m_FreeBlocks.erase(it + 1);
+        }
+        if (it != m_FreeBlocks.begin() && (it - 1)->Offset + (it - 1)->Size == it->Offset)
+        {
+            (it - 1)->Size += it->Size;
+            m_FreeBlocks.erase(it);
+        }
+    }
+
+    size_t GetFreeBlockCount() const { return m_FreeBlocks.size(); }
+
+private:
+    struct Block
+    {
+        uint64_t Offset;
+        uint64_t Size;
+    };
+    std::vector<Block> m_FreeBlocks;
+};
+
+// An upload trace: every frame uploads a few buffers and textures that live for a few frames, and are released in
+// whatever order their transfers complete
+struct TraceEvent
+{
+    bool     Allocate;
+    uint32_t Id;
+    uint64_t Size;
+    uint64_t Alignment;
+};
+
+static std::vector<TraceEvent> BuildUploadTrace(uint32_t frameCount, uint32_t& allocationCount)
+{
+    std::mt19937                          random(42);
+    std::vector<TraceEvent>               trace;
+    std::vector<std::vector<TraceEvent>>  pendingFrees(16);
+    allocationCount = 0;
+    for (uint32_t frame = 0; frame < frameCount; ++frame)
+    {
+        std::vector<TraceEvent>& frees = pendingFrees[frame % pendingFrees.size()];
+        std::shuffle(frees.begin(), frees.end(), random);
+        trace.insert(trace.end(), frees.begin(), frees.end());
+        frees.clear();
+
+        const uint32_t uploadCount = 2 + random() % 24;
+        for (uint32_t upload = 0; upload < uploadCount; ++upload)
+        {
+            // Log-uniform sizes from 256B to 4MB, textures are 64KB aligned
+            const uint64_t size      = static_cast<uint64_t>(std::exp2(8.0 + 14.0 * std::uniform_real_distribution<double>(0.0, 1.0)(random)));
+            const uint64_t alignment = (random() % 2) ? 65536 : 512;
+            const TraceEvent event   = { true, allocationCount++, size, alignment };
+            trace.push_back(event);
+
+            TraceEvent freeEvent = event;
+            freeEvent.Allocate   = false;
+            pendingFrees[(frame + 1 + random() % (pendingFrees.size() - 1)) % pendingFrees.size()].push_back(freeEvent);
+        }
+    }
+
+    // Everything is released in the end
+    for (const std::vector<TraceEvent>& frees : pendingFrees)
+        trace.insert(trace.end(), frees.begin(), frees.end());
+    return trace;
+}
+
+// Replays the upload trace on a 64MB heap against the previous first fit algorithm. Allocations that don't fit are
+// counted as failures (the upload heap would have to wait) and skipped.
+static void BenchmarkTraceReplay()
+{
+    constexpr uint64_t s_HeapSize = 64 << 20;
+
+    uint32_t                      allocationCount = 0;
+    const std::vector<TraceEvent> trace = BuildUploadTrace(20000, allocationCount);
+
+    TLSFAllocator tlsf;
+    tlsf.Init(s_HeapSize, 256);
+    std::vector<TLSFAllocator::Allocation> tlsfAllocations(allocationCount);
+    uint32_t tlsfFailures = 0;
+    const auto tlsfStart = std::chrono::steady_clock::now();
+    for (const TraceEvent& event : trace)
+    {
+        if (event.Allocate)
+            tlsfFailures += tlsf.Allocate(event.Size, event.Alignment, tlsfAllocations[event.Id]) ? 0 : 1;
+        else if (tlsfAllocations[event.Id].Handle != TLSFAllocator::s_InvalidHandle)
+            tlsf.Free(tlsfAllocations[event.Id].Handle);
+    }
+    const double tlsfNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - tlsfStart).count() / trace.size();
+    CHECK(tlsf.GetAllocationCount() == 0);
+    CHECK(tlsf.GetFreeBlockCount() == 1);
+
+    FirstFitAllocator     firstFit(s_HeapSize);
+    std::vector<uint64_t> firstFitOffsets(allocationCount, UINT64_MAX);
+    uint32_t firstFitFailures = 0;
+    const auto firstFitStart = std::chrono::steady_clock::now();
+    for (const TraceEvent& event : trace)
+    {
+        const uint64_t size = (event.Size + 255) & ~255ull;
+        if (event.Allocate)
+            firstFitFailures += firstFit.Allocate(size, event.Alignment, firstFitOffsets[event.Id]) ? 0 : 1;
+        else if (firstFitOffsets[event.Id] != UINT64_MAX)
+            firstFit.Free(firstFitOffsets[event.Id], size);
+    }
+    const double firstFitNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - firstFitStart).count() / trace.size();
+    CHECK(firstFit.GetFreeBlockCount() == 1);
+
+    std::printf("upload trace replay: %llu operations, TLSF %u failed allocations at %.1f ns per operation, first fit %u failed allocations at %.1f ns per operation\n",
+                static_cast<unsigned long long>(trace.size()), tlsfFailures, tlsfNanoseconds, firstFitFailures, firstFitNanoseconds);
+}
+
+int main()
+{
+    TestAllocateFree();
+    TestRandomOperations();
+    BenchmarkTraceReplay();
+    return cauldron::test::GetExitCode();
+}
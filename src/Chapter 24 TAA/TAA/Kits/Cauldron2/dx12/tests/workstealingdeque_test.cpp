@@ -0,0 +1,151 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2025 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "misc/workstealingdeque.h"
+#include "testing.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace cauldron;
+
+// Owner pops in LIFO order, stealers take from the top in FIFO order
+static void TestOrdering()
+{
+    uint32_t                     items[8];
+    WorkStealingDeque<uint32_t*> deque(8);
+    CHECK(deque.Empty());
+    CHECK(deque.Pop() == nullptr);
+    CHECK(deque.Steal() == nullptr);
+
+    for (uint32_t i = 0; i < 8; ++i)
+        deque.Push(&items[i]);
+    CHECK(!deque.Empty());
+
+    CHECK(deque.Pop() == &items[7]);
+    CHECK(deque.Steal() == &items[0]);
+    CHECK(deque.Pop() == &items[6]);
+    CHECK(deque.Steal() == &items[1]);
+    for (uint32_t i = 2; i < 6; ++i)
+        CHECK(deque.Steal() == &items[i]);
+
+    CHECK(deque.Empty());
+    CHECK(deque.Pop() == nullptr);
+    CHECK(deque.Steal() == nullptr);
+}
+
+// Growing from a tiny capacity keeps every item, including across wrapped indices
+static void TestGrowth()
+{
+    std::vector<uint32_t>        items(10000);
+    WorkStealingDeque<uint32_t*> deque(2);
+
+    // Offset top and bottom so the copy into the grown storage has to wrap
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        deque.Push(&items[0]);
+        CHECK(deque.Steal() == &items[0]);
+    }
+
+    for (uint32_t i = 0; i < items.size(); ++i)
+        deque.Push(&items[i]);
+    for (uint32_t i = 0; i < items.size() / 2; ++i)
+        CHECK(deque.Steal() == &items[i]);
+    for (uint32_t i = static_cast<uint32_t>(items.size()); i-- > items.size() / 2;)
+        CHECK(deque.Pop() == &items[i]);
+    CHECK(deque.Empty());
+}
+
+// The owner pushes and pops while stealers drain the top, every item must be taken exactly once
+static void TestOwnerStealers()
+{
+    constexpr uint32_t s_ItemCount    = 2 * 1024 * 1024;
+    constexpr uint32_t s_StealerCount = 4;
+
+    std::vector<uint32_t>             items(s_ItemCount);
+    std::vector<std::atomic_uint32_t> takeCounts(s_ItemCount);
+    for (uint32_t i = 0; i < s_ItemCount; ++i)
+        items[i] = i;
+
+    WorkStealingDeque<uint32_t*> deque(16);
+    std::atomic_uint32_t         remaining = { s_ItemCount };
+    std::atomic_uint32_t         stolen    = { 0 };
+
+    auto take = [&](uint32_t* pItem) {
+        ++takeCounts[*pItem];
+        remaining.fetch_sub(1, std::memory_order_relaxed);
+    };
+
+    std::vector<std::thread> stealers;
+    for (uint32_t s = 0; s < s_StealerCount; ++s)
+    {
+        stealers.emplace_back([&]() {
+            while (remaining.load(std::memory_order_relaxed) > 0)
+            {
+                if (uint32_t* pItem = deque.Steal())
+                {
+                    take(pItem);
+                    stolen.fetch_add(1, std::memory_order_relaxed);
+                }
+                else
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    // Owner pushes in bursts and pops part of each burst back, like a worker spawning and running its own tasks
+    for (uint32_t i = 0; i < s_ItemCount; ++i)
+    {
+        deque.Push(&items[i]);
+        if ((i & 7) == 7)
+        {
+            for (uint32_t p = 0; p < 3; ++p)
+            {
+                if (uint32_t* pItem = deque.Pop())
+                    take(pItem);
+            }
+        }
+    }
+    while (uint32_t* pItem = deque.Pop())
+        take(pItem);
+
+    for (std::thread& stealer : stealers)
+        stealer.join();
+
+    CHECK(remaining == 0);
+    CHECK(deque.Empty());
+    uint32_t badCount = 0;
+    for (uint32_t i = 0; i < s_ItemCount; ++i)
+        badCount += takeCounts[i] != 1;
+    CHECK(badCount == 0);
+    std::printf("WorkStealingDeque: %u items, %u stolen by %u threads\n", s_ItemCount, stolen.load(), s_StealerCount);
+}
+
+int main()
+{
+    TestOrdering();
+    TestGrowth();
+    TestOwnerStealers();
+    return cauldron::test::GetExitCode();
+}